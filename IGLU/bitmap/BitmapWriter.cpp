@@ -8,6 +8,7 @@
 #include <IGLU/bitmap/BitmapWriter.h>
 
 #include <IGLU/texture_accessor/TextureAccessorFactory.h>
+#include <IGLU/texture_encoder/TextureEncoder.h>
 #include <fstream>
 #include <igl/Common.h>
 
@@ -60,26 +61,10 @@ BufferOffsets getBufferOffsets(igl::TextureFormat format) {
   }
 }
 
-} // namespace
-
-bool isSupportedBitmapTextureFormat(igl::TextureFormat format) {
-  switch (format) {
-  case igl::TextureFormat::RGBA_UNorm8:
-  case igl::TextureFormat::RGBX_UNorm8:
-  case igl::TextureFormat::RGBA_SRGB:
-  case igl::TextureFormat::BGRA_UNorm8:
-  case igl::TextureFormat::BGRA_SRGB:
-    return true;
-
-  default:
-    return false;
-  }
-}
-
-void writeBitmap(std::ostream& stream,
-                 std::shared_ptr<igl::ITexture> texture,
-                 igl::IDevice& device,
-                 bool flipY) {
+// Reads back a texture's base level as tightly packed RGBA8 rows
+std::vector<uint8_t> readPixels(const std::shared_ptr<igl::ITexture>& texture,
+                                igl::IDevice& device,
+                                bool flipY) {
   IGL_DEBUG_ASSERT(texture);
   IGL_DEBUG_ASSERT(texture->getType() == igl::TextureType::TwoD);
   IGL_DEBUG_ASSERT(isSupportedBitmapTextureFormat(texture->getFormat()));
@@ -92,7 +77,7 @@ void writeBitmap(std::ostream& stream,
   igl::Result result;
   const auto commandQueue = device.createCommandQueue(desc, &result);
   if (!IGL_DEBUG_VERIFY(result.isOk()) || !IGL_DEBUG_VERIFY(commandQueue)) {
-    return;
+    return {};
   }
 
   textureAccessor->requestBytes(*commandQueue, nullptr);
@@ -104,26 +89,60 @@ void writeBitmap(std::ostream& stream,
   const auto& properties = texture->getProperties();
   const uint32_t bytesPerRow = properties.getBytesPerRow(textureRange);
 
-  std::vector<uint8_t> imageData;
-  imageData.reserve(size.width * size.height * 3);
+  std::vector<uint8_t> pixels;
+  pixels.reserve(size.width * size.height * 4);
 
   IGL_DEBUG_ASSERT(buffer.size() == size.height * bytesPerRow);
 
   const auto bufferOffsets = getBufferOffsets(texture->getFormat());
+  const bool isOpaque = texture->getFormat() == igl::TextureFormat::RGBX_UNorm8;
 
   for (size_t y = 0; y < size.height; ++y) {
     const size_t row = flipY ? size.height - y - 1 : y;
     for (size_t byte = 0; byte < bytesPerRow; byte += 4) {
       const size_t index = row * bytesPerRow + byte;
-      const uint8_t r = buffer[index + bufferOffsets.r];
-      const uint8_t g = buffer[index + bufferOffsets.g];
-      const uint8_t b = buffer[index + bufferOffsets.b];
-
-      imageData.push_back(b);
-      imageData.push_back(g);
-      imageData.push_back(r);
+      pixels.push_back(buffer[index + bufferOffsets.r]);
+      pixels.push_back(buffer[index + bufferOffsets.g]);
+      pixels.push_back(buffer[index + bufferOffsets.b]);
+      pixels.push_back(isOpaque ? 255 : buffer[index + 3]);
     }
   }
+  return pixels;
+}
+
+} // namespace
+
+bool isSupportedBitmapTextureFormat(igl::TextureFormat format) {
+  switch (format) {
+  case igl::TextureFormat::RGBA_UNorm8:
+  case igl::TextureFormat::RGBX_UNorm8:
+  case igl::TextureFormat::RGBA_SRGB:
+  case igl::TextureFormat::BGRA_UNorm8:
+  case igl::TextureFormat::BGRA_SRGB:
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+void writeBitmap(std::ostream& stream,
+                 std::shared_ptr<igl::ITexture> texture,
+                 igl::IDevice& device,
+                 bool flipY) {
+  const auto pixels = readPixels(texture, device, flipY);
+  if (pixels.empty()) {
+    return;
+  }
+
+  const auto size = texture->getSize();
+  std::vector<uint8_t> imageData;
+  imageData.reserve(size.width * size.height * 3);
+  for (size_t i = 0; i < pixels.size(); i += 4) {
+    imageData.push_back(pixels[i + 2]);
+    imageData.push_back(pixels[i + 1]);
+    imageData.push_back(pixels[i]);
+  }
 
   writeBitmap(stream, static_cast<const uint8_t*>(imageData.data()), size.width, size.height);
 }
@@ -142,4 +161,28 @@ void writeBitmap(std::ostream& stream, const uint8_t* imageData, uint32_t width,
   stream.write(reinterpret_cast<const char*>(imageData), imageSize);
 }
 
+void writeKtx2(std::ostream& stream,
+               std::shared_ptr<igl::ITexture> texture,
+               igl::IDevice& device,
+               igl::TextureFormat compressedFormat,
+               bool flipY) {
+  IGL_DEBUG_ASSERT(::iglu::textureencoder::isSupportedEncoderFormat(compressedFormat));
+
+  const auto pixels = readPixels(texture, device, flipY);
+  if (pixels.empty()) {
+    return;
+  }
+
+  const auto size = texture->getSize();
+  igl::Result result;
+  ::iglu::textureencoder::writeKtx2(stream,
+                                    pixels.data(),
+                                    static_cast<uint32_t>(size.width),
+                                    static_cast<uint32_t>(size.height),
+                                    compressedFormat,
+                                    texture->getNumMipLevels(),
+                                    &result);
+  IGL_DEBUG_ASSERT(result.isOk(), result.message.c_str());
+}
+
 } // namespace igl::iglu
@@ -23,4 +23,13 @@ void writeBitmap(std::ostream& stream,
 
 void writeBitmap(std::ostream& stream, const uint8_t* imageData, uint32_t width, uint32_t height);
 
+// Compress the contents of a texture into a block compressed format and write it to a KTX2 file.
+// Mip levels are regenerated from the base level on the CPU. See
+// iglu::textureencoder::isSupportedEncoderFormat() for the supported compressed formats.
+void writeKtx2(std::ostream& stream,
+               std::shared_ptr<igl::ITexture> texture,
+               igl::IDevice& device,
+               igl::TextureFormat compressedFormat,
+               bool flipY = false);
+
 } // namespace igl::iglu
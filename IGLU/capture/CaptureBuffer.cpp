@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/capture/CaptureBuffer.h>
+
+#include <IGLU/capture/TraceRecorder.h>
+
+namespace iglu::capture {
+
+CaptureBuffer::CaptureBuffer(std::unique_ptr<igl::IBuffer> buffer,
+                             std::shared_ptr<TraceRecorder> recorder) :
+  buffer_(std::move(buffer)), recorder_(std::move(recorder)) {
+  IGL_DEBUG_ASSERT(buffer_);
+  id_ = recorder_->registerObject(this, {}, TraceRecorder::ObjectKind::CaptureBuffer);
+}
+
+CaptureBuffer::~CaptureBuffer() {
+  recorder_->unregisterObject(this);
+  recorder_->beginRecord(TraceOp::DestroyBuffer).write(id_);
+  recorder_->endRecord();
+}
+
+igl::Result CaptureBuffer::upload(const void* IGL_NULLABLE data, const igl::BufferRange& range) {
+  recordUpload(data, range);
+  return buffer_->upload(data, range);
+}
+
+void* IGL_NULLABLE CaptureBuffer::map(const igl::BufferRange& range,
+                                      igl::Result* IGL_NULLABLE outResult) {
+  mappedData_ = buffer_->map(range, outResult);
+  mappedRange_ = range;
+  return mappedData_;
+}
+
+void CaptureBuffer::unmap() {
+  // The mapped memory holds whatever the application wrote, so record it as an upload
+  if (mappedData_) {
+    recordUpload(mappedData_, mappedRange_);
+    mappedData_ = nullptr;
+  }
+  buffer_->unmap();
+}
+
+igl::BufferDesc::BufferAPIHint CaptureBuffer::requestedApiHints() const noexcept {
+  return buffer_->requestedApiHints();
+}
+
+igl::BufferDesc::BufferAPIHint CaptureBuffer::acceptedApiHints() const noexcept {
+  return buffer_->acceptedApiHints();
+}
+
+igl::ResourceStorage CaptureBuffer::storage() const noexcept {
+  return buffer_->storage();
+}
+
+size_t CaptureBuffer::getSizeInBytes() const {
+  return buffer_->getSizeInBytes();
+}
+
+uint64_t CaptureBuffer::gpuAddress(size_t offset) const {
+  return buffer_->gpuAddress(offset);
+}
+
+igl::BufferDesc::BufferType CaptureBuffer::getBufferType() const {
+  return buffer_->getBufferType();
+}
+
+void CaptureBuffer::recordUpload(const void* IGL_NULLABLE data, const igl::BufferRange& range) {
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::BufferUpload);
+  writer.write(id_);
+  writer.write(static_cast<uint64_t>(range.offset));
+  writer.writeBlob(data, range.size);
+  recorder_->endRecord();
+}
+
+} // namespace iglu::capture
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/Buffer.h>
+#include <memory>
+
+namespace iglu::capture {
+
+class TraceRecorder;
+
+/**
+ * Forwards to a buffer created by the captured device and records uploads, including writes made
+ * through map()/unmap().
+ */
+class CaptureBuffer final : public igl::IBuffer {
+ public:
+  CaptureBuffer(std::unique_ptr<igl::IBuffer> buffer, std::shared_ptr<TraceRecorder> recorder);
+  ~CaptureBuffer() override;
+
+  [[nodiscard]] igl::Result upload(const void* IGL_NULLABLE data,
+                                   const igl::BufferRange& range) final;
+  void* IGL_NULLABLE map(const igl::BufferRange& range, igl::Result* IGL_NULLABLE outResult) final;
+  void unmap() final;
+  [[nodiscard]] igl::BufferDesc::BufferAPIHint requestedApiHints() const noexcept final;
+  [[nodiscard]] igl::BufferDesc::BufferAPIHint acceptedApiHints() const noexcept final;
+  [[nodiscard]] igl::ResourceStorage storage() const noexcept final;
+  [[nodiscard]] size_t getSizeInBytes() const final;
+  [[nodiscard]] uint64_t gpuAddress(size_t offset = 0) const final;
+  [[nodiscard]] igl::BufferDesc::BufferType getBufferType() const final;
+
+  [[nodiscard]] uint32_t id() const noexcept {
+    return id_;
+  }
+  [[nodiscard]] igl::IBuffer& buffer() const noexcept {
+    return *buffer_;
+  }
+
+ private:
+  void recordUpload(const void* IGL_NULLABLE data, const igl::BufferRange& range);
+
+  std::unique_ptr<igl::IBuffer> buffer_;
+  std::shared_ptr<TraceRecorder> recorder_;
+  uint32_t id_ = 0;
+  void* IGL_NULLABLE mappedData_ = nullptr;
+  igl::BufferRange mappedRange_;
+};
+
+} // namespace iglu::capture
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/capture/CaptureCommandBuffer.h>
+
+#include <IGLU/capture/CaptureComputeCommandEncoder.h>
+#include <IGLU/capture/CaptureRenderCommandEncoder.h>
+#include <IGLU/capture/TraceRecorder.h>
+
+namespace iglu::capture {
+
+CaptureCommandBuffer::CaptureCommandBuffer(std::shared_ptr<igl::ICommandBuffer> commandBuffer,
+                                           std::shared_ptr<TraceRecorder> recorder,
+                                           uint32_t id) :
+  commandBuffer_(std::move(commandBuffer)), recorder_(std::move(recorder)), id_(id) {
+  IGL_DEBUG_ASSERT(commandBuffer_);
+}
+
+std::unique_ptr<igl::IRenderCommandEncoder> CaptureCommandBuffer::createRenderCommandEncoder(
+    const igl::RenderPassDesc& renderPass,
+    const std::shared_ptr<igl::IFramebuffer>& framebuffer,
+    const igl::Dependencies& dependencies,
+    igl::Result* IGL_NULLABLE outResult) {
+  const CapturedDependencies captured(*recorder_, dependencies);
+  auto encoder = commandBuffer_->createRenderCommandEncoder(
+      renderPass, framebuffer, captured.get(), outResult);
+  if (!encoder) {
+    return nullptr;
+  }
+
+  // Framebuffers are not wrapped, so the drawables they render into are recorded here. This catches
+  // updateDrawable() calls made since the framebuffer was created.
+  const uint32_t framebufferId = recorder_->findObject(framebuffer.get());
+  const uint32_t colorId =
+      framebuffer ? recorder_->textureId(framebuffer->getColorAttachment(0)) : 0;
+  const uint32_t depthId =
+      framebuffer ? recorder_->textureId(framebuffer->getDepthAttachment()) : 0;
+  const uint32_t encoderId = recorder_->allocateId();
+
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateRenderCommandEncoder);
+  writer.write(id_);
+  writer.write(encoderId);
+  write(writer, renderPass);
+  writer.write(framebufferId);
+  writer.write(colorId);
+  writer.write(depthId);
+  captured.write(writer);
+  recorder_->endRecord();
+
+  return std::make_unique<CaptureRenderCommandEncoder>(
+      std::move(encoder), shared_from_this(), recorder_, encoderId);
+}
+
+std::unique_ptr<igl::IComputeCommandEncoder> CaptureCommandBuffer::createComputeCommandEncoder() {
+  auto encoder = commandBuffer_->createComputeCommandEncoder();
+  if (!encoder) {
+    return nullptr;
+  }
+  const uint32_t encoderId = recorder_->allocateId();
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateComputeCommandEncoder);
+  writer.write(id_);
+  writer.write(encoderId);
+  recorder_->endRecord();
+  return std::make_unique<CaptureComputeCommandEncoder>(std::move(encoder), recorder_, encoderId);
+}
+
+void CaptureCommandBuffer::present(const std::shared_ptr<igl::ITexture>& surface) const {
+  const uint32_t surfaceId = recorder_->textureId(surface);
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::Present);
+  writer.write(id_);
+  writer.write(surfaceId);
+  recorder_->endRecord();
+  commandBuffer_->present(unwrapTexture(*recorder_, surface));
+}
+
+void CaptureCommandBuffer::waitUntilScheduled() {
+  recorder_->beginRecord(TraceOp::WaitUntilScheduled).write(id_);
+  recorder_->endRecord();
+  commandBuffer_->waitUntilScheduled();
+}
+
+void CaptureCommandBuffer::waitUntilCompleted() {
+  recorder_->beginRecord(TraceOp::WaitUntilCompleted).write(id_);
+  recorder_->endRecord();
+  commandBuffer_->waitUntilCompleted();
+}
+
+void CaptureCommandBuffer::pushDebugGroupLabel(const char* IGL_NONNULL label,
+                                               const igl::Color& color) const {
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::PushDebugGroupLabel);
+  writer.write(id_);
+  writer.writeString(label);
+  write(writer, color);
+  recorder_->endRecord();
+  commandBuffer_->pushDebugGroupLabel(label, color);
+}
+
+void CaptureCommandBuffer::popDebugGroupLabel() const {
+  recorder_->beginRecord(TraceOp::PopDebugGroupLabel).write(id_);
+  recorder_->endRecord();
+  commandBuffer_->popDebugGroupLabel();
+}
+
+} // namespace iglu::capture
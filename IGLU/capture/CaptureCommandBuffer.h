@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/CommandBuffer.h>
+#include <memory>
+
+namespace iglu::capture {
+
+class TraceRecorder;
+
+/// Wraps the encoders it creates in capture encoders and records presents, waits and labels.
+class CaptureCommandBuffer final : public igl::ICommandBuffer,
+                                   public std::enable_shared_from_this<CaptureCommandBuffer> {
+ public:
+  CaptureCommandBuffer(std::shared_ptr<igl::ICommandBuffer> commandBuffer,
+                       std::shared_ptr<TraceRecorder> recorder,
+                       uint32_t id);
+
+  [[nodiscard]] std::unique_ptr<igl::IRenderCommandEncoder> createRenderCommandEncoder(
+      const igl::RenderPassDesc& renderPass,
+      const std::shared_ptr<igl::IFramebuffer>& framebuffer,
+      const igl::Dependencies& dependencies,
+      igl::Result* IGL_NULLABLE outResult) final;
+  [[nodiscard]] std::unique_ptr<igl::IComputeCommandEncoder> createComputeCommandEncoder() final;
+  void present(const std::shared_ptr<igl::ITexture>& surface) const final;
+  void waitUntilScheduled() final;
+  void waitUntilCompleted() final;
+  void pushDebugGroupLabel(const char* IGL_NONNULL label,
+                           const igl::Color& color = igl::Color(1, 1, 1, 1)) const final;
+  void popDebugGroupLabel() const final;
+
+  [[nodiscard]] uint32_t id() const noexcept {
+    return id_;
+  }
+  [[nodiscard]] const igl::ICommandBuffer& commandBuffer() const noexcept {
+    return *commandBuffer_;
+  }
+  [[nodiscard]] igl::ICommandBuffer& commandBuffer() noexcept {
+    return *commandBuffer_;
+  }
+
+ private:
+  std::shared_ptr<igl::ICommandBuffer> commandBuffer_;
+  std::shared_ptr<TraceRecorder> recorder_;
+  uint32_t id_;
+};
+
+} // namespace iglu::capture
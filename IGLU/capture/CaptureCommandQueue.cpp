@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/capture/CaptureCommandQueue.h>
+
+#include <IGLU/capture/CaptureCommandBuffer.h>
+#include <IGLU/capture/TraceRecorder.h>
+
+namespace iglu::capture {
+
+CaptureCommandQueue::CaptureCommandQueue(std::shared_ptr<igl::ICommandQueue> commandQueue,
+                                         std::shared_ptr<TraceRecorder> recorder,
+                                         uint32_t id) :
+  commandQueue_(std::move(commandQueue)), recorder_(std::move(recorder)), id_(id) {
+  IGL_DEBUG_ASSERT(commandQueue_);
+}
+
+std::shared_ptr<igl::ICommandBuffer> CaptureCommandQueue::createCommandBuffer(
+    const igl::CommandBufferDesc& desc,
+    igl::Result* IGL_NULLABLE outResult) {
+  auto commandBuffer = commandQueue_->createCommandBuffer(desc, outResult);
+  if (!commandBuffer) {
+    return nullptr;
+  }
+  const uint32_t commandBufferId = recorder_->allocateId();
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateCommandBuffer);
+  writer.write(id_);
+  writer.write(commandBufferId);
+  writer.writeString(desc.debugName);
+  recorder_->endRecord();
+  return std::make_shared<CaptureCommandBuffer>(
+      std::move(commandBuffer), recorder_, commandBufferId);
+}
+
+igl::SubmitHandle CaptureCommandQueue::submit(const igl::ICommandBuffer& commandBuffer,
+                                              bool endOfFrame) {
+  const auto& captureBuffer = static_cast<const CaptureCommandBuffer&>(commandBuffer);
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::Submit);
+  writer.write(id_);
+  writer.write(captureBuffer.id());
+  writer.write(endOfFrame);
+  recorder_->endRecord();
+
+  const igl::ICommandBuffer& inner = captureBuffer.commandBuffer();
+  incrementDrawCount(inner.getCurrentDrawCount());
+  return commandQueue_->submit(inner, endOfFrame);
+}
+
+} // namespace iglu::capture
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/CommandQueue.h>
+#include <memory>
+
+namespace iglu::capture {
+
+class TraceRecorder;
+
+/// Hands out capture command buffers and records submissions.
+class CaptureCommandQueue final : public igl::ICommandQueue {
+ public:
+  CaptureCommandQueue(std::shared_ptr<igl::ICommandQueue> commandQueue,
+                      std::shared_ptr<TraceRecorder> recorder,
+                      uint32_t id);
+
+  [[nodiscard]] std::shared_ptr<igl::ICommandBuffer> createCommandBuffer(
+      const igl::CommandBufferDesc& desc,
+      igl::Result* IGL_NULLABLE outResult) final;
+  igl::SubmitHandle submit(const igl::ICommandBuffer& commandBuffer, bool endOfFrame) final;
+
+  [[nodiscard]] uint32_t id() const noexcept {
+    return id_;
+  }
+  [[nodiscard]] igl::ICommandQueue& commandQueue() const noexcept {
+    return *commandQueue_;
+  }
+
+ private:
+  std::shared_ptr<igl::ICommandQueue> commandQueue_;
+  std::shared_ptr<TraceRecorder> recorder_;
+  uint32_t id_;
+};
+
+} // namespace iglu::capture
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/capture/CaptureComputeCommandEncoder.h>
+
+#include <IGLU/capture/TraceRecorder.h>
+
+namespace iglu::capture {
+
+CaptureComputeCommandEncoder::CaptureComputeCommandEncoder(
+    std::unique_ptr<igl::IComputeCommandEncoder> encoder,
+    std::shared_ptr<TraceRecorder> recorder,
+    uint32_t id) :
+  encoder_(std::move(encoder)), recorder_(std::move(recorder)), id_(id) {
+  IGL_DEBUG_ASSERT(encoder_);
+}
+
+TraceWriter& CaptureComputeCommandEncoder::beginRecord(TraceOp op) const {
+  TraceWriter& writer = recorder_->beginRecord(op);
+  writer.write(id_);
+  return writer;
+}
+
+void CaptureComputeCommandEncoder::endRecord() const {
+  recorder_->endRecord();
+}
+
+void CaptureComputeCommandEncoder::endEncoding() {
+  beginRecord(TraceOp::EndEncoding);
+  endRecord();
+  encoder_->endEncoding();
+}
+
+void CaptureComputeCommandEncoder::pushDebugGroupLabel(const char* IGL_NONNULL label,
+                                                       const igl::Color& color) const {
+  TraceWriter& writer = beginRecord(TraceOp::PushDebugGroupLabel);
+  writer.writeString(label);
+  write(writer, color);
+  endRecord();
+  encoder_->pushDebugGroupLabel(label, color);
+}
+
+void CaptureComputeCommandEncoder::insertDebugEventLabel(const char* IGL_NONNULL label,
+                                                         const igl::Color& color) const {
+  TraceWriter& writer = beginRecord(TraceOp::InsertDebugEventLabel);
+  writer.writeString(label);
+  write(writer, color);
+  endRecord();
+  encoder_->insertDebugEventLabel(label, color);
+}
+
+void CaptureComputeCommandEncoder::popDebugGroupLabel() const {
+  beginRecord(TraceOp::PopDebugGroupLabel);
+  endRecord();
+  encoder_->popDebugGroupLabel();
+}
+
+void CaptureComputeCommandEncoder::bindUniform(const igl::UniformDesc& uniformDesc,
+                                               const void* IGL_NONNULL data) {
+  write(beginRecord(TraceOp::ComputeBindUniform), uniformDesc, data);
+  endRecord();
+  encoder_->bindUniform(uniformDesc, data);
+}
+
+void CaptureComputeCommandEncoder::bindTexture(uint32_t index,
+                                               igl::ITexture* IGL_NULLABLE texture) {
+  const uint32_t textureId = recorder_->textureId(texture);
+  TraceWriter& writer = beginRecord(TraceOp::ComputeBindTexture);
+  writer.write(index);
+  writer.write(textureId);
+  endRecord();
+  encoder_->bindTexture(index, unwrapTexture(*recorder_, texture));
+}
+
+void CaptureComputeCommandEncoder::bindBuffer(uint32_t index,
+                                              igl::IBuffer* IGL_NULLABLE buffer,
+                                              size_t offset,
+                                              size_t bufferSize) {
+  TraceWriter& writer = beginRecord(TraceOp::ComputeBindBuffer);
+  writer.write(index);
+  writer.write(recorder_->findObject(buffer));
+  writer.write(static_cast<uint64_t>(offset));
+  writer.write(static_cast<uint64_t>(bufferSize));
+  endRecord();
+  encoder_->bindBuffer(index, unwrapBuffer(*recorder_, buffer), offset, bufferSize);
+}
+
+void CaptureComputeCommandEncoder::bindBytes(size_t index,
+                                             const void* IGL_NULLABLE data,
+                                             size_t length) {
+  TraceWriter& writer = beginRecord(TraceOp::ComputeBindBytes);
+  writer.write(static_cast<uint64_t>(index));
+  writer.writeBlob(data, length);
+  endRecord();
+  encoder_->bindBytes(index, data, length);
+}
+
+void CaptureComputeCommandEncoder::bindPushConstants(const void* IGL_NONNULL data,
+                                                     size_t length,
+                                                     size_t offset) {
+  TraceWriter& writer = beginRecord(TraceOp::ComputeBindPushConstants);
+  writer.write(static_cast<uint64_t>(offset));
+  writer.writeBlob(data, length);
+  endRecord();
+  encoder_->bindPushConstants(data, length, offset);
+}
+
+void CaptureComputeCommandEncoder::bindComputePipelineState(
+    const std::shared_ptr<igl::IComputePipelineState>& pipelineState) {
+  beginRecord(TraceOp::ComputeBindComputePipelineState)
+      .write(recorder_->findObject(pipelineState.get()));
+  endRecord();
+  encoder_->bindComputePipelineState(pipelineState);
+}
+
+void CaptureComputeCommandEncoder::dispatchThreadGroups(const igl::Dimensions& threadgroupCount,
+                                                        const igl::Dimensions& threadgroupSize,
+                                                        const igl::Dependencies& dependencies) {
+  const CapturedDependencies captured(*recorder_, dependencies);
+  TraceWriter& writer = beginRecord(TraceOp::ComputeDispatchThreadGroups);
+  writer.write(threadgroupCount);
+  writer.write(threadgroupSize);
+  captured.write(writer);
+  endRecord();
+  encoder_->dispatchThreadGroups(threadgroupCount, threadgroupSize, captured.get());
+}
+
+} // namespace iglu::capture
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <IGLU/capture/TraceFormat.h>
+#include <igl/ComputeCommandEncoder.h>
+#include <memory>
+
+namespace iglu::capture {
+
+class TraceRecorder;
+
+/// Records every call into the trace before forwarding it to the captured device's encoder.
+class CaptureComputeCommandEncoder final : public igl::IComputeCommandEncoder {
+ public:
+  CaptureComputeCommandEncoder(std::unique_ptr<igl::IComputeCommandEncoder> encoder,
+                               std::shared_ptr<TraceRecorder> recorder,
+                               uint32_t id);
+
+  void endEncoding() final;
+  void pushDebugGroupLabel(const char* IGL_NONNULL label,
+                           const igl::Color& color = igl::Color(1, 1, 1, 1)) const final;
+  void insertDebugEventLabel(const char* IGL_NONNULL label,
+                             const igl::Color& color = igl::Color(1, 1, 1, 1)) const final;
+  void popDebugGroupLabel() const final;
+
+  void bindUniform(const igl::UniformDesc& uniformDesc, const void* IGL_NONNULL data) final;
+  void bindTexture(uint32_t index, igl::ITexture* IGL_NULLABLE texture) final;
+  void bindBuffer(uint32_t index,
+                  igl::IBuffer* IGL_NULLABLE buffer,
+                  size_t offset,
+                  size_t bufferSize) final;
+  void bindBytes(size_t index, const void* IGL_NULLABLE data, size_t length) final;
+  void bindPushConstants(const void* IGL_NONNULL data, size_t length, size_t offset) final;
+  void bindComputePipelineState(
+      const std::shared_ptr<igl::IComputePipelineState>& pipelineState) final;
+  void dispatchThreadGroups(const igl::Dimensions& threadgroupCount,
+                            const igl::Dimensions& threadgroupSize,
+                            const igl::Dependencies& dependencies) final;
+
+ private:
+  /// Starts a record whose payload begins with this encoder's id.
+  TraceWriter& beginRecord(TraceOp op) const;
+  void endRecord() const;
+
+  std::unique_ptr<igl::IComputeCommandEncoder> encoder_;
+  std::shared_ptr<TraceRecorder> recorder_;
+  uint32_t id_;
+};
+
+} // namespace iglu::capture
@@ -0,0 +1,463 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/capture/CaptureDevice.h>
+
+#include <IGLU/capture/CaptureBuffer.h>
+#include <IGLU/capture/CaptureCommandQueue.h>
+#include <IGLU/capture/CaptureShaderStages.h>
+#include <IGLU/capture/CaptureTexture.h>
+#include <igl/CommandEncoder.h>
+#include <igl/CommandQueue.h>
+#include <igl/ComputePipelineState.h>
+#include <igl/Framebuffer.h>
+#include <igl/RenderPipelineState.h>
+#include <igl/Shader.h>
+
+namespace iglu::capture {
+
+namespace {
+
+void writeAttachment(TraceRecorder& recorder,
+                     TraceWriter& writer,
+                     const igl::FramebufferDesc::AttachmentDesc& attachment) {
+  writer.write(recorder.findObject(attachment.texture.get()));
+  writer.write(recorder.findObject(attachment.resolveTexture.get()));
+}
+
+void writeShaderInput(TraceWriter& writer, const igl::ShaderInput& input) {
+  writer.write(input.type);
+  if (input.type == igl::ShaderInputType::String) {
+    writer.writeString(input.source ? input.source : "");
+    writer.write(input.options.fastMathEnabled);
+  } else {
+    writer.writeBlob(input.data, input.data ? input.length : 0);
+  }
+}
+
+} // namespace
+
+CaptureDevice::CaptureDevice(std::shared_ptr<igl::IDevice> device) :
+  device_(std::move(device)), recorder_(std::make_shared<TraceRecorder>()) {
+  IGL_DEBUG_ASSERT(device_);
+}
+
+igl::Holder<igl::BindGroupTextureHandle> CaptureDevice::createBindGroup(
+    const igl::BindGroupTextureDesc& desc,
+    const igl::IRenderPipelineState* IGL_NULLABLE compatiblePipeline,
+    igl::Result* IGL_NULLABLE outResult) {
+  igl::BindGroupTextureDesc unwrapped = desc;
+  for (auto& texture : unwrapped.textures) {
+    texture = unwrapTexture(*recorder_, texture);
+  }
+  igl::Holder<igl::BindGroupTextureHandle> holder =
+      device_->createBindGroup(unwrapped, compatiblePipeline, outResult);
+  if (holder.empty()) {
+    return {};
+  }
+
+  uint32_t textureIds[igl::IGL_TEXTURE_SAMPLERS_MAX] = {};
+  for (uint32_t i = 0; i != igl::IGL_TEXTURE_SAMPLERS_MAX; ++i) {
+    textureIds[i] = recorder_->textureId(desc.textures[i]);
+  }
+  // Re-target the holder at this device so that destroying the bind group is recorded
+  const igl::BindGroupTextureHandle handle = holder.release();
+  const uint32_t id = recorder_->registerBindGroup(handle);
+
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateTextureBindGroup);
+  writer.write(id);
+  writer.write(recorder_->findObject(compatiblePipeline));
+  writer.write(static_cast<uint32_t>(igl::IGL_TEXTURE_SAMPLERS_MAX));
+  for (uint32_t i = 0; i != igl::IGL_TEXTURE_SAMPLERS_MAX; ++i) {
+    writer.write(textureIds[i]);
+    writer.write(recorder_->findObject(desc.samplers[i].get()));
+  }
+  writer.writeString(desc.debugName);
+  recorder_->endRecord();
+
+  return {this, handle};
+}
+
+igl::Holder<igl::BindGroupBufferHandle> CaptureDevice::createBindGroup(
+    const igl::BindGroupBufferDesc& desc,
+    igl::Result* IGL_NULLABLE outResult) {
+  igl::BindGroupBufferDesc unwrapped = desc;
+  for (auto& buffer : unwrapped.buffers) {
+    if (recorder_->isCaptureBuffer(buffer.get())) {
+      // Aliasing keeps the capture buffer, and with it the wrapped buffer, alive
+      buffer = std::shared_ptr<igl::IBuffer>(buffer, unwrapBuffer(*recorder_, buffer.get()));
+    }
+  }
+  igl::Holder<igl::BindGroupBufferHandle> holder = device_->createBindGroup(unwrapped, outResult);
+  if (holder.empty()) {
+    return {};
+  }
+
+  const igl::BindGroupBufferHandle handle = holder.release();
+  const uint32_t id = recorder_->registerBindGroup(handle);
+
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateBufferBindGroup);
+  writer.write(id);
+  writer.write(static_cast<uint32_t>(igl::IGL_UNIFORM_BLOCKS_BINDING_MAX));
+  for (uint32_t i = 0; i != igl::IGL_UNIFORM_BLOCKS_BINDING_MAX; ++i) {
+    writer.write(recorder_->findObject(desc.buffers[i].get()));
+    writer.write(static_cast<uint64_t>(desc.offset[i]));
+    writer.write(static_cast<uint64_t>(desc.size[i]));
+  }
+  writer.write(desc.isDynamicBufferMask);
+  writer.writeString(desc.debugName);
+  recorder_->endRecord();
+
+  return {this, handle};
+}
+
+void CaptureDevice::destroy(igl::BindGroupTextureHandle handle) {
+  if (const uint32_t id = recorder_->findBindGroup(handle, true)) {
+    recorder_->beginRecord(TraceOp::DestroyTextureBindGroup).write(id);
+    recorder_->endRecord();
+  }
+  device_->destroy(handle);
+}
+
+void CaptureDevice::destroy(igl::BindGroupBufferHandle handle) {
+  if (const uint32_t id = recorder_->findBindGroup(handle, true)) {
+    recorder_->beginRecord(TraceOp::DestroyBufferBindGroup).write(id);
+    recorder_->endRecord();
+  }
+  device_->destroy(handle);
+}
+
+void CaptureDevice::destroy(igl::SamplerHandle handle) {
+  device_->destroy(handle);
+}
+
+bool CaptureDevice::hasFeature(igl::DeviceFeatures feature) const {
+  return device_->hasFeature(feature);
+}
+
+bool CaptureDevice::hasRequirement(igl::DeviceRequirement requirement) const {
+  return device_->hasRequirement(requirement);
+}
+
+igl::ICapabilities::TextureFormatCapabilities CaptureDevice::getTextureFormatCapabilities(
+    igl::TextureFormat format) const {
+  return device_->getTextureFormatCapabilities(format);
+}
+
+bool CaptureDevice::getFeatureLimits(igl::DeviceFeatureLimits featureLimits,
+                                     size_t& result) const {
+  return device_->getFeatureLimits(featureLimits, result);
+}
+
+igl::ShaderVersion CaptureDevice::getShaderVersion() const {
+  return device_->getShaderVersion();
+}
+
+igl::BackendVersion CaptureDevice::getBackendVersion() const {
+  return device_->getBackendVersion();
+}
+
+std::shared_ptr<igl::ICommandQueue> CaptureDevice::createCommandQueue(
+    const igl::CommandQueueDesc& desc,
+    igl::Result* IGL_NULLABLE outResult) {
+  auto commandQueue = device_->createCommandQueue(desc, outResult);
+  if (!commandQueue) {
+    return nullptr;
+  }
+  const uint32_t id = recorder_->allocateId();
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateCommandQueue);
+  writer.write(id);
+  writer.write(desc.type);
+  recorder_->endRecord();
+  return std::make_shared<CaptureCommandQueue>(std::move(commandQueue), recorder_, id);
+}
+
+std::unique_ptr<igl::IBuffer> CaptureDevice::createBuffer(const igl::BufferDesc& desc,
+                                                          igl::Result* IGL_NULLABLE
+                                                              outResult) const noexcept {
+  auto buffer = device_->createBuffer(desc, outResult);
+  if (!buffer) {
+    return nullptr;
+  }
+  auto captureBuffer = std::make_unique<CaptureBuffer>(std::move(buffer), recorder_);
+
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateBuffer);
+  writer.write(captureBuffer->id());
+  writer.write(desc.type);
+  writer.write(desc.hint);
+  writer.write(desc.storage);
+  writer.write(static_cast<uint64_t>(desc.length));
+  writer.writeBlob(desc.data, desc.data ? desc.length : 0);
+  writer.writeString(desc.debugName);
+  recorder_->endRecord();
+
+  return captureBuffer;
+}
+
+std::shared_ptr<igl::IDepthStencilState> CaptureDevice::createDepthStencilState(
+    const igl::DepthStencilStateDesc& desc,
+    igl::Result* IGL_NULLABLE outResult) const {
+  auto state = device_->createDepthStencilState(desc, outResult);
+  if (state) {
+    TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateDepthStencilState);
+    writer.write(recorder_->registerObject(state));
+    write(writer, desc);
+    recorder_->endRecord();
+  }
+  return state;
+}
+
+std::shared_ptr<igl::ISamplerState> CaptureDevice::createSamplerState(
+    const igl::SamplerStateDesc& desc,
+    igl::Result* IGL_NULLABLE outResult) const {
+  auto state = device_->createSamplerState(desc, outResult);
+  if (state) {
+    TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateSamplerState);
+    writer.write(recorder_->registerObject(state));
+    write(writer, desc);
+    recorder_->endRecord();
+  }
+  return state;
+}
+
+std::shared_ptr<igl::ITexture> CaptureDevice::createTexture(const igl::TextureDesc& desc,
+                                                            igl::Result* IGL_NULLABLE
+                                                                outResult) const noexcept {
+  auto texture = device_->createTexture(desc, outResult);
+  if (!texture) {
+    return nullptr;
+  }
+  auto captureTexture = std::make_shared<CaptureTexture>(std::move(texture), recorder_);
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateTexture);
+  writer.write(captureTexture->id());
+  write(writer, desc);
+  recorder_->endRecord();
+  return captureTexture;
+}
+
+std::shared_ptr<igl::IVertexInputState> CaptureDevice::createVertexInputState(
+    const igl::VertexInputStateDesc& desc,
+    igl::Result* IGL_NULLABLE outResult) const {
+  auto state = device_->createVertexInputState(desc, outResult);
+  if (state) {
+    TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateVertexInputState);
+    writer.write(recorder_->registerObject(state));
+    write(writer, desc);
+    recorder_->endRecord();
+  }
+  return state;
+}
+
+std::shared_ptr<igl::IComputePipelineState> CaptureDevice::createComputePipeline(
+    const igl::ComputePipelineDesc& desc,
+    igl::Result* IGL_NULLABLE outResult) const {
+  igl::ComputePipelineDesc unwrapped = desc;
+  unwrapped.shaderStages = unwrapShaderStages(*recorder_, desc.shaderStages);
+  auto pipeline = device_->createComputePipeline(unwrapped, outResult);
+  if (pipeline) {
+    TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateComputePipeline);
+    writer.write(recorder_->registerObject(pipeline));
+    write(writer, desc.imagesMap);
+    write(writer, desc.buffersMap);
+    writer.write(recorder_->findObject(desc.shaderStages.get()));
+    writer.writeString(desc.debugName);
+    recorder_->endRecord();
+  }
+  return pipeline;
+}
+
+std::shared_ptr<igl::IRenderPipelineState> CaptureDevice::createRenderPipeline(
+    const igl::RenderPipelineDesc& desc,
+    igl::Result* IGL_NULLABLE outResult) const {
+  igl::RenderPipelineDesc unwrapped = desc;
+  unwrapped.shaderStages = unwrapShaderStages(*recorder_, desc.shaderStages);
+  auto pipeline = device_->createRenderPipeline(unwrapped, outResult);
+  if (pipeline) {
+    TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateRenderPipeline);
+    writer.write(recorder_->registerObject(pipeline));
+    writer.write(desc.topology);
+    writer.write(recorder_->findObject(desc.vertexInputState.get()));
+    writer.write(recorder_->findObject(desc.shaderStages.get()));
+    write(writer, desc.targetDesc);
+    writer.write(desc.cullMode);
+    writer.write(desc.frontFaceWinding);
+    writer.write(desc.polygonFillMode);
+    write(writer, desc.vertexUnitSamplerMap);
+    write(writer, desc.fragmentUnitSamplerMap);
+    write(writer, desc.uniformBlockBindingMap);
+    writer.write(desc.sampleCount);
+    writer.write(desc.isDynamicBufferMask);
+    writer.write(static_cast<uint32_t>(igl::IGL_TEXTURE_SAMPLERS_MAX));
+    for (const auto& sampler : desc.immutableSamplers) {
+      writer.write(recorder_->findObject(sampler.get()));
+    }
+    writer.writeString(desc.debugName.toString());
+    recorder_->endRecord();
+  }
+  return pipeline;
+}
+
+std::shared_ptr<igl::IShaderModule> CaptureDevice::createShaderModule(
+    const igl::ShaderModuleDesc& desc,
+    igl::Result* IGL_NULLABLE outResult) const {
+  auto shaderModule = device_->createShaderModule(desc, outResult);
+  if (shaderModule) {
+    TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateShaderModule);
+    writer.write(recorder_->registerObject(shaderModule));
+    writer.write(desc.info.stage);
+    writer.writeString(desc.info.entryPoint);
+    writer.writeString(desc.info.debugName);
+    writeShaderInput(writer, desc.input);
+    writer.writeString(desc.debugName);
+    recorder_->endRecord();
+  }
+  return shaderModule;
+}
+
+std::shared_ptr<igl::IFramebuffer> CaptureDevice::createFramebuffer(
+    const igl::FramebufferDesc& desc,
+    igl::Result* IGL_NULLABLE outResult) {
+  igl::FramebufferDesc unwrapped = desc;
+  for (auto& attachment : unwrapped.colorAttachments) {
+    attachment.texture = unwrapTexture(*recorder_, attachment.texture);
+    attachment.resolveTexture = unwrapTexture(*recorder_, attachment.resolveTexture);
+  }
+  for (auto* attachment : {&unwrapped.depthAttachment, &unwrapped.stencilAttachment}) {
+    attachment->texture = unwrapTexture(*recorder_, attachment->texture);
+    attachment->resolveTexture = unwrapTexture(*recorder_, attachment->resolveTexture);
+  }
+  auto framebuffer = device_->createFramebuffer(unwrapped, outResult);
+  if (!framebuffer) {
+    return nullptr;
+  }
+  // Attachments such as swapchain images may not have been created through this device
+  for (const auto& attachment : desc.colorAttachments) {
+    recorder_->textureId(attachment.texture);
+    recorder_->textureId(attachment.resolveTexture);
+  }
+  for (const auto* attachment : {&desc.depthAttachment, &desc.stencilAttachment}) {
+    recorder_->textureId(attachment->texture);
+    recorder_->textureId(attachment->resolveTexture);
+  }
+
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateFramebuffer);
+  writer.write(recorder_->registerObject(framebuffer));
+  writer.write(static_cast<uint32_t>(igl::IGL_COLOR_ATTACHMENTS_MAX));
+  for (const auto& attachment : desc.colorAttachments) {
+    writeAttachment(*recorder_, writer, attachment);
+  }
+  writeAttachment(*recorder_, writer, desc.depthAttachment);
+  writeAttachment(*recorder_, writer, desc.stencilAttachment);
+  writer.write(desc.mode);
+  writer.writeString(desc.debugName);
+  recorder_->endRecord();
+
+  return framebuffer;
+}
+
+const igl::IPlatformDevice& CaptureDevice::getPlatformDevice() const noexcept {
+  return device_->getPlatformDevice();
+}
+
+bool CaptureDevice::verifyScope() {
+  return device_->verifyScope();
+}
+
+igl::BackendType CaptureDevice::getBackendType() const {
+  return device_->getBackendType();
+}
+
+igl::NormalizedZRange CaptureDevice::getNormalizedZRange() const {
+  return device_->getNormalizedZRange();
+}
+
+size_t CaptureDevice::getCurrentDrawCount() const {
+  return device_->getCurrentDrawCount();
+}
+
+std::unique_ptr<igl::IShaderLibrary> CaptureDevice::createShaderLibrary(
+    const igl::ShaderLibraryDesc& desc,
+    igl::Result* IGL_NULLABLE outResult) const {
+  auto library = device_->createShaderLibrary(desc, outResult);
+  if (!library) {
+    return nullptr;
+  }
+  const uint32_t id = recorder_->allocateId();
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateShaderLibrary);
+  writer.write(id);
+  writer.write(static_cast<uint32_t>(desc.moduleInfo.size()));
+  for (const auto& info : desc.moduleInfo) {
+    writer.write(info.stage);
+    writer.writeString(info.entryPoint);
+    writer.writeString(info.debugName);
+  }
+  writeShaderInput(writer, desc.input);
+  writer.writeString(desc.debugName);
+  recorder_->endRecord();
+
+  // Each module gets a record of its own so that shader stages can refer to it like to any other
+  // module. The library keeps its modules alive, so their ids outlive this call.
+  for (const auto& info : desc.moduleInfo) {
+    auto shaderModule = library->getShaderModule(info.stage, info.entryPoint);
+    if (!shaderModule) {
+      continue;
+    }
+    const uint32_t moduleId = recorder_->registerObject(shaderModule);
+    TraceWriter& moduleWriter = recorder_->beginRecord(TraceOp::CreateLibraryShaderModule);
+    moduleWriter.write(moduleId);
+    moduleWriter.write(id);
+    moduleWriter.write(info.stage);
+    moduleWriter.writeString(info.entryPoint);
+    recorder_->endRecord();
+  }
+  return library;
+}
+
+void CaptureDevice::updateSurface(void* IGL_NONNULL nativeWindowType) {
+  device_->updateSurface(nativeWindowType);
+}
+
+std::unique_ptr<igl::IShaderStages> CaptureDevice::createShaderStages(
+    const igl::ShaderStagesDesc& desc,
+    igl::Result* IGL_NULLABLE outResult) const {
+  auto stages = device_->createShaderStages(desc, outResult);
+  if (!stages) {
+    return nullptr;
+  }
+  auto captureStages = std::make_unique<CaptureShaderStages>(desc, std::move(stages), recorder_);
+
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::CreateShaderStages);
+  writer.write(captureStages->id());
+  writer.write(desc.type);
+  writer.write(recorder_->findObject(desc.vertexModule.get()));
+  writer.write(recorder_->findObject(desc.fragmentModule.get()));
+  writer.write(recorder_->findObject(desc.computeModule.get()));
+  writer.writeString(desc.debugName);
+  recorder_->endRecord();
+
+  return captureStages;
+}
+
+void CaptureDevice::setCurrentThread() {
+  device_->setCurrentThread();
+}
+
+void CaptureDevice::beginScope() {
+  IDevice::beginScope();
+  if (scopeDepth_++ == 0) {
+    deviceScope_.emplace(*device_);
+  }
+}
+
+void CaptureDevice::endScope() {
+  if (--scopeDepth_ == 0) {
+    deviceScope_.reset();
+  }
+  IDevice::endScope();
+}
+
+} // namespace iglu::capture
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <IGLU/capture/TraceRecorder.h>
+#include <igl/Device.h>
+#include <memory>
+#include <optional>
+
+namespace iglu::capture {
+
+/**
+ * Records every call made through it, and through the command queues, command buffers, encoders
+ * and buffers it hands out, into a binary trace before forwarding the call to the wrapped device.
+ * The trace can be saved with recorder().save() and replayed on any backend with TraceReplayer.
+ *
+ * Objects are used as returned by the wrapped device except for command queues, command buffers,
+ * encoders, buffers, textures and shader stages, so a CaptureDevice can stand in for the device
+ * anywhere in an application. Framebuffers are not wrapped: textures passed to IFramebuffer
+ * methods must be unwrapped with unwrapTexture() first.
+ */
+class CaptureDevice final : public igl::IDevice {
+ public:
+  explicit CaptureDevice(std::shared_ptr<igl::IDevice> device);
+
+  [[nodiscard]] const TraceRecorder& recorder() const noexcept {
+    return *recorder_;
+  }
+  [[nodiscard]] igl::IDevice& device() const noexcept {
+    return *device_;
+  }
+
+  [[nodiscard]] igl::Holder<igl::BindGroupTextureHandle> createBindGroup(
+      const igl::BindGroupTextureDesc& desc,
+      const igl::IRenderPipelineState* IGL_NULLABLE compatiblePipeline,
+      igl::Result* IGL_NULLABLE outResult) final;
+  [[nodiscard]] igl::Holder<igl::BindGroupBufferHandle> createBindGroup(
+      const igl::BindGroupBufferDesc& desc,
+      igl::Result* IGL_NULLABLE outResult) final;
+  void destroy(igl::BindGroupTextureHandle handle) final;
+  void destroy(igl::BindGroupBufferHandle handle) final;
+  void destroy(igl::SamplerHandle handle) final;
+
+  [[nodiscard]] bool hasFeature(igl::DeviceFeatures feature) const final;
+  [[nodiscard]] bool hasRequirement(igl::DeviceRequirement requirement) const final;
+  [[nodiscard]] TextureFormatCapabilities getTextureFormatCapabilities(
+      igl::TextureFormat format) const final;
+  [[nodiscard]] bool getFeatureLimits(igl::DeviceFeatureLimits featureLimits,
+                                      size_t& result) const final;
+  [[nodiscard]] igl::ShaderVersion getShaderVersion() const final;
+  [[nodiscard]] igl::BackendVersion getBackendVersion() const final;
+
+  [[nodiscard]] std::shared_ptr<igl::ICommandQueue> createCommandQueue(
+      const igl::CommandQueueDesc& desc,
+      igl::Result* IGL_NULLABLE outResult) final;
+  [[nodiscard]] std::unique_ptr<igl::IBuffer> createBuffer(const igl::BufferDesc& desc,
+                                                           igl::Result* IGL_NULLABLE
+                                                               outResult) const noexcept final;
+  [[nodiscard]] std::shared_ptr<igl::IDepthStencilState> createDepthStencilState(
+      const igl::DepthStencilStateDesc& desc,
+      igl::Result* IGL_NULLABLE outResult) const final;
+  [[nodiscard]] std::shared_ptr<igl::ISamplerState> createSamplerState(
+      const igl::SamplerStateDesc& desc,
+      igl::Result* IGL_NULLABLE outResult) const final;
+  [[nodiscard]] std::shared_ptr<igl::ITexture> createTexture(const igl::TextureDesc& desc,
+                                                             igl::Result* IGL_NULLABLE
+                                                                 outResult) const noexcept final;
+  [[nodiscard]] std::shared_ptr<igl::IVertexInputState> createVertexInputState(
+      const igl::VertexInputStateDesc& desc,
+      igl::Result* IGL_NULLABLE outResult) const final;
+  [[nodiscard]] std::shared_ptr<igl::IComputePipelineState> createComputePipeline(
+      const igl::ComputePipelineDesc& desc,
+      igl::Result* IGL_NULLABLE outResult) const final;
+  [[nodiscard]] std::shared_ptr<igl::IRenderPipelineState> createRenderPipeline(
+      const igl::RenderPipelineDesc& desc,
+      igl::Result* IGL_NULLABLE outResult) const final;
+  [[nodiscard]] std::shared_ptr<igl::IShaderModule> createShaderModule(
+      const igl::ShaderModuleDesc& desc,
+      igl::Result* IGL_NULLABLE outResult) const final;
+  [[nodiscard]] std::shared_ptr<igl::IFramebuffer> createFramebuffer(
+      const igl::FramebufferDesc& desc,
+      igl::Result* IGL_NULLABLE outResult) final;
+  [[nodiscard]] const igl::IPlatformDevice& getPlatformDevice() const noexcept final;
+  [[nodiscard]] bool verifyScope() final;
+  [[nodiscard]] igl::BackendType getBackendType() const final;
+  [[nodiscard]] igl::NormalizedZRange getNormalizedZRange() const final;
+  [[nodiscard]] size_t getCurrentDrawCount() const final;
+  [[nodiscard]] std::unique_ptr<igl::IShaderLibrary> createShaderLibrary(
+      const igl::ShaderLibraryDesc& desc,
+      igl::Result* IGL_NULLABLE outResult) const final;
+  void updateSurface(void* IGL_NONNULL nativeWindowType) final;
+  [[nodiscard]] std::unique_ptr<igl::IShaderStages> createShaderStages(
+      const igl::ShaderStagesDesc& desc,
+      igl::Result* IGL_NULLABLE outResult) const final;
+  void setCurrentThread() final;
+
+ protected:
+  void beginScope() final;
+  void endScope() final;
+
+ private:
+  std::shared_ptr<igl::IDevice> device_;
+  std::shared_ptr<TraceRecorder> recorder_;
+  // The wrapped device sees a single scope spanning the outermost scope opened on this device
+  std::optional<igl::DeviceScope> deviceScope_;
+  int scopeDepth_ = 0;
+};
+
+} // namespace iglu::capture
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/capture/CaptureRenderCommandEncoder.h>
+
+#include <IGLU/capture/TraceRecorder.h>
+
+namespace iglu::capture {
+
+CaptureRenderCommandEncoder::CaptureRenderCommandEncoder(
+    std::unique_ptr<igl::IRenderCommandEncoder> encoder,
+    const std::shared_ptr<igl::ICommandBuffer>& commandBuffer,
+    std::shared_ptr<TraceRecorder> recorder,
+    uint32_t id) :
+  IRenderCommandEncoder(commandBuffer),
+  encoder_(std::move(encoder)),
+  recorder_(std::move(recorder)),
+  id_(id) {
+  IGL_DEBUG_ASSERT(encoder_);
+}
+
+TraceWriter& CaptureRenderCommandEncoder::beginRecord(TraceOp op) const {
+  TraceWriter& writer = recorder_->beginRecord(op);
+  writer.write(id_);
+  return writer;
+}
+
+void CaptureRenderCommandEncoder::endRecord() const {
+  recorder_->endRecord();
+}
+
+void CaptureRenderCommandEncoder::endEncoding() {
+  beginRecord(TraceOp::EndEncoding);
+  endRecord();
+  encoder_->endEncoding();
+}
+
+void CaptureRenderCommandEncoder::pushDebugGroupLabel(const char* IGL_NONNULL label,
+                                                      const igl::Color& color) const {
+  TraceWriter& writer = beginRecord(TraceOp::PushDebugGroupLabel);
+  writer.writeString(label);
+  write(writer, color);
+  endRecord();
+  encoder_->pushDebugGroupLabel(label, color);
+}
+
+void CaptureRenderCommandEncoder::insertDebugEventLabel(const char* IGL_NONNULL label,
+                                                        const igl::Color& color) const {
+  TraceWriter& writer = beginRecord(TraceOp::InsertDebugEventLabel);
+  writer.writeString(label);
+  write(writer, color);
+  endRecord();
+  encoder_->insertDebugEventLabel(label, color);
+}
+
+void CaptureRenderCommandEncoder::popDebugGroupLabel() const {
+  beginRecord(TraceOp::PopDebugGroupLabel);
+  endRecord();
+  encoder_->popDebugGroupLabel();
+}
+
+void CaptureRenderCommandEncoder::bindViewport(const igl::Viewport& viewport) {
+  beginRecord(TraceOp::BindViewport).write(viewport);
+  endRecord();
+  encoder_->bindViewport(viewport);
+}
+
+void CaptureRenderCommandEncoder::bindScissorRect(const igl::ScissorRect& rect) {
+  beginRecord(TraceOp::BindScissorRect).write(rect);
+  endRecord();
+  encoder_->bindScissorRect(rect);
+}
+
+void CaptureRenderCommandEncoder::bindRenderPipelineState(
+    const std::shared_ptr<igl::IRenderPipelineState>& pipelineState) {
+  beginRecord(TraceOp::BindRenderPipelineState).write(recorder_->findObject(pipelineState.get()));
+  endRecord();
+  encoder_->bindRenderPipelineState(pipelineState);
+}
+
+void CaptureRenderCommandEncoder::bindDepthStencilState(
+    const std::shared_ptr<igl::IDepthStencilState>& depthStencilState) {
+  beginRecord(TraceOp::BindDepthStencilState)
+      .write(recorder_->findObject(depthStencilState.get()));
+  endRecord();
+  encoder_->bindDepthStencilState(depthStencilState);
+}
+
+void CaptureRenderCommandEncoder::bindBuffer(uint32_t index,
+                                             igl::IBuffer* IGL_NULLABLE buffer,
+                                             size_t bufferOffset,
+                                             size_t bufferSize) {
+  TraceWriter& writer = beginRecord(TraceOp::BindBuffer);
+  writer.write(index);
+  writer.write(recorder_->findObject(buffer));
+  writer.write(static_cast<uint64_t>(bufferOffset));
+  writer.write(static_cast<uint64_t>(bufferSize));
+  endRecord();
+  encoder_->bindBuffer(index, unwrapBuffer(*recorder_, buffer), bufferOffset, bufferSize);
+}
+
+void CaptureRenderCommandEncoder::bindVertexBuffer(uint32_t index,
+                                                   igl::IBuffer& buffer,
+                                                   size_t bufferOffset) {
+  TraceWriter& writer = beginRecord(TraceOp::BindVertexBuffer);
+  writer.write(index);
+  writer.write(recorder_->findObject(&buffer));
+  writer.write(static_cast<uint64_t>(bufferOffset));
+  endRecord();
+  encoder_->bindVertexBuffer(index, *unwrapBuffer(*recorder_, &buffer), bufferOffset);
+}
+
+void CaptureRenderCommandEncoder::bindIndexBuffer(igl::IBuffer& buffer,
+                                                  igl::IndexFormat format,
+                                                  size_t bufferOffset) {
+  TraceWriter& writer = beginRecord(TraceOp::BindIndexBuffer);
+  writer.write(recorder_->findObject(&buffer));
+  writer.write(format);
+  writer.write(static_cast<uint64_t>(bufferOffset));
+  endRecord();
+  encoder_->bindIndexBuffer(*unwrapBuffer(*recorder_, &buffer), format, bufferOffset);
+}
+
+void CaptureRenderCommandEncoder::bindBytes(size_t index,
+                                            uint8_t target,
+                                            const void* IGL_NULLABLE data,
+                                            size_t length) {
+  TraceWriter& writer = beginRecord(TraceOp::BindBytes);
+  writer.write(static_cast<uint64_t>(index));
+  writer.write(target);
+  writer.writeBlob(data, length);
+  endRecord();
+  encoder_->bindBytes(index, target, data, length);
+}
+
+void CaptureRenderCommandEncoder::bindPushConstants(const void* IGL_NONNULL data,
+                                                    size_t length,
+                                                    size_t offset) {
+  TraceWriter& writer = beginRecord(TraceOp::BindPushConstants);
+  writer.write(static_cast<uint64_t>(offset));
+  writer.writeBlob(data, length);
+  endRecord();
+  encoder_->bindPushConstants(data, length, offset);
+}
+
+void CaptureRenderCommandEncoder::bindSamplerState(size_t index,
+                                                   uint8_t target,
+                                                   igl::ISamplerState* IGL_NULLABLE samplerState) {
+  TraceWriter& writer = beginRecord(TraceOp::BindSamplerState);
+  writer.write(static_cast<uint64_t>(index));
+  writer.write(target);
+  writer.write(recorder_->findObject(samplerState));
+  endRecord();
+  encoder_->bindSamplerState(index, target, samplerState);
+}
+
+void CaptureRenderCommandEncoder::bindTexture(size_t index,
+                                              uint8_t target,
+                                              igl::ITexture* IGL_NULLABLE texture) {
+  const uint32_t textureId = recorder_->textureId(texture);
+  TraceWriter& writer = beginRecord(TraceOp::BindTexture);
+  writer.write(static_cast<uint64_t>(index));
+  writer.write(target);
+  writer.write(textureId);
+  endRecord();
+  encoder_->bindTexture(index, target, unwrapTexture(*recorder_, texture));
+}
+
+void CaptureRenderCommandEncoder::bindUniform(const igl::UniformDesc& uniformDesc,
+                                              const void* IGL_NONNULL data) {
+  write(beginRecord(TraceOp::BindUniform), uniformDesc, data);
+  endRecord();
+  encoder_->bindUniform(uniformDesc, data);
+}
+
+void CaptureRenderCommandEncoder::bindBindGroup(igl::BindGroupTextureHandle handle) {
+  beginRecord(TraceOp::BindTextureBindGroup).write(recorder_->findBindGroup(handle));
+  endRecord();
+  encoder_->bindBindGroup(handle);
+}
+
+void CaptureRenderCommandEncoder::bindBindGroup(igl::BindGroupBufferHandle handle,
+                                                uint32_t numDynamicOffsets,
+                                                const uint32_t* IGL_NULLABLE dynamicOffsets) {
+  TraceWriter& writer = beginRecord(TraceOp::BindBufferBindGroup);
+  writer.write(recorder_->findBindGroup(handle));
+  writer.writeBlob(dynamicOffsets, dynamicOffsets ? numDynamicOffsets * sizeof(uint32_t) : 0);
+  endRecord();
+  encoder_->bindBindGroup(handle, numDynamicOffsets, dynamicOffsets);
+}
+
+void CaptureRenderCommandEncoder::draw(size_t vertexCount,
+                                       uint32_t instanceCount,
+                                       uint32_t firstVertex,
+                                       uint32_t baseInstance) {
+  TraceWriter& writer = beginRecord(TraceOp::Draw);
+  writer.write(static_cast<uint64_t>(vertexCount));
+  writer.write(instanceCount);
+  writer.write(firstVertex);
+  writer.write(baseInstance);
+  endRecord();
+  encoder_->draw(vertexCount, instanceCount, firstVertex, baseInstance);
+}
+
+void CaptureRenderCommandEncoder::drawIndexed(size_t indexCount,
+                                              uint32_t instanceCount,
+                                              uint32_t firstIndex,
+                                              int32_t vertexOffset,
+                                              uint32_t baseInstance) {
+  TraceWriter& writer = beginRecord(TraceOp::DrawIndexed);
+  writer.write(static_cast<uint64_t>(indexCount));
+  writer.write(instanceCount);
+  writer.write(firstIndex);
+  writer.write(vertexOffset);
+  writer.write(baseInstance);
+  endRecord();
+  encoder_->drawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, baseInstance);
+}
+
+void CaptureRenderCommandEncoder::multiDrawIndirect(igl::IBuffer& indirectBuffer,
+                                                    size_t indirectBufferOffset,
+                                                    uint32_t drawCount,
+                                                    uint32_t stride) {
+  TraceWriter& writer = beginRecord(TraceOp::MultiDrawIndirect);
+  writer.write(recorder_->findObject(&indirectBuffer));
+  writer.write(static_cast<uint64_t>(indirectBufferOffset));
+  writer.write(drawCount);
+  writer.write(stride);
+  endRecord();
+  encoder_->multiDrawIndirect(
+      *unwrapBuffer(*recorder_, &indirectBuffer), indirectBufferOffset, drawCount, stride);
+}
+
+void CaptureRenderCommandEncoder::multiDrawIndexedIndirect(igl::IBuffer& indirectBuffer,
+                                                           size_t indirectBufferOffset,
+                                                           uint32_t drawCount,
+                                                           uint32_t stride) {
+  TraceWriter& writer = beginRecord(TraceOp::MultiDrawIndexedIndirect);
+  writer.write(recorder_->findObject(&indirectBuffer));
+  writer.write(static_cast<uint64_t>(indirectBufferOffset));
+  writer.write(drawCount);
+  writer.write(stride);
+  endRecord();
+  encoder_->multiDrawIndexedIndirect(
+      *unwrapBuffer(*recorder_, &indirectBuffer), indirectBufferOffset, drawCount, stride);
+}
+
+void CaptureRenderCommandEncoder::setStencilReferenceValue(uint32_t value) {
+  beginRecord(TraceOp::SetStencilReferenceValue).write(value);
+  endRecord();
+  encoder_->setStencilReferenceValue(value);
+}
+
+void CaptureRenderCommandEncoder::setBlendColor(const igl::Color& color) {
+  write(beginRecord(TraceOp::SetBlendColor), color);
+  endRecord();
+  encoder_->setBlendColor(color);
+}
+
+void CaptureRenderCommandEncoder::setDepthBias(float depthBias, float slopeScale, float clamp) {
+  TraceWriter& writer = beginRecord(TraceOp::SetDepthBias);
+  writer.write(depthBias);
+  writer.write(slopeScale);
+  writer.write(clamp);
+  endRecord();
+  encoder_->setDepthBias(depthBias, slopeScale, clamp);
+}
+
+} // namespace iglu::capture
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <IGLU/capture/TraceFormat.h>
+#include <igl/RenderCommandEncoder.h>
+#include <memory>
+
+namespace iglu::capture {
+
+class TraceRecorder;
+
+/// Records every call into the trace before forwarding it to the captured device's encoder.
+class CaptureRenderCommandEncoder final : public igl::IRenderCommandEncoder {
+ public:
+  CaptureRenderCommandEncoder(std::unique_ptr<igl::IRenderCommandEncoder> encoder,
+                              const std::shared_ptr<igl::ICommandBuffer>& commandBuffer,
+                              std::shared_ptr<TraceRecorder> recorder,
+                              uint32_t id);
+
+  void endEncoding() final;
+  void pushDebugGroupLabel(const char* IGL_NONNULL label,
+                           const igl::Color& color = igl::Color(1, 1, 1, 1)) const final;
+  void insertDebugEventLabel(const char* IGL_NONNULL label,
+                             const igl::Color& color = igl::Color(1, 1, 1, 1)) const final;
+  void popDebugGroupLabel() const final;
+
+  void bindViewport(const igl::Viewport& viewport) final;
+  void bindScissorRect(const igl::ScissorRect& rect) final;
+  void bindRenderPipelineState(
+      const std::shared_ptr<igl::IRenderPipelineState>& pipelineState) final;
+  void bindDepthStencilState(
+      const std::shared_ptr<igl::IDepthStencilState>& depthStencilState) final;
+  void bindBuffer(uint32_t index,
+                  igl::IBuffer* IGL_NULLABLE buffer,
+                  size_t bufferOffset,
+                  size_t bufferSize) final;
+  void bindVertexBuffer(uint32_t index, igl::IBuffer& buffer, size_t bufferOffset) final;
+  void bindIndexBuffer(igl::IBuffer& buffer, igl::IndexFormat format, size_t bufferOffset) final;
+  void bindBytes(size_t index, uint8_t target, const void* IGL_NULLABLE data, size_t length) final;
+  void bindPushConstants(const void* IGL_NONNULL data, size_t length, size_t offset) final;
+  void bindSamplerState(size_t index,
+                        uint8_t target,
+                        igl::ISamplerState* IGL_NULLABLE samplerState) final;
+  void bindTexture(size_t index, uint8_t target, igl::ITexture* IGL_NULLABLE texture) final;
+  void bindUniform(const igl::UniformDesc& uniformDesc, const void* IGL_NONNULL data) final;
+  void bindBindGroup(igl::BindGroupTextureHandle handle) final;
+  void bindBindGroup(igl::BindGroupBufferHandle handle,
+                     uint32_t numDynamicOffsets,
+                     const uint32_t* IGL_NULLABLE dynamicOffsets) final;
+
+  void draw(size_t vertexCount,
+            uint32_t instanceCount,
+            uint32_t firstVertex,
+            uint32_t baseInstance) final;
+  void drawIndexed(size_t indexCount,
+                   uint32_t instanceCount,
+                   uint32_t firstIndex,
+                   int32_t vertexOffset,
+                   uint32_t baseInstance) final;
+  void multiDrawIndirect(igl::IBuffer& indirectBuffer,
+                         size_t indirectBufferOffset,
+                         uint32_t drawCount,
+                         uint32_t stride) final;
+  void multiDrawIndexedIndirect(igl::IBuffer& indirectBuffer,
+                                size_t indirectBufferOffset,
+                                uint32_t drawCount,
+                                uint32_t stride) final;
+
+  void setStencilReferenceValue(uint32_t value) final;
+  void setBlendColor(const igl::Color& color) final;
+  void setDepthBias(float depthBias, float slopeScale, float clamp) final;
+
+ private:
+  /// Starts a record whose payload begins with this encoder's id.
+  TraceWriter& beginRecord(TraceOp op) const;
+  void endRecord() const;
+
+  std::unique_ptr<igl::IRenderCommandEncoder> encoder_;
+  std::shared_ptr<TraceRecorder> recorder_;
+  uint32_t id_;
+};
+
+} // namespace iglu::capture
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/capture/CaptureShaderStages.h>
+
+#include <IGLU/capture/TraceRecorder.h>
+
+namespace iglu::capture {
+
+CaptureShaderStages::CaptureShaderStages(const igl::ShaderStagesDesc& desc,
+                                         std::unique_ptr<igl::IShaderStages> stages,
+                                         std::shared_ptr<TraceRecorder> recorder) :
+  IShaderStages(desc), stages_(std::move(stages)), recorder_(std::move(recorder)) {
+  IGL_DEBUG_ASSERT(stages_);
+  id_ = recorder_->registerObject(this, {}, TraceRecorder::ObjectKind::CaptureShaderStages);
+}
+
+CaptureShaderStages::~CaptureShaderStages() {
+  recorder_->unregisterObject(this);
+}
+
+} // namespace iglu::capture
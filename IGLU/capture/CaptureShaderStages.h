@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/Shader.h>
+#include <memory>
+
+namespace iglu::capture {
+
+class TraceRecorder;
+
+/**
+ * Owns shader stages created by the captured device along with their trace id. Shader stages are
+ * handed out as a unique_ptr with no owner to observe, so the id lives exactly as long as this
+ * wrapper does.
+ */
+class CaptureShaderStages final : public igl::IShaderStages {
+ public:
+  CaptureShaderStages(const igl::ShaderStagesDesc& desc,
+                      std::unique_ptr<igl::IShaderStages> stages,
+                      std::shared_ptr<TraceRecorder> recorder);
+  ~CaptureShaderStages() override;
+
+  [[nodiscard]] uint32_t id() const noexcept {
+    return id_;
+  }
+  [[nodiscard]] igl::IShaderStages& stages() const noexcept {
+    return *stages_;
+  }
+
+ private:
+  std::unique_ptr<igl::IShaderStages> stages_;
+  std::shared_ptr<TraceRecorder> recorder_;
+  uint32_t id_ = 0;
+};
+
+} // namespace iglu::capture
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/capture/CaptureTexture.h>
+
+#include <IGLU/capture/CaptureCommandBuffer.h>
+#include <IGLU/capture/CaptureCommandQueue.h>
+#include <IGLU/capture/TraceRecorder.h>
+
+namespace iglu::capture {
+
+CaptureTexture::CaptureTexture(std::shared_ptr<igl::ITexture> texture,
+                               std::shared_ptr<TraceRecorder> recorder) :
+  ITexture(texture->getFormat()), texture_(std::move(texture)), recorder_(std::move(recorder)) {
+  id_ = recorder_->registerObject(this, {}, TraceRecorder::ObjectKind::CaptureTexture);
+  recorder_->registerAlias(texture_.get(), id_);
+}
+
+CaptureTexture::~CaptureTexture() {
+  recorder_->unregisterObject(this);
+  recorder_->unregisterObject(texture_.get());
+  recorder_->beginRecord(TraceOp::DestroyTexture).write(id_);
+  recorder_->endRecord();
+}
+
+bool CaptureTexture::supportsUpload() const {
+  return texture_->supportsUpload();
+}
+
+igl::Dimensions CaptureTexture::getDimensions() const {
+  return texture_->getDimensions();
+}
+
+uint32_t CaptureTexture::getNumLayers() const {
+  return texture_->getNumLayers();
+}
+
+igl::TextureType CaptureTexture::getType() const {
+  return texture_->getType();
+}
+
+igl::TextureDesc::TextureUsage CaptureTexture::getUsage() const {
+  return texture_->getUsage();
+}
+
+uint32_t CaptureTexture::getSamples() const {
+  return texture_->getSamples();
+}
+
+void CaptureTexture::generateMipmap(igl::ICommandQueue& cmdQueue,
+                                    const igl::TextureRangeDesc* IGL_NULLABLE range) const {
+  auto& captureQueue = static_cast<CaptureCommandQueue&>(cmdQueue);
+  recordGenerateMipmap(captureQueue.id(), range);
+  texture_->generateMipmap(captureQueue.commandQueue(), range);
+}
+
+void CaptureTexture::generateMipmap(igl::ICommandBuffer& cmdBuffer,
+                                    const igl::TextureRangeDesc* IGL_NULLABLE range) const {
+  auto& captureBuffer = static_cast<CaptureCommandBuffer&>(cmdBuffer);
+  recordGenerateMipmap(captureBuffer.id(), range);
+  texture_->generateMipmap(captureBuffer.commandBuffer(), range);
+}
+
+uint32_t CaptureTexture::getNumMipLevels() const {
+  return texture_->getNumMipLevels();
+}
+
+bool CaptureTexture::isRequiredGenerateMipmap() const {
+  return texture_->isRequiredGenerateMipmap();
+}
+
+uint64_t CaptureTexture::getTextureId() const {
+  return texture_->getTextureId();
+}
+
+bool CaptureTexture::isSwapchainTexture() const {
+  return texture_->isSwapchainTexture();
+}
+
+igl::Result CaptureTexture::uploadInternal(igl::TextureType /*type*/,
+                                           const igl::TextureRangeDesc& range,
+                                           const void* IGL_NULLABLE data,
+                                           size_t bytesPerRow) const {
+  // ITexture::upload() has validated the range, so the size of the data follows from it
+  const size_t length =
+      data ? properties_.getBytesPerRange(range, static_cast<uint32_t>(bytesPerRow)) *
+                 range.numFaces
+           : 0;
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::TextureUpload);
+  writer.write(id_);
+  writer.write(range);
+  writer.write(static_cast<uint64_t>(bytesPerRow));
+  writer.write(data != nullptr);
+  writer.writeBlob(data, length);
+  recorder_->endRecord();
+
+  return texture_->upload(range, data, bytesPerRow);
+}
+
+void CaptureTexture::recordGenerateMipmap(uint32_t commandsId,
+                                          const igl::TextureRangeDesc* IGL_NULLABLE range) const {
+  TraceWriter& writer = recorder_->beginRecord(TraceOp::TextureGenerateMipmap);
+  writer.write(id_);
+  writer.write(commandsId);
+  writer.write(range != nullptr);
+  writer.write(range ? *range : igl::TextureRangeDesc{});
+  recorder_->endRecord();
+}
+
+} // namespace iglu::capture
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/Texture.h>
+#include <memory>
+
+namespace iglu::capture {
+
+class TraceRecorder;
+
+/**
+ * Forwards to a texture created by the captured device and records uploads and mipmap generation.
+ * The wrapped texture resolves to the same trace id, so attachments returned by framebuffers are
+ * recognized as well.
+ */
+class CaptureTexture final : public igl::ITexture {
+ public:
+  CaptureTexture(std::shared_ptr<igl::ITexture> texture, std::shared_ptr<TraceRecorder> recorder);
+  ~CaptureTexture() override;
+
+  [[nodiscard]] bool supportsUpload() const final;
+  [[nodiscard]] igl::Dimensions getDimensions() const final;
+  [[nodiscard]] uint32_t getNumLayers() const final;
+  [[nodiscard]] igl::TextureType getType() const final;
+  [[nodiscard]] igl::TextureDesc::TextureUsage getUsage() const final;
+  [[nodiscard]] uint32_t getSamples() const final;
+  void generateMipmap(igl::ICommandQueue& cmdQueue,
+                      const igl::TextureRangeDesc* IGL_NULLABLE range = nullptr) const final;
+  void generateMipmap(igl::ICommandBuffer& cmdBuffer,
+                      const igl::TextureRangeDesc* IGL_NULLABLE range = nullptr) const final;
+  [[nodiscard]] uint32_t getNumMipLevels() const final;
+  [[nodiscard]] bool isRequiredGenerateMipmap() const final;
+  [[nodiscard]] uint64_t getTextureId() const final;
+  [[nodiscard]] bool isSwapchainTexture() const final;
+
+  [[nodiscard]] uint32_t id() const noexcept {
+    return id_;
+  }
+  [[nodiscard]] igl::ITexture& texture() const noexcept {
+    return *texture_;
+  }
+
+ private:
+  [[nodiscard]] igl::Result uploadInternal(igl::TextureType type,
+                                           const igl::TextureRangeDesc& range,
+                                           const void* IGL_NULLABLE data,
+                                           size_t bytesPerRow) const final;
+  void recordGenerateMipmap(uint32_t commandsId, const igl::TextureRangeDesc* IGL_NULLABLE range)
+      const;
+
+  std::shared_ptr<igl::ITexture> texture_;
+  std::shared_ptr<TraceRecorder> recorder_;
+  uint32_t id_ = 0;
+};
+
+} // namespace iglu::capture
@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/capture/TraceFormat.h>
+
+#include <algorithm>
+
+namespace iglu::capture {
+
+namespace {
+
+void writeStencil(TraceWriter& writer, const igl::StencilStateDesc& desc) {
+  writer.write(desc.stencilFailureOperation);
+  writer.write(desc.depthFailureOperation);
+  writer.write(desc.depthStencilPassOperation);
+  writer.write(desc.stencilCompareFunction);
+  writer.write(desc.readMask);
+  writer.write(desc.writeMask);
+}
+
+void readStencil(TraceReader& reader, igl::StencilStateDesc& desc) {
+  desc.stencilFailureOperation = reader.read<igl::StencilOperation>();
+  desc.depthFailureOperation = reader.read<igl::StencilOperation>();
+  desc.depthStencilPassOperation = reader.read<igl::StencilOperation>();
+  desc.stencilCompareFunction = reader.read<igl::CompareFunction>();
+  desc.readMask = reader.read<uint32_t>();
+  desc.writeMask = reader.read<uint32_t>();
+}
+
+void writeAttachment(TraceWriter& writer, const igl::RenderPassDesc::BaseAttachmentDesc& desc) {
+  writer.write(desc.loadAction);
+  writer.write(desc.storeAction);
+  writer.write(desc.face);
+  writer.write(desc.mipLevel);
+  writer.write(desc.layer);
+}
+
+void readAttachment(TraceReader& reader, igl::RenderPassDesc::BaseAttachmentDesc& desc) {
+  desc.loadAction = reader.read<igl::LoadAction>();
+  desc.storeAction = reader.read<igl::StoreAction>();
+  desc.face = reader.read<uint8_t>();
+  desc.mipLevel = reader.read<uint8_t>();
+  desc.layer = reader.read<uint8_t>();
+}
+
+size_t uniformDataSize(const igl::UniformDesc& desc) {
+  const size_t elementSize = igl::sizeForUniformType(desc.type);
+  if (desc.numElements == 0) {
+    return desc.offset;
+  }
+  const size_t stride = std::max(desc.elementStride, elementSize);
+  return desc.offset + (desc.numElements - 1) * stride + elementSize;
+}
+
+} // namespace
+
+const char* traceOpName(TraceOp op) {
+  switch (op) {
+#define IGLU_TRACE_OP_NAME(name) \
+  case TraceOp::name:            \
+    return #name;
+    IGLU_TRACE_OP_NAME(CreateCommandQueue)
+    IGLU_TRACE_OP_NAME(CreateBuffer)
+    IGLU_TRACE_OP_NAME(CreateTexture)
+    IGLU_TRACE_OP_NAME(CreateExternalTexture)
+    IGLU_TRACE_OP_NAME(CreateSamplerState)
+    IGLU_TRACE_OP_NAME(CreateDepthStencilState)
+    IGLU_TRACE_OP_NAME(CreateVertexInputState)
+    IGLU_TRACE_OP_NAME(CreateShaderModule)
+    IGLU_TRACE_OP_NAME(CreateShaderLibrary)
+    IGLU_TRACE_OP_NAME(CreateLibraryShaderModule)
+    IGLU_TRACE_OP_NAME(CreateShaderStages)
+    IGLU_TRACE_OP_NAME(CreateRenderPipeline)
+    IGLU_TRACE_OP_NAME(CreateComputePipeline)
+    IGLU_TRACE_OP_NAME(CreateFramebuffer)
+    IGLU_TRACE_OP_NAME(CreateTextureBindGroup)
+    IGLU_TRACE_OP_NAME(CreateBufferBindGroup)
+    IGLU_TRACE_OP_NAME(DestroyTextureBindGroup)
+    IGLU_TRACE_OP_NAME(DestroyBufferBindGroup)
+    IGLU_TRACE_OP_NAME(BufferUpload)
+    IGLU_TRACE_OP_NAME(DestroyBuffer)
+    IGLU_TRACE_OP_NAME(TextureUpload)
+    IGLU_TRACE_OP_NAME(TextureGenerateMipmap)
+    IGLU_TRACE_OP_NAME(DestroyTexture)
+    IGLU_TRACE_OP_NAME(CreateCommandBuffer)
+    IGLU_TRACE_OP_NAME(Submit)
+    IGLU_TRACE_OP_NAME(Present)
+    IGLU_TRACE_OP_NAME(WaitUntilScheduled)
+    IGLU_TRACE_OP_NAME(WaitUntilCompleted)
+    IGLU_TRACE_OP_NAME(EndEncoding)
+    IGLU_TRACE_OP_NAME(PushDebugGroupLabel)
+    IGLU_TRACE_OP_NAME(InsertDebugEventLabel)
+    IGLU_TRACE_OP_NAME(PopDebugGroupLabel)
+    IGLU_TRACE_OP_NAME(CreateRenderCommandEncoder)
+    IGLU_TRACE_OP_NAME(BindViewport)
+    IGLU_TRACE_OP_NAME(BindScissorRect)
+    IGLU_TRACE_OP_NAME(BindRenderPipelineState)
+    IGLU_TRACE_OP_NAME(BindDepthStencilState)
+    IGLU_TRACE_OP_NAME(BindBuffer)
+    IGLU_TRACE_OP_NAME(BindVertexBuffer)
+    IGLU_TRACE_OP_NAME(BindIndexBuffer)
+    IGLU_TRACE_OP_NAME(BindBytes)
+    IGLU_TRACE_OP_NAME(BindPushConstants)
+    IGLU_TRACE_OP_NAME(BindSamplerState)
+    IGLU_TRACE_OP_NAME(BindTexture)
+    IGLU_TRACE_OP_NAME(BindUniform)
+    IGLU_TRACE_OP_NAME(BindTextureBindGroup)
+    IGLU_TRACE_OP_NAME(BindBufferBindGroup)
+    IGLU_TRACE_OP_NAME(Draw)
+    IGLU_TRACE_OP_NAME(DrawIndexed)
+    IGLU_TRACE_OP_NAME(MultiDrawIndirect)
+    IGLU_TRACE_OP_NAME(MultiDrawIndexedIndirect)
+    IGLU_TRACE_OP_NAME(SetStencilReferenceValue)
+    IGLU_TRACE_OP_NAME(SetBlendColor)
+    IGLU_TRACE_OP_NAME(SetDepthBias)
+    IGLU_TRACE_OP_NAME(CreateComputeCommandEncoder)
+    IGLU_TRACE_OP_NAME(ComputeBindComputePipelineState)
+    IGLU_TRACE_OP_NAME(ComputeBindBuffer)
+    IGLU_TRACE_OP_NAME(ComputeBindBytes)
+    IGLU_TRACE_OP_NAME(ComputeBindPushConstants)
+    IGLU_TRACE_OP_NAME(ComputeBindTexture)
+    IGLU_TRACE_OP_NAME(ComputeBindUniform)
+    IGLU_TRACE_OP_NAME(ComputeDispatchThreadGroups)
+#undef IGLU_TRACE_OP_NAME
+  case TraceOp::Count:
+    break;
+  }
+  return "Unknown";
+}
+
+void TraceWriter::writeBytes(const void* IGL_NULLABLE data, size_t length) {
+  if (length == 0) {
+    return;
+  }
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  if (bytes) {
+    data_.insert(data_.end(), bytes, bytes + length);
+  } else {
+    data_.resize(data_.size() + length, 0);
+  }
+}
+
+void TraceWriter::writeBlob(const void* IGL_NULLABLE data, size_t length) {
+  write(static_cast<uint32_t>(length));
+  writeBytes(data, length);
+}
+
+void TraceWriter::writeString(const std::string& str) {
+  writeBlob(str.data(), str.size());
+}
+
+const uint8_t* IGL_NULLABLE TraceReader::readBytes(size_t length) {
+  if (failed_ || length > length_ - offset_) {
+    failed_ = true;
+    return nullptr;
+  }
+  const uint8_t* bytes = data_ + offset_;
+  offset_ += length;
+  return bytes;
+}
+
+const uint8_t* IGL_NULLABLE TraceReader::readBlob(uint32_t& outLength) {
+  outLength = read<uint32_t>();
+  const uint8_t* bytes = readBytes(outLength);
+  if (!bytes) {
+    outLength = 0;
+  }
+  return bytes;
+}
+
+std::string TraceReader::readString() {
+  uint32_t length = 0;
+  const uint8_t* bytes = readBlob(length);
+  return bytes ? std::string(reinterpret_cast<const char*>(bytes), length) : std::string();
+}
+
+void write(TraceWriter& writer, const igl::Color& color) {
+  writer.write(color.r);
+  writer.write(color.g);
+  writer.write(color.b);
+  writer.write(color.a);
+}
+
+igl::Color readColor(TraceReader& reader) {
+  const float r = reader.read<float>();
+  const float g = reader.read<float>();
+  const float b = reader.read<float>();
+  return {r, g, b, reader.read<float>()};
+}
+
+void write(TraceWriter& writer, const igl::TextureDesc& desc) {
+  writer.write(desc.width);
+  writer.write(desc.height);
+  writer.write(desc.depth);
+  writer.write(desc.numLayers);
+  writer.write(desc.numSamples);
+  writer.write(desc.usage);
+  writer.write(desc.numMipLevels);
+  writer.write(desc.type);
+  writer.write(desc.format);
+  writer.write(desc.storage);
+  writer.write(desc.tiling);
+  writer.writeString(desc.debugName);
+}
+
+void read(TraceReader& reader, igl::TextureDesc& desc) {
+  desc.width = reader.read<uint32_t>();
+  desc.height = reader.read<uint32_t>();
+  desc.depth = reader.read<uint32_t>();
+  desc.numLayers = reader.read<uint32_t>();
+  desc.numSamples = reader.read<uint32_t>();
+  desc.usage = reader.read<igl::TextureDesc::TextureUsage>();
+  desc.numMipLevels = reader.read<uint32_t>();
+  desc.type = reader.read<igl::TextureType>();
+  desc.format = reader.read<igl::TextureFormat>();
+  desc.storage = reader.read<igl::ResourceStorage>();
+  desc.tiling = reader.read<igl::TextureDesc::TextureTiling>();
+  desc.debugName = reader.readString();
+}
+
+void write(TraceWriter& writer, const igl::SamplerStateDesc& desc) {
+  writer.write(desc.minFilter);
+  writer.write(desc.magFilter);
+  writer.write(desc.mipFilter);
+  writer.write(desc.addressModeU);
+  writer.write(desc.addressModeV);
+  writer.write(desc.addressModeW);
+  writer.write(desc.depthCompareFunction);
+  writer.write(desc.mipLodMin);
+  writer.write(desc.mipLodMax);
+  writer.write(desc.maxAnisotropic);
+  writer.write(desc.depthCompareEnabled);
+  writer.write(desc.yuvFormat);
+  writer.writeString(desc.debugName);
+}
+
+void read(TraceReader& reader, igl::SamplerStateDesc& desc) {
+  desc.minFilter = reader.read<igl::SamplerMinMagFilter>();
+  desc.magFilter = reader.read<igl::SamplerMinMagFilter>();
+  desc.mipFilter = reader.read<igl::SamplerMipFilter>();
+  desc.addressModeU = reader.read<igl::SamplerAddressMode>();
+  desc.addressModeV = reader.read<igl::SamplerAddressMode>();
+  desc.addressModeW = reader.read<igl::SamplerAddressMode>();
+  desc.depthCompareFunction = reader.read<igl::CompareFunction>();
+  desc.mipLodMin = reader.read<uint8_t>();
+  desc.mipLodMax = reader.read<uint8_t>();
+  desc.maxAnisotropic = reader.read<uint8_t>();
+  desc.depthCompareEnabled = reader.read<bool>();
+  desc.yuvFormat = reader.read<igl::TextureFormat>();
+  desc.debugName = reader.readString();
+}
+
+void write(TraceWriter& writer, const igl::DepthStencilStateDesc& desc) {
+  writer.write(desc.compareFunction);
+  writer.write(desc.isDepthWriteEnabled);
+  writeStencil(writer, desc.backFaceStencil);
+  writeStencil(writer, desc.frontFaceStencil);
+  writer.writeString(desc.debugName);
+}
+
+void read(TraceReader& reader, igl::DepthStencilStateDesc& desc) {
+  desc.compareFunction = reader.read<igl::CompareFunction>();
+  desc.isDepthWriteEnabled = reader.read<bool>();
+  readStencil(reader, desc.backFaceStencil);
+  readStencil(reader, desc.frontFaceStencil);
+  desc.debugName = reader.readString();
+}
+
+void write(TraceWriter& writer, const igl::VertexInputStateDesc& desc) {
+  writer.write(static_cast<uint32_t>(desc.numAttributes));
+  for (size_t i = 0; i < desc.numAttributes; ++i) {
+    const auto& attribute = desc.attributes[i];
+    writer.write(static_cast<uint32_t>(attribute.bufferIndex));
+    writer.write(attribute.format);
+    writer.write(static_cast<uint64_t>(attribute.offset));
+    writer.writeString(attribute.name);
+    writer.write(static_cast<int32_t>(attribute.location));
+  }
+  writer.write(static_cast<uint32_t>(desc.numInputBindings));
+  for (size_t i = 0; i < desc.numInputBindings; ++i) {
+    const auto& binding = desc.inputBindings[i];
+    writer.write(static_cast<uint64_t>(binding.stride));
+    writer.write(binding.sampleFunction);
+    writer.write(static_cast<uint64_t>(binding.sampleRate));
+  }
+}
+
+void read(TraceReader& reader, igl::VertexInputStateDesc& desc) {
+  desc.numAttributes = std::min<size_t>(reader.read<uint32_t>(), igl::IGL_VERTEX_ATTRIBUTES_MAX);
+  for (size_t i = 0; i < desc.numAttributes; ++i) {
+    auto& attribute = desc.attributes[i];
+    attribute.bufferIndex = reader.read<uint32_t>();
+    attribute.format = reader.read<igl::VertexAttributeFormat>();
+    attribute.offset = static_cast<uintptr_t>(reader.read<uint64_t>());
+    attribute.name = reader.readString();
+    attribute.location = reader.read<int32_t>();
+  }
+  desc.numInputBindings = std::min<size_t>(reader.read<uint32_t>(), igl::IGL_VERTEX_BUFFER_MAX);
+  for (size_t i = 0; i < desc.numInputBindings; ++i) {
+    auto& binding = desc.inputBindings[i];
+    binding.stride = static_cast<size_t>(reader.read<uint64_t>());
+    binding.sampleFunction = reader.read<igl::VertexSampleFunction>();
+    binding.sampleRate = static_cast<size_t>(reader.read<uint64_t>());
+  }
+}
+
+void write(TraceWriter& writer, const igl::RenderPassDesc& desc) {
+  writer.write(static_cast<uint32_t>(desc.colorAttachments.size()));
+  for (const auto& attachment : desc.colorAttachments) {
+    writeAttachment(writer, attachment);
+    write(writer, attachment.clearColor);
+  }
+  writeAttachment(writer, desc.depthAttachment);
+  writer.write(desc.depthAttachment.clearDepth);
+  writeAttachment(writer, desc.stencilAttachment);
+  writer.write(desc.stencilAttachment.clearStencil);
+}
+
+void read(TraceReader& reader, igl::RenderPassDesc& desc) {
+  desc.colorAttachments.resize(
+      std::min<size_t>(reader.read<uint32_t>(), igl::IGL_COLOR_ATTACHMENTS_MAX));
+  for (auto& attachment : desc.colorAttachments) {
+    readAttachment(reader, attachment);
+    attachment.clearColor = readColor(reader);
+  }
+  readAttachment(reader, desc.depthAttachment);
+  desc.depthAttachment.clearDepth = reader.read<float>();
+  readAttachment(reader, desc.stencilAttachment);
+  desc.stencilAttachment.clearStencil = reader.read<uint32_t>();
+}
+
+void write(TraceWriter& writer, const igl::RenderPipelineDesc::TargetDesc& desc) {
+  writer.write(static_cast<uint32_t>(desc.colorAttachments.size()));
+  for (const auto& attachment : desc.colorAttachments) {
+    writer.write(attachment.textureFormat);
+    writer.write(attachment.colorWriteMask);
+    writer.write(attachment.blendEnabled);
+    writer.write(attachment.rgbBlendOp);
+    writer.write(attachment.alphaBlendOp);
+    writer.write(attachment.srcRGBBlendFactor);
+    writer.write(attachment.srcAlphaBlendFactor);
+    writer.write(attachment.dstRGBBlendFactor);
+    writer.write(attachment.dstAlphaBlendFactor);
+  }
+  writer.write(desc.depthAttachmentFormat);
+  writer.write(desc.stencilAttachmentFormat);
+}
+
+void read(TraceReader& reader, igl::RenderPipelineDesc::TargetDesc& desc) {
+  const auto numColorAttachments =
+      std::min(reader.read<uint32_t>(), static_cast<uint32_t>(igl::IGL_COLOR_ATTACHMENTS_MAX));
+  desc.colorAttachments.resize(numColorAttachments);
+  for (auto& attachment : desc.colorAttachments) {
+    attachment.textureFormat = reader.read<igl::TextureFormat>();
+    attachment.colorWriteMask = reader.read<igl::ColorWriteMask>();
+    attachment.blendEnabled = reader.read<bool>();
+    attachment.rgbBlendOp = reader.read<igl::BlendOp>();
+    attachment.alphaBlendOp = reader.read<igl::BlendOp>();
+    attachment.srcRGBBlendFactor = reader.read<igl::BlendFactor>();
+    attachment.srcAlphaBlendFactor = reader.read<igl::BlendFactor>();
+    attachment.dstRGBBlendFactor = reader.read<igl::BlendFactor>();
+    attachment.dstAlphaBlendFactor = reader.read<igl::BlendFactor>();
+  }
+  desc.depthAttachmentFormat = reader.read<igl::TextureFormat>();
+  desc.stencilAttachmentFormat = reader.read<igl::TextureFormat>();
+}
+
+void write(TraceWriter& writer, const std::unordered_map<size_t, igl::NameHandle>& map) {
+  writer.write(static_cast<uint32_t>(map.size()));
+  for (const auto& [index, name] : map) {
+    writer.write(static_cast<uint64_t>(index));
+    writer.writeString(name.toString());
+  }
+}
+
+void read(TraceReader& reader, std::unordered_map<size_t, igl::NameHandle>& map) {
+  const auto size = reader.read<uint32_t>();
+  for (uint32_t i = 0; i < size && reader.ok(); ++i) {
+    const auto index = static_cast<size_t>(reader.read<uint64_t>());
+    map[index] = igl::genNameHandle(reader.readString());
+  }
+}
+
+void write(TraceWriter& writer, const UniformBlockBindingMap& map) {
+  writer.write(static_cast<uint32_t>(map.size()));
+  for (const auto& [index, names] : map) {
+    writer.write(static_cast<uint64_t>(index));
+    writer.write(static_cast<uint32_t>(names.size()));
+    for (const auto& [blockName, instanceName] : names) {
+      writer.writeString(blockName.toString());
+      writer.writeString(instanceName.toString());
+    }
+  }
+}
+
+void read(TraceReader& reader, UniformBlockBindingMap& map) {
+  const auto size = reader.read<uint32_t>();
+  for (uint32_t i = 0; i < size && reader.ok(); ++i) {
+    auto& names = map[static_cast<size_t>(reader.read<uint64_t>())];
+    const auto numNames = reader.read<uint32_t>();
+    for (uint32_t j = 0; j < numNames && reader.ok(); ++j) {
+      auto blockName = igl::genNameHandle(reader.readString());
+      names.emplace_back(std::move(blockName), igl::genNameHandle(reader.readString()));
+    }
+  }
+}
+
+void write(TraceWriter& writer, const igl::UniformDesc& desc, const void* IGL_NONNULL data) {
+  writer.writeString(desc.name);
+  writer.write(static_cast<int32_t>(desc.location));
+  writer.write(desc.type);
+  writer.write(static_cast<uint64_t>(desc.numElements));
+  writer.write(static_cast<uint64_t>(desc.offset));
+  writer.write(static_cast<uint64_t>(desc.elementStride));
+  writer.writeBlob(data, uniformDataSize(desc));
+}
+
+const uint8_t* IGL_NULLABLE read(TraceReader& reader,
+                                 igl::UniformDesc& desc,
+                                 uint32_t& outLength) {
+  desc.name = reader.readString();
+  desc.location = reader.read<int32_t>();
+  desc.type = reader.read<igl::UniformType>();
+  desc.numElements = static_cast<size_t>(reader.read<uint64_t>());
+  desc.offset = static_cast<size_t>(reader.read<uint64_t>());
+  desc.elementStride = static_cast<size_t>(reader.read<uint64_t>());
+  return reader.readBlob(outLength);
+}
+
+} // namespace iglu::capture
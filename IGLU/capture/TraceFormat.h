@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <igl/DepthStencilState.h>
+#include <igl/NameHandle.h>
+#include <igl/RenderPass.h>
+#include <igl/RenderPipelineState.h>
+#include <igl/SamplerState.h>
+#include <igl/Texture.h>
+#include <igl/Uniform.h>
+#include <igl/VertexInputState.h>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace iglu::capture {
+
+/// Trace layout: a TraceHeader followed by records. Each record is a uint16_t TraceOp, a uint32_t
+/// payload size and the payload. Objects are referred to by ids unique within a trace; id 0 means
+/// no object.
+constexpr uint32_t kTraceMagic = 0x54474c49; // 'IGLT'
+constexpr uint32_t kTraceVersion = 2;
+
+struct TraceHeader {
+  uint32_t magic = kTraceMagic;
+  uint32_t version = kTraceVersion;
+};
+
+enum class TraceOp : uint16_t {
+  // IDevice
+  CreateCommandQueue,
+  CreateBuffer,
+  CreateTexture,
+  /// A texture the trace uses but did not create, such as a swapchain image.
+  CreateExternalTexture,
+  CreateSamplerState,
+  CreateDepthStencilState,
+  CreateVertexInputState,
+  CreateShaderModule,
+  CreateShaderLibrary,
+  /// A module of a shader library, looked up by stage and entry point.
+  CreateLibraryShaderModule,
+  CreateShaderStages,
+  CreateRenderPipeline,
+  CreateComputePipeline,
+  CreateFramebuffer,
+  CreateTextureBindGroup,
+  CreateBufferBindGroup,
+  DestroyTextureBindGroup,
+  DestroyBufferBindGroup,
+  // IBuffer
+  BufferUpload,
+  DestroyBuffer,
+  // ITexture
+  TextureUpload,
+  /// Mipmap generation on a command queue or a command buffer.
+  TextureGenerateMipmap,
+  DestroyTexture,
+  // ICommandQueue and ICommandBuffer
+  CreateCommandBuffer,
+  Submit,
+  Present,
+  WaitUntilScheduled,
+  WaitUntilCompleted,
+  // ICommandEncoder
+  EndEncoding,
+  PushDebugGroupLabel,
+  InsertDebugEventLabel,
+  PopDebugGroupLabel,
+  // IRenderCommandEncoder
+  CreateRenderCommandEncoder,
+  BindViewport,
+  BindScissorRect,
+  BindRenderPipelineState,
+  BindDepthStencilState,
+  BindBuffer,
+  BindVertexBuffer,
+  BindIndexBuffer,
+  BindBytes,
+  BindPushConstants,
+  BindSamplerState,
+  BindTexture,
+  BindUniform,
+  BindTextureBindGroup,
+  BindBufferBindGroup,
+  Draw,
+  DrawIndexed,
+  MultiDrawIndirect,
+  MultiDrawIndexedIndirect,
+  SetStencilReferenceValue,
+  SetBlendColor,
+  SetDepthBias,
+  // IComputeCommandEncoder
+  CreateComputeCommandEncoder,
+  ComputeBindComputePipelineState,
+  ComputeBindBuffer,
+  ComputeBindBytes,
+  ComputeBindPushConstants,
+  ComputeBindTexture,
+  ComputeBindUniform,
+  ComputeDispatchThreadGroups,
+
+  Count,
+};
+
+constexpr size_t kNumTraceOps = static_cast<size_t>(TraceOp::Count);
+
+[[nodiscard]] const char* traceOpName(TraceOp op);
+
+/// Appends primitives in native byte order to a growing byte buffer. Traces are replayed on the
+/// architecture they were captured on.
+class TraceWriter {
+ public:
+  template<typename T>
+  void write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    writeBytes(&value, sizeof(T));
+  }
+  void writeBytes(const void* IGL_NULLABLE data, size_t length);
+  /// Writes a uint32_t length followed by the bytes.
+  void writeBlob(const void* IGL_NULLABLE data, size_t length);
+  void writeString(const std::string& str);
+  /// Overwrites a value written earlier at `offset`.
+  template<typename T>
+  void patch(size_t offset, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    IGL_DEBUG_ASSERT(offset + sizeof(T) <= data_.size());
+    std::memcpy(data_.data() + offset, &value, sizeof(T));
+  }
+
+  [[nodiscard]] size_t size() const noexcept {
+    return data_.size();
+  }
+  [[nodiscard]] const std::vector<uint8_t>& data() const noexcept {
+    return data_;
+  }
+  void clear() noexcept {
+    data_.clear();
+  }
+
+ private:
+  std::vector<uint8_t> data_;
+};
+
+/// Bounds-checked reads from a byte range. Reading past the end sets a sticky error and yields
+/// zeroes.
+class TraceReader {
+ public:
+  TraceReader(const uint8_t* IGL_NULLABLE data, size_t length) : data_(data), length_(length) {}
+
+  template<typename T>
+  T read() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value{};
+    const uint8_t* IGL_NULLABLE bytes = readBytes(sizeof(T));
+    if (bytes) {
+      std::memcpy(&value, bytes, sizeof(T));
+    }
+    return value;
+  }
+  /// Returns a pointer into the trace, or nullptr if fewer than `length` bytes remain.
+  const uint8_t* IGL_NULLABLE readBytes(size_t length);
+  /// Reads a blob written by TraceWriter::writeBlob(). Returns a pointer into the trace.
+  const uint8_t* IGL_NULLABLE readBlob(uint32_t& outLength);
+  std::string readString();
+
+  [[nodiscard]] bool ok() const noexcept {
+    return !failed_;
+  }
+  [[nodiscard]] size_t remaining() const noexcept {
+    return length_ - offset_;
+  }
+
+ private:
+  const uint8_t* IGL_NULLABLE data_;
+  size_t length_;
+  size_t offset_ = 0;
+  bool failed_ = false;
+};
+
+using UniformBlockBindingMap = decltype(igl::RenderPipelineDesc::uniformBlockBindingMap);
+
+void write(TraceWriter& writer, const igl::Color& color);
+[[nodiscard]] igl::Color readColor(TraceReader& reader);
+
+// Serialization of descriptors that do not reference other objects
+void write(TraceWriter& writer, const igl::TextureDesc& desc);
+void write(TraceWriter& writer, const igl::SamplerStateDesc& desc);
+void write(TraceWriter& writer, const igl::DepthStencilStateDesc& desc);
+void write(TraceWriter& writer, const igl::VertexInputStateDesc& desc);
+void write(TraceWriter& writer, const igl::RenderPassDesc& desc);
+void write(TraceWriter& writer, const igl::RenderPipelineDesc::TargetDesc& desc);
+void write(TraceWriter& writer, const std::unordered_map<size_t, igl::NameHandle>& map);
+void write(TraceWriter& writer, const UniformBlockBindingMap& map);
+
+void read(TraceReader& reader, igl::TextureDesc& desc);
+void read(TraceReader& reader, igl::SamplerStateDesc& desc);
+void read(TraceReader& reader, igl::DepthStencilStateDesc& desc);
+void read(TraceReader& reader, igl::VertexInputStateDesc& desc);
+void read(TraceReader& reader, igl::RenderPassDesc& desc);
+void read(TraceReader& reader, igl::RenderPipelineDesc::TargetDesc& desc);
+void read(TraceReader& reader, std::unordered_map<size_t, igl::NameHandle>& map);
+void read(TraceReader& reader, UniformBlockBindingMap& map);
+
+/// Writes the uniform descriptor along with the bytes bindUniform() reads from `data`.
+void write(TraceWriter& writer, const igl::UniformDesc& desc, const void* IGL_NONNULL data);
+/// Returns a pointer into the trace to the uniform data and its size in `outLength`.
+const uint8_t* IGL_NULLABLE read(TraceReader& reader,
+                                 igl::UniformDesc& desc,
+                                 uint32_t& outLength);
+
+} // namespace iglu::capture
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/capture/TraceRecorder.h>
+
+#include <IGLU/capture/CaptureBuffer.h>
+#include <IGLU/capture/CaptureShaderStages.h>
+#include <IGLU/capture/CaptureTexture.h>
+#include <algorithm>
+#include <cstdio>
+#include <igl/CommandEncoder.h>
+
+namespace iglu::capture {
+
+namespace {
+
+template<typename HandleType>
+uint64_t bindGroupKey(HandleType handle) {
+  return (static_cast<uint64_t>(handle.index()) << 32) | handle.gen();
+}
+
+template<typename HandleType>
+uint32_t findBindGroupImpl(std::unordered_map<uint64_t, uint32_t>& bindGroups,
+                           HandleType handle,
+                           bool remove) {
+  const auto it = bindGroups.find(bindGroupKey(handle));
+  if (it == bindGroups.end()) {
+    return 0;
+  }
+  const uint32_t id = it->second;
+  if (remove) {
+    bindGroups.erase(it);
+  }
+  return id;
+}
+
+} // namespace
+
+TraceRecorder::TraceRecorder() {
+  writer_.write(TraceHeader{});
+}
+
+uint32_t TraceRecorder::registerObject(const void* IGL_NULLABLE object,
+                                       std::weak_ptr<const void> owner,
+                                       ObjectKind kind) {
+  if (!object) {
+    return 0;
+  }
+  if (objects_.size() >= pruneThreshold_) {
+    pruneExpired();
+    pruneThreshold_ = std::max<size_t>(pruneThreshold_, objects_.size() * 2);
+  }
+  Entry& entry = objects_[object];
+  entry.id = nextId_++;
+  entry.owned = !owner.expired();
+  entry.owner = std::move(owner);
+  entry.kind = kind;
+  return entry.id;
+}
+
+void TraceRecorder::unregisterObject(const void* IGL_NULLABLE object) {
+  objects_.erase(object);
+}
+
+void TraceRecorder::registerAlias(const void* IGL_NULLABLE object, uint32_t id) {
+  if (object) {
+    objects_[object] = Entry{id, {}, false, ObjectKind::Generic};
+  }
+}
+
+void TraceRecorder::pruneExpired() {
+  for (auto it = objects_.begin(); it != objects_.end();) {
+    if (it->second.owned && it->second.owner.expired()) {
+      it = objects_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+const TraceRecorder::Entry* IGL_NULLABLE
+TraceRecorder::find(const void* IGL_NULLABLE object) const {
+  if (!object) {
+    return nullptr;
+  }
+  const auto it = objects_.find(object);
+  if (it == objects_.end()) {
+    return nullptr;
+  }
+  if (it->second.owned && it->second.owner.expired()) {
+    objects_.erase(it);
+    return nullptr;
+  }
+  return &it->second;
+}
+
+uint32_t TraceRecorder::findObject(const void* IGL_NULLABLE object) const {
+  const Entry* entry = find(object);
+  return entry ? entry->id : 0;
+}
+
+bool TraceRecorder::isCaptureBuffer(const igl::IBuffer* IGL_NULLABLE buffer) const {
+  const Entry* entry = find(buffer);
+  return entry && entry->kind == ObjectKind::CaptureBuffer;
+}
+
+bool TraceRecorder::isCaptureShaderStages(const igl::IShaderStages* IGL_NULLABLE stages) const {
+  const Entry* entry = find(stages);
+  return entry && entry->kind == ObjectKind::CaptureShaderStages;
+}
+
+bool TraceRecorder::isCaptureTexture(const igl::ITexture* IGL_NULLABLE texture) const {
+  const Entry* entry = find(texture);
+  return entry && entry->kind == ObjectKind::CaptureTexture;
+}
+
+uint32_t TraceRecorder::textureId(const std::shared_ptr<igl::ITexture>& texture) {
+  return textureId(texture.get(), std::weak_ptr<const void>(texture));
+}
+
+uint32_t TraceRecorder::textureId(const igl::ITexture* IGL_NULLABLE texture) {
+  return textureId(texture, {});
+}
+
+uint32_t TraceRecorder::textureId(const igl::ITexture* IGL_NULLABLE texture,
+                                  std::weak_ptr<const void> owner) {
+  if (!texture) {
+    return 0;
+  }
+  if (const uint32_t id = findObject(texture)) {
+    return id;
+  }
+  // Without an owner to observe, an external texture is tracked by address only. Swapchains
+  // recycle a small set of images, so this keeps one id per image.
+  const uint32_t id = registerObject(texture, std::move(owner), ObjectKind::Generic);
+
+  const igl::Dimensions dimensions = texture->getDimensions();
+  igl::TextureDesc desc;
+  desc.width = dimensions.width;
+  desc.height = dimensions.height;
+  desc.depth = dimensions.depth;
+  desc.numLayers = texture->getNumLayers();
+  desc.numSamples = texture->getSamples();
+  desc.usage = texture->getUsage();
+  desc.numMipLevels = texture->getNumMipLevels();
+  desc.type = texture->getType();
+  desc.format = texture->getFormat();
+  desc.storage = igl::ResourceStorage::Private;
+  desc.debugName = "External texture";
+
+  TraceWriter& writer = beginRecord(TraceOp::CreateExternalTexture);
+  writer.write(id);
+  write(writer, desc);
+  endRecord();
+  return id;
+}
+
+uint32_t TraceRecorder::registerBindGroup(igl::BindGroupTextureHandle handle) {
+  if (handle.empty()) {
+    return 0;
+  }
+  return textureBindGroups_[bindGroupKey(handle)] = nextId_++;
+}
+
+uint32_t TraceRecorder::registerBindGroup(igl::BindGroupBufferHandle handle) {
+  if (handle.empty()) {
+    return 0;
+  }
+  return bufferBindGroups_[bindGroupKey(handle)] = nextId_++;
+}
+
+uint32_t TraceRecorder::findBindGroup(igl::BindGroupTextureHandle handle, bool remove) {
+  return findBindGroupImpl(textureBindGroups_, handle, remove);
+}
+
+uint32_t TraceRecorder::findBindGroup(igl::BindGroupBufferHandle handle, bool remove) {
+  return findBindGroupImpl(bufferBindGroups_, handle, remove);
+}
+
+TraceWriter& TraceRecorder::beginRecord(TraceOp op) {
+  IGL_DEBUG_ASSERT(!inRecord_, "Trace records cannot be nested");
+  inRecord_ = true;
+  writer_.write(op);
+  recordStart_ = writer_.size();
+  // Payload size, patched by endRecord()
+  writer_.write(uint32_t(0));
+  return writer_;
+}
+
+void TraceRecorder::endRecord() {
+  IGL_DEBUG_ASSERT(inRecord_);
+  inRecord_ = false;
+  ++numRecords_;
+  const auto payloadSize =
+      static_cast<uint32_t>(writer_.size() - recordStart_ - sizeof(uint32_t));
+  writer_.patch(recordStart_, payloadSize);
+}
+
+igl::Result TraceRecorder::save(const std::string& path) const {
+  FILE* file = fopen(path.c_str(), "wb");
+  if (!file) {
+    return igl::Result(igl::Result::Code::RuntimeError, "Cannot open " + path);
+  }
+  const auto& bytes = writer_.data();
+  const size_t written = fwrite(bytes.data(), 1, bytes.size(), file);
+  fclose(file);
+  return written == bytes.size()
+             ? igl::Result()
+             : igl::Result(igl::Result::Code::RuntimeError, "Cannot write " + path);
+}
+
+igl::IBuffer* IGL_NULLABLE unwrapBuffer(const TraceRecorder& recorder,
+                                        igl::IBuffer* IGL_NULLABLE buffer) {
+  if (recorder.isCaptureBuffer(buffer)) {
+    return &static_cast<CaptureBuffer*>(buffer)->buffer();
+  }
+  return buffer;
+}
+
+igl::ITexture* IGL_NULLABLE unwrapTexture(const TraceRecorder& recorder,
+                                          igl::ITexture* IGL_NULLABLE texture) {
+  if (recorder.isCaptureTexture(texture)) {
+    return &static_cast<CaptureTexture*>(texture)->texture();
+  }
+  return texture;
+}
+
+std::shared_ptr<igl::ITexture> unwrapTexture(const TraceRecorder& recorder,
+                                             const std::shared_ptr<igl::ITexture>& texture) {
+  if (recorder.isCaptureTexture(texture.get())) {
+    // Aliasing keeps the capture texture, and with it the wrapped texture, alive
+    return {texture, &static_cast<CaptureTexture*>(texture.get())->texture()};
+  }
+  return texture;
+}
+
+std::shared_ptr<igl::IShaderStages> unwrapShaderStages(
+    const TraceRecorder& recorder,
+    const std::shared_ptr<igl::IShaderStages>& stages) {
+  if (recorder.isCaptureShaderStages(stages.get())) {
+    return {stages, &static_cast<CaptureShaderStages*>(stages.get())->stages()};
+  }
+  return stages;
+}
+
+CapturedDependencies::CapturedDependencies(TraceRecorder& recorder,
+                                           const igl::Dependencies& dependencies) {
+  constexpr uint32_t kMaxTextures = igl::Dependencies::IGL_MAX_TEXTURE_DEPENDENCIES;
+  constexpr uint32_t kMaxBuffers = igl::Dependencies::IGL_MAX_BUFFER_DEPENDENCIES;
+
+  for (const igl::Dependencies* deps = &dependencies; deps; deps = deps->next) {
+    igl::Dependencies& link = chain_.emplace_back();
+    for (uint32_t i = 0; i != kMaxTextures; ++i) {
+      link.textures[i] = unwrapTexture(recorder, deps->textures[i]);
+      ids_.push_back(recorder.textureId(deps->textures[i]));
+    }
+    for (uint32_t i = 0; i != kMaxBuffers; ++i) {
+      link.buffers[i] = unwrapBuffer(recorder, deps->buffers[i]);
+      ids_.push_back(recorder.findObject(deps->buffers[i]));
+    }
+  }
+  // Link the copies only once the vector is no longer growing
+  for (size_t i = 1; i < chain_.size(); ++i) {
+    chain_[i - 1].next = &chain_[i];
+  }
+}
+
+const igl::Dependencies& CapturedDependencies::get() const {
+  return chain_.front();
+}
+
+void CapturedDependencies::write(TraceWriter& writer) const {
+  writer.write(static_cast<uint32_t>(chain_.size()));
+  writer.writeBytes(ids_.data(), ids_.size() * sizeof(uint32_t));
+}
+
+} // namespace iglu::capture
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <IGLU/capture/TraceFormat.h>
+#include <cstdint>
+#include <igl/Common.h>
+#include <igl/Texture.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace igl {
+class IBuffer;
+class IShaderStages;
+class ITexture;
+struct Dependencies;
+} // namespace igl
+
+namespace iglu::capture {
+
+/**
+ * Owns the trace being captured and maps live IGL objects to trace ids. Shared by all the capture
+ * wrappers created from one CaptureDevice. Like the rest of IGL, it is not thread-safe.
+ */
+class TraceRecorder final {
+ public:
+  enum class ObjectKind : uint8_t {
+    Generic,
+    CaptureBuffer,
+    CaptureShaderStages,
+    CaptureTexture,
+  };
+
+  TraceRecorder();
+
+  /// Returns a fresh id for objects the recorder does not need to look up, such as command buffers
+  /// and encoders whose capture wrappers keep their own id.
+  uint32_t allocateId() noexcept {
+    return nextId_++;
+  }
+  /// Assigns an id to an object that is owned through a shared_ptr. The id is dropped once the
+  /// object expires, so a new object at the same address never inherits it.
+  template<typename T>
+  uint32_t registerObject(const std::shared_ptr<T>& object) {
+    return registerObject(object.get(), std::weak_ptr<const void>(object), ObjectKind::Generic);
+  }
+  /// Assigns an id to a capture wrapper or an object with some other ownership. The caller must
+  /// unregister it before it is destroyed.
+  uint32_t registerObject(const void* IGL_NULLABLE object,
+                          std::weak_ptr<const void> owner,
+                          ObjectKind kind);
+  void unregisterObject(const void* IGL_NULLABLE object);
+  /// Makes `object` resolve to the id of a capture wrapper that forwards to it, so that objects
+  /// handed out by the wrapped device keep the wrapper's id. The caller must unregister it.
+  void registerAlias(const void* IGL_NULLABLE object, uint32_t id);
+  /// Returns 0 for null or unknown objects.
+  [[nodiscard]] uint32_t findObject(const void* IGL_NULLABLE object) const;
+  [[nodiscard]] bool isCaptureBuffer(const igl::IBuffer* IGL_NULLABLE buffer) const;
+  [[nodiscard]] bool isCaptureShaderStages(const igl::IShaderStages* IGL_NULLABLE stages) const;
+  [[nodiscard]] bool isCaptureTexture(const igl::ITexture* IGL_NULLABLE texture) const;
+
+  /// Returns the id of a texture. Textures the trace did not create, such as swapchain images, are
+  /// recorded as CreateExternalTexture the first time they are seen. Prefer the shared_ptr overload
+  /// where one is available, so that the id is dropped along with the texture.
+  uint32_t textureId(const std::shared_ptr<igl::ITexture>& texture);
+  uint32_t textureId(const igl::ITexture* IGL_NULLABLE texture);
+
+  uint32_t registerBindGroup(igl::BindGroupTextureHandle handle);
+  uint32_t registerBindGroup(igl::BindGroupBufferHandle handle);
+  /// Returns 0 for unknown handles. Set `remove` when the bind group is being destroyed.
+  uint32_t findBindGroup(igl::BindGroupTextureHandle handle, bool remove = false);
+  uint32_t findBindGroup(igl::BindGroupBufferHandle handle, bool remove = false);
+
+  /// Starts a record and returns the writer for its payload. Ids must be resolved before this is
+  /// called because resolving them may emit records of its own.
+  TraceWriter& beginRecord(TraceOp op);
+  void endRecord();
+
+  [[nodiscard]] const std::vector<uint8_t>& data() const noexcept {
+    return writer_.data();
+  }
+  [[nodiscard]] size_t numRecords() const noexcept {
+    return numRecords_;
+  }
+  igl::Result save(const std::string& path) const;
+
+ private:
+  struct Entry {
+    uint32_t id = 0;
+    std::weak_ptr<const void> owner;
+    bool owned = false;
+    ObjectKind kind = ObjectKind::Generic;
+  };
+
+  /// Drops the entry of `object` if its owner has expired.
+  const Entry* IGL_NULLABLE find(const void* IGL_NULLABLE object) const;
+  /// Drops the entries of all expired owners.
+  void pruneExpired();
+  uint32_t textureId(const igl::ITexture* IGL_NULLABLE texture, std::weak_ptr<const void> owner);
+
+  TraceWriter writer_;
+  // Mutable so that lookups can drop the expired entries they come across
+  mutable std::unordered_map<const void*, Entry> objects_;
+  // objects_ is swept for expired entries whenever it grows past this size
+  size_t pruneThreshold_ = 256;
+  std::unordered_map<uint64_t, uint32_t> textureBindGroups_;
+  std::unordered_map<uint64_t, uint32_t> bufferBindGroups_;
+  uint32_t nextId_ = 1;
+  size_t recordStart_ = 0;
+  bool inRecord_ = false;
+  size_t numRecords_ = 0;
+};
+
+/// Returns the buffer a CaptureBuffer wraps, or `buffer` itself for any other buffer.
+igl::IBuffer* IGL_NULLABLE unwrapBuffer(const TraceRecorder& recorder,
+                                        igl::IBuffer* IGL_NULLABLE buffer);
+/// Returns the texture a CaptureTexture wraps, or `texture` itself for any other texture.
+igl::ITexture* IGL_NULLABLE unwrapTexture(const TraceRecorder& recorder,
+                                          igl::ITexture* IGL_NULLABLE texture);
+/// Returns the texture a CaptureTexture wraps, or `texture` itself for any other texture. The
+/// result shares ownership with `texture`.
+std::shared_ptr<igl::ITexture> unwrapTexture(const TraceRecorder& recorder,
+                                             const std::shared_ptr<igl::ITexture>& texture);
+/// Returns the shader stages a CaptureShaderStages wraps, or `stages` itself for any other stages.
+/// The result shares ownership with `stages`.
+std::shared_ptr<igl::IShaderStages> unwrapShaderStages(
+    const TraceRecorder& recorder,
+    const std::shared_ptr<igl::IShaderStages>& stages);
+
+/**
+ * Copy of a Dependencies chain where capture buffers and textures are replaced by the resources
+ * they wrap, along with the trace ids of all the resources it references.
+ */
+class CapturedDependencies final {
+ public:
+  CapturedDependencies(TraceRecorder& recorder, const igl::Dependencies& dependencies);
+  CapturedDependencies(const CapturedDependencies&) = delete;
+  CapturedDependencies& operator=(const CapturedDependencies&) = delete;
+
+  [[nodiscard]] const igl::Dependencies& get() const;
+  /// Writes the number of chain links and, per link, the texture ids and then the buffer ids.
+  void write(TraceWriter& writer) const;
+
+ private:
+  std::vector<igl::Dependencies> chain_;
+  std::vector<uint32_t> ids_;
+};
+
+} // namespace iglu::capture
@@ -0,0 +1,1009 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/capture/TraceReplayer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <igl/CommandEncoder.h>
+#include <igl/DepthStencilState.h>
+#include <igl/RenderCommandEncoder.h>
+#include <igl/SamplerState.h>
+#include <igl/VertexInputState.h>
+
+namespace iglu::capture {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+uint32_t readCount(TraceReader& reader, uint32_t max) {
+  return std::min(reader.read<uint32_t>(), max);
+}
+
+/// String inputs point into `source`, which must outlive `input`.
+void readShaderInput(TraceReader& reader, igl::ShaderInput& input, std::string& source) {
+  input.type = reader.read<igl::ShaderInputType>();
+  if (input.type == igl::ShaderInputType::String) {
+    source = reader.readString();
+    input.source = source.c_str();
+    input.options.fastMathEnabled = reader.read<bool>();
+  } else {
+    uint32_t dataLength = 0;
+    input.data = reader.readBlob(dataLength);
+    input.length = dataLength;
+  }
+}
+
+} // namespace
+
+std::string ReplayStatistics::toString() const {
+  std::vector<size_t> order;
+  for (size_t i = 0; i != ops.size(); ++i) {
+    if (ops[i].count || ops[i].skipped) {
+      order.push_back(i);
+    }
+  }
+  std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    return ops[a].totalMs > ops[b].totalMs;
+  });
+
+  std::string result;
+  char line[160];
+  snprintf(line,
+           sizeof(line),
+           "%-32s %10s %10s %12s %12s\n",
+           "Call",
+           "Count",
+           "Skipped",
+           "Total (ms)",
+           "Mean (us)");
+  result += line;
+  for (const size_t i : order) {
+    const OpStatistics& op = ops[i];
+    snprintf(line,
+             sizeof(line),
+             "%-32s %10zu %10zu %12.3f %12.3f\n",
+             traceOpName(static_cast<TraceOp>(i)),
+             op.count,
+             op.skipped,
+             op.totalMs,
+             op.count ? op.totalMs * 1000.0 / static_cast<double>(op.count) : 0.0);
+    result += line;
+  }
+  snprintf(line, sizeof(line), "%zu records replayed in %.3f ms\n", numRecords, totalMs);
+  result += line;
+  return result;
+}
+
+TraceReplayer::TraceReplayer(igl::IDevice& device) : device_(device) {}
+
+igl::Result TraceReplayer::replay(const uint8_t* IGL_NULLABLE data,
+                                  size_t length,
+                                  ReplayStatistics* IGL_NULLABLE outStatistics) {
+  ReplayStatistics statistics;
+  TraceReader reader(data, length);
+
+  const auto header = reader.read<TraceHeader>();
+  if (!reader.ok() || header.magic != kTraceMagic) {
+    return igl::Result(igl::Result::Code::ArgumentInvalid, "Not an IGL trace");
+  }
+  if (header.version != kTraceVersion) {
+    return igl::Result(igl::Result::Code::Unsupported, "Unsupported trace version");
+  }
+
+  igl::Result result;
+  {
+    const igl::DeviceScope scope(device_);
+    const Clock::time_point replayStart = Clock::now();
+
+    while (reader.remaining() > 0) {
+      const auto op = reader.read<TraceOp>();
+      const auto payloadSize = reader.read<uint32_t>();
+      const uint8_t* payload = reader.readBytes(payloadSize);
+      if (!reader.ok() || op >= TraceOp::Count) {
+        result = igl::Result(igl::Result::Code::ArgumentInvalid, "Truncated or corrupt trace");
+        break;
+      }
+      // Every id is introduced by its own record, so no valid id can exceed the record count
+      maxId_ = ++statistics.numRecords;
+
+      TraceReader payloadReader(payload, payloadSize);
+      const Clock::time_point start = Clock::now();
+      const bool executed = execute(op, payloadReader);
+      const Clock::time_point end = Clock::now();
+
+      if (!payloadReader.ok()) {
+        result = igl::Result(igl::Result::Code::ArgumentInvalid,
+                             std::string("Malformed ") + traceOpName(op) + " record");
+        break;
+      }
+      ReplayStatistics::OpStatistics& opStatistics = statistics.ops[static_cast<size_t>(op)];
+      if (executed) {
+        ++opStatistics.count;
+        opStatistics.totalMs += elapsedMs(start, end);
+      } else {
+        ++opStatistics.skipped;
+      }
+    }
+    statistics.totalMs = elapsedMs(replayStart, Clock::now());
+
+    // Encoders before command buffers before the resources they use
+    for (auto it = objects_.rbegin(); it != objects_.rend(); ++it) {
+      *it = std::monostate();
+    }
+    objects_.clear();
+    drawables_.clear();
+    lastSubmitted_.clear();
+  }
+
+  if (outStatistics) {
+    *outStatistics = statistics;
+  }
+  return result;
+}
+
+void TraceReplayer::set(uint32_t id, Object object) {
+  if (id == 0 || id > maxId_) {
+    return;
+  }
+  if (id >= objects_.size()) {
+    objects_.resize(std::max<size_t>(id + 1, objects_.size() * 2));
+  }
+  objects_[id] = std::move(object);
+}
+
+void TraceReplayer::release(uint32_t id) {
+  if (id < objects_.size()) {
+    objects_[id] = std::monostate();
+  }
+}
+
+igl::IBuffer* IGL_NULLABLE TraceReplayer::getBuffer(uint32_t id) {
+  auto* buffer = get<std::shared_ptr<igl::IBuffer>>(id);
+  return buffer ? buffer->get() : nullptr;
+}
+
+igl::ITexture* IGL_NULLABLE TraceReplayer::getTexture(uint32_t id) {
+  auto* texture = get<std::shared_ptr<igl::ITexture>>(id);
+  return texture ? texture->get() : nullptr;
+}
+
+const void* IGL_NULLABLE TraceReplayer::alignedCopy(const uint8_t* IGL_NULLABLE data,
+                                                    uint32_t length) {
+  if (!data) {
+    return nullptr;
+  }
+  scratch_.resize((length + sizeof(uint64_t) - 1) / sizeof(uint64_t) + 1);
+  if (length) {
+    std::memcpy(scratch_.data(), data, length);
+  }
+  return scratch_.data();
+}
+
+const igl::Dependencies& TraceReplayer::readDependencies(TraceReader& reader) {
+  constexpr uint32_t kMaxTextures = igl::Dependencies::IGL_MAX_TEXTURE_DEPENDENCIES;
+  constexpr uint32_t kMaxBuffers = igl::Dependencies::IGL_MAX_BUFFER_DEPENDENCIES;
+  constexpr uint32_t kMaxLinks = 16;
+
+  dependencies_.clear();
+  const uint32_t numLinks = std::max(readCount(reader, kMaxLinks), 1u);
+  dependencies_.resize(numLinks);
+  for (igl::Dependencies& link : dependencies_) {
+    // Dependencies must be dense, so resources the replay device did not create are compacted out
+    uint32_t numTextures = 0;
+    for (uint32_t i = 0; i != kMaxTextures; ++i) {
+      if (igl::ITexture* texture = getTexture(reader.read<uint32_t>())) {
+        link.textures[numTextures++] = texture;
+      }
+    }
+    uint32_t numBuffers = 0;
+    for (uint32_t i = 0; i != kMaxBuffers; ++i) {
+      if (igl::IBuffer* buffer = getBuffer(reader.read<uint32_t>())) {
+        link.buffers[numBuffers++] = buffer;
+      }
+    }
+  }
+  for (size_t i = 1; i < dependencies_.size(); ++i) {
+    dependencies_[i - 1].next = &dependencies_[i];
+  }
+  return dependencies_.front();
+}
+
+bool TraceReplayer::execute(TraceOp op, TraceReader& reader) {
+  switch (op) {
+  case TraceOp::CreateCommandQueue:
+  case TraceOp::CreateBuffer:
+  case TraceOp::CreateTexture:
+  case TraceOp::CreateExternalTexture:
+  case TraceOp::CreateSamplerState:
+  case TraceOp::CreateDepthStencilState:
+  case TraceOp::CreateVertexInputState:
+  case TraceOp::CreateShaderModule:
+  case TraceOp::CreateShaderLibrary:
+  case TraceOp::CreateLibraryShaderModule:
+  case TraceOp::CreateShaderStages:
+  case TraceOp::CreateRenderPipeline:
+  case TraceOp::CreateComputePipeline:
+  case TraceOp::CreateFramebuffer:
+  case TraceOp::CreateTextureBindGroup:
+  case TraceOp::CreateBufferBindGroup:
+    return executeCreate(op, reader);
+  case TraceOp::DestroyTextureBindGroup:
+  case TraceOp::DestroyBufferBindGroup:
+  case TraceOp::DestroyBuffer:
+  case TraceOp::DestroyTexture: {
+    const auto id = reader.read<uint32_t>();
+    const bool exists = id < objects_.size() && objects_[id].index() != 0;
+    release(id);
+    return exists;
+  }
+  case TraceOp::BufferUpload: {
+    igl::IBuffer* buffer = getBuffer(reader.read<uint32_t>());
+    const auto offset = static_cast<uintptr_t>(reader.read<uint64_t>());
+    uint32_t size = 0;
+    const uint8_t* data = reader.readBlob(size);
+    if (!buffer || !reader.ok()) {
+      return false;
+    }
+    return buffer->upload(data, igl::BufferRange(size, offset)).isOk();
+  }
+  case TraceOp::TextureUpload: {
+    igl::ITexture* texture = getTexture(reader.read<uint32_t>());
+    const auto range = reader.read<igl::TextureRangeDesc>();
+    const auto bytesPerRow = static_cast<size_t>(reader.read<uint64_t>());
+    const auto hasData = reader.read<bool>();
+    uint32_t size = 0;
+    const uint8_t* data = reader.readBlob(size);
+    if (!texture || !reader.ok()) {
+      return false;
+    }
+    return texture->upload(range, hasData ? alignedCopy(data, size) : nullptr, bytesPerRow).isOk();
+  }
+  case TraceOp::TextureGenerateMipmap: {
+    igl::ITexture* texture = getTexture(reader.read<uint32_t>());
+    const auto commandsId = reader.read<uint32_t>();
+    const auto hasRange = reader.read<bool>();
+    const auto range = reader.read<igl::TextureRangeDesc>();
+    if (!texture || !reader.ok()) {
+      return false;
+    }
+    const igl::TextureRangeDesc* rangePtr = hasRange ? &range : nullptr;
+    if (auto* queue = get<std::shared_ptr<igl::ICommandQueue>>(commandsId)) {
+      texture->generateMipmap(**queue, rangePtr);
+    } else if (auto* commandBuffer = get<std::shared_ptr<igl::ICommandBuffer>>(commandsId)) {
+      texture->generateMipmap(**commandBuffer, rangePtr);
+    } else {
+      return false;
+    }
+    return true;
+  }
+  case TraceOp::CreateCommandBuffer:
+  case TraceOp::Submit:
+  case TraceOp::Present:
+  case TraceOp::WaitUntilScheduled:
+  case TraceOp::WaitUntilCompleted:
+  case TraceOp::CreateRenderCommandEncoder:
+  case TraceOp::CreateComputeCommandEncoder:
+    return executeCommandBuffer(op, reader);
+  case TraceOp::EndEncoding:
+  case TraceOp::PushDebugGroupLabel:
+  case TraceOp::InsertDebugEventLabel:
+  case TraceOp::PopDebugGroupLabel: {
+    // These records are shared by command buffers and both kinds of encoders
+    const auto id = reader.read<uint32_t>();
+    igl::ICommandEncoder* encoder = nullptr;
+    if (auto* renderEncoder = get<std::unique_ptr<igl::IRenderCommandEncoder>>(id)) {
+      encoder = renderEncoder->get();
+    } else if (auto* computeEncoder = get<std::unique_ptr<igl::IComputeCommandEncoder>>(id)) {
+      encoder = computeEncoder->get();
+    }
+    auto* commandBuffer = get<std::shared_ptr<igl::ICommandBuffer>>(id);
+    std::string label;
+    igl::Color color(1, 1, 1, 1);
+    if (op == TraceOp::PushDebugGroupLabel || op == TraceOp::InsertDebugEventLabel) {
+      label = reader.readString();
+      color = readColor(reader);
+    }
+    if (op == TraceOp::EndEncoding) {
+      if (!encoder) {
+        return false;
+      }
+      encoder->endEncoding();
+      release(id);
+    } else if (encoder) {
+      if (op == TraceOp::PushDebugGroupLabel) {
+        encoder->pushDebugGroupLabel(label.c_str(), color);
+      } else if (op == TraceOp::InsertDebugEventLabel) {
+        encoder->insertDebugEventLabel(label.c_str(), color);
+      } else {
+        encoder->popDebugGroupLabel();
+      }
+    } else if (commandBuffer && *commandBuffer) {
+      if (op == TraceOp::PushDebugGroupLabel) {
+        (*commandBuffer)->pushDebugGroupLabel(label.c_str(), color);
+      } else if (op == TraceOp::PopDebugGroupLabel) {
+        (*commandBuffer)->popDebugGroupLabel();
+      } else {
+        return false;
+      }
+    } else {
+      return false;
+    }
+    return true;
+  }
+  case TraceOp::BindViewport:
+  case TraceOp::BindScissorRect:
+  case TraceOp::BindRenderPipelineState:
+  case TraceOp::BindDepthStencilState:
+  case TraceOp::BindBuffer:
+  case TraceOp::BindVertexBuffer:
+  case TraceOp::BindIndexBuffer:
+  case TraceOp::BindBytes:
+  case TraceOp::BindPushConstants:
+  case TraceOp::BindSamplerState:
+  case TraceOp::BindTexture:
+  case TraceOp::BindUniform:
+  case TraceOp::BindTextureBindGroup:
+  case TraceOp::BindBufferBindGroup:
+  case TraceOp::Draw:
+  case TraceOp::DrawIndexed:
+  case TraceOp::MultiDrawIndirect:
+  case TraceOp::MultiDrawIndexedIndirect:
+  case TraceOp::SetStencilReferenceValue:
+  case TraceOp::SetBlendColor:
+  case TraceOp::SetDepthBias:
+    return executeRenderEncoder(op, reader);
+  case TraceOp::ComputeBindComputePipelineState:
+  case TraceOp::ComputeBindBuffer:
+  case TraceOp::ComputeBindBytes:
+  case TraceOp::ComputeBindPushConstants:
+  case TraceOp::ComputeBindTexture:
+  case TraceOp::ComputeBindUniform:
+  case TraceOp::ComputeDispatchThreadGroups:
+    return executeComputeEncoder(op, reader);
+  case TraceOp::Count:
+    break;
+  }
+  return false;
+}
+
+bool TraceReplayer::executeCreate(TraceOp op, TraceReader& reader) {
+  const auto id = reader.read<uint32_t>();
+  igl::Result result;
+  Object object;
+
+  switch (op) {
+  case TraceOp::CreateCommandQueue: {
+    igl::CommandQueueDesc desc{};
+    desc.type = reader.read<igl::CommandQueueType>();
+    if (auto queue = device_.createCommandQueue(desc, &result)) {
+      object = std::move(queue);
+    }
+    break;
+  }
+  case TraceOp::CreateBuffer: {
+    igl::BufferDesc desc;
+    desc.type = reader.read<igl::BufferDesc::BufferType>();
+    desc.hint = reader.read<igl::BufferDesc::BufferAPIHint>();
+    desc.storage = reader.read<igl::ResourceStorage>();
+    desc.length = static_cast<size_t>(reader.read<uint64_t>());
+    uint32_t dataLength = 0;
+    desc.data = reader.readBlob(dataLength);
+    desc.debugName = reader.readString();
+    if (auto buffer = device_.createBuffer(desc, &result)) {
+      object = std::shared_ptr<igl::IBuffer>(std::move(buffer));
+    }
+    break;
+  }
+  case TraceOp::CreateTexture:
+  case TraceOp::CreateExternalTexture: {
+    igl::TextureDesc desc;
+    read(reader, desc);
+    if (op == TraceOp::CreateExternalTexture) {
+      // Stand-ins for swapchain images are rendered into and never presented
+      desc.usage |= igl::TextureDesc::TextureUsageBits::Attachment;
+    }
+    if (auto texture = device_.createTexture(desc, &result)) {
+      object = std::move(texture);
+    }
+    break;
+  }
+  case TraceOp::CreateSamplerState: {
+    igl::SamplerStateDesc desc;
+    read(reader, desc);
+    if (auto state = device_.createSamplerState(desc, &result)) {
+      object = std::move(state);
+    }
+    break;
+  }
+  case TraceOp::CreateDepthStencilState: {
+    igl::DepthStencilStateDesc desc;
+    read(reader, desc);
+    if (auto state = device_.createDepthStencilState(desc, &result)) {
+      object = std::move(state);
+    }
+    break;
+  }
+  case TraceOp::CreateVertexInputState: {
+    igl::VertexInputStateDesc desc;
+    read(reader, desc);
+    if (auto state = device_.createVertexInputState(desc, &result)) {
+      object = std::move(state);
+    }
+    break;
+  }
+  case TraceOp::CreateShaderModule: {
+    igl::ShaderModuleDesc desc;
+    desc.info.stage = reader.read<igl::ShaderStage>();
+    desc.info.entryPoint = reader.readString();
+    desc.info.debugName = reader.readString();
+    std::string source;
+    readShaderInput(reader, desc.input, source);
+    desc.debugName = reader.readString();
+    if (!reader.ok()) {
+      return false;
+    }
+    if (auto shaderModule = device_.createShaderModule(desc, &result)) {
+      object = std::move(shaderModule);
+    }
+    break;
+  }
+  case TraceOp::CreateShaderLibrary: {
+    igl::ShaderLibraryDesc desc;
+    const uint32_t numModules = reader.read<uint32_t>();
+    for (uint32_t i = 0; i != numModules && reader.ok(); ++i) {
+      igl::ShaderModuleInfo& info = desc.moduleInfo.emplace_back();
+      info.stage = reader.read<igl::ShaderStage>();
+      info.entryPoint = reader.readString();
+      info.debugName = reader.readString();
+    }
+    std::string source;
+    readShaderInput(reader, desc.input, source);
+    desc.debugName = reader.readString();
+    if (!reader.ok()) {
+      return false;
+    }
+    if (auto library = device_.createShaderLibrary(desc, &result)) {
+      object = std::shared_ptr<igl::IShaderLibrary>(std::move(library));
+    }
+    break;
+  }
+  case TraceOp::CreateLibraryShaderModule: {
+    auto* library = get<std::shared_ptr<igl::IShaderLibrary>>(reader.read<uint32_t>());
+    const auto stage = reader.read<igl::ShaderStage>();
+    const std::string entryPoint = reader.readString();
+    if (!library || !reader.ok()) {
+      return false;
+    }
+    if (auto shaderModule = (*library)->getShaderModule(stage, entryPoint)) {
+      object = std::move(shaderModule);
+    }
+    break;
+  }
+  case TraceOp::CreateShaderStages: {
+    igl::ShaderStagesDesc desc;
+    desc.type = reader.read<igl::ShaderStagesType>();
+    desc.vertexModule = getShared<std::shared_ptr<igl::IShaderModule>>(reader.read<uint32_t>());
+    desc.fragmentModule = getShared<std::shared_ptr<igl::IShaderModule>>(reader.read<uint32_t>());
+    desc.computeModule = getShared<std::shared_ptr<igl::IShaderModule>>(reader.read<uint32_t>());
+    desc.debugName = reader.readString();
+    if (!desc.vertexModule && !desc.fragmentModule && !desc.computeModule) {
+      return false;
+    }
+    if (auto stages = device_.createShaderStages(desc, &result)) {
+      object = std::shared_ptr<igl::IShaderStages>(std::move(stages));
+    }
+    break;
+  }
+  case TraceOp::CreateRenderPipeline: {
+    igl::RenderPipelineDesc desc;
+    desc.topology = reader.read<igl::PrimitiveType>();
+    desc.vertexInputState =
+        getShared<std::shared_ptr<igl::IVertexInputState>>(reader.read<uint32_t>());
+    desc.shaderStages = getShared<std::shared_ptr<igl::IShaderStages>>(reader.read<uint32_t>());
+    read(reader, desc.targetDesc);
+    desc.cullMode = reader.read<igl::CullMode>();
+    desc.frontFaceWinding = reader.read<igl::WindingMode>();
+    desc.polygonFillMode = reader.read<igl::PolygonFillMode>();
+    read(reader, desc.vertexUnitSamplerMap);
+    read(reader, desc.fragmentUnitSamplerMap);
+    read(reader, desc.uniformBlockBindingMap);
+    desc.sampleCount = reader.read<uint32_t>();
+    desc.isDynamicBufferMask = reader.read<uint32_t>();
+    const uint32_t numSamplers = reader.read<uint32_t>();
+    for (uint32_t i = 0; i != numSamplers && reader.ok(); ++i) {
+      auto sampler = getShared<std::shared_ptr<igl::ISamplerState>>(reader.read<uint32_t>());
+      if (i < igl::IGL_TEXTURE_SAMPLERS_MAX) {
+        desc.immutableSamplers[i] = std::move(sampler);
+      }
+    }
+    desc.debugName = igl::genNameHandle(reader.readString());
+    if (!desc.shaderStages || !reader.ok()) {
+      return false;
+    }
+    if (auto pipeline = device_.createRenderPipeline(desc, &result)) {
+      object = std::move(pipeline);
+    }
+    break;
+  }
+  case TraceOp::CreateComputePipeline: {
+    igl::ComputePipelineDesc desc;
+    read(reader, desc.imagesMap);
+    read(reader, desc.buffersMap);
+    desc.shaderStages = getShared<std::shared_ptr<igl::IShaderStages>>(reader.read<uint32_t>());
+    desc.debugName = reader.readString();
+    if (!desc.shaderStages || !reader.ok()) {
+      return false;
+    }
+    if (auto pipeline = device_.createComputePipeline(desc, &result)) {
+      object = std::move(pipeline);
+    }
+    break;
+  }
+  case TraceOp::CreateFramebuffer: {
+    igl::FramebufferDesc desc;
+    // Returns the id of the attachment's texture
+    auto readAttachment = [this, &reader](igl::FramebufferDesc::AttachmentDesc& attachment) {
+      const auto textureId = reader.read<uint32_t>();
+      attachment.texture = getShared<std::shared_ptr<igl::ITexture>>(textureId);
+      attachment.resolveTexture =
+          getShared<std::shared_ptr<igl::ITexture>>(reader.read<uint32_t>());
+      return textureId;
+    };
+    const uint32_t numColorAttachments = reader.read<uint32_t>();
+    Drawable drawable;
+    for (uint32_t i = 0; i != numColorAttachments && reader.ok(); ++i) {
+      igl::FramebufferDesc::AttachmentDesc attachment;
+      const uint32_t textureId = readAttachment(attachment);
+      if (i == 0) {
+        drawable.colorId = textureId;
+      }
+      if (i < igl::IGL_COLOR_ATTACHMENTS_MAX) {
+        desc.colorAttachments[i] = std::move(attachment);
+      }
+    }
+    drawable.depthId = readAttachment(desc.depthAttachment);
+    readAttachment(desc.stencilAttachment);
+    desc.mode = reader.read<igl::FramebufferMode>();
+    desc.debugName = reader.readString();
+    if (!reader.ok()) {
+      return false;
+    }
+    if (auto framebuffer = device_.createFramebuffer(desc, &result)) {
+      object = std::move(framebuffer);
+      drawables_[id] = drawable;
+    }
+    break;
+  }
+  case TraceOp::CreateTextureBindGroup: {
+    igl::BindGroupTextureDesc desc;
+    auto* pipeline = get<std::shared_ptr<igl::IRenderPipelineState>>(reader.read<uint32_t>());
+    const uint32_t numSlots = reader.read<uint32_t>();
+    for (uint32_t i = 0; i != numSlots && reader.ok(); ++i) {
+      auto texture = getShared<std::shared_ptr<igl::ITexture>>(reader.read<uint32_t>());
+      auto sampler = getShared<std::shared_ptr<igl::ISamplerState>>(reader.read<uint32_t>());
+      if (i < igl::IGL_TEXTURE_SAMPLERS_MAX) {
+        desc.textures[i] = std::move(texture);
+        desc.samplers[i] = std::move(sampler);
+      }
+    }
+    desc.debugName = reader.readString();
+    if (!reader.ok()) {
+      return false;
+    }
+    auto holder = device_.createBindGroup(desc, pipeline ? pipeline->get() : nullptr, &result);
+    if (!holder.empty()) {
+      object = std::move(holder);
+    }
+    break;
+  }
+  case TraceOp::CreateBufferBindGroup: {
+    igl::BindGroupBufferDesc desc;
+    const uint32_t numSlots = reader.read<uint32_t>();
+    for (uint32_t i = 0; i != numSlots && reader.ok(); ++i) {
+      auto buffer = getShared<std::shared_ptr<igl::IBuffer>>(reader.read<uint32_t>());
+      const auto offset = static_cast<size_t>(reader.read<uint64_t>());
+      const auto size = static_cast<size_t>(reader.read<uint64_t>());
+      if (i < igl::IGL_UNIFORM_BLOCKS_BINDING_MAX) {
+        desc.buffers[i] = std::move(buffer);
+        desc.offset[i] = offset;
+        desc.size[i] = size;
+      }
+    }
+    desc.isDynamicBufferMask = reader.read<uint32_t>();
+    desc.debugName = reader.readString();
+    if (!reader.ok()) {
+      return false;
+    }
+    auto holder = device_.createBindGroup(desc, &result);
+    if (!holder.empty()) {
+      object = std::move(holder);
+    }
+    break;
+  }
+  default:
+    IGL_DEBUG_ASSERT_NOT_REACHED();
+    return false;
+  }
+
+  if (object.index() == 0) {
+    return false;
+  }
+  set(id, std::move(object));
+  return true;
+}
+
+bool TraceReplayer::executeCommandBuffer(TraceOp op, TraceReader& reader) {
+  switch (op) {
+  case TraceOp::CreateCommandBuffer: {
+    auto* queue = get<std::shared_ptr<igl::ICommandQueue>>(reader.read<uint32_t>());
+    const auto id = reader.read<uint32_t>();
+    igl::CommandBufferDesc desc;
+    desc.debugName = reader.readString();
+    if (!queue || !reader.ok()) {
+      return false;
+    }
+    auto commandBuffer = (*queue)->createCommandBuffer(desc, nullptr);
+    if (!commandBuffer) {
+      return false;
+    }
+    set(id, std::move(commandBuffer));
+    return true;
+  }
+  case TraceOp::Submit: {
+    const auto queueId = reader.read<uint32_t>();
+    const auto id = reader.read<uint32_t>();
+    const auto endOfFrame = reader.read<bool>();
+    auto* queue = get<std::shared_ptr<igl::ICommandQueue>>(queueId);
+    auto* commandBuffer = get<std::shared_ptr<igl::ICommandBuffer>>(id);
+    if (!queue || !commandBuffer) {
+      return false;
+    }
+    (*queue)->submit(**commandBuffer, endOfFrame);
+    uint32_t& lastSubmitted = lastSubmitted_[queueId];
+    if (lastSubmitted != id) {
+      release(lastSubmitted);
+      lastSubmitted = id;
+    }
+    return true;
+  }
+  case TraceOp::Present:
+    // Replay renders offscreen
+    return false;
+  case TraceOp::WaitUntilScheduled:
+  case TraceOp::WaitUntilCompleted: {
+    auto* commandBuffer = get<std::shared_ptr<igl::ICommandBuffer>>(reader.read<uint32_t>());
+    if (!commandBuffer) {
+      return false;
+    }
+    if (op == TraceOp::WaitUntilScheduled) {
+      (*commandBuffer)->waitUntilScheduled();
+    } else {
+      (*commandBuffer)->waitUntilCompleted();
+    }
+    return true;
+  }
+  case TraceOp::CreateRenderCommandEncoder: {
+    auto* commandBuffer = get<std::shared_ptr<igl::ICommandBuffer>>(reader.read<uint32_t>());
+    const auto id = reader.read<uint32_t>();
+    igl::RenderPassDesc renderPass;
+    read(reader, renderPass);
+    const auto framebufferId = reader.read<uint32_t>();
+    Drawable drawable;
+    drawable.colorId = reader.read<uint32_t>();
+    drawable.depthId = reader.read<uint32_t>();
+    const igl::Dependencies& dependencies = readDependencies(reader);
+    auto* framebuffer = get<std::shared_ptr<igl::IFramebuffer>>(framebufferId);
+    if (!commandBuffer || !framebuffer || !reader.ok()) {
+      return false;
+    }
+    // Framebuffers that render into a swapchain get a new drawable every frame
+    Drawable& current = drawables_[framebufferId];
+    if (current.colorId != drawable.colorId || current.depthId != drawable.depthId) {
+      igl::SurfaceTextures surfaceTextures;
+      surfaceTextures.color = getShared<std::shared_ptr<igl::ITexture>>(drawable.colorId);
+      surfaceTextures.depth = getShared<std::shared_ptr<igl::ITexture>>(drawable.depthId);
+      (*framebuffer)->updateDrawable(std::move(surfaceTextures));
+      current = drawable;
+    }
+    auto encoder =
+        (*commandBuffer)->createRenderCommandEncoder(renderPass, *framebuffer, dependencies);
+    if (!encoder) {
+      return false;
+    }
+    set(id, std::move(encoder));
+    return true;
+  }
+  case TraceOp::CreateComputeCommandEncoder: {
+    auto* commandBuffer = get<std::shared_ptr<igl::ICommandBuffer>>(reader.read<uint32_t>());
+    const auto id = reader.read<uint32_t>();
+    if (!commandBuffer) {
+      return false;
+    }
+    auto encoder = (*commandBuffer)->createComputeCommandEncoder();
+    if (!encoder) {
+      return false;
+    }
+    set(id, std::move(encoder));
+    return true;
+  }
+  default:
+    IGL_DEBUG_ASSERT_NOT_REACHED();
+    return false;
+  }
+}
+
+bool TraceReplayer::executeRenderEncoder(TraceOp op, TraceReader& reader) {
+  auto* encoderPtr = get<std::unique_ptr<igl::IRenderCommandEncoder>>(reader.read<uint32_t>());
+  if (!encoderPtr) {
+    return false;
+  }
+  igl::IRenderCommandEncoder& encoder = **encoderPtr;
+
+  switch (op) {
+  case TraceOp::BindViewport:
+    encoder.bindViewport(reader.read<igl::Viewport>());
+    return true;
+  case TraceOp::BindScissorRect:
+    encoder.bindScissorRect(reader.read<igl::ScissorRect>());
+    return true;
+  case TraceOp::BindRenderPipelineState: {
+    auto* pipeline = get<std::shared_ptr<igl::IRenderPipelineState>>(reader.read<uint32_t>());
+    if (!pipeline) {
+      return false;
+    }
+    encoder.bindRenderPipelineState(*pipeline);
+    return true;
+  }
+  case TraceOp::BindDepthStencilState: {
+    auto* state = get<std::shared_ptr<igl::IDepthStencilState>>(reader.read<uint32_t>());
+    if (!state) {
+      return false;
+    }
+    encoder.bindDepthStencilState(*state);
+    return true;
+  }
+  case TraceOp::BindBuffer: {
+    const auto index = reader.read<uint32_t>();
+    igl::IBuffer* buffer = getBuffer(reader.read<uint32_t>());
+    const auto offset = static_cast<size_t>(reader.read<uint64_t>());
+    const auto size = static_cast<size_t>(reader.read<uint64_t>());
+    if (!buffer) {
+      return false;
+    }
+    encoder.bindBuffer(index, buffer, offset, size);
+    return true;
+  }
+  case TraceOp::BindVertexBuffer: {
+    const auto index = reader.read<uint32_t>();
+    igl::IBuffer* buffer = getBuffer(reader.read<uint32_t>());
+    const auto offset = static_cast<size_t>(reader.read<uint64_t>());
+    if (!buffer) {
+      return false;
+    }
+    encoder.bindVertexBuffer(index, *buffer, offset);
+    return true;
+  }
+  case TraceOp::BindIndexBuffer: {
+    igl::IBuffer* buffer = getBuffer(reader.read<uint32_t>());
+    const auto format = reader.read<igl::IndexFormat>();
+    const auto offset = static_cast<size_t>(reader.read<uint64_t>());
+    if (!buffer) {
+      return false;
+    }
+    encoder.bindIndexBuffer(*buffer, format, offset);
+    return true;
+  }
+  case TraceOp::BindBytes: {
+    const auto index = static_cast<size_t>(reader.read<uint64_t>());
+    const auto target = reader.read<uint8_t>();
+    uint32_t length = 0;
+    const uint8_t* blob = reader.readBlob(length);
+    const void* data = alignedCopy(blob, length);
+    if (!data) {
+      return false;
+    }
+    encoder.bindBytes(index, target, data, length);
+    return true;
+  }
+  case TraceOp::BindPushConstants: {
+    const auto offset = static_cast<size_t>(reader.read<uint64_t>());
+    uint32_t length = 0;
+    const uint8_t* blob = reader.readBlob(length);
+    const void* data = alignedCopy(blob, length);
+    if (!data) {
+      return false;
+    }
+    encoder.bindPushConstants(data, length, offset);
+    return true;
+  }
+  case TraceOp::BindSamplerState: {
+    const auto index = static_cast<size_t>(reader.read<uint64_t>());
+    const auto target = reader.read<uint8_t>();
+    auto* sampler = get<std::shared_ptr<igl::ISamplerState>>(reader.read<uint32_t>());
+    encoder.bindSamplerState(index, target, sampler ? sampler->get() : nullptr);
+    return true;
+  }
+  case TraceOp::BindTexture: {
+    const auto index = static_cast<size_t>(reader.read<uint64_t>());
+    const auto target = reader.read<uint8_t>();
+    encoder.bindTexture(index, target, getTexture(reader.read<uint32_t>()));
+    return true;
+  }
+  case TraceOp::BindUniform: {
+    igl::UniformDesc desc;
+    uint32_t length = 0;
+    const uint8_t* blob = read(reader, desc, length);
+    const void* data = alignedCopy(blob, length);
+    if (!data) {
+      return false;
+    }
+    encoder.bindUniform(desc, data);
+    return true;
+  }
+  case TraceOp::BindTextureBindGroup: {
+    auto* holder = get<igl::Holder<igl::BindGroupTextureHandle>>(reader.read<uint32_t>());
+    if (!holder) {
+      return false;
+    }
+    encoder.bindBindGroup(static_cast<igl::BindGroupTextureHandle>(*holder));
+    return true;
+  }
+  case TraceOp::BindBufferBindGroup: {
+    auto* holder = get<igl::Holder<igl::BindGroupBufferHandle>>(reader.read<uint32_t>());
+    uint32_t length = 0;
+    const uint8_t* offsets = reader.readBlob(length);
+    if (!holder) {
+      return false;
+    }
+    // Copied because the trace gives no alignment guarantees
+    std::vector<uint32_t> dynamicOffsets(length / sizeof(uint32_t));
+    if (!dynamicOffsets.empty()) {
+      std::memcpy(dynamicOffsets.data(), offsets, dynamicOffsets.size() * sizeof(uint32_t));
+    }
+    encoder.bindBindGroup(static_cast<igl::BindGroupBufferHandle>(*holder),
+                          static_cast<uint32_t>(dynamicOffsets.size()),
+                          dynamicOffsets.empty() ? nullptr : dynamicOffsets.data());
+    return true;
+  }
+  case TraceOp::Draw: {
+    const auto vertexCount = static_cast<size_t>(reader.read<uint64_t>());
+    const auto instanceCount = reader.read<uint32_t>();
+    const auto firstVertex = reader.read<uint32_t>();
+    const auto baseInstance = reader.read<uint32_t>();
+    encoder.draw(vertexCount, instanceCount, firstVertex, baseInstance);
+    return true;
+  }
+  case TraceOp::DrawIndexed: {
+    const auto indexCount = static_cast<size_t>(reader.read<uint64_t>());
+    const auto instanceCount = reader.read<uint32_t>();
+    const auto firstIndex = reader.read<uint32_t>();
+    const auto vertexOffset = reader.read<int32_t>();
+    const auto baseInstance = reader.read<uint32_t>();
+    encoder.drawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, baseInstance);
+    return true;
+  }
+  case TraceOp::MultiDrawIndirect:
+  case TraceOp::MultiDrawIndexedIndirect: {
+    igl::IBuffer* buffer = getBuffer(reader.read<uint32_t>());
+    const auto offset = static_cast<size_t>(reader.read<uint64_t>());
+    const auto drawCount = reader.read<uint32_t>();
+    const auto stride = reader.read<uint32_t>();
+    if (!buffer) {
+      return false;
+    }
+    if (op == TraceOp::MultiDrawIndirect) {
+      encoder.multiDrawIndirect(*buffer, offset, drawCount, stride);
+    } else {
+      encoder.multiDrawIndexedIndirect(*buffer, offset, drawCount, stride);
+    }
+    return true;
+  }
+  case TraceOp::SetStencilReferenceValue:
+    encoder.setStencilReferenceValue(reader.read<uint32_t>());
+    return true;
+  case TraceOp::SetBlendColor:
+    encoder.setBlendColor(readColor(reader));
+    return true;
+  case TraceOp::SetDepthBias: {
+    const auto depthBias = reader.read<float>();
+    const auto slopeScale = reader.read<float>();
+    const auto clamp = reader.read<float>();
+    encoder.setDepthBias(depthBias, slopeScale, clamp);
+    return true;
+  }
+  default:
+    IGL_DEBUG_ASSERT_NOT_REACHED();
+    return false;
+  }
+}
+
+bool TraceReplayer::executeComputeEncoder(TraceOp op, TraceReader& reader) {
+  auto* encoderPtr = get<std::unique_ptr<igl::IComputeCommandEncoder>>(reader.read<uint32_t>());
+  if (!encoderPtr) {
+    return false;
+  }
+  igl::IComputeCommandEncoder& encoder = **encoderPtr;
+
+  switch (op) {
+  case TraceOp::ComputeBindComputePipelineState: {
+    auto* pipeline = get<std::shared_ptr<igl::IComputePipelineState>>(reader.read<uint32_t>());
+    if (!pipeline) {
+      return false;
+    }
+    encoder.bindComputePipelineState(*pipeline);
+    return true;
+  }
+  case TraceOp::ComputeBindBuffer: {
+    const auto index = reader.read<uint32_t>();
+    igl::IBuffer* buffer = getBuffer(reader.read<uint32_t>());
+    const auto offset = static_cast<size_t>(reader.read<uint64_t>());
+    const auto size = static_cast<size_t>(reader.read<uint64_t>());
+    if (!buffer) {
+      return false;
+    }
+    encoder.bindBuffer(index, buffer, offset, size);
+    return true;
+  }
+  case TraceOp::ComputeBindBytes: {
+    const auto index = static_cast<size_t>(reader.read<uint64_t>());
+    uint32_t length = 0;
+    const uint8_t* blob = reader.readBlob(length);
+    const void* data = alignedCopy(blob, length);
+    if (!data) {
+      return false;
+    }
+    encoder.bindBytes(index, data, length);
+    return true;
+  }
+  case TraceOp::ComputeBindPushConstants: {
+    const auto offset = static_cast<size_t>(reader.read<uint64_t>());
+    uint32_t length = 0;
+    const uint8_t* blob = reader.readBlob(length);
+    const void* data = alignedCopy(blob, length);
+    if (!data) {
+      return false;
+    }
+    encoder.bindPushConstants(data, length, offset);
+    return true;
+  }
+  case TraceOp::ComputeBindTexture: {
+    const auto index = reader.read<uint32_t>();
+    encoder.bindTexture(index, getTexture(reader.read<uint32_t>()));
+    return true;
+  }
+  case TraceOp::ComputeBindUniform: {
+    igl::UniformDesc desc;
+    uint32_t length = 0;
+    const uint8_t* blob = read(reader, desc, length);
+    const void* data = alignedCopy(blob, length);
+    if (!data) {
+      return false;
+    }
+    encoder.bindUniform(desc, data);
+    return true;
+  }
+  case TraceOp::ComputeDispatchThreadGroups: {
+    const auto threadgroupCount = reader.read<igl::Dimensions>();
+    const auto threadgroupSize = reader.read<igl::Dimensions>();
+    const igl::Dependencies& dependencies = readDependencies(reader);
+    encoder.dispatchThreadGroups(threadgroupCount, threadgroupSize, dependencies);
+    return true;
+  }
+  default:
+    IGL_DEBUG_ASSERT_NOT_REACHED();
+    return false;
+  }
+}
+
+} // namespace iglu::capture
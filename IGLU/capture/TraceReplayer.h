@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <IGLU/capture/TraceFormat.h>
+#include <array>
+#include <igl/Buffer.h>
+#include <igl/CommandBuffer.h>
+#include <igl/CommandQueue.h>
+#include <igl/ComputeCommandEncoder.h>
+#include <igl/ComputePipelineState.h>
+#include <igl/Device.h>
+#include <igl/Framebuffer.h>
+#include <igl/RenderPipelineState.h>
+#include <igl/Shader.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace iglu::capture {
+
+/// CPU time spent replaying each kind of record.
+struct ReplayStatistics {
+  struct OpStatistics {
+    /// Records that were executed.
+    size_t count = 0;
+    /// Records whose objects the replay device did not create, and Present records.
+    size_t skipped = 0;
+    double totalMs = 0.0;
+  };
+
+  std::array<OpStatistics, kNumTraceOps> ops = {};
+  size_t numRecords = 0;
+  double totalMs = 0.0;
+
+  [[nodiscard]] const OpStatistics& operator[](TraceOp op) const {
+    return ops[static_cast<size_t>(op)];
+  }
+  /// One line per record kind that was seen, sorted by total time.
+  [[nodiscard]] std::string toString() const;
+};
+
+/**
+ * Replays a trace recorded by CaptureDevice on any device, timing every call. Replay renders into
+ * the textures the trace creates and never presents, so any backend, including a headless one or
+ * iglu::sentinel::Device, can replay any trace. With the sentinel device nothing is created and the
+ * statistics measure decoding and dispatch alone.
+ */
+class TraceReplayer final {
+ public:
+  explicit TraceReplayer(igl::IDevice& device);
+
+  /// Replays the whole trace. Objects created by the trace are released when replay ends.
+  igl::Result replay(const uint8_t* IGL_NULLABLE data,
+                     size_t length,
+                     ReplayStatistics* IGL_NULLABLE outStatistics = nullptr);
+
+ private:
+  using Object = std::variant<std::monostate,
+                              std::shared_ptr<igl::ICommandQueue>,
+                              std::shared_ptr<igl::IBuffer>,
+                              std::shared_ptr<igl::ITexture>,
+                              std::shared_ptr<igl::ISamplerState>,
+                              std::shared_ptr<igl::IDepthStencilState>,
+                              std::shared_ptr<igl::IVertexInputState>,
+                              std::shared_ptr<igl::IShaderModule>,
+                              std::shared_ptr<igl::IShaderLibrary>,
+                              std::shared_ptr<igl::IShaderStages>,
+                              std::shared_ptr<igl::IRenderPipelineState>,
+                              std::shared_ptr<igl::IComputePipelineState>,
+                              std::shared_ptr<igl::IFramebuffer>,
+                              igl::Holder<igl::BindGroupTextureHandle>,
+                              igl::Holder<igl::BindGroupBufferHandle>,
+                              std::shared_ptr<igl::ICommandBuffer>,
+                              std::unique_ptr<igl::IRenderCommandEncoder>,
+                              std::unique_ptr<igl::IComputeCommandEncoder>>;
+
+  /// Textures a framebuffer currently renders into, by trace id.
+  struct Drawable {
+    uint32_t colorId = 0;
+    uint32_t depthId = 0;
+  };
+
+  /// Returns false if the record was skipped.
+  bool execute(TraceOp op, TraceReader& reader);
+  bool executeCreate(TraceOp op, TraceReader& reader);
+  bool executeCommandBuffer(TraceOp op, TraceReader& reader);
+  bool executeRenderEncoder(TraceOp op, TraceReader& reader);
+  bool executeComputeEncoder(TraceOp op, TraceReader& reader);
+
+  void set(uint32_t id, Object object);
+  void release(uint32_t id);
+  template<typename T>
+  [[nodiscard]] T* IGL_NULLABLE get(uint32_t id) {
+    return id < objects_.size() ? std::get_if<T>(&objects_[id]) : nullptr;
+  }
+  template<typename T>
+  [[nodiscard]] T getShared(uint32_t id) {
+    const T* object = get<T>(id);
+    return object ? *object : T();
+  }
+  igl::IBuffer* IGL_NULLABLE getBuffer(uint32_t id);
+  igl::ITexture* IGL_NULLABLE getTexture(uint32_t id);
+  /// Blobs inside the trace have no alignment, so data handed to the device is copied first.
+  const void* IGL_NULLABLE alignedCopy(const uint8_t* IGL_NULLABLE data, uint32_t length);
+  /// Reads a Dependencies chain written by CapturedDependencies into dependencies_.
+  const igl::Dependencies& readDependencies(TraceReader& reader);
+
+  igl::IDevice& device_;
+  std::vector<Object> objects_;
+  std::unordered_map<uint32_t, Drawable> drawables_;
+  /// Per queue, the last command buffer submitted. It is released by the next submission so that
+  /// waits issued right after a submit still find it.
+  std::unordered_map<uint32_t, uint32_t> lastSubmitted_;
+  std::vector<igl::Dependencies> dependencies_;
+  std::vector<uint64_t> scratch_;
+  size_t maxId_ = 0;
+};
+
+} // namespace iglu::capture
@@ -7,8 +7,10 @@
 
 #include <IGLU/managedUniformBuffer/ManagedUniformBuffer.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <igl/Macros.h>
+#include <numeric>
 
 #if defined(IGL_CMAKE_BUILD)
 #include <igl/IGLSafeC.h>
@@ -26,6 +28,7 @@
 #endif
 
 namespace iglu {
+
 ManagedUniformBuffer::ManagedUniformBuffer(igl::IDevice& device,
                                            const ManagedUniformBufferInfo& info) :
   uniformInfo(info) {
@@ -93,11 +96,28 @@ ManagedUniformBuffer::ManagedUniformBuffer(igl::IDevice& device,
     desc.type = igl::BufferDesc::BufferTypeBits::Uniform;
     desc.storage = igl::ResourceStorage::Shared;
 
+    size_t numBuffers = std::max<size_t>(info.numBuffers, 1);
     if (device.hasFeature(igl::DeviceFeatures::BufferNoCopy)) {
       desc.type |= igl::BufferDesc::BufferAPIHintBits::NoCopy;
+      // Every copy would share data_, so extra copies can't help
+      numBuffers = 1;
+    }
+    const size_t dirtyWords = (uniformInfo.uniforms.size() + 63) / 64;
+    buffers_.resize(numBuffers);
+    for (auto& copy : buffers_) {
+      copy.buffer = device.createBuffer(desc, &result);
+      copy.dirtyUniforms.resize(dirtyWords, 0);
+      if (!result.isOk()) {
+        return;
+      }
     }
-    buffer_ = device.createBuffer(desc, &result);
   }
+
+  uniformsByOffset_.resize(uniformInfo.uniforms.size());
+  std::iota(uniformsByOffset_.begin(), uniformsByOffset_.end(), 0);
+  std::sort(uniformsByOffset_.begin(), uniformsByOffset_.end(), [this](size_t a, size_t b) {
+    return uniformInfo.uniforms[a].offset < uniformInfo.uniforms[b].offset;
+  });
 }
 
 ManagedUniformBuffer::~ManagedUniformBuffer() {
@@ -138,14 +158,7 @@ void ManagedUniformBuffer::bind(const igl::IDevice& device,
     if (useBindBytes_) {
       encoder.bindBytes(uniformInfo.index, igl::BindTarget::kAllGraphics, data_, length_);
     } else {
-      // Need to ensure the latest data is present in the buffer
-      // TODO: Have callers handle this when data has changed.
-      void* data = data_;
-      if (buffer_->acceptedApiHints() & igl::BufferDesc::BufferAPIHintBits::NoCopy) {
-        data = nullptr;
-      }
-      buffer_->upload(data, {buffer_->getSizeInBytes(), 0});
-      encoder.bindBuffer(uniformInfo.index, buffer_.get());
+      encoder.bindBuffer(uniformInfo.index, &prepareBufferForBind());
     }
   }
 }
@@ -157,19 +170,96 @@ void ManagedUniformBuffer::bind(const igl::IDevice& device, igl::IComputeCommand
     if (useBindBytes_) {
       encoder.bindBytes(uniformInfo.index, data_, length_);
     } else {
-      // Need to ensure the latest data is present in the buffer
-      // TODO: Have callers handle this when data has changed.
-      void* data = data_;
-      if (buffer_->acceptedApiHints() & igl::BufferDesc::BufferAPIHintBits::NoCopy) {
-        data = nullptr;
+      encoder.bindBuffer(static_cast<uint32_t>(uniformInfo.index), &prepareBufferForBind());
+    }
+  }
+}
+
+igl::IBuffer& ManagedUniformBuffer::prepareBufferForBind() {
+  IGL_DEBUG_ASSERT(!buffers_.empty());
+  // Move on to the copy bound longest ago whenever the data changed, so the copy bound last is
+  // never written while the GPU may still read it
+  if (changedSinceBind_) {
+    currentBuffer_ = (currentBuffer_ + 1) % buffers_.size();
+    changedSinceBind_ = false;
+  }
+  auto& copy = buffers_[currentBuffer_];
+  auto& buffer = *copy.buffer;
+
+  if (buffer.acceptedApiHints() & igl::BufferDesc::BufferAPIHintBits::NoCopy) {
+    // The buffer shares data_, this only tells the backend the contents changed
+    buffer.upload(nullptr, {buffer.getSizeInBytes(), 0});
+    return buffer;
+  }
+
+  const auto* bytes = static_cast<const uint8_t*>(data_);
+  const size_t length = std::min<size_t>(uniformInfo.length, buffer.getSizeInBytes());
+  if (copy.allDirty || uniformsByOffset_.size() != uniformInfo.uniforms.size()) {
+    buffer.upload(bytes, {length, 0});
+  } else {
+    dirtyScratch_.clear();
+    for (const size_t i : uniformsByOffset_) {
+      if (copy.dirtyUniforms[i / 64] & (uint64_t(1) << (i % 64))) {
+        dirtyScratch_.push_back(i);
       }
-      buffer_->upload(data, {buffer_->getSizeInBytes(), 0});
-      encoder.bindBuffer(static_cast<uint32_t>(uniformInfo.index), buffer_.get());
     }
+    rangesScratch_.clear();
+    coalesceUniformRanges(uniformInfo.uniforms, dirtyScratch_, length, rangesScratch_);
+    for (const auto& range : rangesScratch_) {
+      buffer.upload(bytes + range.offset, range);
+    }
+  }
+  std::fill(copy.dirtyUniforms.begin(), copy.dirtyUniforms.end(), 0);
+  copy.allDirty = false;
+  return buffer;
+}
+
+void ManagedUniformBuffer::coalesceUniformRanges(const std::vector<igl::UniformDesc>& uniforms,
+                                                 const std::vector<size_t>& dirtyUniforms,
+                                                 size_t length,
+                                                 std::vector<igl::BufferRange>& outRanges) {
+  size_t rangeBegin = 0;
+  size_t rangeEnd = 0;
+  for (const size_t i : dirtyUniforms) {
+    const auto& uniform = uniforms[i];
+    const size_t begin = std::min(uniform.offset, length);
+    const size_t end = std::min(begin + getUniformDataSizeInternal(uniform), length);
+    if (rangeEnd > rangeBegin && begin <= rangeEnd + kCoalesceGap) {
+      rangeEnd = std::max(rangeEnd, end);
+      continue;
+    }
+    if (rangeEnd > rangeBegin) {
+      outRanges.emplace_back(rangeEnd - rangeBegin, rangeBegin);
+    }
+    rangeBegin = begin;
+    rangeEnd = end;
+  }
+  if (rangeEnd > rangeBegin) {
+    outRanges.emplace_back(rangeEnd - rangeBegin, rangeBegin);
+  }
+}
+
+void ManagedUniformBuffer::markDirty(size_t uniformIndex) {
+  for (auto& copy : buffers_) {
+    if (uniformIndex / 64 < copy.dirtyUniforms.size()) {
+      copy.dirtyUniforms[uniformIndex / 64] |= uint64_t(1) << (uniformIndex % 64);
+    } else {
+      // uniformInfo gained uniforms after construction
+      copy.allDirty = true;
+    }
+  }
+  changedSinceBind_ = true;
+}
+
+void ManagedUniformBuffer::markAllDirty() {
+  for (auto& copy : buffers_) {
+    copy.allDirty = true;
   }
+  changedSinceBind_ = true;
 }
 
 void* ManagedUniformBuffer::getData() {
+  markAllDirty();
   return data_;
 }
 
@@ -201,26 +291,8 @@ bool ManagedUniformBuffer::updateData(const char* name, const void* data, size_t
     index = findUniformByName(uniformInfo.uniforms, name);
   }
 
-  if (index >= 0) {
-    auto& uniform = uniformInfo.uniforms[index];
-    if (strcmp(name, uniform.name.c_str()) == 0) {
-      // If dataSize is smaller than the expected size, we will just update as client requested.
-      // This could mean the user knows only a portion of the uniform data needs updating
-      // However, if dataSize is larger than or equal to what we expect for this uniform, we will
-      // only copy data up to the expected data size for this uniform
-      const size_t uniformDataSize = getUniformDataSizeInternal(uniform);
-      if (dataSize > uniformDataSize) {
-        dataSize = uniformDataSize;
-#if IGL_DEBUG
-        IGL_LOG_INFO_ONCE(
-            "IGLU/ManagedBufferBuffer/updateData: dataSize is larger than expected. This could be "
-            "benign. See comments in updateData for more details. \n");
-#endif
-      }
-      char* ptr = reinterpret_cast<char*>(data_);
-      checked_memcpy(ptr + uniform.offset, uniformDataSize, data, dataSize);
-      return true;
-    }
+  if (index >= 0 && strcmp(name, uniformInfo.uniforms[index].name.c_str()) == 0) {
+    return updateData(UniformHandle{index}, data, dataSize);
   }
 #ifndef GTEST
   IGL_DEBUG_ABORT("call to updateData: uniform with name %s not found, skipping update\n", name);
@@ -228,6 +300,39 @@ bool ManagedUniformBuffer::updateData(const char* name, const void* data, size_t
   return false;
 }
 
+bool ManagedUniformBuffer::updateData(UniformHandle handle, const void* data, size_t dataSize) {
+  if (!handle.isValid() || static_cast<size_t>(handle.index) >= uniformInfo.uniforms.size()) {
+#ifndef GTEST
+    IGL_DEBUG_ABORT("call to updateData: invalid uniform handle, skipping update\n");
+#endif
+    return false;
+  }
+
+  const auto& uniform = uniformInfo.uniforms[handle.index];
+  // If dataSize is smaller than the expected size, we will just update as client requested.
+  // This could mean the user knows only a portion of the uniform data needs updating
+  // However, if dataSize is larger than or equal to what we expect for this uniform, we will
+  // only copy data up to the expected data size for this uniform
+  const size_t uniformDataSize = getUniformDataSizeInternal(uniform);
+  if (dataSize > uniformDataSize) {
+    dataSize = uniformDataSize;
+#if IGL_DEBUG
+    IGL_LOG_INFO_ONCE(
+        "IGLU/ManagedBufferBuffer/updateData: dataSize is larger than expected. This could be "
+        "benign. See comments in updateData for more details. \n");
+#endif
+  }
+  char* ptr = reinterpret_cast<char*>(data_);
+  checked_memcpy(ptr + uniform.offset, uniformDataSize, data, dataSize);
+  markDirty(handle.index);
+  return true;
+}
+
+ManagedUniformBuffer::UniformHandle ManagedUniformBuffer::getUniformHandle(const char* name) const {
+  IGL_DEBUG_ASSERT(name);
+  return UniformHandle{findUniformByName(uniformInfo.uniforms, name)};
+}
+
 size_t ManagedUniformBuffer::getUniformDataSize(const char* name) {
   for (auto& uniform : uniformInfo.uniforms) {
     if (strcmp(name, uniform.name.c_str()) == 0) {
@@ -237,7 +342,7 @@ size_t ManagedUniformBuffer::getUniformDataSize(const char* name) {
   return 0;
 }
 
-size_t ManagedUniformBuffer::getUniformDataSizeInternal(igl::UniformDesc& uniform) {
+size_t ManagedUniformBuffer::getUniformDataSizeInternal(const igl::UniformDesc& uniform) {
   const size_t uniformDataSize = uniform.elementStride != 0
                                      ? uniform.numElements * uniform.elementStride
                                      : uniform.numElements * igl::sizeForUniformType(uniform.type);
@@ -15,16 +15,33 @@ struct ManagedUniformBufferInfo {
   int index = -1;
   size_t length = 0;
   std::vector<igl::UniformDesc> uniforms;
+  // Number of GPU buffers cycled through when the data changes between binds. Using 2 or 3 keeps
+  // the CPU from overwriting data the GPU may still be reading on backends that upload in place.
+  // Ignored when the data is bound with bindBytes or shared with the buffer (NoCopy).
+  size_t numBuffers = 1;
 };
 
 class ManagedUniformBuffer {
  public:
+  // Index of a uniform in uniformInfo.uniforms, resolved once with getUniformHandle() so per frame
+  // updates skip the name lookup
+  struct UniformHandle {
+    int index = -1;
+    [[nodiscard]] bool isValid() const {
+      return index >= 0;
+    }
+  };
+
   igl::Result result;
   ManagedUniformBufferInfo uniformInfo;
   ManagedUniformBuffer(igl::IDevice& device, const ManagedUniformBufferInfo& info);
   ~ManagedUniformBuffer();
   // This function takes a chunk of data and use it to update the value of uniform 'name'
   bool updateData(const char* name, const void* data, size_t dataSize);
+  // Same as above for a uniform resolved with getUniformHandle()
+  bool updateData(UniformHandle handle, const void* data, size_t dataSize);
+  // Returns an invalid handle if no uniform with given name exists
+  [[nodiscard]] UniformHandle getUniformHandle(const char* name) const;
   // This function returns the expected data size for uniform with given name
   // If uniform has type UniformType::Float3, this function will return
   // 3 * sizeof(float) if elementStride is zero and return elementStride otherwise
@@ -36,15 +53,43 @@ class ManagedUniformBuffer {
             igl::IRenderCommandEncoder& encoder);
   void bind(const igl::IDevice& device, igl::IComputeCommandEncoder& encoder);
 
+  // Callers may write anything through the returned pointer, so the whole buffer is uploaded on
+  // the next bind
   void* getData();
 
   void buildUnifromLUT();
 
+  // Dirty uniforms separated by at most this many clean bytes are uploaded as a single range
+  static constexpr size_t kCoalesceGap = 64;
+  // Appends to 'outRanges' the byte ranges to upload for 'dirtyUniforms', indices into 'uniforms'
+  // sorted by offset. Ranges are clamped to 'length' and merged across gaps of up to kCoalesceGap.
+  static void coalesceUniformRanges(const std::vector<igl::UniformDesc>& uniforms,
+                                    const std::vector<size_t>& dirtyUniforms,
+                                    size_t length,
+                                    std::vector<igl::BufferRange>& outRanges);
+
  private:
-  size_t getUniformDataSizeInternal(igl::UniformDesc& uniform);
+  struct BufferCopy {
+    std::shared_ptr<igl::IBuffer> buffer;
+    // One bit per uniform changed since this copy was last uploaded
+    std::vector<uint64_t> dirtyUniforms;
+    bool allDirty = true;
+  };
+
+  static size_t getUniformDataSizeInternal(const igl::UniformDesc& uniform);
+  void markDirty(size_t uniformIndex);
+  void markAllDirty();
+  igl::IBuffer& prepareBufferForBind();
   void* data_ = nullptr;
   int length_ = 0;
-  std::shared_ptr<igl::IBuffer> buffer_ = nullptr;
+  std::vector<BufferCopy> buffers_;
+  size_t currentBuffer_ = 0;
+  bool changedSinceBind_ = false;
+  // Uniform indices sorted by offset, so dirty uniforms coalesce into contiguous upload ranges
+  std::vector<size_t> uniformsByOffset_;
+  // Scratch space for prepareBufferForBind(), kept to avoid allocating on every bind
+  std::vector<size_t> dirtyScratch_;
+  std::vector<igl::BufferRange> rangesScratch_;
   std::unique_ptr<std::unordered_map<std::string, size_t>> uniformLUT_ = nullptr;
 #if IGL_PLATFORM_IOS_SIMULATOR
   /// If we're in the simulator we need to hold onto length so we can deallocate memory buffer
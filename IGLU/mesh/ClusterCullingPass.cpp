@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/mesh/ClusterCullingPass.h>
+
+#include <cstring>
+#include <string>
+
+namespace iglu::mesh {
+namespace {
+
+constexpr uint32_t kMeshletsIndex = 0;
+constexpr uint32_t kParamsIndex = 1;
+constexpr uint32_t kDrawCommandsIndex = 2;
+constexpr uint32_t kThreadgroupSize = 64;
+
+// Matches CullParams in the shaders
+struct CullParams {
+  float frustumPlanes[6][4];
+  float cameraPosition[4];
+  uint32_t meshletCount;
+  uint32_t padding[3];
+};
+
+// Same layout as VkDrawIndexedIndirectCommand, MTLDrawIndexedPrimitivesIndirectArguments and
+// OpenGL's DrawElementsIndirectCommand
+struct DrawIndexedIndirectCommand {
+  uint32_t indexCount;
+  uint32_t instanceCount;
+  uint32_t firstIndex;
+  int32_t vertexOffset;
+  uint32_t firstInstance;
+};
+
+const char* getMetalShaderSource() {
+  return R"(
+#include <metal_stdlib>
+using namespace metal;
+
+struct Meshlet {
+  float4 sphere;
+  float4 cone;
+  packed_float3 coneApex;
+  uint indexOffset;
+  uint indexCount;
+  uint padding[3];
+};
+
+struct CullParams {
+  float4 frustumPlanes[6];
+  float4 cameraPosition;
+  uint meshletCount;
+};
+
+struct DrawCommand {
+  uint indexCount;
+  uint instanceCount;
+  uint firstIndex;
+  int vertexOffset;
+  uint firstInstance;
+};
+
+kernel void cullMeshlets(device const Meshlet* meshlets [[buffer(0)]],
+                         constant CullParams& params [[buffer(1)]],
+                         device DrawCommand* commands [[buffer(2)]],
+                         uint i [[thread_position_in_grid]]) {
+  if (i >= params.meshletCount) {
+    return;
+  }
+  const Meshlet m = meshlets[i];
+  bool visible = true;
+  for (int p = 0; p < 6; ++p) {
+    const float distance = dot(params.frustumPlanes[p], float4(m.sphere.xyz, 1.0));
+    visible = visible && distance >= -m.sphere.w;
+  }
+  const float3 toApex = float3(m.coneApex) - params.cameraPosition.xyz;
+  const float apexDistance = length(toApex);
+  visible = visible && (apexDistance == 0.0 || dot(toApex, m.cone.xyz) < m.cone.w * apexDistance);
+
+  commands[i].indexCount = m.indexCount;
+  commands[i].instanceCount = visible ? 1 : 0;
+  commands[i].firstIndex = m.indexOffset;
+  commands[i].vertexOffset = 0;
+  commands[i].firstInstance = 0;
+}
+)";
+}
+
+// Vulkan binds storage buffers in descriptor set 1
+std::string getGlslShaderSource(const igl::IDevice& device) {
+  const bool isVulkan = device.getBackendType() == igl::BackendType::Vulkan;
+  std::string shader;
+  if (!isVulkan) {
+    shader += device.getShaderVersion().family == igl::ShaderFamily::GlslEs
+                  ? "#version 310 es\nprecision highp float;\n"
+                  : "#version 430\n";
+  }
+  const std::string set = isVulkan ? ", set = 1" : "";
+  shader += R"(
+layout (local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+struct Meshlet {
+  vec4 sphere;
+  vec4 cone;
+  vec3 coneApex;
+  uint indexOffset;
+  uint indexCount;
+  uint padding0;
+  uint padding1;
+  uint padding2;
+};
+
+struct DrawCommand {
+  uint indexCount;
+  uint instanceCount;
+  uint firstIndex;
+  int vertexOffset;
+  uint firstInstance;
+};
+)";
+  shader += "layout (std430, binding = 0" + set + ") readonly buffer Meshlets {\n";
+  shader += "  Meshlet meshlets[];\n};\n";
+  shader += "layout (std430, binding = 1" + set + ") readonly buffer CullParams {\n";
+  shader += "  vec4 frustumPlanes[6];\n  vec4 cameraPosition;\n  uint meshletCount;\n};\n";
+  shader += "layout (std430, binding = 2" + set + ") writeonly buffer DrawCommands {\n";
+  shader += "  DrawCommand commands[];\n};\n";
+  shader += R"(
+void main() {
+  uint i = gl_GlobalInvocationID.x;
+  if (i >= meshletCount) {
+    return;
+  }
+  Meshlet m = meshlets[i];
+  bool visible = true;
+  for (int p = 0; p < 6; ++p) {
+    visible = visible && dot(frustumPlanes[p], vec4(m.sphere.xyz, 1.0)) >= -m.sphere.w;
+  }
+  vec3 toApex = m.coneApex - cameraPosition.xyz;
+  float distance = length(toApex);
+  visible = visible && (distance == 0.0 || dot(toApex, m.cone.xyz) < m.cone.w * distance);
+
+  commands[i] = DrawCommand(m.indexCount, visible ? 1u : 0u, m.indexOffset, 0, 0u);
+}
+)";
+  return shader;
+}
+
+} // namespace
+
+ClusterCullingPass::ClusterCullingPass(igl::IDevice& device,
+                                       const MeshletMesh& mesh,
+                                       igl::Result* IGL_NULLABLE outResult) :
+  meshletCount_(static_cast<uint32_t>(mesh.meshlets.size())) {
+  if (!isSupported(device)) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::Unsupported, "Cluster culling requires compute shaders.");
+    return;
+  }
+  if (mesh.meshlets.empty()) {
+    igl::Result::setResult(outResult, igl::Result::Code::ArgumentInvalid, "Empty mesh.");
+    return;
+  }
+
+  meshletBuffer_ =
+      device.createBuffer(igl::BufferDesc(igl::BufferDesc::BufferTypeBits::Storage,
+                                          mesh.meshlets.data(),
+                                          mesh.meshlets.size() * sizeof(Meshlet),
+                                          igl::ResourceStorage::Private,
+                                          0,
+                                          "ClusterCullingPass::meshlets"),
+                          outResult);
+  if (meshletBuffer_ == nullptr) {
+    return;
+  }
+  indexBuffer_ = device.createBuffer(igl::BufferDesc(igl::BufferDesc::BufferTypeBits::Index,
+                                                     mesh.indices.data(),
+                                                     mesh.indices.size() * sizeof(uint32_t),
+                                                     igl::ResourceStorage::Private,
+                                                     0,
+                                                     "ClusterCullingPass::indices"),
+                                     outResult);
+  if (indexBuffer_ == nullptr) {
+    return;
+  }
+  indirectBuffer_ = device.createBuffer(
+      igl::BufferDesc(igl::BufferDesc::BufferTypeBits::Storage |
+                          igl::BufferDesc::BufferTypeBits::Indirect,
+                      nullptr,
+                      mesh.meshlets.size() * sizeof(DrawIndexedIndirectCommand),
+                      igl::ResourceStorage::Private,
+                      0,
+                      "ClusterCullingPass::drawCommands"),
+      outResult);
+  if (indirectBuffer_ == nullptr) {
+    return;
+  }
+  // Updated every frame; ring buffers keep frames in flight from overwriting each other's view
+  paramsBuffer_ = device.createBuffer(igl::BufferDesc(igl::BufferDesc::BufferTypeBits::Storage,
+                                                      nullptr,
+                                                      sizeof(CullParams),
+                                                      igl::ResourceStorage::Shared,
+                                                      igl::BufferDesc::BufferAPIHintBits::Ring,
+                                                      "ClusterCullingPass::params"),
+                                      outResult);
+  if (paramsBuffer_ == nullptr) {
+    return;
+  }
+
+  const bool isMetal = device.getBackendType() == igl::BackendType::Metal;
+  const std::string source = isMetal ? getMetalShaderSource() : getGlslShaderSource(device);
+  igl::ComputePipelineDesc desc;
+  desc.shaderStages = igl::ShaderStagesCreator::fromModuleStringInput(
+      device, source.c_str(), isMetal ? "cullMeshlets" : "main", "cullMeshlets", outResult);
+  if (desc.shaderStages == nullptr) {
+    return;
+  }
+  desc.buffersMap[kMeshletsIndex] = igl::genNameHandle("Meshlets");
+  desc.buffersMap[kParamsIndex] = igl::genNameHandle("CullParams");
+  desc.buffersMap[kDrawCommandsIndex] = igl::genNameHandle("DrawCommands");
+  desc.debugName = igl::genNameHandle("ClusterCullingPass");
+  pipelineState_ = device.createComputePipeline(desc, outResult);
+}
+
+bool ClusterCullingPass::isSupported(const igl::IDevice& device) {
+  return device.hasFeature(igl::DeviceFeatures::Compute) &&
+         device.hasFeature(igl::DeviceFeatures::DrawIndexedIndirect);
+}
+
+void ClusterCullingPass::cull(igl::ICommandBuffer& commandBuffer, const MeshletCullingView& view) {
+  if (!IGL_DEBUG_VERIFY(pipelineState_)) {
+    return;
+  }
+
+  CullParams params{};
+  std::memcpy(params.frustumPlanes, view.frustumPlanes, sizeof(params.frustumPlanes));
+  std::memcpy(params.cameraPosition, view.cameraPosition, sizeof(view.cameraPosition));
+  params.meshletCount = meshletCount_;
+  paramsBuffer_->upload(&params, {sizeof(params), 0});
+
+  auto encoder = commandBuffer.createComputeCommandEncoder();
+  encoder->bindComputePipelineState(pipelineState_);
+  encoder->bindBuffer(kMeshletsIndex, meshletBuffer_.get());
+  encoder->bindBuffer(kParamsIndex, paramsBuffer_.get());
+  encoder->bindBuffer(kDrawCommandsIndex, indirectBuffer_.get());
+  encoder->dispatchThreadGroups(
+      igl::Dimensions((meshletCount_ + kThreadgroupSize - 1) / kThreadgroupSize, 1, 1),
+      igl::Dimensions(kThreadgroupSize, 1, 1));
+  encoder->endEncoding();
+}
+
+void ClusterCullingPass::draw(igl::IRenderCommandEncoder& encoder) {
+  if (!IGL_DEBUG_VERIFY(pipelineState_)) {
+    return;
+  }
+  encoder.bindIndexBuffer(*indexBuffer_, igl::IndexFormat::UInt32);
+  encoder.multiDrawIndexedIndirect(
+      *indirectBuffer_, 0, meshletCount_, sizeof(DrawIndexedIndirectCommand));
+}
+
+} // namespace iglu::mesh
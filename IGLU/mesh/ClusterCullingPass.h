@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <IGLU/mesh/Meshlets.h>
+#include <igl/IGL.h>
+#include <memory>
+
+namespace iglu::mesh {
+
+/// Culls the meshlets of a mesh on the GPU and draws the survivors with a single
+/// multiDrawIndexedIndirect() call.
+///
+/// Meshlet bounds live in a storage buffer; a compute pass tests each meshlet against the view
+/// frustum and its normal cone and writes one indexed indirect draw per meshlet, with an instance
+/// count of 0 for culled ones. Pass indirectBuffer() in the Dependencies of the render encoder
+/// that calls draw() so Vulkan orders the draws after the compute pass.
+class ClusterCullingPass final {
+ public:
+  /// Requires DeviceFeatures::Compute and DeviceFeatures::DrawIndexedIndirect.
+  ClusterCullingPass(igl::IDevice& device,
+                     const MeshletMesh& mesh,
+                     igl::Result* IGL_NULLABLE outResult);
+
+  [[nodiscard]] static bool isSupported(const igl::IDevice& device);
+
+  /// Encodes the culling compute pass.
+  void cull(igl::ICommandBuffer& commandBuffer, const MeshletCullingView& view);
+
+  /// Binds the meshlet index buffer and draws the visible meshlets. The render pipeline and the
+  /// vertex buffer the meshlets index into must already be bound.
+  void draw(igl::IRenderCommandEncoder& encoder);
+
+  [[nodiscard]] igl::IBuffer& indirectBuffer() const {
+    return *indirectBuffer_;
+  }
+  [[nodiscard]] uint32_t meshletCount() const {
+    return meshletCount_;
+  }
+
+ private:
+  uint32_t meshletCount_ = 0;
+  std::shared_ptr<igl::IBuffer> meshletBuffer_;
+  std::shared_ptr<igl::IBuffer> indexBuffer_;
+  std::shared_ptr<igl::IBuffer> indirectBuffer_;
+  std::shared_ptr<igl::IBuffer> paramsBuffer_;
+  std::shared_ptr<igl::IComputePipelineState> pipelineState_;
+};
+
+} // namespace iglu::mesh
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/mesh/MeshCache.h>
+
+#include <cstring>
+
+namespace iglu::mesh {
+namespace {
+
+constexpr uint32_t kMeshCacheMagic = 0x4D4C4749; // "IGLM"
+constexpr uint64_t kSectionAlignment = 16;
+
+uint64_t alignSection(uint64_t offset) {
+  return (offset + kSectionAlignment - 1) & ~(kSectionAlignment - 1);
+}
+
+void writeSection(std::ostream& stream,
+                  uint64_t& position,
+                  uint64_t offset,
+                  const void* data,
+                  size_t size) {
+  static constexpr char kPadding[kSectionAlignment] = {};
+  stream.write(kPadding, static_cast<std::streamsize>(offset - position));
+  stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+  position = offset + size;
+}
+
+bool isSectionValid(uint64_t offset, uint64_t count, uint64_t elementSize, size_t length) {
+  return offset % kSectionAlignment == 0 && offset <= length &&
+         count <= (length - offset) / elementSize;
+}
+
+} // namespace
+
+void writeMeshCache(std::ostream& stream,
+                    const MeshView& mesh,
+                    igl::Result* IGL_NULLABLE outResult) noexcept {
+  MeshCacheHeader header;
+  header.magic = kMeshCacheMagic;
+  header.version = kMeshCacheVersion;
+  header.vertexStride = sizeof(QuantizedVertex);
+  header.numLods = static_cast<uint32_t>(mesh.numLods);
+  header.numVertices = mesh.numVertices;
+  header.numIndices = mesh.numIndices;
+  header.positionDequantization = mesh.positionDequantization;
+  header.lodsOffset = alignSection(sizeof(MeshCacheHeader));
+  header.verticesOffset = alignSection(header.lodsOffset + mesh.numLods * sizeof(MeshLod));
+  header.indicesOffset =
+      alignSection(header.verticesOffset + mesh.numVertices * sizeof(QuantizedVertex));
+
+  uint64_t position = 0;
+  writeSection(stream, position, 0, &header, sizeof(header));
+  writeSection(stream, position, header.lodsOffset, mesh.lods, mesh.numLods * sizeof(MeshLod));
+  writeSection(stream,
+               position,
+               header.verticesOffset,
+               mesh.vertices,
+               mesh.numVertices * sizeof(QuantizedVertex));
+  writeSection(
+      stream, position, header.indicesOffset, mesh.indices, mesh.numIndices * sizeof(uint32_t));
+
+  if (!stream) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::RuntimeError, "Failed to write mesh cache.");
+    return;
+  }
+  igl::Result::setOk(outResult);
+}
+
+MeshView readMeshCache(const void* IGL_NULLABLE data,
+                       size_t length,
+                       igl::Result* IGL_NULLABLE outResult) noexcept {
+  if (data == nullptr || length < sizeof(MeshCacheHeader) ||
+      reinterpret_cast<uintptr_t>(data) % alignof(uint32_t) != 0) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::ArgumentInvalid, "Mesh cache is too small or misaligned.");
+    return {};
+  }
+
+  MeshCacheHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != kMeshCacheMagic || header.version != kMeshCacheVersion ||
+      header.vertexStride != sizeof(QuantizedVertex)) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::InvalidOperation, "Mesh cache has a different version.");
+    return {};
+  }
+  if (!isSectionValid(header.lodsOffset, header.numLods, sizeof(MeshLod), length) ||
+      !isSectionValid(
+          header.verticesOffset, header.numVertices, sizeof(QuantizedVertex), length) ||
+      !isSectionValid(header.indicesOffset, header.numIndices, sizeof(uint32_t), length)) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::ArgumentOutOfRange, "Truncated mesh cache.");
+    return {};
+  }
+
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  MeshView view;
+  view.lods = reinterpret_cast<const MeshLod*>(bytes + header.lodsOffset);
+  view.numLods = header.numLods;
+  view.vertices = reinterpret_cast<const QuantizedVertex*>(bytes + header.verticesOffset);
+  view.numVertices = header.numVertices;
+  view.indices = reinterpret_cast<const uint32_t*>(bytes + header.indicesOffset);
+  view.numIndices = header.numIndices;
+  view.positionDequantization = header.positionDequantization;
+
+  for (size_t i = 0; i < view.numLods; ++i) {
+    if (view.lods[i].indexOffset > view.numIndices ||
+        view.lods[i].indexCount > view.numIndices - view.lods[i].indexOffset) {
+      igl::Result::setResult(
+          outResult, igl::Result::Code::ArgumentOutOfRange, "Mesh cache LOD is out of range.");
+      return {};
+    }
+  }
+
+  igl::Result::setOk(outResult);
+  return view;
+}
+
+} // namespace iglu::mesh
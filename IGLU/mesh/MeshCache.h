@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <IGLU/mesh/MeshOptimizer.h>
+#include <cstdint>
+#include <ostream>
+
+namespace iglu::mesh {
+
+/// Bumped whenever QuantizedVertex, MeshLod, PositionDequantization or the file layout change.
+constexpr uint32_t kMeshCacheVersion = 2;
+
+/// Mesh cache files hold a MeshCacheHeader followed by the LOD table, vertices and indices, each
+/// 16 byte aligned and stored in native byte order, so a memory mapped file is used in place.
+struct MeshCacheHeader {
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  uint32_t vertexStride = 0;
+  uint32_t numLods = 0;
+  uint64_t numVertices = 0;
+  uint64_t numIndices = 0;
+  uint64_t lodsOffset = 0;
+  uint64_t verticesOffset = 0;
+  uint64_t indicesOffset = 0;
+  PositionDequantization positionDequantization;
+};
+
+/// Writes the mesh in the mesh cache format.
+void writeMeshCache(std::ostream& stream,
+                    const MeshView& mesh,
+                    igl::Result* IGL_NULLABLE outResult) noexcept;
+
+/// Validates a mesh cache file loaded or mapped at `data`, which must be 4 byte aligned, and
+/// returns a view pointing into it. Files of another version or vertex layout are rejected so the
+/// caller can rebuild them.
+[[nodiscard]] MeshView readMeshCache(const void* IGL_NULLABLE data,
+                                     size_t length,
+                                     igl::Result* IGL_NULLABLE outResult) noexcept;
+
+} // namespace iglu::mesh
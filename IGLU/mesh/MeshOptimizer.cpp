@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/mesh/MeshOptimizer.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <meshoptimizer.h>
+
+namespace iglu::mesh {
+namespace {
+
+// Names and locations shared with ParametricVertexData
+constexpr const char* kAttrPosition = "a_position";
+constexpr int kLocationPosition = 0;
+constexpr const char* kAttrUV = "a_uv";
+constexpr int kLocationUV = 1;
+constexpr const char* kAttrNormal = "a_normal";
+constexpr int kLocationNormal = 2;
+
+// Stop generating LODs once simplification removes less than this fraction of the indices
+constexpr float kMinLodReduction = 0.05f;
+
+bool useUInt16Indices(const MeshView& mesh) {
+  return mesh.numVertices <= std::numeric_limits<uint16_t>::max();
+}
+
+// Maps the bounds of `vertices` to [0, 1] along each axis
+PositionDequantization positionBounds(const MeshVertex* vertices, size_t numVertices) {
+  PositionDequantization bounds;
+  if (numVertices == 0) {
+    return bounds;
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    float minValue = vertices[0].position[i];
+    float maxValue = minValue;
+    for (size_t v = 1; v < numVertices; ++v) {
+      minValue = std::min(minValue, vertices[v].position[i]);
+      maxValue = std::max(maxValue, vertices[v].position[i]);
+    }
+    bounds.offset[i] = minValue;
+    // Flat meshes keep a unit scale so quantizing doesn't divide by 0
+    bounds.scale[i] = maxValue > minValue ? maxValue - minValue : 1.0f;
+  }
+  return bounds;
+}
+
+QuantizedVertex quantize(const MeshVertex& v, const PositionDequantization& bounds) {
+  QuantizedVertex q;
+  for (size_t i = 0; i < 3; ++i) {
+    const float position = (v.position[i] - bounds.offset[i]) / bounds.scale[i];
+    q.position[i] = static_cast<uint16_t>(meshopt_quantizeUnorm(position, 16));
+    q.normal[i] = static_cast<int16_t>(meshopt_quantizeSnorm(v.normal[i], 16));
+  }
+  q.position[3] = std::numeric_limits<uint16_t>::max();
+  q.normal[3] = 0;
+  q.uv[0] = meshopt_quantizeHalf(v.uv[0]);
+  q.uv[1] = meshopt_quantizeHalf(v.uv[1]);
+  return q;
+}
+
+} // namespace
+
+MeshView OptimizedMesh::view() const noexcept {
+  return {vertices.data(),
+          vertices.size(),
+          indices.data(),
+          indices.size(),
+          lods.data(),
+          lods.size(),
+          positionDequantization};
+}
+
+OptimizedMesh optimizeMesh(const MeshVertex* IGL_NONNULL vertices,
+                           size_t numVertices,
+                           const uint32_t* IGL_NULLABLE indices,
+                           size_t numIndices,
+                           const MeshOptimizerOptions& options) {
+  if (indices == nullptr) {
+    numIndices = numVertices;
+  }
+  IGL_DEBUG_ASSERT(numIndices % 3 == 0, "Expected a triangle list");
+  if (numIndices < 3) {
+    return {};
+  }
+
+  // Weld identical vertices
+  std::vector<uint32_t> remap(numVertices);
+  const size_t vertexCount = meshopt_generateVertexRemap(
+      remap.data(), indices, numIndices, vertices, numVertices, sizeof(MeshVertex));
+  std::vector<MeshVertex> welded(vertexCount);
+  meshopt_remapVertexBuffer(welded.data(), vertices, numVertices, sizeof(MeshVertex), remap.data());
+  std::vector<uint32_t> lod0(numIndices);
+  meshopt_remapIndexBuffer(lod0.data(), indices, numIndices, remap.data());
+
+  const float* positions = welded.front().position;
+  constexpr size_t kPositionStride = sizeof(MeshVertex);
+
+  meshopt_optimizeVertexCache(lod0.data(), lod0.data(), lod0.size(), vertexCount);
+  if (options.overdrawThreshold > 0.0f) {
+    meshopt_optimizeOverdraw(lod0.data(),
+                             lod0.data(),
+                             lod0.size(),
+                             positions,
+                             vertexCount,
+                             kPositionStride,
+                             options.overdrawThreshold);
+  }
+
+  OptimizedMesh result;
+  result.indices = lod0;
+  result.lods.push_back({0, static_cast<uint32_t>(lod0.size()), 0.0f});
+
+  // Each LOD is simplified from the previous one, which keeps the chain consistent and cheap
+  const float errorScale = meshopt_simplifyScale(positions, vertexCount, kPositionStride);
+  std::vector<uint32_t> source = std::move(lod0);
+  std::vector<uint32_t> lod(source.size());
+  while (result.lods.size() < options.maxLods) {
+    const auto targetCount =
+        static_cast<size_t>(static_cast<float>(source.size()) * options.lodReduction) / 3 * 3;
+    if (targetCount < 3) {
+      break;
+    }
+    float lodError = 0.0f;
+    const size_t lodCount = meshopt_simplify(lod.data(),
+                                             source.data(),
+                                             source.size(),
+                                             positions,
+                                             vertexCount,
+                                             kPositionStride,
+                                             targetCount,
+                                             options.lodTargetError,
+                                             0,
+                                             &lodError);
+    const auto maxLodCount = static_cast<float>(source.size()) * (1.0f - kMinLodReduction);
+    if (lodCount == 0 || static_cast<float>(lodCount) > maxLodCount) {
+      break;
+    }
+    lod.resize(lodCount);
+    meshopt_optimizeVertexCache(lod.data(), lod.data(), lod.size(), vertexCount);
+
+    result.lods.push_back({static_cast<uint32_t>(result.indices.size()),
+                           static_cast<uint32_t>(lod.size()),
+                           lodError * errorScale});
+    result.indices.insert(result.indices.end(), lod.begin(), lod.end());
+    std::swap(source, lod);
+    lod.resize(source.size());
+  }
+
+  // Order vertices by first use across all LODs; vertices no LOD references are dropped
+  std::vector<MeshVertex> ordered(vertexCount);
+  const size_t usedCount = meshopt_optimizeVertexFetch(ordered.data(),
+                                                       result.indices.data(),
+                                                       result.indices.size(),
+                                                       welded.data(),
+                                                       vertexCount,
+                                                       sizeof(MeshVertex));
+
+  result.positionDequantization = positionBounds(ordered.data(), usedCount);
+  result.vertices.resize(usedCount);
+  std::transform(ordered.begin(),
+                 ordered.begin() + usedCount,
+                 result.vertices.begin(),
+                 [&bounds = result.positionDequantization](const MeshVertex& v) {
+                   return quantize(v, bounds);
+                 });
+  return result;
+}
+
+igl::VertexInputStateDesc quantizedVertexInputStateDesc() {
+  igl::VertexInputStateDesc inputDesc;
+  inputDesc.numAttributes = 3;
+  inputDesc.attributes[0] = igl::VertexAttribute(0,
+                                                 igl::VertexAttributeFormat::UShort4Norm,
+                                                 offsetof(QuantizedVertex, position),
+                                                 kAttrPosition,
+                                                 kLocationPosition);
+  inputDesc.attributes[1] = igl::VertexAttribute(0,
+                                                 igl::VertexAttributeFormat::HalfFloat2,
+                                                 offsetof(QuantizedVertex, uv),
+                                                 kAttrUV,
+                                                 kLocationUV);
+  inputDesc.attributes[2] = igl::VertexAttribute(0,
+                                                 igl::VertexAttributeFormat::Short4Norm,
+                                                 offsetof(QuantizedVertex, normal),
+                                                 kAttrNormal,
+                                                 kLocationNormal);
+  inputDesc.numInputBindings = 1;
+  inputDesc.inputBindings[0].stride = sizeof(QuantizedVertex);
+  return inputDesc;
+}
+
+std::shared_ptr<vertexdata::VertexData> createVertexData(igl::IDevice& device,
+                                                         const MeshView& mesh,
+                                                         size_t lod,
+                                                         igl::Result* IGL_NULLABLE outResult) {
+  if (mesh.numVertices == 0 || mesh.numIndices == 0 || lod >= mesh.numLods) {
+    igl::Result::setResult(outResult, igl::Result::Code::ArgumentInvalid, "Empty mesh or LOD.");
+    return nullptr;
+  }
+
+  auto vertexInput = device.createVertexInputState(quantizedVertexInputStateDesc(), outResult);
+  if (vertexInput == nullptr) {
+    return nullptr;
+  }
+
+  auto vertexBuffer = device.createBuffer(
+      igl::BufferDesc(igl::BufferDesc::BufferTypeBits::Vertex,
+                      mesh.vertices,
+                      mesh.numVertices * sizeof(QuantizedVertex)),
+      outResult);
+  if (vertexBuffer == nullptr) {
+    return nullptr;
+  }
+
+  std::shared_ptr<igl::IBuffer> indexBuffer;
+  igl::IndexFormat indexFormat = igl::IndexFormat::UInt32;
+  if (useUInt16Indices(mesh)) {
+    const std::vector<uint16_t> narrowed(mesh.indices, mesh.indices + mesh.numIndices);
+    indexFormat = igl::IndexFormat::UInt16;
+    indexBuffer = device.createBuffer(igl::BufferDesc(igl::BufferDesc::BufferTypeBits::Index,
+                                                      narrowed.data(),
+                                                      narrowed.size() * sizeof(uint16_t)),
+                                      outResult);
+  } else {
+    indexBuffer = device.createBuffer(igl::BufferDesc(igl::BufferDesc::BufferTypeBits::Index,
+                                                      mesh.indices,
+                                                      mesh.numIndices * sizeof(uint32_t)),
+                                      outResult);
+  }
+  if (indexBuffer == nullptr) {
+    return nullptr;
+  }
+
+  auto vertexData = std::make_shared<vertexdata::VertexData>(std::move(vertexInput),
+                                                             std::move(vertexBuffer),
+                                                             std::move(indexBuffer),
+                                                             indexFormat,
+                                                             vertexdata::PrimitiveDesc{});
+  setLod(*vertexData, mesh, lod);
+  igl::Result::setOk(outResult);
+  return vertexData;
+}
+
+void setLod(vertexdata::VertexData& vertexData, const MeshView& mesh, size_t lod) {
+  IGL_DEBUG_ASSERT(lod < mesh.numLods);
+  lod = std::min(lod, mesh.numLods - 1);
+  const size_t indexSize = useUInt16Indices(mesh) ? sizeof(uint16_t) : sizeof(uint32_t);
+  auto& primitiveDesc = vertexData.primitiveDesc();
+  primitiveDesc.offset = mesh.lods[lod].indexOffset * indexSize;
+  primitiveDesc.numEntries = mesh.lods[lod].indexCount;
+}
+
+} // namespace iglu::mesh
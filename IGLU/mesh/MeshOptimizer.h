@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <IGLU/simple_renderer/VertexData.h>
+#include <cstdint>
+#include <igl/IGL.h>
+#include <memory>
+#include <vector>
+
+namespace iglu::mesh {
+
+/// Full precision vertex accepted by optimizeMesh().
+struct MeshVertex {
+  float position[3] = {};
+  float normal[3] = {};
+  float uv[2] = {};
+};
+
+/// 20 byte vertex produced by optimizeMesh(): unorm16 positions within the mesh bounds (w = 1),
+/// snorm16 normals (w = 0) and half float UVs. Four component formats keep every attribute 4 byte
+/// aligned and avoid 3 component 16 bit formats, which many Vulkan drivers can't fetch.
+struct QuantizedVertex {
+  uint16_t position[4];
+  int16_t normal[4];
+  uint16_t uv[2];
+};
+static_assert(sizeof(QuantizedVertex) == 20);
+
+/// Maps the unorm16 positions of QuantizedVertex, fetched as [0, 1], back to mesh units:
+/// position = offset + scale * quantized. Fold it into the model matrix, i.e. multiply the model
+/// matrix by translate(offset) * scale(scale). Unlike half floats, the error is then the same
+/// anywhere in the mesh, at most 1/65535 of its extent along each axis.
+struct PositionDequantization {
+  float scale[3] = {1.0f, 1.0f, 1.0f};
+  float offset[3] = {};
+};
+
+/// A level of detail: a range of the shared index buffer, all LODs reference the same vertices.
+struct MeshLod {
+  uint32_t indexOffset = 0;
+  uint32_t indexCount = 0;
+  /// Simplification error in mesh units; 0 for the full detail LOD.
+  float error = 0.0f;
+};
+
+/// Non-owning view of an optimized mesh, either in memory or in a mapped mesh cache file.
+struct MeshView {
+  const QuantizedVertex* IGL_NULLABLE vertices = nullptr;
+  size_t numVertices = 0;
+  const uint32_t* IGL_NULLABLE indices = nullptr;
+  size_t numIndices = 0;
+  const MeshLod* IGL_NULLABLE lods = nullptr;
+  size_t numLods = 0;
+  PositionDequantization positionDequantization;
+};
+
+struct OptimizedMesh {
+  std::vector<QuantizedVertex> vertices;
+  /// Triangle lists of all LODs, from full detail to coarsest.
+  std::vector<uint32_t> indices;
+  std::vector<MeshLod> lods;
+  PositionDequantization positionDequantization;
+
+  [[nodiscard]] MeshView view() const noexcept;
+};
+
+struct MeshOptimizerOptions {
+  /// How much overdraw optimization may worsen vertex cache efficiency; 0 disables it.
+  float overdrawThreshold = 1.05f;
+  /// Maximum number of LODs, including the full detail one.
+  uint32_t maxLods = 4;
+  /// Target index count of each LOD relative to the previous one.
+  float lodReduction = 0.5f;
+  /// Largest simplification error accepted for a LOD, relative to the mesh extents.
+  float lodTargetError = 1e-2f;
+};
+
+/// Welds duplicate vertices, optimizes triangle order for the post-transform cache and overdraw,
+/// generates simplified LODs, reorders vertices for fetch locality and quantizes them. Pass
+/// nullptr indices for an unindexed triangle list.
+[[nodiscard]] OptimizedMesh optimizeMesh(const MeshVertex* IGL_NONNULL vertices,
+                                         size_t numVertices,
+                                         const uint32_t* IGL_NULLABLE indices,
+                                         size_t numIndices,
+                                         const MeshOptimizerOptions& options = {});
+
+/// Vertex layout of QuantizedVertex in buffer 0, using the attribute names and locations of
+/// ParametricVertexData: a_position (0), a_uv (1), plus a_normal (2).
+[[nodiscard]] igl::VertexInputStateDesc quantizedVertexInputStateDesc();
+
+/// Uploads the mesh and returns VertexData drawing the given LOD. Indices are narrowed to 16 bits
+/// when all vertices are addressable with them. Use setLod() to switch LODs without re-uploading.
+/// Positions are uploaded quantized; apply mesh.positionDequantization in the vertex shader.
+[[nodiscard]] std::shared_ptr<vertexdata::VertexData> createVertexData(
+    igl::IDevice& device,
+    const MeshView& mesh,
+    size_t lod,
+    igl::Result* IGL_NULLABLE outResult);
+
+/// Points VertexData created by createVertexData() at another LOD of the same mesh.
+void setLod(vertexdata::VertexData& vertexData, const MeshView& mesh, size_t lod);
+
+} // namespace iglu::mesh
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/mesh/Meshlets.h>
+
+#include <cmath>
+#include <meshoptimizer.h>
+
+namespace iglu::mesh {
+
+MeshletMesh buildMeshlets(const float* IGL_NONNULL positions,
+                          size_t positionStride,
+                          size_t numVertices,
+                          const uint32_t* IGL_NONNULL indices,
+                          size_t numIndices,
+                          size_t maxVertices,
+                          size_t maxTriangles,
+                          float coneWeight) {
+  const size_t maxMeshlets = meshopt_buildMeshletsBound(numIndices, maxVertices, maxTriangles);
+  std::vector<meshopt_Meshlet> meshlets(maxMeshlets);
+  std::vector<uint32_t> meshletVertices(maxMeshlets * maxVertices);
+  std::vector<uint8_t> meshletTriangles(maxMeshlets * maxTriangles * 3);
+  meshlets.resize(meshopt_buildMeshlets(meshlets.data(),
+                                        meshletVertices.data(),
+                                        meshletTriangles.data(),
+                                        indices,
+                                        numIndices,
+                                        positions,
+                                        numVertices,
+                                        positionStride,
+                                        maxVertices,
+                                        maxTriangles,
+                                        coneWeight));
+
+  MeshletMesh result;
+  result.meshlets.reserve(meshlets.size());
+  result.indices.reserve(numIndices);
+  for (const auto& m : meshlets) {
+    const uint32_t* vertices = meshletVertices.data() + m.vertex_offset;
+    const uint8_t* triangles = meshletTriangles.data() + m.triangle_offset;
+    const auto bounds = meshopt_computeMeshletBounds(
+        vertices, triangles, m.triangle_count, positions, numVertices, positionStride);
+
+    Meshlet meshlet{};
+    for (size_t i = 0; i < 3; ++i) {
+      meshlet.center[i] = bounds.center[i];
+      meshlet.coneAxis[i] = bounds.cone_axis[i];
+      meshlet.coneApex[i] = bounds.cone_apex[i];
+    }
+    meshlet.radius = bounds.radius;
+    meshlet.coneCutoff = bounds.cone_cutoff;
+    meshlet.indexOffset = static_cast<uint32_t>(result.indices.size());
+    meshlet.indexCount = m.triangle_count * 3;
+    for (size_t i = 0; i < meshlet.indexCount; ++i) {
+      result.indices.push_back(vertices[triangles[i]]);
+    }
+    result.meshlets.push_back(meshlet);
+  }
+  return result;
+}
+
+MeshletCullingView makeMeshletCullingView(const iglu::simdtypes::float4x4& modelViewProjection,
+                                          const iglu::simdtypes::float3& cameraPosition) {
+  const auto& m = modelViewProjection.columns;
+  const auto row = [&m](int r, int c) -> float { return m[c][r]; };
+
+  MeshletCullingView view;
+  for (int c = 0; c < 4; ++c) {
+    const float w = row(3, c);
+    view.frustumPlanes[0][c] = w + row(0, c);
+    view.frustumPlanes[1][c] = w - row(0, c);
+    view.frustumPlanes[2][c] = w + row(1, c);
+    view.frustumPlanes[3][c] = w - row(1, c);
+    view.frustumPlanes[4][c] = w + row(2, c);
+    view.frustumPlanes[5][c] = w - row(2, c);
+  }
+  for (auto& plane : view.frustumPlanes) {
+    const float length =
+        std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+    if (length > 0.0f) {
+      for (float& p : plane) {
+        p /= length;
+      }
+    }
+  }
+  for (int i = 0; i < 3; ++i) {
+    view.cameraPosition[i] = cameraPosition[i];
+  }
+  return view;
+}
+
+bool isMeshletVisible(const Meshlet& meshlet, const MeshletCullingView& view) {
+  for (const auto& plane : view.frustumPlanes) {
+    const float distance = plane[0] * meshlet.center[0] + plane[1] * meshlet.center[1] +
+                           plane[2] * meshlet.center[2] + plane[3];
+    if (distance < -meshlet.radius) {
+      return false;
+    }
+  }
+
+  // Backface cone test, see meshopt_computeMeshletBounds()
+  float distanceSquared = 0.0f;
+  float dot = 0.0f;
+  for (size_t i = 0; i < 3; ++i) {
+    const float toApex = meshlet.coneApex[i] - view.cameraPosition[i];
+    distanceSquared += toApex * toApex;
+    dot += toApex * meshlet.coneAxis[i];
+  }
+  const float distance = std::sqrt(distanceSquared);
+  return distance == 0.0f || dot < meshlet.coneCutoff * distance;
+}
+
+} // namespace iglu::mesh
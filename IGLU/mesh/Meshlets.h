@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <IGLU/simdtypes/SimdTypes.h>
+#include <cstddef>
+#include <cstdint>
+#include <igl/Null.h>
+#include <vector>
+
+namespace iglu::mesh {
+
+/// Bounds of a small cluster of triangles, laid out for std430 storage buffers and Metal device
+/// buffers alike.
+struct Meshlet {
+  float center[3];
+  float radius;
+  /// The cluster faces away from every viewer for whom
+  /// dot(normalize(coneApex - viewer), coneAxis) >= coneCutoff.
+  float coneAxis[3];
+  float coneCutoff;
+  float coneApex[3];
+  /// Range of the meshlet's triangles in MeshletMesh::indices.
+  uint32_t indexOffset;
+  uint32_t indexCount;
+  uint32_t padding[3];
+};
+static_assert(sizeof(Meshlet) == 64);
+
+struct MeshletMesh {
+  std::vector<Meshlet> meshlets;
+  /// Triangle lists of all meshlets, indexing the vertices the meshlets were built from.
+  std::vector<uint32_t> indices;
+};
+
+/// Splits an indexed triangle list into meshlets of at most `maxVertices` vertices and
+/// `maxTriangles` triangles, each with a bounding sphere and a normal cone for backface culling.
+/// Larger `coneWeight` values favor tighter cones over tighter spheres.
+[[nodiscard]] MeshletMesh buildMeshlets(const float* IGL_NONNULL positions,
+                                        size_t positionStride,
+                                        size_t numVertices,
+                                        const uint32_t* IGL_NONNULL indices,
+                                        size_t numIndices,
+                                        size_t maxVertices = 64,
+                                        size_t maxTriangles = 124,
+                                        float coneWeight = 0.25f);
+
+/// View used to cull meshlets, in the space of the mesh's vertices.
+struct MeshletCullingView {
+  /// Inward facing planes with normalized xyz: left, right, bottom, top, near, far.
+  float frustumPlanes[6][4] = {};
+  float cameraPosition[3] = {};
+};
+
+/// Extracts the frustum planes of a mesh space to clip space matrix. The near plane assumes a
+/// [-1, 1] depth range, which is conservative for [0, 1] depth.
+[[nodiscard]] MeshletCullingView makeMeshletCullingView(
+    const iglu::simdtypes::float4x4& modelViewProjection,
+    const iglu::simdtypes::float3& cameraPosition);
+
+/// CPU reference of the cluster culling compute shader; returns true if the meshlet is visible.
+[[nodiscard]] bool isMeshletVisible(const Meshlet& meshlet, const MeshletCullingView& view);
+
+} // namespace iglu::mesh
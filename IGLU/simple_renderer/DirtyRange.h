@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// @MARK:COVERAGE_EXCLUDE_FILE
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace iglu::material {
+
+/// Byte range of a CPU side buffer copy written since it was last uploaded.
+class DirtyRange {
+ public:
+  /// Marks everything up to 'size' dirty, for buffers that were never uploaded.
+  explicit DirtyRange(size_t size = 0) : end_(size) {}
+
+  [[nodiscard]] bool empty() const {
+    return begin_ == end_;
+  }
+  [[nodiscard]] size_t begin() const {
+    return begin_;
+  }
+  [[nodiscard]] size_t end() const {
+    return end_;
+  }
+
+  void add(size_t offset, size_t size) {
+    if (size == 0) {
+      return;
+    }
+    if (empty()) {
+      begin_ = offset;
+      end_ = offset + size;
+    } else {
+      begin_ = std::min(begin_, offset);
+      end_ = std::max(end_, offset + size);
+    }
+  }
+
+  /// Returns the dirty part of [offset, offset + size) and marks it clean. When that part lies
+  /// strictly inside the range, the whole range stays dirty, as the rest isn't contiguous.
+  [[nodiscard]] DirtyRange take(size_t offset, size_t size) {
+    const size_t end = offset + size;
+    DirtyRange taken;
+    if (empty() || end_ <= offset || begin_ >= end) {
+      return taken;
+    }
+    taken.begin_ = std::max(begin_, offset);
+    taken.end_ = std::min(end_, end);
+    if (begin_ >= offset && end_ <= end) {
+      begin_ = end_ = 0;
+    } else if (begin_ >= offset) {
+      begin_ = end;
+    } else if (end_ <= end) {
+      end_ = offset;
+    }
+    return taken;
+  }
+
+ private:
+  size_t begin_ = 0;
+  size_t end_ = 0;
+};
+
+} // namespace iglu::material
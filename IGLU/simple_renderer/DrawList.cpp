@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// @MARK:COVERAGE_EXCLUDE_FILE
+
+#include "DrawList.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <utility>
+
+namespace iglu::renderpass {
+
+namespace {
+
+constexpr uint64_t kTranslucentBit = 1ull << 63;
+// Largest ids that fit the sort key fields
+constexpr uint32_t kMaxStateId = 0xFFFFu;
+constexpr uint32_t kMaxVertexDataId = 0x7FFFu;
+
+// Maps a float to 16 bits that sort in the same order
+uint64_t sortableDepth(float depth) {
+  uint32_t bits = 0;
+  std::memcpy(&bits, &depth, sizeof(bits));
+  bits ^= (bits & 0x80000000u) != 0 ? 0xFFFFFFFFu : 0x80000000u;
+  return bits >> 16;
+}
+
+} // namespace
+
+void DrawList::add(drawable::Drawable& drawable,
+                   igl::IDevice& device,
+                   std::shared_ptr<igl::IRenderPipelineState> pipelineState,
+                   float depth,
+                   const void* instanceData,
+                   size_t instanceDataSize) {
+  Item item;
+  item.drawable = &drawable;
+  item.device = &device;
+  item.pipelineState = std::move(pipelineState);
+  if (instanceData && instanceDataSize) {
+    item.instanceDataOffset = _instanceData.size();
+    item.instanceDataSize = instanceDataSize;
+    const auto* bytes = static_cast<const uint8_t*>(instanceData);
+    _instanceData.insert(_instanceData.end(), bytes, bytes + instanceDataSize);
+  }
+
+  // Opaque draws: pipeline state, material, vertex data, then front to back.
+  // Translucent draws: after all opaque draws, back to front, then by state.
+  const uint64_t pipelineId = id(_pipelineIds, item.pipelineState.get(), kMaxStateId);
+  const uint64_t materialId = id(_materialIds, drawable.material().get(), kMaxStateId);
+  const uint64_t vertexDataId =
+      id(_vertexDataIds, drawable.vertexData().get(), kMaxVertexDataId);
+  const uint64_t depthBits = sortableDepth(depth);
+  if (drawable.material()->blendMode == material::BlendMode::Opaque()) {
+    item.sortKey = (pipelineId << 47) | (materialId << 31) | (vertexDataId << 16) | depthBits;
+  } else {
+    item.sortKey = kTranslucentBit | ((~depthBits & 0xFFFFu) << 47) | (pipelineId << 31) |
+                   (materialId << 15) | vertexDataId;
+  }
+
+  _items.push_back(std::move(item));
+}
+
+size_t DrawList::size() const {
+  return _items.size();
+}
+
+uint32_t DrawList::id(IdMap& ids, const void* object, uint32_t maxId) {
+  const auto it = ids.find(object);
+  if (it != ids.end()) {
+    return it->second;
+  }
+  // Objects past the field width share its last id. Draws stay correct, as binding and merging
+  // compare the objects themselves, but runs of the same state may be split.
+  IGL_SOFT_ASSERT(ids.size() <= maxId,
+                  "DrawList: more than %u distinct objects of one kind in a flush",
+                  maxId + 1);
+  const auto id = static_cast<uint32_t>(std::min<size_t>(ids.size(), maxId));
+  ids.emplace(object, id);
+  return id;
+}
+
+void DrawList::flush(igl::IRenderCommandEncoder& commandEncoder, uint32_t instanceBufferIndex) {
+  if (_items.empty()) {
+    return;
+  }
+
+  // Stable LSD radix sort on bytes, skipping bytes all keys share
+  _sortEntries.resize(_items.size());
+  for (size_t i = 0; i < _items.size(); ++i) {
+    _sortEntries[i] = {_items[i].sortKey, static_cast<uint32_t>(i)};
+  }
+  _sortScratch.resize(_sortEntries.size());
+  for (uint32_t shift = 0; shift < 64; shift += 8) {
+    std::array<size_t, 256> counts{};
+    for (const auto& entry : _sortEntries) {
+      ++counts[(entry.key >> shift) & 0xFFu];
+    }
+    if (counts[(_sortEntries.front().key >> shift) & 0xFFu] == _sortEntries.size()) {
+      continue;
+    }
+    size_t offset = 0;
+    for (auto& count : counts) {
+      const size_t bucketSize = count;
+      count = offset;
+      offset += bucketSize;
+    }
+    for (const auto& entry : _sortEntries) {
+      _sortScratch[counts[(entry.key >> shift) & 0xFFu]++] = entry;
+    }
+    _sortEntries.swap(_sortScratch);
+  }
+
+  // Group sorted draws into runs that can share one instanced draw, packing their instance data
+  // contiguously
+  struct Run {
+    size_t first = 0;
+    uint32_t count = 0;
+    size_t instanceDataOffset = 0;
+  };
+  std::vector<Run> runs;
+  std::vector<uint8_t> instanceBufferData;
+  instanceBufferData.reserve(_instanceData.size());
+  for (size_t i = 0; i < _sortEntries.size(); ++i) {
+    const auto& item = _items[_sortEntries[i].index];
+    bool canMerge = false;
+    if (i > 0 && item.instanceDataSize > 0) {
+      const auto& previous = _items[_sortEntries[i - 1].index];
+      canMerge = previous.instanceDataSize == item.instanceDataSize &&
+                 previous.pipelineState == item.pipelineState &&
+                 previous.drawable->material() == item.drawable->material() &&
+                 previous.drawable->vertexData() == item.drawable->vertexData();
+    }
+    if (canMerge) {
+      ++runs.back().count;
+    } else {
+      runs.push_back({i, 1, instanceBufferData.size()});
+    }
+    const auto instanceData = _instanceData.begin() + item.instanceDataOffset;
+    instanceBufferData.insert(
+        instanceBufferData.end(), instanceData, instanceData + item.instanceDataSize);
+  }
+
+  _instanceBuffer = nullptr;
+  if (!instanceBufferData.empty()) {
+    const igl::BufferDesc desc(igl::BufferDesc::BufferTypeBits::Vertex,
+                               instanceBufferData.data(),
+                               instanceBufferData.size(),
+                               igl::ResourceStorage::Shared);
+    _instanceBuffer = _items.front().device->createBuffer(desc, nullptr);
+  }
+
+  // Issue the runs, binding only the states that change
+  const igl::IRenderPipelineState* boundPipelineState = nullptr;
+  const material::Material* boundMaterial = nullptr;
+  const vertexdata::VertexData* boundVertexData = nullptr;
+  for (const auto& run : runs) {
+    const auto& item = _items[_sortEntries[run.first].index];
+    if (!item.pipelineState) {
+      continue;
+    }
+    const auto& material = item.drawable->material();
+    const auto& vertexData = item.drawable->vertexData();
+    if (item.pipelineState.get() != boundPipelineState) {
+      commandEncoder.bindRenderPipelineState(item.pipelineState);
+      boundPipelineState = item.pipelineState.get();
+      // Material bindings are resolved against the pipeline state
+      boundMaterial = nullptr;
+    }
+    if (material.get() != boundMaterial) {
+      material->bind(*item.device, *item.pipelineState, commandEncoder);
+      boundMaterial = material.get();
+    }
+    if (vertexData.get() != boundVertexData) {
+      vertexData->bind(commandEncoder);
+      boundVertexData = vertexData.get();
+    }
+    if (item.instanceDataSize > 0 && _instanceBuffer) {
+      commandEncoder.bindVertexBuffer(
+          instanceBufferIndex, *_instanceBuffer, run.instanceDataOffset);
+    }
+    vertexData->drawInstances(commandEncoder, run.count);
+  }
+
+  _items.clear();
+  _instanceData.clear();
+  _pipelineIds.clear();
+  _materialIds.clear();
+  _vertexDataIds.clear();
+}
+
+} // namespace iglu::renderpass
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// @MARK:COVERAGE_EXCLUDE_FILE
+
+#pragma once
+
+#include <IGLU/simple_renderer/Drawable.h>
+#include <igl/IGL.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace iglu::renderpass {
+
+/// Records draws and issues them sorted by render pipeline state, material, vertex data and
+/// depth, so each state is bound once per run of draws. Drawables with translucent materials are
+/// issued last, back to front. Sorted draws sharing vertex data and material that carry instance
+/// data of the same size are merged into one instanced draw, reading their instance data from a
+/// transient vertex buffer.
+///
+/// Drawables and their materials must stay alive and unchanged until flush().
+class DrawList final {
+ public:
+  /// Records a draw of 'drawable' with 'pipelineState', the state the drawable resolved for the
+  /// target. 'depth' is the drawable's distance from the camera and 'instanceData' holds
+  /// 'instanceDataSize' bytes of per-instance vertex attributes.
+  void add(drawable::Drawable& drawable,
+           igl::IDevice& device,
+           std::shared_ptr<igl::IRenderPipelineState> pipelineState,
+           float depth = 0.0f,
+           const void* instanceData = nullptr,
+           size_t instanceDataSize = 0);
+
+  /// Issues all recorded draws on 'commandEncoder' and clears the list. Instance data is bound as
+  /// a vertex buffer at 'instanceBufferIndex'.
+  void flush(igl::IRenderCommandEncoder& commandEncoder, uint32_t instanceBufferIndex = 1);
+
+  [[nodiscard]] size_t size() const;
+
+ private:
+  struct Item {
+    drawable::Drawable* drawable = nullptr;
+    igl::IDevice* device = nullptr;
+    std::shared_ptr<igl::IRenderPipelineState> pipelineState;
+    uint64_t sortKey = 0;
+    size_t instanceDataOffset = 0;
+    size_t instanceDataSize = 0;
+  };
+
+  struct SortEntry {
+    uint64_t key = 0;
+    uint32_t index = 0;
+  };
+
+  using IdMap = std::unordered_map<const void*, uint32_t>;
+
+  static uint32_t id(IdMap& ids, const void* object, uint32_t maxId);
+
+  std::vector<Item> _items;
+  std::vector<uint8_t> _instanceData;
+  // Dense per flush ids of pipeline states, materials and vertex data, in order of first use
+  IdMap _pipelineIds;
+  IdMap _materialIds;
+  IdMap _vertexDataIds;
+  std::vector<SortEntry> _sortEntries;
+  std::vector<SortEntry> _sortScratch;
+  // Recreated on every flush, as the GPU may still be reading the previous instances, and kept
+  // alive until then
+  std::shared_ptr<igl::IBuffer> _instanceBuffer;
+};
+
+} // namespace iglu::renderpass
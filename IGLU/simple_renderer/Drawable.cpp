@@ -22,16 +22,23 @@ void Drawable::draw(igl::IDevice& device,
                     const igl::RenderPipelineDesc& pipelineDesc,
                     size_t pushConstantsDataSize,
                     const void* pushConstantsData) {
-  // Assumption: _vertexData and _material are immutable
-  const size_t pipelineDescHash = std::hash<igl::RenderPipelineDesc>()(pipelineDesc);
-  if (!_pipelineState || pipelineDescHash != _lastPipelineDescHash) {
-    igl::RenderPipelineDesc mutablePipelineDesc = pipelineDesc;
-    _vertexData->populatePipelineDescriptor(mutablePipelineDesc);
-    _material->populatePipelineDescriptor(mutablePipelineDesc);
+  draw(device,
+       commandEncoder,
+       pipelineDesc,
+       std::hash<igl::RenderPipelineDesc>()(pipelineDesc),
+       nullptr,
+       pushConstantsDataSize,
+       pushConstantsData);
+}
 
-    _pipelineState = device.createRenderPipeline(mutablePipelineDesc, nullptr);
-    _lastPipelineDescHash = pipelineDescHash;
-  }
+void Drawable::draw(igl::IDevice& device,
+                    igl::IRenderCommandEncoder& commandEncoder,
+                    const igl::RenderPipelineDesc& pipelineDesc,
+                    size_t pipelineDescKey,
+                    PipelineCache* pipelineCache,
+                    size_t pushConstantsDataSize,
+                    const void* pushConstantsData) {
+  pipelineState(device, pipelineDesc, pipelineDescKey, pipelineCache);
 
   commandEncoder.bindRenderPipelineState(_pipelineState);
 
@@ -44,4 +51,37 @@ void Drawable::draw(igl::IDevice& device,
   _vertexData->draw(commandEncoder);
 }
 
+const std::shared_ptr<igl::IRenderPipelineState>& Drawable::pipelineState(
+    igl::IDevice& device,
+    const igl::RenderPipelineDesc& pipelineDesc) {
+  return pipelineState(
+      device, pipelineDesc, std::hash<igl::RenderPipelineDesc>()(pipelineDesc), nullptr);
+}
+
+const std::shared_ptr<igl::IRenderPipelineState>& Drawable::pipelineState(
+    igl::IDevice& device,
+    const igl::RenderPipelineDesc& pipelineDesc,
+    size_t pipelineDescKey,
+    PipelineCache* pipelineCache) {
+  // Assumption: _vertexData and _material are immutable
+  if (!_pipelineState || pipelineDescKey != _lastPipelineDescKey) {
+    igl::RenderPipelineDesc mutablePipelineDesc = pipelineDesc;
+    _vertexData->populatePipelineDescriptor(mutablePipelineDesc);
+    _material->populatePipelineDescriptor(mutablePipelineDesc);
+
+    _pipelineState = pipelineCache ? pipelineCache->getOrCreate(device, mutablePipelineDesc)
+                                   : device.createRenderPipeline(mutablePipelineDesc, nullptr);
+    _lastPipelineDescKey = pipelineDescKey;
+  }
+  return _pipelineState;
+}
+
+const std::shared_ptr<vertexdata::VertexData>& Drawable::vertexData() const {
+  return _vertexData;
+}
+
+const std::shared_ptr<material::Material>& Drawable::material() const {
+  return _material;
+}
+
 } // namespace iglu::drawable
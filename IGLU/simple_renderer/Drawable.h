@@ -10,6 +10,7 @@
 #pragma once
 
 #include <IGLU/simple_renderer/Material.h>
+#include <IGLU/simple_renderer/PipelineCache.h>
 #include <IGLU/simple_renderer/VertexData.h>
 #include <memory>
 
@@ -29,6 +30,33 @@ class Drawable final {
             size_t pushConstantsDataSize = 0,
             const void* pushConstantsData = nullptr);
 
+  /// Same as above, but 'pipelineDescKey' identifies 'pipelineDesc' so it isn't hashed on every
+  /// draw: callers compute it once, e.g. with std::hash, whenever the descriptor changes. New
+  /// pipeline states are resolved through 'pipelineCache' when provided.
+  void draw(igl::IDevice& device,
+            igl::IRenderCommandEncoder& commandEncoder,
+            const igl::RenderPipelineDesc& pipelineDesc,
+            size_t pipelineDescKey,
+            PipelineCache* pipelineCache,
+            size_t pushConstantsDataSize = 0,
+            const void* pushConstantsData = nullptr);
+
+  /// Returns the render pipeline state for 'pipelineDesc', creating it on first use or when
+  /// the descriptor changes. draw() binds the same state.
+  const std::shared_ptr<igl::IRenderPipelineState>& pipelineState(
+      igl::IDevice& device,
+      const igl::RenderPipelineDesc& pipelineDesc);
+
+  /// Same as above, with a precomputed 'pipelineDescKey' and an optional shared 'pipelineCache'.
+  const std::shared_ptr<igl::IRenderPipelineState>& pipelineState(
+      igl::IDevice& device,
+      const igl::RenderPipelineDesc& pipelineDesc,
+      size_t pipelineDescKey,
+      PipelineCache* pipelineCache = nullptr);
+
+  [[nodiscard]] const std::shared_ptr<vertexdata::VertexData>& vertexData() const;
+  [[nodiscard]] const std::shared_ptr<material::Material>& material() const;
+
   /// A Drawable is "immutable" in that there's no API to modify its inputs after
   /// creation. They're lightweight objects and should be recreated instead of updated.
   Drawable(std::shared_ptr<vertexdata::VertexData> vertexData,
@@ -40,7 +68,7 @@ class Drawable final {
   std::shared_ptr<material::Material> _material;
 
   std::shared_ptr<igl::IRenderPipelineState> _pipelineState;
-  size_t _lastPipelineDescHash = 0;
+  size_t _lastPipelineDescKey = 0;
 };
 
 } // namespace iglu::drawable
@@ -13,7 +13,8 @@
 
 namespace iglu::renderpass {
 
-ForwardRenderPass::ForwardRenderPass(igl::IDevice& device) {
+ForwardRenderPass::ForwardRenderPass(igl::IDevice& device) :
+  _pipelineCache(std::make_shared<drawable::PipelineCache>()) {
   const igl::CommandQueueDesc desc{};
   _commandQueue = device.createCommandQueue(desc, nullptr);
   _backendType = device.getBackendType();
@@ -34,6 +35,7 @@ void ForwardRenderPass::begin(std::shared_ptr<igl::IFramebuffer> target,
   auto stencilAttachment = _framebuffer->getStencilAttachment();
   _renderPipelineDesc.targetDesc.stencilAttachmentFormat =
       stencilAttachment ? stencilAttachment->getFormat() : igl::TextureFormat::Invalid;
+  _renderPipelineDescKey = std::hash<igl::RenderPipelineDesc>()(_renderPipelineDesc);
 
   igl::RenderPassDesc defaultRenderPassDesc;
   defaultRenderPassDesc.colorAttachments.resize(1);
@@ -50,14 +52,47 @@ void ForwardRenderPass::begin(std::shared_ptr<igl::IFramebuffer> target,
       _commandBuffer->createRenderCommandEncoder(*finalDesc, _framebuffer, {}, nullptr);
 }
 
-void ForwardRenderPass::draw(drawable::Drawable& drawable, igl::IDevice& device) const {
+void ForwardRenderPass::draw(drawable::Drawable& drawable,
+                             igl::IDevice& device,
+                             float depth,
+                             const void* instanceData,
+                             size_t instanceDataSize) {
   IGL_DEBUG_ASSERT(isActive(), "Drawing not in progress");
-  drawable.draw(device, *_commandEncoder, _renderPipelineDesc);
+  if (!_drawListEnabled) {
+    drawable.draw(device,
+                  *_commandEncoder,
+                  _renderPipelineDesc,
+                  _renderPipelineDescKey,
+                  _pipelineCache.get());
+    return;
+  }
+
+  _drawList.add(drawable,
+                device,
+                drawable.pipelineState(
+                    device, _renderPipelineDesc, _renderPipelineDescKey, _pipelineCache.get()),
+                depth,
+                instanceData,
+                instanceDataSize);
+}
+
+void ForwardRenderPass::setDrawListEnabled(bool enabled, uint32_t instanceBufferIndex) {
+  IGL_DEBUG_ASSERT(!isActive(), "Drawing already in progress");
+  _drawListEnabled = enabled;
+  _instanceBufferIndex = instanceBufferIndex;
+}
+
+void ForwardRenderPass::setPipelineCache(std::shared_ptr<drawable::PipelineCache> pipelineCache) {
+  IGL_DEBUG_ASSERT(!isActive(), "Drawing already in progress");
+  IGL_DEBUG_ASSERT(pipelineCache != nullptr);
+  _pipelineCache = std::move(pipelineCache);
 }
 
 void ForwardRenderPass::end(bool shouldPresent) {
   IGL_DEBUG_ASSERT(isActive(), "Drawing not in progress");
 
+  _drawList.flush(*_commandEncoder, _instanceBufferIndex);
+
   _commandEncoder->endEncoding();
 
   if (shouldPresent) {
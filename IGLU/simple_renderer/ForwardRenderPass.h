@@ -9,11 +9,11 @@
 
 #pragma once
 
+#include <IGLU/simple_renderer/DrawList.h>
 #include <IGLU/simple_renderer/Drawable.h>
 #include <igl/IGL.h>
 #include <memory>
 #include <string>
-#include <vector>
 
 namespace iglu::renderpass {
 
@@ -28,14 +28,33 @@ class ForwardRenderPass final {
   void begin(std::shared_ptr<igl::IFramebuffer> target,
              const igl::RenderPassDesc* renderPassDescOverride = nullptr);
 
-  /// Call once per drawable.
-  void draw(drawable::Drawable& drawable, igl::IDevice& device) const;
+  /// Call once per drawable. 'depth' is the drawable's distance from the camera and
+  /// 'instanceData' holds 'instanceDataSize' bytes of per-instance vertex attributes; both are
+  /// only used in draw list mode. Not const, as draw list mode records the draw in the pass.
+  void draw(drawable::Drawable& drawable,
+            igl::IDevice& device,
+            float depth = 0.0f,
+            const void* instanceData = nullptr,
+            size_t instanceDataSize = 0);
 
   /// Call after all drawing within this render pass is finished. The 'present'
   /// parameter controls whether to present the target framebuffer and must be set
   /// to true exactly once per frame, when targeting the "onscreen" framebuffer.
   void end(bool present = false);
 
+  /// Optional, call outside of begin() and end(). In draw list mode, draw() only records
+  /// drawables in a DrawList and end() issues them sorted by state and depth, merging draws with
+  /// instance data into instanced draws that read it from a vertex buffer bound at
+  /// 'instanceBufferIndex'.
+  ///
+  /// Drawables and their materials must stay alive and unchanged until end().
+  void setDrawListEnabled(bool enabled, uint32_t instanceBufferIndex = 1);
+
+  /// Optional, call outside of begin() and end(). Render pipeline states are resolved through
+  /// 'pipelineCache', which may be shared with other render passes so drawables with identical
+  /// materials share one state object. Each render pass creates its own cache by default.
+  void setPipelineCache(std::shared_ptr<drawable::PipelineCache> pipelineCache);
+
   /// Optional. By default, a viewport matching the size of the target framebuffer
   /// will be used.
   ///
@@ -56,9 +75,16 @@ class ForwardRenderPass final {
   std::shared_ptr<igl::ICommandQueue> _commandQueue;
   std::shared_ptr<igl::IFramebuffer> _framebuffer;
   igl::RenderPipelineDesc _renderPipelineDesc;
+  // Identifies _renderPipelineDesc, computed once per begin() rather than once per draw
+  size_t _renderPipelineDescKey = 0;
+  std::shared_ptr<drawable::PipelineCache> _pipelineCache;
 
   std::shared_ptr<igl::ICommandBuffer> _commandBuffer;
   std::unique_ptr<igl::IRenderCommandEncoder> _commandEncoder;
+
+  bool _drawListEnabled = false;
+  uint32_t _instanceBufferIndex = 1;
+  DrawList _drawList;
 };
 
 } // namespace iglu::renderpass
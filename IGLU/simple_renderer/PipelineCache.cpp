@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// @MARK:COVERAGE_EXCLUDE_FILE
+
+#include "PipelineCache.h"
+
+#include <iterator>
+#include <utility>
+
+namespace iglu::drawable {
+
+std::shared_ptr<igl::IRenderPipelineState> PipelineCache::getOrCreate(
+    igl::IDevice& device,
+    const igl::RenderPipelineDesc& desc,
+    igl::Result* outResult) {
+  {
+    const std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _pipelineStates.find(desc);
+    if (it != _pipelineStates.end()) {
+      igl::Result::setOk(outResult);
+      return it->second;
+    }
+  }
+
+  // Compiling a pipeline can take a while, so other threads aren't blocked meanwhile. If two
+  // threads race on the same descriptor, the first state inserted wins.
+  auto pipelineState = device.createRenderPipeline(desc, outResult);
+  if (!pipelineState) {
+    return nullptr;
+  }
+
+  const std::lock_guard<std::mutex> lock(_mutex);
+  return _pipelineStates.try_emplace(desc, std::move(pipelineState)).first->second;
+}
+
+size_t PipelineCache::releaseUnused() {
+  const std::lock_guard<std::mutex> lock(_mutex);
+  const size_t oldSize = _pipelineStates.size();
+  for (auto it = _pipelineStates.begin(); it != _pipelineStates.end();) {
+    // States are only handed out under the lock, so the count can't grow meanwhile
+    it = it->second.use_count() == 1 ? _pipelineStates.erase(it) : std::next(it);
+  }
+  return oldSize - _pipelineStates.size();
+}
+
+void PipelineCache::clear() {
+  const std::lock_guard<std::mutex> lock(_mutex);
+  _pipelineStates.clear();
+}
+
+size_t PipelineCache::size() const {
+  const std::lock_guard<std::mutex> lock(_mutex);
+  return _pipelineStates.size();
+}
+
+} // namespace iglu::drawable
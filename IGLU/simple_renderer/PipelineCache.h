@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// @MARK:COVERAGE_EXCLUDE_FILE
+
+#pragma once
+
+#include <igl/IGL.h>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace iglu::drawable {
+
+/// Render pipeline states shared by drawables, keyed by their fully populated descriptors, so
+/// drawables with identical vertex layouts and materials targeting compatible framebuffers share
+/// one state object. Safe to use from multiple threads.
+///
+/// The cache holds a reference to every state it creates, so it grows with the number of distinct
+/// descriptors until releaseUnused() or clear() is called. Applications that keep creating
+/// materials or render targets should call releaseUnused() periodically, e.g. on scene changes.
+class PipelineCache final {
+ public:
+  /// Returns the cached render pipeline state for 'desc', creating it on first use.
+  std::shared_ptr<igl::IRenderPipelineState> getOrCreate(igl::IDevice& device,
+                                                         const igl::RenderPipelineDesc& desc,
+                                                         igl::Result* outResult = nullptr);
+
+  /// Drops the cached states no one else references anymore, such as those of destroyed
+  /// drawables, and returns how many were dropped.
+  size_t releaseUnused();
+
+  /// Drops all cached states. States still referenced by drawables stay alive.
+  void clear();
+
+  [[nodiscard]] size_t size() const;
+
+ private:
+  mutable std::mutex _mutex;
+  std::unordered_map<igl::RenderPipelineDesc, std::shared_ptr<igl::IRenderPipelineState>>
+      _pipelineStates;
+};
+
+} // namespace iglu::drawable
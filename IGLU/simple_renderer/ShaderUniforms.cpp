@@ -20,6 +20,7 @@
 #include <secure_lib/secure_string.h>
 #endif
 
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 #include <string>
@@ -90,6 +91,7 @@ ShaderUniforms::ShaderUniforms(igl::IDevice& device,
     }
 
     std::shared_ptr<igl::IBuffer> buffer = nullptr;
+    bool isRingBuffer = false;
     if (createBuffer) {
       igl::BufferDesc desc;
       desc.length = bufferAllocationLength;
@@ -100,6 +102,7 @@ ShaderUniforms::ShaderUniforms(igl::IDevice& device,
       if (device_.getBackendType() == igl::BackendType::Metal ||
           device_.getBackendType() == igl::BackendType::Vulkan) {
         desc.hint |= igl::BufferDesc::BufferAPIHintBits::Ring;
+        isRingBuffer = true;
       }
       buffer = device.createBuffer(desc, nullptr);
     } else {
@@ -113,6 +116,7 @@ ShaderUniforms::ShaderUniforms(igl::IDevice& device,
       continue;
     }
     auto allocation = std::make_shared<BufferAllocation>(data, bufferAllocationLength, buffer);
+    allocation->isRingBuffer = isRingBuffer;
     _allocations.push_back(allocation);
 
     std::shared_ptr<BufferDesc> bufferDesc = std::make_shared<BufferDesc>();
@@ -244,23 +248,137 @@ void ShaderUniforms::setUniformBytes(const UniformDesc& uniformDesc,
     return;
   }
 
-  uintptr_t subAllocatedOffset = 0;
-  if (strongBuffer->isSuballocated && strongBuffer->currentAllocation >= 0) {
-    subAllocatedOffset = strongBuffer->currentAllocation * strongBuffer->suballocationsSize;
+  writeUniformBytes(*strongBuffer,
+                    uniformDesc.iglMemberDesc.offset + elementSize * arrayIndex,
+                    data,
+                    elementSize * count);
+}
+
+void ShaderUniforms::writeUniformBytes(BufferDesc& buffer,
+                                       size_t offset,
+                                       const void* data,
+                                       size_t size) {
+  if (buffer.isSuballocated && buffer.currentAllocation >= 0) {
+    offset += buffer.currentAllocation * buffer.suballocationsSize;
+  }
+
+  auto& allocation = *buffer.allocation;
+  auto err = offset > allocation.size ? -1 : 0;
+  if (err == 0) {
+    err = try_checked_memcpy((uint8_t*)allocation.ptr + offset, // destination
+                             allocation.size - offset, // max destination size
+                             data, // source
+                             size // num bytes to copy
+    );
   }
-  const uintptr_t offset =
-      uniformDesc.iglMemberDesc.offset + elementSize * arrayIndex + subAllocatedOffset;
-
-  auto err = try_checked_memcpy((uint8_t*)strongBuffer->allocation->ptr + offset, // destination
-                                strongBuffer->allocation->size - offset, // max destination size
-                                data, // source
-                                elementSize * count // num bytes to copy
-  );
   if (err != 0) {
     IGL_LOG_ERROR_ONCE("[IGL][Error] Failed to update uniform buffer\n");
+    return;
+  }
+
+  allocation.dirty.add(offset, size);
+}
+
+void ShaderUniforms::setUniformBytes(const UniformHandle& handle,
+                                     const void* data,
+                                     size_t elementSize,
+                                     size_t count,
+                                     size_t arrayIndex) {
+  if (!handle.isValid()) {
+    IGL_LOG_ERROR_ONCE("[IGL][Error] Invalid uniform handle\n");
+    return;
+  }
+  IGL_DEBUG_ASSERT(handle.first_ + handle.count_ <= _uniformTargets.size());
+
+  for (uint32_t i = handle.first_; i != handle.first_ + handle.count_; ++i) {
+    const UniformTarget& target = _uniformTargets[i];
+    if (arrayIndex + count > target.arrayLength) {
+      IGL_LOG_ERROR_ONCE("[IGL][Error] Invalid range for uniform handle: %zu,%zu,%zu\n",
+                         arrayIndex,
+                         count,
+                         target.arrayLength);
+      continue;
+    }
+    writeUniformBytes(
+        *target.buffer, target.offset + elementSize * arrayIndex, data, elementSize * count);
   }
 }
 
+ShaderUniforms::UniformHandle ShaderUniforms::makeUniformHandle(
+    const igl::NameHandle& key,
+    const std::vector<const UniformDesc*>& uniforms) {
+  auto it = _uniformHandles.find(key);
+  if (it != _uniformHandles.end()) {
+    return it->second;
+  }
+
+  UniformHandle handle;
+  handle.first_ = static_cast<uint32_t>(_uniformTargets.size());
+  for (const UniformDesc* uniform : uniforms) {
+    auto strongBuffer = uniform->buffer.lock();
+    if (!strongBuffer) {
+      continue;
+    }
+    // Buffer descs live as long as this object, so handles can keep raw pointers to them
+    _uniformTargets.push_back(
+        {strongBuffer.get(), uniform->iglMemberDesc.offset, uniform->iglMemberDesc.arrayLength});
+    ++handle.count_;
+  }
+  if (handle.isValid()) {
+    _uniformHandles.emplace(key, handle);
+  }
+  return handle;
+}
+
+ShaderUniforms::UniformHandle ShaderUniforms::getUniformHandle(
+    const igl::NameHandle& uniformName) {
+  std::vector<const UniformDesc*> uniforms;
+  auto range = _allUniformsByName.equal_range(uniformName);
+  for (auto it = range.first; it != range.second; ++it) {
+    uniforms.push_back(&it->second);
+  }
+  if (uniforms.empty()) {
+    IGL_LOG_ERROR_ONCE("[IGL][Error] Invalid uniform name: %s\n", uniformName.c_str());
+    return {};
+  }
+  return makeUniformHandle(uniformName, uniforms);
+}
+
+ShaderUniforms::UniformHandle ShaderUniforms::getUniformHandle(
+    const igl::NameHandle& blockTypeName,
+    const igl::NameHandle& blockInstanceName,
+    const igl::NameHandle& memberName) {
+  // Resolves the same buffers and members as setUniformBytes() does for block members
+  std::vector<const UniformDesc*> uniforms;
+  auto possibleBufferNames =
+      getPossibleBufferAndMemberNames(blockTypeName, blockInstanceName, memberName);
+  for (auto& [bufferName, bufferMemberName] : possibleBufferNames) {
+    auto range = _bufferDescs.equal_range(bufferName);
+    if (range.first == range.second) {
+      continue;
+    }
+    for (auto bufferDescIt = range.first; bufferDescIt != range.second; ++bufferDescIt) {
+      auto& bufferDesc = bufferDescIt->second;
+      auto memberIndexIt = bufferDesc->memberIndices.find(bufferMemberName);
+      if (memberIndexIt != bufferDesc->memberIndices.end()) {
+        uniforms.push_back(&bufferDesc->uniforms[memberIndexIt->second]);
+      }
+    }
+    break;
+  }
+  if (uniforms.empty()) {
+    IGL_LOG_ERROR_ONCE("[IGL][Error] Invalid uniform: %s.%s\n",
+                       blockTypeName.c_str(),
+                       memberName.c_str());
+    return {};
+  }
+  // ':' can't appear in uniform names, so keys of block members never collide with them
+  return makeUniformHandle(igl::genNameHandle(blockTypeName.toString() + ":" +
+                                              blockInstanceName.toString() + "." +
+                                              memberName.toString()),
+                           uniforms);
+}
+
 void ShaderUniforms::setUniformBytes(const igl::NameHandle& blockTypeName,
                                      const igl::NameHandle& blockInstanceName,
                                      const igl::NameHandle& memberName,
@@ -776,6 +894,101 @@ void ShaderUniforms::setIntArray(const igl::NameHandle& blockTypeName,
                   arrayIndex);
 }
 
+void ShaderUniforms::setBool(const UniformHandle& handle, const bool& value, size_t arrayIndex) {
+  setUniformBytes(handle, &value, sizeof(bool), 1, arrayIndex);
+}
+
+void ShaderUniforms::setBoolArray(const UniformHandle& handle,
+                                  const bool* value,
+                                  size_t count,
+                                  size_t arrayIndex) {
+  setUniformBytes(handle, value, sizeof(bool), count, arrayIndex);
+}
+
+void ShaderUniforms::setFloat(const UniformHandle& handle,
+                              const iglu::simdtypes::float1& value,
+                              size_t arrayIndex) {
+  setUniformBytes(handle, &value, sizeof(iglu::simdtypes::float1), 1, arrayIndex);
+}
+
+void ShaderUniforms::setFloatArray(const UniformHandle& handle,
+                                   const iglu::simdtypes::float1* value,
+                                   size_t count,
+                                   size_t arrayIndex) {
+  setUniformBytes(handle, value, sizeof(iglu::simdtypes::float1), count, arrayIndex);
+}
+
+void ShaderUniforms::setFloat2(const UniformHandle& handle,
+                               const iglu::simdtypes::float2& value,
+                               size_t arrayIndex) {
+  setUniformBytes(handle, &value, sizeof(iglu::simdtypes::float2), 1, arrayIndex);
+}
+
+void ShaderUniforms::setFloat2Array(const UniformHandle& handle,
+                                    const iglu::simdtypes::float2* value,
+                                    size_t count,
+                                    size_t arrayIndex) {
+  setUniformBytes(handle, value, sizeof(iglu::simdtypes::float2), count, arrayIndex);
+}
+
+void ShaderUniforms::setFloat4(const UniformHandle& handle,
+                               const iglu::simdtypes::float4& value,
+                               size_t arrayIndex) {
+  setUniformBytes(handle, &value, sizeof(iglu::simdtypes::float4), 1, arrayIndex);
+}
+
+void ShaderUniforms::setFloat4Array(const UniformHandle& handle,
+                                    const iglu::simdtypes::float4* value,
+                                    size_t count,
+                                    size_t arrayIndex) {
+  setUniformBytes(handle, value, sizeof(iglu::simdtypes::float4), count, arrayIndex);
+}
+
+void ShaderUniforms::setFloat2x2(const UniformHandle& handle,
+                                 const iglu::simdtypes::float2x2& value,
+                                 size_t arrayIndex) {
+  setUniformBytes(handle, &value, sizeof(iglu::simdtypes::float2x2), 1, arrayIndex);
+}
+
+void ShaderUniforms::setFloat2x2Array(const UniformHandle& handle,
+                                      const iglu::simdtypes::float2x2* value,
+                                      size_t count,
+                                      size_t arrayIndex) {
+  setUniformBytes(handle, value, sizeof(iglu::simdtypes::float2x2), count, arrayIndex);
+}
+
+void ShaderUniforms::setFloat4x4(const UniformHandle& handle,
+                                 const iglu::simdtypes::float4x4& value,
+                                 size_t arrayIndex) {
+  setUniformBytes(handle, &value, sizeof(iglu::simdtypes::float4x4), 1, arrayIndex);
+}
+
+void ShaderUniforms::setFloat4x4Array(const UniformHandle& handle,
+                                      const iglu::simdtypes::float4x4* value,
+                                      size_t count,
+                                      size_t arrayIndex) {
+  setUniformBytes(handle, value, sizeof(iglu::simdtypes::float4x4), count, arrayIndex);
+}
+
+void ShaderUniforms::setInt(const UniformHandle& handle,
+                            const iglu::simdtypes::int1& value,
+                            size_t arrayIndex) {
+  setUniformBytes(handle, &value, sizeof(iglu::simdtypes::int1), 1, arrayIndex);
+}
+
+void ShaderUniforms::setIntArray(const UniformHandle& handle,
+                                 const iglu::simdtypes::int1* value,
+                                 size_t count,
+                                 size_t arrayIndex) {
+  setUniformBytes(handle, value, sizeof(iglu::simdtypes::int1), count, arrayIndex);
+}
+
+void ShaderUniforms::setInt2(const UniformHandle& handle,
+                             const iglu::simdtypes::int2& value,
+                             size_t arrayIndex) {
+  setUniformBytes(handle, &value, sizeof(iglu::simdtypes::int2), 1, arrayIndex);
+}
+
 void ShaderUniforms::setTexture(const std::string& name,
                                 const std::shared_ptr<igl::ITexture>& value,
                                 const std::shared_ptr<igl::ISamplerState>& sampler,
@@ -840,6 +1053,17 @@ void ShaderUniforms::bindUniformOpenGL(const igl::NameHandle& uniformName,
 }
 #endif
 
+void ShaderUniforms::uploadBuffer(BufferAllocation& allocation, size_t offset, size_t size) {
+  // Bytes written to other suballocations stay dirty until those are bound
+  const DirtyRange dirty = allocation.dirty.take(offset, size);
+  if (allocation.isRingBuffer) {
+    allocation.iglBuffer->upload((uint8_t*)allocation.ptr + offset, igl::BufferRange(size, offset));
+  } else if (!dirty.empty()) {
+    allocation.iglBuffer->upload((uint8_t*)allocation.ptr + dirty.begin(),
+                                 igl::BufferRange(dirty.end() - dirty.begin(), dirty.begin()));
+  }
+}
+
 void ShaderUniforms::bindBuffer(igl::IDevice& device,
                                 const igl::IRenderPipelineState& pipelineState,
                                 igl::IRenderCommandEncoder& encoder,
@@ -852,8 +1076,7 @@ void ShaderUniforms::bindBuffer(igl::IDevice& device,
     const auto& uniformName = buffer->iglBufferDesc.name;
     if (buffer->iglBufferDesc.isUniformBlock) {
       IGL_DEBUG_ASSERT(buffer->allocation->iglBuffer != nullptr);
-      buffer->allocation->iglBuffer->upload(buffer->allocation->ptr,
-                                            igl::BufferRange(buffer->allocation->size, 0));
+      uploadBuffer(*buffer->allocation, 0, buffer->allocation->size);
       const auto& glPipelineState =
           static_cast<const igl::opengl::RenderPipelineState&>(pipelineState);
       encoder.bindBuffer(glPipelineState.getUniformBlockBindingPoint(uniformName),
@@ -877,8 +1100,7 @@ void ShaderUniforms::bindBuffer(igl::IDevice& device,
         uploadSize = buffer->suballocationsSize;
       }
 
-      buffer->allocation->iglBuffer->upload((uint8_t*)buffer->allocation->ptr + subAllocatedOffset,
-                                            igl::BufferRange(uploadSize, subAllocatedOffset));
+      uploadBuffer(*buffer->allocation, subAllocatedOffset, uploadSize);
       encoder.bindBuffer(buffer->iglBufferDesc.bufferIndex,
                          buffer->allocation->iglBuffer.get(),
                          subAllocatedOffset);
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <IGLU/simdtypes/SimdTypes.h>
+#include <IGLU/simple_renderer/DirtyRange.h>
 #include <igl/Common.h>
 #include <igl/IGL.h>
 #include <igl/NameHandle.h>
@@ -191,6 +192,81 @@ class ShaderUniforms final {
                const iglu::simdtypes::int2& value,
                size_t arrayIndex = 0);
 
+  /// Identifies a uniform resolved once by getUniformHandle(). It holds the byte offsets of the
+  /// uniform in every buffer declaring it, so the setters below write to them directly instead of
+  /// looking names up on every call. Valid for the lifetime of the ShaderUniforms returning it.
+  class UniformHandle {
+   public:
+    [[nodiscard]] bool isValid() const {
+      return count_ != 0;
+    }
+
+   private:
+    friend class ShaderUniforms;
+    uint32_t first_ = 0;
+    uint32_t count_ = 0;
+  };
+
+  /// Resolves a uniform once, ahead of per frame updates. Returns an invalid handle if no
+  /// uniform matches.
+  [[nodiscard]] UniformHandle getUniformHandle(const igl::NameHandle& uniformName);
+  [[nodiscard]] UniformHandle getUniformHandle(const igl::NameHandle& blockTypeName,
+                                               const igl::NameHandle& blockInstanceName,
+                                               const igl::NameHandle& memberName);
+
+  // Setters taking a handle. float3 based types are left out, as their packing depends on the
+  // backend; use the name based setters for them.
+  void setBool(const UniformHandle& handle, const bool& value, size_t arrayIndex = 0);
+  void setBoolArray(const UniformHandle& handle,
+                    const bool* value,
+                    size_t count = 1,
+                    size_t arrayIndex = 0);
+  void setFloat(const UniformHandle& handle,
+                const iglu::simdtypes::float1& value,
+                size_t arrayIndex = 0);
+  void setFloatArray(const UniformHandle& handle,
+                     const iglu::simdtypes::float1* value,
+                     size_t count = 1,
+                     size_t arrayIndex = 0);
+  void setFloat2(const UniformHandle& handle,
+                 const iglu::simdtypes::float2& value,
+                 size_t arrayIndex = 0);
+  void setFloat2Array(const UniformHandle& handle,
+                      const iglu::simdtypes::float2* value,
+                      size_t count = 1,
+                      size_t arrayIndex = 0);
+  void setFloat4(const UniformHandle& handle,
+                 const iglu::simdtypes::float4& value,
+                 size_t arrayIndex = 0);
+  void setFloat4Array(const UniformHandle& handle,
+                      const iglu::simdtypes::float4* value,
+                      size_t count = 1,
+                      size_t arrayIndex = 0);
+  void setFloat2x2(const UniformHandle& handle,
+                   const iglu::simdtypes::float2x2& value,
+                   size_t arrayIndex = 0);
+  void setFloat2x2Array(const UniformHandle& handle,
+                        const iglu::simdtypes::float2x2* value,
+                        size_t count = 1,
+                        size_t arrayIndex = 0);
+  void setFloat4x4(const UniformHandle& handle,
+                   const iglu::simdtypes::float4x4& value,
+                   size_t arrayIndex = 0);
+  void setFloat4x4Array(const UniformHandle& handle,
+                        const iglu::simdtypes::float4x4* value,
+                        size_t count = 1,
+                        size_t arrayIndex = 0);
+  void setInt(const UniformHandle& handle,
+              const iglu::simdtypes::int1& value,
+              size_t arrayIndex = 0);
+  void setIntArray(const UniformHandle& handle,
+                   const iglu::simdtypes::int1* value,
+                   size_t count = 1,
+                   size_t arrayIndex = 0);
+  void setInt2(const UniformHandle& handle,
+               const iglu::simdtypes::int2& value,
+               size_t arrayIndex = 0);
+
   void setTexture(const std::string& name,
                   const std::shared_ptr<igl::ITexture>& value,
                   const std::shared_ptr<igl::ISamplerState>& sampler,
@@ -202,7 +278,8 @@ class ShaderUniforms final {
 
   void setTexture(const std::string& name, igl::ITexture* value, igl::ISamplerState* sampler);
 
-  /// Binds all relevant states in 'encoder' in preparation for drawing.
+  /// Binds all relevant states in 'encoder' in preparation for drawing. Buffers that aren't ring
+  /// buffers only upload the bytes written since their last upload.
   void bind(igl::IDevice& device,
             const igl::IRenderPipelineState& pipelineState,
             igl::IRenderCommandEncoder& encoder);
@@ -266,10 +343,13 @@ class ShaderUniforms final {
     void* ptr = nullptr;
     size_t size = 0;
     std::shared_ptr<igl::IBuffer> iglBuffer;
-    bool dirty = false;
+    // Ring buffers cycle through one copy per frame in flight, so each upload must be complete
+    bool isRingBuffer = false;
+    // Bytes written since the last upload; everything is uploaded the first time
+    DirtyRange dirty;
 
     BufferAllocation(void* ptr, size_t size, std::shared_ptr<igl::IBuffer> buffer) :
-      ptr(ptr), size(size), iglBuffer(std::move(buffer)) {}
+      ptr(ptr), size(size), iglBuffer(std::move(buffer)), dirty(size) {}
   };
 
   struct BufferDesc;
@@ -298,6 +378,15 @@ class ShaderUniforms final {
 
   std::unordered_multimap<igl::NameHandle, UniformDesc> _allUniformsByName;
 
+  struct UniformTarget {
+    BufferDesc* buffer = nullptr;
+    size_t offset = 0;
+    size_t arrayLength = 0;
+  };
+  // Targets of all handles, each handle owning a contiguous range
+  std::vector<UniformTarget> _uniformTargets;
+  std::unordered_map<igl::NameHandle, UniformHandle> _uniformHandles;
+
   MemoizedQualifiedMemberNameCalculator memoizedQualifiedMemberNameCalculator_;
 
   struct TextureSlot {
@@ -319,6 +408,17 @@ class ShaderUniforms final {
       const igl::NameHandle& blockInstanceName,
       const igl::NameHandle& memberName);
 
+  UniformHandle makeUniformHandle(const igl::NameHandle& key,
+                                  const std::vector<const UniformDesc*>& uniforms);
+
+  void writeUniformBytes(BufferDesc& buffer, size_t offset, const void* data, size_t size);
+
+  void setUniformBytes(const UniformHandle& handle,
+                       const void* data,
+                       size_t elementSize,
+                       size_t count,
+                       size_t arrayIndex);
+
   void setUniformBytes(const UniformDesc& uniformDesc,
                        const void* data,
                        size_t elementSize,
@@ -344,6 +444,8 @@ class ShaderUniforms final {
                          const igl::IRenderPipelineState& pipelineState,
                          igl::IRenderCommandEncoder& encoder);
 
+  void uploadBuffer(BufferAllocation& allocation, size_t offset, size_t size);
+
   void bindBuffer(igl::IDevice& device,
                   const igl::IRenderPipelineState& pipelineState,
                   igl::IRenderCommandEncoder& encoder,
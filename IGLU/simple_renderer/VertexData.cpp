@@ -72,6 +72,11 @@ void VertexData::draw(igl::IRenderCommandEncoder& commandEncoder) {
   if (primitiveDesc_.numEntries == 0) {
     return;
   }
+  bind(commandEncoder);
+  drawInstances(commandEncoder, 1);
+}
+
+void VertexData::bind(igl::IRenderCommandEncoder& commandEncoder) {
   // Assumption: we don't need buffer offset
   if (vb_) {
     commandEncoder.bindVertexBuffer(0, *vb_);
@@ -79,9 +84,18 @@ void VertexData::draw(igl::IRenderCommandEncoder& commandEncoder) {
 
   if (ib_) {
     commandEncoder.bindIndexBuffer(*ib_, ibFormat_, primitiveDesc_.offset);
-    commandEncoder.drawIndexed(primitiveDesc_.numEntries);
+  }
+}
+
+void VertexData::drawInstances(igl::IRenderCommandEncoder& commandEncoder,
+                               uint32_t instanceCount) {
+  if (primitiveDesc_.numEntries == 0 || instanceCount == 0) {
+    return;
+  }
+  if (ib_) {
+    commandEncoder.drawIndexed(primitiveDesc_.numEntries, instanceCount);
   } else {
-    commandEncoder.draw(primitiveDesc_.numEntries, 1, primitiveDesc_.offset);
+    commandEncoder.draw(primitiveDesc_.numEntries, instanceCount, primitiveDesc_.offset);
   }
 }
 
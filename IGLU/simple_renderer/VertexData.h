@@ -32,6 +32,12 @@ class VertexData final {
   /// Invokes the draw command of the lower level APIs.
   void draw(igl::IRenderCommandEncoder& commandEncoder);
 
+  /// Binds the vertex and index buffers. Lets callers drawing the same vertex data repeatedly
+  /// bind it once and then call drawInstances().
+  void bind(igl::IRenderCommandEncoder& commandEncoder);
+  /// Issues an instanced draw command, assuming the buffers are bound.
+  void drawInstances(igl::IRenderCommandEncoder& commandEncoder, uint32_t instanceCount);
+
   PrimitiveDesc& primitiveDesc();
   std::shared_ptr<igl::IVertexInputState> vertexInputState();
 
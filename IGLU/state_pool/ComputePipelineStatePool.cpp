@@ -8,6 +8,7 @@
 #include <IGLU/state_pool/ComputePipelineStatePool.h>
 
 #include <igl/Device.h>
+#include <igl/Hash.h>
 
 namespace iglu::state_pool {
 
@@ -18,4 +19,23 @@ std::shared_ptr<igl::IComputePipelineState> ComputePipelineStatePool::createStat
   return dev.createComputePipeline(desc, outResult);
 }
 
+///--------------------------------------
+/// MARK: - ConcurrentComputePipelineStatePool
+
+size_t ConcurrentComputePipelineStatePool::persistentDescriptorHash(
+    const igl::ComputePipelineDesc& desc) const {
+  igl::Fnv1aHasher hasher;
+  hasher.add(persistentShaderStagesHash(desc.shaderStages.get())).add(desc.debugName);
+  addPersistentHash(hasher, desc.buffersMap);
+  addPersistentHash(hasher, desc.imagesMap);
+  return static_cast<size_t>(hasher.value());
+}
+
+std::shared_ptr<igl::IComputePipelineState> ConcurrentComputePipelineStatePool::createStateObject(
+    igl::IDevice& dev,
+    const igl::ComputePipelineDesc& desc,
+    igl::Result* outResult) {
+  return dev.createComputePipeline(desc, outResult);
+}
+
 } // namespace iglu::state_pool
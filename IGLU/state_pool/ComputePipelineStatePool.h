@@ -26,4 +26,20 @@ class ComputePipelineStatePool
       igl::Result* outResult) override;
 };
 
+/// Thread safe version of ComputePipelineStatePool. For prewarming, shader stages are identified
+/// across runs by their modules' entry points and debug names.
+class ConcurrentComputePipelineStatePool final
+  : public ConcurrentLRUStatePool<igl::ComputePipelineDesc, igl::IComputePipelineState> {
+ public:
+  using ConcurrentLRUStatePool::ConcurrentLRUStatePool;
+
+ private:
+  size_t persistentDescriptorHash(const igl::ComputePipelineDesc& desc) const override;
+
+  std::shared_ptr<igl::IComputePipelineState> createStateObject(
+      igl::IDevice& dev,
+      const igl::ComputePipelineDesc& desc,
+      igl::Result* outResult) override;
+};
+
 } // namespace iglu::state_pool
@@ -18,4 +18,14 @@ std::shared_ptr<igl::IDepthStencilState> DepthStencilStatePool::createStateObjec
   return dev.createDepthStencilState(desc, outResult);
 }
 
+///--------------------------------------
+/// MARK: - ConcurrentDepthStencilStatePool
+
+std::shared_ptr<igl::IDepthStencilState> ConcurrentDepthStencilStatePool::createStateObject(
+    igl::IDevice& dev,
+    const igl::DepthStencilStateDesc& desc,
+    igl::Result* outResult) {
+  return dev.createDepthStencilState(desc, outResult);
+}
+
 } // namespace iglu::state_pool
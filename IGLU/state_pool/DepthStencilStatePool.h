@@ -25,4 +25,16 @@ class DepthStencilStatePool
                                                              igl::Result* outResult) override;
 };
 
+/// Thread safe version of DepthStencilStatePool.
+class ConcurrentDepthStencilStatePool final
+  : public ConcurrentLRUStatePool<igl::DepthStencilStateDesc, igl::IDepthStencilState> {
+ public:
+  using ConcurrentLRUStatePool::ConcurrentLRUStatePool;
+
+ private:
+  std::shared_ptr<igl::IDepthStencilState> createStateObject(igl::IDevice& dev,
+                                                             const igl::DepthStencilStateDesc& desc,
+                                                             igl::Result* outResult) override;
+};
+
 } // namespace iglu::state_pool
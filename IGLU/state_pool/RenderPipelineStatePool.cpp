@@ -7,7 +7,10 @@
 
 #include <IGLU/state_pool/RenderPipelineStatePool.h>
 
+#include <algorithm>
 #include <igl/Device.h>
+#include <igl/Hash.h>
+#include <vector>
 
 using namespace igl;
 
@@ -66,4 +69,64 @@ void CountedRenderPipelineStatePool::compact() {
   }
 }
 
+///--------------------------------------
+/// MARK: - ConcurrentRenderPipelineStatePool
+
+size_t ConcurrentRenderPipelineStatePool::persistentDescriptorHash(
+    const igl::RenderPipelineDesc& desc) const {
+  // The vertex input state and immutable samplers are objects without a persistent identity and
+  // are left out
+  Fnv1aHasher hasher;
+  hasher.add(persistentShaderStagesHash(desc.shaderStages.get()));
+
+  hasher.add(desc.targetDesc.colorAttachments.size());
+  for (const auto& attachment : desc.targetDesc.colorAttachments) {
+    hasher.add(attachment.textureFormat)
+        .add(attachment.colorWriteMask)
+        .add(attachment.blendEnabled)
+        .add(attachment.rgbBlendOp)
+        .add(attachment.alphaBlendOp)
+        .add(attachment.srcRGBBlendFactor)
+        .add(attachment.srcAlphaBlendFactor)
+        .add(attachment.dstRGBBlendFactor)
+        .add(attachment.dstAlphaBlendFactor);
+  }
+  hasher.add(desc.targetDesc.depthAttachmentFormat).add(desc.targetDesc.stencilAttachmentFormat);
+
+  hasher.add(desc.topology)
+      .add(desc.cullMode)
+      .add(desc.sampleCount)
+      .add(desc.frontFaceWinding)
+      .add(desc.polygonFillMode)
+      .add(desc.isDynamicBufferMask)
+      .add(desc.debugName.toString());
+
+  addPersistentHash(hasher, desc.vertexUnitSamplerMap);
+  addPersistentHash(hasher, desc.fragmentUnitSamplerMap);
+
+  std::vector<size_t> bindings;
+  bindings.reserve(desc.uniformBlockBindingMap.size());
+  for (const auto& binding : desc.uniformBlockBindingMap) {
+    bindings.push_back(binding.first);
+  }
+  std::sort(bindings.begin(), bindings.end());
+  hasher.add(bindings.size());
+  for (const size_t binding : bindings) {
+    const auto& names = desc.uniformBlockBindingMap.at(binding);
+    hasher.add(binding).add(names.size());
+    for (const auto& [blockName, instanceName] : names) {
+      hasher.add(blockName.toString()).add(instanceName.toString());
+    }
+  }
+
+  return static_cast<size_t>(hasher.value());
+}
+
+std::shared_ptr<igl::IRenderPipelineState> ConcurrentRenderPipelineStatePool::createStateObject(
+    igl::IDevice& dev,
+    const igl::RenderPipelineDesc& desc,
+    igl::Result* outResult) {
+  return dev.createRenderPipeline(desc, outResult);
+}
+
 } // namespace iglu::state_pool
@@ -49,4 +49,21 @@ class CountedRenderPipelineStatePool final
       cache_;
 };
 
+/// Thread safe version of RenderPipelineStatePool. For prewarming, shader stages are identified
+/// across runs by their modules' entry points and sources, and vertex input states and immutable
+/// samplers not at all, so prewarm() may create states for candidates differing from recorded
+/// descriptors only in those.
+class ConcurrentRenderPipelineStatePool final
+  : public ConcurrentLRUStatePool<igl::RenderPipelineDesc, igl::IRenderPipelineState> {
+ public:
+  using ConcurrentLRUStatePool::ConcurrentLRUStatePool;
+
+ private:
+  size_t persistentDescriptorHash(const igl::RenderPipelineDesc& desc) const override;
+
+  std::shared_ptr<igl::IRenderPipelineState> createStateObject(igl::IDevice& dev,
+                                                               const igl::RenderPipelineDesc& desc,
+                                                               igl::Result* outResult) override;
+};
+
 } // namespace iglu::state_pool
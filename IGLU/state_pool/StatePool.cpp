@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/state_pool/StatePool.h>
+
+#include <algorithm>
+#include <igl/Hash.h>
+#include <igl/NameHandle.h>
+#include <igl/Shader.h>
+
+namespace iglu::state_pool {
+
+size_t persistentShaderStagesHash(const igl::IShaderStages* stages) {
+  if (stages == nullptr) {
+    return 0;
+  }
+
+  igl::Fnv1aHasher hasher;
+  hasher.add(stages->getType());
+  for (const auto* module : {stages->getVertexModule().get(),
+                             stages->getFragmentModule().get(),
+                             stages->getComputeModule().get()}) {
+    // Absent modules still contribute, so the slot a module occupies is part of the hash
+    hasher.add(module != nullptr);
+    if (module != nullptr) {
+      // Entry points tell apart modules of one library, which share their input hash
+      const auto& info = module->info();
+      hasher.add(info.stage).add(info.entryPoint).add(info.inputHash);
+    }
+  }
+  return static_cast<size_t>(hasher.value());
+}
+
+void addPersistentHash(igl::Fnv1aHasher& hasher,
+                       const std::unordered_map<size_t, igl::NameHandle>& map) {
+  // Iteration order of unordered maps differs between runs and standard libraries
+  std::vector<std::pair<size_t, const igl::NameHandle*>> entries;
+  entries.reserve(map.size());
+  for (const auto& [index, name] : map) {
+    entries.emplace_back(index, &name);
+  }
+  std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+    return a.first < b.first;
+  });
+  hasher.add(entries.size());
+  for (const auto& [index, name] : entries) {
+    hasher.add(index).add(name->toString());
+  }
+}
+
+} // namespace iglu::state_pool
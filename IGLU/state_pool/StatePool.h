@@ -7,14 +7,23 @@
 
 #pragma once
 
+#include <algorithm>
 #include <igl/Common.h>
+#include <istream>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <ostream>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace igl {
+class Fnv1aHasher;
 class IDevice;
+class IShaderStages;
+class NameHandle;
 }
 
 namespace iglu::state_pool {
@@ -103,4 +112,234 @@ class LRUStatePool : public IStatePool<TDescriptor, TStateObject> {
   uint32_t maxCacheSize_ = 1024; // maximum capacity of cache
 };
 
+///--------------------------------------
+/// MARK: - ConcurrentLRUStatePool
+
+/// Hashes the entry points and input hashes of the modules of 'stages' with FNV-1a, which unlike
+/// their addresses identify them across runs and platforms. Modules created without the
+/// ShaderModuleDesc or ShaderLibraryDesc factories have no input hash and are told apart by their
+/// entry points only.
+size_t persistentShaderStagesHash(const igl::IShaderStages* stages);
+
+/// Adds the entries of a binding map to 'hasher' in index order, so that the result does not depend
+/// on the map's iteration order.
+void addPersistentHash(igl::Fnv1aHasher& hasher,
+                       const std::unordered_map<size_t, igl::NameHandle>& map);
+
+/// Thread safe variant of LRUStatePool. Descriptors are spread across shards by hash, each shard
+/// having its own lock and LRU order, so threads rarely contend. A shard keeps its entries in an
+/// array allocated up front, linked into hash chains and the LRU list by index, so cache misses
+/// copy the descriptor once and allocate nothing per entry. Eviction is least recently used
+/// within a shard.
+///
+/// The pool also records a hash of the first `maxRecordedHashes` descriptors it creates a state
+/// for. Saved with writeDescriptorHashes() and read back in a later run, they let prewarm() create
+/// the states that run is expected to need before the first frame.
+template<class TDescriptor, class TStateObject>
+class ConcurrentLRUStatePool : public IStatePool<TDescriptor, TStateObject> {
+ public:
+  explicit ConcurrentLRUStatePool(uint32_t maxCacheSize = 1024,
+                                  uint32_t numShards = 16,
+                                  uint32_t maxRecordedHashes = 4096) :
+    numShards_(std::clamp(numShards, 1u, std::max(maxCacheSize, 1u))),
+    shards_(std::make_unique<Shard[]>(numShards_)) {
+    const uint32_t shardCapacity = (std::max(maxCacheSize, 1u) + numShards_ - 1) / numShards_;
+    uint32_t numChains = 1;
+    while (numChains < shardCapacity) {
+      numChains <<= 1;
+    }
+    for (uint32_t i = 0; i < numShards_; ++i) {
+      shards_[i].capacity = shardCapacity;
+      shards_[i].entries.reserve(shardCapacity);
+      shards_[i].chains.assign(numChains, kNone);
+      shards_[i].maxSeenHashes = (maxRecordedHashes + numShards_ - 1) / numShards_;
+    }
+  }
+
+  std::shared_ptr<TStateObject> getOrCreate(igl::IDevice& dev,
+                                            const TDescriptor& desc,
+                                            igl::Result* outResult) final {
+    const size_t hash = std::hash<TDescriptor>()(desc);
+    Shard& shard = shards_[hash % numShards_];
+    {
+      const std::lock_guard<std::mutex> lock(shard.mutex);
+      if (auto state = find(shard, desc, hash)) {
+        igl::Result::setOk(outResult);
+        return state;
+      }
+    }
+
+    // Creating state objects can be slow, so the shard stays unlocked meanwhile
+    auto stateResource = createStateObject(dev, desc, outResult);
+    if (!IGL_DEBUG_VERIFY(stateResource != nullptr)) {
+      return nullptr;
+    }
+    const size_t persistentHash = persistentDescriptorHash(desc);
+
+    const std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.seenHashes.size() < shard.maxSeenHashes) {
+      shard.seenHashes.insert(persistentHash);
+    }
+    // Another thread may have created the same state meanwhile
+    if (auto state = find(shard, desc, hash)) {
+      return state;
+    }
+    insert(shard, desc, hash, stateResource);
+    return stateResource;
+  }
+
+  /// Creates the states of those 'descs' whose persistent hashes are in 'hashes', typically read
+  /// with readDescriptorHashes(). Returns the number of states created.
+  ///
+  /// Like any state creation, this needs a thread the device can create objects on. On OpenGL that
+  /// is the render thread, or a thread with a current context sharing objects with the render one.
+  size_t prewarm(igl::IDevice& dev,
+                 const std::vector<TDescriptor>& descs,
+                 const std::unordered_set<size_t>& hashes) {
+    size_t numCreated = 0;
+    for (const auto& desc : descs) {
+      if (hashes.count(persistentDescriptorHash(desc)) == 0) {
+        continue;
+      }
+      igl::Result result;
+      if (getOrCreate(dev, desc, &result) != nullptr && result.isOk()) {
+        ++numCreated;
+      }
+    }
+    return numCreated;
+  }
+
+  /// Writes the recorded persistent hashes, including those of states evicted since, one per line.
+  void writeDescriptorHashes(std::ostream& stream) const {
+    for (uint32_t i = 0; i < numShards_; ++i) {
+      const std::lock_guard<std::mutex> lock(shards_[i].mutex);
+      for (const size_t hash : shards_[i].seenHashes) {
+        stream << hash << '\n';
+      }
+    }
+  }
+
+  static std::unordered_set<size_t> readDescriptorHashes(std::istream& stream) {
+    std::unordered_set<size_t> hashes;
+    size_t hash = 0;
+    while (stream >> hash) {
+      hashes.insert(hash);
+    }
+    return hashes;
+  }
+
+  [[nodiscard]] size_t size() const {
+    size_t size = 0;
+    for (uint32_t i = 0; i < numShards_; ++i) {
+      const std::lock_guard<std::mutex> lock(shards_[i].mutex);
+      size += shards_[i].entries.size();
+    }
+    return size;
+  }
+
+ protected:
+  /// Hash recorded for prewarming, which must identify a descriptor across runs. std::hash is
+  /// used by default; pools of descriptors referencing objects hashed by address override it.
+  virtual size_t persistentDescriptorHash(const TDescriptor& desc) const {
+    return std::hash<TDescriptor>()(desc);
+  }
+
+ private:
+  static constexpr uint32_t kNone = ~0u;
+
+  struct Entry {
+    TDescriptor desc;
+    std::shared_ptr<TStateObject> state;
+    size_t hash = 0;
+    uint32_t prev = kNone;
+    uint32_t next = kNone;
+    uint32_t nextInChain = kNone;
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    uint32_t capacity = 0;
+    std::vector<Entry> entries;
+    // Heads of the hash chains, a power of two of them
+    std::vector<uint32_t> chains;
+    // Most and least recently used entries
+    uint32_t head = kNone;
+    uint32_t tail = kNone;
+    // Persistent hashes recorded for prewarming. Recording stops once there are maxSeenHashes.
+    std::unordered_set<size_t> seenHashes;
+    size_t maxSeenHashes = 0;
+  };
+
+  virtual std::shared_ptr<TStateObject> createStateObject(igl::IDevice& dev,
+                                                          const TDescriptor& desc,
+                                                          igl::Result* outResult) = 0;
+
+  uint32_t& chainHead(Shard& shard, size_t hash) const {
+    // The shard was picked by the hash modulo numShards_, so the chain uses the remaining bits.
+    // Masking the hash itself would leave all entries of a shard in 1 / numShards_ of its chains.
+    return shard.chains[(hash / numShards_) & (shard.chains.size() - 1)];
+  }
+
+  static void unlink(Shard& shard, uint32_t index) {
+    Entry& entry = shard.entries[index];
+    (entry.prev != kNone ? shard.entries[entry.prev].next : shard.head) = entry.next;
+    (entry.next != kNone ? shard.entries[entry.next].prev : shard.tail) = entry.prev;
+    entry.prev = entry.next = kNone;
+  }
+
+  static void pushFront(Shard& shard, uint32_t index) {
+    Entry& entry = shard.entries[index];
+    entry.next = shard.head;
+    (shard.head != kNone ? shard.entries[shard.head].prev : shard.tail) = index;
+    shard.head = index;
+  }
+
+  std::shared_ptr<TStateObject> find(Shard& shard, const TDescriptor& desc, size_t hash) const {
+    for (uint32_t index = chainHead(shard, hash); index != kNone;
+         index = shard.entries[index].nextInChain) {
+      Entry& entry = shard.entries[index];
+      if (entry.hash == hash && entry.desc == desc) {
+        if (index != shard.head) {
+          unlink(shard, index);
+          pushFront(shard, index);
+        }
+        return entry.state;
+      }
+    }
+    return nullptr;
+  }
+
+  void insert(Shard& shard,
+              const TDescriptor& desc,
+              size_t hash,
+              std::shared_ptr<TStateObject> state) const {
+    uint32_t index = kNone;
+    if (shard.entries.size() < shard.capacity) {
+      index = static_cast<uint32_t>(shard.entries.size());
+      shard.entries.emplace_back();
+    } else {
+      // Reuse the least recently used entry
+      index = shard.tail;
+      unlink(shard, index);
+      uint32_t* link = &chainHead(shard, shard.entries[index].hash);
+      while (*link != index) {
+        link = &shard.entries[*link].nextInChain;
+      }
+      *link = shard.entries[index].nextInChain;
+    }
+
+    Entry& entry = shard.entries[index];
+    entry.desc = desc;
+    entry.state = std::move(state);
+    entry.hash = hash;
+    uint32_t& head = chainHead(shard, hash);
+    entry.nextInChain = head;
+    head = index;
+    pushFront(shard, index);
+  }
+
+  const uint32_t numShards_;
+  std::unique_ptr<Shard[]> shards_;
+};
+
 } // namespace iglu::state_pool
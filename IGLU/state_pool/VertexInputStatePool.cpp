@@ -18,4 +18,14 @@ std::shared_ptr<igl::IVertexInputState> VertexInputStatePool::createStateObject(
   return dev.createVertexInputState(desc, outResult);
 }
 
+///--------------------------------------
+/// MARK: - ConcurrentVertexInputStatePool
+
+std::shared_ptr<igl::IVertexInputState> ConcurrentVertexInputStatePool::createStateObject(
+    igl::IDevice& dev,
+    const igl::VertexInputStateDesc& desc,
+    igl::Result* outResult) {
+  return dev.createVertexInputState(desc, outResult);
+}
+
 } // namespace iglu::state_pool
@@ -25,4 +25,16 @@ class VertexInputStatePool
                                                             igl::Result* outResult) override;
 };
 
+/// Thread safe version of VertexInputStatePool.
+class ConcurrentVertexInputStatePool final
+  : public ConcurrentLRUStatePool<igl::VertexInputStateDesc, igl::IVertexInputState> {
+ public:
+  using ConcurrentLRUStatePool::ConcurrentLRUStatePool;
+
+ private:
+  std::shared_ptr<igl::IVertexInputState> createStateObject(igl::IDevice& dev,
+                                                            const igl::VertexInputStateDesc& desc,
+                                                            igl::Result* outResult) override;
+};
+
 } // namespace iglu::state_pool
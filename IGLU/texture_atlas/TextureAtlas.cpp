@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/texture_atlas/TextureAtlas.h>
+
+#include <IGLU/texture_loader/PixelConversion.h>
+#include <algorithm>
+#include <cstring>
+#include <igl/Device.h>
+#include <limits>
+
+namespace iglu::textureatlas {
+
+namespace {
+
+bool supportsCpuMipmaps(igl::TextureFormat format) {
+  return format == igl::TextureFormat::RGBA_UNorm8 || format == igl::TextureFormat::BGRA_UNorm8 ||
+         format == igl::TextureFormat::RGBA_SRGB || format == igl::TextureFormat::BGRA_SRGB;
+}
+
+uint32_t alignUp(uint32_t value, uint32_t alignment) {
+  return (value + alignment - 1u) / alignment * alignment;
+}
+
+} // namespace
+
+TextureAtlas::TextureAtlas(igl::IDevice& device, TextureAtlasDesc desc) :
+  device_(device), desc_(std::move(desc)) {
+  const auto properties = igl::TextureFormatProperties::fromTextureFormat(desc_.format);
+  if (!properties.isCompressed()) {
+    bytesPerPixel_ = properties.bytesPerBlock;
+  }
+  desc_.numMipLevels = std::clamp(
+      desc_.numMipLevels,
+      1u,
+      igl::TextureDesc::calcNumMipLevels(desc_.pageWidth, desc_.pageHeight));
+  alignment_ = 1u << (desc_.numMipLevels - 1u);
+}
+
+AtlasHandle TextureAtlas::add(uint32_t width,
+                              uint32_t height,
+                              const void* IGL_NONNULL data,
+                              size_t bytesPerRow,
+                              igl::Result* IGL_NULLABLE outResult) {
+  if (bytesPerPixel_ == 0 || (desc_.numMipLevels > 1 && !supportsCpuMipmaps(desc_.format))) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::Unsupported, "Unsupported texture atlas format.");
+    return 0;
+  }
+  if (width == 0 || height == 0 || data == nullptr) {
+    igl::Result::setResult(outResult, igl::Result::Code::ArgumentInvalid, "Empty image.");
+    return 0;
+  }
+
+  const uint32_t allocationWidth = alignUp(width + 2u * desc_.padding, alignment_);
+  const uint32_t allocationHeight = alignUp(height + 2u * desc_.padding, alignment_);
+  if (allocationWidth > desc_.pageWidth || allocationHeight > desc_.pageHeight) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::ArgumentOutOfRange, "Image is larger than an atlas page.");
+    return 0;
+  }
+
+  uint32_t page = 0;
+  Rect allocation;
+  if (!allocate(allocationWidth, allocationHeight, page, allocation)) {
+    if (pages_.size() >= desc_.maxPages) {
+      igl::Result::setResult(
+          outResult, igl::Result::Code::ArgumentOutOfRange, "Texture atlas is full.");
+      return 0;
+    }
+    if (!addPage(outResult)) {
+      return 0;
+    }
+    page = static_cast<uint32_t>(pages_.size() - 1);
+    if (!allocateFromSkyline(pages_.back(), allocationWidth, allocationHeight, allocation)) {
+      igl::Result::setResult(
+          outResult, igl::Result::Code::RuntimeError, "Failed to allocate from an empty page.");
+      return 0;
+    }
+  }
+
+  auto result = upload(
+      page, allocation, width, height, static_cast<const uint8_t*>(data), bytesPerRow);
+  if (!result.isOk()) {
+    pages_[page].freeRects.push_back(allocation);
+    igl::Result::setResult(outResult, std::move(result));
+    return 0;
+  }
+
+  Entry entry;
+  entry.allocation = allocation;
+  entry.region.page = page;
+  entry.region.x = allocation.x + desc_.padding;
+  entry.region.y = allocation.y + desc_.padding;
+  entry.region.width = width;
+  entry.region.height = height;
+  entry.region.u0 = static_cast<float>(entry.region.x) / static_cast<float>(desc_.pageWidth);
+  entry.region.v0 = static_cast<float>(entry.region.y) / static_cast<float>(desc_.pageHeight);
+  entry.region.u1 =
+      static_cast<float>(entry.region.x + width) / static_cast<float>(desc_.pageWidth);
+  entry.region.v1 =
+      static_cast<float>(entry.region.y + height) / static_cast<float>(desc_.pageHeight);
+
+  const AtlasHandle handle = nextHandle_++;
+  if (nextHandle_ == 0) {
+    nextHandle_ = 1;
+  }
+  entries_[handle] = entry;
+
+  igl::Result::setOk(outResult);
+  return handle;
+}
+
+void TextureAtlas::remove(AtlasHandle handle) {
+  auto it = entries_.find(handle);
+  if (it == entries_.end()) {
+    return;
+  }
+  pages_[it->second.region.page].freeRects.push_back(it->second.allocation);
+  entries_.erase(it);
+}
+
+const AtlasRegion* IGL_NULLABLE TextureAtlas::getRegion(AtlasHandle handle) const {
+  auto it = entries_.find(handle);
+  return it != entries_.end() ? &it->second.region : nullptr;
+}
+
+std::shared_ptr<igl::ITexture> TextureAtlas::getTexture(uint32_t page) const {
+  if (page >= pages_.size()) {
+    return nullptr;
+  }
+  return desc_.useArrayTexture ? pages_.front().texture : pages_[page].texture;
+}
+
+uint32_t TextureAtlas::numPages() const noexcept {
+  return static_cast<uint32_t>(pages_.size());
+}
+
+size_t TextureAtlas::numImages() const noexcept {
+  return entries_.size();
+}
+
+bool TextureAtlas::allocate(uint32_t width, uint32_t height, uint32_t& outPage, Rect& outRect) {
+  // Reuse released space before growing any skyline so long running atlases don't fragment
+  for (uint32_t i = 0; i < pages_.size(); ++i) {
+    if (allocateFromFreeList(pages_[i], width, height, outRect)) {
+      outPage = i;
+      return true;
+    }
+  }
+  for (uint32_t i = 0; i < pages_.size(); ++i) {
+    if (allocateFromSkyline(pages_[i], width, height, outRect)) {
+      outPage = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool TextureAtlas::allocateFromFreeList(Page& page,
+                                        uint32_t width,
+                                        uint32_t height,
+                                        Rect& outRect) {
+  auto& freeRects = page.freeRects;
+  for (size_t i = 0; i < freeRects.size(); ++i) {
+    const Rect free = freeRects[i];
+    if (free.width < width || free.height < height) {
+      continue;
+    }
+    outRect = {free.x, free.y, width, height};
+    freeRects.erase(freeRects.begin() + static_cast<std::ptrdiff_t>(i));
+
+    // Split the remainder along the shorter leftover axis, which keeps the larger piece whole
+    Rect right{free.x + width, free.y, free.width - width, height};
+    Rect bottom{free.x, free.y + height, free.width, free.height - height};
+    if (free.width - width > free.height - height) {
+      right.height = free.height;
+      bottom.width = width;
+    }
+    if (right.width > 0 && right.height > 0) {
+      freeRects.push_back(right);
+    }
+    if (bottom.width > 0 && bottom.height > 0) {
+      freeRects.push_back(bottom);
+    }
+    return true;
+  }
+  return false;
+}
+
+bool TextureAtlas::allocateFromSkyline(Page& page,
+                                       uint32_t width,
+                                       uint32_t height,
+                                       Rect& outRect) const {
+  auto& skyline = page.skyline;
+
+  // Bottom-left heuristic: the lowest position, then the narrowest node to waste less space
+  size_t bestIndex = skyline.size();
+  uint32_t bestY = std::numeric_limits<uint32_t>::max();
+  uint32_t bestWidth = std::numeric_limits<uint32_t>::max();
+  for (size_t i = 0; i < skyline.size(); ++i) {
+    if (skyline[i].x + width > desc_.pageWidth) {
+      break;
+    }
+    uint32_t y = 0;
+    uint32_t remaining = width;
+    for (size_t j = i; remaining > 0; ++j) {
+      y = std::max(y, skyline[j].y);
+      remaining -= std::min(remaining, skyline[j].width);
+    }
+    if (y + height > desc_.pageHeight) {
+      continue;
+    }
+    if (y < bestY || (y == bestY && skyline[i].width < bestWidth)) {
+      bestIndex = i;
+      bestY = y;
+      bestWidth = skyline[i].width;
+    }
+  }
+  if (bestIndex == skyline.size()) {
+    return false;
+  }
+
+  outRect = {skyline[bestIndex].x, bestY, width, height};
+
+  // Raise the skyline over the new rectangle and trim the nodes it covers
+  skyline.insert(skyline.begin() + static_cast<std::ptrdiff_t>(bestIndex),
+                 SkylineNode{outRect.x, bestY + height, width});
+  const uint32_t right = outRect.x + width;
+  size_t i = bestIndex + 1;
+  while (i < skyline.size() && skyline[i].x < right) {
+    const uint32_t nodeRight = skyline[i].x + skyline[i].width;
+    if (nodeRight <= right) {
+      skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i));
+      continue;
+    }
+    skyline[i].width = nodeRight - right;
+    skyline[i].x = right;
+    break;
+  }
+
+  // Merge neighbors of equal height
+  for (i = 0; i + 1 < skyline.size();) {
+    if (skyline[i].y == skyline[i + 1].y) {
+      skyline[i].width += skyline[i + 1].width;
+      skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+    } else {
+      ++i;
+    }
+  }
+  return true;
+}
+
+bool TextureAtlas::addPage(igl::Result* IGL_NULLABLE outResult) {
+  Page page;
+  page.skyline.push_back({0, 0, desc_.pageWidth});
+
+  if (!desc_.useArrayTexture || pages_.empty()) {
+    auto textureDesc = igl::TextureDesc::new2D(desc_.format,
+                                               desc_.pageWidth,
+                                               desc_.pageHeight,
+                                               igl::TextureDesc::TextureUsageBits::Sampled,
+                                               desc_.debugName.c_str());
+    if (desc_.useArrayTexture) {
+      textureDesc.type = igl::TextureType::TwoDArray;
+      textureDesc.numLayers = desc_.maxPages;
+    }
+    textureDesc.numMipLevels = desc_.numMipLevels;
+    page.texture = device_.createTexture(textureDesc, outResult);
+    if (page.texture == nullptr) {
+      return false;
+    }
+  }
+
+  pages_.push_back(std::move(page));
+  return true;
+}
+
+igl::Result TextureAtlas::upload(uint32_t page,
+                                 const Rect& allocation,
+                                 uint32_t width,
+                                 uint32_t height,
+                                 const uint8_t* IGL_NONNULL data,
+                                 size_t bytesPerRow) const {
+  if (bytesPerRow == 0) {
+    bytesPerRow = static_cast<size_t>(width) * bytesPerPixel_;
+  }
+
+  // Fill the whole allocation, repeating edge pixels into the padding and alignment so filtering
+  // and lower mip levels only ever see this image
+  std::vector<uint8_t> pixels(static_cast<size_t>(allocation.width) * allocation.height *
+                              bytesPerPixel_);
+  for (uint32_t y = 0; y < allocation.height; ++y) {
+    const uint32_t srcY = std::min(y > desc_.padding ? y - desc_.padding : 0u, height - 1u);
+    const uint8_t* srcRow = data + srcY * bytesPerRow;
+    uint8_t* dstRow = pixels.data() + static_cast<size_t>(y) * allocation.width * bytesPerPixel_;
+
+    const uint32_t left = std::min(desc_.padding, allocation.width);
+    const uint32_t right = std::min(left + width, allocation.width);
+    for (uint32_t x = 0; x < left; ++x) {
+      std::memcpy(dstRow + static_cast<size_t>(x) * bytesPerPixel_, srcRow, bytesPerPixel_);
+    }
+    std::memcpy(dstRow + static_cast<size_t>(left) * bytesPerPixel_,
+                srcRow,
+                static_cast<size_t>(right - left) * bytesPerPixel_);
+    const uint8_t* lastPixel = srcRow + static_cast<size_t>(width - 1u) * bytesPerPixel_;
+    for (uint32_t x = right; x < allocation.width; ++x) {
+      std::memcpy(dstRow + static_cast<size_t>(x) * bytesPerPixel_, lastPixel, bytesPerPixel_);
+    }
+  }
+
+  const auto& texture = desc_.useArrayTexture ? pages_.front().texture : pages_[page].texture;
+  const bool isSrgb = desc_.format == igl::TextureFormat::RGBA_SRGB ||
+                      desc_.format == igl::TextureFormat::BGRA_SRGB;
+  std::vector<uint8_t> nextLevel;
+  for (uint32_t mipLevel = 0; mipLevel < desc_.numMipLevels; ++mipLevel) {
+    const uint32_t x = allocation.x >> mipLevel;
+    const uint32_t y = allocation.y >> mipLevel;
+    const uint32_t levelWidth = allocation.width >> mipLevel;
+    const uint32_t levelHeight = allocation.height >> mipLevel;
+    if (mipLevel > 0) {
+      nextLevel.resize(static_cast<size_t>(levelWidth) * levelHeight * bytesPerPixel_);
+      iglu::textureloader::downsampleRgba8(
+          pixels.data(), levelWidth * 2u, levelHeight * 2u, nextLevel.data(), isSrgb);
+      pixels.swap(nextLevel);
+    }
+
+    const auto range =
+        desc_.useArrayTexture
+            ? igl::TextureRangeDesc::new2DArray(x, y, levelWidth, levelHeight, page, 1, mipLevel)
+            : igl::TextureRangeDesc::new2D(x, y, levelWidth, levelHeight, mipLevel);
+    auto result = texture->upload(range, pixels.data());
+    if (!result.isOk()) {
+      return result;
+    }
+  }
+  return igl::Result();
+}
+
+} // namespace iglu::textureatlas
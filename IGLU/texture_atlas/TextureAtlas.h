@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/Texture.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace igl {
+class IDevice;
+} // namespace igl
+
+namespace iglu::textureatlas {
+
+/// Identifies an image packed into a TextureAtlas. 0 is never a valid handle.
+using AtlasHandle = uint32_t;
+
+struct TextureAtlasDesc {
+  igl::TextureFormat format = igl::TextureFormat::RGBA_UNorm8;
+  uint32_t pageWidth = 1024;
+  uint32_t pageHeight = 1024;
+  /// Number of pages. Array atlases allocate all of them up front as layers of one texture.
+  uint32_t maxPages = 4;
+  /// Pixels around each image filled by repeating its edges, so filtering never samples neighbors.
+  uint32_t padding = 2;
+  /// With more than one mip level, images are placed on a grid of 2^(numMipLevels - 1) pixels and
+  /// their mip levels are generated on upload, which requires an RGBA or BGRA 8 bit format.
+  uint32_t numMipLevels = 1;
+  /// Pack into the layers of a single 2D array texture rather than into separate 2D textures, so
+  /// all images can be used with one binding.
+  bool useArrayTexture = true;
+  std::string debugName = "TextureAtlas";
+};
+
+/// Where an image was packed.
+struct AtlasRegion {
+  /// Index of the page: the layer of the array texture, or the texture returned by getTexture()
+  uint32_t page = 0;
+  /// Position and size of the image in pixels, excluding padding
+  uint32_t x = 0;
+  uint32_t y = 0;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  /// Texture coordinates of the image's corners
+  float u0 = 0.0f;
+  float v0 = 0.0f;
+  float u1 = 0.0f;
+  float v1 = 0.0f;
+};
+
+/**
+ * @brief Packs many small images into a few shared textures.
+ *
+ * Images are placed with a skyline packer on each page. Space released by remove() goes to a
+ * per-page free list and is reused, split guillotine style, before the skyline grows. Images are
+ * uploaded into their regions with ITexture::upload() sub-region updates as they are added.
+ */
+class TextureAtlas final {
+ public:
+  TextureAtlas(igl::IDevice& device, TextureAtlasDesc desc);
+
+  /// Packs an image of tightly packed rows, or of rows bytesPerRow apart, and uploads it. Returns 0
+  /// if the image doesn't fit into any page.
+  [[nodiscard]] AtlasHandle add(uint32_t width,
+                                uint32_t height,
+                                const void* IGL_NONNULL data,
+                                size_t bytesPerRow = 0,
+                                igl::Result* IGL_NULLABLE outResult = nullptr);
+  /// Releases the image's space for reuse. Its pixels stay in the texture until overwritten.
+  void remove(AtlasHandle handle);
+
+  [[nodiscard]] const AtlasRegion* IGL_NULLABLE getRegion(AtlasHandle handle) const;
+  /// Returns the texture holding `page`; all pages share one texture for array atlases.
+  [[nodiscard]] std::shared_ptr<igl::ITexture> getTexture(uint32_t page = 0) const;
+
+  [[nodiscard]] uint32_t numPages() const noexcept;
+  [[nodiscard]] size_t numImages() const noexcept;
+
+ private:
+  struct Rect {
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+  };
+
+  struct SkylineNode {
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+  };
+
+  struct Page {
+    std::shared_ptr<igl::ITexture> texture;
+    // Top edge of the packed area, left to right, covering the page width
+    std::vector<SkylineNode> skyline;
+    std::vector<Rect> freeRects;
+  };
+
+  struct Entry {
+    AtlasRegion region;
+    // Includes padding and alignment
+    Rect allocation;
+  };
+
+  [[nodiscard]] bool allocate(uint32_t width, uint32_t height, uint32_t& outPage, Rect& outRect);
+  [[nodiscard]] static bool allocateFromFreeList(Page& page,
+                                                 uint32_t width,
+                                                 uint32_t height,
+                                                 Rect& outRect);
+  [[nodiscard]] bool allocateFromSkyline(Page& page,
+                                         uint32_t width,
+                                         uint32_t height,
+                                         Rect& outRect) const;
+  [[nodiscard]] bool addPage(igl::Result* IGL_NULLABLE outResult);
+  [[nodiscard]] igl::Result upload(uint32_t page,
+                                   const Rect& allocation,
+                                   uint32_t width,
+                                   uint32_t height,
+                                   const uint8_t* IGL_NONNULL data,
+                                   size_t bytesPerRow) const;
+
+  igl::IDevice& device_;
+  TextureAtlasDesc desc_;
+  uint32_t bytesPerPixel_ = 0;
+  // Allocations are aligned to this many pixels so mip levels never straddle two images
+  uint32_t alignment_ = 1;
+  std::vector<Page> pages_;
+  std::unordered_map<AtlasHandle, Entry> entries_;
+  AtlasHandle nextHandle_ = 1;
+};
+
+} // namespace iglu::textureatlas
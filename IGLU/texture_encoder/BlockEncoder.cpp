@@ -0,0 +1,537 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/texture_encoder/BlockEncoder.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IGLU_TEXTURE_ENCODER_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define IGLU_TEXTURE_ENCODER_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace iglu::textureencoder {
+namespace {
+
+constexpr uint32_t kNumPixels = 16;
+
+struct Bounds {
+  std::array<uint8_t, 4> min;
+  std::array<uint8_t, 4> max;
+};
+
+// Per channel minimum and maximum of a block
+Bounds computeBounds(const uint8_t* IGL_NONNULL rgba) {
+  Bounds bounds{};
+#if IGLU_TEXTURE_ENCODER_SSE2
+  __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba));
+  __m128i hi = lo;
+  for (uint32_t row = 1; row < 4; ++row) {
+    const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + 16u * row));
+    lo = _mm_min_epu8(lo, pixels);
+    hi = _mm_max_epu8(hi, pixels);
+  }
+  lo = _mm_min_epu8(lo, _mm_srli_si128(lo, 8));
+  lo = _mm_min_epu8(lo, _mm_srli_si128(lo, 4));
+  hi = _mm_max_epu8(hi, _mm_srli_si128(hi, 8));
+  hi = _mm_max_epu8(hi, _mm_srli_si128(hi, 4));
+  const int32_t minBits = _mm_cvtsi128_si32(lo);
+  const int32_t maxBits = _mm_cvtsi128_si32(hi);
+  std::memcpy(bounds.min.data(), &minBits, 4);
+  std::memcpy(bounds.max.data(), &maxBits, 4);
+#elif IGLU_TEXTURE_ENCODER_NEON
+  uint8x16_t lo = vld1q_u8(rgba);
+  uint8x16_t hi = lo;
+  for (uint32_t row = 1; row < 4; ++row) {
+    const uint8x16_t pixels = vld1q_u8(rgba + 16u * row);
+    lo = vminq_u8(lo, pixels);
+    hi = vmaxq_u8(hi, pixels);
+  }
+  uint8x8_t lo8 = vmin_u8(vget_low_u8(lo), vget_high_u8(lo));
+  uint8x8_t hi8 = vmax_u8(vget_low_u8(hi), vget_high_u8(hi));
+  lo8 = vmin_u8(lo8, vext_u8(lo8, lo8, 4));
+  hi8 = vmax_u8(hi8, vext_u8(hi8, hi8, 4));
+  uint8_t minBytes[8];
+  uint8_t maxBytes[8];
+  vst1_u8(minBytes, lo8);
+  vst1_u8(maxBytes, hi8);
+  std::memcpy(bounds.min.data(), minBytes, 4);
+  std::memcpy(bounds.max.data(), maxBytes, 4);
+#else
+  bounds.min = {255, 255, 255, 255};
+  bounds.max = {0, 0, 0, 0};
+  for (uint32_t i = 0; i < kNumPixels; ++i) {
+    for (uint32_t c = 0; c < 4; ++c) {
+      bounds.min[c] = std::min(bounds.min[c], rgba[4u * i + c]);
+      bounds.max[c] = std::max(bounds.max[c], rgba[4u * i + c]);
+    }
+  }
+#endif
+  return bounds;
+}
+
+uint8_t clampToByte(int32_t value) {
+  return static_cast<uint8_t>(std::clamp(value, 0, 255));
+}
+
+// BC7
+
+constexpr std::array<uint32_t, 16> kBc7Weights4 = {
+    0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+// Writes little endian bit fields, lowest bits first
+class BitWriter {
+ public:
+  explicit BitWriter(uint8_t* IGL_NONNULL out, size_t numBytes) : out_(out) {
+    std::memset(out_, 0, numBytes);
+  }
+
+  void write(uint32_t value, uint32_t numBits) {
+    for (uint32_t i = 0; i < numBits; ++i, ++position_) {
+      out_[position_ / 8u] |= static_cast<uint8_t>(((value >> i) & 1u) << (position_ % 8u));
+    }
+  }
+
+ private:
+  uint8_t* out_;
+  uint32_t position_ = 0;
+};
+
+struct Bc7Mode6Fit {
+  std::array<uint8_t, 4> endpoints[2];
+  uint32_t pBits[2] = {};
+  std::array<uint8_t, kNumPixels> indices{};
+  uint32_t error = std::numeric_limits<uint32_t>::max();
+};
+
+// Quantizes both endpoints to 7 bits plus the given p-bits and picks the closest index per pixel
+Bc7Mode6Fit fitBc7Mode6(const uint8_t* IGL_NONNULL rgba,
+                        const std::array<float, 4> (&endpoints)[2],
+                        uint32_t p0,
+                        uint32_t p1) {
+  Bc7Mode6Fit fit;
+  fit.pBits[0] = p0;
+  fit.pBits[1] = p1;
+
+  std::array<int32_t, 4> colors[2];
+  for (uint32_t e = 0; e < 2; ++e) {
+    for (uint32_t c = 0; c < 4; ++c) {
+      const float value = (endpoints[e][c] - static_cast<float>(fit.pBits[e])) * 0.5f;
+      fit.endpoints[e][c] = static_cast<uint8_t>(std::clamp(std::lround(value), 0l, 127l));
+      colors[e][c] = (fit.endpoints[e][c] << 1) | static_cast<int32_t>(fit.pBits[e]);
+    }
+  }
+
+  std::array<std::array<int32_t, 4>, 16> palette;
+  for (uint32_t i = 0; i < 16; ++i) {
+    const auto w = static_cast<int32_t>(kBc7Weights4[i]);
+    for (uint32_t c = 0; c < 4; ++c) {
+      palette[i][c] = ((64 - w) * colors[0][c] + w * colors[1][c] + 32) >> 6;
+    }
+  }
+
+  fit.error = 0;
+  for (uint32_t p = 0; p < kNumPixels; ++p) {
+    uint32_t bestError = std::numeric_limits<uint32_t>::max();
+    for (uint32_t i = 0; i < 16; ++i) {
+      uint32_t error = 0;
+      for (uint32_t c = 0; c < 4; ++c) {
+        const int32_t d = palette[i][c] - rgba[4u * p + c];
+        error += static_cast<uint32_t>(d * d);
+      }
+      if (error < bestError) {
+        bestError = error;
+        fit.indices[p] = static_cast<uint8_t>(i);
+      }
+    }
+    fit.error += bestError;
+  }
+  return fit;
+}
+
+// ETC2
+
+// Intensity modifiers for the small (a) and large (b) pixel index values
+constexpr int32_t kEtcModifiers[8][2] = {
+    {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+int32_t etcModifier(uint32_t table, uint32_t selector) {
+  // Selectors 0 and 1 add a and b, 2 and 3 subtract them
+  const int32_t modifier = kEtcModifiers[table][selector & 1u];
+  return selector >= 2 ? -modifier : modifier;
+}
+
+bool isInSecondSubblock(uint32_t x, uint32_t y, bool flip) {
+  return flip ? y >= 2 : x >= 2;
+}
+
+// Picks the best modifier table and per pixel selectors for one subblock around `base`
+uint32_t fitEtcSubblock(const uint8_t* IGL_NONNULL rgba,
+                        bool flip,
+                        bool second,
+                        const std::array<int32_t, 3>& base,
+                        uint32_t& outTable,
+                        std::array<uint8_t, kNumPixels>& outSelectors) {
+  uint32_t bestError = std::numeric_limits<uint32_t>::max();
+  std::array<uint8_t, kNumPixels> selectors{};
+  for (uint32_t table = 0; table < 8; ++table) {
+    uint32_t error = 0;
+    for (uint32_t p = 0; p < kNumPixels && error < bestError; ++p) {
+      if (isInSecondSubblock(p % 4u, p / 4u, flip) != second) {
+        continue;
+      }
+      uint32_t bestPixelError = std::numeric_limits<uint32_t>::max();
+      for (uint32_t selector = 0; selector < 4; ++selector) {
+        const int32_t modifier = etcModifier(table, selector);
+        uint32_t pixelError = 0;
+        for (uint32_t c = 0; c < 3; ++c) {
+          const int32_t d = clampToByte(base[c] + modifier) - rgba[4u * p + c];
+          pixelError += static_cast<uint32_t>(d * d);
+        }
+        if (pixelError < bestPixelError) {
+          bestPixelError = pixelError;
+          selectors[p] = static_cast<uint8_t>(selector);
+        }
+      }
+      error += bestPixelError;
+    }
+    if (error < bestError) {
+      bestError = error;
+      outTable = table;
+      for (uint32_t p = 0; p < kNumPixels; ++p) {
+        if (isInSecondSubblock(p % 4u, p / 4u, flip) == second) {
+          outSelectors[p] = selectors[p];
+        }
+      }
+    }
+  }
+  return bestError;
+}
+
+struct EtcFit {
+  bool flip = false;
+  bool differential = false;
+  // Base colors at 4 bits, or at 5 bits for differential blocks
+  std::array<int32_t, 3> colors[2];
+  uint32_t tables[2] = {};
+  std::array<uint8_t, kNumPixels> selectors{};
+  uint32_t error = std::numeric_limits<uint32_t>::max();
+};
+
+// EAC
+
+constexpr int32_t kEacModifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},
+    {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},
+    {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},
+    {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},
+    {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8},
+};
+
+void writeBigEndian(uint64_t bits, uint8_t* IGL_NONNULL outBlock) {
+  for (uint32_t i = 0; i < 8; ++i) {
+    outBlock[i] = static_cast<uint8_t>(bits >> (56u - 8u * i));
+  }
+}
+
+// ETC and EAC number pixels down each column first
+uint32_t etcPixelIndex(uint32_t p) {
+  return (p % 4u) * 4u + p / 4u;
+}
+
+} // namespace
+
+void encodeBc7Block(const uint8_t* IGL_NONNULL rgba, uint8_t* IGL_NONNULL outBlock) noexcept {
+  const Bounds bounds = computeBounds(rgba);
+
+  std::array<float, 4> mean{};
+  for (uint32_t p = 0; p < kNumPixels; ++p) {
+    for (uint32_t c = 0; c < 4; ++c) {
+      mean[c] += static_cast<float>(rgba[4u * p + c]);
+    }
+  }
+  for (auto& m : mean) {
+    m /= static_cast<float>(kNumPixels);
+  }
+
+  // Principal axis by power iteration, starting from the bounding box diagonal
+  float covariance[4][4] = {};
+  for (uint32_t p = 0; p < kNumPixels; ++p) {
+    float d[4];
+    for (uint32_t c = 0; c < 4; ++c) {
+      d[c] = static_cast<float>(rgba[4u * p + c]) - mean[c];
+    }
+    for (uint32_t i = 0; i < 4; ++i) {
+      for (uint32_t j = 0; j < 4; ++j) {
+        covariance[i][j] += d[i] * d[j];
+      }
+    }
+  }
+  std::array<float, 4> axis;
+  for (uint32_t c = 0; c < 4; ++c) {
+    axis[c] = static_cast<float>(bounds.max[c] - bounds.min[c]);
+  }
+  for (uint32_t iteration = 0; iteration < 4; ++iteration) {
+    std::array<float, 4> next{};
+    float maxComponent = 0.0f;
+    for (uint32_t i = 0; i < 4; ++i) {
+      for (uint32_t j = 0; j < 4; ++j) {
+        next[i] += covariance[i][j] * axis[j];
+      }
+      maxComponent = std::max(maxComponent, std::fabs(next[i]));
+    }
+    if (maxComponent == 0.0f) {
+      break;
+    }
+    for (uint32_t c = 0; c < 4; ++c) {
+      axis[c] = next[c] / maxComponent;
+    }
+  }
+
+  // Endpoints are the extreme projections onto the axis
+  std::array<float, 4> endpoints[2] = {mean, mean};
+  const float axisLengthSquared =
+      axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2] + axis[3] * axis[3];
+  if (axisLengthSquared > 0.0f) {
+    float minT = std::numeric_limits<float>::max();
+    float maxT = std::numeric_limits<float>::lowest();
+    for (uint32_t p = 0; p < kNumPixels; ++p) {
+      float t = 0.0f;
+      for (uint32_t c = 0; c < 4; ++c) {
+        t += (static_cast<float>(rgba[4u * p + c]) - mean[c]) * axis[c];
+      }
+      minT = std::min(minT, t);
+      maxT = std::max(maxT, t);
+    }
+    for (uint32_t c = 0; c < 4; ++c) {
+      endpoints[0][c] = std::clamp(mean[c] + axis[c] * minT / axisLengthSquared, 0.0f, 255.0f);
+      endpoints[1][c] = std::clamp(mean[c] + axis[c] * maxT / axisLengthSquared, 0.0f, 255.0f);
+    }
+  }
+
+  Bc7Mode6Fit best;
+  for (uint32_t iteration = 0; iteration < 3 && best.error > 0; ++iteration) {
+    if (iteration > 0) {
+      // Least squares endpoints for the current indices
+      float aa = 0.0f;
+      float ab = 0.0f;
+      float bb = 0.0f;
+      std::array<float, 4> ax{};
+      std::array<float, 4> bx{};
+      for (uint32_t p = 0; p < kNumPixels; ++p) {
+        const float b = static_cast<float>(kBc7Weights4[best.indices[p]]) / 64.0f;
+        const float a = 1.0f - b;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (uint32_t c = 0; c < 4; ++c) {
+          ax[c] += a * static_cast<float>(rgba[4u * p + c]);
+          bx[c] += b * static_cast<float>(rgba[4u * p + c]);
+        }
+      }
+      const float determinant = aa * bb - ab * ab;
+      if (std::fabs(determinant) < 1e-6f) {
+        break;
+      }
+      for (uint32_t c = 0; c < 4; ++c) {
+        endpoints[0][c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+        endpoints[1][c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+      }
+    }
+
+    const uint32_t previousError = best.error;
+    for (uint32_t p0 = 0; p0 < 2; ++p0) {
+      for (uint32_t p1 = 0; p1 < 2; ++p1) {
+        auto fit = fitBc7Mode6(rgba, endpoints, p0, p1);
+        if (fit.error < best.error) {
+          best = fit;
+        }
+      }
+    }
+    if (best.error == previousError) {
+      break;
+    }
+  }
+
+  // The first index is stored without its top bit, so it must be below 8
+  if (best.indices[0] >= 8) {
+    std::swap(best.endpoints[0], best.endpoints[1]);
+    std::swap(best.pBits[0], best.pBits[1]);
+    for (auto& index : best.indices) {
+      index = static_cast<uint8_t>(15u - index);
+    }
+  }
+
+  BitWriter writer(outBlock, 16);
+  writer.write(1u << 6, 7);
+  for (uint32_t c = 0; c < 4; ++c) {
+    writer.write(best.endpoints[0][c], 7);
+    writer.write(best.endpoints[1][c], 7);
+  }
+  writer.write(best.pBits[0], 1);
+  writer.write(best.pBits[1], 1);
+  for (uint32_t p = 0; p < kNumPixels; ++p) {
+    writer.write(best.indices[p], p == 0 ? 3 : 4);
+  }
+}
+
+void encodeEtc2RgbBlock(const uint8_t* IGL_NONNULL rgba, uint8_t* IGL_NONNULL outBlock) noexcept {
+  EtcFit best;
+  for (const bool flip : {false, true}) {
+    std::array<float, 3> averages[2] = {};
+    for (uint32_t p = 0; p < kNumPixels; ++p) {
+      const uint32_t subblock = isInSecondSubblock(p % 4u, p / 4u, flip) ? 1 : 0;
+      for (uint32_t c = 0; c < 3; ++c) {
+        averages[subblock][c] += static_cast<float>(rgba[4u * p + c]) / 8.0f;
+      }
+    }
+
+    for (const bool differential : {false, true}) {
+      EtcFit fit;
+      fit.flip = flip;
+      fit.differential = differential;
+      std::array<int32_t, 3> bases[2];
+      bool isValid = true;
+      for (uint32_t s = 0; s < 2; ++s) {
+        for (uint32_t c = 0; c < 3; ++c) {
+          const int32_t maxValue = differential ? 31 : 15;
+          fit.colors[s][c] = static_cast<int32_t>(
+              std::lround(averages[s][c] * static_cast<float>(maxValue) / 255.0f));
+          bases[s][c] = differential ? (fit.colors[s][c] << 3) | (fit.colors[s][c] >> 2)
+                                     : fit.colors[s][c] * 17;
+        }
+      }
+      if (differential) {
+        // Deltas out of range would select the ETC2 T, H or planar modes
+        for (uint32_t c = 0; c < 3; ++c) {
+          const int32_t delta = fit.colors[1][c] - fit.colors[0][c];
+          isValid = isValid && delta >= -4 && delta <= 3;
+        }
+      }
+      if (!isValid) {
+        continue;
+      }
+
+      fit.error = 0;
+      for (uint32_t s = 0; s < 2; ++s) {
+        fit.error += fitEtcSubblock(rgba, flip, s == 1, bases[s], fit.tables[s], fit.selectors);
+      }
+      if (fit.error < best.error) {
+        best = fit;
+      }
+    }
+  }
+
+  uint64_t bits = 0;
+  if (best.differential) {
+    for (uint32_t c = 0; c < 3; ++c) {
+      const auto delta = static_cast<uint64_t>((best.colors[1][c] - best.colors[0][c]) & 7);
+      bits |= static_cast<uint64_t>(best.colors[0][c]) << (59u - 8u * c);
+      bits |= delta << (56u - 8u * c);
+    }
+    bits |= 1ull << 33;
+  } else {
+    for (uint32_t c = 0; c < 3; ++c) {
+      bits |= static_cast<uint64_t>(best.colors[0][c]) << (60u - 8u * c);
+      bits |= static_cast<uint64_t>(best.colors[1][c]) << (56u - 8u * c);
+    }
+  }
+  bits |= static_cast<uint64_t>(best.tables[0]) << 37;
+  bits |= static_cast<uint64_t>(best.tables[1]) << 34;
+  bits |= static_cast<uint64_t>(best.flip ? 1 : 0) << 32;
+  for (uint32_t p = 0; p < kNumPixels; ++p) {
+    const uint32_t i = etcPixelIndex(p);
+    bits |= static_cast<uint64_t>(best.selectors[p] >> 1) << (16u + i);
+    bits |= static_cast<uint64_t>(best.selectors[p] & 1u) << i;
+  }
+  writeBigEndian(bits, outBlock);
+}
+
+void encodeEacAlphaBlock(const uint8_t* IGL_NONNULL rgba, uint8_t* IGL_NONNULL outBlock) noexcept {
+  const Bounds bounds = computeBounds(rgba);
+  const int32_t minAlpha = bounds.min[3];
+  const int32_t maxAlpha = bounds.max[3];
+
+  uint32_t bestError = std::numeric_limits<uint32_t>::max();
+  int32_t bestBase = minAlpha;
+  uint32_t bestMultiplier = 1;
+  uint32_t bestTable = 0;
+  for (uint32_t table = 0; table < 16 && bestError > 0; ++table) {
+    const int32_t* modifiers = kEacModifiers[table];
+    const int32_t modifierMin = *std::min_element(modifiers, modifiers + 8);
+    const int32_t modifierMax = *std::max_element(modifiers, modifiers + 8);
+    const auto multiplierGuess = std::clamp(
+        static_cast<int32_t>(std::lround(static_cast<float>(maxAlpha - minAlpha) /
+                                         static_cast<float>(modifierMax - modifierMin))),
+        1,
+        15);
+    for (int32_t multiplier = std::max(multiplierGuess - 1, 1);
+         multiplier <= std::min(multiplierGuess + 1, 15);
+         ++multiplier) {
+      const auto baseGuess = static_cast<int32_t>(
+          std::lround(static_cast<float>(minAlpha + maxAlpha) * 0.5f -
+                      static_cast<float>((modifierMin + modifierMax) * multiplier) * 0.5f));
+      for (int32_t base = std::max(baseGuess - 1, 0); base <= std::min(baseGuess + 1, 255);
+           ++base) {
+        uint32_t error = 0;
+        for (uint32_t p = 0; p < kNumPixels && error < bestError; ++p) {
+          uint32_t bestPixelError = std::numeric_limits<uint32_t>::max();
+          for (uint32_t i = 0; i < 8; ++i) {
+            const int32_t d = clampToByte(base + modifiers[i] * multiplier) - rgba[4u * p + 3u];
+            bestPixelError = std::min(bestPixelError, static_cast<uint32_t>(d * d));
+          }
+          error += bestPixelError;
+        }
+        if (error < bestError) {
+          bestError = error;
+          bestBase = base;
+          bestMultiplier = static_cast<uint32_t>(multiplier);
+          bestTable = table;
+        }
+      }
+    }
+  }
+
+  uint64_t bits = static_cast<uint64_t>(bestBase) << 56;
+  bits |= static_cast<uint64_t>(bestMultiplier) << 52;
+  bits |= static_cast<uint64_t>(bestTable) << 48;
+  const auto multiplier = static_cast<int32_t>(bestMultiplier);
+  for (uint32_t p = 0; p < kNumPixels; ++p) {
+    uint32_t bestIndex = 0;
+    uint32_t bestPixelError = std::numeric_limits<uint32_t>::max();
+    for (uint32_t i = 0; i < 8; ++i) {
+      const int32_t d =
+          clampToByte(bestBase + kEacModifiers[bestTable][i] * multiplier) - rgba[4u * p + 3u];
+      if (static_cast<uint32_t>(d * d) < bestPixelError) {
+        bestPixelError = static_cast<uint32_t>(d * d);
+        bestIndex = i;
+      }
+    }
+    bits |= static_cast<uint64_t>(bestIndex) << (45u - 3u * etcPixelIndex(p));
+  }
+  writeBigEndian(bits, outBlock);
+}
+
+} // namespace iglu::textureencoder
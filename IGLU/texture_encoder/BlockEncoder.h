@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <igl/Null.h>
+
+namespace iglu::textureencoder {
+
+/// Encoders for single 4x4 blocks of RGBA8 pixels, stored row by row in 64 bytes. They favor speed
+/// over quality and are meant for content generated at runtime, not for offline asset pipelines.
+
+/// Encodes a 16 byte BC7 block using mode 6: one RGBA line with 4 bit indices.
+void encodeBc7Block(const uint8_t* IGL_NONNULL rgba, uint8_t* IGL_NONNULL outBlock) noexcept;
+
+/// Encodes the 8 byte ETC2 RGB block of a block's color channels. Only the ETC1 compatible
+/// individual and differential modes are used.
+void encodeEtc2RgbBlock(const uint8_t* IGL_NONNULL rgba, uint8_t* IGL_NONNULL outBlock) noexcept;
+
+/// Encodes the 8 byte EAC block of a block's alpha channel, which precedes the ETC2 RGB block in
+/// RGBA8 EAC ETC2 textures.
+void encodeEacAlphaBlock(const uint8_t* IGL_NONNULL rgba, uint8_t* IGL_NONNULL outBlock) noexcept;
+
+} // namespace iglu::textureencoder
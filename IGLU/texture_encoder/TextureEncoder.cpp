@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/texture_encoder/TextureEncoder.h>
+
+#include <IGLU/texture_encoder/BlockEncoder.h>
+#include <IGLU/texture_loader/PixelConversion.h>
+#include <IGLU/texture_loader/WorkerPool.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ktx.h>
+
+namespace iglu::textureencoder {
+namespace {
+
+// Vulkan formats identify the block layout in KTX2 files
+constexpr uint32_t kVkFormatBc7UNorm = 145;
+constexpr uint32_t kVkFormatBc7Srgb = 146;
+constexpr uint32_t kVkFormatEtc2Rgb8UNorm = 147;
+constexpr uint32_t kVkFormatEtc2Rgb8Srgb = 148;
+constexpr uint32_t kVkFormatEtc2Rgba8UNorm = 151;
+constexpr uint32_t kVkFormatEtc2Rgba8Srgb = 152;
+
+uint32_t toVkFormat(igl::TextureFormat format) {
+  switch (format) {
+  case igl::TextureFormat::RGBA_BC7_UNORM_4x4:
+    return kVkFormatBc7UNorm;
+  case igl::TextureFormat::RGBA_BC7_SRGB_4x4:
+    return kVkFormatBc7Srgb;
+  case igl::TextureFormat::RGB8_ETC2:
+    return kVkFormatEtc2Rgb8UNorm;
+  case igl::TextureFormat::SRGB8_ETC2:
+    return kVkFormatEtc2Rgb8Srgb;
+  case igl::TextureFormat::RGBA8_EAC_ETC2:
+    return kVkFormatEtc2Rgba8UNorm;
+  case igl::TextureFormat::SRGB8_A8_EAC_ETC2:
+    return kVkFormatEtc2Rgba8Srgb;
+  default:
+    return 0;
+  }
+}
+
+bool isSrgbFormat(igl::TextureFormat format) {
+  return format == igl::TextureFormat::RGBA_BC7_SRGB_4x4 ||
+         format == igl::TextureFormat::SRGB8_ETC2 ||
+         format == igl::TextureFormat::SRGB8_A8_EAC_ETC2;
+}
+
+} // namespace
+
+bool isSupportedEncoderFormat(igl::TextureFormat format) noexcept {
+  return toVkFormat(format) != 0;
+}
+
+std::vector<uint8_t> encodeImage(const uint8_t* IGL_NONNULL rgba,
+                                 uint32_t width,
+                                 uint32_t height,
+                                 igl::TextureFormat format,
+                                 igl::Result* IGL_NULLABLE outResult) noexcept {
+  if (!isSupportedEncoderFormat(format)) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::Unsupported, "Unsupported texture encoder format.");
+    return {};
+  }
+  if (rgba == nullptr || width == 0 || height == 0) {
+    igl::Result::setResult(outResult, igl::Result::Code::ArgumentInvalid, "Empty image.");
+    return {};
+  }
+
+  const auto properties = igl::TextureFormatProperties::fromTextureFormat(format);
+  const size_t bytesPerBlock = properties.bytesPerBlock;
+  const uint32_t blocksPerRow = (width + 3u) / 4u;
+  const uint32_t blocksPerColumn = (height + 3u) / 4u;
+  std::vector<uint8_t> blocks(bytesPerBlock * blocksPerRow * blocksPerColumn);
+
+  textureloader::WorkerPool::shared().parallelFor(blocksPerColumn, [&](size_t blockY) {
+    uint8_t pixels[16 * 4];
+    for (uint32_t blockX = 0; blockX < blocksPerRow; ++blockX) {
+      for (uint32_t y = 0; y < 4; ++y) {
+        const uint32_t srcY = std::min(static_cast<uint32_t>(blockY) * 4u + y, height - 1u);
+        for (uint32_t x = 0; x < 4; ++x) {
+          const uint32_t srcX = std::min(blockX * 4u + x, width - 1u);
+          std::memcpy(pixels + 4u * (y * 4u + x),
+                      rgba + 4u * (static_cast<size_t>(srcY) * width + srcX),
+                      4);
+        }
+      }
+
+      uint8_t* block = blocks.data() + bytesPerBlock * (blockY * blocksPerRow + blockX);
+      switch (format) {
+      case igl::TextureFormat::RGBA_BC7_UNORM_4x4:
+      case igl::TextureFormat::RGBA_BC7_SRGB_4x4:
+        encodeBc7Block(pixels, block);
+        break;
+      case igl::TextureFormat::RGBA8_EAC_ETC2:
+      case igl::TextureFormat::SRGB8_A8_EAC_ETC2:
+        encodeEacAlphaBlock(pixels, block);
+        encodeEtc2RgbBlock(pixels, block + 8);
+        break;
+      default:
+        encodeEtc2RgbBlock(pixels, block);
+        break;
+      }
+    }
+  });
+
+  igl::Result::setOk(outResult);
+  return blocks;
+}
+
+void writeKtx2(std::ostream& stream,
+               const uint8_t* IGL_NONNULL rgba,
+               uint32_t width,
+               uint32_t height,
+               igl::TextureFormat format,
+               uint32_t numMipLevels,
+               igl::Result* IGL_NULLABLE outResult) noexcept {
+  if (!isSupportedEncoderFormat(format)) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::Unsupported, "Unsupported texture encoder format.");
+    return;
+  }
+  if (rgba == nullptr || width == 0 || height == 0) {
+    igl::Result::setResult(outResult, igl::Result::Code::ArgumentInvalid, "Empty image.");
+    return;
+  }
+
+  auto desc = igl::TextureDesc::new2D(
+      isSrgbFormat(format) ? igl::TextureFormat::RGBA_SRGB : igl::TextureFormat::RGBA_UNorm8,
+      width,
+      height,
+      igl::TextureDesc::TextureUsageBits::Sampled);
+  desc.numMipLevels =
+      std::clamp(numMipLevels, 1u, igl::TextureDesc::calcNumMipLevels(width, height));
+
+  std::unique_ptr<textureloader::IData> mipmaps;
+  const uint8_t* levels = rgba;
+  if (desc.numMipLevels > 1) {
+    mipmaps = textureloader::generateMipmaps(desc, rgba, outResult);
+    if (mipmaps == nullptr) {
+      return;
+    }
+    levels = mipmaps->data();
+  }
+
+  ktxTextureCreateInfo createInfo{};
+  createInfo.vkFormat = toVkFormat(format);
+  createInfo.baseWidth = width;
+  createInfo.baseHeight = height;
+  createInfo.baseDepth = 1;
+  createInfo.numDimensions = 2;
+  createInfo.numLevels = desc.numMipLevels;
+  createInfo.numLayers = 1;
+  createInfo.numFaces = 1;
+  createInfo.isArray = KTX_FALSE;
+  createInfo.generateMipmaps = KTX_FALSE;
+
+  ktxTexture2* texture = nullptr;
+  auto error = ktxTexture2_Create(&createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &texture);
+  if (error != KTX_SUCCESS) {
+    igl::Result::setResult(outResult, igl::Result::Code::RuntimeError, ktxErrorString(error));
+    return;
+  }
+
+  for (uint32_t mipLevel = 0; mipLevel < desc.numMipLevels && error == KTX_SUCCESS; ++mipLevel) {
+    const uint32_t levelWidth = std::max(width >> mipLevel, 1u);
+    const uint32_t levelHeight = std::max(height >> mipLevel, 1u);
+    auto blocks = encodeImage(levels, levelWidth, levelHeight, format, outResult);
+    error = ktxTexture_SetImageFromMemory(
+        ktxTexture(texture), mipLevel, 0, 0, blocks.data(), blocks.size());
+    levels += static_cast<size_t>(levelWidth) * levelHeight * 4u;
+  }
+
+  ktx_uint8_t* file = nullptr;
+  ktx_size_t fileSize = 0;
+  if (error == KTX_SUCCESS) {
+    error = ktxTexture_WriteToMemory(ktxTexture(texture), &file, &fileSize);
+  }
+  ktxTexture_Destroy(ktxTexture(texture));
+  if (error != KTX_SUCCESS) {
+    igl::Result::setResult(outResult, igl::Result::Code::RuntimeError, ktxErrorString(error));
+    return;
+  }
+
+  stream.write(reinterpret_cast<const char*>(file), static_cast<std::streamsize>(fileSize));
+  std::free(file);
+  if (!stream) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::RuntimeError, "Error writing KTX2 file to the stream.");
+    return;
+  }
+  igl::Result::setOk(outResult);
+}
+
+} // namespace iglu::textureencoder
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <igl/Texture.h>
+#include <ostream>
+#include <vector>
+
+namespace iglu::textureencoder {
+
+/// Returns true for the block compressed formats encodeImage() can produce: BC7, ETC2 RGB8 and
+/// RGBA8 EAC ETC2, each in UNorm and sRGB variants.
+[[nodiscard]] bool isSupportedEncoderFormat(igl::TextureFormat format) noexcept;
+
+/// Compresses a tightly packed RGBA8 image, spreading rows of blocks across the shared WorkerPool.
+/// Images whose dimensions aren't multiples of 4 are padded by repeating their last row and column.
+[[nodiscard]] std::vector<uint8_t> encodeImage(const uint8_t* IGL_NONNULL rgba,
+                                               uint32_t width,
+                                               uint32_t height,
+                                               igl::TextureFormat format,
+                                               igl::Result* IGL_NULLABLE outResult) noexcept;
+
+/// Compresses a tightly packed RGBA8 image and `numMipLevels - 1` mip levels generated from it and
+/// writes them as a KTX2 file, which the ktx2 TextureLoaderFactory can load. Fails if `stream` is
+/// left in an error state by the write.
+void writeKtx2(std::ostream& stream,
+               const uint8_t* IGL_NONNULL rgba,
+               uint32_t width,
+               uint32_t height,
+               igl::TextureFormat format,
+               uint32_t numMipLevels,
+               igl::Result* IGL_NULLABLE outResult) noexcept;
+
+} // namespace iglu::textureencoder
@@ -7,6 +7,15 @@
 
 #include <IGLU/texture_loader/IData.h>
 
+#include <fstream>
+#include <limits>
+#if !IGL_PLATFORM_WIN
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // !IGL_PLATFORM_WIN
+
 namespace iglu::textureloader {
 namespace {
 class ByteData final : public IData {
@@ -35,6 +44,37 @@ uint32_t ByteData::length() const noexcept {
   return length_;
 }
 
+#if !IGL_PLATFORM_WIN
+class MappedFileData final : public IData {
+ public:
+  MappedFileData(void* IGL_NONNULL mapping, uint32_t length) noexcept;
+
+  ~MappedFileData() final;
+
+  [[nodiscard]] const uint8_t* IGL_NONNULL data() const noexcept final;
+  [[nodiscard]] uint32_t length() const noexcept final;
+
+ private:
+  void* mapping_ = nullptr;
+  uint32_t length_ = 0;
+};
+
+MappedFileData::MappedFileData(void* IGL_NONNULL mapping, uint32_t length) noexcept :
+  mapping_(mapping), length_(length) {}
+
+MappedFileData::~MappedFileData() {
+  munmap(mapping_, length_);
+}
+
+const uint8_t* IGL_NONNULL MappedFileData::data() const noexcept {
+  return static_cast<const uint8_t*>(mapping_);
+}
+
+uint32_t MappedFileData::length() const noexcept {
+  return length_;
+}
+#endif // !IGL_PLATFORM_WIN
+
 } // namespace
 
 std::unique_ptr<IData> IData::tryCreate(std::unique_ptr<uint8_t[]> data,
@@ -53,4 +93,62 @@ std::unique_ptr<IData> IData::tryCreate(std::unique_ptr<uint8_t[]> data,
   return std::make_unique<ByteData>(std::move(data), length);
 }
 
+std::unique_ptr<IData> IData::tryCreateFromFile(const std::string& path,
+                                                igl::Result* IGL_NULLABLE outResult) {
+#if IGL_PLATFORM_WIN
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    igl::Result::setResult(outResult, igl::Result::Code::RuntimeError, "Can't open file.");
+    return nullptr;
+  }
+  const std::streamoff fileLength = file.tellg();
+  if (fileLength <= 0 || fileLength > std::numeric_limits<uint32_t>::max()) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::ArgumentOutOfRange, "Unsupported file length.");
+    return nullptr;
+  }
+  const auto length = static_cast<uint32_t>(fileLength);
+  auto data = std::make_unique<uint8_t[]>(length);
+  file.seekg(0, std::ios::beg);
+  if (!file.read(reinterpret_cast<char*>(data.get()), length)) {
+    igl::Result::setResult(outResult, igl::Result::Code::RuntimeError, "Can't read file.");
+    return nullptr;
+  }
+  return tryCreate(std::move(data), length, outResult);
+#else
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    igl::Result::setResult(outResult, igl::Result::Code::RuntimeError, "Can't open file.");
+    return nullptr;
+  }
+
+  struct stat fileStat = {};
+  if (fstat(fd, &fileStat) != 0) {
+    close(fd);
+    igl::Result::setResult(outResult, igl::Result::Code::RuntimeError, "Can't stat file.");
+    return nullptr;
+  }
+  if (fileStat.st_size <= 0 || fileStat.st_size > std::numeric_limits<uint32_t>::max()) {
+    close(fd);
+    igl::Result::setResult(
+        outResult, igl::Result::Code::ArgumentOutOfRange, "Unsupported file length.");
+    return nullptr;
+  }
+  const auto length = static_cast<uint32_t>(fileStat.st_size);
+
+  void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the descriptor is closed
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    igl::Result::setResult(outResult, igl::Result::Code::RuntimeError, "Can't map file.");
+    return nullptr;
+  }
+  // Texture data is mostly read front to back exactly once
+  madvise(mapping, length, MADV_SEQUENTIAL);
+
+  igl::Result::setOk(outResult);
+  return std::make_unique<MappedFileData>(mapping, length);
+#endif // IGL_PLATFORM_WIN
+}
+
 } // namespace iglu::textureloader
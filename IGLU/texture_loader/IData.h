@@ -9,6 +9,7 @@
 
 #include <igl/Common.h>
 #include <memory>
+#include <string>
 
 namespace iglu::textureloader {
 
@@ -24,6 +25,12 @@ class IData {
                                           uint32_t length,
                                           igl::Result* IGL_NULLABLE outResult);
 
+  /// Creates an IData backed by a read-only memory mapping of the file at `path`. Pages are only
+  /// read when accessed, so loaders that use the data in place never hold a second copy of the
+  /// file. Falls back to reading the whole file on platforms without mmap.
+  static std::unique_ptr<IData> tryCreateFromFile(const std::string& path,
+                                                  igl::Result* IGL_NULLABLE outResult);
+
   [[nodiscard]] virtual const uint8_t* IGL_NONNULL data() const noexcept = 0;
   [[nodiscard]] virtual uint32_t length() const noexcept = 0;
 };
@@ -18,6 +18,8 @@ class IDevice;
 
 namespace iglu::textureloader {
 
+class ITextureLoaderFactory;
+
 /// Interface for getting CPU access to GPU texture data
 class ITextureLoader {
  protected:
@@ -94,6 +96,8 @@ class ITextureLoader {
   }
 
  private:
+  friend class ITextureLoaderFactory;
+
   void defaultUpload(igl::ITexture& texture, igl::Result* IGL_NULLABLE outResult) const noexcept;
   [[nodiscard]] std::unique_ptr<IData> defaultLoad(
       igl::Result* IGL_NULLABLE outResult) const noexcept;
@@ -103,6 +107,8 @@ class ITextureLoader {
 
   igl::TextureDesc desc_;
   DataReader reader_;
+  // Set when the loader was created from an IData; keeps the memory reader_ points to alive
+  std::unique_ptr<IData> ownedData_;
 };
 
 } // namespace iglu::textureloader
@@ -73,4 +73,44 @@ std::unique_ptr<ITextureLoader> ITextureLoaderFactory::tryCreate(DataReader read
   return tryCreateInternal(reader, preferredFormat, outResult);
 }
 
+std::unique_ptr<ITextureLoader> ITextureLoaderFactory::tryCreate(std::unique_ptr<IData> data,
+                                                                 igl::Result* IGL_NULLABLE
+                                                                     outResult) const noexcept {
+  return tryCreate(std::move(data), igl::TextureFormat::Invalid, outResult);
+}
+
+std::unique_ptr<ITextureLoader> ITextureLoaderFactory::tryCreate(std::unique_ptr<IData> data,
+                                                                 igl::TextureFormat preferredFormat,
+                                                                 igl::Result* IGL_NULLABLE
+                                                                     outResult) const noexcept {
+  if (data == nullptr) {
+    igl::Result::setResult(outResult, igl::Result::Code::ArgumentNull, "data is nullptr.");
+    return nullptr;
+  }
+
+  auto loader = tryCreate(data->data(), data->length(), preferredFormat, outResult);
+  if (loader) {
+    loader->ownedData_ = std::move(data);
+  }
+  return loader;
+}
+
+std::unique_ptr<ITextureLoader> ITextureLoaderFactory::tryCreateFromFile(
+    const std::string& path,
+    igl::Result* IGL_NULLABLE outResult) const noexcept {
+  return tryCreateFromFile(path, igl::TextureFormat::Invalid, outResult);
+}
+
+std::unique_ptr<ITextureLoader> ITextureLoaderFactory::tryCreateFromFile(
+    const std::string& path,
+    igl::TextureFormat preferredFormat,
+    igl::Result* IGL_NULLABLE outResult) const noexcept {
+  auto data = IData::tryCreateFromFile(path, outResult);
+  if (!data) {
+    return nullptr;
+  }
+
+  return tryCreate(std::move(data), preferredFormat, outResult);
+}
+
 } // namespace iglu::textureloader
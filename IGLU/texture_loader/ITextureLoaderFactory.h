@@ -10,6 +10,7 @@
 #include <IGLU/texture_loader/DataReader.h>
 #include <IGLU/texture_loader/ITextureLoader.h>
 #include <igl/DeviceFeatures.h>
+#include <string>
 
 namespace iglu::textureloader {
 
@@ -45,6 +46,25 @@ class ITextureLoaderFactory {
                                                           igl::Result* IGL_NULLABLE
                                                               outResult) const noexcept;
 
+  /// Creates a loader that takes ownership of `data`.
+  [[nodiscard]] std::unique_ptr<ITextureLoader> tryCreate(std::unique_ptr<IData> data,
+                                                          igl::Result* IGL_NULLABLE
+                                                              outResult) const noexcept;
+  [[nodiscard]] std::unique_ptr<ITextureLoader> tryCreate(std::unique_ptr<IData> data,
+                                                          igl::TextureFormat preferredFormat,
+                                                          igl::Result* IGL_NULLABLE
+                                                              outResult) const noexcept;
+
+  /// Creates a loader for the file at `path`. The file is memory mapped, so loaders that upload
+  /// from the source data (e.g. uncompressed KTX) read it straight from the mapped pages.
+  [[nodiscard]] std::unique_ptr<ITextureLoader> tryCreateFromFile(const std::string& path,
+                                                                  igl::Result* IGL_NULLABLE
+                                                                      outResult) const noexcept;
+  [[nodiscard]] std::unique_ptr<ITextureLoader> tryCreateFromFile(
+      const std::string& path,
+      igl::TextureFormat preferredFormat,
+      igl::Result* IGL_NULLABLE outResult) const noexcept;
+
  protected:
   [[nodiscard]] virtual bool canCreateInternal(DataReader headerReader,
                                                igl::Result* IGL_NULLABLE
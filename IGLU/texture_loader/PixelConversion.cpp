@@ -0,0 +1,500 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/texture_loader/PixelConversion.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IGLU_PIXEL_CONVERSION_SSE2 1
+#include <emmintrin.h>
+#if defined(__SSSE3__)
+#define IGLU_PIXEL_CONVERSION_SSSE3 1
+#include <tmmintrin.h>
+#endif
+#elif defined(__ARM_NEON)
+#define IGLU_PIXEL_CONVERSION_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace iglu::textureloader {
+namespace {
+
+const std::array<float, 256>& srgbToLinearTable() {
+  static const std::array<float, 256> kTable = []() {
+    std::array<float, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+      const float c = static_cast<float>(i) / 255.0f;
+      table[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    }
+    return table;
+  }();
+  return kTable;
+}
+
+uint8_t linearToSrgb(float c) {
+  c = std::clamp(c, 0.0f, 1.0f);
+  const float s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+  return static_cast<uint8_t>(s * 255.0f + 0.5f);
+}
+
+// Exactly rounded c * a / 255
+uint8_t multiplyUNorm8(uint32_t c, uint32_t a) {
+  const uint32_t t = c * a + 128u;
+  return static_cast<uint8_t>((t + (t >> 8u)) >> 8u);
+}
+
+uint16_t floatToHalf(float value) {
+  uint32_t x = 0;
+  std::memcpy(&x, &value, sizeof(x));
+  const uint32_t sign = x & 0x80000000u;
+  x ^= sign;
+
+  uint32_t half = 0;
+  if (x >= 0x47800000u) {
+    // Overflows to infinity, or NaN
+    half = x > 0x7f800000u ? 0x7e00u : 0x7c00u;
+  } else if (x < 0x38800000u) {
+    // Subnormal or zero: let the FPU round by adding a magic number that aligns the mantissa
+    constexpr uint32_t kSubnormalMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23u;
+    float f = 0.0f;
+    std::memcpy(&f, &x, sizeof(f));
+    float magic = 0.0f;
+    std::memcpy(&magic, &kSubnormalMagic, sizeof(magic));
+    f += magic;
+    std::memcpy(&x, &f, sizeof(x));
+    half = x - kSubnormalMagic;
+  } else {
+    // Rebias the exponent and round the mantissa to nearest even
+    const uint32_t mantissaOdd = (x >> 13u) & 1u;
+    x += 0xfffu - ((127u - 15u) << 23u);
+    x += mantissaOdd;
+    half = x >> 13u;
+  }
+  return static_cast<uint16_t>(half | (sign >> 16u));
+}
+
+void downsampleRowRgba8(const uint8_t* row0,
+                        const uint8_t* row1,
+                        uint32_t srcWidth,
+                        uint8_t* dst,
+                        uint32_t dstBegin,
+                        uint32_t dstEnd) {
+  for (uint32_t x = dstBegin; x < dstEnd; ++x) {
+    const uint32_t x0 = 2u * x * 4u;
+    const uint32_t x1 = std::min(2u * x + 1u, srcWidth - 1u) * 4u;
+    for (uint32_t c = 0; c < 4u; ++c) {
+      const uint32_t sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+      dst[x * 4u + c] = static_cast<uint8_t>((sum + 2u) >> 2u);
+    }
+  }
+}
+
+void downsampleRowRgbaF32(const float* row0,
+                          const float* row1,
+                          uint32_t srcWidth,
+                          float* dst,
+                          uint32_t dstBegin,
+                          uint32_t dstEnd) {
+  for (uint32_t x = dstBegin; x < dstEnd; ++x) {
+    const uint32_t x0 = 2u * x * 4u;
+    const uint32_t x1 = std::min(2u * x + 1u, srcWidth - 1u) * 4u;
+    for (uint32_t c = 0; c < 4u; ++c) {
+      dst[x * 4u + c] = ((row0[x0 + c] + row0[x1 + c]) + (row1[x0 + c] + row1[x1 + c])) * 0.25f;
+    }
+  }
+}
+
+} // namespace
+
+namespace scalar {
+
+void expandRgb8ToRgba8(const uint8_t* IGL_NONNULL src,
+                       uint8_t* IGL_NONNULL dst,
+                       size_t numPixels) noexcept {
+  for (size_t i = 0; i < numPixels; ++i) {
+    dst[4 * i + 0] = src[3 * i + 0];
+    dst[4 * i + 1] = src[3 * i + 1];
+    dst[4 * i + 2] = src[3 * i + 2];
+    dst[4 * i + 3] = 0xFF;
+  }
+}
+
+void convertFloatToHalf(const float* IGL_NONNULL src,
+                        uint16_t* IGL_NONNULL dst,
+                        size_t count) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = floatToHalf(src[i]);
+  }
+}
+
+void premultiplyAlphaRgba8(uint8_t* IGL_NONNULL pixels, size_t numPixels, bool isSrgb) noexcept {
+  if (isSrgb) {
+    const auto& toLinear = srgbToLinearTable();
+    for (size_t i = 0; i < numPixels; ++i) {
+      uint8_t* pixel = pixels + 4 * i;
+      const float alpha = static_cast<float>(pixel[3]) / 255.0f;
+      for (size_t c = 0; c < 3; ++c) {
+        pixel[c] = linearToSrgb(toLinear[pixel[c]] * alpha);
+      }
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < numPixels; ++i) {
+    uint8_t* pixel = pixels + 4 * i;
+    pixel[0] = multiplyUNorm8(pixel[0], pixel[3]);
+    pixel[1] = multiplyUNorm8(pixel[1], pixel[3]);
+    pixel[2] = multiplyUNorm8(pixel[2], pixel[3]);
+  }
+}
+
+void premultiplyAlphaRgbaF32(float* IGL_NONNULL pixels, size_t numPixels) noexcept {
+  for (size_t i = 0; i < numPixels; ++i) {
+    float* pixel = pixels + 4 * i;
+    pixel[0] *= pixel[3];
+    pixel[1] *= pixel[3];
+    pixel[2] *= pixel[3];
+  }
+}
+
+void downsampleRgba8(const uint8_t* IGL_NONNULL src,
+                     uint32_t srcWidth,
+                     uint32_t srcHeight,
+                     uint8_t* IGL_NONNULL dst,
+                     bool isSrgb) noexcept {
+  const uint32_t dstWidth = std::max(srcWidth / 2u, 1u);
+  const uint32_t dstHeight = std::max(srcHeight / 2u, 1u);
+  const auto& toLinear = srgbToLinearTable();
+
+  for (uint32_t y = 0; y < dstHeight; ++y) {
+    const uint8_t* row0 = src + static_cast<size_t>(2u * y) * srcWidth * 4u;
+    const uint8_t* row1 =
+        src + static_cast<size_t>(std::min(2u * y + 1u, srcHeight - 1u)) * srcWidth * 4u;
+    uint8_t* dstRow = dst + static_cast<size_t>(y) * dstWidth * 4u;
+    if (!isSrgb) {
+      downsampleRowRgba8(row0, row1, srcWidth, dstRow, 0, dstWidth);
+      continue;
+    }
+    for (uint32_t x = 0; x < dstWidth; ++x) {
+      const uint32_t x0 = 2u * x * 4u;
+      const uint32_t x1 = std::min(2u * x + 1u, srcWidth - 1u) * 4u;
+      for (uint32_t c = 0; c < 3u; ++c) {
+        const float sum = (toLinear[row0[x0 + c]] + toLinear[row0[x1 + c]]) +
+                          (toLinear[row1[x0 + c]] + toLinear[row1[x1 + c]]);
+        dstRow[x * 4u + c] = linearToSrgb(sum * 0.25f);
+      }
+      const uint32_t alpha = row0[x0 + 3] + row0[x1 + 3] + row1[x0 + 3] + row1[x1 + 3];
+      dstRow[x * 4u + 3] = static_cast<uint8_t>((alpha + 2u) >> 2u);
+    }
+  }
+}
+
+void downsampleRgbaF32(const float* IGL_NONNULL src,
+                       uint32_t srcWidth,
+                       uint32_t srcHeight,
+                       float* IGL_NONNULL dst) noexcept {
+  const uint32_t dstWidth = std::max(srcWidth / 2u, 1u);
+  const uint32_t dstHeight = std::max(srcHeight / 2u, 1u);
+  for (uint32_t y = 0; y < dstHeight; ++y) {
+    const float* row0 = src + static_cast<size_t>(2u * y) * srcWidth * 4u;
+    const float* row1 =
+        src + static_cast<size_t>(std::min(2u * y + 1u, srcHeight - 1u)) * srcWidth * 4u;
+    downsampleRowRgbaF32(
+        row0, row1, srcWidth, dst + static_cast<size_t>(y) * dstWidth * 4u, 0, dstWidth);
+  }
+}
+
+} // namespace scalar
+
+void expandRgb8ToRgba8(const uint8_t* IGL_NONNULL src,
+                       uint8_t* IGL_NONNULL dst,
+                       size_t numPixels) noexcept {
+  size_t i = 0;
+#if IGLU_PIXEL_CONVERSION_SSSE3
+  // Each iteration reads 16 bytes but only consumes 4 pixels, so stop 6 pixels before the end
+  const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+  for (; i + 6 <= numPixels; i += 4) {
+    const __m128i rgb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * i));
+    const __m128i rgba = _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), rgba);
+  }
+#elif IGLU_PIXEL_CONVERSION_NEON
+  for (; i + 8 <= numPixels; i += 8) {
+    const uint8x8x3_t rgb = vld3_u8(src + 3 * i);
+    const uint8x8x4_t rgba = {{rgb.val[0], rgb.val[1], rgb.val[2], vdup_n_u8(0xFF)}};
+    vst4_u8(dst + 4 * i, rgba);
+  }
+#endif
+  scalar::expandRgb8ToRgba8(src + 3 * i, dst + 4 * i, numPixels - i);
+}
+
+void convertFloatToHalf(const float* IGL_NONNULL src,
+                        uint16_t* IGL_NONNULL dst,
+                        size_t count) noexcept {
+  size_t i = 0;
+#if IGLU_PIXEL_CONVERSION_SSE2
+  // Branchless version of floatToHalf() on 8 values at a time
+  const __m128 signMask = _mm_set1_ps(-0.0f);
+  const __m128i f16Max = _mm_set1_epi32((127 + 16) << 23);
+  const __m128i nanBit = _mm_set1_epi32(0x200);
+  const __m128i infinity = _mm_set1_epi32(0x7c00);
+  const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+  const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+  const __m128i normalBias = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+
+  auto convert = [&](__m128 f) {
+    const __m128 sign = _mm_and_ps(f, signMask);
+    const __m128 absF = _mm_xor_ps(f, sign);
+    const __m128i absI = _mm_castps_si128(absF);
+    const __m128i isRegular = _mm_cmpgt_epi32(f16Max, absI);
+    const __m128i infOrNan =
+        _mm_or_si128(_mm_and_si128(_mm_castps_si128(_mm_cmpunord_ps(absF, absF)), nanBit),
+                     infinity);
+    const __m128i isSubnormal = _mm_cmpgt_epi32(minNormal, absI);
+
+    const __m128i subnormal = _mm_sub_epi32(
+        _mm_castps_si128(_mm_add_ps(absF, _mm_castsi128_ps(subnormalMagic))), subnormalMagic);
+
+    const __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absI, 31 - 13), 31);
+    const __m128i normal =
+        _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absI, normalBias), mantissaOdd), 13);
+
+    const __m128i finite = _mm_or_si128(_mm_and_si128(subnormal, isSubnormal),
+                                        _mm_andnot_si128(isSubnormal, normal));
+    const __m128i joined =
+        _mm_or_si128(_mm_and_si128(finite, isRegular), _mm_andnot_si128(isRegular, infOrNan));
+    // The sign lands in bit 15; the bits above it are sign extended so packing is lossless
+    return _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+  };
+
+  for (; i + 8 <= count; i += 8) {
+    const __m128i lo = convert(_mm_loadu_ps(src + i));
+    const __m128i hi = convert(_mm_loadu_ps(src + i + 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(lo, hi));
+  }
+#elif IGLU_PIXEL_CONVERSION_NEON && defined(__aarch64__)
+  for (; i + 4 <= count; i += 4) {
+    const float16x4_t half = vcvt_f16_f32(vld1q_f32(src + i));
+    vst1_u16(dst + i, vreinterpret_u16_f16(half));
+  }
+#endif
+  scalar::convertFloatToHalf(src + i, dst + i, count - i);
+}
+
+void premultiplyAlphaRgba8(uint8_t* IGL_NONNULL pixels, size_t numPixels, bool isSrgb) noexcept {
+  if (isSrgb) {
+    // Needs a per-channel transfer function; not worth vectorizing
+    scalar::premultiplyAlphaRgba8(pixels, numPixels, isSrgb);
+    return;
+  }
+
+  size_t i = 0;
+#if IGLU_PIXEL_CONVERSION_SSE2
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i colorMask = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+  const __m128i opaque = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+  const __m128i half = _mm_set1_epi16(128);
+
+  auto multiply = [&](__m128i rgba) {
+    // Broadcast alpha over its pixel, but multiply alpha itself by 255 to keep it unchanged
+    __m128i alpha = _mm_shufflelo_epi16(rgba, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_or_si128(_mm_and_si128(alpha, colorMask), opaque);
+    const __m128i t = _mm_add_epi16(_mm_mullo_epi16(rgba, alpha), half);
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+  };
+
+  for (; i + 4 <= numPixels; i += 4) {
+    auto* p = reinterpret_cast<__m128i*>(pixels + 4 * i);
+    const __m128i rgba = _mm_loadu_si128(p);
+    const __m128i lo = multiply(_mm_unpacklo_epi8(rgba, zero));
+    const __m128i hi = multiply(_mm_unpackhi_epi8(rgba, zero));
+    _mm_storeu_si128(p, _mm_packus_epi16(lo, hi));
+  }
+#elif IGLU_PIXEL_CONVERSION_NEON
+  auto multiply = [](uint8x8_t c, uint8x8_t a) {
+    const uint16x8_t t = vaddq_u16(vmull_u8(c, a), vdupq_n_u16(128));
+    return vaddhn_u16(t, vshrq_n_u16(t, 8));
+  };
+  for (; i + 8 <= numPixels; i += 8) {
+    uint8x8x4_t rgba = vld4_u8(pixels + 4 * i);
+    rgba.val[0] = multiply(rgba.val[0], rgba.val[3]);
+    rgba.val[1] = multiply(rgba.val[1], rgba.val[3]);
+    rgba.val[2] = multiply(rgba.val[2], rgba.val[3]);
+    vst4_u8(pixels + 4 * i, rgba);
+  }
+#endif
+  scalar::premultiplyAlphaRgba8(pixels + 4 * i, numPixels - i, false);
+}
+
+void premultiplyAlphaRgbaF32(float* IGL_NONNULL pixels, size_t numPixels) noexcept {
+  size_t i = 0;
+#if IGLU_PIXEL_CONVERSION_SSE2
+  const __m128 alphaOne = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+  const __m128 colorMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+  for (; i < numPixels; ++i) {
+    float* p = pixels + 4 * i;
+    const __m128 rgba = _mm_loadu_ps(p);
+    const __m128 alpha = _mm_shuffle_ps(rgba, rgba, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128 factor = _mm_or_ps(_mm_and_ps(alpha, colorMask), alphaOne);
+    _mm_storeu_ps(p, _mm_mul_ps(rgba, factor));
+  }
+#elif IGLU_PIXEL_CONVERSION_NEON
+  for (; i < numPixels; ++i) {
+    float* p = pixels + 4 * i;
+    const float32x4_t rgba = vld1q_f32(p);
+    const float32x4_t product = vmulq_n_f32(rgba, vgetq_lane_f32(rgba, 3));
+    vst1q_f32(p, vsetq_lane_f32(vgetq_lane_f32(rgba, 3), product, 3));
+  }
+#endif
+  scalar::premultiplyAlphaRgbaF32(pixels + 4 * i, numPixels - i);
+}
+
+void downsampleRgba8(const uint8_t* IGL_NONNULL src,
+                     uint32_t srcWidth,
+                     uint32_t srcHeight,
+                     uint8_t* IGL_NONNULL dst,
+                     bool isSrgb) noexcept {
+  if (isSrgb) {
+    scalar::downsampleRgba8(src, srcWidth, srcHeight, dst, isSrgb);
+    return;
+  }
+
+  const uint32_t dstWidth = std::max(srcWidth / 2u, 1u);
+  const uint32_t dstHeight = std::max(srcHeight / 2u, 1u);
+  for (uint32_t y = 0; y < dstHeight; ++y) {
+    const uint8_t* row0 = src + static_cast<size_t>(2u * y) * srcWidth * 4u;
+    const uint8_t* row1 =
+        src + static_cast<size_t>(std::min(2u * y + 1u, srcHeight - 1u)) * srcWidth * 4u;
+    uint8_t* dstRow = dst + static_cast<size_t>(y) * dstWidth * 4u;
+
+    // Destination pixels are vectorized in pairs whose source footprint is inside the image
+    uint32_t x = 0;
+#if IGLU_PIXEL_CONVERSION_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+    for (; x < 2u * (srcWidth / 4u); x += 2) {
+      // 4 source pixels from each row make 2 destination pixels
+      const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + 8u * x));
+      const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + 8u * x));
+      const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+      const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+      const __m128i sum = _mm_unpacklo_epi64(_mm_add_epi16(lo, _mm_srli_si128(lo, 8)),
+                                             _mm_add_epi16(hi, _mm_srli_si128(hi, 8)));
+      const __m128i average = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(dstRow + 4u * x),
+                       _mm_packus_epi16(average, average));
+    }
+#elif IGLU_PIXEL_CONVERSION_NEON
+    for (; x < 2u * (srcWidth / 4u); x += 2) {
+      const uint8x16_t a = vld1q_u8(row0 + 8u * x);
+      const uint8x16_t b = vld1q_u8(row1 + 8u * x);
+      const uint16x8_t lo = vaddl_u8(vget_low_u8(a), vget_low_u8(b));
+      const uint16x8_t hi = vaddl_u8(vget_high_u8(a), vget_high_u8(b));
+      const uint16x8_t sum = vcombine_u16(vadd_u16(vget_low_u16(lo), vget_high_u16(lo)),
+                                          vadd_u16(vget_low_u16(hi), vget_high_u16(hi)));
+      vst1_u8(dstRow + 4u * x, vrshrn_n_u16(sum, 2));
+    }
+#endif
+    downsampleRowRgba8(row0, row1, srcWidth, dstRow, x, dstWidth);
+  }
+}
+
+void downsampleRgbaF32(const float* IGL_NONNULL src,
+                       uint32_t srcWidth,
+                       uint32_t srcHeight,
+                       float* IGL_NONNULL dst) noexcept {
+  const uint32_t dstWidth = std::max(srcWidth / 2u, 1u);
+  const uint32_t dstHeight = std::max(srcHeight / 2u, 1u);
+  for (uint32_t y = 0; y < dstHeight; ++y) {
+    const float* row0 = src + static_cast<size_t>(2u * y) * srcWidth * 4u;
+    const float* row1 =
+        src + static_cast<size_t>(std::min(2u * y + 1u, srcHeight - 1u)) * srcWidth * 4u;
+    float* dstRow = dst + static_cast<size_t>(y) * dstWidth * 4u;
+
+    uint32_t x = 0;
+#if IGLU_PIXEL_CONVERSION_SSE2
+    const __m128 quarter = _mm_set1_ps(0.25f);
+    for (; x < srcWidth / 2u; ++x) {
+      const __m128 top = _mm_add_ps(_mm_loadu_ps(row0 + 8u * x), _mm_loadu_ps(row0 + 8u * x + 4u));
+      const __m128 bottom =
+          _mm_add_ps(_mm_loadu_ps(row1 + 8u * x), _mm_loadu_ps(row1 + 8u * x + 4u));
+      _mm_storeu_ps(dstRow + 4u * x, _mm_mul_ps(_mm_add_ps(top, bottom), quarter));
+    }
+#elif IGLU_PIXEL_CONVERSION_NEON
+    for (; x < srcWidth / 2u; ++x) {
+      const float32x4_t top = vaddq_f32(vld1q_f32(row0 + 8u * x), vld1q_f32(row0 + 8u * x + 4u));
+      const float32x4_t bottom =
+          vaddq_f32(vld1q_f32(row1 + 8u * x), vld1q_f32(row1 + 8u * x + 4u));
+      vst1q_f32(dstRow + 4u * x, vmulq_n_f32(vaddq_f32(top, bottom), 0.25f));
+    }
+#endif
+    downsampleRowRgbaF32(row0, row1, srcWidth, dstRow, x, dstWidth);
+  }
+}
+
+std::unique_ptr<IData> generateMipmaps(const igl::TextureDesc& desc,
+                                       const uint8_t* IGL_NONNULL baseLevel,
+                                       igl::Result* IGL_NULLABLE outResult) noexcept {
+  const bool isFloat = desc.format == igl::TextureFormat::RGBA_F32;
+  const bool isSrgb =
+      desc.format == igl::TextureFormat::RGBA_SRGB || desc.format == igl::TextureFormat::BGRA_SRGB;
+  if (!isFloat && !isSrgb && desc.format != igl::TextureFormat::RGBA_UNorm8 &&
+      desc.format != igl::TextureFormat::BGRA_UNorm8) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::Unsupported, "Unsupported format for CPU mipmaps.");
+    return nullptr;
+  }
+  if (desc.type != igl::TextureType::TwoD || desc.numMipLevels == 0 ||
+      desc.numMipLevels > igl::TextureDesc::calcNumMipLevels(desc.width, desc.height)) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::ArgumentInvalid, "Invalid texture for CPU mipmaps.");
+    return nullptr;
+  }
+
+  const size_t bytesPerPixel = isFloat ? 16u : 4u;
+  size_t length = 0;
+  for (uint32_t level = 0; level < desc.numMipLevels; ++level) {
+    length += std::max<size_t>(desc.width >> level, 1u) *
+              std::max<size_t>(desc.height >> level, 1u) * bytesPerPixel;
+  }
+  if (length > std::numeric_limits<uint32_t>::max()) {
+    igl::Result::setResult(outResult, igl::Result::Code::ArgumentOutOfRange, "Image is too large.");
+    return nullptr;
+  }
+
+  auto data = std::make_unique<uint8_t[]>(length);
+  const size_t baseLength = desc.width * desc.height * bytesPerPixel;
+  std::memcpy(data.get(), baseLevel, baseLength);
+
+  uint8_t* src = data.get();
+  auto width = static_cast<uint32_t>(desc.width);
+  auto height = static_cast<uint32_t>(desc.height);
+  for (uint32_t level = 1; level < desc.numMipLevels; ++level) {
+    uint8_t* dst = src + static_cast<size_t>(width) * height * bytesPerPixel;
+    if (isFloat) {
+      downsampleRgbaF32(
+          reinterpret_cast<const float*>(src), width, height, reinterpret_cast<float*>(dst));
+    } else {
+      // BGRA only swaps color channels, which are filtered identically
+      downsampleRgba8(src, width, height, dst, isSrgb);
+    }
+    src = dst;
+    width = std::max(width / 2u, 1u);
+    height = std::max(height / 2u, 1u);
+  }
+
+  return IData::tryCreate(std::move(data), static_cast<uint32_t>(length), outResult);
+}
+
+} // namespace iglu::textureloader
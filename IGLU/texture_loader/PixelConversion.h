@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <IGLU/texture_loader/IData.h>
+#include <cstddef>
+#include <cstdint>
+#include <igl/Texture.h>
+#include <memory>
+
+namespace iglu::textureloader {
+
+/// CPU-side pixel conversion and mip generation used when preparing texture data for upload.
+/// Functions are vectorized with SSE2/SSSE3 or NEON when available and produce bit-identical
+/// results to the scalar implementations below, which handle remainders and serve as a reference
+/// for tests and benchmarks.
+
+/// Expands tightly packed RGB8 pixels to RGBA8 with opaque alpha. `src` and `dst` must not overlap.
+void expandRgb8ToRgba8(const uint8_t* IGL_NONNULL src,
+                       uint8_t* IGL_NONNULL dst,
+                       size_t numPixels) noexcept;
+
+/// Converts floats to IEEE 754 half floats, rounding to nearest even.
+void convertFloatToHalf(const float* IGL_NONNULL src,
+                        uint16_t* IGL_NONNULL dst,
+                        size_t count) noexcept;
+
+/// Multiplies the color channels of RGBA8 pixels by alpha in place. sRGB encoded colors are
+/// linearized before being multiplied.
+void premultiplyAlphaRgba8(uint8_t* IGL_NONNULL pixels, size_t numPixels, bool isSrgb) noexcept;
+
+/// Multiplies the color channels of RGBA32F pixels by alpha in place.
+void premultiplyAlphaRgbaF32(float* IGL_NONNULL pixels, size_t numPixels) noexcept;
+
+/// Box filters a 4 channel, 8 bit image into the next mip level, which is
+/// max(srcWidth / 2, 1) x max(srcHeight / 2, 1) pixels. sRGB encoded colors are averaged in linear
+/// space; alpha is always linear.
+void downsampleRgba8(const uint8_t* IGL_NONNULL src,
+                     uint32_t srcWidth,
+                     uint32_t srcHeight,
+                     uint8_t* IGL_NONNULL dst,
+                     bool isSrgb) noexcept;
+
+/// Box filters an RGBA32F image into the next mip level.
+void downsampleRgbaF32(const float* IGL_NONNULL src,
+                       uint32_t srcWidth,
+                       uint32_t srcHeight,
+                       float* IGL_NONNULL dst) noexcept;
+
+/// Generates `desc.numMipLevels` tightly packed mip levels for a 2D texture from its base level.
+/// Supports RGBA/BGRA 8 bit UNorm and sRGB formats and RGBA_F32, which GPUs can't always filter or
+/// render to.
+[[nodiscard]] std::unique_ptr<IData> generateMipmaps(const igl::TextureDesc& desc,
+                                                     const uint8_t* IGL_NONNULL baseLevel,
+                                                     igl::Result* IGL_NULLABLE
+                                                         outResult) noexcept;
+
+namespace scalar {
+
+void expandRgb8ToRgba8(const uint8_t* IGL_NONNULL src,
+                       uint8_t* IGL_NONNULL dst,
+                       size_t numPixels) noexcept;
+void convertFloatToHalf(const float* IGL_NONNULL src,
+                        uint16_t* IGL_NONNULL dst,
+                        size_t count) noexcept;
+void premultiplyAlphaRgba8(uint8_t* IGL_NONNULL pixels, size_t numPixels, bool isSrgb) noexcept;
+void premultiplyAlphaRgbaF32(float* IGL_NONNULL pixels, size_t numPixels) noexcept;
+void downsampleRgba8(const uint8_t* IGL_NONNULL src,
+                     uint32_t srcWidth,
+                     uint32_t srcHeight,
+                     uint8_t* IGL_NONNULL dst,
+                     bool isSrgb) noexcept;
+void downsampleRgbaF32(const float* IGL_NONNULL src,
+                       uint32_t srcWidth,
+                       uint32_t srcHeight,
+                       float* IGL_NONNULL dst) noexcept;
+
+} // namespace scalar
+
+} // namespace iglu::textureloader
@@ -7,7 +7,27 @@
 
 #include <IGLU/texture_loader/TextureLoaderFactory.h>
 
+#include <IGLU/texture_loader/IData.h>
+#include <IGLU/texture_loader/WorkerPool.h>
+#include <algorithm>
+#include <igl/CommandQueue.h>
+#include <igl/Device.h>
+#include <mutex>
+#include <optional>
+#include <queue>
+
 namespace iglu::textureloader {
+namespace {
+
+// Decoded image data of one loader in a batch
+struct DecodedTexture {
+  std::unique_ptr<IData> data;
+  // Points into the batch allocation for loaders that decode into external memory
+  const uint8_t* externalData = nullptr;
+  igl::Result result;
+};
+
+} // namespace
 
 TextureLoaderFactory::TextureLoaderFactory(
     std::vector<std::unique_ptr<ITextureLoaderFactory>>&& factories) :
@@ -47,4 +67,141 @@ std::unique_ptr<ITextureLoader> TextureLoaderFactory::tryCreateInternal(
   return nullptr;
 }
 
+std::vector<std::unique_ptr<ITextureLoader>> TextureLoaderFactory::tryCreateBatch(
+    std::vector<std::unique_ptr<IData>> sources,
+    igl::TextureFormat preferredFormat,
+    std::vector<igl::Result>* IGL_NULLABLE outResults) const noexcept {
+  std::vector<std::unique_ptr<ITextureLoader>> loaders(sources.size());
+  std::vector<igl::Result> results(sources.size());
+
+  WorkerPool::shared().parallelFor(sources.size(), [&](size_t i) {
+    loaders[i] = tryCreate(std::move(sources[i]), preferredFormat, &results[i]);
+  });
+
+  if (outResults != nullptr) {
+    *outResults = std::move(results);
+  }
+  return loaders;
+}
+
+std::vector<std::shared_ptr<igl::ITexture>> TextureLoaderFactory::createTextures(
+    const igl::IDevice& device,
+    const std::vector<std::unique_ptr<ITextureLoader>>& loaders,
+    igl::ICommandQueue* IGL_NULLABLE commandQueue,
+    std::vector<igl::Result>* IGL_NULLABLE outResults) noexcept {
+  std::vector<std::shared_ptr<igl::ITexture>> textures(loaders.size());
+  std::vector<igl::Result> results(loaders.size());
+  std::vector<DecodedTexture> decoded(loaders.size());
+
+  // Size a single allocation for everything decoded into external memory
+  constexpr size_t kAlignment = 16;
+  std::vector<size_t> decodeIndices;
+  std::vector<size_t> externalOffsets(loaders.size(), 0);
+  size_t externalLength = 0;
+  for (size_t i = 0; i < loaders.size(); ++i) {
+    if (!loaders[i]) {
+      results[i] = igl::Result(igl::Result::Code::ArgumentNull, "loader is nullptr.");
+      continue;
+    }
+    if (loaders[i]->canUploadSourceData()) {
+      continue;
+    }
+    decodeIndices.push_back(i);
+    if (loaders[i]->canUseExternalMemory()) {
+      externalOffsets[i] = externalLength;
+      externalLength += (loaders[i]->memorySizeInBytes() + kAlignment - 1) & ~(kAlignment - 1);
+    }
+  }
+  const auto externalMemory =
+      externalLength > 0 ? std::make_unique<uint8_t[]>(externalLength) : nullptr;
+
+  // Textures are decoded on the shared worker pool and handed to the calling thread in completion
+  // order
+  auto& pool = WorkerPool::shared();
+  std::mutex mutex;
+  std::queue<size_t> decodedQueue;
+  std::vector<WorkerPool::TaskFuture<void>> decodeTasks;
+  decodeTasks.reserve(decodeIndices.size());
+  for (const size_t index : decodeIndices) {
+    decodeTasks.push_back(pool.async([&, index]() {
+      const auto& loader = *loaders[index];
+      auto& texture = decoded[index];
+      if (loader.canUseExternalMemory()) {
+        uint8_t* data = externalMemory.get() + externalOffsets[index];
+        loader.loadToExternalMemory(data, loader.memorySizeInBytes(), &texture.result);
+        texture.externalData = data;
+      } else {
+        texture.data = loader.load(&texture.result);
+      }
+      const std::lock_guard<std::mutex> lock(mutex);
+      decodedQueue.push(index);
+    }));
+  }
+
+  const auto createTexture = [&](size_t index) {
+    auto& result = results[index];
+    auto texture = loaders[index]->create(device, &result);
+    if (!texture || !result.isOk()) {
+      return;
+    }
+    if (loaders[index]->canUploadSourceData()) {
+      loaders[index]->upload(*texture, &result);
+    } else {
+      auto& source = decoded[index];
+      if (!source.result.isOk()) {
+        result = std::move(source.result);
+        return;
+      }
+      const uint8_t* data = source.data ? source.data->data() : source.externalData;
+      const auto range = loaders[index]->shouldGenerateMipmaps() ? texture->getFullRange()
+                                                                 : texture->getFullMipRange();
+      result = texture->upload(range, data);
+      // Release decoded data as soon as it is uploaded
+      source.data = nullptr;
+    }
+    if (result.isOk() && commandQueue != nullptr && loaders[index]->shouldGenerateMipmaps()) {
+      texture->generateMipmap(*commandQueue);
+    }
+    if (result.isOk()) {
+      textures[index] = std::move(texture);
+    }
+  };
+
+  // Textures uploaded straight from their source data don't wait for any decoding
+  for (size_t i = 0; i < loaders.size(); ++i) {
+    if (loaders[i] && loaders[i]->canUploadSourceData()) {
+      createTexture(i);
+    }
+  }
+
+  size_t nextDecodeTask = 0;
+  for (size_t numUploaded = 0; numUploaded < decodeIndices.size(); ++numUploaded) {
+    std::optional<size_t> index;
+    while (!index) {
+      {
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (!decodedQueue.empty()) {
+          index = decodedQueue.front();
+          decodedQueue.pop();
+          break;
+        }
+      }
+      // Nothing is decoded yet. Waiting on the oldest pending task decodes it on this thread if no
+      // worker has started it, so this also makes progress when every worker is busy.
+      decodeTasks[nextDecodeTask++].get();
+    }
+    createTexture(*index);
+  }
+  for (auto& decodeTask : decodeTasks) {
+    if (decodeTask.valid()) {
+      decodeTask.get();
+    }
+  }
+
+  if (outResults != nullptr) {
+    *outResults = std::move(results);
+  }
+  return textures;
+}
+
 } // namespace iglu::textureloader
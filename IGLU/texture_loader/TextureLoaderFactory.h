@@ -10,6 +10,12 @@
 #include <IGLU/texture_loader/ITextureLoaderFactory.h>
 #include <vector>
 
+namespace igl {
+class ICommandQueue;
+class IDevice;
+class ITexture;
+} // namespace igl
+
 namespace iglu::textureloader {
 
 /// Factory for creating ITextureLoader instances for supported formats.
@@ -22,6 +28,25 @@ class TextureLoaderFactory : public ITextureLoaderFactory {
 
   [[nodiscard]] uint32_t headerLength() const noexcept final;
 
+  /// Creates loaders for all `sources` in parallel, probing each source's header against the
+  /// sub-factories on the shared WorkerPool. Entries are nullptr for sources no factory can
+  /// load; `outResults`, if provided, receives one result per source.
+  [[nodiscard]] std::vector<std::unique_ptr<ITextureLoader>> tryCreateBatch(
+      std::vector<std::unique_ptr<IData>> sources,
+      igl::TextureFormat preferredFormat,
+      std::vector<igl::Result>* IGL_NULLABLE outResults) const noexcept;
+
+  /// Creates and uploads textures for all `loaders`. Loaders that can't upload their source data
+  /// are decoded on the shared WorkerPool; those able to decode into external memory share a
+  /// single allocation sized for the whole batch. Textures are created and uploaded on the calling
+  /// thread as soon as their data is ready, so uploads start before the whole batch is decoded.
+  /// Mipmaps are generated with `commandQueue` for loaders that need them, if provided.
+  [[nodiscard]] static std::vector<std::shared_ptr<igl::ITexture>> createTextures(
+      const igl::IDevice& device,
+      const std::vector<std::unique_ptr<ITextureLoader>>& loaders,
+      igl::ICommandQueue* IGL_NULLABLE commandQueue,
+      std::vector<igl::Result>* IGL_NULLABLE outResults) noexcept;
+
  protected:
   [[nodiscard]] bool canCreateInternal(DataReader headerReader,
                                        igl::Result* IGL_NULLABLE outResult) const noexcept final;
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/texture_loader/WorkerPool.h>
+
+#include <algorithm>
+
+namespace iglu::textureloader {
+
+WorkerPool::WorkerPool(size_t numThreads) {
+  if (numThreads == 0) {
+    numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  threads_.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i) {
+    threads_.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  jobCondition_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+WorkerPool& WorkerPool::shared() {
+  static WorkerPool pool;
+  return pool;
+}
+
+void WorkerPool::enqueue(std::function<void()>&& job) {
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(std::move(job));
+  }
+  jobCondition_.notify_one();
+}
+
+void WorkerPool::workerLoop() {
+  for (;;) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      jobCondition_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+      // Remaining jobs are still run on shutdown so that no TaskFuture is left without a result
+      if (jobs_.empty()) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+    job();
+  }
+}
+
+} // namespace iglu::textureloader
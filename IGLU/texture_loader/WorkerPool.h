@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace iglu::textureloader {
+
+/// Persistent pool of worker threads used by the texture loaders and encoders for CPU work such as
+/// decoding, inflating and encoding, so threads are not created on every call.
+///
+/// The waiting thread always takes part in the work it waits for: parallelFor() runs indices on
+/// the calling thread and TaskFuture::get() runs a task that no worker has started yet. Waiting on
+/// a worker thread therefore cannot deadlock, even when every worker is busy.
+class WorkerPool final {
+ public:
+  /// Result of async(). Waiting on it runs the task on the calling thread if no worker started it.
+  template<typename T>
+  class TaskFuture final {
+   public:
+    TaskFuture() = default;
+
+    [[nodiscard]] bool valid() const noexcept {
+      return state_ != nullptr;
+    }
+
+    T get() {
+      auto state = std::move(state_);
+      state->tryRun();
+      return state->future.get();
+    }
+
+   private:
+    friend class WorkerPool;
+
+    struct State {
+      explicit State(std::packaged_task<T()>&& t) : task(std::move(t)), future(task.get_future()) {}
+      void tryRun() {
+        if (!claimed.exchange(true)) {
+          task();
+        }
+      }
+      std::atomic<bool> claimed = false;
+      std::packaged_task<T()> task;
+      std::future<T> future;
+    };
+
+    explicit TaskFuture(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+    std::shared_ptr<State> state_;
+  };
+
+  /// Creates a pool with `numThreads` workers, or one per hardware thread if `numThreads` is 0.
+  explicit WorkerPool(size_t numThreads = 0);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /// Pool shared by all texture loaders and encoders in the process.
+  static WorkerPool& shared();
+
+  [[nodiscard]] size_t numThreads() const noexcept {
+    return threads_.size();
+  }
+
+  /// Runs `task` on a worker thread.
+  template<typename Task>
+  [[nodiscard]] TaskFuture<std::invoke_result_t<Task>> async(Task&& task) {
+    using T = std::invoke_result_t<Task>;
+    auto state = std::make_shared<typename TaskFuture<T>::State>(
+        std::packaged_task<T()>(std::forward<Task>(task)));
+    enqueue([state]() { state->tryRun(); });
+    return TaskFuture<T>(std::move(state));
+  }
+
+  /// Runs `task(i)` for every index in [0, count) on the calling thread and the workers and returns
+  /// once all of them have finished.
+  template<typename Task>
+  void parallelFor(size_t count, const Task& task) {
+    if (count == 0) {
+      return;
+    }
+    // Workers may pick up their helper job after this call has returned, so the shared state must
+    // outlive it. `task` is only touched for indices below `count`, all of which finish before the
+    // call returns.
+    auto state = std::make_shared<ParallelForState>(count, [&task](size_t i) { task(i); });
+    const size_t numHelpers = std::min(count - 1, numThreads());
+    for (size_t i = 0; i < numHelpers; ++i) {
+      enqueue([state]() { state->run(); });
+    }
+    state->run();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->doneCondition.wait(lock, [&state]() { return state->done == state->count; });
+  }
+
+ private:
+  struct ParallelForState {
+    ParallelForState(size_t count, std::function<void(size_t)>&& task) :
+      count(count), task(std::move(task)) {}
+    void run() {
+      size_t finished = 0;
+      for (size_t i = next++; i < count; i = next++) {
+        task(i);
+        ++finished;
+      }
+      if (finished > 0) {
+        const std::lock_guard<std::mutex> lock(mutex);
+        done += finished;
+        if (done == count) {
+          doneCondition.notify_all();
+        }
+      }
+    }
+    const size_t count;
+    const std::function<void(size_t)> task;
+    std::atomic<size_t> next = 0;
+    std::mutex mutex;
+    std::condition_variable doneCondition;
+    size_t done = 0; // guarded by mutex
+  };
+
+  void enqueue(std::function<void()>&& job);
+  void workerLoop();
+
+  std::mutex mutex_;
+  std::condition_variable jobCondition_;
+  std::deque<std::function<void()>> jobs_; // guarded by mutex_
+  bool stopping_ = false; // guarded by mutex_
+  std::vector<std::thread> threads_;
+};
+
+} // namespace iglu::textureloader
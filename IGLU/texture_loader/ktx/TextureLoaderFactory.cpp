@@ -7,9 +7,23 @@
 
 #include <IGLU/texture_loader/ktx/TextureLoaderFactory.h>
 
+#include <IGLU/texture_loader/WorkerPool.h>
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <igl/Hash.h>
 #include <igl/IGLSafeC.h>
 #include <ktx.h>
 #include <numeric>
+#include <thread>
+#if defined(IGLU_TEXTURE_LOADER_WITH_ZSTD)
+#include <zstd.h>
+#endif
 
 namespace iglu::textureloader::ktx {
 namespace {
@@ -20,6 +34,79 @@ struct KtxDeleter {
   }
 };
 
+// Inflates a Zstd supercompressed mip level stored in `container` into `dst`
+bool inflateMipLevel([[maybe_unused]] const uint8_t* IGL_NONNULL container,
+                     [[maybe_unused]] const MipLevelSource& source,
+                     [[maybe_unused]] uint8_t* IGL_NONNULL dst) noexcept {
+#if defined(IGLU_TEXTURE_LOADER_WITH_ZSTD)
+  const size_t inflatedLength =
+      ZSTD_decompress(dst, source.uncompressedLength, container + source.offset, source.length);
+  if (ZSTD_isError(inflatedLength)) {
+    IGL_LOG_ERROR("Error inflating KTX mip level: %s\n", ZSTD_getErrorName(inflatedLength));
+    return false;
+  }
+  return inflatedLength == source.uncompressedLength;
+#else
+  // mipLevelSources() leaves Zstd supercompressed levels to libktx in this configuration
+  IGL_LOG_ERROR("KTX mip level inflation requires Zstd\n");
+  return false;
+#endif
+}
+
+ktx_transcode_fmt_e toTranscodeFormat(igl::TextureFormat format) noexcept {
+  switch (format) {
+  case igl::TextureFormat::RGBA_ASTC_4x4:
+    return KTX_TTF_ASTC_4x4_RGBA;
+  case igl::TextureFormat::RGBA_BC7_UNORM_4x4:
+    return KTX_TTF_BC7_RGBA;
+  case igl::TextureFormat::RGBA8_EAC_ETC2:
+    return KTX_TTF_ETC2_RGBA;
+  default:
+    return KTX_TTF_RGBA32;
+  }
+}
+
+uint64_t hashData(DataReader reader) noexcept {
+  return igl::fnv1aHash(reader.data(), reader.length());
+}
+
+// Writes the transcoded texture to `path`. The file is written under a temporary name and renamed,
+// so concurrent loads never read a partially written cache entry.
+void writeTranscodeCache(ktxTexture* IGL_NONNULL texture, const std::string& path) noexcept {
+  ktx_uint8_t* bytes = nullptr;
+  ktx_size_t size = 0;
+  auto error = ktxTexture_WriteToMemory(texture, &bytes, &size);
+  if (error != KTX_SUCCESS || bytes == nullptr) {
+    IGL_LOG_ERROR("Error writing transcoded KTX texture: %d %s\n", error, ktxErrorString(error));
+    return;
+  }
+
+  std::error_code ec;
+  const std::filesystem::path cachePath(path);
+  std::filesystem::create_directories(cachePath.parent_path(), ec);
+  auto tempPath = cachePath;
+  tempPath += ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+  bool written = false;
+  {
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+    file.close();
+    written = !file.fail();
+  }
+  std::free(bytes);
+  if (!written) {
+    // Never publish a truncated entry, later loads would trust it
+    IGL_LOG_ERROR("Error writing KTX transcode cache %s\n", tempPath.string().c_str());
+    std::filesystem::remove(tempPath, ec);
+    return;
+  }
+
+  std::filesystem::rename(tempPath, cachePath, ec);
+  if (ec) {
+    std::filesystem::remove(tempPath, ec);
+  }
+}
+
 class TextureLoader : public ITextureLoader {
   using Super = ITextureLoader;
 
@@ -27,7 +114,8 @@ class TextureLoader : public ITextureLoader {
   TextureLoader(DataReader reader,
                 const igl::TextureRangeDesc& range,
                 igl::TextureFormat format,
-                std::unique_ptr<ktxTexture, KtxDeleter> texture) noexcept;
+                std::unique_ptr<ktxTexture, KtxDeleter> texture,
+                std::vector<MipLevelSource> mipLevelSources) noexcept;
 
   [[nodiscard]] bool canUploadSourceData() const noexcept final;
   [[nodiscard]] bool shouldGenerateMipmaps() const noexcept final;
@@ -39,14 +127,31 @@ class TextureLoader : public ITextureLoader {
                                     uint32_t length,
                                     igl::Result* IGL_NULLABLE outResult) const noexcept final;
 
+  void uploadZstdCompressed(igl::ITexture& texture,
+                            uint32_t numMipLevels,
+                            igl::Result* IGL_NULLABLE outResult) const noexcept;
+  void loadZstdCompressed(uint8_t* IGL_NONNULL data,
+                          uint32_t length,
+                          uint32_t numMipLevels,
+                          igl::Result* IGL_NULLABLE outResult) const noexcept;
+
+  [[nodiscard]] bool isZstdCompressed() const noexcept;
+  [[nodiscard]] uint32_t numMipLevelsToUpload() const noexcept;
+
+  // Returns the image data of the first face and layer of mipLevel
+  [[nodiscard]] const uint8_t* IGL_NULLABLE mipLevelData(uint32_t mipLevel) const noexcept;
+
   std::unique_ptr<ktxTexture, KtxDeleter> texture_;
+  // Location of the mip levels in the source data. Empty if libktx loaded the image data.
+  std::vector<MipLevelSource> mipLevelSources_;
 };
 
 TextureLoader::TextureLoader(DataReader reader,
                              const igl::TextureRangeDesc& range,
                              igl::TextureFormat format,
-                             std::unique_ptr<ktxTexture, KtxDeleter> texture) noexcept :
-  Super(reader), texture_(std::move(texture)) {
+                             std::unique_ptr<ktxTexture, KtxDeleter> texture,
+                             std::vector<MipLevelSource> mipLevelSources) noexcept :
+  Super(reader), texture_(std::move(texture)), mipLevelSources_(std::move(mipLevelSources)) {
   auto& desc = mutableDescriptor();
   desc.format = format;
   desc.numLayers = range.numLayers;
@@ -76,20 +181,44 @@ bool TextureLoader::shouldGenerateMipmaps() const noexcept {
   return texture_->generateMipmaps;
 }
 
+bool TextureLoader::isZstdCompressed() const noexcept {
+  return !mipLevelSources_.empty() && mipLevelSources_[0].isZstdCompressed;
+}
+
+uint32_t TextureLoader::numMipLevelsToUpload() const noexcept {
+  return std::min(descriptor().numMipLevels, static_cast<uint32_t>(texture_->numLevels));
+}
+
+const uint8_t* IGL_NULLABLE TextureLoader::mipLevelData(uint32_t mipLevel) const noexcept {
+  if (!mipLevelSources_.empty()) {
+    return reader().data() + mipLevelSources_[mipLevel].offset;
+  }
+
+  size_t offset = 0;
+  auto error = ktxTexture_GetImageOffset(ktxTexture(texture_.get()), mipLevel, 0, 0, &offset);
+  if (error != KTX_SUCCESS) {
+    IGL_LOG_ERROR("Error getting KTX texture data: %d %s\n", error, ktxErrorString(error));
+    return nullptr;
+  }
+  return texture_->pData + offset;
+}
+
 void TextureLoader::uploadInternal(igl::ITexture& texture,
                                    igl::Result* IGL_NULLABLE outResult) const noexcept {
-  const auto& desc = descriptor();
+  const uint32_t numMipLevels = numMipLevelsToUpload();
+  if (isZstdCompressed()) {
+    uploadZstdCompressed(texture, numMipLevels, outResult);
+    return;
+  }
 
-  size_t offset = 0;
-  for (uint32_t mipLevel = 0; mipLevel < desc.numMipLevels && mipLevel < texture_->numLevels;
-       ++mipLevel) {
-    auto error = ktxTexture_GetImageOffset(ktxTexture(texture_.get()), mipLevel, 0, 0, &offset);
-    if (error != KTX_SUCCESS) {
-      IGL_LOG_ERROR("Error getting KTX texture data: %d %s\n", error, ktxErrorString(error));
+  for (uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel) {
+    const uint8_t* data = mipLevelData(mipLevel);
+    if (data == nullptr) {
       igl::Result::setResult(
           outResult, igl::Result::Code::RuntimeError, "Error getting KTX texture data.");
+      return;
     }
-    texture.upload(texture.getFullRange(mipLevel), texture_->pData + offset);
+    texture.upload(texture.getFullRange(mipLevel), data);
   }
 
   igl::Result::setOk(outResult);
@@ -101,6 +230,22 @@ void TextureLoader::loadToExternalMemoryInternal(uint8_t* IGL_NONNULL data,
                                                      outResult) const noexcept {
   const auto& desc = descriptor();
 
+  if (isZstdCompressed()) {
+    loadZstdCompressed(data, length, numMipLevelsToUpload(), outResult);
+    return;
+  }
+
+  if (!mipLevelSources_.empty()) {
+    size_t offset = 0;
+    for (uint32_t mipLevel = 0; mipLevel < numMipLevelsToUpload(); ++mipLevel) {
+      const uint32_t mipLevelLength = mipLevelSources_[mipLevel].uncompressedLength;
+      checked_memcpy_offset(data, length, offset, mipLevelData(mipLevel), mipLevelLength);
+      offset += mipLevelLength;
+    }
+    igl::Result::setOk(outResult);
+    return;
+  }
+
   size_t offset = 0;
   for (uint32_t mipLevel = 0; mipLevel < desc.numMipLevels && mipLevel < texture_->numLevels;
        ++mipLevel) {
@@ -116,11 +261,128 @@ void TextureLoader::loadToExternalMemoryInternal(uint8_t* IGL_NONNULL data,
     offset += mipLevelLength;
   }
 }
+
+void TextureLoader::uploadZstdCompressed(igl::ITexture& texture,
+                                         uint32_t numMipLevels,
+                                         igl::Result* IGL_NULLABLE outResult) const noexcept {
+  // Mip levels are inflated on the shared worker pool while earlier levels are uploaded. At most
+  // one level per worker is kept inflated at a time, so the texture is never inflated at once.
+  auto& pool = WorkerPool::shared();
+  const auto maxLevelsInFlight = static_cast<uint32_t>(pool.numThreads());
+  const auto inflate = [this](uint32_t mipLevel) -> std::unique_ptr<uint8_t[]> {
+    const auto& source = mipLevelSources_[mipLevel];
+    auto data = std::make_unique<uint8_t[]>(source.uncompressedLength);
+    if (!inflateMipLevel(reader().data(), source, data.get())) {
+      return nullptr;
+    }
+    return data;
+  };
+
+  std::vector<WorkerPool::TaskFuture<std::unique_ptr<uint8_t[]>>> mipLevels(numMipLevels);
+  uint32_t nextMipLevel = 0;
+  for (uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel) {
+    for (; nextMipLevel < numMipLevels && nextMipLevel < mipLevel + maxLevelsInFlight;
+         ++nextMipLevel) {
+      mipLevels[nextMipLevel] = pool.async([&inflate, nextMipLevel]() {
+        return inflate(nextMipLevel);
+      });
+    }
+
+    const auto data = mipLevels[mipLevel].get();
+    if (!data) {
+      // Levels still in flight refer to this loader, so they have to finish before returning
+      for (auto& pending : mipLevels) {
+        if (pending.valid()) {
+          pending.get();
+        }
+      }
+      igl::Result::setResult(
+          outResult, igl::Result::Code::RuntimeError, "Error inflating KTX texture data.");
+      return;
+    }
+    texture.upload(texture.getFullRange(mipLevel), data.get());
+  }
+
+  igl::Result::setOk(outResult);
+}
+
+void TextureLoader::loadZstdCompressed(uint8_t* IGL_NONNULL data,
+                                       uint32_t length,
+                                       uint32_t numMipLevels,
+                                       igl::Result* IGL_NULLABLE outResult) const noexcept {
+  // Mip levels are inflated in parallel on the shared worker pool straight into their place in
+  // `data`
+  std::vector<size_t> offsets;
+  offsets.reserve(numMipLevels);
+  size_t offset = 0;
+  for (uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel) {
+    const auto& source = mipLevelSources_[mipLevel];
+    if (offset + source.uncompressedLength > length) {
+      break;
+    }
+    offsets.push_back(offset);
+    offset += source.uncompressedLength;
+  }
+
+  std::atomic<bool> succeeded = offsets.size() == numMipLevels;
+  WorkerPool::shared().parallelFor(offsets.size(), [&](size_t mipLevel) {
+    if (!inflateMipLevel(reader().data(), mipLevelSources_[mipLevel], data + offsets[mipLevel])) {
+      succeeded = false;
+    }
+  });
+  if (!succeeded) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::RuntimeError, "Error inflating KTX texture data.");
+    return;
+  }
+
+  igl::Result::setOk(outResult);
+}
 } // namespace
 
+TextureLoaderFactory::TextureLoaderFactory() noexcept :
+#if IGL_PLATFORM_ANDROID || IGL_PLATFORM_IOS
+  transcodeTarget_(igl::TextureFormat::RGBA_ASTC_4x4)
+#else
+  transcodeTarget_(igl::TextureFormat::RGBA_BC7_UNORM_4x4)
+#endif
+{
+}
+
+void TextureLoaderFactory::setTranscodeTarget(const igl::ICapabilities& capabilities) noexcept {
+  for (const auto format : {igl::TextureFormat::RGBA_ASTC_4x4,
+                            igl::TextureFormat::RGBA_BC7_UNORM_4x4,
+                            igl::TextureFormat::RGBA8_EAC_ETC2}) {
+    if (igl::contains(capabilities.getTextureFormatCapabilities(format),
+                      igl::ICapabilities::TextureFormatCapabilityBits::Sampled)) {
+      transcodeTarget_ = format;
+      return;
+    }
+  }
+  transcodeTarget_ = igl::TextureFormat::RGBA_UNorm8;
+}
+
+igl::TextureFormat TextureLoaderFactory::transcodeTarget() const noexcept {
+  return transcodeTarget_;
+}
+
+void TextureLoaderFactory::setTranscodeCacheDirectory(std::string directory) noexcept {
+  transcodeCacheDirectory_ = std::move(directory);
+}
+
+std::string TextureLoaderFactory::transcodeCachePath(DataReader reader) const {
+  char fileName[64];
+  std::snprintf(fileName,
+                sizeof(fileName),
+                "%016" PRIx64 "-%d.ktx2",
+                hashData(reader),
+                static_cast<int>(toTranscodeFormat(transcodeTarget_)));
+  return (std::filesystem::path(transcodeCacheDirectory_) / fileName).string();
+}
+
 std::unique_ptr<ITextureLoader> TextureLoaderFactory::tryCreateInternal(
     DataReader reader,
-    igl::TextureFormat /*preferredFormat*/,
+    igl::TextureFormat preferredFormat,
     igl::Result* IGL_NULLABLE outResult) const noexcept {
   const auto range = textureRange(reader);
   auto result = range.validate();
@@ -133,9 +395,31 @@ std::unique_ptr<ITextureLoader> TextureLoaderFactory::tryCreateInternal(
     return nullptr;
   }
 
+  // Image data that can be used in place is not copied into libktx-owned memory
+  auto sources = mipLevelSources(reader, range);
+
+  std::string cachePath;
+  if (!transcodeCacheDirectory_.empty() && needsTranscoding(reader)) {
+    // Data that needs transcoding may have been transcoded by an earlier load. Cached files hold
+    // GPU-native blocks, so loading them never recurses into the cache.
+    cachePath = transcodeCachePath(reader);
+    std::error_code ec;
+    if (std::filesystem::exists(cachePath, ec)) {
+      auto loader =
+          tryCreate(IData::tryCreateFromFile(cachePath, nullptr), preferredFormat, nullptr);
+      if (loader) {
+        igl::Result::setOk(outResult);
+        return loader;
+      }
+      IGL_LOG_INFO("Ignoring invalid KTX transcode cache %s\n", cachePath.c_str());
+    }
+  }
+  const ktxTextureCreateFlags createFlags =
+      sources.empty() ? KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT : KTX_TEXTURE_CREATE_NO_FLAGS;
+
   ktxTexture* rawTexture = nullptr;
-  auto error = ktxTexture_CreateFromMemory(
-      reader.data(), reader.length(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &rawTexture);
+  auto error =
+      ktxTexture_CreateFromMemory(reader.data(), reader.length(), createFlags, &rawTexture);
 
   if (error != KTX_SUCCESS || rawTexture == nullptr) {
     IGL_LOG_ERROR("Error loading KTX texture: %d %s\n", error, ktxErrorString(error));
@@ -150,19 +434,17 @@ std::unique_ptr<ITextureLoader> TextureLoaderFactory::tryCreateInternal(
   auto texture = std::unique_ptr<ktxTexture, KtxDeleter>(rawTexture);
 
   if (ktxTexture_NeedsTranscoding(rawTexture)) {
-#if IGL_PLATFORM_ANDROID || IGL_PLATFORM_IOS
-    const ktx_transcode_fmt_e transcodeFormat = KTX_TTF_ASTC_4x4_RGBA;
-#else
-    const ktx_transcode_fmt_e transcodeFormat = KTX_TTF_BC7_RGBA;
-#endif
-    error =
-        ktxTexture2_TranscodeBasis(reinterpret_cast<ktxTexture2*>(rawTexture), transcodeFormat, 0);
+    error = ktxTexture2_TranscodeBasis(
+        reinterpret_cast<ktxTexture2*>(rawTexture), toTranscodeFormat(transcodeTarget_), 0);
     if (error != KTX_SUCCESS) {
       IGL_LOG_ERROR("Error transcoding KTX texture: %d %s\n", error, ktxErrorString(error));
       igl::Result::setResult(
           outResult, igl::Result::Code::RuntimeError, "Error transcoding KTX texture.");
       return nullptr;
     }
+    if (!cachePath.empty()) {
+      writeTranscodeCache(rawTexture, cachePath);
+    }
   }
 
   const auto format = textureFormat(rawTexture);
@@ -202,6 +484,7 @@ std::unique_ptr<ITextureLoader> TextureLoaderFactory::tryCreateInternal(
     return nullptr;
   }
 
-  return std::make_unique<TextureLoader>(reader, range, format, std::move(texture));
+  return std::make_unique<TextureLoader>(
+      reader, range, format, std::move(texture), std::move(sources));
 }
 } // namespace iglu::textureloader::ktx
@@ -8,17 +8,40 @@
 #pragma once
 
 #include <IGLU/texture_loader/ITextureLoaderFactory.h>
+#include <string>
+#include <vector>
 
 struct ktxTexture;
 
 namespace iglu::textureloader::ktx {
 
+/// Location of a mip level's image data within a KTX container
+struct MipLevelSource {
+  uint32_t offset = 0;
+  uint32_t length = 0;
+  // Differs from length if the level is supercompressed
+  uint32_t uncompressedLength = 0;
+  bool isZstdCompressed = false;
+};
+
 /**
  * @brief ITextureLoaderFactory base class for loading KTX v1 and v2 textures
  */
 class TextureLoaderFactory : public ITextureLoaderFactory {
+ public:
+  /// Chooses the format Basis Universal textures are transcoded to: the first of ASTC 4x4, BC7 and
+  /// ETC2 RGBA that `capabilities` can sample, or uncompressed RGBA8. Without calling this, ASTC is
+  /// used on mobile platforms and BC7 elsewhere.
+  void setTranscodeTarget(const igl::ICapabilities& capabilities) noexcept;
+  [[nodiscard]] igl::TextureFormat transcodeTarget() const noexcept;
+
+  /// Writes transcoded Basis Universal textures to `directory` as KTX2 files keyed by a hash of the
+  /// source data and the transcode target. Later loads of the same data read the GPU-native blocks
+  /// from there instead of transcoding again. An empty directory disables the cache.
+  void setTranscodeCacheDirectory(std::string directory) noexcept;
+
  protected:
-  TextureLoaderFactory() noexcept = default;
+  TextureLoaderFactory() noexcept;
   [[nodiscard]] virtual igl::TextureRangeDesc textureRange(DataReader reader) const noexcept = 0;
 
   [[nodiscard]] virtual bool validate(DataReader reader,
@@ -28,11 +51,28 @@ class TextureLoaderFactory : public ITextureLoaderFactory {
   [[nodiscard]] virtual igl::TextureFormat textureFormat(
       const ktxTexture* IGL_NONNULL texture) const noexcept = 0;
 
+  /// Returns where each mip level's image data is stored within the container, or an empty vector
+  /// if libktx has to load the image data (e.g. because it needs transcoding). When available,
+  /// mip levels are uploaded straight from the container, or inflated from it level by level if
+  /// they are Zstd supercompressed, without libktx loading the whole image data first.
+  [[nodiscard]] virtual std::vector<MipLevelSource> mipLevelSources(
+      DataReader reader,
+      const igl::TextureRangeDesc& range) const noexcept = 0;
+
+  /// Returns true if the image data is Basis Universal and has to be transcoded when loaded. Only
+  /// such data is looked up in the transcode cache.
+  [[nodiscard]] virtual bool needsTranscoding(DataReader reader) const noexcept = 0;
+
  private:
   [[nodiscard]] std::unique_ptr<ITextureLoader> tryCreateInternal(
       DataReader reader,
       igl::TextureFormat preferredFormat, // Ignored for KTX textures
       igl::Result* IGL_NULLABLE outResult) const noexcept final;
+
+  [[nodiscard]] std::string transcodeCachePath(DataReader reader) const;
+
+  igl::TextureFormat transcodeTarget_;
+  std::string transcodeCacheDirectory_;
 };
 
 } // namespace iglu::textureloader::ktx
@@ -116,4 +116,39 @@ igl::TextureFormat TextureLoaderFactory::textureFormat(const ktxTexture* texture
   return igl::TextureFormat::Invalid;
 }
 
+std::vector<ktx::MipLevelSource> TextureLoaderFactory::mipLevelSources(
+    DataReader reader,
+    const igl::TextureRangeDesc& range) const noexcept {
+  const Header* header = reader.as<Header>();
+  if (header->endianness != 0x04030201) {
+    // libktx byte swaps data stored with the opposite endianness while loading it
+    return {};
+  }
+
+  const auto format = igl::opengl::util::glTextureFormatToTextureFormat(
+      header->glInternalFormat, header->glFormat, header->glType);
+  const auto properties = igl::TextureFormatProperties::fromTextureFormat(format);
+  const bool isCubeTexture = header->numberOfFaces == 6u;
+
+  // Same layout as checked by validate(): every mip level is preceded by its imageSize
+  std::vector<ktx::MipLevelSource> sources;
+  sources.reserve(range.numMipLevels);
+  uint32_t offset = kHeaderLength + header->bytesOfKeyValueData;
+  for (uint32_t mipLevel = 0; mipLevel < range.numMipLevels; ++mipLevel) {
+    const size_t bytes = properties.getBytesPerRange(range.atMipLevel(mipLevel).atFace(0));
+    const auto mipLevelLength =
+        static_cast<uint32_t>(isCubeTexture ? bytes * static_cast<size_t>(6) : bytes);
+    offset += 4u;
+    sources.push_back({offset, mipLevelLength, mipLevelLength, false});
+    offset += mipLevelLength;
+  }
+
+  return sources;
+}
+
+bool TextureLoaderFactory::needsTranscoding(DataReader /*reader*/) const noexcept {
+  // KTX v1 has no Basis Universal encoding
+  return false;
+}
+
 } // namespace iglu::textureloader::ktx1
@@ -34,6 +34,12 @@ class TextureLoaderFactory final : public ktx::TextureLoaderFactory {
 
   [[nodiscard]] igl::TextureFormat textureFormat(
       const ktxTexture* IGL_NONNULL texture) const noexcept final;
+
+  [[nodiscard]] std::vector<ktx::MipLevelSource> mipLevelSources(
+      DataReader reader,
+      const igl::TextureRangeDesc& range) const noexcept final;
+
+  [[nodiscard]] bool needsTranscoding(DataReader reader) const noexcept final;
 };
 
 } // namespace iglu::textureloader::ktx1
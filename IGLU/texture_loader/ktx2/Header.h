@@ -40,4 +40,6 @@ static_assert(sizeof(Header) == 13 * sizeof(uint32_t) + 2 * sizeof(uint64_t) + 1
 
 constexpr uint32_t kHeaderLength = static_cast<uint32_t>(sizeof(Header));
 
+constexpr uint32_t kSupercompressionSchemeZstd = 2u;
+
 } // namespace iglu::textureloader::ktx2
@@ -95,8 +95,10 @@ bool TextureLoaderFactory::validate(DataReader reader,
         igl::vulkan::util::vkTextureFormatToTextureFormat(static_cast<int32_t>(header->vkFormat));
     const auto properties = igl::TextureFormatProperties::fromTextureFormat(format);
 
+    // Supercompressed mip levels are stored unaligned and are shorter than their uncompressed size
+    const bool isSupercompressed = header->supercompressionScheme != 0u;
     const uint32_t mipLevelAlignment =
-        std::lcm(static_cast<uint32_t>(properties.bytesPerBlock), 4u);
+        isSupercompressed ? 1u : std::lcm(static_cast<uint32_t>(properties.bytesPerBlock), 4u);
 
     size_t rangeBytesAsSizeT = 0;
     for (uint32_t mipLevel = 0; mipLevel < range.numMipLevels; ++mipLevel) {
@@ -104,7 +106,7 @@ bool TextureLoaderFactory::validate(DataReader reader,
                                  static_cast<size_t>(mipLevelAlignment));
     }
 
-    if (rangeBytesAsSizeT > length) {
+    if (!isSupercompressed && rangeBytesAsSizeT > length) {
       igl::Result::setResult(
           outResult, igl::Result::Code::InvalidOperation, "Length is too short.");
       return false;
@@ -127,7 +129,7 @@ bool TextureLoaderFactory::validate(DataReader reader,
     uint32_t expectedDataOffset = align(metadataLength, mipLevelAlignment);
 
     const uint32_t expectedLength = expectedDataOffset + rangeBytes;
-    if (length < expectedLength) {
+    if (!isSupercompressed && length < expectedLength) {
       igl::Result::setResult(
           outResult, igl::Result::Code::InvalidOperation, "Length shorter than expected length.");
       return false;
@@ -158,6 +160,12 @@ bool TextureLoaderFactory::validate(DataReader reader,
         return false;
       }
 
+      if (byteOffset + byteLength > static_cast<uint64_t>(length)) {
+        igl::Result::setResult(
+            outResult, igl::Result::Code::InvalidOperation, "Length shorter than expected length.");
+        return false;
+      }
+
       if (static_cast<size_t>(uncompressedByteLength) !=
           properties.getBytesPerRange(range.atMipLevel(mipLevel))) {
         igl::Result::setResult(
@@ -182,4 +190,42 @@ igl::TextureFormat TextureLoaderFactory::textureFormat(const ktxTexture* texture
 
   return igl::TextureFormat::Invalid;
 }
+
+std::vector<ktx::MipLevelSource> TextureLoaderFactory::mipLevelSources(
+    DataReader reader,
+    const igl::TextureRangeDesc& range) const noexcept {
+  const Header* header = reader.as<Header>();
+  if (header->vkFormat == 0u) {
+    // Basis Universal data has to be transcoded by libktx
+    return {};
+  }
+  const bool isZstdCompressed = header->supercompressionScheme == kSupercompressionSchemeZstd;
+  if (header->supercompressionScheme != 0u && !isZstdCompressed) {
+    return {};
+  }
+#if !defined(IGLU_TEXTURE_LOADER_WITH_ZSTD)
+  if (isZstdCompressed) {
+    // Without Zstd, libktx inflates the image data when loading it
+    return {};
+  }
+#endif
+
+  std::vector<ktx::MipLevelSource> sources;
+  sources.reserve(range.numMipLevels);
+  for (uint32_t mipLevel = 0; mipLevel < range.numMipLevels; ++mipLevel) {
+    // The level index was checked against the data layout by validate()
+    const uint32_t offset = kHeaderLength + mipLevel * 24u;
+    sources.push_back({static_cast<uint32_t>(reader.readAt<uint64_t>(offset)),
+                       static_cast<uint32_t>(reader.readAt<uint64_t>(offset + 8u)),
+                       static_cast<uint32_t>(reader.readAt<uint64_t>(offset + 16u)),
+                       isZstdCompressed});
+  }
+
+  return sources;
+}
+
+bool TextureLoaderFactory::needsTranscoding(DataReader reader) const noexcept {
+  // Basis Universal data is stored with an undefined Vulkan format
+  return reader.as<Header>()->vkFormat == 0u;
+}
 } // namespace iglu::textureloader::ktx2
@@ -7,6 +7,8 @@
 
 #include <IGLU/texture_loader/stb_image/TextureLoaderFactory.h>
 
+#include <IGLU/texture_loader/PixelConversion.h>
+
 #ifdef WIN32
 #define STBI_MSC_SECURE_CRT
 #endif
@@ -62,6 +64,8 @@ class TextureLoader : public ITextureLoader {
 
  private:
   std::unique_ptr<IData> loadInternal(igl::Result* IGL_NULLABLE outResult) const noexcept final;
+  std::unique_ptr<IData> loadHalfFloat(float* IGL_NONNULL pixels,
+                                       igl::Result* IGL_NULLABLE outResult) const noexcept;
 
   bool isFloatFormat_;
 };
@@ -83,9 +87,11 @@ TextureLoader::TextureLoader(DataReader reader,
   desc.depth = 1;
   desc.type = igl::TextureType::TwoD;
 
-  // Floating point mipmaps not always supported
-  desc.numMipLevels = isFloatFormat ? 1
-                                    : igl::TextureDesc::calcNumMipLevels(desc.width, desc.height);
+  // Floating point mipmaps not always supported, except for half floats which are generated on the
+  // CPU since not all GPUs can render to them
+  desc.numMipLevels = isFloatFormat && desc.format != igl::TextureFormat::RGBA_F16
+                          ? 1
+                          : igl::TextureDesc::calcNumMipLevels(desc.width, desc.height);
 }
 
 bool TextureLoader::canUploadSourceData() const noexcept {
@@ -93,7 +99,7 @@ bool TextureLoader::canUploadSourceData() const noexcept {
 }
 
 bool TextureLoader::shouldGenerateMipmaps() const noexcept {
-  return descriptor().numMipLevels > 1;
+  return !isFloatFormat_ && descriptor().numMipLevels > 1;
 }
 
 std::unique_ptr<IData> TextureLoader::loadInternal(
@@ -115,8 +121,37 @@ std::unique_ptr<IData> TextureLoader::loadInternal(
     return nullptr;
   }
 
+  if (isFloatFormat_ && descriptor().format == igl::TextureFormat::RGBA_F16) {
+    return loadHalfFloat(reinterpret_cast<float*>(data), outResult);
+  }
+
   return std::make_unique<StbImageData>(reinterpret_cast<uint8_t*>(data), memorySizeInBytes());
 }
+
+std::unique_ptr<IData> TextureLoader::loadHalfFloat(
+    float* IGL_NONNULL pixels,
+    igl::Result* IGL_NULLABLE outResult) const noexcept {
+  const std::unique_ptr<float, StbImageDeleter> stbPixels(pixels);
+
+  // Mip levels are filtered at full precision before being converted to half floats
+  std::unique_ptr<IData> mipLevels;
+  const float* src = pixels;
+  if (descriptor().numMipLevels > 1) {
+    igl::TextureDesc floatDesc = descriptor();
+    floatDesc.format = igl::TextureFormat::RGBA_F32;
+    mipLevels = generateMipmaps(floatDesc, reinterpret_cast<const uint8_t*>(pixels), outResult);
+    if (!mipLevels) {
+      return nullptr;
+    }
+    src = reinterpret_cast<const float*>(mipLevels->data());
+  }
+
+  const uint32_t length = memorySizeInBytes();
+  auto data = std::make_unique<uint8_t[]>(length);
+  convertFloatToHalf(src, reinterpret_cast<uint16_t*>(data.get()), length / sizeof(uint16_t));
+
+  return IData::tryCreate(std::move(data), length, outResult);
+}
 } // namespace
 
 TextureLoaderFactory::TextureLoaderFactory(bool isFloatFormat) noexcept :
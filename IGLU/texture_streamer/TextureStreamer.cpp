@@ -0,0 +1,451 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/texture_streamer/TextureStreamer.h>
+
+#include <algorithm>
+#include <igl/CommandQueue.h>
+#include <igl/Device.h>
+
+namespace iglu::texturestreamer {
+namespace {
+
+igl::TextureRangeDesc fullRange(const igl::TextureDesc& desc) {
+  igl::TextureRangeDesc range;
+  range.width = desc.width;
+  range.height = desc.height;
+  range.depth = desc.depth;
+  range.numLayers = desc.numLayers;
+  range.numFaces = desc.type == igl::TextureType::Cube ? 6u : 1u;
+  range.numMipLevels = desc.numMipLevels;
+  return range;
+}
+
+size_t mipLevelLength(const igl::TextureDesc& desc, uint32_t mipLevel) {
+  const auto properties = igl::TextureFormatProperties::fromTextureFormat(desc.format);
+  return properties.getBytesPerRange(fullRange(desc).atMipLevel(mipLevel));
+}
+
+// Decoded texture data stores mip levels tightly packed, starting with level 0
+size_t mipLevelOffset(const igl::TextureDesc& desc, uint32_t mipLevel) {
+  size_t offset = 0;
+  for (uint32_t level = 0; level < mipLevel; ++level) {
+    offset += mipLevelLength(desc, level);
+  }
+  return offset;
+}
+
+} // namespace
+
+bool TextureStreamer::JobOrder::operator()(const Job& lhs, const Job& rhs) const noexcept {
+  if (lhs.priority.importance != rhs.priority.importance) {
+    return lhs.priority.importance < rhs.priority.importance;
+  }
+  if (lhs.priority.requestedMipLevel != rhs.priority.requestedMipLevel) {
+    return lhs.priority.requestedMipLevel > rhs.priority.requestedMipLevel;
+  }
+  // Oldest first
+  return lhs.sequence > rhs.sequence;
+}
+
+TextureStreamer::TextureStreamer(igl::IDevice& device,
+                                 std::unique_ptr<textureloader::ITextureLoaderFactory> factory,
+                                 const TextureStreamerDesc& desc) :
+  device_(device), factory_(std::move(factory)), desc_(desc) {
+  IGL_DEBUG_ASSERT(factory_);
+  decodeTasks_.resize(desc_.maxConcurrentDecodes);
+}
+
+TextureStreamer::~TextureStreamer() {
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  // Tasks no worker has started yet run here and return right away
+  for (auto& task : decodeTasks_) {
+    if (task.future.valid()) {
+      task.future.get();
+    }
+  }
+}
+
+TextureId TextureStreamer::request(std::string path, const StreamingPriority& priority) {
+  Entry entry;
+  entry.path = std::move(path);
+  entry.priority = priority;
+  return addEntry(std::move(entry));
+}
+
+TextureId TextureStreamer::request(std::unique_ptr<textureloader::IData> data,
+                                   const StreamingPriority& priority) {
+  if (!IGL_DEBUG_VERIFY(data)) {
+    return 0;
+  }
+  Entry entry;
+  entry.source = std::move(data);
+  entry.priority = priority;
+  return addEntry(std::move(entry));
+}
+
+TextureId TextureStreamer::addEntry(Entry entry) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  const TextureId id = nextId_++;
+  auto& newEntry = entries_.emplace(id, std::move(entry)).first->second;
+  newEntry.lastUsedFrame = frame_;
+  enqueueLocked(id, newEntry);
+  return id;
+}
+
+void TextureStreamer::enqueueLocked(TextureId id, Entry& entry) {
+  entry.state = TextureState::Queued;
+  entry.sequence = nextSequence_++;
+  jobs_.push({entry.priority, entry.sequence, id, entry.generation});
+  startDecodeTaskLocked();
+}
+
+void TextureStreamer::setPriority(TextureId id, const StreamingPriority& priority) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(id);
+  if (it == entries_.end()) {
+    return;
+  }
+  auto& entry = it->second;
+  entry.priority = priority;
+  if (entry.state == TextureState::Queued) {
+    // Queue a job with the new priority; the old one is skipped as stale
+    ++entry.generation;
+    enqueueLocked(id, entry);
+  }
+}
+
+void TextureStreamer::release(TextureId id) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(id);
+  if (it == entries_.end()) {
+    return;
+  }
+  residentBytes_ -= it->second.residentBytes;
+  entries_.erase(it);
+}
+
+std::shared_ptr<igl::ITexture> TextureStreamer::getTexture(TextureId id) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(id);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  auto& entry = it->second;
+  entry.lastUsedFrame = frame_;
+  if (entry.state == TextureState::Evicted) {
+    enqueueLocked(id, entry);
+  }
+  return entry.state == TextureState::Resident ? entry.texture : entry.placeholder;
+}
+
+TextureState TextureStreamer::getState(TextureId id) const {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(id);
+  return it == entries_.end() ? TextureState::Invalid : it->second.state;
+}
+
+size_t TextureStreamer::residentBytes() const {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return residentBytes_;
+}
+
+bool TextureStreamer::popJobLocked(Job& outJob) {
+  while (!jobs_.empty()) {
+    outJob = jobs_.top();
+    jobs_.pop();
+    auto it = entries_.find(outJob.id);
+    if (it != entries_.end() && it->second.generation == outJob.generation &&
+        it->second.state == TextureState::Queued) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void TextureStreamer::startDecodeTaskLocked() {
+  if (stopping_) {
+    return;
+  }
+  for (size_t i = 0; i < decodeTasks_.size(); ++i) {
+    auto& task = decodeTasks_[i];
+    if (task.running) {
+      continue;
+    }
+    if (task.future.valid()) {
+      // The previous task stopped running under the lock and only has to return, so this is quick
+      task.future.get();
+    }
+    task.running = true;
+    task.future = textureloader::WorkerPool::shared().async([this, i]() { decodeLoop(i); });
+    return;
+  }
+}
+
+void TextureStreamer::decodeLoop(size_t taskIndex) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  Job job;
+  while (!stopping_ && popJobLocked(job)) {
+    decode(job, lock);
+  }
+  decodeTasks_[taskIndex].running = false;
+}
+
+void TextureStreamer::decode(const Job& job, std::unique_lock<std::mutex>& lock) {
+  auto& entry = entries_.at(job.id);
+  entry.state = TextureState::Decoding;
+  const uint32_t generation = entry.generation;
+  const std::string path = entry.path;
+  // Keeps in-memory data alive while it is decoded without holding the lock
+  const std::shared_ptr<textureloader::IData> source = entry.source;
+
+  lock.unlock();
+  igl::Result result;
+  auto loader = source ? factory_->tryCreate(source->data(), source->length(), &result)
+                       : factory_->tryCreateFromFile(path, &result);
+  auto decoded = loader ? loader->load(&result) : nullptr;
+  lock.lock();
+
+  auto it = entries_.find(job.id);
+  if (it == entries_.end() || it->second.generation != generation) {
+    // Released or evicted while decoding
+    return;
+  }
+  if (!loader || !decoded) {
+    IGL_LOG_ERROR("TextureStreamer: failed to decode texture %u: %s\n",
+                  job.id,
+                  result.message.c_str());
+    it->second.state = TextureState::Failed;
+    return;
+  }
+  it->second.loader = std::move(loader);
+  it->second.decoded = std::move(decoded);
+  it->second.state = TextureState::Decoded;
+}
+
+size_t TextureStreamer::update(igl::ICommandQueue& commandQueue) {
+  std::vector<PendingUpload> pendingUploads;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (decodeTasks_.empty()) {
+      Job job;
+      if (popJobLocked(job)) {
+        decode(job, lock);
+      }
+    }
+    for (const auto& [id, entry] : entries_) {
+      if (entry.state == TextureState::Decoded || entry.state == TextureState::Uploading) {
+        PendingUpload pending;
+        pending.job = {entry.priority, entry.sequence, id, entry.generation};
+        pending.loader = entry.loader;
+        pending.decoded = entry.decoded;
+        pending.placeholder = entry.placeholder;
+        pending.texture = entry.texture;
+        pending.numUploadedMipLevels = entry.numUploadedMipLevels;
+        pendingUploads.push_back(std::move(pending));
+      }
+    }
+  }
+
+  // Upload the most important textures first. Textures are created and uploaded without the lock,
+  // so decode tasks keep publishing decoded textures and picking up new jobs meanwhile.
+  std::sort(pendingUploads.begin(),
+            pendingUploads.end(),
+            [](const PendingUpload& lhs, const PendingUpload& rhs) {
+              return JobOrder()(rhs.job, lhs.job);
+            });
+
+  size_t uploadedBytes = 0;
+  size_t numProcessed = 0;
+  for (; numProcessed < pendingUploads.size(); ++numProcessed) {
+    if (uploadedBytes >= desc_.uploadBudgetBytesPerFrame) {
+      break;
+    }
+    uploadedBytes += upload(pendingUploads[numProcessed],
+                            desc_.uploadBudgetBytesPerFrame - uploadedBytes,
+                            uploadedBytes == 0,
+                            commandQueue);
+  }
+
+  const std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t i = 0; i < numProcessed; ++i) {
+    commitLocked(pendingUploads[i]);
+  }
+  evictLocked();
+  ++frame_;
+
+  return uploadedBytes;
+}
+
+size_t TextureStreamer::upload(PendingUpload& pending,
+                               size_t budget,
+                               bool mustUpload,
+                               igl::ICommandQueue& commandQueue) {
+  const auto& desc = pending.loader->descriptor();
+  const uint8_t* data = pending.decoded->data();
+
+  size_t uploadedBytes = 0;
+  if (!pending.texture) {
+    uploadedBytes += uploadPlaceholder(pending);
+
+    igl::Result result;
+    pending.texture = pending.loader->create(device_, &result);
+    if (!pending.texture || !result.isOk()) {
+      IGL_LOG_ERROR("TextureStreamer: failed to create texture: %s\n", result.message.c_str());
+      pending.failed = true;
+      return uploadedBytes;
+    }
+  }
+
+  if (pending.loader->shouldGenerateMipmaps()) {
+    // Only the base mip level is stored
+    if ((uploadedBytes > 0 || !mustUpload) && uploadedBytes + mipLevelLength(desc, 0) > budget) {
+      return uploadedBytes;
+    }
+    auto result = pending.texture->upload(pending.texture->getFullRange(0), data);
+    if (!result.isOk()) {
+      pending.failed = true;
+      return uploadedBytes;
+    }
+    uploadedBytes += mipLevelLength(desc, 0);
+    pending.texture->generateMipmap(commandQueue);
+    pending.numUploadedMipLevels = desc.numMipLevels;
+  }
+
+  // Smallest mip levels first, so that the finest levels can be spread over several frames
+  while (pending.numUploadedMipLevels < desc.numMipLevels) {
+    const uint32_t mipLevel = desc.numMipLevels - pending.numUploadedMipLevels - 1;
+    const size_t length = mipLevelLength(desc, mipLevel);
+    if ((uploadedBytes > 0 || !mustUpload) && uploadedBytes + length > budget) {
+      return uploadedBytes;
+    }
+    auto result = pending.texture->upload(pending.texture->getFullRange(mipLevel),
+                                          data + mipLevelOffset(desc, mipLevel));
+    if (!result.isOk()) {
+      IGL_LOG_ERROR("TextureStreamer: failed to upload texture: %s\n", result.message.c_str());
+      pending.failed = true;
+      return uploadedBytes;
+    }
+    uploadedBytes += length;
+    ++pending.numUploadedMipLevels;
+  }
+
+  // The full texture is resident, so the placeholder is no longer needed
+  pending.placeholder = nullptr;
+
+  return uploadedBytes;
+}
+
+void TextureStreamer::commitLocked(PendingUpload& pending) {
+  auto it = entries_.find(pending.job.id);
+  if (it == entries_.end() || it->second.generation != pending.job.generation) {
+    // Released while uploading
+    return;
+  }
+  auto& entry = it->second;
+  if (pending.failed) {
+    resetLocked(entry, TextureState::Failed);
+    return;
+  }
+
+  const size_t residentBytes =
+      (pending.texture ? pending.texture->getEstimatedSizeInBytes() : 0) +
+      (pending.placeholder ? pending.placeholder->getEstimatedSizeInBytes() : 0);
+  residentBytes_ = residentBytes_ - entry.residentBytes + residentBytes;
+  entry.residentBytes = residentBytes;
+  entry.texture = std::move(pending.texture);
+  entry.placeholder = std::move(pending.placeholder);
+  entry.numUploadedMipLevels = pending.numUploadedMipLevels;
+
+  if (entry.numUploadedMipLevels < entry.loader->descriptor().numMipLevels) {
+    entry.state = TextureState::Uploading;
+    return;
+  }
+  // The full texture is resident; the decoded data is no longer needed
+  entry.decoded = nullptr;
+  entry.loader = nullptr;
+  entry.state = TextureState::Resident;
+}
+
+size_t TextureStreamer::uploadPlaceholder(PendingUpload& pending) {
+  const auto& desc = pending.loader->descriptor();
+  if (desc_.placeholderMaxDimension == 0 || pending.loader->shouldGenerateMipmaps()) {
+    return 0;
+  }
+
+  uint32_t firstMipLevel = 0;
+  while (firstMipLevel < desc.numMipLevels &&
+         std::max(desc.width >> firstMipLevel, desc.height >> firstMipLevel) >
+             desc_.placeholderMaxDimension) {
+    ++firstMipLevel;
+  }
+  if (firstMipLevel == 0 || firstMipLevel == desc.numMipLevels) {
+    // The texture is either small enough already or has no small mip levels
+    return 0;
+  }
+
+  igl::TextureDesc placeholderDesc = desc;
+  placeholderDesc.width = std::max(desc.width >> firstMipLevel, 1u);
+  placeholderDesc.height = std::max(desc.height >> firstMipLevel, 1u);
+  placeholderDesc.depth = std::max(desc.depth >> firstMipLevel, 1u);
+  placeholderDesc.numMipLevels = desc.numMipLevels - firstMipLevel;
+  placeholderDesc.debugName = desc.debugName + " (placeholder)";
+
+  igl::Result result;
+  auto placeholder = device_.createTexture(placeholderDesc, &result);
+  if (!placeholder || !result.isOk()) {
+    return 0;
+  }
+
+  const uint8_t* data = pending.decoded->data();
+  size_t uploadedBytes = 0;
+  for (uint32_t mipLevel = 0; mipLevel < placeholderDesc.numMipLevels; ++mipLevel) {
+    result = placeholder->upload(placeholder->getFullRange(mipLevel),
+                                 data + mipLevelOffset(desc, firstMipLevel + mipLevel));
+    if (!result.isOk()) {
+      return uploadedBytes;
+    }
+    uploadedBytes += mipLevelLength(desc, firstMipLevel + mipLevel);
+  }
+
+  pending.placeholder = std::move(placeholder);
+  return uploadedBytes;
+}
+
+void TextureStreamer::evictLocked() {
+  while (residentBytes_ > desc_.memoryBudgetBytes) {
+    // Evict the least recently used resident texture that wasn't used during the current frame
+    Entry* leastRecentlyUsed = nullptr;
+    for (auto& [id, entry] : entries_) {
+      if (entry.state == TextureState::Resident && entry.lastUsedFrame < frame_ &&
+          (!leastRecentlyUsed || entry.lastUsedFrame < leastRecentlyUsed->lastUsedFrame)) {
+        leastRecentlyUsed = &entry;
+      }
+    }
+    if (!leastRecentlyUsed) {
+      return;
+    }
+    resetLocked(*leastRecentlyUsed, TextureState::Evicted);
+  }
+}
+
+void TextureStreamer::resetLocked(Entry& entry, TextureState state) {
+  residentBytes_ -= entry.residentBytes;
+  entry.residentBytes = 0;
+  entry.loader = nullptr;
+  entry.decoded = nullptr;
+  entry.placeholder = nullptr;
+  entry.texture = nullptr;
+  entry.numUploadedMipLevels = 0;
+  ++entry.generation;
+  entry.state = state;
+}
+
+} // namespace iglu::texturestreamer
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <IGLU/texture_loader/ITextureLoaderFactory.h>
+#include <IGLU/texture_loader/WorkerPool.h>
+#include <igl/Texture.h>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace igl {
+class ICommandQueue;
+class IDevice;
+} // namespace igl
+
+namespace iglu::texturestreamer {
+
+/// Identifies a texture requested from a TextureStreamer. 0 is never a valid id.
+using TextureId = uint32_t;
+
+/// Describes how urgently a texture is needed.
+struct StreamingPriority {
+  /// Screen-space importance, e.g. the projected size of the objects using the texture. Textures
+  /// with a higher importance are decoded and uploaded first.
+  float importance = 1.0f;
+  /// Finest mip level currently needed. Among textures of equal importance, the ones needing finer
+  /// mip levels are streamed first.
+  uint32_t requestedMipLevel = 0;
+};
+
+enum class TextureState : uint8_t {
+  /// The id is unknown or was released
+  Invalid,
+  /// Waiting to be decoded
+  Queued,
+  /// Being decoded by a worker
+  Decoding,
+  /// Decoded and waiting to be uploaded
+  Decoded,
+  /// Partially uploaded; getTexture() returns a low resolution placeholder if one exists
+  Uploading,
+  /// Fully uploaded
+  Resident,
+  /// Evicted to stay within the memory budget; requested again by the next getTexture()
+  Evicted,
+  /// Decoding or uploading failed
+  Failed,
+};
+
+struct TextureStreamerDesc {
+  /// Maximum number of textures decoded at once on the shared WorkerPool. With 0, update() decodes
+  /// the most important queued texture itself, which keeps headless tests deterministic.
+  uint32_t maxConcurrentDecodes = 2;
+  /// Bytes uploaded per update(). At least one mip level is uploaded per update() regardless.
+  size_t uploadBudgetBytesPerFrame = 8u * 1024u * 1024u;
+  /// Once resident textures exceed this many bytes, the least recently used ones are evicted.
+  size_t memoryBudgetBytes = 256u * 1024u * 1024u;
+  /// Mip levels with both dimensions at most this size are uploaded first into a placeholder
+  /// texture, which is returned until the full texture is resident. 0 disables placeholders.
+  uint32_t placeholderMaxDimension = 64;
+};
+
+/**
+ * @brief Streams textures asynchronously on top of ITextureLoader.
+ *
+ * Textures are decoded on the shared WorkerPool in priority order. update() must be called once
+ * per frame on the thread owning the device; it creates GPU textures and uploads decoded mip levels
+ * within a per-frame byte budget, smallest levels first, and evicts the least recently used
+ * textures when over the memory budget. All other methods may be called from any thread.
+ */
+class TextureStreamer final {
+ public:
+  TextureStreamer(igl::IDevice& device,
+                  std::unique_ptr<textureloader::ITextureLoaderFactory> factory,
+                  const TextureStreamerDesc& desc = {});
+  ~TextureStreamer();
+
+  TextureStreamer(const TextureStreamer&) = delete;
+  TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+  /// Requests the texture stored in the file at `path`.
+  [[nodiscard]] TextureId request(std::string path, const StreamingPriority& priority = {});
+  /// Requests the texture stored in `data`.
+  [[nodiscard]] TextureId request(std::unique_ptr<textureloader::IData> data,
+                                  const StreamingPriority& priority = {});
+
+  void setPriority(TextureId id, const StreamingPriority& priority);
+  void release(TextureId id);
+
+  /// Returns the resident texture, or its placeholder while it is being uploaded, or nullptr.
+  /// Marks the texture as used in the current frame.
+  [[nodiscard]] std::shared_ptr<igl::ITexture> getTexture(TextureId id);
+  [[nodiscard]] TextureState getState(TextureId id) const;
+
+  /// Uploads decoded textures within the per-frame budget and evicts textures over the memory
+  /// budget. `commandQueue` is used to generate mipmaps for formats that don't store them.
+  /// Returns the number of bytes uploaded.
+  size_t update(igl::ICommandQueue& commandQueue);
+
+  [[nodiscard]] size_t residentBytes() const;
+
+ private:
+  struct Entry {
+    std::string path;
+    std::shared_ptr<textureloader::IData> source;
+    StreamingPriority priority;
+    TextureState state = TextureState::Queued;
+    // Incremented whenever pending work for the entry becomes stale
+    uint32_t generation = 0;
+    // Sequence of the latest job queued for the entry, which orders entries of equal priority
+    uint64_t sequence = 0;
+    uint64_t lastUsedFrame = 0;
+    // Shared with update(), which uploads without holding the lock
+    std::shared_ptr<textureloader::ITextureLoader> loader;
+    std::shared_ptr<textureloader::IData> decoded;
+    std::shared_ptr<igl::ITexture> placeholder;
+    std::shared_ptr<igl::ITexture> texture;
+    // Mip levels of the full texture are uploaded from the smallest one up to level 0
+    uint32_t numUploadedMipLevels = 0;
+    size_t residentBytes = 0;
+  };
+
+  struct Job {
+    StreamingPriority priority;
+    uint64_t sequence = 0;
+    TextureId id = 0;
+    uint32_t generation = 0;
+  };
+
+  struct JobOrder {
+    bool operator()(const Job& lhs, const Job& rhs) const noexcept;
+  };
+
+  // Pool task decoding queued jobs until none are left
+  struct DecodeTask {
+    textureloader::WorkerPool::TaskFuture<void> future;
+    bool running = false;
+  };
+
+  // Snapshot of a decoded entry that update() uploads without holding the lock. The results are
+  // committed to the entry afterwards unless it was released or evicted in the meantime.
+  struct PendingUpload {
+    Job job;
+    std::shared_ptr<textureloader::ITextureLoader> loader;
+    std::shared_ptr<textureloader::IData> decoded;
+    std::shared_ptr<igl::ITexture> placeholder;
+    std::shared_ptr<igl::ITexture> texture;
+    uint32_t numUploadedMipLevels = 0;
+    bool failed = false;
+  };
+
+  TextureId addEntry(Entry entry);
+  void enqueueLocked(TextureId id, Entry& entry);
+  [[nodiscard]] bool popJobLocked(Job& outJob);
+  void startDecodeTaskLocked();
+  void decodeLoop(size_t taskIndex);
+  void decode(const Job& job, std::unique_lock<std::mutex>& lock);
+  [[nodiscard]] size_t upload(PendingUpload& pending,
+                              size_t budget,
+                              bool mustUpload,
+                              igl::ICommandQueue& commandQueue);
+  [[nodiscard]] size_t uploadPlaceholder(PendingUpload& pending);
+  void commitLocked(PendingUpload& pending);
+  void evictLocked();
+  void resetLocked(Entry& entry, TextureState state);
+
+  igl::IDevice& device_;
+  std::unique_ptr<textureloader::ITextureLoaderFactory> factory_;
+  TextureStreamerDesc desc_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<TextureId, Entry> entries_;
+  std::priority_queue<Job, std::vector<Job>, JobOrder> jobs_;
+  std::vector<DecodeTask> decodeTasks_;
+  TextureId nextId_ = 1;
+  uint64_t nextSequence_ = 0;
+  uint64_t frame_ = 0;
+  size_t residentBytes_ = 0;
+  bool stopping_ = false;
+};
+
+} // namespace iglu::texturestreamer
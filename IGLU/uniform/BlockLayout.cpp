@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/uniform/BlockLayout.h>
+
+#include <IGLU/uniform/Collection.h>
+#include <IGLU/uniform/Descriptor.h>
+#include <algorithm>
+#include <cstring>
+
+namespace iglu::uniform {
+
+namespace {
+
+size_t alignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+struct ElementLayout {
+  size_t alignment = 0;
+  size_t size = 0;
+  uint32_t numColumns = 1;
+  size_t columnSize = 0;
+  size_t columnStride = 0;
+};
+
+ElementLayout elementLayout(igl::UniformType type, BlockLayout::Standard standard) {
+  const bool isStd140 = standard == BlockLayout::Standard::Std140;
+  switch (type) {
+  case igl::UniformType::Float:
+  case igl::UniformType::Int:
+  case igl::UniformType::Boolean: // bools take 4 bytes in uniform blocks
+    return {4, 4, 1, 4, 4};
+  case igl::UniformType::Float2:
+  case igl::UniformType::Int2:
+    return {8, 8, 1, 8, 8};
+  case igl::UniformType::Float3:
+  case igl::UniformType::Int3:
+    return {16, 12, 1, 12, 16};
+  case igl::UniformType::Float4:
+  case igl::UniformType::Int4:
+    return {16, 16, 1, 16, 16};
+  case igl::UniformType::Mat2x2:
+    // Matrices are laid out as arrays of their columns
+    return isStd140 ? ElementLayout{16, 32, 2, 8, 16} : ElementLayout{8, 16, 2, 8, 8};
+  case igl::UniformType::Mat3x3:
+    return {16, 48, 3, 12, 16};
+  case igl::UniformType::Mat4x4:
+    return {16, 64, 4, 16, 16};
+  default:
+    IGL_DEBUG_ASSERT_NOT_REACHED();
+    return {4, 0, 1, 0, 0};
+  }
+}
+
+BlockLayout::Member makeMember(const igl::NameHandle& name,
+                               igl::UniformType type,
+                               size_t arrayLength,
+                               BlockLayout::Standard standard,
+                               size_t& inOutOffset) {
+  const ElementLayout element = elementLayout(type, standard);
+  size_t alignment = element.alignment;
+  size_t arrayStride = element.size;
+  if (arrayLength > 1 || element.numColumns > 1) {
+    if (standard == BlockLayout::Standard::Std140) {
+      // Array elements and matrix columns are rounded up to 16 bytes
+      alignment = alignUp(alignment, 16);
+    }
+    arrayStride = alignUp(element.size, alignment);
+  }
+
+  BlockLayout::Member member;
+  member.name = name;
+  member.type = type;
+  member.offset = alignUp(inOutOffset, alignment);
+  member.arrayLength = arrayLength;
+  member.arrayStride = arrayStride;
+  member.numColumns = element.numColumns;
+  member.columnSize = element.columnSize;
+  member.columnStride = element.columnStride;
+  inOutOffset = member.offset + (arrayLength > 1 ? arrayStride * arrayLength : element.size);
+  return member;
+}
+
+} // namespace
+
+BlockLayout BlockLayout::fromReflection(const igl::BufferArgDesc& bufferDesc, Standard standard) {
+  BlockLayout layout;
+  layout.bufferIndex = bufferDesc.bufferIndex;
+  layout.members.reserve(bufferDesc.members.size());
+  for (const auto& memberDesc : bufferDesc.members) {
+    size_t offset = memberDesc.offset;
+    auto member =
+        makeMember(memberDesc.name, memberDesc.type, memberDesc.arrayLength, standard, offset);
+    member.offset = memberDesc.offset;
+    layout.size = std::max(layout.size, offset);
+    layout.members.push_back(std::move(member));
+  }
+  layout.size = std::max(layout.size, bufferDesc.bufferDataSize);
+  return layout;
+}
+
+BlockLayout BlockLayout::fromCollection(const Collection& collection,
+                                        const std::vector<igl::NameHandle>& uniformNames,
+                                        int bufferIndex,
+                                        Standard standard) {
+  BlockLayout layout;
+  layout.bufferIndex = bufferIndex;
+  layout.members.reserve(uniformNames.size());
+  size_t offset = 0;
+  for (const auto& name : uniformNames) {
+    const Descriptor& uniform = collection.get(name);
+    layout.members.push_back(makeMember(name, uniform.getType(), uniform.size(), standard, offset));
+  }
+  // The block itself is aligned like a vec4
+  layout.size = alignUp(offset, 16);
+  return layout;
+}
+
+void BlockLayout::write(const Collection& collection, uint8_t* outData) const noexcept {
+  for (const auto& member : members) {
+    if (!collection.contains(member.name)) {
+      continue;
+    }
+    const Descriptor& uniform = collection.get(member.name);
+    if (!IGL_DEBUG_VERIFY(uniform.getType() == member.type)) {
+      continue;
+    }
+
+    const auto* src = static_cast<const uint8_t*>(uniform.data(Alignment::Packed));
+    uint8_t* dst = outData + member.offset;
+    const size_t count = std::min(uniform.size(), member.arrayLength);
+
+    if (member.type == igl::UniformType::Boolean) {
+      for (size_t i = 0; i < count; ++i) {
+        const uint32_t value = src[i] != 0 ? 1u : 0u;
+        std::memcpy(dst + i * member.arrayStride, &value, sizeof(value));
+      }
+      continue;
+    }
+
+    const size_t elementSize = member.columnSize * member.numColumns;
+    if (member.columnStride == member.columnSize && member.arrayStride == elementSize) {
+      // Tightly packed in the block too, e.g. arrays of vec4 and mat4
+      std::memcpy(dst, src, elementSize * count);
+      continue;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      for (uint32_t column = 0; column < member.numColumns; ++column) {
+        std::memcpy(dst + i * member.arrayStride + column * member.columnStride,
+                    src + (i * member.numColumns + column) * member.columnSize,
+                    member.columnSize);
+      }
+    }
+  }
+}
+
+} // namespace iglu::uniform
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <igl/NameHandle.h>
+#include <igl/RenderPipelineReflection.h>
+#include <igl/Uniform.h>
+#include <vector>
+
+namespace iglu::uniform {
+
+struct Collection;
+
+// BlockLayout
+//
+// Places the uniforms of a Collection in a uniform block following std140 or std430 rules.
+// It's built once, e.g. from pipeline reflection, and then writes the whole collection into one
+// contiguous block of memory per draw. See CollectionEncoder for binding it.
+//
+// Metal lays out buffers like std430, except that 3 component vectors take 16 bytes; using
+// fromReflection() with Std430 covers both.
+struct BlockLayout {
+  enum class Standard { Std140, Std430 };
+
+  struct Member {
+    igl::NameHandle name;
+    igl::UniformType type = igl::UniformType::Invalid;
+    size_t offset = 0;
+    size_t arrayLength = 1;
+    size_t arrayStride = 0;
+    // Matrices are written one column at a time, other types as a single column
+    uint32_t numColumns = 1;
+    size_t columnSize = 0;
+    size_t columnStride = 0;
+  };
+
+  std::vector<Member> members;
+  size_t size = 0;
+  // On OpenGL, the binding point of the uniform block
+  int bufferIndex = -1;
+
+  // Uses the member offsets reported by reflection, e.g. by
+  // igl::IRenderPipelineReflection::allUniformBuffers()
+  static BlockLayout fromReflection(const igl::BufferArgDesc& bufferDesc,
+                                    Standard standard = Standard::Std140);
+
+  // Lays out 'uniformNames' of 'collection' in order, matching a uniform block declaring the same
+  // members in the same order
+  static BlockLayout fromCollection(const Collection& collection,
+                                    const std::vector<igl::NameHandle>& uniformNames,
+                                    int bufferIndex,
+                                    Standard standard = Standard::Std140);
+
+  // Writes the members of the layout found in 'collection' into 'outData', which must hold 'size'
+  // bytes. Bytes of missing members and padding are left untouched.
+  void write(const Collection& collection, uint8_t* outData) const noexcept;
+};
+
+} // namespace iglu::uniform
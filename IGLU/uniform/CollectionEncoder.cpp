@@ -7,8 +7,11 @@
 
 #include <IGLU/uniform/CollectionEncoder.h>
 
+#include <IGLU/uniform/BlockLayout.h>
 #include <IGLU/uniform/Collection.h>
 #include <IGLU/uniform/Encoder.h>
+#include <IGLU/uniform/TransientBuffer.h>
+#include <igl/RenderCommandEncoder.h>
 
 namespace iglu::uniform {
 
@@ -25,4 +28,28 @@ void CollectionEncoder::operator()(
   }
 }
 
+void CollectionEncoder::operator()(const Collection& collection,
+                                   igl::IRenderCommandEncoder& commandEncoder,
+                                   const BlockLayout& layout,
+                                   TransientBuffer& transientBuffer) const noexcept {
+  if (!IGL_DEBUG_VERIFY(layout.bufferIndex >= 0)) {
+    return;
+  }
+
+  uint8_t* data = transientBuffer.scratch(layout.size);
+  layout.write(collection, data);
+
+  igl::Result result;
+  const size_t offset = transientBuffer.upload(data, layout.size, &result);
+  if (!result.isOk()) {
+    IGL_LOG_ERROR_ONCE("[IGL][Error] Failed to upload uniform block: %s\n",
+                       result.message.c_str());
+    return;
+  }
+  commandEncoder.bindBuffer(static_cast<uint32_t>(layout.bufferIndex),
+                            &transientBuffer.buffer(),
+                            offset,
+                            layout.size);
+}
+
 } // namespace iglu::uniform
@@ -17,11 +17,14 @@ class IRenderCommandEncoder;
 
 namespace iglu::uniform {
 
+struct BlockLayout;
 struct Collection;
+class TransientBuffer;
 
 // CollectionEncoder
 //
-// Submits uniforms corresponding to uniformNames in the source collection
+// Submits uniforms corresponding to uniformNames in the source collection, either one by one or
+// packed into a single uniform block
 //
 class CollectionEncoder {
  public:
@@ -32,6 +35,14 @@ class CollectionEncoder {
                   uint8_t bindTarget,
                   const std::vector<igl::NameHandle>& uniformNames) const noexcept;
 
+  // Writes the members of 'layout' found in the source collection into one slice of
+  // 'transientBuffer' and binds it as a single uniform buffer at layout.bufferIndex. This is the
+  // only mode supported on Vulkan.
+  void operator()(const Collection& collection,
+                  igl::IRenderCommandEncoder& commandEncoder,
+                  const BlockLayout& layout,
+                  TransientBuffer& transientBuffer) const noexcept;
+
  private:
   igl::BackendType backendType_;
 };
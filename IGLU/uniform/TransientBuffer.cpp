@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/uniform/TransientBuffer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <igl/Buffer.h>
+#include <igl/Device.h>
+
+namespace iglu::uniform {
+
+TransientBuffer::TransientBuffer(igl::IDevice& device, size_t capacity) : capacity_(capacity) {
+  size_t alignment = 0;
+  if (device.getFeatureLimits(igl::DeviceFeatureLimits::BufferAlignment, alignment) &&
+      alignment > 0) {
+    alignment_ = alignment;
+  }
+
+  igl::BufferDesc desc;
+  desc.length = capacity;
+  desc.storage = igl::ResourceStorage::Shared;
+  desc.type = igl::BufferDesc::BufferTypeBits::Uniform;
+  desc.hint = igl::BufferDesc::BufferAPIHintBits::UniformBlock;
+  if (device.getBackendType() == igl::BackendType::Metal ||
+      device.getBackendType() == igl::BackendType::Vulkan) {
+    // One copy per frame in flight, so slices of the previous frames aren't overwritten
+    desc.hint |= igl::BufferDesc::BufferAPIHintBits::Ring;
+  }
+  igl::Result result;
+  buffer_ = device.createBuffer(desc, &result);
+  IGL_DEBUG_ASSERT(result.isOk(), result.message.c_str());
+}
+
+uint8_t* TransientBuffer::scratch(size_t size) {
+  scratch_.resize(std::max(scratch_.size(), size));
+  std::memset(scratch_.data(), 0, size);
+  return scratch_.data();
+}
+
+size_t TransientBuffer::upload(const void* data, size_t size, igl::Result* outResult) {
+  if (!buffer_) {
+    igl::Result::setResult(outResult, igl::Result::Code::RuntimeError, "No buffer.");
+    return 0;
+  }
+  const size_t offset = (offset_ + alignment_ - 1) / alignment_ * alignment_;
+  if (offset + size > capacity_) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::ArgumentOutOfRange, "Transient buffer is full.");
+    return 0;
+  }
+
+  const auto result = buffer_->upload(data, igl::BufferRange(size, offset));
+  if (!result.isOk()) {
+    igl::Result::setResult(outResult, result);
+    return 0;
+  }
+  offset_ = offset + size;
+  igl::Result::setOk(outResult);
+  return offset;
+}
+
+void TransientBuffer::reset() noexcept {
+  offset_ = 0;
+}
+
+} // namespace iglu::uniform
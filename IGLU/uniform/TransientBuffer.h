@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <igl/Common.h>
+#include <memory>
+#include <vector>
+
+namespace igl {
+class IBuffer;
+class IDevice;
+} // namespace igl
+
+namespace iglu::uniform {
+
+// TransientBuffer
+//
+// A uniform buffer handing out one slice per draw, for uniforms written every frame. Slices are
+// placed one after the other, aligned as the device requires, and the buffer starts over on
+// reset(), which must be called once per frame before the first upload.
+class TransientBuffer {
+ public:
+  explicit TransientBuffer(igl::IDevice& device, size_t capacity = 64 * 1024);
+
+  // Returns zeroed CPU memory to assemble 'size' bytes in, valid until the next call
+  [[nodiscard]] uint8_t* scratch(size_t size);
+
+  // Uploads 'size' bytes of 'data' to the next slice and returns the slice's offset
+  size_t upload(const void* data, size_t size, igl::Result* outResult);
+
+  void reset() noexcept;
+
+  [[nodiscard]] igl::IBuffer& buffer() const noexcept {
+    return *buffer_;
+  }
+
+ private:
+  std::shared_ptr<igl::IBuffer> buffer_;
+  size_t capacity_ = 0;
+  size_t alignment_ = 1;
+  size_t offset_ = 0;
+  std::vector<uint8_t> scratch_;
+};
+
+} // namespace iglu::uniform
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <shell/shared/benchmark/FrameStatistics.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace igl::shell {
+namespace {
+
+FrameStatistics createStatistics() {
+  FrameStatistics statistics;
+  statistics.addSample({1.5, 0.5, 10, 20});
+  statistics.addSample({2.5, 1.5, 12, 0});
+  return statistics;
+}
+
+} // namespace
+
+TEST(FrameStatisticsTest, SummarizeInterpolatesPercentiles) {
+  // Shuffled, as samples are sorted before ranking
+  std::vector<double> values;
+  for (int i = 100; i > 0; i -= 2) {
+    values.push_back(i);
+  }
+  for (int i = 1; i < 100; i += 2) {
+    values.push_back(i);
+  }
+
+  const auto summary = FrameStatistics::summarize(values);
+  EXPECT_DOUBLE_EQ(summary.min, 1.0);
+  EXPECT_DOUBLE_EQ(summary.max, 100.0);
+  EXPECT_DOUBLE_EQ(summary.mean, 50.5);
+  EXPECT_NEAR(summary.p50, 50.5, 1e-9);
+  EXPECT_NEAR(summary.p90, 90.1, 1e-9);
+  EXPECT_NEAR(summary.p95, 95.05, 1e-9);
+  EXPECT_NEAR(summary.p99, 99.01, 1e-9);
+}
+
+TEST(FrameStatisticsTest, SummarizeFewValues) {
+  const auto empty = FrameStatistics::summarize({});
+  EXPECT_EQ(empty.min, 0.0);
+  EXPECT_EQ(empty.p99, 0.0);
+  EXPECT_EQ(empty.max, 0.0);
+
+  const auto single = FrameStatistics::summarize({4.0});
+  EXPECT_EQ(single.min, 4.0);
+  EXPECT_EQ(single.p50, 4.0);
+  EXPECT_EQ(single.p99, 4.0);
+  EXPECT_EQ(single.max, 4.0);
+}
+
+TEST(FrameStatisticsTest, SummariesPerMeasurement) {
+  const auto statistics = createStatistics();
+  EXPECT_DOUBLE_EQ(statistics.cpuTime().mean, 2.0);
+  EXPECT_DOUBLE_EQ(statistics.gpuDrainTime().max, 1.5);
+  EXPECT_DOUBLE_EQ(statistics.frameTime().min, 2.0);
+  EXPECT_DOUBLE_EQ(statistics.frameTime().max, 4.0);
+  EXPECT_DOUBLE_EQ(statistics.drawCount().p50, 11.0);
+  EXPECT_DOUBLE_EQ(statistics.callCount().min, 0.0);
+}
+
+TEST(FrameStatisticsTest, WriteCsv) {
+  std::ostringstream os;
+  createStatistics().writeCsv(os);
+  EXPECT_EQ(os.str(),
+            "frame,cpuMs,gpuDrainMs,frameMs,drawCount,callCount\n"
+            "0,1.5,0.5,2,10,20\n"
+            "1,2.5,1.5,4,12,0\n");
+}
+
+TEST(FrameStatisticsTest, WriteJson) {
+  std::ostringstream os;
+  createStatistics().writeJson(os, "my\"session", "vulkan");
+  const std::string json = os.str();
+
+  EXPECT_NE(json.find("\"session\": \"my\\\"session\""), std::string::npos) << json;
+  EXPECT_NE(json.find("\"backend\": \"vulkan\""), std::string::npos) << json;
+  EXPECT_NE(json.find("\"frames\": 2"), std::string::npos) << json;
+  EXPECT_NE(json.find("\"drawCount\": {\"min\": 10, \"mean\": 11, \"p50\": 11, \"p90\": 11.8, "
+                      "\"p95\": 11.9, \"p99\": 11.98, \"max\": 12}"),
+            std::string::npos)
+      << json;
+  EXPECT_NE(json.find("{\"cpuMs\": 1.5, \"gpuDrainMs\": 0.5, \"drawCount\": 10, "
+                      "\"callCount\": 20},\n"),
+            std::string::npos)
+      << json;
+  EXPECT_NE(json.find("{\"cpuMs\": 2.5, \"gpuDrainMs\": 1.5, \"drawCount\": 12, "
+                      "\"callCount\": 0}\n  ]\n}\n"),
+            std::string::npos)
+      << json;
+}
+
+} // namespace igl::shell
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <shell/shared/benchmark/BenchmarkRunner.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <igl/IGL.h>
+#include <iostream>
+#include <shell/shared/platform/Platform.h>
+#include <shell/shared/renderSession/AppParams.h>
+#include <shell/shared/renderSession/DefaultRenderSessionFactory.h>
+#include <shell/shared/renderSession/RenderSession.h>
+#include <shell/shared/renderSession/ShellParams.h>
+#include <string_view>
+
+namespace igl::shell {
+
+namespace {
+
+bool parseSize(std::string_view arg, std::string_view name, size_t& outValue) {
+  if (arg.substr(0, name.size()) != name) {
+    return false;
+  }
+  const std::string value(arg.substr(name.size()));
+  outValue = static_cast<size_t>(std::strtoull(value.c_str(), nullptr, 10));
+  return true;
+}
+
+bool endsWith(const std::string& str, std::string_view suffix) {
+  return str.size() >= suffix.size() &&
+         std::string_view(str).substr(str.size() - suffix.size()) == suffix;
+}
+
+std::string getExecutableName(int argc, char* argv[]) {
+  if (argc < 1 || argv == nullptr || argv[0] == nullptr) {
+    return {};
+  }
+  const std::string path(argv[0]);
+  const size_t slash = path.find_last_of("/\\");
+  return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+} // namespace
+
+BenchmarkConfig BenchmarkConfig::fromCommandLine(int argc, char* argv[]) {
+  BenchmarkConfig config;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg(argv[i]);
+    size_t value = 0;
+    if (parseSize(arg, "--warmup-frames=", value)) {
+      config.warmupFrames = value;
+    } else if (parseSize(arg, "--frames=", value)) {
+      config.measuredFrames = value;
+    } else if (parseSize(arg, "--width=", value)) {
+      config.width = static_cast<uint32_t>(value);
+    } else if (parseSize(arg, "--height=", value)) {
+      config.height = static_cast<uint32_t>(value);
+    } else if (arg == "--software-device") {
+      config.softwareDevice = true;
+    } else if (arg.substr(0, 9) == "--output=") {
+      config.outputPath = std::string(arg.substr(9));
+    }
+  }
+  return config;
+}
+
+BenchmarkRunner::BenchmarkRunner(std::shared_ptr<Platform> platform,
+                                 BenchmarkConfig config,
+                                 CallCounter callCounter) :
+  platform_(std::move(platform)),
+  config_(std::move(config)),
+  callCounter_(std::move(callCounter)) {}
+
+FrameStatistics BenchmarkRunner::run(RenderSession& session, Result* IGL_NULLABLE outResult) {
+  FrameStatistics statistics;
+  auto& device = platform_->getDevice();
+
+  Result result;
+  const DeviceScope scope(device);
+
+  TextureDesc colorDesc = TextureDesc::new2D(
+      device.getBackendType() == BackendType::Metal ? TextureFormat::BGRA_SRGB
+                                                    : TextureFormat::RGBA_SRGB,
+      config_.width,
+      config_.height,
+      TextureDesc::TextureUsageBits::Sampled | TextureDesc::TextureUsageBits::Attachment,
+      "BenchmarkRunner::color");
+  auto color = device.createTexture(colorDesc, &result);
+  if (!result.isOk()) {
+    Result::setResult(outResult, std::move(result));
+    return statistics;
+  }
+  TextureDesc depthDesc = TextureDesc::new2D(TextureFormat::Z_UNorm24,
+                                             config_.width,
+                                             config_.height,
+                                             TextureDesc::TextureUsageBits::Attachment,
+                                             "BenchmarkRunner::depth");
+  depthDesc.storage = ResourceStorage::Private;
+  auto depth = device.createTexture(depthDesc, &result);
+  if (!result.isOk()) {
+    Result::setResult(outResult, std::move(result));
+    return statistics;
+  }
+
+  // Waiting on an empty command buffer submitted after the session's own work tells when the
+  // device has drained the frame
+  auto commandQueue = device.createCommandQueue({CommandQueueType::Graphics}, &result);
+  if (!result.isOk()) {
+    Result::setResult(outResult, std::move(result));
+    return statistics;
+  }
+
+  ShellParams shellParams;
+  shellParams.viewportSize = glm::vec2(config_.width, config_.height);
+  shellParams.nativeSurfaceDimensions = glm::ivec2(config_.width, config_.height);
+  shellParams.shouldPresent = false;
+  session.setShellParams(shellParams);
+  session.initialize();
+
+  statistics.reserve(config_.measuredFrames);
+  const size_t numFrames = config_.warmupFrames + config_.measuredFrames;
+  for (size_t frame = 0; frame < numFrames && !session.appParams().exitRequested; ++frame) {
+    const size_t drawCountBefore = device.getCurrentDrawCount();
+    const uint64_t callCountBefore = callCounter_ ? callCounter_() : 0;
+
+    const double start = RenderSession::getSeconds();
+    session.update({color, depth});
+    const double encoded = RenderSession::getSeconds();
+    auto commandBuffer = commandQueue->createCommandBuffer({}, nullptr);
+    commandQueue->submit(*commandBuffer);
+    commandBuffer->waitUntilCompleted();
+    const double completed = RenderSession::getSeconds();
+
+    if (frame < config_.warmupFrames) {
+      continue;
+    }
+    FrameSample sample;
+    sample.cpuMs = (encoded - start) * 1000.0;
+    sample.gpuDrainMs = (completed - encoded) * 1000.0;
+    sample.drawCount = device.getCurrentDrawCount() - drawCountBefore;
+    sample.callCount = callCounter_ ? callCounter_() - callCountBefore : 0;
+    statistics.addSample(sample);
+  }
+
+  session.teardown();
+  Result::setOk(outResult);
+  return statistics;
+}
+
+Result BenchmarkRunner::writeStatistics(const FrameStatistics& statistics,
+                                        const std::string& session,
+                                        const std::string& backend) const {
+  if (config_.outputPath.empty()) {
+    statistics.writeJson(std::cout, session, backend);
+    return Result();
+  }
+  std::ofstream file(config_.outputPath);
+  if (!file) {
+    return Result(Result::Code::RuntimeError, "Cannot open " + config_.outputPath);
+  }
+  if (endsWith(config_.outputPath, ".csv")) {
+    statistics.writeCsv(file);
+  } else {
+    statistics.writeJson(file, session, backend);
+  }
+  return file ? Result() : Result(Result::Code::RuntimeError, "Cannot write " + config_.outputPath);
+}
+
+int runBenchmark(int argc,
+                 char* argv[],
+                 std::shared_ptr<Platform> platform,
+                 const BenchmarkConfig& config,
+                 const std::string& backend,
+                 BenchmarkRunner::CallCounter callCounter) {
+  if (!platform) {
+    IGL_LOG_ERROR("Could not create a %s device\n", backend.c_str());
+    return -1;
+  }
+  Platform::initializeCommandLineArgs(argc, argv);
+
+  auto factory = createDefaultRenderSessionFactory();
+  auto session = factory->createRenderSession(platform);
+  if (IGL_DEBUG_VERIFY_NOT(!session)) {
+    return -1;
+  }
+
+  BenchmarkRunner runner(std::move(platform), config, std::move(callCounter));
+  Result result;
+  const auto statistics = runner.run(*session, &result);
+  session.reset();
+  if (!result.isOk()) {
+    IGL_LOG_ERROR("Benchmark failed: %s\n", result.message.c_str());
+    return -1;
+  }
+
+  const std::string sessionName = getExecutableName(argc, argv);
+  result = runner.writeStatistics(statistics, sessionName, backend);
+  if (!result.isOk()) {
+    IGL_LOG_ERROR("%s\n", result.message.c_str());
+    return -1;
+  }
+
+  const auto frameTime = statistics.frameTime();
+  IGL_LOG_INFO("%s (%s): %zu frames, frame time p50 %.3f ms, p99 %.3f ms\n",
+               sessionName.c_str(),
+               backend.c_str(),
+               statistics.samples().size(),
+               frameTime.p50,
+               frameTime.p99);
+  return 0;
+}
+
+} // namespace igl::shell
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <igl/Common.h>
+#include <memory>
+#include <shell/shared/benchmark/FrameStatistics.h>
+#include <string>
+
+namespace igl::shell {
+
+class Platform;
+class RenderSession;
+
+struct BenchmarkConfig {
+  /// Frames rendered before measuring, to let caches, pipelines and drivers settle.
+  size_t warmupFrames = 60;
+  size_t measuredFrames = 600;
+  uint32_t width = 1024;
+  uint32_t height = 768;
+  /// Selects a software rasterizer such as lavapipe or llvmpipe when the backend has a choice.
+  bool softwareDevice = false;
+  /// Statistics are written as CSV if the path ends with ".csv" and as JSON otherwise. An empty
+  /// path writes JSON to stdout.
+  std::string outputPath;
+
+  /// Parses --warmup-frames=N, --frames=N, --width=N, --height=N, --software-device and
+  /// --output=PATH; unknown arguments are ignored.
+  [[nodiscard]] static BenchmarkConfig fromCommandLine(int argc, char* argv[]);
+};
+
+/// Runs a render session offscreen for a fixed number of frames and records per-frame timings
+/// and draw/call counts. The session renders into offscreen color and depth textures and never
+/// presents, so no window or swapchain is needed.
+class BenchmarkRunner {
+ public:
+  /// Returns the number of backend API calls made so far.
+  using CallCounter = std::function<uint64_t()>;
+
+  BenchmarkRunner(std::shared_ptr<Platform> platform,
+                  BenchmarkConfig config,
+                  CallCounter callCounter = nullptr);
+
+  /// Initializes the session, renders the warm-up and measured frames and tears it down.
+  [[nodiscard]] FrameStatistics run(RenderSession& session, Result* IGL_NULLABLE outResult);
+
+  /// Writes `statistics` to BenchmarkConfig::outputPath.
+  [[nodiscard]] Result writeStatistics(const FrameStatistics& statistics,
+                                       const std::string& session,
+                                       const std::string& backend) const;
+
+ private:
+  std::shared_ptr<Platform> platform_;
+  BenchmarkConfig config_;
+  CallCounter callCounter_;
+};
+
+/// Entry point shared by the headless benchmark apps: benchmarks the session returned by
+/// createDefaultRenderSessionFactory() and writes its statistics. Returns the process exit code.
+int runBenchmark(int argc,
+                 char* argv[],
+                 std::shared_ptr<Platform> platform,
+                 const BenchmarkConfig& config,
+                 const std::string& backend,
+                 BenchmarkRunner::CallCounter callCounter = nullptr);
+
+} // namespace igl::shell
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <shell/shared/benchmark/FrameStatistics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace igl::shell {
+
+namespace {
+
+double percentile(const std::vector<double>& sorted, double p) {
+  const double rank = p * static_cast<double>(sorted.size() - 1);
+  const auto lower = static_cast<size_t>(std::floor(rank));
+  const size_t upper = std::min(lower + 1, sorted.size() - 1);
+  return sorted[lower] + (sorted[upper] - sorted[lower]) * (rank - static_cast<double>(lower));
+}
+
+std::string escapeJson(const std::string& str) {
+  std::string result;
+  result.reserve(str.size());
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+    }
+    result += c;
+  }
+  return result;
+}
+
+void writeSummaryJson(std::ostream& os, const char* name, const FrameStatisticsSummary& s) {
+  os << "    \"" << name << "\": {\"min\": " << s.min << ", \"mean\": " << s.mean
+     << ", \"p50\": " << s.p50 << ", \"p90\": " << s.p90 << ", \"p95\": " << s.p95
+     << ", \"p99\": " << s.p99 << ", \"max\": " << s.max << "}";
+}
+
+} // namespace
+
+void FrameStatistics::reserve(size_t numSamples) {
+  samples_.reserve(numSamples);
+}
+
+void FrameStatistics::addSample(const FrameSample& sample) {
+  samples_.push_back(sample);
+}
+
+FrameStatisticsSummary FrameStatistics::summarize(std::vector<double> values) {
+  FrameStatisticsSummary summary;
+  if (values.empty()) {
+    return summary;
+  }
+  std::sort(values.begin(), values.end());
+  summary.min = values.front();
+  summary.max = values.back();
+  summary.mean =
+      std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+  summary.p50 = percentile(values, 0.50);
+  summary.p90 = percentile(values, 0.90);
+  summary.p95 = percentile(values, 0.95);
+  summary.p99 = percentile(values, 0.99);
+  return summary;
+}
+
+template<typename T>
+FrameStatisticsSummary FrameStatistics::summarize(T FrameSample::* member) const {
+  std::vector<double> values;
+  values.reserve(samples_.size());
+  for (const auto& sample : samples_) {
+    values.push_back(static_cast<double>(sample.*member));
+  }
+  return summarize(std::move(values));
+}
+
+FrameStatisticsSummary FrameStatistics::cpuTime() const {
+  return summarize(&FrameSample::cpuMs);
+}
+
+FrameStatisticsSummary FrameStatistics::gpuDrainTime() const {
+  return summarize(&FrameSample::gpuDrainMs);
+}
+
+FrameStatisticsSummary FrameStatistics::frameTime() const {
+  std::vector<double> values;
+  values.reserve(samples_.size());
+  for (const auto& sample : samples_) {
+    values.push_back(sample.cpuMs + sample.gpuDrainMs);
+  }
+  return summarize(std::move(values));
+}
+
+FrameStatisticsSummary FrameStatistics::drawCount() const {
+  return summarize(&FrameSample::drawCount);
+}
+
+FrameStatisticsSummary FrameStatistics::callCount() const {
+  return summarize(&FrameSample::callCount);
+}
+
+void FrameStatistics::writeJson(std::ostream& os,
+                                const std::string& session,
+                                const std::string& backend) const {
+  os << "{\n";
+  os << "  \"session\": \"" << escapeJson(session) << "\",\n";
+  os << "  \"backend\": \"" << escapeJson(backend) << "\",\n";
+  os << "  \"frames\": " << samples_.size() << ",\n";
+  os << "  \"summary\": {\n";
+  writeSummaryJson(os, "cpuMs", cpuTime());
+  os << ",\n";
+  writeSummaryJson(os, "gpuDrainMs", gpuDrainTime());
+  os << ",\n";
+  writeSummaryJson(os, "frameMs", frameTime());
+  os << ",\n";
+  writeSummaryJson(os, "drawCount", drawCount());
+  os << ",\n";
+  writeSummaryJson(os, "callCount", callCount());
+  os << "\n  },\n";
+  os << "  \"samples\": [";
+  for (size_t i = 0; i < samples_.size(); ++i) {
+    const auto& s = samples_[i];
+    os << (i == 0 ? "\n" : ",\n") << "    {\"cpuMs\": " << s.cpuMs
+       << ", \"gpuDrainMs\": " << s.gpuDrainMs << ", \"drawCount\": " << s.drawCount
+       << ", \"callCount\": " << s.callCount << "}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+void FrameStatistics::writeCsv(std::ostream& os) const {
+  os << "frame,cpuMs,gpuDrainMs,frameMs,drawCount,callCount\n";
+  for (size_t i = 0; i < samples_.size(); ++i) {
+    const auto& s = samples_[i];
+    os << i << "," << s.cpuMs << "," << s.gpuDrainMs << "," << s.cpuMs + s.gpuDrainMs << ","
+       << s.drawCount << "," << s.callCount << "\n";
+  }
+}
+
+} // namespace igl::shell
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace igl::shell {
+
+/// Measurements of a single benchmarked frame.
+struct FrameSample {
+  /// CPU time spent in RenderSession::update(), including the submits it issues.
+  double cpuMs = 0.0;
+  /// Time from the end of RenderSession::update() until the GPU finished the submitted work.
+  double gpuDrainMs = 0.0;
+  /// Draw calls recorded during the frame, see IDevice::getCurrentDrawCount().
+  uint64_t drawCount = 0;
+  /// Backend API calls made during the frame. Only OpenGL counts them, see
+  /// opengl::IContext::getCallCount(); 0 on other backends.
+  uint64_t callCount = 0;
+};
+
+struct FrameStatisticsSummary {
+  double min = 0.0;
+  double mean = 0.0;
+  double p50 = 0.0;
+  double p90 = 0.0;
+  double p95 = 0.0;
+  double p99 = 0.0;
+  double max = 0.0;
+};
+
+/// Collects per-frame samples of a benchmark run and exports them as JSON or CSV.
+class FrameStatistics {
+ public:
+  void reserve(size_t numSamples);
+  void addSample(const FrameSample& sample);
+
+  [[nodiscard]] const std::vector<FrameSample>& samples() const noexcept {
+    return samples_;
+  }
+
+  [[nodiscard]] FrameStatisticsSummary cpuTime() const;
+  [[nodiscard]] FrameStatisticsSummary gpuDrainTime() const;
+  [[nodiscard]] FrameStatisticsSummary frameTime() const;
+  [[nodiscard]] FrameStatisticsSummary drawCount() const;
+  [[nodiscard]] FrameStatisticsSummary callCount() const;
+
+  /// Percentiles are linearly interpolated between the two closest ranks.
+  [[nodiscard]] static FrameStatisticsSummary summarize(std::vector<double> values);
+
+  /// Writes the summaries followed by every sample. `session` and `backend` identify the run.
+  void writeJson(std::ostream& os, const std::string& session, const std::string& backend) const;
+  /// Writes one row per sample.
+  void writeCsv(std::ostream& os) const;
+
+ private:
+  template<typename T>
+  [[nodiscard]] FrameStatisticsSummary summarize(T FrameSample::* member) const;
+
+  std::vector<FrameSample> samples_;
+};
+
+} // namespace igl::shell
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// @fb-only
+
+#include <cstdlib>
+#include <cstring>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/IContext.h>
+#include <memory>
+#include <shell/shared/benchmark/BenchmarkRunner.h>
+#include <shell/shared/platform/win/PlatformWin.h>
+
+// clang-format off
+#if IGL_PLATFORM_LINUX_USE_EGL
+  #include <igl/opengl/egl/HWDevice.h>
+#else
+  #include <igl/opengl/glx/HWDevice.h>
+#endif
+// clang-format on
+
+using namespace igl;
+namespace igl::shell {
+namespace {
+
+std::shared_ptr<Platform> createPlatform(const BenchmarkConfig& config) {
+  if (config.softwareDevice) {
+    // Mesa's llvmpipe
+    setenv("LIBGL_ALWAYS_SOFTWARE", "1", 0);
+  }
+#if IGL_PLATFORM_LINUX_USE_EGL
+  opengl::egl::HWDevice hwDevice;
+  const auto api = opengl::RenderingAPI::GLES3;
+#else
+  opengl::glx::HWDevice hwDevice;
+  const auto api = opengl::RenderingAPI::GL;
+#endif
+  Result result;
+  auto context = hwDevice.createOffscreenContext(api, config.width, config.height, &result);
+  if (!result.isOk()) {
+    return nullptr;
+  }
+  auto glDevice = hwDevice.createWithContext(std::move(context), &result);
+  if (!result.isOk()) {
+    return nullptr;
+  }
+  if (config.softwareDevice) {
+    // Drivers other than Mesa ignore LIBGL_ALWAYS_SOFTWARE and would silently benchmark hardware
+    const auto* renderer =
+        reinterpret_cast<const char*>(glDevice->getContext().getString(GL_RENDERER));
+    if (renderer == nullptr ||
+        (strstr(renderer, "llvmpipe") == nullptr && strstr(renderer, "softpipe") == nullptr)) {
+      IGL_LOG_ERROR("--software-device: %s is not a software renderer such as llvmpipe\n",
+                    renderer != nullptr ? renderer : "The renderer");
+      return nullptr;
+    }
+  }
+  return std::make_shared<PlatformWin>(std::move(glDevice));
+}
+
+} // namespace
+} // namespace igl::shell
+
+int main(int argc, char* argv[]) {
+  const auto config = igl::shell::BenchmarkConfig::fromCommandLine(argc, argv);
+  auto platform = igl::shell::createPlatform(config);
+  auto* glDevice = platform ? static_cast<igl::opengl::Device*>(&platform->getDevice()) : nullptr;
+  return igl::shell::runBenchmark(argc, argv, std::move(platform), config, "opengl", [glDevice]() {
+    return static_cast<uint64_t>(glDevice->getContext().getCallCount());
+  });
+}
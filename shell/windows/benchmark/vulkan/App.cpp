@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// @fb-only
+
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/HWDevice.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <memory>
+#include <shell/shared/benchmark/BenchmarkRunner.h>
+#include <shell/shared/platform/win/PlatformWin.h>
+
+using namespace igl;
+namespace igl::shell {
+namespace {
+
+std::shared_ptr<Platform> createPlatform(const BenchmarkConfig& config) {
+  vulkan::VulkanContextConfig cfg;
+  cfg.enableValidation = false;
+  // No surface: sessions render into offscreen textures
+  auto ctx = vulkan::HWDevice::createContext(cfg, nullptr);
+
+  std::vector<HWDeviceDesc> devices = vulkan::HWDevice::queryDevices(
+      *ctx,
+      HWDeviceQueryDesc(config.softwareDevice ? HWDeviceType::SoftwareGpu
+                                              : HWDeviceType::DiscreteGpu),
+      nullptr);
+  if (devices.empty() && config.softwareDevice) {
+    // Falling back to a hardware device would silently benchmark something else
+    IGL_LOG_ERROR("--software-device: no software Vulkan device such as lavapipe found\n");
+    return nullptr;
+  }
+  if (devices.empty()) {
+    devices =
+        vulkan::HWDevice::queryDevices(*ctx, HWDeviceQueryDesc(HWDeviceType::Unknown), nullptr);
+  }
+  if (devices.empty()) {
+    return nullptr;
+  }
+  IGL_LOG_INFO("Benchmarking on %s\n", devices[0].name.c_str());
+
+  Result result;
+  auto vulkanDevice = vulkan::HWDevice::create(
+      std::move(ctx), devices[0], 0, 0, 0, nullptr, nullptr, &result);
+  if (!result.isOk()) {
+    return nullptr;
+  }
+  return std::make_shared<PlatformWin>(std::move(vulkanDevice));
+}
+
+} // namespace
+} // namespace igl::shell
+
+int main(int argc, char* argv[]) {
+  const auto config = igl::shell::BenchmarkConfig::fromCommandLine(argc, argv);
+  return igl::shell::runBenchmark(
+      argc, argv, igl::shell::createPlatform(config), config, "vulkan");
+}
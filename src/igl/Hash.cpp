@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/Hash.h>
+
+namespace igl {
+
+Fnv1aHasher& Fnv1aHasher::add(const void* IGL_NULLABLE data, size_t length) noexcept {
+  if (data == nullptr) {
+    return *this;
+  }
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  size_t offset = 0;
+  for (; offset + sizeof(uint64_t) <= length; offset += sizeof(uint64_t)) {
+    // Assembled byte by byte so the result does not depend on endianness. Compilers turn this into
+    // a single load on little-endian targets.
+    uint64_t word = 0;
+    for (size_t i = 0; i != sizeof(uint64_t); ++i) {
+      word |= static_cast<uint64_t>(bytes[offset + i]) << (8 * i);
+    }
+    addWord(word);
+  }
+  for (; offset < length; ++offset) {
+    addWord(bytes[offset]);
+  }
+  return *this;
+}
+
+Fnv1aHasher& Fnv1aHasher::add(std::string_view string) noexcept {
+  add(string.size());
+  return add(string.data(), string.size());
+}
+
+} // namespace igl
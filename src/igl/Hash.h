@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <igl/Null.h>
+#include <string_view>
+#include <type_traits>
+
+namespace igl {
+
+/**
+ * @brief Incremental 64-bit FNV-1a hash. Unlike std::hash, it gives the same value on every
+ * platform and run, so it can key data that outlives the process, such as on-disk caches.
+ *
+ * Bytes are consumed eight at a time, in little-endian order on every platform, so hashing large
+ * blobs stays cheap. Values are combined in the order they are added.
+ */
+class Fnv1aHasher final {
+ public:
+  Fnv1aHasher& add(const void* IGL_NULLABLE data, size_t length) noexcept;
+  /// Adds the length too, so that ("ab", "c") and ("a", "bc") hash differently.
+  Fnv1aHasher& add(std::string_view string) noexcept;
+  template<typename T>
+  std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, Fnv1aHasher&> add(T value) noexcept {
+    if constexpr (std::is_enum_v<T>) {
+      return addWord(static_cast<uint64_t>(static_cast<std::underlying_type_t<T>>(value)));
+    } else {
+      return addWord(static_cast<uint64_t>(value));
+    }
+  }
+
+  [[nodiscard]] uint64_t value() const noexcept {
+    return hash_;
+  }
+
+ private:
+  static constexpr uint64_t kOffsetBasis = 0xcbf29ce484222325ull;
+  static constexpr uint64_t kPrime = 0x100000001b3ull;
+
+  Fnv1aHasher& addWord(uint64_t word) noexcept {
+    hash_ = (hash_ ^ word) * kPrime;
+    return *this;
+  }
+
+  uint64_t hash_ = kOffsetBasis;
+};
+
+/// Hashes `length` bytes at `data` with Fnv1aHasher.
+[[nodiscard]] inline uint64_t fnv1aHash(const void* IGL_NULLABLE data, size_t length) noexcept {
+  return Fnv1aHasher().add(data, length).value();
+}
+
+} // namespace igl
@@ -449,6 +449,39 @@
 #define IGL_PROFILER_THREAD(name) tracy::SetThreadName(name)
 #define IGL_PROFILER_FRAME(name) FrameMarkNamed(name)
 
+#elif defined(IGL_WITH_PROFILER) && defined(__cplusplus)
+#include <igl/Profiler.h>
+// Built-in CPU profiler. Colors are ignored. Zone names are interned once per call site, so they
+// have to be string literals.
+#define IGL_PROFILER_ZONE_GPU_OGL(name)
+#define IGL_PROFILER_ZONE_GPU_COLOR_OGL(name, color)
+
+#define IGL_PROFILER_ZONE_GPU_VK(name, profilingContext, cmdBuffer)
+#define IGL_PROFILER_ZONE_GPU_COLOR_VK(name, profilingContext, cmdBuffer, color)
+
+#define IGL_PROFILER_ZONE_TRANSIENT_GPU_OGL(varname, name)
+#define IGL_PROFILER_ZONE_TRANSIENT_GPU_VK(profilingContext, varname, cmdBuffer, name)
+#define IGL_PROFILER_ZONE_GPU_END()
+
+#define _IGL_PROFILER_SCOPED_ZONE(name)                                          \
+  static const ::igl::profiler::ZoneId IGL_CONCAT(iglProfilerZoneId, __LINE__) = \
+      ::igl::profiler::internName(name);                                         \
+  const ::igl::profiler::ScopedZone IGL_CONCAT(iglProfilerZone, __LINE__)(       \
+      IGL_CONCAT(iglProfilerZoneId, __LINE__))
+#define IGL_PROFILER_FUNCTION() _IGL_PROFILER_SCOPED_ZONE(__func__)
+#define IGL_PROFILER_FUNCTION_COLOR(color) _IGL_PROFILER_SCOPED_ZONE(__func__)
+#define IGL_PROFILER_ZONE(name, color) \
+  {                                    \
+    _IGL_PROFILER_SCOPED_ZONE(name);
+#define IGL_PROFILER_ZONE_END() }
+#define IGL_PROFILER_THREAD(name) ::igl::profiler::setThreadName(name)
+#define IGL_PROFILER_FRAME(name)                              \
+  do {                                                        \
+    static const ::igl::profiler::ZoneId iglProfilerFrameId = \
+        ::igl::profiler::internFrameName(name);               \
+    ::igl::profiler::markFrame(iglProfilerFrameId);           \
+  } while (false)
+
 #else
 #define IGL_PROFILER_ZONE_GPU_OGL(name)
 #define IGL_PROFILER_ZONE_GPU_COLOR_OGL(name, color)
@@ -466,7 +499,7 @@
 #define IGL_PROFILER_ZONE_END() }
 #define IGL_PROFILER_THREAD(name)
 #define IGL_PROFILER_FRAME(name)
-#endif // IGL_WITH_TRACY
+#endif // IGL_WITH_TRACY, IGL_WITH_PROFILER
 
 #if !defined(IGL_ENUM_TO_STRING)
 #define IGL_ENUM_TO_STRING(enum, res) \
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/Profiler.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace igl::profiler {
+
+namespace {
+
+enum class EventType : uint8_t {
+  Begin,
+  End,
+  Frame,
+};
+
+/// Stored as relaxed atomics so that dumping while other threads record is well defined.
+struct Event {
+  std::atomic<uint64_t> timestamp{0};
+  /// ZoneId in the low 32 bits, EventType in the high 32 bits.
+  std::atomic<uint64_t> payload{0};
+};
+
+/// Written only by its own thread. `head` counts every event ever written, so the live events
+/// are [max(start, head - kEventsPerThread), head).
+struct ThreadBuffer {
+  std::array<Event, kEventsPerThread> events;
+  std::atomic<uint64_t> head{0};
+  std::atomic<uint64_t> start{0};
+  uint32_t threadIndex = 0;
+  std::string name; // guarded by Registry::mutex
+};
+
+struct Registry {
+  std::mutex mutex;
+  /// Buffers outlive their threads so that events of finished threads can still be dumped.
+  std::vector<std::shared_ptr<ThreadBuffer>> threads;
+  std::vector<std::string> names;
+  std::unordered_map<std::string, ZoneId> nameIds;
+};
+
+Registry& registry() {
+  static Registry registry;
+  return registry;
+}
+
+std::shared_ptr<ThreadBuffer> registerThread() {
+  auto buffer = std::make_shared<ThreadBuffer>();
+  Registry& r = registry();
+  const std::lock_guard<std::mutex> guard(r.mutex);
+  buffer->threadIndex = static_cast<uint32_t>(r.threads.size());
+  r.threads.push_back(buffer);
+  return buffer;
+}
+
+ThreadBuffer& threadBuffer() {
+  thread_local const std::shared_ptr<ThreadBuffer> buffer = registerThread();
+  return *buffer;
+}
+
+uint64_t now() noexcept {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
+void record(EventType type, ZoneId zone) {
+  ThreadBuffer& buffer = threadBuffer();
+  const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+  Event& event = buffer.events[head % kEventsPerThread];
+  event.timestamp.store(now(), std::memory_order_relaxed);
+  event.payload.store(static_cast<uint64_t>(type) << 32 | zone, std::memory_order_relaxed);
+  buffer.head.store(head + 1, std::memory_order_release);
+}
+
+struct EventCopy {
+  uint64_t timestamp;
+  ZoneId zone;
+  EventType type;
+};
+
+/// Copies the live events of `buffer`, dropping any that the owning thread overwrote meanwhile.
+std::vector<EventCopy> copyEvents(const ThreadBuffer& buffer) {
+  const uint64_t head = buffer.head.load(std::memory_order_acquire);
+  const uint64_t first = std::max(buffer.start.load(std::memory_order_relaxed),
+                                  head > kEventsPerThread ? head - kEventsPerThread : 0);
+  std::vector<EventCopy> events;
+  events.reserve(static_cast<size_t>(head - first));
+  for (uint64_t i = first; i != head; ++i) {
+    const Event& event = buffer.events[i % kEventsPerThread];
+    const uint64_t payload = event.payload.load(std::memory_order_relaxed);
+    events.push_back({event.timestamp.load(std::memory_order_relaxed),
+                      static_cast<ZoneId>(payload),
+                      static_cast<EventType>(payload >> 32)});
+  }
+  const uint64_t newHead = buffer.head.load(std::memory_order_acquire);
+  if (newHead > first + kEventsPerThread) {
+    const auto overwritten = static_cast<size_t>(
+        std::min<uint64_t>(newHead - kEventsPerThread - first, events.size()));
+    events.erase(events.begin(), events.begin() + overwritten);
+  }
+  return events;
+}
+
+void appendEscaped(std::string& out, const std::string& str) {
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      out += escaped;
+    } else {
+      out += c;
+    }
+  }
+}
+
+} // namespace
+
+namespace detail {
+
+void beginZone(ZoneId zone) {
+  record(EventType::Begin, zone);
+}
+
+void endZone(ZoneId zone) {
+  record(EventType::End, zone);
+}
+
+} // namespace detail
+
+void setEnabled(bool enabled) noexcept {
+  detail::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+ZoneId internName(const char* name) {
+  Registry& r = registry();
+  const std::lock_guard<std::mutex> guard(r.mutex);
+  const auto [it, inserted] =
+      r.nameIds.try_emplace(name ? name : "", static_cast<ZoneId>(r.names.size()));
+  if (inserted) {
+    r.names.push_back(it->first);
+  }
+  return it->second;
+}
+
+void setThreadName(const char* name) {
+  ThreadBuffer& buffer = threadBuffer();
+  const std::lock_guard<std::mutex> guard(registry().mutex);
+  buffer.name = name ? name : "";
+}
+
+ZoneId internFrameName(const char* name) {
+  return internName(name ? name : "Frame");
+}
+
+void markFrame(ZoneId frame) {
+  if (!isEnabled()) {
+    return;
+  }
+  record(EventType::Frame, frame);
+}
+
+void reset() {
+  Registry& r = registry();
+  const std::lock_guard<std::mutex> guard(r.mutex);
+  for (const auto& thread : r.threads) {
+    thread->start.store(thread->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+  }
+}
+
+std::string toChromeTrace() {
+  Registry& r = registry();
+  const std::lock_guard<std::mutex> guard(r.mutex);
+
+  std::vector<std::vector<EventCopy>> threadEvents;
+  threadEvents.reserve(r.threads.size());
+  uint64_t origin = UINT64_MAX;
+  for (const auto& thread : r.threads) {
+    threadEvents.push_back(copyEvents(*thread));
+    if (!threadEvents.back().empty()) {
+      origin = std::min(origin, threadEvents.back().front().timestamp);
+    }
+  }
+
+  std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  char buffer[128];
+  const auto separate = [&json, &first]() {
+    json += first ? "\n" : ",\n";
+    first = false;
+  };
+
+  for (size_t i = 0; i != r.threads.size(); ++i) {
+    const ThreadBuffer& thread = *r.threads[i];
+    if (!thread.name.empty()) {
+      separate();
+      snprintf(buffer,
+               sizeof(buffer),
+               "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+               thread.threadIndex);
+      json += buffer;
+      appendEscaped(json, thread.name);
+      json += "\"}}";
+    }
+
+    // Ends whose begins were overwritten in the ring buffer are dropped
+    uint32_t depth = 0;
+    for (const EventCopy& event : threadEvents[i]) {
+      const char* phase = "i";
+      if (event.type == EventType::Begin) {
+        phase = "B";
+        ++depth;
+      } else if (event.type == EventType::End) {
+        if (depth == 0) {
+          continue;
+        }
+        phase = "E";
+        --depth;
+      }
+      separate();
+      json += "{\"name\":\"";
+      if (event.zone < r.names.size()) {
+        appendEscaped(json, r.names[event.zone]);
+      }
+      snprintf(buffer,
+               sizeof(buffer),
+               "\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":1,\"tid\":%u%s}",
+               phase,
+               static_cast<double>(event.timestamp - origin) / 1000.0,
+               thread.threadIndex,
+               event.type == EventType::Frame ? ",\"s\":\"p\"" : "");
+      json += buffer;
+    }
+  }
+  json += "\n]}\n";
+  return json;
+}
+
+bool saveChromeTrace(const char* path) {
+  const std::string json = toChromeTrace();
+  FILE* file = path ? fopen(path, "wb") : nullptr;
+  if (!file) {
+    return false;
+  }
+  const bool written = fwrite(json.data(), 1, json.size(), file) == json.size();
+  return fclose(file) == 0 && written;
+}
+
+} // namespace igl::profiler
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// Built-in CPU profiler used by the IGL_PROFILER_* macros when IGL_WITH_PROFILER is defined and
+/// Tracy is not. Every thread records begin/end events into its own fixed-size ring buffer without
+/// taking locks, so only the most recent events of each thread are kept. Recording is off until
+/// setEnabled(true) is called and the events can be dumped at any time as Chrome trace_event JSON,
+/// which loads in chrome://tracing and Perfetto.
+///
+/// The functions are always compiled, so applications can also record their own zones.
+namespace igl::profiler {
+
+/// Index of an interned zone name.
+using ZoneId = uint32_t;
+
+/// Events kept per thread. Older events are overwritten.
+constexpr size_t kEventsPerThread = 8192;
+
+namespace detail {
+inline std::atomic<bool> enabled{false};
+void beginZone(ZoneId zone);
+void endZone(ZoneId zone);
+} // namespace detail
+
+/// Turns recording on or off for all threads. Zones that are open when recording is turned off
+/// still record their end.
+void setEnabled(bool enabled) noexcept;
+
+[[nodiscard]] inline bool isEnabled() noexcept {
+  return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/// Returns a stable id for `name`. Equal names return the same id. Takes a lock, so call sites
+/// intern their names once and keep the id.
+[[nodiscard]] ZoneId internName(const char* name);
+
+/// Names the calling thread in the exported trace.
+void setThreadName(const char* name);
+
+/// Interns a frame name for markFrame(). A null `name` gives the default "Frame".
+[[nodiscard]] ZoneId internFrameName(const char* name);
+
+/// Records an instant event marking the end of a frame. Does not lock.
+void markFrame(ZoneId frame);
+
+/// Discards the events recorded so far on all threads.
+void reset();
+
+/// Returns the recorded events of all threads as Chrome trace_event JSON.
+[[nodiscard]] std::string toChromeTrace();
+
+/// Writes toChromeTrace() to `path`. Returns false if the file cannot be written.
+bool saveChromeTrace(const char* path);
+
+/// Records a zone for the lifetime of the object if recording was on when it was created.
+class ScopedZone final {
+ public:
+  explicit ScopedZone(ZoneId zone) : zone_(zone), active_(isEnabled()) {
+    if (active_) {
+      detail::beginZone(zone_);
+    }
+  }
+  ~ScopedZone() {
+    if (active_) {
+      detail::endZone(zone_);
+    }
+  }
+  ScopedZone(const ScopedZone&) = delete;
+  ScopedZone& operator=(const ScopedZone&) = delete;
+
+ private:
+  ZoneId zone_;
+  bool active_;
+};
+
+} // namespace igl::profiler
@@ -235,6 +235,25 @@ class IRenderPipelineState {
     return -1;
   }
 
+  /**
+   * @brief Returns false while the backend is still compiling or linking the pipeline's shaders
+   * in the background. Binding a pipeline that is not ready blocks until it is, so callers can
+   * keep drawing with a fallback pipeline until this returns true.
+   */
+  [[nodiscard]] virtual bool isReady() const {
+    return true;
+  }
+
+  /**
+   * @brief Returns the outcome of creating the pipeline. Backends that defer compiling or linking
+   * report failures found after createRenderPipeline() returned here; this blocks until they are
+   * known if isReady() is still false. A pipeline with a failed status is never bound, and draws
+   * using it are skipped.
+   */
+  [[nodiscard]] virtual Result getStatus() const {
+    return Result();
+  }
+
   const RenderPipelineDesc& getRenderPipelineDesc() const {
     return desc_;
   }
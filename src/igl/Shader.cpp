@@ -9,6 +9,7 @@
 
 #include <cstring>
 #include <igl/Common.h>
+#include <igl/Hash.h>
 #include <type_traits>
 
 namespace {
@@ -44,6 +45,12 @@ bool safeCStrCompare(const char* IGL_NULLABLE a, const char* IGL_NULLABLE b) {
   return (strcmp(a, b) == 0);
 }
 
+uint64_t shaderInputHash(const igl::ShaderInput& input) {
+  return input.type == igl::ShaderInputType::String
+             ? igl::fnv1aHash(input.source, input.source ? strlen(input.source) : 0)
+             : igl::fnv1aHash(input.data, input.data ? input.length : 0);
+}
+
 size_t safeCStrHash(const char* IGL_NULLABLE s) {
   if (s == nullptr) {
     return 0;
@@ -99,6 +106,7 @@ ShaderModuleDesc ShaderModuleDesc::fromStringInput(const char* IGL_NONNULL sourc
   desc.input.type = ShaderInputType::String;
   desc.input.source = source;
   desc.info = std::move(info);
+  desc.info.inputHash = shaderInputHash(desc.input);
   desc.debugName = std::move(debugName);
   return desc;
 }
@@ -112,6 +120,7 @@ ShaderModuleDesc ShaderModuleDesc::fromBinaryInput(const void* IGL_NONNULL data,
   desc.input.data = data;
   desc.input.length = dataLength;
   desc.info = std::move(info);
+  desc.info.inputHash = shaderInputHash(desc.input);
   desc.debugName = std::move(debugName);
   return desc;
 }
@@ -135,6 +144,10 @@ ShaderLibraryDesc ShaderLibraryDesc::fromStringInput(const char* IGL_NONNULL lib
   if (IGL_DEBUG_VERIFY(!moduleInfo.empty())) {
     libraryDesc.moduleInfo = std::move(moduleInfo);
   }
+  const uint64_t hash = shaderInputHash(libraryDesc.input);
+  for (auto& info : libraryDesc.moduleInfo) {
+    info.inputHash = hash;
+  }
 
   return libraryDesc;
 }
@@ -152,6 +165,10 @@ ShaderLibraryDesc ShaderLibraryDesc::fromBinaryInput(const void* IGL_NONNULL lib
   if (IGL_DEBUG_VERIFY(!moduleInfo.empty())) {
     libraryDesc.moduleInfo = std::move(moduleInfo);
   }
+  const uint64_t hash = shaderInputHash(libraryDesc.input);
+  for (auto& info : libraryDesc.moduleInfo) {
+    info.inputHash = hash;
+  }
 
   return libraryDesc;
 }
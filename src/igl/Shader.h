@@ -48,6 +48,12 @@ struct ShaderModuleInfo {
   std::string entryPoint;
 
   std::string debugName;
+  /**
+   * @brief FNV-1a hash of the source or binary the module was created from. Unlike the module's
+   * address, it identifies the module across runs. Set by the ShaderModuleDesc and
+   * ShaderLibraryDesc factories, 0 if unknown. Not part of equality.
+   */
+  uint64_t inputHash = 0;
 
   bool operator==(const ShaderModuleInfo& other) const;
   bool operator!=(const ShaderModuleInfo& other) const;
@@ -123,6 +123,7 @@ Result ArrayBuffer::upload(const void* data, const BufferRange& range) {
     return Result(Result::Code::InvalidOperation, "Can't upload to static buffers");
   }
 
+  getContext().flushPendingDraws();
   getContext().bindBuffer(target_, iD_);
 
   getContext().bufferSubData(target_, range.offset, range.size, data);
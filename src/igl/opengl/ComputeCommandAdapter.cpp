@@ -113,7 +113,9 @@ void ComputeCommandAdapter::willDispatch() {
   }
 
   // Bind uniforms to be used for compute
-  uniformAdapter_.bindToPipeline(getContext());
+  const auto* shaderStages = pipelineState->getShaderStages();
+  uniformAdapter_.bindToPipeline(getContext(),
+                                 shaderStages ? &shaderStages->getUniformBindPlan() : nullptr);
 
   for (size_t index = 0; index < textureStates_.size(); index++) {
     if (!IS_DIRTY(textureStatesDirty_, index)) {
@@ -143,8 +145,11 @@ void ComputeCommandAdapter::didDispatch() {
     return;
   }
   if (pipelineState->getIsUsingShaderStorageBuffers()) {
+    // Storage buffers written by the dispatch may be consumed as vertex, index or indirect draw
+    // and dispatch arguments
     getContext().memoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT |
-                               GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+                               GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT |
+                               GL_BUFFER_UPDATE_BARRIER_BIT);
   }
 }
 
@@ -36,6 +36,10 @@ class ComputePipelineState final : public WithContext, public IComputePipelineSt
 
   [[nodiscard]] int getIndexByName(const NameHandle& name) const override;
 
+  [[nodiscard]] const ShaderStages* getShaderStages() const {
+    return shaderStages_.get();
+  }
+
   bool getIsUsingShaderStorageBuffers() {
     return usingShaderStorageBuffers_;
   }
@@ -8,6 +8,7 @@
 #include <igl/opengl/Device.h>
 #include <igl/opengl/Shader.h>
 
+#include <array>
 #include <cstdio>
 #include <cstring>
 #include <igl/opengl/Buffer.h>
@@ -343,9 +344,43 @@ Holder<igl::BindGroupTextureHandle> Device::createBindGroup(
   IGL_DEBUG_ASSERT(context_);
   IGL_DEBUG_ASSERT(!desc.debugName.empty(), "Each bind group should have a debug name");
 
-  BindGroupTextureDesc description(desc);
+  BindGroupMetadataTextures metadata{desc, {}};
+
+  if (context_->shouldUseBindlessTextures()) {
+    // std140 array elements are 16 bytes apart; the 64-bit handle occupies the first 8 bytes
+    constexpr size_t kHandleStride = 16;
+    std::array<uint8_t, IGL_TEXTURE_SAMPLERS_MAX * kHandleStride> handles{};
+    for (uint32_t i = 0; i != IGL_TEXTURE_SAMPLERS_MAX; i++) {
+      auto* texture = static_cast<Texture*>(desc.textures[i].get());
+      if (!texture) {
+        continue;
+      }
+      if (!(texture->getUsage() & TextureDesc::TextureUsageBits::Sampled)) {
+        Result::setResult(outResult,
+                          Result::Code::ArgumentInvalid,
+                          "Bindless textures must have TextureUsageBits::Sampled");
+        return {};
+      }
+      // One handle per texture/sampler pair, so bind groups can sample a texture differently
+      const uint64_t textureHandle = texture->getTextureSamplerHandle(desc.samplers[i]);
+      std::memcpy(handles.data() + i * kHandleStride, &textureHandle, sizeof(textureHandle));
+    }
+
+    Result result;
+    metadata.bindlessHandles = createBuffer(BufferDesc(BufferDesc::BufferTypeBits::Uniform,
+                                                       handles.data(),
+                                                       handles.size(),
+                                                       ResourceStorage::Shared,
+                                                       BufferDesc::BufferAPIHintBits::UniformBlock,
+                                                       desc.debugName + " (bindless handles)"),
+                                            &result);
+    if (!result.isOk()) {
+      Result::setResult(outResult, std::move(result));
+      return {};
+    }
+  }
 
-  const auto handle = context_->bindGroupTexturesPool_.create(std::move(description));
+  const auto handle = context_->bindGroupTexturesPool_.create(std::move(metadata));
 
   Result::setResult(outResult,
                     handle.empty() ? Result(Result::Code::RuntimeError, "Cannot create bind group")
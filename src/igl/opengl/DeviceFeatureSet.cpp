@@ -106,8 +106,52 @@ void DeviceFeatureSet::initializeVersion(GLVersion version) {
 
 void DeviceFeatureSet::initializeExtensions(std::string extensions,
                                             std::unordered_set<std::string> supportedExtensions) {
-  extensions_ = std::move(extensions);
   supportedExtensions_ = std::move(supportedExtensions);
+
+  // Contexts without glGetStringi report all extensions as a single space-separated string
+  size_t begin = extensions.find_first_not_of(' ');
+  while (begin != std::string::npos) {
+    const size_t end = extensions.find(' ', begin);
+    supportedExtensions_.emplace(extensions, begin, end == std::string::npos ? end : end - begin);
+    begin = extensions.find_first_not_of(' ', end);
+  }
+
+  precomputeCapabilities();
+}
+
+void DeviceFeatureSet::precomputeCapabilities() {
+  // Tables are filled in dependency order; queries against tables that aren't filled in yet are
+  // evaluated directly.
+  extensionsPrecomputed_ = false;
+  internalFeaturesPrecomputed_ = false;
+  featuresPrecomputed_ = false;
+  textureFeaturesPrecomputed_ = false;
+  textureCapabilitiesPrecomputed_ = false;
+
+  for (size_t i = 0; i < kNumExtensions; ++i) {
+    extensions_[i] = isExtensionSupported(static_cast<Extensions>(i));
+  }
+  extensionsPrecomputed_ = true;
+
+  for (size_t i = 0; i < kNumInternalFeatures; ++i) {
+    internalFeatures_[i] = isInternalFeatureSupported(static_cast<InternalFeatures>(i));
+  }
+  internalFeaturesPrecomputed_ = true;
+
+  for (size_t i = 0; i < kNumDeviceFeatures; ++i) {
+    features_[i] = isFeatureSupported(static_cast<DeviceFeatures>(i));
+  }
+  featuresPrecomputed_ = true;
+
+  for (size_t i = 0; i < kNumTextureFeatures; ++i) {
+    textureFeatures_[i] = isTextureFeatureSupported(static_cast<TextureFeatures>(i));
+  }
+  textureFeaturesPrecomputed_ = true;
+
+  for (size_t i = 0; i < kNumTextureFormats; ++i) {
+    textureCapabilities_[i] = computeTextureFormatCapabilities(static_cast<TextureFormat>(i));
+  }
+  textureCapabilitiesPrecomputed_ = true;
 }
 
 GLVersion DeviceFeatureSet::getGLVersion() const noexcept {
@@ -164,11 +208,7 @@ BackendVersion DeviceFeatureSet::getBackendVersion() const {
 }
 
 bool DeviceFeatureSet::isSupported(const std::string& extensionName) const {
-  if (!extensions_.empty()) {
-    return extensions_.find(extensionName) != std::string::npos;
-  } else {
-    return supportedExtensions_.find(extensionName) != supportedExtensions_.end();
-  }
+  return supportedExtensions_.find(extensionName) != supportedExtensions_.end();
 }
 
 bool DeviceFeatureSet::isExtensionSupported(Extensions extension) const {
@@ -207,6 +247,11 @@ bool DeviceFeatureSet::isExtensionSupported(Extensions extension) const {
     return hasESExtension(*this, "GL_OES_mapbuffer");
   case Extensions::MapBufferRange:
     return hasESExtension(*this, "GL_EXT_map_buffer_range");
+  case Extensions::MultiDrawAngle:
+    return hasESExtension(*this, "GL_ANGLE_multi_draw") ||
+           hasESExtension(*this, "GL_WEBGL_multi_draw");
+  case Extensions::MultiDrawArraysExt:
+    return hasESExtension(*this, "GL_EXT_multi_draw_arrays");
   case Extensions::MultiSampleApple:
     return hasESExtension(*this, "GL_APPLE_framebuffer_multisample");
   case Extensions::MultiSampleExt:
@@ -215,6 +260,10 @@ bool DeviceFeatureSet::isExtensionSupported(Extensions extension) const {
     return hasESExtension(*this, "GL_IMG_multisampled_render_to_texture");
   case Extensions::MultiViewMultiSample:
     return hasESExtension(*this, "GL_OVR_multiview_multisampled_render_to_texture");
+  case Extensions::ParallelShaderCompileArb:
+    return hasDesktopExtension(*this, "GL_ARB_parallel_shader_compile");
+  case Extensions::ParallelShaderCompileKhr:
+    return hasDesktopOrESExtension(*this, "GL_KHR_parallel_shader_compile");
   case Extensions::PolygonOffsetClamp:
     return hasDesktopOrESExtension(*this, "GL_ARB_polygon_offset_clamp");
   case Extensions::RequiredInternalFormat:
@@ -252,6 +301,8 @@ bool DeviceFeatureSet::isExtensionSupported(Extensions extension) const {
     return hasESExtension(*this, "GL_OES_vertex_array_object");
   case Extensions::VertexAttribDivisor:
     return hasESExtension(*this, "GL_NV_instanced_arrays");
+  case Extensions::Count:
+    break;
   }
   IGL_UNREACHABLE_RETURN(false)
 }
@@ -543,6 +594,17 @@ bool DeviceFeatureSet::isInternalFeatureSupported(InternalFeatures feature) cons
 
   case InternalFeatures::DrawElementsInstanced:
     return hasDesktopOrESVersion(*this, GLVersion::v3_1, GLVersion::v3_0_ES);
+
+  case InternalFeatures::ParallelShaderCompile:
+    return hasExtension(Extensions::ParallelShaderCompileKhr) ||
+           hasExtension(Extensions::ParallelShaderCompileArb);
+
+  case InternalFeatures::MultiDrawElements:
+    return !usesOpenGLES() || hasExtension(Extensions::MultiDrawAngle) ||
+           hasExtension(Extensions::MultiDrawArraysExt);
+
+  case InternalFeatures::Count:
+    break;
   }
 
   return false;
@@ -839,65 +901,42 @@ bool DeviceFeatureSet::isTextureFeatureSupported(TextureFeatures feature) const
 
   case TextureFeatures::TextureTypeUInt8888Rev:
     return hasDesktopVersion(*this, GLVersion::v2_0);
+
+  case TextureFeatures::Count:
+    break;
   }
 
   return false;
 }
 
 bool DeviceFeatureSet::hasExtension(Extensions extension) const {
-  const uint64_t extensionIndex = static_cast<uint64_t>(extension);
-  IGL_DEBUG_ASSERT(extensionIndex < 64);
-  const uint64_t extensionBit = 1ull << extensionIndex;
-  if ((extensionCacheInitialized_ & extensionBit) == 0) {
-    if (isExtensionSupported(extension)) {
-      extensionCache_ |= extensionBit;
-    }
-    extensionCacheInitialized_ |= extensionBit;
+  if (!extensionsPrecomputed_) {
+    return isExtensionSupported(extension);
   }
-
-  return (extensionCache_ & extensionBit) != 0;
+  return extensions_[static_cast<size_t>(extension)];
 }
 
 bool DeviceFeatureSet::hasFeature(DeviceFeatures feature) const {
-  const uint64_t featureIndex = static_cast<uint64_t>(feature);
-  IGL_DEBUG_ASSERT(featureIndex < 64);
-  const uint64_t featureBit = 1ull << featureIndex;
-  if ((featureCacheInitialized_ & featureBit) == 0) {
-    if (isFeatureSupported(feature)) {
-      featureCache_ |= featureBit;
-    }
-    featureCacheInitialized_ |= featureBit;
+  const auto index = static_cast<size_t>(feature);
+  if (!featuresPrecomputed_ || index >= kNumDeviceFeatures) {
+    IGL_DEBUG_ASSERT(index < kNumDeviceFeatures, "kNumDeviceFeatures does not cover %zu", index);
+    return isFeatureSupported(feature);
   }
-
-  return (featureCache_ & featureBit) != 0;
+  return features_[index];
 }
 
 bool DeviceFeatureSet::hasInternalFeature(InternalFeatures feature) const {
-  const uint32_t featureIndex = static_cast<uint32_t>(feature);
-  IGL_DEBUG_ASSERT(featureIndex < 32);
-  const uint32_t featureBit = 1u << featureIndex;
-  if ((internalFeatureCacheInitialized_ & featureBit) == 0) {
-    if (isInternalFeatureSupported(feature)) {
-      internalFeatureCache_ |= featureBit;
-    }
-    internalFeatureCacheInitialized_ |= featureBit;
+  if (!internalFeaturesPrecomputed_) {
+    return isInternalFeatureSupported(feature);
   }
-
-  return (internalFeatureCache_ & featureBit) != 0;
+  return internalFeatures_[static_cast<size_t>(feature)];
 }
 
 bool DeviceFeatureSet::hasTextureFeature(TextureFeatures feature) const {
-  const uint64_t featureIndex = static_cast<uint64_t>(feature);
-  IGL_DEBUG_ASSERT(featureIndex < 64);
-  const uint64_t featureBit = 1ull << featureIndex;
-  if ((textureFeatureCacheInitialized_ & featureBit) == 0) {
-    if (isTextureFeatureSupported(feature)) {
-      textureFeatureCache_ |= featureBit;
-    }
-    textureFeatureCacheInitialized_ |= featureBit;
+  if (!textureFeaturesPrecomputed_) {
+    return isTextureFeatureSupported(feature);
   }
-
-  return (textureFeatureCache_ & featureBit) != 0;
+  return textureFeatures_[static_cast<size_t>(feature)];
 }
 
 bool DeviceFeatureSet::hasRequirement(DeviceRequirement requirement) const {
@@ -1140,11 +1179,14 @@ ICapabilities::TextureFormatCapabilities DeviceFeatureSet::getTextureFormatCapab
       !hasTextureFeature(TextureFeatures::Depth32FStencil8)) {
     format = TextureFormat::S8_UInt_Z24_UNorm;
   }
-  const auto it = textureCapabilityCache_.find(format);
-  if (it != textureCapabilityCache_.end()) {
-    return it->second;
+  if (!textureCapabilitiesPrecomputed_) {
+    return computeTextureFormatCapabilities(format);
   }
+  return textureCapabilities_[static_cast<size_t>(format)];
+}
 
+ICapabilities::TextureFormatCapabilities DeviceFeatureSet::computeTextureFormatCapabilities(
+    TextureFormat format) const {
   const auto sampled = ICapabilities::TextureFormatCapabilityBits::Sampled;
   const auto attachment = ICapabilities::TextureFormatCapabilityBits::Attachment;
   const auto storage = hasInternalFeature(InternalFeatures::TexStorage)
@@ -1561,11 +1603,9 @@ ICapabilities::TextureFormatCapabilities DeviceFeatureSet::getTextureFormatCapab
     }
     break;
   default:
-    // We are relying on the fact that TextureFormatCapabilities::Unsupported is 0
-    return textureCapabilityCache_[format];
+    return unsupported;
   };
 
-  textureCapabilityCache_[format] = capabilities;
   return capabilities;
 }
 
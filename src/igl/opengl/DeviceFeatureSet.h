@@ -7,11 +7,14 @@
 
 #pragma once
 
+#include <array>
+#include <bitset>
 #include <igl/DeviceFeatures.h>
 #include <igl/Texture.h>
 #include <igl/opengl/Version.h>
+#include <limits>
 #include <string>
-#include <unordered_map>
+#include <type_traits>
 #include <unordered_set>
 
 namespace igl::opengl {
@@ -37,10 +40,14 @@ enum class Extensions {
   InvalidateSubdata,          // GL_ARB_invalidate_subdata is supported
   MapBuffer,                  // GL_OES_mapbuffer is supported
   MapBufferRange,             // GL_EXT_map_buffer_range is supported
+  MultiDrawAngle,             // GL_ANGLE_multi_draw or GL_WEBGL_multi_draw is supported
+  MultiDrawArraysExt,         // GL_EXT_multi_draw_arrays is supported
   MultiSampleApple,           // GL_APPLE_framebuffer_multisample is supported
   MultiSampleExt,             // GL_EXT_multisampled_render_to_texture is supported
   MultiSampleImg,             // GL_IMG_multisampled_render_to_texture is supported
   MultiViewMultiSample,       // GL_OVR_multiview_multisampled_render_to_texture is supported
+  ParallelShaderCompileArb,   // GL_ARB_parallel_shader_compile is supported
+  ParallelShaderCompileKhr,   // GL_KHR_parallel_shader_compile is supported
   PolygonOffsetClamp,         // GL_ARB_polygon_offset_clamp is supported
   RequiredInternalFormat,     // GL_OES_required_internalformat is supported
   ShaderImageLoadStore,       // GL_EXT_shader_image_load_store is supported
@@ -59,8 +66,10 @@ enum class Extensions {
   TextureType2_10_10_10_Rev,  // GL_EXT_texture_type_2_10_10_10_REV is supporteds
   VertexArrayObject,          // GL_OES_vertex_array_object is supported
   VertexAttribDivisor,        // GL_NV_instanced_arrays is supported
+  Count,                      // Number of extensions; must be last
 };
 // clang-format on
+constexpr size_t kNumExtensions = static_cast<size_t>(Extensions::Count);
 
 // clang-format off
 enum class InternalFeatures {
@@ -89,8 +98,12 @@ enum class InternalFeatures {
   PackRowLength,             // GL_PACK_ROW_LENGTH is supported with glPixelStorei
   DrawElementsInstanced,     // glDrawElementsInstanced is supported
   DrawArraysInstanced,       // glDrawArraysInstanced is supported
+  ParallelShaderCompile,     // Shader compile and program link can complete asynchronously
+  MultiDrawElements,         // glMultiDrawElements or an equivalent extension is supported
+  Count,                     // Number of internal features; must be last
 };
 // clang-format on
+constexpr size_t kNumInternalFeatures = static_cast<size_t>(InternalFeatures::Count);
 
 // clang-format off
 enum class TextureFeatures {
@@ -154,8 +167,10 @@ enum class TextureFeatures {
   TextureCompressionTexStorage, // TexStorage can be used to initialize compressed textures
   TextureInteger,               // Integer textures are supported
   TextureTypeUInt8888Rev,       // GL_UNSIGNED_INT_8_8_8_8_REV is supported
+  Count,                        // Number of texture features; must be last
   };
 // clang-format on
+constexpr size_t kNumTextureFeatures = static_cast<size_t>(TextureFeatures::Count);
 
 enum class InternalRequirement {
   ColorTexImageRgb10A2Unsized,
@@ -192,6 +207,8 @@ class DeviceFeatureSet final {
   [[nodiscard]] static bool usesOpenGLES() noexcept;
 
   void initializeVersion(GLVersion version);
+  /// Parses the extension list and precomputes the answers to all extension, feature and texture
+  /// format queries. Before this is called, queries are evaluated on every call.
   void initializeExtensions(std::string extensions,
                             std::unordered_set<std::string> supportedExtensions);
 
@@ -220,23 +237,34 @@ class DeviceFeatureSet final {
 
  private:
   ICapabilities::TextureFormatCapabilities getCompressedTextureCapabilities() const;
+  ICapabilities::TextureFormatCapabilities computeTextureFormatCapabilities(
+      TextureFormat format) const;
   bool isExtensionSupported(Extensions extension) const;
   bool isFeatureSupported(DeviceFeatures feature) const;
   bool isInternalFeatureSupported(InternalFeatures feature) const;
   bool isTextureFeatureSupported(TextureFeatures feature) const;
+  void precomputeCapabilities();
+
+  // DeviceFeatures is a public enum without a sentinel. Features appended after
+  // ValidationLayersEnabled fall outside the table and are evaluated on every call instead.
+  static constexpr size_t kNumDeviceFeatures =
+      static_cast<size_t>(DeviceFeatures::ValidationLayersEnabled) + 1;
+  // Covers every value of the underlying type, so new texture formats never index past the table
+  static_assert(std::is_same_v<std::underlying_type_t<TextureFormat>, uint8_t>);
+  static constexpr size_t kNumTextureFormats = std::numeric_limits<uint8_t>::max() + 1;
 
   std::unordered_set<std::string> supportedExtensions_;
-  std::string extensions_;
-  mutable std::unordered_map<TextureFormat, ICapabilities::TextureFormatCapabilities>
-      textureCapabilityCache_;
-  mutable uint64_t extensionCache_ = 0;
-  mutable uint64_t extensionCacheInitialized_ = 0;
-  mutable uint64_t featureCache_ = 0;
-  mutable uint64_t featureCacheInitialized_ = 0;
-  mutable uint32_t internalFeatureCache_ = 0;
-  mutable uint32_t internalFeatureCacheInitialized_ = 0;
-  mutable uint64_t textureFeatureCache_ = 0;
-  mutable uint64_t textureFeatureCacheInitialized_ = 0;
+  std::bitset<kNumExtensions> extensions_;
+  std::bitset<kNumDeviceFeatures> features_;
+  std::bitset<kNumInternalFeatures> internalFeatures_;
+  std::bitset<kNumTextureFeatures> textureFeatures_;
+  std::array<ICapabilities::TextureFormatCapabilities, kNumTextureFormats> textureCapabilities_{};
+  // Each table is only valid once precomputeCapabilities() has filled it in
+  bool extensionsPrecomputed_ = false;
+  bool featuresPrecomputed_ = false;
+  bool internalFeaturesPrecomputed_ = false;
+  bool textureFeaturesPrecomputed_ = false;
+  bool textureCapabilitiesPrecomputed_ = false;
   IContext& glContext_;
   GLVersion version_ = GLVersion::NotAvailable;
 };
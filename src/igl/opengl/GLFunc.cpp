@@ -181,6 +181,11 @@ IGL_EXTERN_BEGIN
 #else
 #define CAN_CALL_glDrawArraysInstanced 0
 #endif
+#if defined(GL_VERSION_1_4)
+#define CAN_CALL_glMultiDrawElements CAN_CALL_OPENGL
+#else
+#define CAN_CALL_glMultiDrawElements 0
+#endif
 #if defined(GL_VERSION_4_3) || defined(GL_ES_VERSION_3_2)
 #define CAN_CALL_glDebugMessageCallback CAN_CALL
 #define CAN_CALL_glDebugMessageInsert CAN_CALL
@@ -430,6 +435,45 @@ void iglDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei pri
                           primcount);
 }
 
+void iglMultiDrawElements(GLenum mode,
+                          const GLsizei* count,
+                          GLenum type,
+                          const void* const* indices,
+                          GLsizei drawcount) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glMultiDrawElements,
+                          glMultiDrawElements,
+                          PFNIGLMULTIDRAWELEMENTSPROC,
+                          mode,
+                          count,
+                          type,
+                          indices,
+                          drawcount);
+}
+
+///--------------------------------------
+/// MARK: - GL_ANGLE_multi_draw
+
+#if defined(GL_ANGLE_multi_draw)
+#define CAN_CALL_glMultiDrawElementsANGLE CAN_CALL_OPENGL_ES
+#else
+#define CAN_CALL_glMultiDrawElementsANGLE 0
+#endif
+
+void iglMultiDrawElementsANGLE(GLenum mode,
+                               const GLsizei* counts,
+                               GLenum type,
+                               const void* const* offsets,
+                               GLsizei drawcount) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glMultiDrawElementsANGLE,
+                          glMultiDrawElementsANGLE,
+                          PFNIGLMULTIDRAWELEMENTSPROC,
+                          mode,
+                          counts,
+                          type,
+                          offsets,
+                          drawcount);
+}
+
 ///--------------------------------------
 /// MARK: - GL_APPLE_framebuffer_multisample
 
@@ -493,10 +537,12 @@ void iglGetSyncivAPPLE(GLsync sync, GLenum pname, GLsizei bufSize, GLsizei* leng
 
 #if defined(GL_ARB_bindless_texture)
 #define CAN_CALL_glGetTextureHandleARB CAN_CALL_OPENGL
+#define CAN_CALL_glGetTextureSamplerHandleARB CAN_CALL_OPENGL
 #define CAN_CALL_glMakeTextureHandleResidentARB CAN_CALL_OPENGL
 #define CAN_CALL_glMakeTextureHandleNonResidentARB CAN_CALL_OPENGL
 #else
 #define CAN_CALL_glGetTextureHandleARB 0
+#define CAN_CALL_glGetTextureSamplerHandleARB 0
 #define CAN_CALL_glMakeTextureHandleResidentARB 0
 #define CAN_CALL_glMakeTextureHandleNonResidentARB 0
 #endif
@@ -509,6 +555,15 @@ GLuint64 iglGetTextureHandleARB(GLuint texture) {
                                       texture);
 }
 
+GLuint64 iglGetTextureSamplerHandleARB(GLuint texture, GLuint sampler) {
+  GLEXTENSION_METHOD_BODY_WITH_RETURN(CAN_CALL_glGetTextureSamplerHandleARB,
+                                      glGetTextureSamplerHandleARB,
+                                      PFNIGLGETTEXTURESAMPLERHANDLEPROC,
+                                      GL_ZERO,
+                                      texture,
+                                      sampler);
+}
+
 void iglMakeTextureHandleResidentARB(GLuint64 handle) {
   GLEXTENSION_METHOD_BODY(CAN_CALL_glMakeTextureHandleResidentARB,
                           glMakeTextureHandleResidentARB,
@@ -854,6 +909,22 @@ void* iglMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbit
                                       access);
 }
 
+///--------------------------------------
+/// MARK: - GL_ARB_parallel_shader_compile
+
+#if defined(GL_ARB_parallel_shader_compile)
+#define CAN_CALL_glMaxShaderCompilerThreadsARB CAN_CALL_OPENGL
+#else
+#define CAN_CALL_glMaxShaderCompilerThreadsARB 0
+#endif
+
+void iglMaxShaderCompilerThreadsARB(GLuint count) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glMaxShaderCompilerThreadsARB,
+                          glMaxShaderCompilerThreadsARB,
+                          PFNIGLMAXSHADERCOMPILERTHREADSPROC,
+                          count);
+}
+
 ///--------------------------------------
 /// MARK: - GL_ARB_program_interface_query
 
@@ -930,6 +1001,49 @@ void iglGetProgramResourceName(GLuint program,
                           name)
 }
 
+///--------------------------------------
+/// MARK: - GL_ARB_sampler_objects
+
+#if defined(GL_VERSION_3_3) || defined(GL_ES_VERSION_3_0) || defined(GL_ARB_sampler_objects)
+#define CAN_CALL_glDeleteSamplers CAN_CALL
+#define CAN_CALL_glGenSamplers CAN_CALL
+#define CAN_CALL_glSamplerParameterf CAN_CALL
+#define CAN_CALL_glSamplerParameteri CAN_CALL
+#else
+#define CAN_CALL_glDeleteSamplers 0
+#define CAN_CALL_glGenSamplers 0
+#define CAN_CALL_glSamplerParameterf 0
+#define CAN_CALL_glSamplerParameteri 0
+#endif
+
+void iglDeleteSamplers(GLsizei n, const GLuint* samplers) {
+  GLEXTENSION_METHOD_BODY(
+      CAN_CALL_glDeleteSamplers, glDeleteSamplers, PFNIGLDELETESAMPLERSPROC, n, samplers);
+}
+
+void iglGenSamplers(GLsizei n, GLuint* samplers) {
+  GLEXTENSION_METHOD_BODY(
+      CAN_CALL_glGenSamplers, glGenSamplers, PFNIGLGENSAMPLERSPROC, n, samplers);
+}
+
+void iglSamplerParameterf(GLuint sampler, GLenum pname, GLfloat param) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glSamplerParameterf,
+                          glSamplerParameterf,
+                          PFNIGLSAMPLERPARAMETERFPROC,
+                          sampler,
+                          pname,
+                          param);
+}
+
+void iglSamplerParameteri(GLuint sampler, GLenum pname, GLint param) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glSamplerParameteri,
+                          glSamplerParameteri,
+                          PFNIGLSAMPLERPARAMETERIPROC,
+                          sampler,
+                          pname,
+                          param);
+}
+
 ///--------------------------------------
 /// MARK: - GL_ARB_shader_image_load_store
 
@@ -1436,6 +1550,30 @@ void iglImportMemoryFdEXT(GLuint memory, GLuint64 size, GLenum handleType, GLint
                           fd);
 }
 
+///--------------------------------------
+/// MARK: - GL_EXT_multi_draw_arrays
+
+#if defined(GL_EXT_multi_draw_arrays)
+#define CAN_CALL_glMultiDrawElementsEXT CAN_CALL_OPENGL_ES
+#else
+#define CAN_CALL_glMultiDrawElementsEXT 0
+#endif
+
+void iglMultiDrawElementsEXT(GLenum mode,
+                             const GLsizei* count,
+                             GLenum type,
+                             const void* const* indices,
+                             GLsizei primcount) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glMultiDrawElementsEXT,
+                          glMultiDrawElementsEXT,
+                          PFNIGLMULTIDRAWELEMENTSPROC,
+                          mode,
+                          count,
+                          type,
+                          indices,
+                          primcount);
+}
+
 ///--------------------------------------
 /// MARK: - GL_EXT_multisampled_render_to_texture
 
@@ -1721,15 +1859,33 @@ void iglPushDebugGroupKHR(GLenum source, GLuint id, GLsizei length, const GLchar
                           message);
 }
 
+///--------------------------------------
+/// MARK: - GL_KHR_parallel_shader_compile
+
+#if defined(GL_KHR_parallel_shader_compile)
+#define CAN_CALL_glMaxShaderCompilerThreadsKHR CAN_CALL
+#else
+#define CAN_CALL_glMaxShaderCompilerThreadsKHR 0
+#endif
+
+void iglMaxShaderCompilerThreadsKHR(GLuint count) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glMaxShaderCompilerThreadsKHR,
+                          glMaxShaderCompilerThreadsKHR,
+                          PFNIGLMAXSHADERCOMPILERTHREADSPROC,
+                          count);
+}
+
 ///--------------------------------------
 /// MARK: - GL_NV_bindless_texture
 
 #if defined(GL_NV_bindless_texture)
 #define CAN_CALL_glGetTextureHandleNV CAN_CALL
+#define CAN_CALL_glGetTextureSamplerHandleNV CAN_CALL
 #define CAN_CALL_glMakeTextureHandleResidentNV CAN_CALL
 #define CAN_CALL_glMakeTextureHandleNonResidentNV CAN_CALL
 #else
 #define CAN_CALL_glGetTextureHandleNV 0
+#define CAN_CALL_glGetTextureSamplerHandleNV 0
 #define CAN_CALL_glMakeTextureHandleResidentNV 0
 #define CAN_CALL_glMakeTextureHandleNonResidentNV 0
 #endif
@@ -1742,6 +1898,15 @@ GLuint64 iglGetTextureHandleNV(GLuint texture) {
                                       texture);
 }
 
+GLuint64 iglGetTextureSamplerHandleNV(GLuint texture, GLuint sampler) {
+  GLEXTENSION_METHOD_BODY_WITH_RETURN(CAN_CALL_glGetTextureSamplerHandleNV,
+                                      glGetTextureSamplerHandleNV,
+                                      PFNIGLGETTEXTURESAMPLERHANDLEPROC,
+                                      GL_ZERO,
+                                      texture,
+                                      sampler);
+}
+
 void iglMakeTextureHandleResidentNV(GLuint64 handle) {
   GLEXTENSION_METHOD_BODY(CAN_CALL_glMakeTextureHandleResidentNV,
                           glMakeTextureHandleResidentNV,
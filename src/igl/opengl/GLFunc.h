@@ -95,6 +95,7 @@ using PFNIGLDEBUGMESSAGEINSERTPROC = void (*)(GLenum source,
 using PFNIGLDELETEFRAMEBUFFERSPROC = void (*)(GLsizei n, const GLuint* framebuffers);
 using PFNIGLDELETEMEMORYOBJECTSPROC = void (*)(GLsizei n, const GLuint* memoryObjects);
 using PFNIGLDELETERENDERBUFFERSPROC = void (*)(GLsizei n, const GLuint* renderbuffers);
+using PFNIGLDELETESAMPLERSPROC = void (*)(GLsizei n, const GLuint* samplers);
 using PFNIGLDELETESYNCPROC = void (*)(GLsync sync);
 using PFNIGLDELETEVERTEXARRAYSPROC = void (*)(GLsizei n, const GLuint* vertexArrays);
 using PFNIGLDISCARDFRAMEBUFFERPROC = void (*)(GLenum target,
@@ -137,6 +138,7 @@ using PFNIGLFRAMEBUFFERTEXTUREMULTIVIEWPROC = void (*)(GLenum target,
 using PFNIGLGENERATEMIPMAPPROC = void (*)(GLenum target);
 using PFNIGLGENFRAMEBUFFERSPROC = void (*)(GLsizei n, GLuint* framebuffers);
 using PFNIGLGENRENDERBUFFERSPROC = void (*)(GLsizei n, GLuint* renderbuffers);
+using PFNIGLGENSAMPLERSPROC = void (*)(GLsizei n, GLuint* samplers);
 using PFNIGLGENVERTEXARRAYSPROC = void (*)(GLsizei n, GLuint* vertexArrays);
 using PFNIGLGETACTIVEUNIFORMSIVPROC = void (*)(GLuint program,
                                                GLsizei uniformCount,
@@ -190,6 +192,7 @@ using PFNIGLGETSTRINGIPROC = const GLubyte* (*)(GLenum name, GLuint index);
 using PFNIGLGETSYNCIVPROC =
     void (*)(GLsync sync, GLenum pname, GLsizei bufSize, GLsizei* length, GLint* values);
 using PFNIGLGETTEXTUREHANDLEPROC = GLuint64 (*)(GLuint texture);
+using PFNIGLGETTEXTURESAMPLERHANDLEPROC = GLuint64 (*)(GLuint texture, GLuint sampler);
 using PFNIGLGETUNIFORMBLOCKINDEXPROC = GLuint (*)(GLuint program, const GLchar* name);
 using PFNIGLIMPORTMEMORYFDPROC = void (*)(GLuint memory,
                                           GLuint64 size,
@@ -208,7 +211,13 @@ using PFNIGLMAPBUFFERRANGEPROC = void* (*)(GLenum target,
                                            GLintptr offset,
                                            GLsizeiptr length,
                                            GLbitfield access);
+using PFNIGLMAXSHADERCOMPILERTHREADSPROC = void (*)(GLuint count);
 using PFNIGLMEMORYBARRIERPROC = void (*)(GLbitfield barriers);
+using PFNIGLMULTIDRAWELEMENTSPROC = void (*)(GLenum mode,
+                                             const GLsizei* count,
+                                             GLenum type,
+                                             const void* const* indices,
+                                             GLsizei drawcount);
 using PFNIGLOBJECTLABELPROC = void (*)(GLenum identifier,
                                        GLuint name,
                                        GLsizei length,
@@ -226,6 +235,8 @@ using PFNIGLRENDERBUFFERSTORAGEPROC = void (*)(GLenum target,
                                                GLsizei height);
 using PFNIGLRENDERBUFFERSTORAGEMULTISAMPLEPROC =
     void (*)(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height);
+using PFNIGLSAMPLERPARAMETERFPROC = void (*)(GLuint sampler, GLenum pname, GLfloat param);
+using PFNIGLSAMPLERPARAMETERIPROC = void (*)(GLuint sampler, GLenum pname, GLint param);
 using PFNIGLTEXIMAGE3DPROC = void (*)(GLenum target,
                                       GLint level,
                                       GLint internalformat,
@@ -366,6 +377,20 @@ void iglDrawElementsInstanced(GLenum mode,
                               const void* indices,
                               GLsizei instancecount);
 void iglDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei primcount);
+void iglMultiDrawElements(GLenum mode,
+                          const GLsizei* count,
+                          GLenum type,
+                          const void* const* indices,
+                          GLsizei drawcount);
+
+///--------------------------------------
+/// MARK: - GL_ANGLE_multi_draw
+
+void iglMultiDrawElementsANGLE(GLenum mode,
+                               const GLsizei* counts,
+                               GLenum type,
+                               const void* const* offsets,
+                               GLsizei drawcount);
 
 ///--------------------------------------
 /// MARK: - GL_APPLE_framebuffer_multisample
@@ -386,6 +411,7 @@ void iglGetSyncivAPPLE(GLsync sync, GLenum pname, GLsizei bufSize, GLsizei* leng
 /// MARK: - GL_ARB_bindless_texture
 
 GLuint64 iglGetTextureHandleARB(GLuint texture);
+GLuint64 iglGetTextureSamplerHandleARB(GLuint texture, GLuint sampler);
 void iglMakeTextureHandleResidentARB(GLuint64 handle);
 void iglMakeTextureHandleNonResidentARB(GLuint64 handle);
 
@@ -465,6 +491,11 @@ void iglInvalidateFramebuffer(GLenum target, GLsizei numAttachments, const GLenu
 
 void* iglMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
 
+///--------------------------------------
+/// MARK: - GL_ARB_parallel_shader_compile
+
+void iglMaxShaderCompilerThreadsARB(GLuint count);
+
 ///--------------------------------------
 /// MARK: - GL_ARB_program_interface_query
 
@@ -485,6 +516,14 @@ void iglGetProgramResourceName(GLuint program,
                                GLsizei* length,
                                char* name);
 
+///--------------------------------------
+/// MARK: - GL_ARB_sampler_objects
+
+void iglDeleteSamplers(GLsizei n, const GLuint* samplers);
+void iglGenSamplers(GLsizei n, GLuint* samplers);
+void iglSamplerParameterf(GLuint sampler, GLenum pname, GLfloat param);
+void iglSamplerParameteri(GLuint sampler, GLenum pname, GLint param);
+
 ///--------------------------------------
 /// MARK: - GL_ARB_shader_image_load_store
 
@@ -630,6 +669,15 @@ void iglTexStorageMem3DEXT(GLenum target,
 
 void iglImportMemoryFdEXT(GLuint memory, GLuint64 size, GLenum handleType, GLint fd);
 
+///--------------------------------------
+/// MARK: - GL_EXT_multi_draw_arrays
+
+void iglMultiDrawElementsEXT(GLenum mode,
+                             const GLsizei* count,
+                             GLenum type,
+                             const void* const* indices,
+                             GLsizei primcount);
+
 ///--------------------------------------
 /// MARK: - GL_EXT_multisampled_render_to_texture
 
@@ -710,10 +758,16 @@ void iglObjectLabelKHR(GLenum identifier, GLuint name, GLsizei length, const cha
 void iglPopDebugGroupKHR();
 void iglPushDebugGroupKHR(GLenum source, GLuint id, GLsizei length, const GLchar* message);
 
+///--------------------------------------
+/// MARK: - GL_KHR_parallel_shader_compile
+
+void iglMaxShaderCompilerThreadsKHR(GLuint count);
+
 ///--------------------------------------
 /// MARK: - GL_NV_bindless_texture
 
 GLuint64 iglGetTextureHandleNV(GLuint texture);
+GLuint64 iglGetTextureSamplerHandleNV(GLuint texture, GLuint sampler);
 void iglMakeTextureHandleResidentNV(GLuint64 handle);
 void iglMakeTextureHandleNonResidentNV(GLuint64 handle);
 
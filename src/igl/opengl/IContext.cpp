@@ -2231,6 +2231,53 @@ void* IContext::mapBufferRange(GLenum target,
   return ret;
 }
 
+void IContext::maxShaderCompilerThreads(GLuint count) {
+  if (maxShaderCompilerThreadsProc_ == nullptr) {
+    if (deviceFeatureSet_.hasExtension(Extensions::ParallelShaderCompileKhr)) {
+      maxShaderCompilerThreadsProc_ = iglMaxShaderCompilerThreadsKHR;
+    } else if (deviceFeatureSet_.hasExtension(Extensions::ParallelShaderCompileArb)) {
+      maxShaderCompilerThreadsProc_ = iglMaxShaderCompilerThreadsARB;
+    }
+    IGL_DEBUG_ASSERT(maxShaderCompilerThreadsProc_,
+                     "No supported function for glMaxShaderCompilerThreads\n");
+  }
+
+  GLCALL_PROC(maxShaderCompilerThreadsProc_, count);
+  APILOG("glMaxShaderCompilerThreads(%u)\n", count);
+  GLCHECK_ERRORS();
+}
+
+void IContext::multiDrawElements(GLenum mode,
+                                 const GLsizei* count,
+                                 GLenum type,
+                                 const void* const* indices,
+                                 GLsizei drawcount) {
+  if (multiDrawElementsProc_ == nullptr) {
+    if (!DeviceFeatureSet::usesOpenGLES()) {
+      multiDrawElementsProc_ = iglMultiDrawElements;
+    } else if (deviceFeatureSet_.hasExtension(Extensions::MultiDrawAngle)) {
+      multiDrawElementsProc_ = iglMultiDrawElementsANGLE;
+    } else if (deviceFeatureSet_.hasExtension(Extensions::MultiDrawArraysExt)) {
+      multiDrawElementsProc_ = iglMultiDrawElementsEXT;
+    }
+    IGL_DEBUG_ASSERT(multiDrawElementsProc_, "No supported function for glMultiDrawElements\n");
+  }
+
+  drawCallCount_ += drawcount;
+
+  IGL_PROFILER_ZONE_GPU_COLOR_OGL("multiDrawElements()", IGL_PROFILER_COLOR_DRAW);
+
+  GLCALL_PROC(multiDrawElementsProc_, mode, count, type, indices, drawcount);
+  APILOG("glMultiDrawElements(%s, %p, %s, %p, %d)\n",
+         GL_ENUM_TO_STRING(mode),
+         count,
+         GL_ENUM_TO_STRING(type),
+         indices,
+         drawcount);
+  GLCHECK_ERRORS();
+  APILOG_DEC_DRAW_COUNT();
+}
+
 void IContext::objectLabel(GLenum identifier, GLuint name, GLsizei length, const char* label) {
   if (objectLabelProc_ == nullptr) {
     if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::DebugLabelExtReq)) {
@@ -3003,6 +3050,24 @@ GLuint64 IContext::getTextureHandle(GLuint texture) {
   return ret;
 }
 
+GLuint64 IContext::getTextureSamplerHandle(GLuint texture, GLuint sampler) {
+  if (getTextureSamplerHandleProc_ == nullptr) {
+    if (deviceFeatureSet_.hasExtension(Extensions::BindlessTextureArb)) {
+      getTextureSamplerHandleProc_ = iglGetTextureSamplerHandleARB;
+    } else if (deviceFeatureSet_.hasExtension(Extensions::BindlessTextureNv)) {
+      getTextureSamplerHandleProc_ = iglGetTextureSamplerHandleNV;
+    }
+    IGL_DEBUG_ASSERT(getTextureSamplerHandleProc_,
+                     "No supported function for glGetTextureSamplerHandle\n");
+  }
+
+  GLuint64 ret;
+  GLCALL_PROC_WITH_RETURN(ret, getTextureSamplerHandleProc_, GL_ZERO, texture, sampler);
+  APILOG("glGetTextureSamplerHandle(%u, %u) = %llu\n", texture, sampler, ret);
+  GLCHECK_ERRORS();
+  return ret;
+}
+
 void IContext::makeTextureHandleResident(GLuint64 handle) {
   if (makeTextureHandleResidentProc_ == nullptr) {
     if (deviceFeatureSet_.hasExtension(Extensions::BindlessTextureArb)) {
@@ -3035,6 +3100,32 @@ void IContext::makeTextureHandleNonResident(GLuint64 handle) {
   GLCHECK_ERRORS();
 }
 
+void IContext::genSamplers(GLsizei n, GLuint* samplers) {
+  IGLCALL(GenSamplers)(n, samplers);
+  APILOG("glGenSamplers(%u, %p)\n", n, samplers);
+  GLCHECK_ERRORS();
+}
+
+void IContext::deleteSamplers(GLsizei n, const GLuint* samplers) {
+  if (isDestructionAllowed() && IGL_DEBUG_VERIFY(samplers != nullptr)) {
+    IGLCALL(DeleteSamplers)(n, samplers);
+    APILOG("glDeleteSamplers(%u, %p)\n", n, samplers);
+    GLCHECK_ERRORS();
+  }
+}
+
+void IContext::samplerParameterf(GLuint sampler, GLenum pname, GLfloat param) {
+  IGLCALL(SamplerParameterf)(sampler, pname, param);
+  APILOG("glSamplerParameterf(%u, %s, %f)\n", sampler, GL_ENUM_TO_STRING(pname), param);
+  GLCHECK_ERRORS();
+}
+
+void IContext::samplerParameteri(GLuint sampler, GLenum pname, GLint param) {
+  IGLCALL(SamplerParameteri)(sampler, pname, param);
+  APILOG("glSamplerParameteri(%u, %s, %d)\n", sampler, GL_ENUM_TO_STRING(pname), param);
+  GLCHECK_ERRORS();
+}
+
 void IContext::dispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z) {
   IGLCALL(DispatchCompute)(num_groups_x, num_groups_y, num_groups_z);
   APILOG("glDispatchCompute(%u, %u, %u)\n", num_groups_x, num_groups_y, num_groups_z);
@@ -3286,6 +3377,50 @@ bool IContext::shouldValidateShaders() const {
   return shouldValidateShaders_;
 }
 
+void IContext::setShouldDeferShaderStatusChecks(bool shouldDeferShaderStatusChecks) {
+  shouldDeferShaderStatusChecks_ = shouldDeferShaderStatusChecks;
+  if (this->shouldDeferShaderStatusChecks() && !compilerThreadsRequested_) {
+    // 0xFFFFFFFF lets the driver pick the maximum number of compiler threads it supports. Drivers
+    // may compile in the background only after this call, so it is made once deferral is on.
+    maxShaderCompilerThreads(0xFFFFFFFF);
+    compilerThreadsRequested_ = true;
+  }
+}
+
+bool IContext::shouldDeferShaderStatusChecks() const {
+  return shouldDeferShaderStatusChecks_ &&
+         deviceFeatureSet_.hasInternalFeature(InternalFeatures::ParallelShaderCompile);
+}
+
+void IContext::setShouldUseBindlessTextures(bool shouldUseBindlessTextures) {
+  shouldUseBindlessTextures_ = shouldUseBindlessTextures;
+}
+
+bool IContext::shouldUseBindlessTextures() const {
+  return shouldUseBindlessTextures_ &&
+         deviceFeatureSet_.hasExtension(Extensions::BindlessTextureArb) &&
+         deviceFeatureSet_.hasFeature(DeviceFeatures::UniformBlocks);
+}
+
+void IContext::setShouldBatchDraws(bool shouldBatchDraws) {
+  shouldBatchDraws_ = shouldBatchDraws;
+}
+
+bool IContext::shouldBatchDraws() const {
+  return shouldBatchDraws_ &&
+         deviceFeatureSet_.hasInternalFeature(InternalFeatures::MultiDrawElements);
+}
+
+void IContext::setPendingDrawsFlush(std::function<void()> flush) {
+  pendingDrawsFlush_ = std::move(flush);
+}
+
+void IContext::flushPendingDraws() const {
+  if (pendingDrawsFlush_) {
+    pendingDrawsFlush_();
+  }
+}
+
 void IContext::SynchronizedDeletionQueues::flushDeletionQueue(IContext& context) {
   if (IGL_DEBUG_VERIFY(context.isCurrentContext() || context.isCurrentSharegroup())) {
     swapScratchDeletionQueues();
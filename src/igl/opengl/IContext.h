@@ -19,6 +19,7 @@
 #include <igl/opengl/UnbindPolicy.h>
 #include <igl/opengl/Version.h>
 #include <igl/opengl/WithContext.h>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -31,6 +32,17 @@ namespace igl::opengl {
 // For the time being, we only need to differentiate gles2 and gles3
 enum class RenderingAPI { GLES2, GLES3, GL };
 
+/// Uniform block binding used for the texture handles of bindless texture bind groups. Shaders
+/// declare the handles as a std140 block of samplers at this binding, e.g.
+/// `layout(std140, binding = 15) uniform BindlessTextures { sampler2D textures[16]; };`
+constexpr uint32_t kBindlessTexturesBlockBinding = IGL_UNIFORM_BLOCKS_BINDING_MAX - 1;
+
+struct BindGroupMetadataTextures {
+  BindGroupTextureDesc desc;
+  // Uniform buffer with one resident texture handle per slot when bindless textures are enabled
+  std::shared_ptr<IBuffer> bindlessHandles;
+};
+
 ///
 /// Represents an pure abstract class that encapsulates in it an OpenGL context.
 /// Individual types that implement this class are the ones that provide implementation
@@ -286,6 +298,12 @@ class IContext {
   void linkProgram(GLuint program);
   void* mapBuffer(GLenum target, GLbitfield access);
   void* mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+  void maxShaderCompilerThreads(GLuint count);
+  void multiDrawElements(GLenum mode,
+                         const GLsizei* count,
+                         GLenum type,
+                         const void* const* indices,
+                         GLsizei drawcount);
   void objectLabel(GLenum identifier, GLuint name, GLsizei length, const char* label);
   void pixelStorei(GLenum pname, GLint param);
   void polygonOffsetClamp(GLfloat factor, GLfloat units, float clamp);
@@ -424,13 +442,19 @@ class IContext {
   void vertexAttribDivisor(GLuint index, GLuint divisor);
   void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
 
+  void genSamplers(GLsizei n, GLuint* samplers);
+  void deleteSamplers(GLsizei n, const GLuint* samplers);
+  void samplerParameterf(GLuint sampler, GLenum pname, GLfloat param);
+  void samplerParameteri(GLuint sampler, GLenum pname, GLint param);
+
   void dispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z);
   void memoryBarrier(GLbitfield barriers);
   GLuint64 getTextureHandle(GLuint texture);
+  GLuint64 getTextureSamplerHandle(GLuint texture, GLuint sampler);
   void makeTextureHandleResident(GLuint64 handle);
   void makeTextureHandleNonResident(GLuint64 handle);
 
-  /** Returns current `callCounter_` value. Exposed for testing only. */
+  /** Returns current `callCounter_` value. Exposed for testing and benchmarking only. */
   unsigned int getCallCount() const;
 
   unsigned int getCurrentDrawCount() const;
@@ -449,6 +473,49 @@ class IContext {
 
   void setShouldValidateShaders(bool shouldValidateShaders);
   bool shouldValidateShaders() const;
+
+  /** Enables or disables deferred compile/link status checks for render programs.
+   * When enabled and GL_KHR_parallel_shader_compile (or GL_ARB_parallel_shader_compile) is
+   * available, shader modules and render programs no longer block on GL_COMPILE_STATUS and
+   * GL_LINK_STATUS at creation time. Compile and link errors are then reported through
+   * IRenderPipelineState::getStatus(), and IRenderPipelineState::isReady() can be polled to avoid
+   * stalling on a program that is still being compiled. Disabled by default.
+   */
+  void setShouldDeferShaderStatusChecks(bool shouldDeferShaderStatusChecks);
+  bool shouldDeferShaderStatusChecks() const;
+
+  /**
+   * When enabled and GL_ARB_bindless_texture is available, texture bind groups created afterwards
+   * store resident texture handles in a uniform buffer. Binding such a group binds that buffer to
+   * kBindlessTexturesBlockBinding instead of binding each texture to a texture unit. Each
+   * texture/sampler pair gets its own handle, created from a GL sampler object, so bind groups may
+   * combine a texture with different samplers. Handles stay resident for the lifetime of the
+   * texture. Disabled by default.
+   *
+   * Creating a handle makes the sampling parameters of a texture immutable. A texture used by a
+   * bindless bind group and also bound to a texture unit is sampled there with the parameters it
+   * had when its first handle was created, whichever sampler state is bound with it.
+   */
+  void setShouldUseBindlessTextures(bool shouldUseBindlessTextures);
+  bool shouldUseBindlessTextures() const;
+
+  /**
+   * When enabled and glMultiDrawElements (or GL_EXT_multi_draw_arrays / GL_ANGLE_multi_draw) is
+   * available, render command encoders created afterwards collect consecutive non-instanced
+   * drawIndexed() calls that share all state and issue them with a single glMultiDrawElements call.
+   * Batched draws are flushed on the next state change, before any buffer or texture upload and
+   * at the end of encoding. Disabled by default.
+   */
+  void setShouldBatchDraws(bool shouldBatchDraws);
+  bool shouldBatchDraws() const;
+
+  /**
+   * Registers the function a batching render command encoder uses to issue its pending draws.
+   * Buffers and textures call flushPendingDraws() before they bind and upload, so batched draws
+   * read the data that was current when they were encoded. Pass nullptr to unregister.
+   */
+  void setPendingDrawsFlush(std::function<void()> flush);
+  void flushPendingDraws() const;
   inline bool isDestructionAllowed() const {
     return lockCount_ == 0;
   }
@@ -514,7 +581,7 @@ class IContext {
 
  public:
   mutable Pool<BindGroupBufferTag, BindGroupBufferDesc> bindGroupBuffersPool_;
-  mutable Pool<BindGroupTextureTag, BindGroupTextureDesc> bindGroupTexturesPool_;
+  mutable Pool<BindGroupTextureTag, BindGroupMetadataTextures> bindGroupTexturesPool_;
 
  protected:
   static std::unordered_map<void*, IContext*>& getExistingContexts();
@@ -531,6 +598,12 @@ class IContext {
   int lockCount_ = 0; // used by DestructionGuard
   int refCount_ = 0; // used by addRef/releaseRef
   bool shouldValidateShaders_ = false;
+  bool shouldDeferShaderStatusChecks_ = false;
+  // glMaxShaderCompilerThreads has been called, see setShouldDeferShaderStatusChecks()
+  bool compilerThreadsRequested_ = false;
+  bool shouldUseBindlessTextures_ = false;
+  bool shouldBatchDraws_ = false;
+  std::function<void()> pendingDrawsFlush_;
 
   // API Logging
   unsigned int apiLogDrawsLeft_ = 0;
@@ -554,11 +627,14 @@ class IContext {
   mutable PFNIGLGETDEBUGMESSAGELOGPROC getDebugMessageLogProc_ = nullptr;
   mutable PFNIGLGETSYNCIVPROC getSyncivProc_ = nullptr;
   PFNIGLGETTEXTUREHANDLEPROC getTextureHandleProc_ = nullptr;
+  PFNIGLGETTEXTURESAMPLERHANDLEPROC getTextureSamplerHandleProc_ = nullptr;
   PFNIGLMAKETEXTUREHANDLERESIDENTPROC makeTextureHandleResidentProc_ = nullptr;
   PFNIGLMAKETEXTUREHANDLENONRESIDENTPROC makeTextureHandleNonResidentProc_ = nullptr;
   PFNIGLMAPBUFFERPROC mapBufferProc_ = nullptr;
   PFNIGLMAPBUFFERRANGEPROC mapBufferRangeProc_ = nullptr;
+  PFNIGLMAXSHADERCOMPILERTHREADSPROC maxShaderCompilerThreadsProc_ = nullptr;
   PFNIGLMEMORYBARRIERPROC memoryBarrierProc_ = nullptr;
+  PFNIGLMULTIDRAWELEMENTSPROC multiDrawElementsProc_ = nullptr;
   PFNIGLOBJECTLABELPROC objectLabelProc_ = nullptr;
   PFNIGLPOPDEBUGGROUPPROC popDebugGroupProc_ = nullptr;
   PFNIGLPUSHDEBUGGROUPPROC pushDebugGroupProc_ = nullptr;
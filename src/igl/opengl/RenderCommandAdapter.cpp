@@ -246,7 +246,9 @@ void RenderCommandAdapter::setPipelineState(const std::shared_ptr<IRenderPipelin
 }
 
 void RenderCommandAdapter::drawArrays(GLenum mode, GLint first, GLsizei count) {
-  willDraw();
+  if (!willDraw()) {
+    return;
+  }
   getContext().drawArrays(toMockWireframeMode(mode), first, count);
   didDraw();
 }
@@ -254,7 +256,9 @@ void RenderCommandAdapter::drawArrays(GLenum mode, GLint first, GLsizei count) {
 void RenderCommandAdapter::drawArraysIndirect(GLenum mode,
                                               Buffer& indirectBuffer,
                                               const GLvoid* indirectBufferOffset) {
-  willDraw();
+  if (!willDraw()) {
+    return;
+  }
   if (getContext().deviceFeatures().hasInternalFeature(InternalFeatures::DrawArraysIndirect)) {
     bindBufferWithShaderStorageBufferOverride(indirectBuffer, GL_DRAW_INDIRECT_BUFFER);
     getContext().drawArraysIndirect(toMockWireframeMode(mode), indirectBufferOffset);
@@ -268,7 +272,9 @@ void RenderCommandAdapter::drawArraysInstanced(GLenum mode,
                                                GLint first,
                                                GLsizei count,
                                                GLsizei instancecount) {
-  willDraw();
+  if (!willDraw()) {
+    return;
+  }
   if (getContext().deviceFeatures().hasInternalFeature(InternalFeatures::DrawArraysInstanced)) {
     getContext().drawArraysInstanced(toMockWireframeMode(mode), first, count, instancecount);
   } else {
@@ -281,17 +287,80 @@ void RenderCommandAdapter::drawElements(GLenum mode,
                                         GLsizei indexCount,
                                         GLenum indexType,
                                         const GLvoid* indexOffset) {
-  willDraw();
+  if (!willDraw()) {
+    return;
+  }
   getContext().drawElements(toMockWireframeMode(mode), indexCount, indexType, indexOffset);
   didDraw();
 }
 
+void RenderCommandAdapter::multiDrawElements(GLenum mode,
+                                             const GLsizei* indexCounts,
+                                             GLenum indexType,
+                                             const void* const* indexOffsets,
+                                             GLsizei drawCount) {
+  if (!willDraw()) {
+    return;
+  }
+  if (getContext().deviceFeatures().hasInternalFeature(InternalFeatures::MultiDrawElements)) {
+    getContext().multiDrawElements(
+        toMockWireframeMode(mode), indexCounts, indexType, indexOffsets, drawCount);
+  } else {
+    IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+  }
+  didDraw();
+}
+
+bool RenderCommandAdapter::isPipelineStateBound(const IRenderPipelineState* pipelineState) const {
+  return pipelineState_.get() == pipelineState;
+}
+
+bool RenderCommandAdapter::isVertexBufferBound(const Buffer& buffer,
+                                               size_t offset,
+                                               size_t index) const {
+  return index < IGL_VERTEX_BUFFER_MAX && vertexBuffers_[index].resource == &buffer &&
+         vertexBuffers_[index].offset == offset;
+}
+
+bool RenderCommandAdapter::isUniformBufferBound(const Buffer& buffer,
+                                                size_t offset,
+                                                size_t size,
+                                                uint32_t index) const {
+  return uniformAdapter_.isUniformBufferBound(&buffer, offset, size, index);
+}
+
+bool RenderCommandAdapter::isTextureBound(const ITexture* texture,
+                                          size_t index,
+                                          uint8_t bindTarget) const {
+  if (index >= IGL_TEXTURE_SAMPLERS_MAX) {
+    return false;
+  }
+  return ((bindTarget & BindTarget::kVertex) == 0 ||
+          vertexTextureStates_[index].first == texture) &&
+         ((bindTarget & BindTarget::kFragment) == 0 ||
+          fragmentTextureStates_[index].first == texture);
+}
+
+bool RenderCommandAdapter::isSamplerStateBound(const ISamplerState* samplerState,
+                                               size_t index,
+                                               uint8_t bindTarget) const {
+  if (index >= IGL_TEXTURE_SAMPLERS_MAX) {
+    return false;
+  }
+  return ((bindTarget & BindTarget::kVertex) == 0 ||
+          vertexTextureStates_[index].second == samplerState) &&
+         ((bindTarget & BindTarget::kFragment) == 0 ||
+          fragmentTextureStates_[index].second == samplerState);
+}
+
 void RenderCommandAdapter::drawElementsInstanced(GLenum mode,
                                                  GLsizei indexCount,
                                                  GLenum indexType,
                                                  const GLvoid* indexOffset,
                                                  GLsizei instancecount) {
-  willDraw();
+  if (!willDraw()) {
+    return;
+  }
   if (getContext().deviceFeatures().hasInternalFeature(InternalFeatures::DrawElementsInstanced)) {
     getContext().drawElementsInstanced(
         toMockWireframeMode(mode), indexCount, indexType, indexOffset, instancecount);
@@ -305,7 +374,9 @@ void RenderCommandAdapter::drawElementsIndirect(GLenum mode,
                                                 GLenum indexType,
                                                 Buffer& indirectBuffer,
                                                 const GLvoid* indirectBufferOffset) {
-  willDraw();
+  if (!willDraw()) {
+    return;
+  }
   if (getContext().deviceFeatures().hasFeature(DeviceFeatures::DrawIndexedIndirect)) {
     bindBufferWithShaderStorageBufferOverride(indirectBuffer, GL_DRAW_INDIRECT_BUFFER);
     getContext().drawElementsIndirect(toMockWireframeMode(mode), indexType, indirectBufferOffset);
@@ -336,12 +407,17 @@ void RenderCommandAdapter::endEncoding() {
   dirtyStateBits_ = EnumToValue(StateMask::NONE);
 }
 
-void RenderCommandAdapter::willDraw() {
+bool RenderCommandAdapter::willDraw() {
   Result ret;
   auto* pipelineState = static_cast<RenderPipelineState*>(pipelineState_.get());
 
   // Vertex Buffers must be bound before pipelineState->bind()
   if (pipelineState) {
+    if (isDirty(StateMask::PIPELINE) && !pipelineState->getStatus().isOk()) {
+      // The pipeline failed to link after it was created, drawing with it would use program 0
+      IGL_LOG_ERROR_ONCE("Skipping draws with a render pipeline that failed to link\n");
+      return false;
+    }
     pipelineState->clearActiveAttributesLocations();
     for (size_t bufferIndex = 0; bufferIndex < IGL_VERTEX_BUFFER_MAX; ++bufferIndex) {
       if (IS_DIRTY(vertexBuffersDirty_, bufferIndex)) {
@@ -384,7 +460,9 @@ void RenderCommandAdapter::willDraw() {
   static const size_t kFragmentTextureStatesSize = fragmentTextureStates_.size();
   if (pipelineState) {
     // Bind uniforms to be used for render
-    uniformAdapter_.bindToPipeline(getContext());
+    const auto* shaderStages = pipelineState->getShaderStages();
+    uniformAdapter_.bindToPipeline(getContext(),
+                                   shaderStages ? &shaderStages->getUniformBindPlan() : nullptr);
     for (size_t index = 0; index < kVertexTextureStatesSize; index++) {
       if (!IS_DIRTY(vertexTextureStatesDirty_, index)) {
         continue;
@@ -435,6 +513,7 @@ void RenderCommandAdapter::willDraw() {
       }
     }
   }
+  return true;
 }
 
 void RenderCommandAdapter::unbindTexture(IContext& context,
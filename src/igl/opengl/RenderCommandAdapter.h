@@ -99,6 +99,23 @@ class RenderCommandAdapter final : public WithContext {
                             GLenum indexType,
                             Buffer& indirectBuffer,
                             const GLvoid* indirectBufferOffset);
+  void multiDrawElements(GLenum mode,
+                         const GLsizei* indexCounts,
+                         GLenum indexType,
+                         const void* const* indexOffsets,
+                         GLsizei drawCount);
+
+  // These report whether binding the given resource would leave the current state unchanged
+  [[nodiscard]] bool isPipelineStateBound(const IRenderPipelineState* pipelineState) const;
+  [[nodiscard]] bool isVertexBufferBound(const Buffer& buffer, size_t offset, size_t index) const;
+  [[nodiscard]] bool isUniformBufferBound(const Buffer& buffer,
+                                          size_t offset,
+                                          size_t size,
+                                          uint32_t index) const;
+  [[nodiscard]] bool isTextureBound(const ITexture* texture, size_t index, uint8_t bindTarget) const;
+  [[nodiscard]] bool isSamplerStateBound(const ISamplerState* samplerState,
+                                         size_t index,
+                                         uint8_t bindTarget) const;
 
   void endEncoding();
 
@@ -116,7 +133,8 @@ class RenderCommandAdapter final : public WithContext {
 
   void clearDependentResources(const std::shared_ptr<IRenderPipelineState>& newValue,
                                Result* outResult = nullptr);
-  void willDraw();
+  // Returns false if the draw must be skipped because the bound pipeline is unusable
+  [[nodiscard]] bool willDraw();
   void didDraw();
   void unbindVertexAttributes();
 
@@ -89,7 +89,12 @@ std::unique_ptr<RenderCommandEncoder> RenderCommandEncoder::create(
   return newEncoder;
 }
 
-RenderCommandEncoder::~RenderCommandEncoder() = default;
+RenderCommandEncoder::~RenderCommandEncoder() {
+  if (shouldBatchDraws_) {
+    // Encoding was never ended, don't leave the context with a dangling flush
+    getContext().setPendingDrawsFlush(nullptr);
+  }
+}
 
 void RenderCommandEncoder::beginEncoding(const RenderPassDesc& renderPass,
                                          const std::shared_ptr<IFramebuffer>& framebuffer,
@@ -99,6 +104,11 @@ void RenderCommandEncoder::beginEncoding(const RenderPassDesc& renderPass,
 
   scissorEnabled_ = (context.isEnabled(GL_SCISSOR_TEST) != 0u);
   context.disable(GL_SCISSOR_TEST); // only turn on if bindScissorRect is called
+  shouldBatchDraws_ = context.shouldBatchDraws();
+  if (shouldBatchDraws_) {
+    // Buffer and texture uploads reach GL immediately, so batched draws must be issued first
+    context.setPendingDrawsFlush([this]() { flushPendingDraws(); });
+  }
 
   auto& pool = context.getAdapterPool();
   if (pool.empty()) {
@@ -128,6 +138,11 @@ void RenderCommandEncoder::beginEncoding(const RenderPassDesc& renderPass,
 }
 
 void RenderCommandEncoder::endEncoding() {
+  flushPendingDraws();
+  if (shouldBatchDraws_) {
+    getContext().setPendingDrawsFlush(nullptr);
+    shouldBatchDraws_ = false;
+  }
   if (IGL_DEBUG_VERIFY(adapter_)) {
     // Restore caller state
     getContext().setEnabled(scissorEnabled_, GL_SCISSOR_TEST);
@@ -200,6 +215,7 @@ void RenderCommandEncoder::endEncoding() {
 
 void RenderCommandEncoder::pushDebugGroupLabel(const char* label,
                                                const igl::Color& /*color*/) const {
+  flushPendingDraws();
   IGL_DEBUG_ASSERT(adapter_);
   IGL_DEBUG_ASSERT(label != nullptr && *label);
   if (getContext().deviceFeatures().hasInternalFeature(InternalFeatures::DebugMessage)) {
@@ -212,6 +228,7 @@ void RenderCommandEncoder::pushDebugGroupLabel(const char* label,
 
 void RenderCommandEncoder::insertDebugEventLabel(const char* label,
                                                  const igl::Color& /*color*/) const {
+  flushPendingDraws();
   IGL_DEBUG_ASSERT(adapter_);
   IGL_DEBUG_ASSERT(label != nullptr && *label);
   if (getContext().deviceFeatures().hasInternalFeature(InternalFeatures::DebugMessage)) {
@@ -224,6 +241,7 @@ void RenderCommandEncoder::insertDebugEventLabel(const char* label,
 }
 
 void RenderCommandEncoder::popDebugGroupLabel() const {
+  flushPendingDraws();
   IGL_DEBUG_ASSERT(adapter_);
   if (getContext().deviceFeatures().hasInternalFeature(InternalFeatures::DebugMessage)) {
     getContext().popDebugGroup();
@@ -233,12 +251,14 @@ void RenderCommandEncoder::popDebugGroupLabel() const {
 }
 
 void RenderCommandEncoder::bindViewport(const Viewport& viewport) {
+  flushPendingDraws();
   if (IGL_DEBUG_VERIFY(adapter_)) {
     adapter_->setViewport(viewport);
   }
 }
 
 void RenderCommandEncoder::bindScissorRect(const ScissorRect& rect) {
+  flushPendingDraws();
   if (IGL_DEBUG_VERIFY(adapter_)) {
     adapter_->setScissorRect(rect);
   }
@@ -247,18 +267,23 @@ void RenderCommandEncoder::bindScissorRect(const ScissorRect& rect) {
 void RenderCommandEncoder::bindRenderPipelineState(
     const std::shared_ptr<IRenderPipelineState>& pipelineState) {
   if (IGL_DEBUG_VERIFY(adapter_)) {
+    if (!adapter_->isPipelineStateBound(pipelineState.get())) {
+      flushPendingDraws();
+    }
     adapter_->setPipelineState(pipelineState);
   }
 }
 
 void RenderCommandEncoder::bindDepthStencilState(
     const std::shared_ptr<IDepthStencilState>& depthStencilState) {
+  flushPendingDraws();
   if (IGL_DEBUG_VERIFY(adapter_)) {
     adapter_->setDepthStencilState(depthStencilState);
   }
 }
 
 void RenderCommandEncoder::bindUniform(const UniformDesc& uniformDesc, const void* data) {
+  flushPendingDraws();
   IGL_DEBUG_ASSERT(uniformDesc.location >= 0,
                    "Invalid location passed to bindUniformBuffer: %d",
                    uniformDesc.location);
@@ -279,6 +304,9 @@ void RenderCommandEncoder::bindBuffer(uint32_t index,
     if (bufferType == Buffer::Type::Uniform) {
       IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
     } else if (bufferType == Buffer::Type::UniformBlock) {
+      if (!adapter_->isUniformBufferBound(*glBuffer, offset, bufferSize, index)) {
+        flushPendingDraws();
+      }
       adapter_->setUniformBuffer(glBuffer, offset, bufferSize, index);
     }
   }
@@ -290,6 +318,9 @@ void RenderCommandEncoder::bindVertexBuffer(uint32_t index, IBuffer& buffer, siz
 
     IGL_DEBUG_ASSERT(glBuffer.getType() == Buffer::Type::Attribute);
 
+    if (!adapter_->isVertexBufferBound(glBuffer, bufferOffset, index)) {
+      flushPendingDraws();
+    }
     adapter_->setVertexBuffer(glBuffer, bufferOffset, static_cast<int>(index));
   }
 }
@@ -298,7 +329,13 @@ void RenderCommandEncoder::bindIndexBuffer(IBuffer& buffer,
                                            IndexFormat format,
                                            size_t bufferOffset) {
   if (IGL_DEBUG_VERIFY(adapter_)) {
-    indexType_ = toGlType(format);
+    const GLenum indexType = toGlType(format);
+    if (indexBuffer_ != &buffer || indexType_ != indexType) {
+      // Pending draws may keep their own offsets, but not a different buffer or index type
+      flushPendingDraws();
+    }
+    indexBuffer_ = &buffer;
+    indexType_ = indexType;
     indexBufferOffset_ = reinterpret_cast<void*>(bufferOffset);
     adapter_->setIndexBuffer((Buffer&)buffer);
   }
@@ -321,6 +358,9 @@ void RenderCommandEncoder::bindSamplerState(size_t index,
                                             uint8_t bindTarget,
                                             ISamplerState* samplerState) {
   if (IGL_DEBUG_VERIFY(adapter_)) {
+    if (!adapter_->isSamplerStateBound(samplerState, index, bindTarget)) {
+      flushPendingDraws();
+    }
     if ((bindTarget & BindTarget::kVertex) != 0) {
       adapter_->setVertexSamplerState(samplerState, index);
     }
@@ -332,6 +372,9 @@ void RenderCommandEncoder::bindSamplerState(size_t index,
 
 void RenderCommandEncoder::bindTexture(size_t index, uint8_t bindTarget, ITexture* texture) {
   if (IGL_DEBUG_VERIFY(adapter_)) {
+    if (!adapter_->isTextureBound(texture, index, bindTarget)) {
+      flushPendingDraws();
+    }
     if ((bindTarget & BindTarget::kVertex) != 0) {
       adapter_->setVertexTexture(texture, index);
     }
@@ -345,6 +388,7 @@ void RenderCommandEncoder::draw(size_t vertexCount,
                                 uint32_t instanceCount,
                                 uint32_t firstVertex,
                                 uint32_t baseInstance) {
+  flushPendingDraws();
   (void)baseInstance;
 
   IGL_DEBUG_ASSERT(baseInstance == 0, "Instancing is not implemented");
@@ -378,6 +422,16 @@ void RenderCommandEncoder::drawIndexed(size_t indexCount,
   if (IGL_DEBUG_VERIFY(adapter_ && indexType_)) {
     getCommandBuffer().incrementCurrentDrawCount();
     auto mode = toGlPrimitive(adapter_->pipelineState().getRenderPipelineDesc().topology);
+    if (shouldBatchDraws_ && instanceCount <= 1) {
+      if (pendingDraws_.mode != mode) {
+        flushPendingDraws();
+        pendingDraws_.mode = mode;
+      }
+      pendingDraws_.indexCounts.push_back((GLsizei)indexCount);
+      pendingDraws_.indexOffsets.push_back((uint8_t*)indexBufferOffset_ + indexOffsetBytes);
+      return;
+    }
+    flushPendingDraws();
     if (instanceCount > 1) {
       adapter_->drawElementsInstanced(mode,
                                       (GLsizei)indexCount,
@@ -391,10 +445,34 @@ void RenderCommandEncoder::drawIndexed(size_t indexCount,
   }
 }
 
+void RenderCommandEncoder::flushPendingDraws() const {
+  if (pendingDraws_.indexCounts.empty()) {
+    return;
+  }
+  if (IGL_DEBUG_VERIFY(adapter_)) {
+    if (pendingDraws_.indexCounts.size() == 1) {
+      adapter_->drawElements(pendingDraws_.mode,
+                             pendingDraws_.indexCounts[0],
+                             indexType_,
+                             pendingDraws_.indexOffsets[0]);
+    } else {
+      adapter_->multiDrawElements(pendingDraws_.mode,
+                                  pendingDraws_.indexCounts.data(),
+                                  indexType_,
+                                  pendingDraws_.indexOffsets.data(),
+                                  (GLsizei)pendingDraws_.indexCounts.size());
+    }
+  }
+  pendingDraws_.mode = 0;
+  pendingDraws_.indexCounts.clear();
+  pendingDraws_.indexOffsets.clear();
+}
+
 void RenderCommandEncoder::multiDrawIndirect(IBuffer& indirectBuffer,
                                              size_t indirectBufferOffset,
                                              uint32_t drawCount,
                                              uint32_t stride) {
+  flushPendingDraws();
   if (IGL_DEBUG_VERIFY(adapter_)) {
     getCommandBuffer().incrementCurrentDrawCount();
     const auto mode = toGlPrimitive(adapter_->pipelineState().getRenderPipelineDesc().topology);
@@ -410,6 +488,7 @@ void RenderCommandEncoder::multiDrawIndexedIndirect(IBuffer& indirectBuffer,
                                                     size_t indirectBufferOffset,
                                                     uint32_t drawCount,
                                                     uint32_t stride) {
+  flushPendingDraws();
   IGL_DEBUG_ASSERT(indexType_, "No index buffer bound");
 
   // TODO: use glMultiDrawElementsIndirect() when available
@@ -427,18 +506,21 @@ void RenderCommandEncoder::multiDrawIndexedIndirect(IBuffer& indirectBuffer,
 }
 
 void RenderCommandEncoder::setStencilReferenceValue(uint32_t value) {
+  flushPendingDraws();
   if (IGL_DEBUG_VERIFY(adapter_)) {
     adapter_->setStencilReferenceValue(value);
   }
 }
 
 void RenderCommandEncoder::setBlendColor(const Color& color) {
+  flushPendingDraws();
   if (IGL_DEBUG_VERIFY(adapter_)) {
     adapter_->setBlendColor(color);
   }
 }
 
 void RenderCommandEncoder::setDepthBias(float depthBias, float slopeScale, float clamp) {
+  flushPendingDraws();
   if (IGL_DEBUG_VERIFY(adapter_)) {
     adapter_->setDepthBias(depthBias, slopeScale, clamp);
   }
@@ -449,7 +531,15 @@ void RenderCommandEncoder::bindBindGroup(BindGroupTextureHandle handle) {
     return;
   }
 
-  const BindGroupTextureDesc* desc = getContext().bindGroupTexturesPool_.get(handle);
+  const BindGroupMetadataTextures* metadata = getContext().bindGroupTexturesPool_.get(handle);
+
+  if (metadata->bindlessHandles) {
+    // Textures are already resident; only the handle buffer has to be bound
+    bindBuffer(kBindlessTexturesBlockBinding, metadata->bindlessHandles.get(), 0, 0);
+    return;
+  }
+
+  const BindGroupTextureDesc* desc = &metadata->desc;
 
   for (uint32_t i = 0; i != IGL_TEXTURE_SAMPLERS_MAX; i++) {
     if (desc->textures[i]) {
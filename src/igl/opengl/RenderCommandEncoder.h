@@ -13,6 +13,7 @@
 #include <igl/opengl/GLIncludes.h>
 #include <igl/opengl/IContext.h>
 #include <igl/opengl/UniformAdapter.h>
+#include <vector>
 
 namespace igl {
 class IDepthStencilState;
@@ -92,9 +93,23 @@ class RenderCommandEncoder final : public IRenderCommandEncoder, public WithCont
   void setDepthBias(float depthBias, float slopeScale, float clamp) override;
 
  private:
+  // Issues the batched drawIndexed() calls, if any. Must be called before any state changes.
+  void flushPendingDraws() const;
+
+  // Consecutive drawIndexed() calls without state changes in between, issued together with
+  // glMultiDrawElements when draw batching is enabled on the context
+  struct PendingDraws {
+    GLenum mode = 0;
+    std::vector<GLsizei> indexCounts;
+    std::vector<const void*> indexOffsets;
+  };
+
   std::unique_ptr<RenderCommandAdapter> adapter_;
   bool scissorEnabled_ = false;
+  bool shouldBatchDraws_ = false;
+  mutable PendingDraws pendingDraws_;
   GLenum indexType_ = 0;
+  const IBuffer* indexBuffer_ = nullptr;
   void* indexBufferOffset_ = nullptr;
   std::shared_ptr<igl::opengl::Framebuffer> resolveFramebuffer_;
   std::shared_ptr<igl::opengl::Framebuffer> framebuffer_;
@@ -106,7 +106,7 @@ Result RenderPipelineState::create() {
   if (!IGL_DEBUG_VERIFY(desc_.shaderStages->getType() == ShaderStagesType::Render)) {
     return Result(Result::Code::ArgumentInvalid, "Shader stages not for render");
   }
-  const auto* shaderStages = static_cast<ShaderStages*>(desc_.shaderStages.get());
+  auto* shaderStages = static_cast<ShaderStages*>(desc_.shaderStages.get());
   if (!shaderStages) {
     return Result(Result::Code::ArgumentInvalid,
                   "Shader stages required to create pipeline state.");
@@ -117,9 +117,47 @@ Result RenderPipelineState::create() {
     return Result(Result::Code::ArgumentInvalid, "Missing required shader module(s).");
   }
 
+  const auto& mFramebufferDesc = desc_.targetDesc;
+  if (!mFramebufferDesc.colorAttachments.empty()) {
+    const ColorWriteMask colorWriteMask = mFramebufferDesc.colorAttachments[0].colorWriteMask;
+    colorMask_[0] = static_cast<GLboolean>((colorWriteMask & ColorWriteBitsRed) != 0);
+    colorMask_[1] = static_cast<GLboolean>((colorWriteMask & ColorWriteBitsGreen) != 0);
+    colorMask_[2] = static_cast<GLboolean>((colorWriteMask & ColorWriteBitsBlue) != 0);
+    colorMask_[3] = static_cast<GLboolean>((colorWriteMask & ColorWriteBitsAlpha) != 0);
+  }
+
+  if (!mFramebufferDesc.colorAttachments.empty() &&
+      mFramebufferDesc.colorAttachments[0].blendEnabled) {
+    blendEnabled_ = true;
+    // GL equation sets blending equation for both RGB and alpha
+    blendMode_ = {convertBlendOp(mFramebufferDesc.colorAttachments[0].rgbBlendOp),
+                  convertBlendOp(mFramebufferDesc.colorAttachments[0].alphaBlendOp),
+                  convertBlendFactor(mFramebufferDesc.colorAttachments[0].srcRGBBlendFactor),
+                  convertBlendFactor(mFramebufferDesc.colorAttachments[0].dstRGBBlendFactor),
+                  convertBlendFactor(mFramebufferDesc.colorAttachments[0].srcAlphaBlendFactor),
+                  convertBlendFactor(mFramebufferDesc.colorAttachments[0].dstAlphaBlendFactor)};
+  } else {
+    blendEnabled_ = false;
+  }
+
+  if (shaderStages->isLinkStatusPending()) {
+    // everything below depends on the linked program; defer it until the program is ready
+    programStatePending_ = true;
+    return Result();
+  }
+  // a deferred link of these stages may already have failed and left no program to build on
+  auto result = shaderStages->resolveLinkStatus();
+  if (!result.isOk()) {
+    return result;
+  }
+
+  return createProgramState();
+}
+
+Result RenderPipelineState::createProgramState() const {
+  const auto* shaderStages = static_cast<ShaderStages*>(desc_.shaderStages.get());
   reflection_ = std::make_shared<RenderPipelineReflection>(getContext(), *shaderStages);
 
-  const auto& mFramebufferDesc = desc_.targetDesc;
   // Get and cache all attribute locations, since this won't change throughout
   // the lifetime of this RenderPipelineState
   const auto* vertexInputState = static_cast<VertexInputState*>(desc_.vertexInputState.get());
@@ -191,32 +229,50 @@ Result RenderPipelineState::create() {
     unitSamplerLocationMap_[realTextureUnit] = loc;
   }
 
-  if (!mFramebufferDesc.colorAttachments.empty()) {
-    const ColorWriteMask colorWriteMask = mFramebufferDesc.colorAttachments[0].colorWriteMask;
-    colorMask_[0] = static_cast<GLboolean>((colorWriteMask & ColorWriteBitsRed) != 0);
-    colorMask_[1] = static_cast<GLboolean>((colorWriteMask & ColorWriteBitsGreen) != 0);
-    colorMask_[2] = static_cast<GLboolean>((colorWriteMask & ColorWriteBitsBlue) != 0);
-    colorMask_[3] = static_cast<GLboolean>((colorWriteMask & ColorWriteBitsAlpha) != 0);
+  return Result();
+}
+
+bool RenderPipelineState::isReady() const {
+  if (!programStatePending_) {
+    return true;
+  }
+  if (!getShaderStages()->isLinkComplete()) {
+    return false;
   }
+  resolvePendingProgramState();
+  return true;
+}
 
-  if (!mFramebufferDesc.colorAttachments.empty() &&
-      mFramebufferDesc.colorAttachments[0].blendEnabled) {
-    blendEnabled_ = true;
-    // GL equation sets blending equation for both RGB and alpha
-    blendMode_ = {convertBlendOp(mFramebufferDesc.colorAttachments[0].rgbBlendOp),
-                  convertBlendOp(mFramebufferDesc.colorAttachments[0].alphaBlendOp),
-                  convertBlendFactor(mFramebufferDesc.colorAttachments[0].srcRGBBlendFactor),
-                  convertBlendFactor(mFramebufferDesc.colorAttachments[0].dstRGBBlendFactor),
-                  convertBlendFactor(mFramebufferDesc.colorAttachments[0].srcAlphaBlendFactor),
-                  convertBlendFactor(mFramebufferDesc.colorAttachments[0].dstAlphaBlendFactor)};
-  } else {
-    blendEnabled_ = false;
+Result RenderPipelineState::getStatus() const {
+  resolvePendingProgramState();
+  return status_;
+}
+
+// Program-dependent state is lazily created on first use, so this is called from const accessors
+// too. It blocks if the driver hasn't finished linking yet.
+void RenderPipelineState::resolvePendingProgramState() const {
+  if (!programStatePending_) {
+    return;
   }
+  programStatePending_ = false;
 
-  return Result();
+  auto* shaderStages = static_cast<ShaderStages*>(desc_.shaderStages.get());
+  auto result = shaderStages->resolveLinkStatus();
+  if (result.isOk()) {
+    result = createProgramState();
+  }
+  if (!result.isOk()) {
+    IGL_LOG_ERROR("Deferred render pipeline creation failed: %s\n", result.message.c_str());
+  }
+  status_ = std::move(result);
 }
 
-void RenderPipelineState::bind() {
+Result RenderPipelineState::bind() {
+  resolvePendingProgramState();
+  if (!status_.isOk()) {
+    return status_;
+  }
+
   if (desc_.shaderStages) {
     const auto* shaderStages = static_cast<ShaderStages*>(desc_.shaderStages.get());
     shaderStages->bind();
@@ -256,6 +312,7 @@ void RenderPipelineState::bind() {
     getContext().polygonFillMode((desc_.polygonFillMode == igl::PolygonFillMode::Fill) ? GL_FILL
                                                                                        : GL_LINE);
   }
+  return Result();
 }
 
 void RenderPipelineState::unbind() {
@@ -363,6 +420,7 @@ Result RenderPipelineState::bindTextureUnit(const size_t unit, uint8_t bindTarge
   }
 
   getContext().uniform1i(samplerLocation, static_cast<GLint>(unit));
+  getShaderStages()->getUniformBindPlan().invalidate(samplerLocation);
   getContext().activeTexture(static_cast<GLenum>(GL_TEXTURE0 + unit));
 
   return Result();
@@ -378,6 +436,7 @@ bool RenderPipelineState::matchesVertexInputState(const RenderPipelineState& rhs
 }
 
 int RenderPipelineState::getIndexByName(const NameHandle& name, ShaderStage /*stage*/) const {
+  resolvePendingProgramState();
   if (reflection_ == nullptr) {
     return -1;
   }
@@ -385,6 +444,7 @@ int RenderPipelineState::getIndexByName(const NameHandle& name, ShaderStage /*st
 }
 
 int RenderPipelineState::getIndexByName(const std::string& name, ShaderStage /*stage*/) const {
+  resolvePendingProgramState();
   if (reflection_ == nullptr) {
     return -1;
   }
@@ -396,6 +456,7 @@ int RenderPipelineState::getUniformBlockBindingPoint(const NameHandle& uniformBl
 }
 
 std::shared_ptr<IRenderPipelineReflection> RenderPipelineState::renderPipelineReflection() {
+  resolvePendingProgramState();
   return reflection_;
 }
 
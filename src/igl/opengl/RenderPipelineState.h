@@ -30,6 +30,8 @@ class RenderPipelineState final : public WithContext, public IRenderPipelineStat
   friend class Device;
 
   Result create();
+  Result createProgramState() const;
+  void resolvePendingProgramState() const;
 
  public:
   explicit RenderPipelineState(IContext& context,
@@ -37,7 +39,11 @@ class RenderPipelineState final : public WithContext, public IRenderPipelineStat
                                Result* outResult);
   ~RenderPipelineState() override;
 
-  void bind();
+  [[nodiscard]] bool isReady() const override;
+  [[nodiscard]] Result getStatus() const override;
+
+  // Fails without binding anything if the pipeline's status is not Ok
+  Result bind();
   void unbind();
   Result bindTextureUnit(size_t unit, uint8_t bindTarget);
 
@@ -82,19 +88,27 @@ class RenderPipelineState final : public WithContext, public IRenderPipelineStat
   void unbindPrevPipelineVertexAttributes();
 
  private:
+  // The state up to uniformBlockBindingMap_ depends on the linked program. It is mutable because
+  // with deferred status checks it is created lazily, from const accessors such as isReady().
+
   // Tracks a list of attribute locations associated with a bufferIndex
-  std::vector<int> bufferAttribLocations_[IGL_VERTEX_BUFFER_MAX];
+  mutable std::vector<int> bufferAttribLocations_[IGL_VERTEX_BUFFER_MAX];
 
-  std::shared_ptr<RenderPipelineReflection> reflection_;
-  std::unordered_map<size_t, size_t> vertexTextureUnitRemap;
-  std::array<GLint, IGL_TEXTURE_SAMPLERS_MAX> unitSamplerLocationMap_{};
-  std::unordered_map<int, size_t> uniformBlockBindingMap_;
+  mutable std::shared_ptr<RenderPipelineReflection> reflection_;
+  mutable std::unordered_map<size_t, size_t> vertexTextureUnitRemap;
+  mutable std::array<GLint, IGL_TEXTURE_SAMPLERS_MAX> unitSamplerLocationMap_{};
+  mutable std::unordered_map<int, size_t> uniformBlockBindingMap_;
   std::array<GLboolean, 4> colorMask_ = {GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE};
   std::vector<int> prevPipelineStateAttributesLocations_;
   std::vector<int> activeAttributesLocations_;
   BlendMode blendMode_ = {GL_FUNC_ADD, GL_FUNC_ADD, GL_ONE, GL_ZERO, GL_ONE, GL_ZERO};
   bool blendEnabled_ = false;
   bool uniformBlockBindingPointSet_ = false;
+  // The program was linked with deferred status checks and the state above that depends on it
+  // (reflection, attribute and sampler locations, uniform block bindings) is not created yet
+  mutable bool programStatePending_ = false;
+  // Result of the deferred link and program state creation, see getStatus()
+  mutable Result status_;
 };
 
 } // namespace igl::opengl
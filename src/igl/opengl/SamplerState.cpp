@@ -37,6 +37,31 @@ SamplerState::SamplerState(IContext& context, const SamplerStateDesc& desc) :
   hash_ = h(desc);
 }
 
+SamplerState::~SamplerState() {
+  if (samplerId_ != 0) {
+    getContext().deleteSamplers(1, &samplerId_);
+  }
+}
+
+GLuint SamplerState::getSamplerId() const {
+  if (samplerId_ == 0) {
+    auto& context = getContext();
+    context.genSamplers(1, &samplerId_);
+    context.samplerParameteri(samplerId_, GL_TEXTURE_MIN_FILTER, minMipFilter_);
+    context.samplerParameteri(samplerId_, GL_TEXTURE_MAG_FILTER, magFilter_);
+    context.samplerParameterf(samplerId_, GL_TEXTURE_MIN_LOD, mipLodMin_);
+    context.samplerParameterf(samplerId_, GL_TEXTURE_MAX_LOD, mipLodMax_);
+    context.samplerParameteri(samplerId_, GL_TEXTURE_WRAP_S, addressU_);
+    context.samplerParameteri(samplerId_, GL_TEXTURE_WRAP_T, addressV_);
+    context.samplerParameteri(samplerId_, GL_TEXTURE_WRAP_R, addressW_);
+    context.samplerParameteri(samplerId_,
+                              GL_TEXTURE_COMPARE_MODE,
+                              depthCompareEnabled_ ? GL_COMPARE_REF_TO_TEXTURE : GL_NONE);
+    context.samplerParameteri(samplerId_, GL_TEXTURE_COMPARE_FUNC, depthCompareFunction_);
+  }
+  return samplerId_;
+}
+
 void SamplerState::bind(ITexture* t) {
   if (IGL_DEBUG_VERIFY_NOT(t == nullptr)) {
     return;
@@ -46,6 +71,14 @@ void SamplerState::bind(ITexture* t) {
   if (texture->getSamplerHash() == hash_) {
     return;
   }
+  if (texture->hasBindlessHandles()) {
+    // GL_ARB_bindless_texture makes the parameters of a texture immutable once it has a handle, and
+    // texParameteri would raise GL_INVALID_OPERATION
+    IGL_LOG_INFO_ONCE(
+        "Textures with bindless handles keep the sampler state they had when the first handle was "
+        "created when bound to a texture unit.\n");
+    return;
+  }
   texture->setSamplerHash(hash_);
 
   auto type = texture->getType();
@@ -16,8 +16,13 @@ namespace igl::opengl {
 class SamplerState final : public WithContext, public ISamplerState {
  public:
   SamplerState(IContext& context, const SamplerStateDesc& desc);
+  ~SamplerState() override;
   void bind(ITexture* texture);
 
+  // Returns a GL sampler object with this state, created on first use. Only used for bindless
+  // texture handles; regular binding applies the state to each texture instead.
+  [[nodiscard]] GLuint getSamplerId() const;
+
   static GLint convertMinMipFilter(SamplerMinMagFilter minFilter, SamplerMipFilter mipFilter);
   static GLint convertMagFilter(SamplerMinMagFilter magFilter);
   static GLint convertAddressMode(SamplerAddressMode addressMode);
@@ -46,6 +51,7 @@ class SamplerState final : public WithContext, public ISamplerState {
   GLint depthCompareFunction_;
   bool depthCompareEnabled_;
   bool isYUV_;
+  mutable GLuint samplerId_ = 0;
 };
 
 } // namespace igl::opengl
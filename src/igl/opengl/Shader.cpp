@@ -74,20 +74,26 @@ void ShaderStages::createRenderProgram(Result* result) {
   getContext().detachShader(programID, vertexShaderID);
   getContext().detachShader(programID, fragmentShaderID);
 
+  if (getContext().shouldDeferShaderStatusChecks()) {
+    // the driver may still be compiling and linking in the background; GL_LINK_STATUS is queried
+    // later by resolveLinkStatus() so that creating many programs doesn't serialize on the driver
+    if (programID_ != 0) {
+      getContext().deleteProgram(programID_);
+    }
+    programID_ = programID;
+    uniformBindPlan_.clear();
+    linkStatusPending_ = true;
+    linkResult_ = Result();
+
+    Result::setResult(result, Result::Code::Ok);
+    return;
+  }
+
   // check to see if the linking succeeded
   GLint status = 0;
   getContext().getProgramiv(programID, GL_LINK_STATUS, &status);
   if (status == GL_FALSE) {
-    // Get the size of log
-    GLsizei logSize = 0;
-    getContext().getProgramiv(programID, GL_INFO_LOG_LENGTH, &logSize);
-
-    // Pre-allocate vector for storage
-    std::vector<GLchar> log(logSize);
-    getContext().getProgramInfoLog(programID, logSize, nullptr, log.data());
-
-    // Create actual string from it
-    const std::string errorLog(log.begin(), log.end());
+    const std::string errorLog = getLinkErrorLog(programID);
     IGL_LOG_ERROR("failed to link shaders:\n%s\n", errorLog.c_str());
 
     getContext().deleteProgram(programID);
@@ -100,6 +106,10 @@ void ShaderStages::createRenderProgram(Result* result) {
     getContext().deleteProgram(programID_);
   }
   programID_ = programID;
+  // A new program starts with default uniform values
+  uniformBindPlan_.clear();
+  linkStatusPending_ = false;
+  linkResult_ = Result();
 
   Result::setResult(result, Result::Code::Ok);
 }
@@ -141,7 +151,7 @@ void ShaderStages::createComputeProgram(Result* result) {
   GLint status = 0;
   getContext().getProgramiv(programID, GL_LINK_STATUS, &status);
   if (status == GL_FALSE) {
-    const std::string errorLog = getProgramInfoLog(programID);
+    const std::string errorLog = getLinkErrorLog(programID);
     IGL_LOG_ERROR("failed to link compute shaders:\n%s\n", errorLog.c_str());
 
     getContext().deleteProgram(programID);
@@ -154,6 +164,8 @@ void ShaderStages::createComputeProgram(Result* result) {
     getContext().deleteProgram(programID_);
   }
   programID_ = programID;
+  // A new program starts with default uniform values
+  uniformBindPlan_.clear();
 
   Result::setResult(result, Result::Code::Ok);
 }
@@ -172,6 +184,36 @@ Result ShaderStages::create(const ShaderStagesDesc& /*desc*/) {
   return result;
 }
 
+bool ShaderStages::isLinkComplete() const {
+  if (!linkStatusPending_) {
+    return true;
+  }
+
+  GLint completed = GL_FALSE;
+  getContext().getProgramiv(programID_, GL_COMPLETION_STATUS_KHR, &completed);
+  return completed == GL_TRUE;
+}
+
+Result ShaderStages::resolveLinkStatus() {
+  if (!linkStatusPending_) {
+    return linkResult_;
+  }
+
+  GLint status = 0;
+  getContext().getProgramiv(programID_, GL_LINK_STATUS, &status);
+  linkStatusPending_ = false;
+  if (status == GL_FALSE) {
+    std::string errorLog = getLinkErrorLog(programID_);
+    IGL_LOG_ERROR("failed to link shaders:\n%s\n", errorLog.c_str());
+
+    getContext().deleteProgram(programID_);
+    programID_ = 0;
+    linkResult_ = Result(Result::Code::RuntimeError, std::move(errorLog));
+  }
+
+  return linkResult_;
+}
+
 Result ShaderStages::validate() const {
   getContext().validateProgram(programID_);
   GLint status = 0;
@@ -287,19 +329,13 @@ Result ShaderModule::create(const ShaderModuleDesc& desc) {
   getContext().compileShader(shaderID);
 
   // see if the compilation succeeded
-  GLint status = 0;
-  getContext().getShaderiv(shaderID, GL_COMPILE_STATUS, &status);
+  // with deferred status checks, compile errors are reported when the program is linked
+  GLint status = GL_TRUE;
+  if (!getContext().shouldDeferShaderStatusChecks()) {
+    getContext().getShaderiv(shaderID, GL_COMPILE_STATUS, &status);
+  }
   if (status == GL_FALSE) {
-    // Get the size of log
-    GLsizei logSize = 0;
-    getContext().getShaderiv(shaderID, GL_INFO_LOG_LENGTH, &logSize);
-
-    // Pre-allocate vector for storage
-    std::vector<GLchar> log(logSize);
-    getContext().getShaderInfoLog(shaderID, logSize, nullptr, log.data());
-
-    // Create actual string from it
-    const std::string errorLog(log.begin(), log.end());
+    const std::string errorLog = getShaderInfoLog(shaderID);
     IGL_LOG_ERROR("failed to compile %s shader:\n%s\nSource\n%s",
                   (shaderType_ == GL_VERTEX_SHADER ? "vertex" : "fragment"),
                   errorLog.c_str(),
@@ -324,6 +360,29 @@ Result ShaderModule::create(const ShaderModuleDesc& desc) {
   return Result();
 }
 
+Result ShaderModule::getCompileStatus() const {
+  GLint status = 0;
+  getContext().getShaderiv(shaderID_, GL_COMPILE_STATUS, &status);
+  if (status == GL_FALSE) {
+    return Result(Result::Code::ArgumentInvalid, getShaderInfoLog(shaderID_));
+  }
+
+  return Result{};
+}
+
+std::string ShaderModule::getShaderInfoLog(GLuint shaderID) const {
+  // Get the size of log
+  GLsizei logSize = 0;
+  getContext().getShaderiv(shaderID, GL_INFO_LOG_LENGTH, &logSize);
+
+  // Pre-allocate vector for storage
+  std::vector<GLchar> log(logSize);
+  getContext().getShaderInfoLog(shaderID, logSize, nullptr, log.data());
+
+  // Create actual string from it
+  return {log.begin(), log.end()};
+}
+
 std::string ShaderStages::getProgramInfoLog(GLuint programID) const {
   // Get the size of log
   GLsizei logSize = 0;
@@ -337,4 +396,22 @@ std::string ShaderStages::getProgramInfoLog(GLuint programID) const {
   return {log.begin(), log.end()};
 }
 
+// The program info log usually doesn't explain why a stage whose compile status was never checked
+// failed, so the compile logs of failed stages are appended to it.
+std::string ShaderStages::getLinkErrorLog(GLuint programID) const {
+  std::string errorLog = getProgramInfoLog(programID);
+
+  for (const auto& module : {getVertexModule(), getFragmentModule(), getComputeModule()}) {
+    if (!module) {
+      continue;
+    }
+    const auto compileResult = static_cast<const ShaderModule&>(*module).getCompileStatus();
+    if (!compileResult.isOk()) {
+      errorLog += "\n" + compileResult.message;
+    }
+  }
+
+  return errorLog;
+}
+
 } // namespace igl::opengl
@@ -14,6 +14,7 @@
 #include <igl/Shader.h>
 #include <igl/opengl/GLIncludes.h>
 #include <igl/opengl/IContext.h>
+#include <igl/opengl/UniformBindPlan.h>
 #include <unordered_map>
 
 namespace igl {
@@ -39,9 +40,14 @@ class ShaderModule : public WithContext, public IShaderModule {
     return hash_;
   }
 
+  // Queries GL_COMPILE_STATUS, blocking until a deferred compilation has finished
+  [[nodiscard]] Result getCompileStatus() const;
+
   ShaderModule(IContext& context, ShaderModuleInfo info);
 
  private:
+  [[nodiscard]] std::string getShaderInfoLog(GLuint shaderID) const;
+
   // Type of shader (vertex, fragment, compute)
   GLenum shaderType_ = 0;
 
@@ -69,13 +75,38 @@ class ShaderStages final : public IShaderStages, public WithContext {
     return programID_;
   }
 
+  // True when the program was linked with a deferred GL_LINK_STATUS check
+  [[nodiscard]] bool isLinkStatusPending() const {
+    return linkStatusPending_;
+  }
+
+  // Non-blocking check whether a deferred link has finished (GL_COMPLETION_STATUS_KHR)
+  [[nodiscard]] bool isLinkComplete() const;
+
+  // Queries GL_LINK_STATUS for a deferred link, blocking until it has finished. On failure the
+  // program is deleted, getProgramID() returns 0 and every later call returns the same failure.
+  Result resolveLinkStatus();
+
+  // Shadow of the values uploaded with glUniform* to this program
+  [[nodiscard]] UniformBindPlan& getUniformBindPlan() const {
+    return uniformBindPlan_;
+  }
+
  private:
   void createRenderProgram(Result* result);
   void createComputeProgram(Result* result);
   std::string getProgramInfoLog(GLuint programID) const;
+  std::string getLinkErrorLog(GLuint programID) const;
 
   // the GL shader program ID
   GLuint programID_ = 0;
+
+  // GL_LINK_STATUS has not been queried yet for programID_
+  bool linkStatusPending_ = false;
+  // Outcome of the deferred GL_LINK_STATUS query, returned to every pipeline created afterwards
+  Result linkResult_;
+
+  mutable UniformBindPlan uniformBindPlan_;
 };
 
 } // namespace opengl
@@ -52,6 +52,17 @@ uint64_t Texture::getTextureId() const {
   return 0;
 }
 
+bool Texture::hasBindlessHandles() const {
+  return false;
+}
+
+uint64_t Texture::getTextureSamplerHandle(
+    const std::shared_ptr<ISamplerState>& /*samplerState*/) const {
+  // this requires ARB_bindless_texture
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+  return 0;
+}
+
 bool Texture::isSwapchainTexture() const {
   return isImplicitStorage();
 }
@@ -36,6 +36,13 @@ class Texture : public WithContext, public ITexture {
   [[nodiscard]] bool isRequiredGenerateMipmap() const override;
   [[nodiscard]] uint64_t getTextureId() const override;
   [[nodiscard]] bool isSwapchainTexture() const override;
+  // Resident bindless handle combining this texture with the state of samplerState. Requires
+  // ARB_bindless_texture; the handle stays resident for the lifetime of the texture.
+  [[nodiscard]] virtual uint64_t getTextureSamplerHandle(
+      const std::shared_ptr<ISamplerState>& samplerState) const;
+  // Whether a bindless handle was created for this texture. GL then rejects any change to its
+  // sampling parameters, so they keep the values they had when the first handle was created.
+  [[nodiscard]] virtual bool hasBindlessHandles() const;
 
   virtual Result create(const TextureDesc& desc, bool hasStorageAlready);
 
@@ -9,6 +9,7 @@
 
 #include <array>
 #include <igl/opengl/Errors.h>
+#include <igl/opengl/SamplerState.h>
 #include <utility>
 
 namespace igl::opengl {
@@ -46,6 +47,9 @@ TextureBuffer::~TextureBuffer() {
     if (textureHandle_ != 0) {
       getContext().makeTextureHandleNonResident(textureHandle_);
     }
+    for (const auto& samplerHandle : samplerHandles_) {
+      getContext().makeTextureHandleNonResident(samplerHandle.handle);
+    }
     getContext().deleteTextures({textureID});
   }
 }
@@ -59,6 +63,28 @@ uint64_t TextureBuffer::getTextureId() const {
   return textureHandle_;
 }
 
+bool TextureBuffer::hasBindlessHandles() const {
+  return textureHandle_ != 0 || !samplerHandles_.empty();
+}
+
+uint64_t TextureBuffer::getTextureSamplerHandle(
+    const std::shared_ptr<ISamplerState>& samplerState) const {
+  if (!samplerState) {
+    return getTextureId();
+  }
+  for (const auto& samplerHandle : samplerHandles_) {
+    if (samplerHandle.samplerState == samplerState) {
+      return samplerHandle.handle;
+    }
+  }
+  const GLuint samplerId = static_cast<const SamplerState&>(*samplerState).getSamplerId();
+  const uint64_t handle = getContext().getTextureSamplerHandle(getId(), samplerId);
+  IGL_DEBUG_ASSERT(handle);
+  getContext().makeTextureHandleResident(handle);
+  samplerHandles_.push_back({samplerState, handle});
+  return handle;
+}
+
 // create a 2D texture given the specified dimensions and format
 Result TextureBuffer::create(const TextureDesc& desc, bool hasStorageAlready) {
   Result result = Super::create(desc, hasStorageAlready);
@@ -143,6 +169,7 @@ Result TextureBuffer::initialize(const std::string& debugName) const {
   if (target == 0) {
     return Result{Result::Code::InvalidOperation, "Unknown texture type"};
   }
+  getContext().flushPendingDraws();
   getContext().bindTexture(target, getId());
   setMaxMipLevel();
   if (getNumMipLevels() == 1) { // Change default min filter to ensure mipmapping is disabled
@@ -432,6 +459,7 @@ Result TextureBuffer::uploadInternal(TextureType /*type*/,
   if (target == 0) {
     return Result{Result::Code::InvalidOperation, "Unknown texture type"};
   }
+  getContext().flushPendingDraws();
   getContext().bindTexture(target, getId());
 
   auto result = uploadInternal(target, range, data, bytesPerRow);
@@ -444,6 +472,8 @@ Result TextureBuffer::uploadInternal(GLenum target,
                                      const TextureRangeDesc& range,
                                      const void* IGL_NULLABLE data,
                                      size_t bytesPerRow) const {
+  getContext().flushPendingDraws();
+
   // Use TexImage when range covers full texture AND texture was not initialized with TexStorage
   const auto texImage = isValidForTexImage(range) && !supportsTexStorage();
 
@@ -8,6 +8,8 @@
 #pragma once
 
 #include <igl/opengl/TextureBufferBase.h>
+#include <memory>
+#include <vector>
 
 namespace igl::opengl {
 
@@ -23,6 +25,9 @@ class TextureBuffer : public TextureBufferBase {
   Result create(const TextureDesc& desc, bool hasStorageAlready) override;
   void bindImage(size_t unit) override;
   uint64_t getTextureId() const override;
+  bool hasBindlessHandles() const override;
+  uint64_t getTextureSamplerHandle(
+      const std::shared_ptr<ISamplerState>& samplerState) const override;
 
  protected:
   Result initialize(const std::string& debugName) const;
@@ -59,6 +64,13 @@ class TextureBuffer : public TextureBufferBase {
   bool canInitialize() const;
   bool supportsTexStorage() const;
   mutable uint64_t textureHandle_ = 0;
+  // Handles created by getTextureSamplerHandle(). Each entry keeps its sampler alive so the GL
+  // sampler object, and therefore the handle, stays valid.
+  struct SamplerHandle {
+    std::shared_ptr<ISamplerState> samplerState;
+    uint64_t handle = 0;
+  };
+  mutable std::vector<SamplerHandle> samplerHandles_;
 };
 
 } // namespace igl::opengl
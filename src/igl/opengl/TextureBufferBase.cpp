@@ -145,6 +145,10 @@ void TextureBufferBase::detachAsStencil(bool read) {
 }
 
 void TextureBufferBase::setMaxMipLevel() const {
+  // Set when the texture was initialized, before any bindless handle made it immutable
+  if (hasBindlessHandles()) {
+    return;
+  }
   if (getContext().deviceFeatures().hasFeature(DeviceFeatures::TexturePartialMipChain)) {
     getContext().texParameteri(getTarget(), GL_TEXTURE_MAX_LEVEL, (GLint)(numMipLevels_ - 1));
   }
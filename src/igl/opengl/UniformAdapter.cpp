@@ -7,6 +7,7 @@
 
 #include <igl/opengl/Buffer.h>
 #include <igl/opengl/UniformAdapter.h>
+#include <igl/opengl/UniformBindPlan.h>
 #include <igl/opengl/UniformBuffer.h>
 
 namespace igl::opengl {
@@ -52,6 +53,7 @@ void UniformAdapter::clearUniformBuffers() {
   usedUniformDataBytes_ = 0;
   uniforms_.clear();
   uniformBuffersDirtyMask_ = 0;
+  uniformBuffersSetMask_ = 0;
 
 #if IGL_DEBUG
   std::fill(uniformsDirty_.begin(), uniformsDirty_.end(), false);
@@ -124,7 +126,7 @@ void UniformAdapter::setUniform(const UniformDesc& uniformDesc,
 #endif // IGL_DEBUG
 
   IGL_DEBUG_ASSERT(uniforms_.size() < maxUniforms_);
-  uniforms_.emplace_back(uniformDesc, dataOffset);
+  uniforms_.emplace_back(uniformDesc, dataOffset, static_cast<size_t>(length));
   Result::setOk(outResult);
 }
 
@@ -141,20 +143,35 @@ void UniformAdapter::setUniformBuffer(IBuffer* buffer,
   if (bindingIndex < IGL_UNIFORM_BLOCKS_BINDING_MAX && buffer) {
     uniformBufferBindingMap_[bindingIndex] = {buffer, offset, size};
     uniformBuffersDirtyMask_ |= 1 << bindingIndex;
+    uniformBuffersSetMask_ |= 1 << bindingIndex;
     Result::setOk(outResult);
   } else {
     Result::setResult(outResult, Result::Code::ArgumentInvalid);
   }
 }
 
-void UniformAdapter::bindToPipeline(IContext& context) {
+bool UniformAdapter::isUniformBufferBound(const IBuffer* buffer,
+                                          size_t offset,
+                                          size_t size,
+                                          uint32_t bindingIndex) const {
+  if (bindingIndex >= IGL_UNIFORM_BLOCKS_BINDING_MAX ||
+      (uniformBuffersSetMask_ & (1 << bindingIndex)) == 0) {
+    return false;
+  }
+  const auto& binding = uniformBufferBindingMap_.at(static_cast<int>(bindingIndex));
+  return binding.buffer == buffer && binding.offset == offset && binding.size == size;
+}
+
+void UniformAdapter::bindToPipeline(IContext& context, UniformBindPlan* bindPlan) {
   // bind uniforms
   for (const auto& uniform : uniforms_) {
     const auto& uniformDesc = uniform.desc;
     IGL_DEBUG_ASSERT(uniformDesc.location >= 0);
     IGL_DEBUG_ASSERT(uniformData_.data(), "Uniform data must be non-null");
     auto* start = uniformData_.data() + uniform.dataOffset;
-    if (uniformDesc.numElements > 1 || uniformDesc.type == UniformType::Mat3x3) {
+    if (bindPlan) {
+      bindPlan->bind(context, uniformDesc, start, uniform.length);
+    } else if (uniformDesc.numElements > 1 || uniformDesc.type == UniformType::Mat3x3) {
       IGL_DEBUG_ASSERT(uniformDesc.elementStride > 0,
                        "stride has to be larger than 0 for uniform at offset %zu",
                        uniformDesc.offset);
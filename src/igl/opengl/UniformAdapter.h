@@ -16,6 +16,7 @@
 
 namespace igl::opengl {
 class IContext;
+class UniformBindPlan;
 
 class UniformAdapter {
  public:
@@ -34,20 +35,29 @@ class UniformAdapter {
                         size_t size,
                         uint32_t index,
                         Result* outResult);
+  // Reports whether the given range is already set on bindingIndex since the last clear
+  [[nodiscard]] bool isUniformBufferBound(const IBuffer* buffer,
+                                          size_t offset,
+                                          size_t size,
+                                          uint32_t bindingIndex) const;
 
   [[nodiscard]] uint32_t getMaxUniforms() const {
     return maxUniforms_;
   }
 
-  void bindToPipeline(IContext& context);
+  // Uploads the uniforms set since the last call. When bindPlan is provided, uniforms whose value
+  // hasn't changed since they were last uploaded to the current program are skipped.
+  void bindToPipeline(IContext& context, UniformBindPlan* bindPlan);
 
  private:
   struct UniformState {
     UniformState() = default;
-    UniformState(UniformDesc d, std::ptrdiff_t o) : desc(std::move(d)), dataOffset(o) {}
+    UniformState(UniformDesc d, std::ptrdiff_t o, size_t l) :
+      desc(std::move(d)), dataOffset(o), length(l) {}
 
     UniformDesc desc;
     std::ptrdiff_t dataOffset = 0;
+    size_t length = 0;
   };
 
   std::vector<UniformState> uniforms_;
@@ -64,6 +74,8 @@ class UniformAdapter {
   // map for uniform binding indices to the buffers
   std::unordered_map<int, UniformBufferRange> uniformBufferBindingMap_;
   uint32_t uniformBuffersDirtyMask_ = 0;
+  // Binding indices set through setUniformBuffer() since the last clearUniformBuffers()
+  uint32_t uniformBuffersSetMask_ = 0;
   static_assert(sizeof(uniformBuffersDirtyMask_) * 8 >= IGL_UNIFORM_BLOCKS_BINDING_MAX,
                 "uniformBuffersDirtyMask size is not enough to fit the flags");
 
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/UniformBindPlan.h>
+
+#include <cstring>
+#include <igl/opengl/IContext.h>
+#include <igl/opengl/UniformBuffer.h>
+
+namespace igl::opengl {
+
+namespace {
+
+GLsizei elementCount(size_t numElements) {
+  return static_cast<GLsizei>(numElements);
+}
+
+} // namespace
+
+UniformBindPlan::Setter UniformBindPlan::selectSetter(const UniformDesc& desc) {
+  const bool isArray = desc.numElements > 1 || desc.type == UniformType::Mat3x3;
+  if (isArray && desc.elementStride != igl::sizeForUniformType(desc.type)) {
+    // Elements need repacking before they can be uploaded
+    return [](IContext& context, const Entry& entry, const uint8_t* data) {
+      UniformBuffer::bindUniformArray(
+          context, entry.location, entry.type, data, entry.numElements, entry.elementStride);
+    };
+  }
+
+  switch (desc.type) {
+  case UniformType::Float:
+    return [](IContext& context, const Entry& entry, const uint8_t* data) {
+      context.uniform1fv(
+          entry.location, elementCount(entry.numElements), reinterpret_cast<const GLfloat*>(data));
+    };
+  case UniformType::Float2:
+    return [](IContext& context, const Entry& entry, const uint8_t* data) {
+      context.uniform2fv(
+          entry.location, elementCount(entry.numElements), reinterpret_cast<const GLfloat*>(data));
+    };
+  case UniformType::Float3:
+    return [](IContext& context, const Entry& entry, const uint8_t* data) {
+      context.uniform3fv(
+          entry.location, elementCount(entry.numElements), reinterpret_cast<const GLfloat*>(data));
+    };
+  case UniformType::Float4:
+    return [](IContext& context, const Entry& entry, const uint8_t* data) {
+      context.uniform4fv(
+          entry.location, elementCount(entry.numElements), reinterpret_cast<const GLfloat*>(data));
+    };
+  case UniformType::Int:
+    return [](IContext& context, const Entry& entry, const uint8_t* data) {
+      context.uniform1iv(
+          entry.location, elementCount(entry.numElements), reinterpret_cast<const GLint*>(data));
+    };
+  case UniformType::Int2:
+    return [](IContext& context, const Entry& entry, const uint8_t* data) {
+      context.uniform2iv(
+          entry.location, elementCount(entry.numElements), reinterpret_cast<const GLint*>(data));
+    };
+  case UniformType::Int3:
+    return [](IContext& context, const Entry& entry, const uint8_t* data) {
+      context.uniform3iv(
+          entry.location, elementCount(entry.numElements), reinterpret_cast<const GLint*>(data));
+    };
+  case UniformType::Int4:
+    return [](IContext& context, const Entry& entry, const uint8_t* data) {
+      context.uniform4iv(
+          entry.location, elementCount(entry.numElements), reinterpret_cast<const GLint*>(data));
+    };
+  case UniformType::Mat2x2:
+    return [](IContext& context, const Entry& entry, const uint8_t* data) {
+      context.uniformMatrix2fv(entry.location,
+                               elementCount(entry.numElements),
+                               0u,
+                               reinterpret_cast<const GLfloat*>(data));
+    };
+  case UniformType::Mat3x3:
+    return [](IContext& context, const Entry& entry, const uint8_t* data) {
+      context.uniformMatrix3fv(entry.location,
+                               elementCount(entry.numElements),
+                               0u,
+                               reinterpret_cast<const GLfloat*>(data));
+    };
+  case UniformType::Mat4x4:
+    return [](IContext& context, const Entry& entry, const uint8_t* data) {
+      context.uniformMatrix4fv(entry.location,
+                               elementCount(entry.numElements),
+                               0u,
+                               reinterpret_cast<const GLfloat*>(data));
+    };
+  case UniformType::Boolean:
+    // Booleans are packed bytes and have to be expanded to GLint
+    return [](IContext& context, const Entry& entry, const uint8_t* data) {
+      UniformBuffer::bindUniform(context, entry.location, entry.type, data, entry.numElements);
+    };
+  case UniformType::Invalid:
+    break;
+  }
+  IGL_DEBUG_ABORT("Invalid Uniform Type");
+  return nullptr;
+}
+
+void UniformBindPlan::bind(IContext& context,
+                           const UniformDesc& desc,
+                           const uint8_t* data,
+                           size_t length) {
+  const GLint location = desc.location;
+  if (!IGL_DEBUG_VERIFY(location >= 0)) {
+    return;
+  }
+  if (static_cast<size_t>(location) >= entries_.size()) {
+    entries_.resize(location + 1);
+  }
+
+  auto& entry = entries_[location];
+  const bool isArray = desc.numElements > 1 || desc.type == UniformType::Mat3x3;
+  const size_t numElements = isArray ? desc.numElements : 1;
+  if (entry.setter == nullptr || entry.type != desc.type || entry.numElements != numElements ||
+      entry.elementStride != desc.elementStride || entry.length != length) {
+    // The layout at this location changed; rebuild the entry
+    entry.setter = selectSetter(desc);
+    if (entry.setter == nullptr) {
+      return;
+    }
+    entry.location = location;
+    entry.type = desc.type;
+    entry.numElements = numElements;
+    entry.elementStride = desc.elementStride;
+    if (length > entry.length) {
+      entry.valueOffset = values_.size();
+      values_.resize(values_.size() + length);
+    }
+    entry.length = length;
+    entry.hasValue = false;
+  }
+
+  uint8_t* shadow = values_.data() + entry.valueOffset;
+  if (entry.hasValue && std::memcmp(shadow, data, length) == 0) {
+    return;
+  }
+
+  entry.setter(context, entry, data);
+  std::memcpy(shadow, data, length);
+  entry.hasValue = true;
+}
+
+void UniformBindPlan::invalidate(GLint location) {
+  if (location >= 0 && static_cast<size_t>(location) < entries_.size()) {
+    entries_[location].hasValue = false;
+  }
+}
+
+void UniformBindPlan::clear() {
+  entries_.clear();
+  values_.clear();
+}
+
+} // namespace igl::opengl
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/Uniform.h>
+#include <igl/opengl/GLIncludes.h>
+#include <vector>
+
+namespace igl::opengl {
+class IContext;
+
+/// Per-program bind plan for the non-UBO uniform path.
+///
+/// GL keeps uniform values per program, so values uploaded with glUniform* survive across draws and
+/// program switches. The plan shadows the last value uploaded at every location it has seen and
+/// skips uploads of unchanged values. Each location also caches the setter selected for its type
+/// and layout, so changed uniforms are uploaded without dispatching on UniformType again.
+class UniformBindPlan final {
+ public:
+  /// Uploads `length` bytes at `data` described by `desc` unless they match the value last
+  /// uploaded at desc.location. The program owning the plan must be current.
+  void bind(IContext& context, const UniformDesc& desc, const uint8_t* data, size_t length);
+
+  /// Forgets the shadowed value at `location`. Must be called when the uniform is set outside of
+  /// the plan.
+  void invalidate(GLint location);
+
+  /// Forgets all shadowed values. Must be called when the owning program is relinked.
+  void clear();
+
+ private:
+  struct Entry;
+  using Setter = void (*)(IContext& context, const Entry& entry, const uint8_t* data);
+
+  struct Entry {
+    Setter setter = nullptr;
+    GLint location = -1;
+    UniformType type = UniformType::Invalid;
+    size_t numElements = 0;
+    size_t elementStride = 0;
+    size_t length = 0;
+    // Offset of the shadowed value in values_
+    size_t valueOffset = 0;
+    bool hasValue = false;
+  };
+
+  static Setter selectSetter(const UniformDesc& desc);
+
+  // Indexed by uniform location
+  std::vector<Entry> entries_;
+  std::vector<uint8_t> values_;
+};
+
+} // namespace igl::opengl
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <igl/Profiler.h>
+#include <string>
+#include <thread>
+
+namespace igl::tests {
+
+namespace {
+
+size_t countOccurrences(const std::string& str, const std::string& pattern) {
+  size_t count = 0;
+  for (size_t pos = str.find(pattern); pos != std::string::npos;
+       pos = str.find(pattern, pos + pattern.size())) {
+    ++count;
+  }
+  return count;
+}
+
+} // namespace
+
+class ProfilerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    profiler::reset();
+    profiler::setEnabled(true);
+  }
+  void TearDown() override {
+    profiler::setEnabled(false);
+    profiler::reset();
+  }
+};
+
+TEST_F(ProfilerTest, InternName) {
+  const profiler::ZoneId a = profiler::internName("ProfilerTest::a");
+  const profiler::ZoneId b = profiler::internName("ProfilerTest::b");
+  EXPECT_NE(a, b);
+  EXPECT_EQ(a, profiler::internName(std::string("ProfilerTest::a").c_str()));
+}
+
+TEST_F(ProfilerTest, RecordsNestedZones) {
+  const profiler::ZoneId outer = profiler::internName("ProfilerTest::outer");
+  const profiler::ZoneId inner = profiler::internName("ProfilerTest::inner");
+  {
+    const profiler::ScopedZone outerZone(outer);
+    const profiler::ScopedZone innerZone(inner);
+  }
+  profiler::markFrame(profiler::internFrameName(nullptr));
+
+  const std::string json = profiler::toChromeTrace();
+  EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+  EXPECT_EQ(countOccurrences(json, "\"ph\":\"B\""), 2u);
+  EXPECT_EQ(countOccurrences(json, "\"ph\":\"E\""), 2u);
+  EXPECT_EQ(countOccurrences(json, "\"ph\":\"i\""), 1u);
+  EXPECT_LT(json.find("ProfilerTest::outer"), json.find("ProfilerTest::inner"));
+}
+
+TEST_F(ProfilerTest, FrameNames) {
+  EXPECT_EQ(profiler::internFrameName(nullptr), profiler::internName("Frame"));
+  profiler::markFrame(profiler::internFrameName("ProfilerTest::frame"));
+  const std::string json = profiler::toChromeTrace();
+  EXPECT_NE(json.find("{\"name\":\"ProfilerTest::frame\",\"ph\":\"i\""), std::string::npos);
+}
+
+TEST_F(ProfilerTest, DisabledRecordsNothing) {
+  profiler::setEnabled(false);
+  {
+    const profiler::ScopedZone zone(profiler::internName("ProfilerTest::disabled"));
+  }
+  EXPECT_EQ(profiler::toChromeTrace().find("ProfilerTest::disabled"), std::string::npos);
+}
+
+TEST_F(ProfilerTest, ZoneOpenWhenDisabledIsClosed) {
+  {
+    const profiler::ScopedZone zone(profiler::internName("ProfilerTest::toggled"));
+    profiler::setEnabled(false);
+  }
+  const std::string json = profiler::toChromeTrace();
+  EXPECT_EQ(countOccurrences(json, "\"ph\":\"B\""), 1u);
+  EXPECT_EQ(countOccurrences(json, "\"ph\":\"E\""), 1u);
+}
+
+TEST_F(ProfilerTest, RingBufferKeepsLatestEvents) {
+  const profiler::ZoneId outer = profiler::internName("ProfilerTest::overwritten");
+  const profiler::ZoneId inner = profiler::internName("ProfilerTest::latest");
+  {
+    const profiler::ScopedZone outerZone(outer);
+    for (size_t i = 0; i != profiler::kEventsPerThread; ++i) {
+      const profiler::ScopedZone innerZone(inner);
+    }
+  }
+  // The begin of the outer zone was overwritten, so its end is dropped as well
+  const std::string json = profiler::toChromeTrace();
+  EXPECT_EQ(json.find("ProfilerTest::overwritten"), std::string::npos);
+  EXPECT_EQ(countOccurrences(json, "\"ph\":\"B\""), countOccurrences(json, "\"ph\":\"E\""));
+}
+
+TEST_F(ProfilerTest, MultipleThreads) {
+  auto recordZones = [](const char* threadName) {
+    profiler::setThreadName(threadName);
+    const profiler::ZoneId zone = profiler::internName("ProfilerTest::thread");
+    for (int i = 0; i != 100; ++i) {
+      const profiler::ScopedZone scopedZone(zone);
+    }
+  };
+  std::thread t1(recordZones, "Worker \"1\"");
+  std::thread t2(recordZones, "Worker 2");
+  t1.join();
+  t2.join();
+
+  const std::string json = profiler::toChromeTrace();
+  EXPECT_NE(json.find("Worker \\\"1\\\""), std::string::npos);
+  EXPECT_NE(json.find("Worker 2"), std::string::npos);
+  EXPECT_EQ(countOccurrences(json, "\"ph\":\"B\""), 200u);
+  EXPECT_EQ(countOccurrences(json, "\"ph\":\"E\""), 200u);
+}
+
+TEST_F(ProfilerTest, ResetDiscardsEvents) {
+  {
+    const profiler::ScopedZone zone(profiler::internName("ProfilerTest::reset"));
+  }
+  profiler::reset();
+  EXPECT_EQ(profiler::toChromeTrace().find("ProfilerTest::reset"), std::string::npos);
+}
+
+} // namespace igl::tests
@@ -9,6 +9,7 @@
 #include <functional>
 #include <gtest/gtest.h>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -22,6 +23,11 @@
 #include <igl/IGL.h>
 #include <igl/NameHandle.h>
 #include <igl/RenderPipelineState.h>
+#if IGL_BACKEND_OPENGL
+#include <igl/opengl/IContext.h>
+#include <igl/opengl/PlatformDevice.h>
+#include <igl/opengl/Version.h>
+#endif // IGL_BACKEND_OPENGL
 
 #define OFFSCREEN_RT_WIDTH 4
 #define OFFSCREEN_RT_HEIGHT 4
@@ -501,6 +507,270 @@ TEST_F(RenderCommandEncoderTest, drawIndexedFirstIndex) {
   verifyFrameBuffer(expectedPixels);
 }
 
+#if IGL_BACKEND_OPENGL
+//
+// drawIndexedBatched
+//
+// Consecutive drawIndexed() calls batched into glMultiDrawElements must render the same as
+// individual draws.
+//
+TEST_F(RenderCommandEncoderTest, drawIndexedBatched) {
+  auto* platformDevice = iglDev_->getPlatformDevice<opengl::PlatformDevice>();
+  if (!platformDevice) {
+    GTEST_SKIP();
+    return;
+  }
+  auto& context = platformDevice->getContext();
+  context.setShouldBatchDraws(true);
+  if (!context.shouldBatchDraws()) {
+    context.setShouldBatchDraws(false);
+    GTEST_SKIP() << "glMultiDrawElements is not supported";
+    return;
+  }
+  initializeBuffers(
+      // clang-format off
+      {
+        -1.0f, -1.0f, 0.0f, 1.0f,
+         1.0f, -1.0f, 0.0f, 1.0f,
+         1.0f,  1.0f, 0.0f, 1.0f,
+        -1.0f,  1.0f, 0.0f, 1.0f,
+      },
+      {
+        0.0f, 0.0f,
+        1.0f, 0.0f,
+        1.0f, 1.0f,
+        0.0f, 1.0f,
+      },
+      {
+        0, 1, 2, 0, 2, 3,
+      } // clang-format on
+  );
+
+  ASSERT_TRUE(ib_ != nullptr);
+
+  const size_t drawCount = context.getCurrentDrawCount();
+  encodeAndSubmit([this](const std::unique_ptr<igl::IRenderCommandEncoder>& encoder) {
+    encoder->bindRenderPipelineState(renderPipelineState_Triangle_);
+    encoder->drawIndexed(3, 1, 0);
+    // Rebinding the same state must not break the batch
+    encoder->bindRenderPipelineState(renderPipelineState_Triangle_);
+    encoder->drawIndexed(3, 1, 3);
+  });
+  context.setShouldBatchDraws(false);
+
+  // Batched draws are still counted individually
+  ASSERT_EQ(context.getCurrentDrawCount() - drawCount, 2u);
+
+  const auto grayColor = data::texture::TEX_RGBA_GRAY_4x4[0];
+  verifyFrameBuffer([grayColor](const std::vector<uint32_t>& pixels) {
+    for (const auto pixel : pixels) {
+      ASSERT_EQ(pixel, grayColor);
+    }
+  });
+}
+
+//
+// drawIndexedBatchedUniformBlockUpload
+//
+// Uploading to a uniform buffer between two batched draws must not change what the first draw
+// reads, even when the same buffer stays bound.
+//
+TEST_F(RenderCommandEncoderTest, drawIndexedBatchedUniformBlockUpload) {
+  auto* platformDevice = iglDev_->getPlatformDevice<opengl::PlatformDevice>();
+  if (!platformDevice || !iglDev_->hasFeature(DeviceFeatures::UniformBlocks)) {
+    GTEST_SKIP();
+    return;
+  }
+  auto& context = platformDevice->getContext();
+  const auto shaderVersion = context.deviceFeatures().getShaderVersion();
+  const bool isGlslEs = shaderVersion.family == ShaderFamily::GlslEs;
+  const bool hasUniformBlockSyntax =
+      isGlslEs ? shaderVersion.majorVersion >= 3
+               : (shaderVersion.majorVersion > 1 || shaderVersion.minorVersion >= 40);
+  if (!hasUniformBlockSyntax) {
+    GTEST_SKIP() << "GLSL without uniform blocks";
+    return;
+  }
+  context.setShouldBatchDraws(true);
+  if (!context.shouldBatchDraws()) {
+    context.setShouldBatchDraws(false);
+    GTEST_SKIP() << "glMultiDrawElements is not supported";
+    return;
+  }
+
+  const std::string prolog = opengl::getStringFromShaderVersion(shaderVersion) + "\n" +
+                             (isGlslEs ? "precision highp float;\n" : "");
+  const std::string vertexSource = prolog + R"(
+    in vec4 position_in;
+    in vec2 uv_in;
+    out vec2 uv;
+    void main() {
+      gl_Position = position_in;
+      uv = uv_in;
+    })";
+  const std::string fragmentSource = prolog + R"(
+    layout (std140) uniform ColorBlock {
+      vec4 color;
+    };
+    in vec2 uv;
+    out vec4 fragColor;
+    void main() {
+      fragColor = color + vec4(uv, 0.0, 0.0) * 0.0;
+    })";
+  std::unique_ptr<IShaderStages> stages;
+  util::createShaderStages(iglDev_,
+                           vertexSource.c_str(),
+                           data::shader::shaderFunc,
+                           fragmentSource.c_str(),
+                           data::shader::shaderFunc,
+                           stages);
+  ASSERT_TRUE(stages != nullptr);
+
+  const size_t colorBlockBinding = 1;
+  RenderPipelineDesc pipelineDesc;
+  pipelineDesc.vertexInputState = vertexInputState_;
+  pipelineDesc.shaderStages = std::move(stages);
+  pipelineDesc.targetDesc.colorAttachments.resize(1);
+  pipelineDesc.targetDesc.colorAttachments[0].textureFormat = offscreenTexture_->getFormat();
+  pipelineDesc.targetDesc.depthAttachmentFormat = depthStencilTexture_->getFormat();
+  pipelineDesc.targetDesc.stencilAttachmentFormat = depthStencilTexture_->getFormat();
+  pipelineDesc.uniformBlockBindingMap[colorBlockBinding] = {
+      {IGL_NAMEHANDLE("ColorBlock"), IGL_NAMEHANDLE("")}};
+  pipelineDesc.cullMode = igl::CullMode::Disabled;
+
+  Result ret;
+  auto pipelineState = iglDev_->createRenderPipeline(pipelineDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  const float red[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+  const float green[4] = {0.0f, 1.0f, 0.0f, 1.0f};
+  BufferDesc colorDesc(BufferDesc::BufferTypeBits::Uniform,
+                       red,
+                       sizeof(red),
+                       ResourceStorage::Shared,
+                       BufferDesc::BufferAPIHintBits::UniformBlock);
+  auto colorBuffer = iglDev_->createBuffer(colorDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  // Left and right halves of the render target, six indices each
+  initializeBuffers(
+      // clang-format off
+      {
+        -1.0f, -1.0f, 0.0f, 1.0f,
+         0.0f, -1.0f, 0.0f, 1.0f,
+         0.0f,  1.0f, 0.0f, 1.0f,
+        -1.0f,  1.0f, 0.0f, 1.0f,
+         1.0f, -1.0f, 0.0f, 1.0f,
+         1.0f,  1.0f, 0.0f, 1.0f,
+      },
+      {
+        0.0f, 0.0f,
+        0.5f, 0.0f,
+        0.5f, 1.0f,
+        0.0f, 1.0f,
+        1.0f, 0.0f,
+        1.0f, 1.0f,
+      },
+      {
+        0, 1, 2, 0, 2, 3,
+        1, 4, 5, 1, 5, 2,
+      } // clang-format on
+  );
+  ASSERT_TRUE(ib_ != nullptr);
+
+  encodeAndSubmit([&](const std::unique_ptr<igl::IRenderCommandEncoder>& encoder) {
+    encoder->bindRenderPipelineState(pipelineState);
+    encoder->bindBuffer(colorBlockBinding, colorBuffer.get(), 0, sizeof(red));
+    encoder->drawIndexed(6, 1, 0);
+    colorBuffer->upload(green, BufferRange(sizeof(green)));
+    encoder->bindBuffer(colorBlockBinding, colorBuffer.get(), 0, sizeof(green));
+    encoder->drawIndexed(6, 1, 6);
+  });
+  context.setShouldBatchDraws(false);
+
+  const uint32_t redPixel = 0xff0000ff;
+  const uint32_t greenPixel = 0xff00ff00;
+  verifyFrameBuffer([=](const std::vector<uint32_t>& pixels) {
+    for (size_t y = 0; y < OFFSCREEN_RT_HEIGHT; y++) {
+      for (size_t x = 0; x < OFFSCREEN_RT_WIDTH; x++) {
+        ASSERT_EQ(pixels[y * OFFSCREEN_RT_WIDTH + x],
+                  x < OFFSCREEN_RT_WIDTH / 2 ? redPixel : greenPixel);
+      }
+    }
+  });
+}
+
+//
+// drawIndexedBatchedTextureUpload
+//
+// Uploading to a texture between two batched draws must not change what the first draw samples.
+//
+TEST_F(RenderCommandEncoderTest, drawIndexedBatchedTextureUpload) {
+  auto* platformDevice = iglDev_->getPlatformDevice<opengl::PlatformDevice>();
+  if (!platformDevice) {
+    GTEST_SKIP();
+    return;
+  }
+  auto& context = platformDevice->getContext();
+  context.setShouldBatchDraws(true);
+  if (!context.shouldBatchDraws()) {
+    context.setShouldBatchDraws(false);
+    GTEST_SKIP() << "glMultiDrawElements is not supported";
+    return;
+  }
+
+  // Left and right halves of the render target, six indices each
+  initializeBuffers(
+      // clang-format off
+      {
+        -1.0f, -1.0f, 0.0f, 1.0f,
+         0.0f, -1.0f, 0.0f, 1.0f,
+         0.0f,  1.0f, 0.0f, 1.0f,
+        -1.0f,  1.0f, 0.0f, 1.0f,
+         1.0f, -1.0f, 0.0f, 1.0f,
+         1.0f,  1.0f, 0.0f, 1.0f,
+      },
+      {
+        0.0f, 0.0f,
+        0.5f, 0.0f,
+        0.5f, 1.0f,
+        0.0f, 1.0f,
+        1.0f, 0.0f,
+        1.0f, 1.0f,
+      },
+      {
+        0, 1, 2, 0, 2, 3,
+        1, 4, 5, 1, 5, 2,
+      } // clang-format on
+  );
+  ASSERT_TRUE(ib_ != nullptr);
+
+  const uint32_t grayPixel = data::texture::TEX_RGBA_GRAY_4x4[0];
+  const uint32_t greenPixel = 0x00FF00FF;
+  const std::vector<uint32_t> green(OFFSCREEN_TEX_WIDTH * OFFSCREEN_TEX_HEIGHT, greenPixel);
+  encodeAndSubmit([&](const std::unique_ptr<igl::IRenderCommandEncoder>& encoder) {
+    encoder->bindRenderPipelineState(renderPipelineState_Triangle_);
+    encoder->drawIndexed(6, 1, 0);
+    texture_->upload(TextureRangeDesc::new2D(0, 0, OFFSCREEN_TEX_WIDTH, OFFSCREEN_TEX_HEIGHT),
+                     green.data());
+    // The upload leaves its texture unit unbound in GL, so make the encoder bind it again
+    encoder->bindTexture(textureUnit_, BindTarget::kFragment, nullptr);
+    encoder->bindTexture(textureUnit_, BindTarget::kFragment, texture_.get());
+    encoder->drawIndexed(6, 1, 6);
+  });
+  context.setShouldBatchDraws(false);
+
+  verifyFrameBuffer([=](const std::vector<uint32_t>& pixels) {
+    for (size_t y = 0; y < OFFSCREEN_RT_HEIGHT; y++) {
+      for (size_t x = 0; x < OFFSCREEN_RT_WIDTH; x++) {
+        ASSERT_EQ(pixels[y * OFFSCREEN_RT_WIDTH + x],
+                  x < OFFSCREEN_RT_WIDTH / 2 ? grayPixel : greenPixel);
+      }
+    }
+  });
+}
+#endif // IGL_BACKEND_OPENGL
+
 TEST_F(RenderCommandEncoderTest, drawIndexed8Bit) {
   if (!iglDev_->hasFeature(igl::DeviceFeatures::Indices8Bit)) {
     GTEST_SKIP();
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "RecordingRenderCommandEncoder.h"
+#include "SimpleRendererTest.h"
+
+#include <IGLU/simple_renderer/DrawList.h>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <vector>
+
+namespace igl::tests {
+
+using iglu::tests::RecordingRenderCommandEncoder;
+using Type = RecordingRenderCommandEncoder::Type;
+
+class DrawListTest : public SimpleRendererTest {
+ public:
+  std::shared_ptr<IRenderPipelineState> add(iglu::drawable::Drawable& drawable,
+                                            float depth = 0.0f,
+                                            const void* instanceData = nullptr,
+                                            size_t instanceDataSize = 0) {
+    auto pipelineState =
+        drawable.pipelineState(*iglDev_, pipelineDesc_, pipelineDescKey_, &pipelineCache_);
+    drawList_.add(drawable, *iglDev_, pipelineState, depth, instanceData, instanceDataSize);
+    return pipelineState;
+  }
+
+  [[nodiscard]] std::vector<size_t> drawnVertexCounts() const {
+    std::vector<size_t> counts;
+    for (const auto& command : encoder_.ofType(Type::Draw)) {
+      counts.push_back(command.count);
+    }
+    return counts;
+  }
+
+ protected:
+  iglu::renderpass::DrawList drawList_;
+  RecordingRenderCommandEncoder encoder_;
+};
+
+TEST_F(DrawListTest, SortsByPipelineState) {
+  // Vertex data with a different winding needs its own pipeline state
+  auto material = createMaterial();
+  auto& a1 = createDrawable(createVertexData(1), material);
+  auto& b1 = createDrawable(createVertexData(2, WindingMode::Clockwise), material);
+  auto& a2 = createDrawable(createVertexData(3), material);
+  auto& b2 = createDrawable(createVertexData(4, WindingMode::Clockwise), material);
+  const auto pipelineA = add(a1);
+  const auto pipelineB = add(b1);
+  add(a2);
+  add(b2);
+  ASSERT_NE(pipelineA, pipelineB);
+  EXPECT_EQ(drawList_.size(), 4u);
+
+  drawList_.flush(encoder_);
+  EXPECT_EQ(drawList_.size(), 0u);
+
+  const auto pipelineBinds = encoder_.ofType(Type::BindRenderPipelineState);
+  ASSERT_EQ(pipelineBinds.size(), 2u);
+  EXPECT_EQ(pipelineBinds[0].object, pipelineA.get());
+  EXPECT_EQ(pipelineBinds[1].object, pipelineB.get());
+  EXPECT_EQ(drawnVertexCounts(), (std::vector<size_t>{1, 3, 2, 4}));
+}
+
+TEST_F(DrawListTest, SortsByMaterial) {
+  auto materialA = createMaterial();
+  auto materialB = createMaterial();
+  add(createDrawable(createVertexData(1), materialA));
+  add(createDrawable(createVertexData(2), materialB));
+  add(createDrawable(createVertexData(3), materialA));
+  add(createDrawable(createVertexData(4), materialB));
+
+  drawList_.flush(encoder_);
+
+  // Both materials share one pipeline state, and each is bound once
+  EXPECT_EQ(encoder_.count(Type::BindRenderPipelineState), 1u);
+  const auto depthStencilBinds = encoder_.ofType(Type::BindDepthStencilState);
+  ASSERT_EQ(depthStencilBinds.size(), 2u);
+  EXPECT_NE(depthStencilBinds[0].object, depthStencilBinds[1].object);
+  EXPECT_EQ(drawnVertexCounts(), (std::vector<size_t>{1, 3, 2, 4}));
+}
+
+TEST_F(DrawListTest, SortsByDepth) {
+  // Opaque draws go front to back. Different instance data sizes keep them from being merged, and
+  // their instance data is packed in the order they are issued.
+  auto opaque = createMaterial();
+  auto& drawable = createDrawable(createVertexData(1), opaque);
+  const uint8_t instanceData[12] = {};
+  add(drawable, 3.0f, instanceData, 4);
+  add(drawable, 1.0f, instanceData, 8);
+  add(drawable, 2.0f, instanceData, 12);
+
+  // Translucent draws go after all opaque ones, back to front
+  auto translucent = createMaterial(iglu::material::BlendMode::Translucent());
+  add(createDrawable(createVertexData(10), translucent), 1.0f);
+  add(createDrawable(createVertexData(20), translucent), 3.0f);
+  add(createDrawable(createVertexData(30), translucent), -2.0f);
+  add(createDrawable(createVertexData(40), translucent), 2.0f);
+
+  drawList_.flush(encoder_);
+
+  std::vector<size_t> instanceOffsets;
+  for (const auto& command : encoder_.ofType(Type::BindVertexBuffer)) {
+    if (command.index == 1) {
+      instanceOffsets.push_back(command.offset);
+    }
+  }
+  EXPECT_EQ(instanceOffsets, (std::vector<size_t>{0, 8, 20}));
+  EXPECT_EQ(drawnVertexCounts(), (std::vector<size_t>{1, 1, 1, 20, 40, 10, 30}));
+}
+
+TEST_F(DrawListTest, MergesIdenticalDrawsIntoInstancedDraw) {
+  auto material = createMaterial();
+  auto vertexData = createVertexData(6);
+  auto& first = createDrawable(vertexData, material);
+  auto& second = createDrawable(vertexData, material);
+  const float instance[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+  add(first, 0.0f, instance, sizeof(instance));
+  add(second, 0.0f, instance, sizeof(instance));
+  add(first, 0.0f, instance, sizeof(instance));
+  // Draws without instance data, or with a different size, are not merged
+  add(first);
+  add(first, 0.0f, instance, sizeof(float));
+
+  drawList_.flush(encoder_, 2);
+
+  std::vector<uint32_t> instanceCounts;
+  for (const auto& command : encoder_.ofType(Type::Draw)) {
+    EXPECT_EQ(command.count, 6u);
+    instanceCounts.push_back(command.instanceCount);
+  }
+  std::sort(instanceCounts.begin(), instanceCounts.end());
+  EXPECT_EQ(instanceCounts, (std::vector<uint32_t>{1, 1, 3}));
+
+  // All instance data lives in one buffer bound at the requested index
+  std::vector<size_t> instanceOffsets;
+  const void* instanceBuffer = nullptr;
+  for (const auto& command : encoder_.ofType(Type::BindVertexBuffer)) {
+    if (command.index == 2) {
+      EXPECT_TRUE(instanceBuffer == nullptr || instanceBuffer == command.object);
+      instanceBuffer = command.object;
+      instanceOffsets.push_back(command.offset);
+    }
+  }
+  std::sort(instanceOffsets.begin(), instanceOffsets.end());
+  EXPECT_EQ(instanceOffsets, (std::vector<size_t>{0, 3 * sizeof(instance)}));
+
+  // State is bound once for the whole run
+  EXPECT_EQ(encoder_.count(Type::BindRenderPipelineState), 1u);
+  EXPECT_EQ(encoder_.count(Type::BindDepthStencilState), 1u);
+}
+
+TEST_F(DrawListTest, RebindsMaterialAfterPipelineChange) {
+  auto material = createMaterial();
+  add(createDrawable(createVertexData(1), material));
+  add(createDrawable(createVertexData(2, WindingMode::Clockwise), material));
+
+  drawList_.flush(encoder_);
+
+  std::vector<Type> bindTypes;
+  for (const auto& command : encoder_.commands) {
+    if (command.type == Type::BindRenderPipelineState ||
+        command.type == Type::BindDepthStencilState || command.type == Type::Draw) {
+      bindTypes.push_back(command.type);
+    }
+  }
+  EXPECT_EQ(bindTypes,
+            (std::vector<Type>{Type::BindRenderPipelineState,
+                               Type::BindDepthStencilState,
+                               Type::Draw,
+                               Type::BindRenderPipelineState,
+                               Type::BindDepthStencilState,
+                               Type::Draw}));
+}
+
+} // namespace igl::tests
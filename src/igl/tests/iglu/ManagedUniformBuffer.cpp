@@ -5,8 +5,13 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include "../data/ShaderData.h"
 #include "../util/Common.h"
+#include "RecordingRenderCommandEncoder.h"
+
 #include <IGLU/managedUniformBuffer/ManagedUniformBuffer.h>
+#include <cstring>
+#include <vector>
 
 namespace igl::tests {
 
@@ -84,6 +89,31 @@ TEST_F(ManagedUniformBufferTest, UpdateData) {
   }
 }
 
+TEST_F(ManagedUniformBufferTest, UpdateDataWithHandle) {
+  iglu::ManagedUniformBuffer buffer(*iglDev_,
+                                    {0,
+                                     32,
+                                     {{"first", 0, UniformType::Float, 1, 0, 0},
+                                      {"second", 1, UniformType::Float4, 1, 16, 0}},
+                                     3});
+
+  const auto first = buffer.getUniformHandle("first");
+  const auto second = buffer.getUniformHandle("second");
+  ASSERT_TRUE(first.isValid());
+  ASSERT_TRUE(second.isValid());
+  EXPECT_FALSE(buffer.getUniformHandle("nonExistingUniform").isValid());
+
+  const float firstData = 1000.0f;
+  const float secondData[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+  EXPECT_TRUE(buffer.updateData(first, &firstData, sizeof(firstData)));
+  EXPECT_TRUE(buffer.updateData(second, secondData, sizeof(secondData)));
+  EXPECT_FALSE(buffer.updateData(iglu::ManagedUniformBuffer::UniformHandle{}, &firstData, 4));
+
+  const auto* data = static_cast<const uint8_t*>(buffer.getData());
+  EXPECT_EQ(*reinterpret_cast<const float*>(data), firstData);
+  EXPECT_EQ(std::memcmp(data + 16, secondData, sizeof(secondData)), 0);
+}
+
 TEST_F(ManagedUniformBufferTest, GetUniformDataSize) {
   iglu::ManagedUniformBuffer buffer(*iglDev_,
                                     {0, 10, {{"myUniform", 0, UniformType::Float, 1, 0, 0}}});
@@ -91,4 +121,111 @@ TEST_F(ManagedUniformBufferTest, GetUniformDataSize) {
   EXPECT_EQ(buffer.getUniformDataSize("nonExistingUniform"), 0);
 }
 
+TEST_F(ManagedUniformBufferTest, CoalesceUniformRanges) {
+  constexpr size_t kGap = iglu::ManagedUniformBuffer::kCoalesceGap;
+  const std::vector<UniformDesc> uniforms = {
+      {"a", 0, UniformType::Float4, 1, 0, 0},
+      {"b", 1, UniformType::Float4, 1, 16 + kGap, 0},
+      {"c", 2, UniformType::Float4, 1, 32 + 2 * kGap + 1, 0},
+      {"d", 3, UniformType::Float4, 1, 224, 0},
+  };
+
+  // A gap of exactly kCoalesceGap bytes is merged, one more byte starts a new range
+  std::vector<BufferRange> ranges;
+  iglu::ManagedUniformBuffer::coalesceUniformRanges(uniforms, {0, 1, 2}, 512, ranges);
+  ASSERT_EQ(ranges.size(), 2u);
+  EXPECT_EQ(ranges[0].offset, 0u);
+  EXPECT_EQ(ranges[0].size, 32 + kGap);
+  EXPECT_EQ(ranges[1].offset, 32 + 2 * kGap + 1);
+  EXPECT_EQ(ranges[1].size, 16u);
+
+  // Clean uniforms in between don't matter, only the distance between dirty ones does
+  ranges.clear();
+  iglu::ManagedUniformBuffer::coalesceUniformRanges(uniforms, {0, 2}, 512, ranges);
+  ASSERT_EQ(ranges.size(), 2u);
+  EXPECT_EQ(ranges[0].size, 16u);
+
+  // Ranges are clamped to the buffer length
+  ranges.clear();
+  iglu::ManagedUniformBuffer::coalesceUniformRanges(uniforms, {2, 3}, 232, ranges);
+  ASSERT_EQ(ranges.size(), 1u);
+  EXPECT_EQ(ranges[0].offset, 32 + 2 * kGap + 1);
+  EXPECT_EQ(ranges[0].offset + ranges[0].size, 232u);
+
+  ranges.clear();
+  iglu::ManagedUniformBuffer::coalesceUniformRanges(uniforms, {}, 512, ranges);
+  EXPECT_TRUE(ranges.empty());
+}
+
+TEST_F(ManagedUniformBufferTest, CyclesBuffersAcrossFrames) {
+  if (iglDev_->getBackendType() == BackendType::OpenGL) {
+    GTEST_SKIP() << "OpenGL binds individual uniforms rather than buffers";
+  }
+
+  // Large enough for Metal to bind a buffer rather than bytes
+  constexpr size_t kLength = 64 * 1024;
+  constexpr size_t kNumBuffers = 3;
+  iglu::ManagedUniformBuffer buffer(
+      *iglDev_, {0, kLength, {{"value", 0, UniformType::Float, 1, 0, 0}}, kNumBuffers});
+  ASSERT_TRUE(buffer.result.isOk()) << buffer.result.message;
+  const auto handle = buffer.getUniformHandle("value");
+
+  std::unique_ptr<IShaderStages> stages;
+  util::createSimpleShaderStages(iglDev_, stages);
+  ASSERT_TRUE(stages != nullptr);
+  VertexInputStateDesc inputDesc;
+  inputDesc.attributes[0].format = VertexAttributeFormat::Float4;
+  inputDesc.attributes[0].location = 0;
+  inputDesc.attributes[0].bufferIndex = data::shader::simplePosIndex;
+  inputDesc.attributes[0].name = data::shader::simplePos;
+  inputDesc.inputBindings[0].stride = sizeof(float) * 4;
+  inputDesc.attributes[1].format = VertexAttributeFormat::Float2;
+  inputDesc.attributes[1].location = 1;
+  inputDesc.attributes[1].bufferIndex = data::shader::simpleUvIndex;
+  inputDesc.attributes[1].name = data::shader::simpleUv;
+  inputDesc.inputBindings[1].stride = sizeof(float) * 2;
+  inputDesc.numAttributes = inputDesc.numInputBindings = 2;
+  Result ret;
+  RenderPipelineDesc pipelineDesc;
+  pipelineDesc.vertexInputState = iglDev_->createVertexInputState(inputDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  pipelineDesc.shaderStages = std::move(stages);
+  pipelineDesc.targetDesc.colorAttachments.resize(1);
+  pipelineDesc.targetDesc.colorAttachments[0].textureFormat = TextureFormat::RGBA_UNorm8;
+  const auto pipelineState = iglDev_->createRenderPipeline(pipelineDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+
+  // Buffers shared with the CPU copy can't be cycled
+  const size_t expectedNumBuffers =
+      iglDev_->hasFeature(DeviceFeatures::BufferNoCopy) ? 1 : kNumBuffers;
+
+  auto bindFrame = [&](float value, bool update) -> const void* {
+    if (update) {
+      buffer.updateData(handle, &value, sizeof(value));
+    }
+    iglu::tests::RecordingRenderCommandEncoder encoder;
+    buffer.bind(*iglDev_, *pipelineState, encoder);
+    const auto binds = encoder.ofType(iglu::tests::RecordingRenderCommandEncoder::Type::BindBuffer);
+    EXPECT_EQ(binds.size(), 1u);
+    return binds.empty() ? nullptr : binds[0].object;
+  };
+
+  // Each frame that changes the data moves on to the next buffer, wrapping after numBuffers
+  std::vector<const void*> bound;
+  for (size_t frame = 0; frame < 2 * kNumBuffers; ++frame) {
+    bound.push_back(bindFrame(static_cast<float>(frame), true));
+  }
+  for (size_t frame = 0; frame < bound.size(); ++frame) {
+    EXPECT_EQ(bound[frame], bound[frame % expectedNumBuffers]) << "frame " << frame;
+    if (frame > 0 && expectedNumBuffers > 1) {
+      EXPECT_NE(bound[frame], bound[frame - 1]) << "frame " << frame;
+    }
+  }
+
+  // Frames without changes keep binding the buffer bound last
+  EXPECT_EQ(bindFrame(0.0f, false), bound.back());
+  EXPECT_EQ(bindFrame(0.0f, false), bound.back());
+  EXPECT_EQ(bindFrame(1.0f, true), bound[bound.size() % expectedNumBuffers]);
+}
+
 } // namespace igl::tests
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "SimpleRendererTest.h"
+
+#include <IGLU/simple_renderer/PipelineCache.h>
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+
+namespace igl::tests {
+
+class PipelineCacheTest : public SimpleRendererTest {
+ public:
+  // Returns a fully populated descriptor, as drawables pass them to the cache
+  RenderPipelineDesc populatedDesc(const iglu::material::BlendMode& blendMode) {
+    RenderPipelineDesc desc = pipelineDesc_;
+    createVertexData(3)->populatePipelineDescriptor(desc);
+    createMaterial(blendMode)->populatePipelineDescriptor(desc);
+    return desc;
+  }
+};
+
+TEST_F(PipelineCacheTest, HitAndMiss) {
+  const RenderPipelineDesc opaqueDesc = populatedDesc(iglu::material::BlendMode::Opaque());
+  const RenderPipelineDesc additiveDesc = populatedDesc(iglu::material::BlendMode::Additive());
+
+  Result ret;
+  auto opaque = pipelineCache_.getOrCreate(*iglDev_, opaqueDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  ASSERT_TRUE(opaque != nullptr);
+  EXPECT_EQ(pipelineCache_.size(), 1u);
+
+  EXPECT_EQ(pipelineCache_.getOrCreate(*iglDev_, opaqueDesc, &ret), opaque);
+  EXPECT_TRUE(ret.isOk());
+  EXPECT_EQ(pipelineCache_.size(), 1u);
+
+  auto additive = pipelineCache_.getOrCreate(*iglDev_, additiveDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  EXPECT_NE(additive, opaque);
+  EXPECT_EQ(pipelineCache_.size(), 2u);
+
+  pipelineCache_.clear();
+  EXPECT_EQ(pipelineCache_.size(), 0u);
+  EXPECT_NE(pipelineCache_.getOrCreate(*iglDev_, opaqueDesc), opaque);
+}
+
+TEST_F(PipelineCacheTest, SharedAcrossMaterials) {
+  auto vertexData = createVertexData(3);
+  auto& first = createDrawable(vertexData, createMaterial());
+  auto& second = createDrawable(vertexData, createMaterial());
+  auto& uncached = createDrawable(vertexData, createMaterial());
+
+  const auto firstState =
+      first.pipelineState(*iglDev_, pipelineDesc_, pipelineDescKey_, &pipelineCache_);
+  const auto secondState =
+      second.pipelineState(*iglDev_, pipelineDesc_, pipelineDescKey_, &pipelineCache_);
+  ASSERT_TRUE(firstState != nullptr);
+  EXPECT_EQ(firstState, secondState);
+  EXPECT_EQ(pipelineCache_.size(), 1u);
+
+  // Without a cache, each drawable creates its own state
+  EXPECT_NE(uncached.pipelineState(*iglDev_, pipelineDesc_, pipelineDescKey_), firstState);
+}
+
+TEST_F(PipelineCacheTest, RevalidatesKeyWhenDescChanges) {
+  auto& drawable = createDrawable(createVertexData(3), createMaterial());
+  const auto state =
+      drawable.pipelineState(*iglDev_, pipelineDesc_, pipelineDescKey_, &pipelineCache_);
+  ASSERT_TRUE(state != nullptr);
+
+  // The same key reuses the drawable's state without going through the cache
+  pipelineCache_.clear();
+  EXPECT_EQ(drawable.pipelineState(*iglDev_, pipelineDesc_, pipelineDescKey_, &pipelineCache_),
+            state);
+  EXPECT_EQ(pipelineCache_.size(), 0u);
+
+  // A new target gets a new state
+  RenderPipelineDesc otherDesc = pipelineDesc_;
+  otherDesc.targetDesc.colorAttachments[0].textureFormat = TextureFormat::BGRA_UNorm8;
+  const size_t otherKey = std::hash<RenderPipelineDesc>()(otherDesc);
+  ASSERT_NE(otherKey, pipelineDescKey_);
+  const auto otherState =
+      drawable.pipelineState(*iglDev_, otherDesc, otherKey, &pipelineCache_);
+  ASSERT_TRUE(otherState != nullptr);
+  EXPECT_NE(otherState, state);
+  EXPECT_EQ(pipelineCache_.size(), 1u);
+
+  // Switching back resolves the original target through the cache again
+  const auto newState =
+      drawable.pipelineState(*iglDev_, pipelineDesc_, pipelineDescKey_, &pipelineCache_);
+  EXPECT_NE(newState, otherState);
+  EXPECT_EQ(pipelineCache_.size(), 2u);
+}
+
+TEST_F(PipelineCacheTest, ReleaseUnused) {
+  auto vertexData = createVertexData(3);
+  auto& opaque = createDrawable(vertexData, createMaterial());
+  auto& additive =
+      createDrawable(vertexData, createMaterial(iglu::material::BlendMode::Additive()));
+  ASSERT_TRUE(opaque.pipelineState(*iglDev_, pipelineDesc_, pipelineDescKey_, &pipelineCache_));
+  ASSERT_TRUE(additive.pipelineState(*iglDev_, pipelineDesc_, pipelineDescKey_, &pipelineCache_));
+  EXPECT_EQ(pipelineCache_.size(), 2u);
+
+  EXPECT_EQ(pipelineCache_.releaseUnused(), 0u);
+  drawables_.pop_back();
+  EXPECT_EQ(pipelineCache_.releaseUnused(), 1u);
+  EXPECT_EQ(pipelineCache_.size(), 1u);
+}
+
+} // namespace igl::tests
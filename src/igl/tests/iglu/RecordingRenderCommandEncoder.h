@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/IGL.h>
+#include <vector>
+
+namespace iglu::tests {
+
+/// Render command encoder that records the commands the IGLU renderers issue instead of
+/// encoding them, so tests can check which states get bound and in which order.
+class RecordingRenderCommandEncoder final : public igl::IRenderCommandEncoder {
+ public:
+  enum class Type {
+    BindRenderPipelineState,
+    BindDepthStencilState,
+    BindBuffer,
+    BindVertexBuffer,
+    BindIndexBuffer,
+    BindBytes,
+    BindUniform,
+    Draw,
+    DrawIndexed,
+  };
+
+  struct Command {
+    Type type;
+    const void* object = nullptr;
+    size_t index = 0;
+    size_t offset = 0;
+    size_t count = 0;
+    uint32_t instanceCount = 0;
+  };
+
+  RecordingRenderCommandEncoder() : IRenderCommandEncoder(nullptr) {}
+
+  [[nodiscard]] size_t count(Type type) const {
+    size_t n = 0;
+    for (const auto& command : commands) {
+      n += command.type == type ? 1 : 0;
+    }
+    return n;
+  }
+
+  [[nodiscard]] std::vector<Command> ofType(Type type) const {
+    std::vector<Command> result;
+    for (const auto& command : commands) {
+      if (command.type == type) {
+        result.push_back(command);
+      }
+    }
+    return result;
+  }
+
+  void endEncoding() override {}
+  void pushDebugGroupLabel(const char* /*label*/, const igl::Color& /*color*/) const override {}
+  void insertDebugEventLabel(const char* /*label*/, const igl::Color& /*color*/) const override {}
+  void popDebugGroupLabel() const override {}
+
+  void bindViewport(const igl::Viewport& /*viewport*/) override {}
+  void bindScissorRect(const igl::ScissorRect& /*rect*/) override {}
+  void bindRenderPipelineState(
+      const std::shared_ptr<igl::IRenderPipelineState>& pipelineState) override {
+    commands.push_back({Type::BindRenderPipelineState, pipelineState.get()});
+  }
+  void bindDepthStencilState(
+      const std::shared_ptr<igl::IDepthStencilState>& depthStencilState) override {
+    commands.push_back({Type::BindDepthStencilState, depthStencilState.get()});
+  }
+  void bindBuffer(uint32_t index,
+                  igl::IBuffer* buffer,
+                  size_t bufferOffset,
+                  size_t bufferSize) override {
+    commands.push_back({Type::BindBuffer, buffer, index, bufferOffset, bufferSize});
+  }
+  void bindVertexBuffer(uint32_t index, igl::IBuffer& buffer, size_t bufferOffset) override {
+    commands.push_back({Type::BindVertexBuffer, &buffer, index, bufferOffset});
+  }
+  void bindIndexBuffer(igl::IBuffer& buffer,
+                       igl::IndexFormat /*format*/,
+                       size_t bufferOffset) override {
+    commands.push_back({Type::BindIndexBuffer, &buffer, 0, bufferOffset});
+  }
+  void bindBytes(size_t index, uint8_t /*target*/, const void* data, size_t length) override {
+    commands.push_back({Type::BindBytes, data, index, 0, length});
+  }
+  void bindPushConstants(const void* /*data*/, size_t /*length*/, size_t /*offset*/) override {}
+  void bindSamplerState(size_t /*index*/,
+                        uint8_t /*target*/,
+                        igl::ISamplerState* /*samplerState*/) override {}
+  void bindTexture(size_t /*index*/, uint8_t /*target*/, igl::ITexture* /*texture*/) override {}
+  void bindUniform(const igl::UniformDesc& uniformDesc, const void* data) override {
+    commands.push_back({Type::BindUniform, data, static_cast<size_t>(uniformDesc.location)});
+  }
+  void bindBindGroup(igl::BindGroupTextureHandle /*handle*/) override {}
+  void bindBindGroup(igl::BindGroupBufferHandle /*handle*/,
+                     uint32_t /*numDynamicOffsets*/,
+                     const uint32_t* /*dynamicOffsets*/) override {}
+
+  void draw(size_t vertexCount,
+            uint32_t instanceCount,
+            uint32_t firstVertex,
+            uint32_t /*baseInstance*/) override {
+    commands.push_back({Type::Draw, nullptr, 0, firstVertex, vertexCount, instanceCount});
+  }
+  void drawIndexed(size_t indexCount,
+                   uint32_t instanceCount,
+                   uint32_t firstIndex,
+                   int32_t /*vertexOffset*/,
+                   uint32_t /*baseInstance*/) override {
+    commands.push_back({Type::DrawIndexed, nullptr, 0, firstIndex, indexCount, instanceCount});
+  }
+  void multiDrawIndirect(igl::IBuffer& /*indirectBuffer*/,
+                         size_t /*indirectBufferOffset*/,
+                         uint32_t /*drawCount*/,
+                         uint32_t /*stride*/) override {}
+  void multiDrawIndexedIndirect(igl::IBuffer& /*indirectBuffer*/,
+                                size_t /*indirectBufferOffset*/,
+                                uint32_t /*drawCount*/,
+                                uint32_t /*stride*/) override {}
+
+  void setStencilReferenceValue(uint32_t /*value*/) override {}
+  void setBlendColor(const igl::Color& /*color*/) override {}
+  void setDepthBias(float /*depthBias*/, float /*slopeScale*/, float /*clamp*/) override {}
+
+  std::vector<Command> commands;
+};
+
+} // namespace iglu::tests
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../data/ShaderData.h"
+#include "../util/Common.h"
+#include "RecordingRenderCommandEncoder.h"
+
+#include <IGLU/simple_renderer/DirtyRange.h>
+#include <IGLU/simple_renderer/ShaderUniforms.h>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <memory>
+#include <vector>
+#if IGL_BACKEND_OPENGL
+#include <igl/opengl/Device.h>
+#endif // IGL_BACKEND_OPENGL
+
+namespace igl::tests {
+
+using iglu::material::DirtyRange;
+using iglu::material::ShaderUniforms;
+using iglu::tests::RecordingRenderCommandEncoder;
+using Type = RecordingRenderCommandEncoder::Type;
+
+TEST(DirtyRangeTest, AddAndTake) {
+  DirtyRange range(48);
+  EXPECT_EQ(range.begin(), 0u);
+  EXPECT_EQ(range.end(), 48u);
+
+  auto taken = range.take(0, 48);
+  EXPECT_EQ(taken.begin(), 0u);
+  EXPECT_EQ(taken.end(), 48u);
+  EXPECT_TRUE(range.empty());
+  EXPECT_TRUE(range.take(0, 48).empty());
+
+  range.add(20, 4);
+  range.add(8, 4);
+  range.add(8, 0);
+  EXPECT_EQ(range.begin(), 8u);
+  EXPECT_EQ(range.end(), 24u);
+}
+
+TEST(DirtyRangeTest, TakeSpanningSuballocations) {
+  // Writes to two 64 byte suballocations are cleared once both have been taken
+  DirtyRange range;
+  range.add(16, 16);
+  range.add(96, 16);
+
+  auto taken = range.take(0, 64);
+  EXPECT_EQ(taken.begin(), 16u);
+  EXPECT_EQ(taken.end(), 64u);
+  EXPECT_EQ(range.begin(), 64u);
+  EXPECT_EQ(range.end(), 112u);
+
+  taken = range.take(64, 64);
+  EXPECT_EQ(taken.begin(), 64u);
+  EXPECT_EQ(taken.end(), 112u);
+  EXPECT_TRUE(range.empty());
+
+  // Taking from the end trims it as well
+  range.add(16, 96);
+  taken = range.take(64, 64);
+  EXPECT_EQ(taken.begin(), 64u);
+  EXPECT_EQ(taken.end(), 112u);
+  EXPECT_EQ(range.begin(), 16u);
+  EXPECT_EQ(range.end(), 64u);
+
+  // Taking from the middle leaves the whole range dirty
+  range.add(128, 64);
+  taken = range.take(64, 64);
+  EXPECT_EQ(taken.begin(), 64u);
+  EXPECT_EQ(taken.end(), 128u);
+  EXPECT_EQ(range.begin(), 16u);
+  EXPECT_EQ(range.end(), 192u);
+}
+
+class ShaderUniformsTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    std::shared_ptr<ICommandQueue> cmdQueue;
+    util::createDeviceAndQueue(iglDev_, cmdQueue);
+    ASSERT_TRUE(iglDev_ != nullptr);
+
+    // The shader declares two uniform blocks and a uniform outside of any block
+    bool isGles3 = false;
+#if IGL_BACKEND_OPENGL
+    if (iglDev_->getBackendType() == BackendType::OpenGL) {
+      const auto& context = static_cast<opengl::Device&>(*iglDev_).getContext();
+      isGles3 = opengl::DeviceFeatureSet::usesOpenGLES() &&
+                context.deviceFeatures().getGLVersion() >= opengl::GLVersion::v3_0_ES;
+    }
+#endif // IGL_BACKEND_OPENGL
+    if (!isGles3) {
+      GTEST_SKIP() << "Requires OpenGL ES 3";
+    }
+
+    std::unique_ptr<IShaderStages> stages;
+    util::createShaderStages(iglDev_,
+                             data::shader::OGL_SIMPLE_VERT_SHADER_UNIFORM_BLOCKS,
+                             "vertexShader",
+                             data::shader::OGL_SIMPLE_FRAG_SHADER_UNIFORM_BLOCKS,
+                             "fragmentShader",
+                             stages);
+    ASSERT_TRUE(stages != nullptr);
+
+    VertexInputStateDesc inputDesc;
+    inputDesc.attributes[0].format = VertexAttributeFormat::Float4;
+    inputDesc.attributes[0].offset = 0;
+    inputDesc.attributes[0].location = 0;
+    inputDesc.attributes[0].bufferIndex = data::shader::simplePosIndex;
+    inputDesc.attributes[0].name = data::shader::simplePos;
+    inputDesc.inputBindings[0].stride = sizeof(float) * 4;
+    inputDesc.numAttributes = inputDesc.numInputBindings = 1;
+
+    Result ret;
+    RenderPipelineDesc pipelineDesc;
+    pipelineDesc.vertexInputState = iglDev_->createVertexInputState(inputDesc, &ret);
+    ASSERT_TRUE(ret.isOk());
+    pipelineDesc.shaderStages = std::move(stages);
+    pipelineDesc.targetDesc.colorAttachments.resize(1);
+    pipelineDesc.targetDesc.colorAttachments[0].textureFormat = TextureFormat::RGBA_UNorm8;
+    pipelineState_ = iglDev_->createRenderPipeline(pipelineDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message;
+  }
+
+  std::unique_ptr<ShaderUniforms> createUniforms() {
+    return std::make_unique<ShaderUniforms>(*iglDev_,
+                                            *pipelineState_->renderPipelineReflection());
+  }
+
+  // Reads back the contents of the uniform block buffer bound by 'encoder'
+  std::vector<uint8_t> boundBlockContents(const RecordingRenderCommandEncoder& encoder,
+                                          size_t blockSize) {
+    for (const auto& command : encoder.ofType(Type::BindBuffer)) {
+      auto* buffer = static_cast<IBuffer*>(const_cast<void*>(command.object));
+      if (buffer->getSizeInBytes() != blockSize) {
+        continue;
+      }
+      Result ret;
+      const auto* data = static_cast<const uint8_t*>(buffer->map(BufferRange(blockSize), &ret));
+      EXPECT_TRUE(ret.isOk()) << ret.message;
+      std::vector<uint8_t> contents(data, data + blockSize);
+      buffer->unmap();
+      return contents;
+    }
+    ADD_FAILURE() << "Uniform block buffer not bound";
+    return {};
+  }
+
+ protected:
+  // block_with_instance_name holds a vec3 and a vec4[2] in std140 layout
+  static constexpr size_t kBlockSize = 48;
+  static constexpr size_t kTestArrayOffset = 16;
+
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<IRenderPipelineState> pipelineState_;
+};
+
+TEST_F(ShaderUniformsTest, HandleSetters) {
+  auto uniforms = createUniforms();
+  const auto blockType = genNameHandle("block_with_instance_name");
+  const auto blockInstance = genNameHandle("matrices");
+  const auto testArray = genNameHandle("testArray");
+
+  const auto handle = uniforms->getUniformHandle(blockType, blockInstance, testArray);
+  ASSERT_TRUE(handle.isValid());
+  EXPECT_FALSE(uniforms->getUniformHandle(genNameHandle("missing")).isValid());
+  EXPECT_FALSE(
+      uniforms->getUniformHandle(blockType, blockInstance, genNameHandle("missing")).isValid());
+  const auto boolHandle = uniforms->getUniformHandle(genNameHandle("non_uniform_block_bool"));
+  ASSERT_TRUE(boolHandle.isValid());
+
+  const iglu::simdtypes::float4 values[2] = {{1.0f, 2.0f, 3.0f, 4.0f}, {5.0f, 6.0f, 7.0f, 8.0f}};
+  uniforms->setFloat4Array(handle, values, 2);
+  uniforms->setBool(boolHandle, true);
+
+  // Writes through handles match those through names
+  auto namedUniforms = createUniforms();
+  namedUniforms->setFloat4Array(blockType, blockInstance, testArray, values, 2);
+  namedUniforms->setBool(genNameHandle("non_uniform_block_bool"), true);
+
+  RecordingRenderCommandEncoder encoder;
+  uniforms->bind(*iglDev_, *pipelineState_, encoder);
+  RecordingRenderCommandEncoder namedEncoder;
+  namedUniforms->bind(*iglDev_, *pipelineState_, namedEncoder);
+
+  const auto contents = boundBlockContents(encoder, kBlockSize);
+  ASSERT_EQ(contents.size(), kBlockSize);
+  EXPECT_EQ(std::memcmp(contents.data() + kTestArrayOffset, values, sizeof(values)), 0);
+  const auto namedContents = boundBlockContents(namedEncoder, kBlockSize);
+  ASSERT_EQ(namedContents.size(), kBlockSize);
+  EXPECT_EQ(std::memcmp(contents.data() + kTestArrayOffset,
+                        namedContents.data() + kTestArrayOffset,
+                        sizeof(values)),
+            0);
+
+  const auto boolBinds = encoder.ofType(Type::BindUniform);
+  const auto namedBoolBinds = namedEncoder.ofType(Type::BindUniform);
+  ASSERT_EQ(boolBinds.size(), 1u);
+  ASSERT_EQ(namedBoolBinds.size(), 1u);
+  EXPECT_EQ(*static_cast<const bool*>(boolBinds[0].object), true);
+  EXPECT_EQ(std::memcmp(boolBinds[0].object, namedBoolBinds[0].object, sizeof(bool)), 0);
+}
+
+TEST_F(ShaderUniformsTest, DirtyRangeUploads) {
+  auto uniforms = createUniforms();
+  const auto handle = uniforms->getUniformHandle(genNameHandle("block_with_instance_name"),
+                                                 genNameHandle("matrices"),
+                                                 genNameHandle("testArray"));
+  ASSERT_TRUE(handle.isValid());
+  const iglu::simdtypes::float4 values[2] = {{1.0f, 2.0f, 3.0f, 4.0f}, {5.0f, 6.0f, 7.0f, 8.0f}};
+  uniforms->setFloat4Array(handle, values, 2);
+
+  RecordingRenderCommandEncoder encoder;
+  uniforms->bind(*iglDev_, *pipelineState_, encoder);
+  auto contents = boundBlockContents(encoder, kBlockSize);
+  ASSERT_EQ(contents.size(), kBlockSize);
+  EXPECT_EQ(std::memcmp(contents.data() + kTestArrayOffset, values, sizeof(values)), 0);
+
+  // Overwrite the GPU copy behind the uniforms' back to see which bytes the next binds upload
+  IBuffer* buffer = nullptr;
+  for (const auto& command : encoder.ofType(Type::BindBuffer)) {
+    auto* bound = static_cast<IBuffer*>(const_cast<void*>(command.object));
+    if (bound->getSizeInBytes() == kBlockSize) {
+      buffer = bound;
+    }
+  }
+  ASSERT_TRUE(buffer != nullptr);
+  const std::vector<uint8_t> garbage(kBlockSize, 0xAB);
+  ASSERT_TRUE(buffer->upload(garbage.data(), BufferRange(kBlockSize)).isOk());
+
+  // Nothing was written, so nothing is uploaded
+  encoder.commands.clear();
+  uniforms->bind(*iglDev_, *pipelineState_, encoder);
+  EXPECT_EQ(boundBlockContents(encoder, kBlockSize), garbage);
+
+  // Only the written element is uploaded
+  const iglu::simdtypes::float4 value = {9.0f, 10.0f, 11.0f, 12.0f};
+  uniforms->setFloat4(handle, value, 1);
+  encoder.commands.clear();
+  uniforms->bind(*iglDev_, *pipelineState_, encoder);
+  contents = boundBlockContents(encoder, kBlockSize);
+  ASSERT_EQ(contents.size(), kBlockSize);
+  const size_t valueOffset = kTestArrayOffset + sizeof(value);
+  EXPECT_EQ(std::memcmp(contents.data() + valueOffset, &value, sizeof(value)), 0);
+  EXPECT_TRUE(std::equal(contents.begin(), contents.begin() + valueOffset, garbage.begin()));
+}
+
+} // namespace igl::tests
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "../data/ShaderData.h"
+#include "../util/Common.h"
+
+#include <IGLU/simple_renderer/Drawable.h>
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <memory>
+#include <vector>
+
+namespace igl::tests {
+
+/// Base fixture for the simple_renderer tests. Creates a test device and a shader program, and
+/// makes vertex data, materials and drawables with it.
+class SimpleRendererTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    std::shared_ptr<ICommandQueue> cmdQueue;
+    util::createDeviceAndQueue(iglDev_, cmdQueue);
+    ASSERT_TRUE(iglDev_ != nullptr);
+
+    std::unique_ptr<IShaderStages> stages;
+    util::createSimpleShaderStages(iglDev_, stages);
+    ASSERT_TRUE(stages != nullptr);
+
+    VertexInputStateDesc inputDesc;
+    inputDesc.attributes[0].format = VertexAttributeFormat::Float4;
+    inputDesc.attributes[0].offset = 0;
+    inputDesc.attributes[0].location = 0;
+    inputDesc.attributes[0].bufferIndex = data::shader::simplePosIndex;
+    inputDesc.attributes[0].name = data::shader::simplePos;
+    inputDesc.inputBindings[0].stride = sizeof(float) * 4;
+    inputDesc.attributes[1].format = VertexAttributeFormat::Float2;
+    inputDesc.attributes[1].offset = 0;
+    inputDesc.attributes[1].location = 1;
+    inputDesc.attributes[1].bufferIndex = data::shader::simpleUvIndex;
+    inputDesc.attributes[1].name = data::shader::simpleUv;
+    inputDesc.inputBindings[1].stride = sizeof(float) * 2;
+    inputDesc.numAttributes = inputDesc.numInputBindings = 2;
+
+    Result ret;
+    vertexInputState_ = iglDev_->createVertexInputState(inputDesc, &ret);
+    ASSERT_TRUE(ret.isOk());
+
+    shaderProgram_ = std::make_shared<iglu::material::ShaderProgram>(
+        *iglDev_, std::move(stages), vertexInputState_, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message;
+
+    vertexBuffer_ = iglDev_->createBuffer(
+        BufferDesc(BufferDesc::BufferTypeBits::Vertex, nullptr, 256), &ret);
+    ASSERT_TRUE(ret.isOk());
+
+    pipelineDesc_.targetDesc.colorAttachments.resize(1);
+    pipelineDesc_.targetDesc.colorAttachments[0].textureFormat = TextureFormat::RGBA_UNorm8;
+    pipelineDescKey_ = std::hash<RenderPipelineDesc>()(pipelineDesc_);
+  }
+
+  // Each vertex data draws a distinct number of vertices, which identifies it in the draws
+  std::shared_ptr<iglu::vertexdata::VertexData> createVertexData(
+      size_t numVertices,
+      WindingMode winding = WindingMode::CounterClockwise) {
+    iglu::vertexdata::PrimitiveDesc primitiveDesc;
+    primitiveDesc.numEntries = numVertices;
+    primitiveDesc.frontFaceWinding = winding;
+    return std::make_shared<iglu::vertexdata::VertexData>(
+        vertexInputState_, vertexBuffer_, nullptr, IndexFormat::UInt16, primitiveDesc);
+  }
+
+  std::shared_ptr<iglu::material::Material> createMaterial(
+      const iglu::material::BlendMode& blendMode = iglu::material::BlendMode::Opaque()) {
+    auto material = std::make_shared<iglu::material::Material>(*iglDev_);
+    material->setShaderProgram(*iglDev_, shaderProgram_);
+    material->blendMode = blendMode;
+    return material;
+  }
+
+  iglu::drawable::Drawable& createDrawable(
+      std::shared_ptr<iglu::vertexdata::VertexData> vertexData,
+      std::shared_ptr<iglu::material::Material> material) {
+    drawables_.push_back(
+        std::make_unique<iglu::drawable::Drawable>(std::move(vertexData), std::move(material)));
+    return *drawables_.back();
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<IVertexInputState> vertexInputState_;
+  std::shared_ptr<iglu::material::ShaderProgram> shaderProgram_;
+  std::shared_ptr<IBuffer> vertexBuffer_;
+  RenderPipelineDesc pipelineDesc_;
+  size_t pipelineDescKey_ = 0;
+  iglu::drawable::PipelineCache pipelineCache_;
+  std::vector<std::unique_ptr<iglu::drawable::Drawable>> drawables_;
+};
+
+} // namespace igl::tests
@@ -11,8 +11,10 @@
 
 #include <IGLU/state_pool/RenderPipelineStatePool.h>
 #include <gtest/gtest.h>
+#include <igl/Hash.h>
 #include <igl/IGL.h>
 #include <igl/NameHandle.h>
+#include <sstream>
 #include <string>
 
 namespace igl::tests {
@@ -203,4 +205,173 @@ TEST_F(StatePoolTest, renderPipelineDescCachingLRU1) {
   renderPipelineDesc3_.cullMode = renderPipelineDesc1_.cullMode; // restore change
 }
 
+//
+// concurrentRenderPipelineDescCaching Test
+//
+// Tests to see if ConcurrentRenderPipelineStatePool caching works
+//
+TEST_F(StatePoolTest, concurrentRenderPipelineDescCaching) {
+  Result ret;
+  iglu::state_pool::ConcurrentRenderPipelineStatePool pool;
+
+  auto ps1 = pool.getOrCreate(*iglDev_, renderPipelineDesc1_, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_TRUE(ps1 != nullptr);
+
+  auto ps2 = pool.getOrCreate(*iglDev_, renderPipelineDesc2_, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_TRUE(ps1 == ps2);
+
+  renderPipelineDesc2_.cullMode = igl::CullMode::Front;
+  ps2 = pool.getOrCreate(*iglDev_, renderPipelineDesc2_, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_TRUE(ps2 != nullptr);
+  ASSERT_TRUE(ps1 != ps2);
+  ASSERT_EQ(pool.size(), 2u);
+
+  renderPipelineDesc2_.cullMode = renderPipelineDesc1_.cullMode; // restore change
+}
+
+//
+// concurrentRenderPipelineDescCachingLRU Test
+//
+// Tests to see if ConcurrentRenderPipelineStatePool releases the least recently used states
+//
+TEST_F(StatePoolTest, concurrentRenderPipelineDescCachingLRU) {
+  Result ret;
+  iglu::state_pool::ConcurrentRenderPipelineStatePool pool(2, 1);
+  renderPipelineDesc2_.cullMode = igl::CullMode::Front;
+  renderPipelineDesc3_.cullMode = igl::CullMode::Back;
+
+  auto ps1 = pool.getOrCreate(*iglDev_, renderPipelineDesc1_, &ret);
+  auto ps2 = pool.getOrCreate(*iglDev_, renderPipelineDesc2_, &ret);
+  // Use renderPipelineDesc1_ again so renderPipelineDesc2_ becomes the least recently used
+  ASSERT_TRUE(pool.getOrCreate(*iglDev_, renderPipelineDesc1_, &ret) == ps1);
+
+  auto ps3 = pool.getOrCreate(*iglDev_, renderPipelineDesc3_, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_TRUE(ps3 != nullptr);
+  ASSERT_EQ(pool.size(), 2u);
+
+  ASSERT_TRUE(pool.getOrCreate(*iglDev_, renderPipelineDesc1_, &ret) == ps1);
+  ASSERT_TRUE(pool.getOrCreate(*iglDev_, renderPipelineDesc2_, &ret) != ps2);
+
+  renderPipelineDesc2_.cullMode = renderPipelineDesc1_.cullMode; // restore change
+  renderPipelineDesc3_.cullMode = renderPipelineDesc1_.cullMode; // restore change
+}
+
+//
+// concurrentRenderPipelineDescPrewarm Test
+//
+// Tests to see if descriptor hashes recorded by one pool prewarm another
+//
+TEST_F(StatePoolTest, concurrentRenderPipelineDescPrewarm) {
+  Result ret;
+  renderPipelineDesc2_.cullMode = igl::CullMode::Front;
+  renderPipelineDesc3_.cullMode = igl::CullMode::Back;
+
+  std::stringstream hashes;
+  {
+    iglu::state_pool::ConcurrentRenderPipelineStatePool pool;
+    pool.getOrCreate(*iglDev_, renderPipelineDesc1_, &ret);
+    ASSERT_EQ(ret.code, Result::Code::Ok);
+    pool.getOrCreate(*iglDev_, renderPipelineDesc2_, &ret);
+    ASSERT_EQ(ret.code, Result::Code::Ok);
+    pool.writeDescriptorHashes(hashes);
+  }
+
+  iglu::state_pool::ConcurrentRenderPipelineStatePool pool;
+  const auto seenHashes =
+      iglu::state_pool::ConcurrentRenderPipelineStatePool::readDescriptorHashes(hashes);
+  ASSERT_EQ(seenHashes.size(), 2u);
+  ASSERT_EQ(pool.prewarm(*iglDev_, {renderPipelineDesc1_, renderPipelineDesc3_}, seenHashes), 1u);
+  ASSERT_EQ(pool.size(), 1u);
+
+  renderPipelineDesc2_.cullMode = renderPipelineDesc1_.cullMode; // restore change
+  renderPipelineDesc3_.cullMode = renderPipelineDesc1_.cullMode; // restore change
+}
+
+//
+// concurrentRenderPipelineDescRecordedHashesLimit Test
+//
+// Tests that a pool stops recording descriptor hashes once it has recorded maxRecordedHashes
+//
+TEST_F(StatePoolTest, concurrentRenderPipelineDescRecordedHashesLimit) {
+  Result ret;
+  renderPipelineDesc2_.cullMode = igl::CullMode::Front;
+
+  iglu::state_pool::ConcurrentRenderPipelineStatePool pool(16, 1, 1);
+  pool.getOrCreate(*iglDev_, renderPipelineDesc1_, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  pool.getOrCreate(*iglDev_, renderPipelineDesc2_, &ret);
+  ASSERT_EQ(ret.code, Result::Code::Ok);
+  ASSERT_EQ(pool.size(), 2u);
+
+  std::stringstream hashes;
+  pool.writeDescriptorHashes(hashes);
+  const auto seenHashes =
+      iglu::state_pool::ConcurrentRenderPipelineStatePool::readDescriptorHashes(hashes);
+  ASSERT_EQ(seenHashes.size(), 1u);
+
+  renderPipelineDesc2_.cullMode = renderPipelineDesc1_.cullMode; // restore change
+}
+
+//
+// persistentShaderStagesHash Test
+//
+// Tests that stages hash by the source of their modules rather than by their addresses
+//
+TEST_F(StatePoolTest, persistentShaderStagesHash) {
+  std::unique_ptr<IShaderStages> stages;
+  igl::tests::util::createSimpleShaderStages(iglDev_, stages);
+  ASSERT_TRUE(stages != nullptr);
+  ASSERT_NE(stages.get(), shaderStages_.get());
+  ASSERT_EQ(iglu::state_pool::persistentShaderStagesHash(stages.get()),
+            iglu::state_pool::persistentShaderStagesHash(shaderStages_.get()));
+  ASSERT_EQ(iglu::state_pool::persistentShaderStagesHash(nullptr), 0u);
+
+  // Sources sharing an entry point differ by their input hash
+  const auto desc1 = ShaderModuleDesc::fromStringInput(
+      "void main() {}", {ShaderStage::Fragment, "main"}, "shader");
+  const auto desc2 = ShaderModuleDesc::fromStringInput(
+      "void main() { }", {ShaderStage::Fragment, "main"}, "shader");
+  ASSERT_NE(desc1.info.inputHash, 0u);
+  ASSERT_NE(desc1.info.inputHash, desc2.info.inputHash);
+  ASSERT_EQ(desc1.info.inputHash,
+            ShaderModuleDesc::fromStringInput(
+                "void main() {}", {ShaderStage::Fragment, "main"}, "other")
+                .info.inputHash);
+}
+
+//
+// persistentHashCombine Test
+//
+// Tests that persistent hashes depend on the order values are added in, but not on the iteration
+// order of binding maps
+//
+TEST(StatePoolHashTest, persistentHashCombine) {
+  ASSERT_NE(Fnv1aHasher().add(1).add(2).value(), Fnv1aHasher().add(2).add(1).value());
+  // Both pairs XOR to the same value
+  ASSERT_NE(Fnv1aHasher().add(CullMode::Front).add(WindingMode::Clockwise).value(),
+            Fnv1aHasher().add(CullMode::Disabled).add(WindingMode::CounterClockwise).value());
+  ASSERT_NE(Fnv1aHasher().add("ab").add("c").value(), Fnv1aHasher().add("a").add("bc").value());
+
+  std::unordered_map<size_t, NameHandle> ascending;
+  std::unordered_map<size_t, NameHandle> descending;
+  for (size_t i = 0; i != 32; ++i) {
+    ascending[i] = genNameHandle("sampler" + std::to_string(i));
+    descending[31 - i] = genNameHandle("sampler" + std::to_string(31 - i));
+  }
+  Fnv1aHasher ascendingHasher;
+  Fnv1aHasher descendingHasher;
+  iglu::state_pool::addPersistentHash(ascendingHasher, ascending);
+  iglu::state_pool::addPersistentHash(descendingHasher, descending);
+  ASSERT_EQ(ascendingHasher.value(), descendingHasher.value());
+
+  descending[0] = genNameHandle("other");
+  Fnv1aHasher otherHasher;
+  iglu::state_pool::addPersistentHash(otherHasher, descending);
+  ASSERT_NE(ascendingHasher.value(), otherHasher.value());
+}
+
 } // namespace igl::tests
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../util/Common.h"
+
+#include <IGLU/texture_atlas/TextureAtlas.h>
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <vector>
+
+namespace igl::tests {
+
+namespace {
+
+bool overlaps(const iglu::textureatlas::AtlasRegion& a, const iglu::textureatlas::AtlasRegion& b) {
+  return a.page == b.page && a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height &&
+         b.y < a.y + a.height;
+}
+
+} // namespace
+
+class TextureAtlasTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_NE(iglDev_, nullptr);
+  }
+
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+};
+
+TEST_F(TextureAtlasTest, PacksWithoutOverlap) {
+  iglu::textureatlas::TextureAtlasDesc desc;
+  desc.pageWidth = 64;
+  desc.pageHeight = 64;
+  iglu::textureatlas::TextureAtlas atlas(*iglDev_, desc);
+
+  const std::vector<uint32_t> pixels(12 * 12, 0xFF00FF00);
+  std::vector<iglu::textureatlas::AtlasHandle> handles;
+  for (uint32_t size = 4; size <= 12; size += 4) {
+    for (int i = 0; i < 3; ++i) {
+      Result ret;
+      handles.push_back(atlas.add(size, size, pixels.data(), size * 4u, &ret));
+      ASSERT_TRUE(ret.isOk()) << ret.message;
+      ASSERT_NE(handles.back(), 0u);
+    }
+  }
+  ASSERT_EQ(atlas.numImages(), handles.size());
+  ASSERT_EQ(atlas.numPages(), 1u);
+  ASSERT_NE(atlas.getTexture(), nullptr);
+  ASSERT_EQ(atlas.getTexture()->getType(), TextureType::TwoDArray);
+
+  for (size_t i = 0; i < handles.size(); ++i) {
+    const auto* region = atlas.getRegion(handles[i]);
+    ASSERT_NE(region, nullptr);
+    // Padding keeps images off the page edges
+    ASSERT_GE(region->x, desc.padding);
+    ASSERT_GE(region->y, desc.padding);
+    ASSERT_LE(region->x + region->width + desc.padding, desc.pageWidth);
+    ASSERT_FLOAT_EQ(region->u0, static_cast<float>(region->x) / 64.0f);
+    ASSERT_FLOAT_EQ(region->v1, static_cast<float>(region->y + region->height) / 64.0f);
+    for (size_t j = 0; j < i; ++j) {
+      ASSERT_FALSE(overlaps(*region, *atlas.getRegion(handles[j])));
+    }
+  }
+}
+
+TEST_F(TextureAtlasTest, ReusesRemovedSpace) {
+  iglu::textureatlas::TextureAtlasDesc desc;
+  desc.pageWidth = 32;
+  desc.pageHeight = 32;
+  desc.maxPages = 1;
+  desc.padding = 0;
+  iglu::textureatlas::TextureAtlas atlas(*iglDev_, desc);
+
+  const std::vector<uint32_t> pixels(16 * 16, 0xFFFFFFFF);
+  iglu::textureatlas::AtlasHandle handles[4] = {};
+  for (auto& handle : handles) {
+    handle = atlas.add(16, 16, pixels.data());
+    ASSERT_NE(handle, 0u);
+  }
+
+  Result ret;
+  ASSERT_EQ(atlas.add(16, 16, pixels.data(), 0, &ret), 0u);
+  ASSERT_FALSE(ret.isOk());
+
+  const auto removedRegion = *atlas.getRegion(handles[2]);
+  atlas.remove(handles[2]);
+  ASSERT_EQ(atlas.getRegion(handles[2]), nullptr);
+
+  // The freed rectangle is split to fit smaller images
+  const auto small = atlas.add(8, 8, pixels.data(), 0, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  ASSERT_EQ(atlas.getRegion(small)->x, removedRegion.x);
+  ASSERT_EQ(atlas.getRegion(small)->y, removedRegion.y);
+  ASSERT_NE(atlas.add(8, 8, pixels.data()), 0u);
+  ASSERT_NE(atlas.add(8, 8, pixels.data()), 0u);
+  ASSERT_NE(atlas.add(8, 8, pixels.data()), 0u);
+  ASSERT_EQ(atlas.add(8, 8, pixels.data()), 0u);
+}
+
+TEST_F(TextureAtlasTest, AddsPages) {
+  iglu::textureatlas::TextureAtlasDesc desc;
+  desc.pageWidth = 16;
+  desc.pageHeight = 16;
+  desc.maxPages = 2;
+  desc.padding = 0;
+  desc.useArrayTexture = false;
+  iglu::textureatlas::TextureAtlas atlas(*iglDev_, desc);
+
+  const std::vector<uint32_t> pixels(16 * 16, 0xFFFFFFFF);
+  const auto first = atlas.add(16, 16, pixels.data());
+  const auto second = atlas.add(16, 16, pixels.data());
+  ASSERT_NE(first, 0u);
+  ASSERT_NE(second, 0u);
+  ASSERT_EQ(atlas.add(1, 1, pixels.data()), 0u);
+
+  ASSERT_EQ(atlas.numPages(), 2u);
+  ASSERT_EQ(atlas.getRegion(second)->page, 1u);
+  ASSERT_NE(atlas.getTexture(0), atlas.getTexture(1));
+  ASSERT_EQ(atlas.getTexture(1)->getType(), TextureType::TwoD);
+  ASSERT_EQ(atlas.getTexture(2), nullptr);
+
+  Result ret;
+  ASSERT_EQ(atlas.add(17, 1, pixels.data(), 0, &ret), 0u);
+  ASSERT_EQ(ret.code, Result::Code::ArgumentOutOfRange);
+}
+
+TEST_F(TextureAtlasTest, AlignsForMipmaps) {
+  iglu::textureatlas::TextureAtlasDesc desc;
+  desc.pageWidth = 64;
+  desc.pageHeight = 64;
+  desc.numMipLevels = 3;
+  desc.padding = 1;
+  iglu::textureatlas::TextureAtlas atlas(*iglDev_, desc);
+
+  const std::vector<uint32_t> pixels(5 * 5, 0xFF0000FF);
+  for (int i = 0; i < 4; ++i) {
+    Result ret;
+    const auto handle = atlas.add(5, 5, pixels.data(), 0, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message;
+    const auto* region = atlas.getRegion(handle);
+    // Allocations start on a 4 pixel grid so each mip level of an image covers whole texels
+    ASSERT_EQ((region->x - desc.padding) % 4u, 0u);
+    ASSERT_EQ((region->y - desc.padding) % 4u, 0u);
+  }
+  ASSERT_EQ(atlas.getTexture()->getNumMipLevels(), 3u);
+}
+
+} // namespace igl::tests
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../util/Common.h"
+
+#include <IGLU/texture_loader/ktx1/Header.h>
+#include <IGLU/texture_loader/ktx1/TextureLoaderFactory.h>
+#include <IGLU/texture_streamer/TextureStreamer.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <thread>
+#include <vector>
+
+namespace igl::tests {
+
+namespace {
+
+// Builds an uncompressed RGBA8 KTX1 file with `numMipLevels` mip levels. With 0 mip levels, only
+// the base level is stored and the mipmaps are generated when it is uploaded.
+std::unique_ptr<iglu::textureloader::IData> createKtx1Data(uint32_t width,
+                                                           uint32_t height,
+                                                           uint32_t numMipLevels) {
+  iglu::textureloader::ktx1::Header header{};
+  header.tag = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+  header.endianness = 0x04030201;
+  header.glType = 0x1401; // GL_UNSIGNED_BYTE
+  header.glTypeSize = 1;
+  header.glFormat = 0x1908; // GL_RGBA
+  header.glInternalFormat = 0x8058; // GL_RGBA8
+  header.glBaseInternalFormat = 0x1908; // GL_RGBA
+  header.pixelWidth = width;
+  header.pixelHeight = height;
+  header.numberOfFaces = 1;
+  header.numberOfMipmapLevels = numMipLevels;
+
+  const uint32_t numStoredMipLevels = std::max(numMipLevels, 1u);
+  uint32_t length = iglu::textureloader::ktx1::kHeaderLength;
+  for (uint32_t mipLevel = 0; mipLevel < numStoredMipLevels; ++mipLevel) {
+    length += 4u + std::max(width >> mipLevel, 1u) * std::max(height >> mipLevel, 1u) * 4u;
+  }
+
+  auto buffer = std::make_unique<uint8_t[]>(length);
+  std::memset(buffer.get(), 0x7F, length);
+  std::memcpy(buffer.get(), &header, sizeof(header));
+
+  uint32_t offset = iglu::textureloader::ktx1::kHeaderLength;
+  for (uint32_t mipLevel = 0; mipLevel < numStoredMipLevels; ++mipLevel) {
+    const uint32_t imageSize =
+        std::max(width >> mipLevel, 1u) * std::max(height >> mipLevel, 1u) * 4u;
+    std::memcpy(buffer.get() + offset, &imageSize, sizeof(imageSize));
+    offset += 4u + imageSize;
+  }
+
+  return iglu::textureloader::IData::tryCreate(std::move(buffer), length, nullptr);
+}
+
+} // namespace
+
+class TextureStreamerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+  }
+
+  [[nodiscard]] std::unique_ptr<iglu::texturestreamer::TextureStreamer> createStreamer(
+      const iglu::texturestreamer::TextureStreamerDesc& desc) const {
+    return std::make_unique<iglu::texturestreamer::TextureStreamer>(
+        *iglDev_, std::make_unique<iglu::textureloader::ktx1::TextureLoaderFactory>(), desc);
+  }
+
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+};
+
+//
+// HigherImportanceFirst
+//
+// Without worker threads, each update() decodes the most important queued texture.
+//
+TEST_F(TextureStreamerTest, HigherImportanceFirst) {
+  using iglu::texturestreamer::TextureState;
+
+  iglu::texturestreamer::TextureStreamerDesc desc;
+  desc.maxConcurrentDecodes = 0;
+  auto streamer = createStreamer(desc);
+
+  const auto low = streamer->request(createKtx1Data(4, 4, 1), {0.5f, 0});
+  const auto high = streamer->request(createKtx1Data(4, 4, 1), {2.0f, 0});
+
+  streamer->update(*cmdQueue_);
+  ASSERT_EQ(streamer->getState(high), TextureState::Resident);
+  ASSERT_EQ(streamer->getState(low), TextureState::Queued);
+  ASSERT_NE(streamer->getTexture(high), nullptr);
+  ASSERT_EQ(streamer->getTexture(low), nullptr);
+
+  streamer->update(*cmdQueue_);
+  ASSERT_EQ(streamer->getState(low), TextureState::Resident);
+
+  streamer->release(low);
+  ASSERT_EQ(streamer->getState(low), TextureState::Invalid);
+}
+
+//
+// InvalidData_Fails
+//
+TEST_F(TextureStreamerTest, InvalidData_Fails) {
+  iglu::texturestreamer::TextureStreamerDesc desc;
+  desc.maxConcurrentDecodes = 0;
+  auto streamer = createStreamer(desc);
+
+  auto buffer = std::make_unique<uint8_t[]>(128);
+  std::memset(buffer.get(), 0, 128);
+  const auto id =
+      streamer->request(iglu::textureloader::IData::tryCreate(std::move(buffer), 128, nullptr));
+
+  streamer->update(*cmdQueue_);
+  ASSERT_EQ(streamer->getState(id), iglu::texturestreamer::TextureState::Failed);
+  ASSERT_EQ(streamer->getTexture(id), nullptr);
+}
+
+//
+// PlaceholderUntilResident
+//
+// With a tiny upload budget, the small mip levels are uploaded into a placeholder first, and the
+// full texture is uploaded one mip level per update().
+//
+TEST_F(TextureStreamerTest, PlaceholderUntilResident) {
+  using iglu::texturestreamer::TextureState;
+
+  iglu::texturestreamer::TextureStreamerDesc desc;
+  desc.maxConcurrentDecodes = 0;
+  desc.uploadBudgetBytesPerFrame = 1;
+  desc.placeholderMaxDimension = 64;
+  auto streamer = createStreamer(desc);
+
+  const auto id = streamer->request(createKtx1Data(256, 256, 9));
+
+  streamer->update(*cmdQueue_);
+  ASSERT_EQ(streamer->getState(id), TextureState::Uploading);
+  auto placeholder = streamer->getTexture(id);
+  ASSERT_NE(placeholder, nullptr);
+  ASSERT_EQ(placeholder->getDimensions().width, 64u);
+
+  for (uint32_t i = 0; i < 9 && streamer->getState(id) != TextureState::Resident; ++i) {
+    ASSERT_GT(streamer->update(*cmdQueue_), 0u);
+  }
+  ASSERT_EQ(streamer->getState(id), TextureState::Resident);
+  auto texture = streamer->getTexture(id);
+  ASSERT_NE(texture, nullptr);
+  ASSERT_EQ(texture->getDimensions().width, 256u);
+  ASSERT_EQ(streamer->residentBytes(), texture->getEstimatedSizeInBytes());
+}
+
+//
+// GeneratedMipmapsWithinBudget
+//
+// The base level of a texture with generated mipmaps waits for the next update() when it doesn't
+// fit in what is left of the upload budget.
+//
+TEST_F(TextureStreamerTest, GeneratedMipmapsWithinBudget) {
+  using iglu::texturestreamer::TextureState;
+
+  iglu::texturestreamer::TextureStreamerDesc desc;
+  desc.maxConcurrentDecodes = 2;
+  desc.uploadBudgetBytesPerFrame = 1024;
+  auto streamer = createStreamer(desc);
+
+  // 64 bytes, uploaded first
+  const auto small = streamer->request(createKtx1Data(4, 4, 1), {2.0f, 0});
+  // 16 KiB base level, more than the whole budget
+  const auto large = streamer->request(createKtx1Data(64, 64, 0), {1.0f, 0});
+
+  // Both textures must be decoded before the first update() so that they share its budget
+  for (uint32_t i = 0; i < 10000 && (streamer->getState(small) != TextureState::Decoded ||
+                                     streamer->getState(large) != TextureState::Decoded);
+       ++i) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  ASSERT_EQ(streamer->getState(small), TextureState::Decoded);
+  ASSERT_EQ(streamer->getState(large), TextureState::Decoded);
+
+  ASSERT_EQ(streamer->update(*cmdQueue_), 64u);
+  ASSERT_EQ(streamer->getState(small), TextureState::Resident);
+  ASSERT_EQ(streamer->getState(large), TextureState::Decoded);
+
+  // Alone in the next update(), the base level is uploaded regardless of the budget
+  ASSERT_EQ(streamer->update(*cmdQueue_), 64u * 64u * 4u);
+  ASSERT_EQ(streamer->getState(large), TextureState::Resident);
+  auto texture = streamer->getTexture(large);
+  ASSERT_NE(texture, nullptr);
+  ASSERT_EQ(texture->getNumMipLevels(), 7u);
+}
+
+//
+// EvictsLeastRecentlyUsed
+//
+// Going over the memory budget evicts textures not used in the current frame; using an evicted
+// texture requests it again.
+//
+TEST_F(TextureStreamerTest, EvictsLeastRecentlyUsed) {
+  using iglu::texturestreamer::TextureState;
+
+  iglu::texturestreamer::TextureStreamerDesc desc;
+  desc.maxConcurrentDecodes = 0;
+  desc.memoryBudgetBytes = 100;
+  auto streamer = createStreamer(desc);
+
+  const auto first = streamer->request(createKtx1Data(4, 4, 1));
+  streamer->update(*cmdQueue_);
+  ASSERT_EQ(streamer->getState(first), TextureState::Resident);
+
+  const auto second = streamer->request(createKtx1Data(4, 4, 1));
+  streamer->update(*cmdQueue_);
+  ASSERT_EQ(streamer->getState(second), TextureState::Resident);
+  ASSERT_EQ(streamer->getState(first), TextureState::Evicted);
+  ASSERT_LE(streamer->residentBytes(), desc.memoryBudgetBytes);
+
+  ASSERT_EQ(streamer->getTexture(first), nullptr);
+  ASSERT_EQ(streamer->getState(first), TextureState::Queued);
+}
+
+//
+// ConcurrentDecodes
+//
+// Textures decoded on the shared WorkerPool while update() uploads others all become resident.
+//
+TEST_F(TextureStreamerTest, ConcurrentDecodes) {
+  using iglu::texturestreamer::TextureState;
+
+  iglu::texturestreamer::TextureStreamerDesc desc;
+  desc.maxConcurrentDecodes = 2;
+  desc.uploadBudgetBytesPerFrame = 1024;
+  auto streamer = createStreamer(desc);
+
+  std::vector<iglu::texturestreamer::TextureId> ids;
+  for (uint32_t i = 0; i < 16; ++i) {
+    ids.push_back(streamer->request(createKtx1Data(16, 16, 5), {static_cast<float>(i), 0}));
+  }
+
+  const auto allResident = [&]() {
+    return std::all_of(ids.begin(), ids.end(), [&](auto id) {
+      return streamer->getState(id) == TextureState::Resident;
+    });
+  };
+  for (uint32_t i = 0; i < 10000 && !allResident(); ++i) {
+    streamer->update(*cmdQueue_);
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  ASSERT_TRUE(allResident());
+
+  size_t residentBytes = 0;
+  for (const auto id : ids) {
+    auto texture = streamer->getTexture(id);
+    ASSERT_NE(texture, nullptr);
+    residentBytes += texture->getEstimatedSizeInBytes();
+  }
+  ASSERT_EQ(streamer->residentBytes(), residentBytes);
+}
+
+} // namespace igl::tests
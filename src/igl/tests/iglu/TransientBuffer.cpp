@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../util/Common.h"
+#include "RecordingRenderCommandEncoder.h"
+
+#include <IGLU/uniform/BlockLayout.h>
+#include <IGLU/uniform/Collection.h>
+#include <IGLU/uniform/CollectionEncoder.h>
+#include <IGLU/uniform/TransientBuffer.h>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <vector>
+
+namespace igl::tests {
+
+using iglu::tests::RecordingRenderCommandEncoder;
+using Type = RecordingRenderCommandEncoder::Type;
+
+//
+// TransientBufferTest
+//
+// Encodes a uniform block through CollectionEncoder into a TransientBuffer and checks the slices
+// it binds
+//
+class TransientBufferTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+
+    size_t alignment = 0;
+    if (iglDev_->getFeatureLimits(DeviceFeatureLimits::BufferAlignment, alignment) &&
+        alignment > 0) {
+      alignment_ = alignment;
+    }
+
+    collection_.set(genNameHandle("scale"), 2.0f);
+    collection_.set(genNameHandle("color"), glm::vec4(0.25f, 0.5f, 0.75f, 1.0f));
+    layout_ = iglu::uniform::BlockLayout::fromCollection(
+        collection_, {genNameHandle("scale"), genNameHandle("color")}, kBufferIndex);
+  }
+
+  // Reads back 'size' bytes at 'offset' of 'buffer'
+  std::vector<uint8_t> contents(IBuffer& buffer, size_t offset, size_t size) {
+    Result ret;
+    const auto* data = static_cast<const uint8_t*>(buffer.map(BufferRange(size, offset), &ret));
+    EXPECT_TRUE(ret.isOk()) << ret.message;
+    if (data == nullptr) {
+      return {};
+    }
+    std::vector<uint8_t> result(data, data + size);
+    buffer.unmap();
+    return result;
+  }
+
+ protected:
+  static constexpr int kBufferIndex = 2;
+
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  size_t alignment_ = 1;
+  iglu::uniform::Collection collection_;
+  iglu::uniform::BlockLayout layout_;
+};
+
+//
+// BindsAlignedSlices Test
+//
+// Each encode binds the buffer once, at the next aligned slice, holding the block's bytes
+//
+TEST_F(TransientBufferTest, BindsAlignedSlices) {
+  ASSERT_EQ(layout_.size, 32u);
+  iglu::uniform::TransientBuffer transientBuffer(*iglDev_);
+  const iglu::uniform::CollectionEncoder encoder(iglDev_->getBackendType());
+
+  RecordingRenderCommandEncoder first;
+  encoder(collection_, first, layout_, transientBuffer);
+  ASSERT_EQ(first.commands.size(), 1u);
+  ASSERT_EQ(first.count(Type::BindBuffer), 1u);
+  const auto firstBind = first.commands[0];
+  EXPECT_EQ(firstBind.object, &transientBuffer.buffer());
+  EXPECT_EQ(firstBind.index, static_cast<size_t>(kBufferIndex));
+  EXPECT_EQ(firstBind.offset, 0u);
+  EXPECT_EQ(firstBind.count, layout_.size);
+
+  RecordingRenderCommandEncoder second;
+  encoder(collection_, second, layout_, transientBuffer);
+  ASSERT_EQ(second.commands.size(), 1u);
+  const auto secondBind = second.commands[0];
+  EXPECT_EQ(secondBind.type, Type::BindBuffer);
+  EXPECT_EQ(secondBind.offset % alignment_, 0u);
+  EXPECT_EQ(secondBind.offset, (layout_.size + alignment_ - 1) / alignment_ * alignment_);
+  EXPECT_EQ(secondBind.count, layout_.size);
+
+  std::vector<uint8_t> expected(layout_.size, 0);
+  layout_.write(collection_, expected.data());
+  EXPECT_EQ(contents(transientBuffer.buffer(), firstBind.offset, layout_.size), expected);
+  EXPECT_EQ(contents(transientBuffer.buffer(), secondBind.offset, layout_.size), expected);
+}
+
+//
+// FullAndReset Test
+//
+// Nothing is bound once the buffer is full, and reset() starts over at the beginning
+//
+TEST_F(TransientBufferTest, FullAndReset) {
+  iglu::uniform::TransientBuffer transientBuffer(*iglDev_, layout_.size);
+  const iglu::uniform::CollectionEncoder encoder(iglDev_->getBackendType());
+
+  RecordingRenderCommandEncoder commandEncoder;
+  encoder(collection_, commandEncoder, layout_, transientBuffer);
+  ASSERT_EQ(commandEncoder.count(Type::BindBuffer), 1u);
+
+  // The next slice starts at or past the end of the buffer
+  encoder(collection_, commandEncoder, layout_, transientBuffer);
+  EXPECT_EQ(commandEncoder.count(Type::BindBuffer), 1u);
+
+  Result ret;
+  std::vector<uint8_t> data(layout_.size, 0);
+  EXPECT_EQ(transientBuffer.upload(data.data(), data.size(), &ret), 0u);
+  EXPECT_EQ(ret.code, Result::Code::ArgumentOutOfRange);
+  EXPECT_EQ(ret.message, "Transient buffer is full.");
+
+  transientBuffer.reset();
+  encoder(collection_, commandEncoder, layout_, transientBuffer);
+  const auto binds = commandEncoder.ofType(Type::BindBuffer);
+  ASSERT_EQ(binds.size(), 2u);
+  EXPECT_EQ(binds[1].offset, 0u);
+  EXPECT_EQ(binds[1].count, layout_.size);
+}
+
+} // namespace igl::tests
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/uniform/BlockLayout.h>
+#include <IGLU/uniform/Collection.h>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace iglu::tests {
+
+namespace {
+
+float readFloat(const std::vector<uint8_t>& data, size_t offset) {
+  float value = 0.0f;
+  std::memcpy(&value, data.data() + offset, sizeof(value));
+  return value;
+}
+
+uint32_t readUInt(const std::vector<uint8_t>& data, size_t offset) {
+  uint32_t value = 0;
+  std::memcpy(&value, data.data() + offset, sizeof(value));
+  return value;
+}
+
+} // namespace
+
+class UniformBlockLayoutTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    collection_.set(igl::genNameHandle("scale"), 2.0f);
+    collection_.set(igl::genNameHandle("position"), glm::vec3(1.0f, 2.0f, 3.0f));
+    collection_.set(igl::genNameHandle("enabled"), true);
+    glm::mat3 rotation(1.0f);
+    rotation[1][2] = 5.0f;
+    collection_.set(igl::genNameHandle("rotation"), rotation);
+    collection_.set(igl::genNameHandle("weights"), std::vector<float>{0.25f, 0.5f, 0.75f});
+
+    names_ = {igl::genNameHandle("scale"),
+              igl::genNameHandle("position"),
+              igl::genNameHandle("enabled"),
+              igl::genNameHandle("rotation"),
+              igl::genNameHandle("weights")};
+  }
+
+  uniform::Collection collection_;
+  std::vector<igl::NameHandle> names_;
+};
+
+//
+// Std140 Test
+//
+// Checks member offsets and the data written following std140 rules
+//
+TEST_F(UniformBlockLayoutTest, Std140) {
+  const auto layout = uniform::BlockLayout::fromCollection(
+      collection_, names_, 3, uniform::BlockLayout::Standard::Std140);
+  ASSERT_EQ(layout.bufferIndex, 3);
+  ASSERT_EQ(layout.members.size(), 5u);
+  EXPECT_EQ(layout.members[0].offset, 0u); // float
+  EXPECT_EQ(layout.members[1].offset, 16u); // vec3
+  EXPECT_EQ(layout.members[2].offset, 28u); // bool packed after the vec3
+  EXPECT_EQ(layout.members[3].offset, 32u); // mat3, 3 columns of 16 bytes
+  EXPECT_EQ(layout.members[4].offset, 80u); // float[3], 16 bytes apart
+  EXPECT_EQ(layout.members[4].arrayStride, 16u);
+  EXPECT_EQ(layout.size, 128u);
+
+  std::vector<uint8_t> data(layout.size, 0);
+  layout.write(collection_, data.data());
+  EXPECT_EQ(readFloat(data, 0), 2.0f);
+  EXPECT_EQ(readFloat(data, 16), 1.0f);
+  EXPECT_EQ(readFloat(data, 24), 3.0f);
+  EXPECT_EQ(readUInt(data, 28), 1u);
+  EXPECT_EQ(readFloat(data, 32), 1.0f);
+  EXPECT_EQ(readFloat(data, 32 + 16 + 4), 1.0f);
+  EXPECT_EQ(readFloat(data, 32 + 16 + 8), 5.0f);
+  EXPECT_EQ(readFloat(data, 32 + 32 + 8), 1.0f);
+  EXPECT_EQ(readFloat(data, 80), 0.25f);
+  EXPECT_EQ(readFloat(data, 96), 0.5f);
+  EXPECT_EQ(readFloat(data, 112), 0.75f);
+}
+
+//
+// Std430 Test
+//
+// Checks that arrays of scalars are tightly packed following std430 rules
+//
+TEST_F(UniformBlockLayoutTest, Std430) {
+  const auto layout = uniform::BlockLayout::fromCollection(
+      collection_, names_, 0, uniform::BlockLayout::Standard::Std430);
+  ASSERT_EQ(layout.members.size(), 5u);
+  EXPECT_EQ(layout.members[3].offset, 32u);
+  EXPECT_EQ(layout.members[4].offset, 80u);
+  EXPECT_EQ(layout.members[4].arrayStride, 4u);
+  EXPECT_EQ(layout.size, 96u);
+
+  std::vector<uint8_t> data(layout.size, 0);
+  layout.write(collection_, data.data());
+  EXPECT_EQ(readFloat(data, 80), 0.25f);
+  EXPECT_EQ(readFloat(data, 84), 0.5f);
+  EXPECT_EQ(readFloat(data, 88), 0.75f);
+}
+
+//
+// FromReflection Test
+//
+// Checks that reflected offsets are used and missing uniforms are skipped
+//
+TEST_F(UniformBlockLayoutTest, FromReflection) {
+  igl::BufferArgDesc bufferDesc;
+  bufferDesc.bufferIndex = 1;
+  bufferDesc.bufferDataSize = 64;
+  bufferDesc.members.push_back({igl::genNameHandle("position"), igl::UniformType::Float3, 0, 1});
+  bufferDesc.members.push_back({igl::genNameHandle("scale"), igl::UniformType::Float, 12, 1});
+  bufferDesc.members.push_back({igl::genNameHandle("missing"), igl::UniformType::Float4, 16, 1});
+
+  const auto layout = uniform::BlockLayout::fromReflection(bufferDesc);
+  ASSERT_EQ(layout.members.size(), 3u);
+  EXPECT_EQ(layout.bufferIndex, 1);
+  EXPECT_EQ(layout.size, 64u);
+
+  std::vector<uint8_t> data(layout.size, 0xFF);
+  layout.write(collection_, data.data());
+  EXPECT_EQ(readFloat(data, 0), 1.0f);
+  EXPECT_EQ(readFloat(data, 8), 3.0f);
+  EXPECT_EQ(readFloat(data, 12), 2.0f);
+  EXPECT_EQ(readUInt(data, 16), 0xFFFFFFFFu);
+}
+
+} // namespace iglu::tests
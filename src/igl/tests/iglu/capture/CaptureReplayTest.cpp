@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../../data/ShaderData.h"
+#include "../../util/TestDevice.h"
+#include <IGLU/capture/CaptureDevice.h>
+#include <IGLU/capture/TraceFormat.h>
+#include <IGLU/capture/TraceReplayer.h>
+#include <IGLU/sentinel/Device.h>
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <vector>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kWidth = 4;
+constexpr uint32_t kHeight = 4;
+constexpr uint32_t kNumFrames = 3;
+
+// util::createSimpleShaderStages() casts the device to the backend's type, which a CaptureDevice is
+// not, so the sources are picked from the device's shader version instead
+std::unique_ptr<IShaderStages> createSimpleShaderStages(const IDevice& device, Result& result) {
+  namespace shader = data::shader;
+  switch (device.getBackendType()) {
+  case BackendType::OpenGL: {
+    const ShaderVersion version = device.getShaderVersion();
+    const bool isGles3 = version.family == ShaderFamily::GlslEs && version.majorVersion >= 3;
+    return ShaderStagesCreator::fromModuleStringInput(
+        device,
+        isGles3 ? shader::OGL_SIMPLE_VERT_SHADER_ES3 : shader::OGL_SIMPLE_VERT_SHADER,
+        shader::shaderFunc,
+        "",
+        isGles3 ? shader::OGL_SIMPLE_FRAG_SHADER_ES3 : shader::OGL_SIMPLE_FRAG_SHADER,
+        shader::shaderFunc,
+        "",
+        &result);
+  }
+  case BackendType::Metal:
+    return ShaderStagesCreator::fromLibraryStringInput(device,
+                                                       shader::MTL_SIMPLE_SHADER,
+                                                       shader::simpleVertFunc,
+                                                       shader::simpleFragFunc,
+                                                       "",
+                                                       &result);
+  case BackendType::Vulkan:
+    return ShaderStagesCreator::fromModuleStringInput(device,
+                                                      shader::VULKAN_SIMPLE_VERT_SHADER,
+                                                      shader::shaderFunc,
+                                                      "",
+                                                      shader::VULKAN_SIMPLE_FRAG_SHADER,
+                                                      shader::shaderFunc,
+                                                      "",
+                                                      &result);
+  default:
+    result = Result(Result::Code::Unsupported);
+    return nullptr;
+  }
+}
+
+} // namespace
+
+class CaptureReplayTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+    auto device = util::createTestDevice();
+    ASSERT_TRUE(device != nullptr);
+    device_ = device;
+    captureDevice_ = std::make_shared<iglu::capture::CaptureDevice>(std::move(device));
+  }
+
+  // Renders a few frames that clear an offscreen texture through the capture device
+  void captureFrames() {
+    const DeviceScope scope(*captureDevice_);
+    Result result;
+
+    auto queue = captureDevice_->createCommandQueue({}, &result);
+    ASSERT_TRUE(result.isOk());
+    ASSERT_TRUE(queue != nullptr);
+
+    const TextureDesc texDesc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                                   kWidth,
+                                                   kHeight,
+                                                   TextureDesc::TextureUsageBits::Sampled |
+                                                       TextureDesc::TextureUsageBits::Attachment,
+                                                   "CaptureReplayTest::color");
+    auto texture = captureDevice_->createTexture(texDesc, &result);
+    ASSERT_TRUE(result.isOk());
+
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.colorAttachments[0].texture = texture;
+    auto framebuffer = captureDevice_->createFramebuffer(framebufferDesc, &result);
+    ASSERT_TRUE(result.isOk());
+
+    const float vertices[] = {0.0f, 1.0f, 2.0f, 3.0f};
+    auto buffer = captureDevice_->createBuffer(
+        BufferDesc(BufferDesc::BufferTypeBits::Vertex, vertices, sizeof(vertices)), &result);
+    ASSERT_TRUE(result.isOk());
+
+    RenderPassDesc renderPass;
+    renderPass.colorAttachments.resize(1);
+    renderPass.colorAttachments[0].loadAction = LoadAction::Clear;
+    renderPass.colorAttachments[0].storeAction = StoreAction::Store;
+    renderPass.colorAttachments[0].clearColor = Color(1, 0, 0, 1);
+
+    for (uint32_t frame = 0; frame != kNumFrames; ++frame) {
+      ASSERT_TRUE(buffer->upload(vertices, BufferRange(sizeof(vertices))).isOk());
+
+      auto commandBuffer = queue->createCommandBuffer({}, &result);
+      ASSERT_TRUE(result.isOk());
+      auto encoder = commandBuffer->createRenderCommandEncoder(renderPass, framebuffer, &result);
+      ASSERT_TRUE(result.isOk());
+      encoder->bindViewport({0.0f, 0.0f, kWidth, kHeight, 0.0f, 1.0f});
+      encoder->endEncoding();
+      queue->submit(*commandBuffer);
+      commandBuffer->waitUntilCompleted();
+    }
+  }
+
+ protected:
+  std::shared_ptr<IDevice> device_;
+  std::shared_ptr<iglu::capture::CaptureDevice> captureDevice_;
+};
+
+TEST(TraceFormatTest, WriterReaderRoundTrip) {
+  iglu::capture::TraceWriter writer;
+  writer.write(uint32_t(42));
+  writer.writeString("label");
+  const uint8_t bytes[] = {1, 2, 3};
+  writer.writeBlob(bytes, sizeof(bytes));
+
+  TextureDesc desc = TextureDesc::new2D(
+      TextureFormat::RGBA_UNorm8, 16, 8, TextureDesc::TextureUsageBits::Sampled, "texture");
+  desc.numMipLevels = 3;
+  iglu::capture::write(writer, desc);
+
+  iglu::capture::TraceReader reader(writer.data().data(), writer.size());
+  EXPECT_EQ(reader.read<uint32_t>(), 42u);
+  EXPECT_EQ(reader.readString(), "label");
+  uint32_t length = 0;
+  const uint8_t* blob = reader.readBlob(length);
+  ASSERT_EQ(length, sizeof(bytes));
+  EXPECT_EQ(blob[2], 3);
+
+  TextureDesc readDesc;
+  iglu::capture::read(reader, readDesc);
+  EXPECT_EQ(readDesc.width, 16u);
+  EXPECT_EQ(readDesc.height, 8u);
+  EXPECT_EQ(readDesc.numMipLevels, 3u);
+  EXPECT_EQ(readDesc.format, TextureFormat::RGBA_UNorm8);
+  EXPECT_EQ(readDesc.debugName, "texture");
+  EXPECT_TRUE(reader.ok());
+  EXPECT_EQ(reader.remaining(), 0u);
+
+  // Reads past the end fail without touching memory outside the trace
+  EXPECT_EQ(reader.read<uint64_t>(), 0u);
+  EXPECT_FALSE(reader.ok());
+}
+
+TEST_F(CaptureReplayTest, ReplayOnSameDevice) {
+  captureFrames();
+  const auto& trace = captureDevice_->recorder().data();
+  ASSERT_GT(captureDevice_->recorder().numRecords(), 0u);
+
+  iglu::capture::TraceReplayer replayer(*device_);
+  iglu::capture::ReplayStatistics statistics;
+  const Result result = replayer.replay(trace.data(), trace.size(), &statistics);
+  ASSERT_TRUE(result.isOk()) << result.message;
+
+  using iglu::capture::TraceOp;
+  EXPECT_EQ(statistics.numRecords, captureDevice_->recorder().numRecords());
+  EXPECT_EQ(statistics[TraceOp::CreateCommandQueue].count, 1u);
+  EXPECT_EQ(statistics[TraceOp::CreateTexture].count, 1u);
+  EXPECT_EQ(statistics[TraceOp::CreateFramebuffer].count, 1u);
+  EXPECT_EQ(statistics[TraceOp::CreateBuffer].count, 1u);
+  EXPECT_EQ(statistics[TraceOp::BufferUpload].count, kNumFrames);
+  EXPECT_EQ(statistics[TraceOp::CreateRenderCommandEncoder].count, kNumFrames);
+  EXPECT_EQ(statistics[TraceOp::BindViewport].count, kNumFrames);
+  EXPECT_EQ(statistics[TraceOp::EndEncoding].count, kNumFrames);
+  EXPECT_EQ(statistics[TraceOp::Submit].count, kNumFrames);
+  EXPECT_EQ(statistics[TraceOp::WaitUntilCompleted].count, kNumFrames);
+  EXPECT_EQ(statistics[TraceOp::DestroyBuffer].count, 1u);
+  EXPECT_FALSE(statistics.toString().empty());
+}
+
+TEST_F(CaptureReplayTest, ReplayOnSentinelDevice) {
+  captureFrames();
+  const auto& trace = captureDevice_->recorder().data();
+
+  // The sentinel device creates nothing, so every record is decoded and then skipped
+  iglu::sentinel::Device sentinel(false);
+  iglu::capture::TraceReplayer replayer(sentinel);
+  iglu::capture::ReplayStatistics statistics;
+  const Result result = replayer.replay(trace.data(), trace.size(), &statistics);
+  ASSERT_TRUE(result.isOk()) << result.message;
+
+  EXPECT_EQ(statistics.numRecords, captureDevice_->recorder().numRecords());
+  for (const auto& op : statistics.ops) {
+    EXPECT_EQ(op.count, 0u);
+  }
+  EXPECT_EQ(statistics[iglu::capture::TraceOp::Submit].skipped, kNumFrames);
+}
+
+TEST_F(CaptureReplayTest, ReplayTextureUpload) {
+  const auto& recorder = captureDevice_->recorder();
+  {
+    const DeviceScope scope(*captureDevice_);
+    Result result;
+    const TextureDesc texDesc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                                   kWidth,
+                                                   kHeight,
+                                                   TextureDesc::TextureUsageBits::Sampled |
+                                                       TextureDesc::TextureUsageBits::Attachment,
+                                                   "CaptureReplayTest::upload");
+    auto texture = captureDevice_->createTexture(texDesc, &result);
+    ASSERT_TRUE(result.isOk()) << result.message;
+    ASSERT_TRUE(texture != nullptr);
+    const uint32_t textureId = recorder.findObject(texture.get());
+    EXPECT_NE(textureId, 0u);
+
+    std::vector<uint32_t> pixels(kWidth * kHeight, 0xff00ff00);
+    ASSERT_TRUE(texture->upload(texture->getFullRange(), pixels.data()).isOk());
+
+    // Framebuffers hold the wrapped texture, which resolves to the same id
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.colorAttachments[0].texture = texture;
+    auto framebuffer = captureDevice_->createFramebuffer(framebufferDesc, &result);
+    ASSERT_TRUE(result.isOk()) << result.message;
+    auto attachment = framebuffer->getColorAttachment(0);
+    EXPECT_NE(attachment.get(), texture.get());
+    EXPECT_EQ(recorder.findObject(attachment.get()), textureId);
+  }
+
+  const auto& trace = recorder.data();
+  iglu::capture::TraceReplayer replayer(*device_);
+  iglu::capture::ReplayStatistics statistics;
+  ASSERT_TRUE(replayer.replay(trace.data(), trace.size(), &statistics).isOk());
+  using iglu::capture::TraceOp;
+  EXPECT_EQ(statistics[TraceOp::CreateTexture].count, 1u);
+  EXPECT_EQ(statistics[TraceOp::CreateExternalTexture].count, 0u);
+  EXPECT_EQ(statistics[TraceOp::TextureUpload].count, 1u);
+  EXPECT_EQ(statistics[TraceOp::DestroyTexture].count, 1u);
+}
+
+TEST_F(CaptureReplayTest, ShaderStagesOwnTheirId) {
+  const DeviceScope scope(*captureDevice_);
+  Result result;
+  const auto& recorder = captureDevice_->recorder();
+
+  auto stages = createSimpleShaderStages(*captureDevice_, result);
+  if (result.code == Result::Code::Unsupported) {
+    GTEST_SKIP() << "No simple shaders for this backend.";
+    return;
+  }
+  ASSERT_TRUE(result.isOk()) << result.message;
+  ASSERT_TRUE(stages != nullptr);
+  const IShaderStages* address = stages.get();
+  EXPECT_NE(recorder.findObject(address), 0u);
+
+  VertexInputStateDesc inputDesc;
+  inputDesc.attributes[0].format = VertexAttributeFormat::Float4;
+  inputDesc.attributes[0].bufferIndex = data::shader::simplePosIndex;
+  inputDesc.attributes[0].name = data::shader::simplePos;
+  inputDesc.attributes[0].location = 0;
+  inputDesc.inputBindings[0].stride = sizeof(float) * 4;
+  inputDesc.attributes[1].format = VertexAttributeFormat::Float2;
+  inputDesc.attributes[1].bufferIndex = data::shader::simpleUvIndex;
+  inputDesc.attributes[1].name = data::shader::simpleUv;
+  inputDesc.attributes[1].location = 1;
+  inputDesc.inputBindings[1].stride = sizeof(float) * 2;
+  inputDesc.numAttributes = inputDesc.numInputBindings = 2;
+
+  // The wrapped device receives the shader stages it created, not the capture wrapper
+  RenderPipelineDesc pipelineDesc;
+  pipelineDesc.vertexInputState = captureDevice_->createVertexInputState(inputDesc, &result);
+  ASSERT_TRUE(result.isOk()) << result.message;
+  pipelineDesc.shaderStages = std::move(stages);
+  pipelineDesc.targetDesc.colorAttachments.resize(1);
+  pipelineDesc.targetDesc.colorAttachments[0].textureFormat = TextureFormat::RGBA_UNorm8;
+  auto pipeline = captureDevice_->createRenderPipeline(pipelineDesc, &result);
+  ASSERT_TRUE(result.isOk()) << result.message;
+  ASSERT_TRUE(pipeline != nullptr);
+
+  // Once the stages are gone, a new object at the same address must not inherit their id
+  pipeline.reset();
+  pipelineDesc.shaderStages.reset();
+  EXPECT_EQ(recorder.findObject(address), 0u);
+
+  const auto& trace = recorder.data();
+  iglu::capture::TraceReplayer replayer(*device_);
+  iglu::capture::ReplayStatistics statistics;
+  ASSERT_TRUE(replayer.replay(trace.data(), trace.size(), &statistics).isOk());
+  EXPECT_EQ(statistics[iglu::capture::TraceOp::CreateShaderStages].count, 1u);
+  EXPECT_EQ(statistics[iglu::capture::TraceOp::CreateRenderPipeline].count, 1u);
+}
+
+TEST_F(CaptureReplayTest, ReplayShaderLibrary) {
+  if (!device_->hasFeature(DeviceFeatures::ShaderLibrary)) {
+    GTEST_SKIP() << "Shader Libraries are unsupported for this platform.";
+    return;
+  }
+  const char* source = nullptr;
+  if (device_->getBackendType() == BackendType::Metal) {
+    source = data::shader::MTL_SIMPLE_SHADER;
+  } else if (device_->getBackendType() == BackendType::Vulkan) {
+    source = data::shader::VULKAN_SIMPLE_VERT_SHADER;
+  } else {
+    GTEST_SKIP() << "No shader library source for this backend.";
+    return;
+  }
+
+  const DeviceScope scope(*captureDevice_);
+  Result result;
+  auto library = ShaderLibraryCreator::fromStringInput(
+      *captureDevice_, source, {{ShaderStage::Vertex, "vertexShader"}}, "", &result);
+  ASSERT_TRUE(result.isOk()) << result.message;
+  ASSERT_TRUE(library != nullptr);
+  auto vertexModule = library->getShaderModule("vertexShader");
+  ASSERT_TRUE(vertexModule != nullptr);
+  EXPECT_NE(captureDevice_->recorder().findObject(vertexModule.get()), 0u);
+
+  const auto& trace = captureDevice_->recorder().data();
+  iglu::capture::TraceReplayer replayer(*device_);
+  iglu::capture::ReplayStatistics statistics;
+  ASSERT_TRUE(replayer.replay(trace.data(), trace.size(), &statistics).isOk());
+  EXPECT_EQ(statistics[iglu::capture::TraceOp::CreateShaderLibrary].count, 1u);
+  EXPECT_EQ(statistics[iglu::capture::TraceOp::CreateLibraryShaderModule].count, 1u);
+}
+
+TEST_F(CaptureReplayTest, RejectsCorruptTrace) {
+  captureFrames();
+  auto trace = captureDevice_->recorder().data();
+
+  iglu::capture::TraceReplayer replayer(*device_);
+  EXPECT_FALSE(replayer.replay(trace.data(), 2, nullptr).isOk());
+
+  // Cut the last record short
+  trace.pop_back();
+  EXPECT_FALSE(replayer.replay(trace.data(), trace.size(), nullptr).isOk());
+}
+
+} // namespace igl::tests
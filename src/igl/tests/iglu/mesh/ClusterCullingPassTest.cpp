@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../../util/Common.h"
+
+#include <IGLU/mesh/ClusterCullingPass.h>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <vector>
+
+namespace igl::tests {
+
+namespace {
+
+// Spans two threadgroups of the culling shader
+constexpr uint32_t kNumMeshlets = 100;
+
+struct DrawCommand {
+  uint32_t indexCount;
+  uint32_t instanceCount;
+  uint32_t firstIndex;
+  int32_t vertexOffset;
+  uint32_t firstInstance;
+};
+
+// A 10 x 10 grid of meshlets straddling the [-1, 1] frustum, every third one facing away from the
+// camera
+iglu::mesh::MeshletMesh makeMesh() {
+  iglu::mesh::MeshletMesh mesh;
+  for (uint32_t i = 0; i != kNumMeshlets; ++i) {
+    iglu::mesh::Meshlet meshlet{};
+    meshlet.center[0] = meshlet.coneApex[0] = -3.0f + 0.6f * static_cast<float>(i % 10);
+    meshlet.center[1] = meshlet.coneApex[1] = -3.0f + 0.6f * static_cast<float>(i / 10);
+    meshlet.radius = 0.1f;
+    meshlet.coneAxis[2] = i % 3 == 0 ? -1.0f : 1.0f;
+    meshlet.coneCutoff = 0.5f;
+    meshlet.indexOffset = static_cast<uint32_t>(mesh.indices.size());
+    meshlet.indexCount = 3;
+    mesh.indices.insert(mesh.indices.end(), {0, 1, 2});
+    mesh.meshlets.push_back(meshlet);
+  }
+  return mesh;
+}
+
+} // namespace
+
+class ClusterCullingPassTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+};
+
+// The compute pass must write the same draws the CPU reference predicts, and they must be visible
+// to the commands that follow it
+TEST_F(ClusterCullingPassTest, DrawCommandsMatchCpuCulling) {
+  if (!iglu::mesh::ClusterCullingPass::isSupported(*iglDev_)) {
+    GTEST_SKIP() << "Cluster culling is unsupported for this platform.";
+    return;
+  }
+
+  const auto mesh = makeMesh();
+  Result ret;
+  iglu::mesh::ClusterCullingPass pass(*iglDev_, mesh, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  const auto view = iglu::mesh::makeMeshletCullingView(iglu::simdtypes::float4x4(1.0f),
+                                                       iglu::simdtypes::float3{0.0f, 0.0f, 5.0f});
+  auto cmdBuffer = cmdQueue_->createCommandBuffer({}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  pass.cull(*cmdBuffer, view);
+  cmdQueue_->submit(*cmdBuffer);
+  cmdBuffer->waitUntilCompleted();
+
+  std::vector<DrawCommand> commands(kNumMeshlets);
+  const BufferRange range(sizeof(DrawCommand) * kNumMeshlets, 0);
+  const void* data = pass.indirectBuffer().map(range, &ret);
+  if (data == nullptr) {
+    GTEST_SKIP() << "Draw commands live in memory the CPU cannot map on this platform.";
+    return;
+  }
+  std::memcpy(commands.data(), data, range.size);
+  pass.indirectBuffer().unmap();
+
+  uint32_t numVisible = 0;
+  for (uint32_t i = 0; i != kNumMeshlets; ++i) {
+    const bool visible = iglu::mesh::isMeshletVisible(mesh.meshlets[i], view);
+    numVisible += visible ? 1 : 0;
+    EXPECT_EQ(commands[i].instanceCount, visible ? 1u : 0u) << "meshlet " << i;
+    EXPECT_EQ(commands[i].indexCount, mesh.meshlets[i].indexCount) << "meshlet " << i;
+    EXPECT_EQ(commands[i].firstIndex, mesh.meshlets[i].indexOffset) << "meshlet " << i;
+    EXPECT_EQ(commands[i].vertexOffset, 0) << "meshlet " << i;
+  }
+  // The grid must exercise both outcomes
+  EXPECT_GT(numVisible, 0u);
+  EXPECT_LT(numVisible, kNumMeshlets);
+}
+
+} // namespace igl::tests
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <IGLU/mesh/MeshCache.h>
+#include <IGLU/mesh/MeshOptimizer.h>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace igl::tests {
+
+namespace {
+
+// Unindexed triangle list of a flat grid with `n` x `n` unit quads, starting at `origin`
+std::vector<iglu::mesh::MeshVertex> makeGrid(uint32_t n, float origin = 0.0f) {
+  std::vector<iglu::mesh::MeshVertex> vertices;
+  const auto vertex = [n, origin](uint32_t x, uint32_t y) {
+    iglu::mesh::MeshVertex v;
+    v.position[0] = origin + static_cast<float>(x);
+    v.position[1] = origin + static_cast<float>(y);
+    v.normal[2] = 1.0f;
+    v.uv[0] = static_cast<float>(x) / static_cast<float>(n);
+    v.uv[1] = static_cast<float>(y) / static_cast<float>(n);
+    return v;
+  };
+  for (uint32_t y = 0; y < n; ++y) {
+    for (uint32_t x = 0; x < n; ++x) {
+      vertices.insert(vertices.end(),
+                      {vertex(x, y),
+                       vertex(x + 1, y),
+                       vertex(x, y + 1),
+                       vertex(x + 1, y),
+                       vertex(x + 1, y + 1),
+                       vertex(x, y + 1)});
+    }
+  }
+  return vertices;
+}
+
+} // namespace
+
+TEST(MeshOptimizerTest, OptimizeMesh) {
+  const auto grid = makeGrid(16);
+  const auto mesh = iglu::mesh::optimizeMesh(grid.data(), grid.size(), nullptr, 0);
+
+  ASSERT_FALSE(mesh.lods.empty());
+  EXPECT_EQ(mesh.lods[0].indexOffset, 0u);
+  EXPECT_EQ(mesh.lods[0].indexCount, grid.size());
+  EXPECT_EQ(mesh.lods[0].error, 0.0f);
+  EXPECT_LE(mesh.vertices.size(), 17u * 17u);
+
+  for (size_t i = 1; i < mesh.lods.size(); ++i) {
+    EXPECT_LT(mesh.lods[i].indexCount, mesh.lods[i - 1].indexCount);
+    EXPECT_EQ(mesh.lods[i].indexOffset, mesh.lods[i - 1].indexOffset + mesh.lods[i - 1].indexCount);
+    EXPECT_EQ(mesh.lods[i].indexCount % 3, 0u);
+  }
+  for (const uint32_t index : mesh.indices) {
+    EXPECT_LT(index, mesh.vertices.size());
+  }
+
+  // Flat +Z normals quantize to snorm16 (0, 0, 32767) with w = 0
+  for (const auto& v : mesh.vertices) {
+    EXPECT_EQ(v.normal[0], 0);
+    EXPECT_EQ(v.normal[1], 0);
+    EXPECT_EQ(v.normal[2], 32767);
+    EXPECT_EQ(v.normal[3], 0);
+    EXPECT_EQ(v.position[3], 0xFFFF); // 1.0 as a unorm16
+  }
+}
+
+TEST(MeshOptimizerTest, QuantizePositions) {
+  // Half floats would only resolve 0.25 units at these coordinates
+  constexpr float kOrigin = 500.0f;
+  constexpr uint32_t kSize = 16;
+  const auto grid = makeGrid(kSize, kOrigin);
+  const auto mesh = iglu::mesh::optimizeMesh(grid.data(), grid.size(), nullptr, 0);
+  ASSERT_FALSE(mesh.vertices.empty());
+
+  const auto& dequantization = mesh.positionDequantization;
+  EXPECT_EQ(dequantization.offset[0], kOrigin);
+  EXPECT_EQ(dequantization.offset[1], kOrigin);
+  EXPECT_EQ(dequantization.scale[0], static_cast<float>(kSize));
+  EXPECT_EQ(dequantization.scale[1], static_cast<float>(kSize));
+  // The grid is flat, so z keeps a unit scale
+  EXPECT_EQ(dequantization.offset[2], 0.0f);
+  EXPECT_EQ(dequantization.scale[2], 1.0f);
+
+  // Every vertex lies on the integer grid, within half a quantization step
+  const float maxError = static_cast<float>(kSize) / 65535.0f;
+  for (const auto& v : mesh.vertices) {
+    for (size_t i = 0; i < 3; ++i) {
+      const float position = dequantization.offset[i] +
+                             dequantization.scale[i] * static_cast<float>(v.position[i]) / 65535.0f;
+      EXPECT_NEAR(position, std::round(position), maxError);
+    }
+  }
+}
+
+TEST(MeshOptimizerTest, MeshCacheRoundTrip) {
+  const auto grid = makeGrid(4);
+  const auto mesh = iglu::mesh::optimizeMesh(grid.data(), grid.size(), nullptr, 0);
+
+  std::stringstream stream;
+  Result result;
+  iglu::mesh::writeMeshCache(stream, mesh.view(), &result);
+  ASSERT_TRUE(result.isOk()) << result.message;
+
+  const std::string file = stream.str();
+  std::vector<uint32_t> storage((file.size() + 3) / 4);
+  std::memcpy(storage.data(), file.data(), file.size());
+
+  const auto view = iglu::mesh::readMeshCache(storage.data(), file.size(), &result);
+  ASSERT_TRUE(result.isOk()) << result.message;
+  ASSERT_EQ(view.numVertices, mesh.vertices.size());
+  ASSERT_EQ(view.numIndices, mesh.indices.size());
+  ASSERT_EQ(view.numLods, mesh.lods.size());
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(view.positionDequantization.scale[i], mesh.positionDequantization.scale[i]);
+    EXPECT_EQ(view.positionDequantization.offset[i], mesh.positionDequantization.offset[i]);
+  }
+  EXPECT_EQ(std::memcmp(view.vertices,
+                        mesh.vertices.data(),
+                        mesh.vertices.size() * sizeof(iglu::mesh::QuantizedVertex)),
+            0);
+  EXPECT_EQ(std::memcmp(view.indices, mesh.indices.data(), mesh.indices.size() * 4), 0);
+  for (size_t i = 0; i < view.numLods; ++i) {
+    EXPECT_EQ(view.lods[i].indexOffset, mesh.lods[i].indexOffset);
+    EXPECT_EQ(view.lods[i].indexCount, mesh.lods[i].indexCount);
+  }
+
+  // Truncated files and other versions are rejected
+  std::ignore = iglu::mesh::readMeshCache(storage.data(), file.size() - 4, &result);
+  EXPECT_FALSE(result.isOk());
+
+  const uint32_t version = iglu::mesh::kMeshCacheVersion + 1;
+  std::memcpy(reinterpret_cast<uint8_t*>(storage.data()) +
+                  offsetof(iglu::mesh::MeshCacheHeader, version),
+              &version,
+              sizeof(version));
+  std::ignore = iglu::mesh::readMeshCache(storage.data(), file.size(), &result);
+  EXPECT_FALSE(result.isOk());
+}
+
+} // namespace igl::tests
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <IGLU/mesh/Meshlets.h>
+#include <vector>
+
+namespace igl::tests {
+
+namespace {
+
+iglu::mesh::Meshlet makeMeshlet(float x, float y, float z, float radius) {
+  iglu::mesh::Meshlet meshlet{};
+  meshlet.center[0] = meshlet.coneApex[0] = x;
+  meshlet.center[1] = meshlet.coneApex[1] = y;
+  meshlet.center[2] = meshlet.coneApex[2] = z;
+  meshlet.radius = radius;
+  meshlet.coneAxis[2] = 1.0f;
+  meshlet.coneCutoff = 0.5f;
+  return meshlet;
+}
+
+} // namespace
+
+TEST(MeshletsTest, BuildMeshlets) {
+  // Indexed grid of 16 x 16 quads in the XY plane
+  constexpr uint32_t kSize = 16;
+  std::vector<float> positions;
+  for (uint32_t y = 0; y <= kSize; ++y) {
+    for (uint32_t x = 0; x <= kSize; ++x) {
+      positions.insert(positions.end(), {static_cast<float>(x), static_cast<float>(y), 0.0f});
+    }
+  }
+  std::vector<uint32_t> indices;
+  for (uint32_t y = 0; y < kSize; ++y) {
+    for (uint32_t x = 0; x < kSize; ++x) {
+      const uint32_t i = y * (kSize + 1) + x;
+      indices.insert(indices.end(), {i, i + 1, i + kSize + 1, i + 1, i + kSize + 2, i + kSize + 1});
+    }
+  }
+
+  const auto mesh = iglu::mesh::buildMeshlets(positions.data(),
+                                              3 * sizeof(float),
+                                              positions.size() / 3,
+                                              indices.data(),
+                                              indices.size(),
+                                              64,
+                                              124);
+  ASSERT_FALSE(mesh.meshlets.empty());
+  EXPECT_EQ(mesh.indices.size(), indices.size());
+
+  uint32_t indexOffset = 0;
+  for (const auto& meshlet : mesh.meshlets) {
+    EXPECT_EQ(meshlet.indexOffset, indexOffset);
+    EXPECT_LE(meshlet.indexCount, 124u * 3u);
+    EXPECT_GT(meshlet.radius, 0.0f);
+    indexOffset += meshlet.indexCount;
+  }
+  for (const uint32_t index : mesh.indices) {
+    EXPECT_LT(index, positions.size() / 3);
+  }
+}
+
+TEST(MeshletsTest, FrustumCulling) {
+  // An identity matrix makes the frustum the [-1, 1] cube
+  const auto view = iglu::mesh::makeMeshletCullingView(iglu::simdtypes::float4x4(1.0f),
+                                                       iglu::simdtypes::float3{0.0f, 0.0f, 5.0f});
+
+  EXPECT_TRUE(iglu::mesh::isMeshletVisible(makeMeshlet(0.0f, 0.0f, 0.0f, 0.1f), view));
+  EXPECT_TRUE(iglu::mesh::isMeshletVisible(makeMeshlet(1.05f, 0.0f, 0.0f, 0.1f), view));
+  EXPECT_FALSE(iglu::mesh::isMeshletVisible(makeMeshlet(5.0f, 0.0f, 0.0f, 0.1f), view));
+  EXPECT_FALSE(iglu::mesh::isMeshletVisible(makeMeshlet(0.0f, -3.0f, 0.0f, 0.1f), view));
+  EXPECT_FALSE(iglu::mesh::isMeshletVisible(makeMeshlet(0.0f, 0.0f, 2.0f, 0.5f), view));
+}
+
+TEST(MeshletsTest, BackfaceCulling) {
+  const auto meshlet = makeMeshlet(0.0f, 0.0f, 0.0f, 0.1f);
+
+  // Triangles face +Z, so viewers on that side see them...
+  auto view = iglu::mesh::makeMeshletCullingView(iglu::simdtypes::float4x4(1.0f),
+                                                 iglu::simdtypes::float3{0.0f, 0.0f, 5.0f});
+  EXPECT_TRUE(iglu::mesh::isMeshletVisible(meshlet, view));
+
+  // ...and viewers on the other side see only their back faces
+  view.cameraPosition[2] = -5.0f;
+  EXPECT_FALSE(iglu::mesh::isMeshletVisible(meshlet, view));
+}
+
+} // namespace igl::tests
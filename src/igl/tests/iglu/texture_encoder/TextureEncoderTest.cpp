@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <IGLU/texture_encoder/BlockEncoder.h>
+#include <IGLU/texture_encoder/TextureEncoder.h>
+#include <IGLU/texture_loader/ktx2/TextureLoaderFactory.h>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+namespace igl::tests {
+
+namespace {
+
+using Block = std::array<uint8_t, 64>;
+
+// Reference decoders for the subset of each format the encoders emit
+
+Block decodeBc7Mode6(const uint8_t* block) {
+  uint32_t position = 0;
+  const auto read = [&](uint32_t numBits) {
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < numBits; ++i, ++position) {
+      value |= ((block[position / 8u] >> (position % 8u)) & 1u) << i;
+    }
+    return value;
+  };
+  EXPECT_EQ(read(7), 1u << 6);
+
+  uint32_t endpoints[2][4];
+  for (uint32_t c = 0; c < 4; ++c) {
+    endpoints[0][c] = read(7) << 1;
+    endpoints[1][c] = read(7) << 1;
+  }
+  const uint32_t p0 = read(1);
+  const uint32_t p1 = read(1);
+  constexpr uint32_t kWeights[] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+  Block rgba{};
+  for (uint32_t p = 0; p < 16; ++p) {
+    const uint32_t w = kWeights[read(p == 0 ? 3 : 4)];
+    for (uint32_t c = 0; c < 4; ++c) {
+      rgba[4u * p + c] = static_cast<uint8_t>(
+          ((64u - w) * (endpoints[0][c] | p0) + w * (endpoints[1][c] | p1) + 32u) >> 6);
+    }
+  }
+  return rgba;
+}
+
+uint64_t readBigEndian(const uint8_t* block) {
+  uint64_t bits = 0;
+  for (uint32_t i = 0; i < 8; ++i) {
+    bits = (bits << 8) | block[i];
+  }
+  return bits;
+}
+
+void decodeEtc1(const uint8_t* block, Block& rgba) {
+  constexpr int32_t kModifiers[8][2] = {
+      {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+  const uint64_t bits = readBigEndian(block);
+  const bool differential = ((bits >> 33) & 1u) != 0;
+  const bool flip = ((bits >> 32) & 1u) != 0;
+
+  int32_t bases[2][3];
+  for (uint32_t c = 0; c < 3; ++c) {
+    if (differential) {
+      const auto base = static_cast<int32_t>((bits >> (59u - 8u * c)) & 31u);
+      auto delta = static_cast<int32_t>((bits >> (56u - 8u * c)) & 7u);
+      delta = delta >= 4 ? delta - 8 : delta;
+      ASSERT_GE(base + delta, 0);
+      ASSERT_LE(base + delta, 31);
+      bases[0][c] = (base << 3) | (base >> 2);
+      bases[1][c] = ((base + delta) << 3) | ((base + delta) >> 2);
+    } else {
+      bases[0][c] = static_cast<int32_t>((bits >> (60u - 8u * c)) & 15u) * 17;
+      bases[1][c] = static_cast<int32_t>((bits >> (56u - 8u * c)) & 15u) * 17;
+    }
+  }
+  const uint32_t tables[2] = {static_cast<uint32_t>((bits >> 37) & 7u),
+                              static_cast<uint32_t>((bits >> 34) & 7u)};
+
+  for (uint32_t y = 0; y < 4; ++y) {
+    for (uint32_t x = 0; x < 4; ++x) {
+      const uint32_t i = x * 4u + y;
+      const uint32_t selector = (((bits >> (16u + i)) & 1u) << 1) | ((bits >> i) & 1u);
+      const uint32_t subblock = (flip ? y >= 2 : x >= 2) ? 1 : 0;
+      int32_t modifier = kModifiers[tables[subblock]][selector & 1u];
+      modifier = selector >= 2 ? -modifier : modifier;
+      for (uint32_t c = 0; c < 3; ++c) {
+        rgba[4u * (y * 4u + x) + c] =
+            static_cast<uint8_t>(std::clamp(bases[subblock][c] + modifier, 0, 255));
+      }
+    }
+  }
+}
+
+void decodeEacAlpha(const uint8_t* block, Block& rgba) {
+  constexpr int32_t kModifiers[16][8] = {
+      {-3, -6, -9, -15, 2, 5, 8, 14},
+      {-3, -7, -10, -13, 2, 6, 9, 12},
+      {-2, -5, -8, -13, 1, 4, 7, 12},
+      {-2, -4, -6, -13, 1, 3, 5, 12},
+      {-3, -6, -8, -12, 2, 5, 7, 11},
+      {-3, -7, -9, -11, 2, 6, 8, 10},
+      {-4, -7, -8, -11, 3, 6, 7, 10},
+      {-3, -5, -8, -11, 2, 4, 7, 10},
+      {-2, -6, -8, -10, 1, 5, 7, 9},
+      {-2, -5, -8, -10, 1, 4, 7, 9},
+      {-2, -4, -8, -10, 1, 3, 7, 9},
+      {-2, -5, -7, -10, 1, 4, 6, 9},
+      {-3, -4, -7, -10, 2, 3, 6, 9},
+      {-1, -2, -3, -10, 0, 1, 2, 9},
+      {-4, -6, -8, -9, 3, 5, 7, 8},
+      {-3, -5, -7, -9, 2, 4, 6, 8},
+  };
+  const uint64_t bits = readBigEndian(block);
+  const auto base = static_cast<int32_t>(bits >> 56);
+  const auto multiplier = static_cast<int32_t>((bits >> 52) & 15u);
+  const auto table = static_cast<uint32_t>((bits >> 48) & 15u);
+  for (uint32_t y = 0; y < 4; ++y) {
+    for (uint32_t x = 0; x < 4; ++x) {
+      const auto index = static_cast<uint32_t>((bits >> (45u - 3u * (x * 4u + y))) & 7u);
+      rgba[4u * (y * 4u + x) + 3u] =
+          static_cast<uint8_t>(std::clamp(base + kModifiers[table][index] * multiplier, 0, 255));
+    }
+  }
+}
+
+int32_t maxError(const Block& a, const Block& b, uint32_t numChannels) {
+  int32_t error = 0;
+  for (uint32_t p = 0; p < 16; ++p) {
+    for (uint32_t c = 0; c < numChannels; ++c) {
+      error = std::max(error, std::abs(a[4u * p + c] - b[4u * p + c]));
+    }
+  }
+  return error;
+}
+
+Block solidBlock(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+  Block block{};
+  for (uint32_t p = 0; p < 16; ++p) {
+    block[4u * p] = r;
+    block[4u * p + 1u] = g;
+    block[4u * p + 2u] = b;
+    block[4u * p + 3u] = a;
+  }
+  return block;
+}
+
+// A smooth diagonal ramp, typical of light maps and thumbnails
+Block gradientBlock() {
+  Block block{};
+  for (uint32_t y = 0; y < 4; ++y) {
+    for (uint32_t x = 0; x < 4; ++x) {
+      uint8_t* pixel = block.data() + 4u * (y * 4u + x);
+      pixel[0] = static_cast<uint8_t>(40u + 10u * (x + y));
+      pixel[1] = static_cast<uint8_t>(100u + 6u * (x + y));
+      pixel[2] = static_cast<uint8_t>(200u - 5u * (x + y));
+      pixel[3] = static_cast<uint8_t>(255u - 20u * (x + y));
+    }
+  }
+  return block;
+}
+
+} // namespace
+
+class TextureEncoderTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+  }
+};
+
+TEST_F(TextureEncoderTest, Bc7Block) {
+  for (const auto& block :
+       {solidBlock(0, 0, 0, 0), solidBlock(255, 128, 7, 255), solidBlock(13, 200, 99, 64)}) {
+    uint8_t encoded[16];
+    iglu::textureencoder::encodeBc7Block(block.data(), encoded);
+    EXPECT_LE(maxError(decodeBc7Mode6(encoded), block, 4), 1);
+  }
+
+  const Block block = gradientBlock();
+  uint8_t encoded[16];
+  iglu::textureencoder::encodeBc7Block(block.data(), encoded);
+  EXPECT_LE(maxError(decodeBc7Mode6(encoded), block, 4), 8);
+}
+
+TEST_F(TextureEncoderTest, Etc2RgbBlock) {
+  for (const auto& block :
+       {solidBlock(0, 0, 0, 255), solidBlock(255, 255, 255, 255), solidBlock(13, 200, 99, 255)}) {
+    uint8_t encoded[8];
+    iglu::textureencoder::encodeEtc2RgbBlock(block.data(), encoded);
+    Block decoded = block;
+    decodeEtc1(encoded, decoded);
+    EXPECT_LE(maxError(decoded, block, 3), 6);
+  }
+
+  const Block block = gradientBlock();
+  uint8_t encoded[8];
+  iglu::textureencoder::encodeEtc2RgbBlock(block.data(), encoded);
+  Block decoded = block;
+  decodeEtc1(encoded, decoded);
+  EXPECT_LE(maxError(decoded, block, 3), 24);
+}
+
+TEST_F(TextureEncoderTest, EacAlphaBlock) {
+  for (const uint8_t alpha : {0, 1, 128, 254, 255}) {
+    const Block block = solidBlock(0, 0, 0, alpha);
+    uint8_t encoded[8];
+    iglu::textureencoder::encodeEacAlphaBlock(block.data(), encoded);
+    Block decoded = block;
+    decodeEacAlpha(encoded, decoded);
+    EXPECT_EQ(maxError(decoded, block, 4), 0) << static_cast<int>(alpha);
+  }
+
+  const Block block = gradientBlock();
+  uint8_t encoded[8];
+  iglu::textureencoder::encodeEacAlphaBlock(block.data(), encoded);
+  Block decoded = block;
+  decodeEacAlpha(encoded, decoded);
+  EXPECT_LE(maxError(decoded, block, 4), 8);
+}
+
+TEST_F(TextureEncoderTest, EncodeImage) {
+  // 5x3 pixels cover 2x1 blocks, padded with the last column and row
+  std::vector<uint8_t> rgba(5 * 3 * 4);
+  for (size_t i = 0; i < rgba.size(); i += 4) {
+    rgba[i] = 200;
+    rgba[i + 3] = 255;
+  }
+
+  Result ret;
+  auto blocks =
+      iglu::textureencoder::encodeImage(rgba.data(), 5, 3, TextureFormat::RGBA8_EAC_ETC2, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  ASSERT_EQ(blocks.size(), 2u * 16u);
+
+  for (size_t b = 0; b < 2; ++b) {
+    Block decoded{};
+    decodeEacAlpha(blocks.data() + 16u * b, decoded);
+    decodeEtc1(blocks.data() + 16u * b + 8u, decoded);
+    EXPECT_LE(maxError(decoded, solidBlock(200, 0, 0, 255), 4), 6);
+  }
+
+  blocks = iglu::textureencoder::encodeImage(rgba.data(), 5, 3, TextureFormat::RGBA_SRGB, &ret);
+  ASSERT_TRUE(blocks.empty());
+  ASSERT_EQ(ret.code, Result::Code::Unsupported);
+}
+
+TEST_F(TextureEncoderTest, WriteKtx2_LoadsBack) {
+  std::vector<uint8_t> rgba(16 * 8 * 4, 0x80);
+
+  std::stringstream stream;
+  Result ret;
+  iglu::textureencoder::writeKtx2(
+      stream, rgba.data(), 16, 8, TextureFormat::RGBA_BC7_UNORM_4x4, 3, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+
+  const std::string file = stream.str();
+  iglu::textureloader::ktx2::TextureLoaderFactory factory;
+  auto loader = factory.tryCreate(reinterpret_cast<const uint8_t*>(file.data()),
+                                  static_cast<uint32_t>(file.size()),
+                                  &ret);
+  ASSERT_NE(loader, nullptr) << ret.message;
+  EXPECT_EQ(loader->descriptor().format, TextureFormat::RGBA_BC7_UNORM_4x4);
+  EXPECT_EQ(loader->descriptor().width, 16u);
+  EXPECT_EQ(loader->descriptor().height, 8u);
+  EXPECT_EQ(loader->descriptor().numMipLevels, 3u);
+}
+
+TEST_F(TextureEncoderTest, WriteKtx2_ReportsStreamErrors) {
+  std::vector<uint8_t> rgba(8 * 8 * 4, 0x80);
+
+  std::stringstream stream;
+  stream.setstate(std::ios::badbit);
+  Result ret;
+  iglu::textureencoder::writeKtx2(
+      stream, rgba.data(), 8, 8, TextureFormat::RGBA_BC7_UNORM_4x4, 1, &ret);
+  ASSERT_EQ(ret.code, Result::Code::RuntimeError);
+}
+
+} // namespace igl::tests
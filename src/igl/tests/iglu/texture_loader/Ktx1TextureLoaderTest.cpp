@@ -10,6 +10,8 @@
 #include <IGLU/texture_loader/ktx1/Header.h>
 #include <IGLU/texture_loader/ktx1/TextureLoaderFactory.h>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <igl/opengl/util/TextureFormat.h>
 #include <vector>
 
@@ -167,6 +169,53 @@ TEST_F(Ktx1TextureLoaderTest, HeaderWithMipLevels_Succeeds) {
   EXPECT_TRUE(ret.isOk()) << ret.message;
 }
 
+TEST_F(Ktx1TextureLoaderTest, LoadFromFile_Succeeds) {
+  const uint32_t width = 64u;
+  const uint32_t height = 32u;
+  const uint32_t numMipLevels = 1u;
+  const uint32_t bytesOfKeyValueData = 0u;
+  const uint32_t imageSize = 512u;
+  const uint32_t glFormat = 0x8C03; /* GL_COMPRESSED_RGBA_PVRTC_2BPPV1_IMG */
+  auto buffer = getBuffer(kHeaderSize + imageSize + 4u * numMipLevels /* for imageSize */);
+  populateMinimalValidFile(
+      buffer, glFormat, width, height, numMipLevels, bytesOfKeyValueData, imageSize);
+  for (uint32_t i = 0; i < imageSize; ++i) {
+    buffer[kOffsetImages + 4u + i] = static_cast<uint8_t>(i);
+  }
+
+  const auto path =
+      (std::filesystem::temp_directory_path() / "Ktx1TextureLoaderTest_LoadFromFile.ktx").string();
+  {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(buffer.data()),
+               static_cast<std::streamsize>(buffer.size()));
+  }
+
+  Result ret;
+  auto loader = factory_.tryCreateFromFile(path, &ret);
+  ASSERT_NE(loader, nullptr);
+  EXPECT_TRUE(ret.isOk()) << ret.message;
+
+  // Image data is read in place from the mapped file
+  auto data = loader->load(&ret);
+  ASSERT_NE(data, nullptr);
+  EXPECT_TRUE(ret.isOk()) << ret.message;
+  ASSERT_EQ(data->length(), imageSize);
+  EXPECT_EQ(std::memcmp(data->data(), buffer.data() + kOffsetImages + 4u, imageSize), 0);
+
+  loader.reset();
+  std::filesystem::remove(path);
+}
+
+TEST_F(Ktx1TextureLoaderTest, LoadFromMissingFile_Fails) {
+  Result ret;
+  auto loader = factory_.tryCreateFromFile(
+      (std::filesystem::temp_directory_path() / "Ktx1TextureLoaderTest_Missing.ktx").string(),
+      &ret);
+  EXPECT_EQ(loader, nullptr);
+  EXPECT_FALSE(ret.isOk());
+}
+
 TEST_F(Ktx1TextureLoaderTest, ValidHeaderWithExtraData_Succeeds) {
   const uint32_t width = 64u;
   const uint32_t height = 32u;
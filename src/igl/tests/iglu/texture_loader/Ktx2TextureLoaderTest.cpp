@@ -7,12 +7,18 @@
 
 #include <gtest/gtest.h>
 
+#include <IGLU/texture_loader/IData.h>
 #include <IGLU/texture_loader/ktx2/Header.h>
 #include <IGLU/texture_loader/ktx2/TextureLoaderFactory.h>
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
+#include <filesystem>
 #include <igl/vulkan/util/TextureFormat.h>
+#include <ktx.h>
 #include <numeric>
 #include <vector>
+#include <zstd.h>
 
 namespace igl::tests::ktx2 {
 
@@ -43,6 +49,7 @@ constexpr uint32_t kOffsetWidth = 20u;
 constexpr uint32_t kOffsetHeight = 24u;
 constexpr uint32_t kOffsetFaceCount = 36u;
 constexpr uint32_t kOffsetLevelCount = 40u;
+constexpr uint32_t kOffsetSupercompressionScheme = 44u;
 constexpr uint32_t kOffsetDfdByteOffset = 48u;
 constexpr uint32_t kOffsetDfdByteLength = 52u;
 constexpr uint32_t kOffsetKvdByteOffset = 56u;
@@ -226,6 +233,74 @@ void populateMinimalValidFile(std::vector<uint8_t>& buffer,
   putDfd(buffer, vkFormat, forceDfdAfterMipLevel1 ? 1u : numMipLevels);
 }
 
+// Encodes an RGBA8 image to a Basis Universal compressed KTX2 file, which needs transcoding
+std::vector<uint8_t> createBasisFile(uint32_t width, uint32_t height) {
+  ktxTextureCreateInfo createInfo{};
+  createInfo.vkFormat = 37u; /* VK_FORMAT_R8G8B8A8_UNORM */
+  createInfo.baseWidth = width;
+  createInfo.baseHeight = height;
+  createInfo.baseDepth = 1u;
+  createInfo.numDimensions = 2u;
+  createInfo.numLevels = 1u;
+  createInfo.numLayers = 1u;
+  createInfo.numFaces = 1u;
+  createInfo.generateMipmaps = KTX_FALSE;
+
+  ktxTexture2* texture = nullptr;
+  if (ktxTexture2_Create(&createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &texture) != KTX_SUCCESS) {
+    return {};
+  }
+  std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4u);
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] = static_cast<uint8_t>(i * 7u);
+  }
+  std::vector<uint8_t> file;
+  ktx_uint8_t* bytes = nullptr;
+  ktx_size_t size = 0;
+  if (ktxTexture_SetImageFromMemory(
+          ktxTexture(texture), 0, 0, 0, pixels.data(), pixels.size()) == KTX_SUCCESS &&
+      ktxTexture2_CompressBasis(texture, 0) == KTX_SUCCESS &&
+      ktxTexture_WriteToMemory(ktxTexture(texture), &bytes, &size) == KTX_SUCCESS) {
+    file.assign(bytes, bytes + size);
+  }
+  std::free(bytes);
+  ktxTexture_Destroy(ktxTexture(texture));
+  return file;
+}
+
+// Capabilities that can only sample the given formats
+class SampledFormatsCapabilities final : public ICapabilities {
+ public:
+  explicit SampledFormatsCapabilities(std::vector<TextureFormat> formats) :
+    formats_(std::move(formats)) {}
+
+  [[nodiscard]] bool hasFeature(DeviceFeatures /*feature*/) const final {
+    return false;
+  }
+  [[nodiscard]] bool hasRequirement(DeviceRequirement /*requirement*/) const final {
+    return false;
+  }
+  [[nodiscard]] TextureFormatCapabilities getTextureFormatCapabilities(
+      TextureFormat format) const final {
+    return std::find(formats_.begin(), formats_.end(), format) != formats_.end()
+               ? TextureFormatCapabilityBits::Sampled
+               : TextureFormatCapabilityBits::Unsupported;
+  }
+  bool getFeatureLimits(DeviceFeatureLimits /*featureLimits*/, size_t& result) const final {
+    result = 0;
+    return false;
+  }
+  [[nodiscard]] ShaderVersion getShaderVersion() const final {
+    return {};
+  }
+  [[nodiscard]] BackendVersion getBackendVersion() const final {
+    return {};
+  }
+
+ private:
+  std::vector<TextureFormat> formats_;
+};
+
 } // namespace
 
 class Ktx2TextureLoaderTest : public ::testing::Test {
@@ -280,6 +355,50 @@ TEST_F(Ktx2TextureLoaderTest, MinimumValidHeader_Succeeds) {
   EXPECT_TRUE(ret.isOk()) << ret.message;
 }
 
+TEST_F(Ktx2TextureLoaderTest, ZstdSupercompressed_Succeeds) {
+  const uint32_t width = 64u;
+  const uint32_t height = 32u;
+  const uint32_t numMipLevels = 1u;
+  const uint32_t bytesOfKeyValueData = 0u;
+  const uint32_t imageSize = 512u;
+  const uint32_t vkFormat = 1000054000u; /* VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG */
+
+  std::vector<uint8_t> image(imageSize);
+  for (uint32_t i = 0; i < imageSize; ++i) {
+    image[i] = static_cast<uint8_t>(i % 7u);
+  }
+  std::vector<uint8_t> compressed(ZSTD_compressBound(imageSize));
+  const size_t compressedSize =
+      ZSTD_compress(compressed.data(), compressed.size(), image.data(), image.size(), 3);
+  ASSERT_FALSE(ZSTD_isError(compressedSize));
+  ASSERT_LT(compressedSize, imageSize);
+
+  // Supercompressed mip levels are not aligned and directly follow the DFD
+  const uint32_t dataOffset = iglu::textureloader::ktx2::kHeaderLength +
+                              numMipLevels * kMipmapMetadataSize + kDfdMetadataSize - 4u;
+  auto buffer = getBuffer(dataOffset + static_cast<uint32_t>(compressedSize));
+  populateMinimalValidFile(
+      buffer, vkFormat, width, height, numMipLevels, bytesOfKeyValueData, imageSize);
+  put(buffer, kOffsetSupercompressionScheme, 2u /* KTX_SS_ZSTD */);
+  put(buffer, kHeaderSize, static_cast<uint64_t>(dataOffset));
+  put(buffer, kHeaderSize + 8u, static_cast<uint64_t>(compressedSize));
+  put(buffer, kHeaderSize + 16u, static_cast<uint64_t>(imageSize));
+  std::memcpy(buffer.data() + dataOffset, compressed.data(), compressedSize);
+
+  Result ret;
+  auto reader = *iglu::textureloader::DataReader::tryCreate(
+      buffer.data(), static_cast<uint32_t>(buffer.size()), nullptr);
+  auto loader = factory_.tryCreate(reader, &ret);
+  ASSERT_NE(loader, nullptr);
+  EXPECT_TRUE(ret.isOk()) << ret.message;
+
+  auto data = loader->load(&ret);
+  ASSERT_NE(data, nullptr);
+  EXPECT_TRUE(ret.isOk()) << ret.message;
+  ASSERT_EQ(data->length(), imageSize);
+  EXPECT_EQ(std::memcmp(data->data(), image.data(), imageSize), 0);
+}
+
 TEST_F(Ktx2TextureLoaderTest, HeaderWithMipLevels_Succeeds) {
   const uint32_t width = 64u;
   const uint32_t height = 32u;
@@ -475,4 +594,101 @@ TEST_F(Ktx2TextureLoaderTest, InvalidHeaderWithExcessiveKeyValueData_Fails) {
   EXPECT_FALSE(ret.isOk());
 }
 
+TEST_F(Ktx2TextureLoaderTest, TranscodeTarget_FollowsCapabilities) {
+  factory_.setTranscodeTarget(SampledFormatsCapabilities(
+      {TextureFormat::RGBA_BC7_UNORM_4x4, TextureFormat::RGBA_ASTC_4x4}));
+  EXPECT_EQ(factory_.transcodeTarget(), TextureFormat::RGBA_ASTC_4x4);
+
+  factory_.setTranscodeTarget(SampledFormatsCapabilities(
+      {TextureFormat::RGBA_BC7_UNORM_4x4, TextureFormat::RGBA8_EAC_ETC2}));
+  EXPECT_EQ(factory_.transcodeTarget(), TextureFormat::RGBA_BC7_UNORM_4x4);
+
+  factory_.setTranscodeTarget(SampledFormatsCapabilities({TextureFormat::RGBA8_EAC_ETC2}));
+  EXPECT_EQ(factory_.transcodeTarget(), TextureFormat::RGBA8_EAC_ETC2);
+
+  factory_.setTranscodeTarget(SampledFormatsCapabilities({}));
+  EXPECT_EQ(factory_.transcodeTarget(), TextureFormat::RGBA_UNorm8);
+}
+
+TEST_F(Ktx2TextureLoaderTest, TranscodeCache_SkipsNativeFormats) {
+  const uint32_t width = 64u;
+  const uint32_t height = 32u;
+  const uint32_t numMipLevels = 1u;
+  const uint32_t bytesOfKeyValueData = 0u;
+  const uint32_t imageSize = 512u;
+  const uint32_t vkFormat = 1000054000u; /* VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG */
+  const uint32_t totalHeaderSize = getTotalHeaderSize(numMipLevels, bytesOfKeyValueData);
+  const uint32_t totalDataSize = getTotalDataSize(vkFormat, width, height, numMipLevels);
+
+  auto buffer = getBuffer(totalHeaderSize + totalDataSize);
+  populateMinimalValidFile(
+      buffer, vkFormat, width, height, numMipLevels, bytesOfKeyValueData, imageSize);
+
+  const auto cacheDirectory =
+      std::filesystem::temp_directory_path() / "Ktx2TextureLoaderTest_TranscodeCache";
+  std::filesystem::remove_all(cacheDirectory);
+  factory_.setTranscodeCacheDirectory(cacheDirectory.string());
+
+  // Textures in GPU-native formats don't need transcoding, so nothing is cached for them
+  Result ret;
+  auto reader = *iglu::textureloader::DataReader::tryCreate(
+      buffer.data(), static_cast<uint32_t>(buffer.size()), nullptr);
+  auto loader = factory_.tryCreate(reader, &ret);
+  EXPECT_NE(loader, nullptr);
+  EXPECT_TRUE(ret.isOk()) << ret.message;
+  EXPECT_FALSE(std::filesystem::exists(cacheDirectory));
+}
+
+TEST_F(Ktx2TextureLoaderTest, TranscodeCache_MissThenHit) {
+  const auto buffer = createBasisFile(16u, 16u);
+  ASSERT_FALSE(buffer.empty());
+
+  const auto cacheDirectory =
+      std::filesystem::temp_directory_path() / "Ktx2TextureLoaderTest_TranscodeCacheHit";
+  std::filesystem::remove_all(cacheDirectory);
+  factory_.setTranscodeCacheDirectory(cacheDirectory.string());
+
+  const auto load = [this, &buffer]() {
+    Result ret;
+    auto reader = *iglu::textureloader::DataReader::tryCreate(
+        buffer.data(), static_cast<uint32_t>(buffer.size()), nullptr);
+    auto loader = factory_.tryCreate(reader, &ret);
+    EXPECT_NE(loader, nullptr);
+    EXPECT_TRUE(ret.isOk()) << ret.message;
+    return loader ? loader->descriptor().format : TextureFormat::Invalid;
+  };
+  const auto cacheFiles = [&cacheDirectory]() {
+    std::vector<std::filesystem::path> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(cacheDirectory, ec)) {
+      files.push_back(entry.path());
+    }
+    return files;
+  };
+
+  // The first load misses and writes the transcoded texture
+  ASSERT_TRUE(cacheFiles().empty());
+  const auto format = load();
+  EXPECT_EQ(format, factory_.transcodeTarget());
+  const auto files = cacheFiles();
+  ASSERT_EQ(files.size(), 1u);
+  EXPECT_GT(std::filesystem::file_size(files[0]), 0u);
+  const auto writeTime = std::filesystem::last_write_time(files[0]);
+
+  // The cached file holds GPU-native blocks that load without transcoding
+  auto cached = iglu::textureloader::IData::tryCreateFromFile(files[0].string(), nullptr);
+  ASSERT_NE(cached, nullptr);
+  Result ret;
+  auto cachedLoader = factory_.tryCreate(std::move(cached), &ret);
+  ASSERT_NE(cachedLoader, nullptr);
+  EXPECT_EQ(cachedLoader->descriptor().format, format);
+
+  // The second load hits and leaves the entry untouched
+  EXPECT_EQ(load(), format);
+  EXPECT_EQ(cacheFiles(), files);
+  EXPECT_EQ(std::filesystem::last_write_time(files[0]), writeTime);
+
+  std::filesystem::remove_all(cacheDirectory);
+}
+
 } // namespace igl::tests::ktx2
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <IGLU/texture_loader/PixelConversion.h>
+#include <chrono>
+#include <cstring>
+#include <igl/Log.h>
+#include <random>
+#include <vector>
+
+namespace igl::tests {
+
+namespace {
+
+std::vector<uint8_t> randomBytes(size_t count, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::vector<uint8_t> bytes(count);
+  for (auto& byte : bytes) {
+    byte = static_cast<uint8_t>(rng());
+  }
+  return bytes;
+}
+
+// Sizes that exercise both the vectorized loops and their scalar remainders
+constexpr size_t kNumPixels[] = {0, 1, 5, 7, 8, 13, 64, 1001};
+
+// Returns the average time of `iterations` calls of `function` in nanoseconds per pixel
+template<typename Function>
+double nsPerPixel(size_t numPixels, size_t iterations, Function&& function) {
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t iter = 0; iter < iterations; ++iter) {
+    function();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+  return static_cast<double>(ns) / static_cast<double>(numPixels * iterations);
+}
+
+} // namespace
+
+class PixelConversionTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+  }
+};
+
+TEST_F(PixelConversionTest, ExpandRgb8ToRgba8_MatchesScalar) {
+  for (const size_t numPixels : kNumPixels) {
+    const auto rgb = randomBytes(numPixels * 3, 1);
+    std::vector<uint8_t> expected(numPixels * 4), actual(numPixels * 4);
+    iglu::textureloader::scalar::expandRgb8ToRgba8(rgb.data(), expected.data(), numPixels);
+    iglu::textureloader::expandRgb8ToRgba8(rgb.data(), actual.data(), numPixels);
+    ASSERT_EQ(actual, expected) << numPixels;
+  }
+}
+
+TEST_F(PixelConversionTest, ConvertFloatToHalf) {
+  const std::vector<float> values = {
+      0.0f, -0.0f, 1.0f, -2.0f, 0.5f, 65504.0f, 65520.0f, 1e10f, 1e-7f, 1.0009765625f};
+  const std::vector<uint16_t> expected = {
+      0x0000, 0x8000, 0x3c00, 0xc000, 0x3800, 0x7bff, 0x7c00, 0x7c00, 0x0002, 0x3c01};
+  std::vector<uint16_t> actual(values.size());
+  iglu::textureloader::convertFloatToHalf(values.data(), actual.data(), values.size());
+  ASSERT_EQ(actual, expected);
+
+  std::mt19937 rng(2);
+  std::uniform_real_distribution<float> distribution(-70000.0f, 70000.0f);
+  std::vector<float> floats(1001);
+  for (size_t i = 0; i < floats.size(); ++i) {
+    // Cover normal, subnormal and overflowing halves
+    floats[i] = distribution(rng) * (i % 3 == 0 ? 1.0f : (i % 3 == 1 ? 1e-9f : 1e-4f));
+  }
+  std::vector<uint16_t> scalarHalves(floats.size()), halves(floats.size());
+  iglu::textureloader::scalar::convertFloatToHalf(
+      floats.data(), scalarHalves.data(), floats.size());
+  iglu::textureloader::convertFloatToHalf(floats.data(), halves.data(), floats.size());
+  ASSERT_EQ(halves, scalarHalves);
+}
+
+TEST_F(PixelConversionTest, PremultiplyAlpha_MatchesScalar) {
+  for (const size_t numPixels : kNumPixels) {
+    auto expected = randomBytes(numPixels * 4, 3);
+    auto actual = expected;
+    iglu::textureloader::scalar::premultiplyAlphaRgba8(expected.data(), numPixels, false);
+    iglu::textureloader::premultiplyAlphaRgba8(actual.data(), numPixels, false);
+    ASSERT_EQ(actual, expected) << numPixels;
+  }
+
+  uint8_t pixel[] = {255, 128, 0, 128};
+  iglu::textureloader::premultiplyAlphaRgba8(pixel, 1, false);
+  ASSERT_EQ(pixel[0], 128);
+  ASSERT_EQ(pixel[1], 64);
+  ASSERT_EQ(pixel[2], 0);
+  ASSERT_EQ(pixel[3], 128);
+
+  std::vector<float> floats = {1.0f, 0.5f, 0.25f, 0.5f, 2.0f, 2.0f, 2.0f, 0.0f};
+  iglu::textureloader::premultiplyAlphaRgbaF32(floats.data(), 2);
+  ASSERT_EQ(floats, (std::vector<float>{0.5f, 0.25f, 0.125f, 0.5f, 0.0f, 0.0f, 0.0f, 0.0f}));
+}
+
+TEST_F(PixelConversionTest, Downsample_MatchesScalar) {
+  const std::pair<uint32_t, uint32_t> sizes[] = {
+      {1, 1}, {2, 2}, {3, 5}, {7, 3}, {16, 16}, {17, 9}, {1, 8}, {33, 1}};
+  for (const auto& [width, height] : sizes) {
+    const size_t numDstPixels = std::max(width / 2u, 1u) * std::max(height / 2u, 1u);
+
+    const auto src = randomBytes(static_cast<size_t>(width) * height * 4, width * height);
+    std::vector<uint8_t> expected(numDstPixels * 4), actual(numDstPixels * 4);
+    iglu::textureloader::scalar::downsampleRgba8(src.data(), width, height, expected.data(), false);
+    iglu::textureloader::downsampleRgba8(src.data(), width, height, actual.data(), false);
+    ASSERT_EQ(actual, expected) << width << "x" << height;
+
+    std::vector<float> floatSrc(src.size());
+    for (size_t i = 0; i < src.size(); ++i) {
+      floatSrc[i] = static_cast<float>(src[i]) / 7.0f;
+    }
+    std::vector<float> expectedFloats(numDstPixels * 4), actualFloats(numDstPixels * 4);
+    iglu::textureloader::scalar::downsampleRgbaF32(
+        floatSrc.data(), width, height, expectedFloats.data());
+    iglu::textureloader::downsampleRgbaF32(floatSrc.data(), width, height, actualFloats.data());
+    ASSERT_EQ(actualFloats, expectedFloats) << width << "x" << height;
+  }
+}
+
+TEST_F(PixelConversionTest, DownsampleSrgb_AveragesInLinearSpace) {
+  // Black and white average to linear 0.5, which is sRGB 188
+  const uint8_t src[] = {0, 0, 0, 0, 255, 255, 255, 255, 0, 0, 0, 0, 255, 255, 255, 255};
+  uint8_t dst[4] = {};
+  iglu::textureloader::downsampleRgba8(src, 2, 2, dst, true);
+  ASSERT_EQ(dst[0], 188);
+  ASSERT_EQ(dst[3], 128);
+
+  iglu::textureloader::downsampleRgba8(src, 2, 2, dst, false);
+  ASSERT_EQ(dst[0], 128);
+}
+
+TEST_F(PixelConversionTest, GenerateMipmaps) {
+  auto desc = TextureDesc::new2D(
+      TextureFormat::RGBA_UNorm8, 4, 2, TextureDesc::TextureUsageBits::Sampled);
+  desc.numMipLevels = TextureDesc::calcNumMipLevels(desc.width, desc.height);
+  ASSERT_EQ(desc.numMipLevels, 3u);
+
+  const auto base = randomBytes(4 * 2 * 4, 4);
+  Result ret;
+  auto data = iglu::textureloader::generateMipmaps(desc, base.data(), &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  ASSERT_NE(data, nullptr);
+  ASSERT_EQ(data->length(), (8u + 2u + 1u) * 4u);
+  ASSERT_EQ(std::memcmp(data->data(), base.data(), base.size()), 0);
+
+  uint8_t level1[2 * 4] = {};
+  iglu::textureloader::scalar::downsampleRgba8(base.data(), 4, 2, level1, false);
+  ASSERT_EQ(std::memcmp(data->data() + 32, level1, sizeof(level1)), 0);
+
+  desc.format = TextureFormat::RGBA_F16;
+  data = iglu::textureloader::generateMipmaps(desc, base.data(), &ret);
+  ASSERT_EQ(data, nullptr);
+  ASSERT_FALSE(ret.isOk());
+}
+
+/// Micro-benchmark comparing the vectorized conversions against the scalar reference on a 1024x1024
+/// image. Both must produce the same pixels.
+TEST_F(PixelConversionTest, ConversionBenchmark) {
+  constexpr uint32_t kSize = 1024;
+  constexpr size_t kPixels = static_cast<size_t>(kSize) * kSize;
+  constexpr size_t kIterations = 8;
+
+  const auto rgb = randomBytes(kPixels * 3, 5);
+  std::vector<uint8_t> scalarRgba(kPixels * 4), rgba(kPixels * 4);
+  const double scalarExpandNs = nsPerPixel(kPixels, kIterations, [&]() {
+    iglu::textureloader::scalar::expandRgb8ToRgba8(rgb.data(), scalarRgba.data(), kPixels);
+  });
+  const double expandNs = nsPerPixel(kPixels, kIterations, [&]() {
+    iglu::textureloader::expandRgb8ToRgba8(rgb.data(), rgba.data(), kPixels);
+  });
+  ASSERT_EQ(rgba, scalarRgba);
+
+  // sRGB premultiplication and downsampling always run the scalar code, so only the linear paths
+  // are compared. Premultiplying in place compounds across iterations, so each run starts from the
+  // same pixels.
+  std::vector<uint8_t> scalarPremultiplied(rgba.size()), premultiplied(rgba.size());
+  const double scalarPremultiplyNs = nsPerPixel(kPixels, kIterations, [&]() {
+    std::memcpy(scalarPremultiplied.data(), rgba.data(), rgba.size());
+    iglu::textureloader::scalar::premultiplyAlphaRgba8(scalarPremultiplied.data(), kPixels, false);
+  });
+  const double premultiplyNs = nsPerPixel(kPixels, kIterations, [&]() {
+    std::memcpy(premultiplied.data(), rgba.data(), rgba.size());
+    iglu::textureloader::premultiplyAlphaRgba8(premultiplied.data(), kPixels, false);
+  });
+  ASSERT_EQ(premultiplied, scalarPremultiplied);
+
+  std::vector<uint8_t> scalarMip(kPixels), mip(kPixels);
+  const double scalarDownsampleNs = nsPerPixel(kPixels, kIterations, [&]() {
+    iglu::textureloader::scalar::downsampleRgba8(
+        rgba.data(), kSize, kSize, scalarMip.data(), false);
+  });
+  const double downsampleNs = nsPerPixel(kPixels, kIterations, [&]() {
+    iglu::textureloader::downsampleRgba8(rgba.data(), kSize, kSize, mip.data(), false);
+  });
+  ASSERT_EQ(mip, scalarMip);
+
+  std::vector<float> floats(kPixels);
+  for (size_t i = 0; i < kPixels; ++i) {
+    floats[i] = static_cast<float>(rgb[i]) / 3.0f - 40.0f;
+  }
+  std::vector<uint16_t> scalarHalves(kPixels), halves(kPixels);
+  const double scalarHalfNs = nsPerPixel(kPixels, kIterations, [&]() {
+    iglu::textureloader::scalar::convertFloatToHalf(floats.data(), scalarHalves.data(), kPixels);
+  });
+  const double halfNs = nsPerPixel(kPixels, kIterations, [&]() {
+    iglu::textureloader::convertFloatToHalf(floats.data(), halves.data(), kPixels);
+  });
+  ASSERT_EQ(halves, scalarHalves);
+
+  IGL_LOG_INFO("expandRgb8ToRgba8: %.3f ns/pixel (scalar %.3f)\n", expandNs, scalarExpandNs);
+  IGL_LOG_INFO("premultiplyAlphaRgba8 linear: %.3f ns/pixel (scalar %.3f)\n",
+               premultiplyNs,
+               scalarPremultiplyNs);
+  IGL_LOG_INFO("downsampleRgba8 linear: %.3f ns/pixel (scalar %.3f)\n",
+               downsampleNs,
+               scalarDownsampleNs);
+  IGL_LOG_INFO("convertFloatToHalf: %.3f ns/value (scalar %.3f)\n", halfNs, scalarHalfNs);
+}
+
+} // namespace igl::tests
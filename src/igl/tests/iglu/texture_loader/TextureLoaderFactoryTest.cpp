@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../../util/Common.h"
+
+#include <IGLU/texture_loader/TextureLoaderFactory.h>
+#include <IGLU/texture_loader/stb_jpeg/TextureLoaderFactory.h>
+#include <IGLU/texture_loader/stb_png/TextureLoaderFactory.h>
+#include <array>
+#include <cstring>
+#include <vector>
+
+namespace igl::tests {
+
+namespace {
+constexpr const std::array<uint8_t, 128> kRed2x2PNG{
+    {0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44,
+     0x52, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x08, 0x02, 0x00, 0x00, 0x00, 0xfd,
+     0xd4, 0x9a, 0x73, 0x00, 0x00, 0x00, 0x01, 0x73, 0x52, 0x47, 0x42, 0x00, 0xae, 0xce, 0x1c,
+     0xe9, 0x00, 0x00, 0x00, 0x04, 0x67, 0x41, 0x4d, 0x41, 0x00, 0x00, 0xb1, 0x8f, 0x0b, 0xfc,
+     0x61, 0x05, 0x00, 0x00, 0x00, 0x09, 0x70, 0x48, 0x59, 0x73, 0x00, 0x00, 0x0e, 0xc3, 0x00,
+     0x00, 0x0e, 0xc3, 0x01, 0xc7, 0x6f, 0xa8, 0x64, 0x00, 0x00, 0x00, 0x15, 0x49, 0x44, 0x41,
+     0x54, 0x18, 0x57, 0x63, 0x78, 0x67, 0x64, 0xf5, 0x56, 0x4e, 0x8d, 0x01, 0x88, 0xdf, 0xdb,
+     0xb9, 0x02, 0x00, 0x26, 0xc4, 0x05, 0x2f, 0x43, 0xee, 0xb8, 0xc6, 0x00, 0x00, 0x00, 0x00,
+     0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82}};
+
+std::unique_ptr<iglu::textureloader::IData> createData(const uint8_t* data, uint32_t length) {
+  auto buffer = std::make_unique<uint8_t[]>(length);
+  std::memcpy(buffer.get(), data, length);
+  return iglu::textureloader::IData::tryCreate(std::move(buffer), length, nullptr);
+}
+
+std::vector<std::unique_ptr<iglu::textureloader::IData>> createSources() {
+  const std::array<uint8_t, 128> garbage{};
+  std::vector<std::unique_ptr<iglu::textureloader::IData>> sources;
+  sources.push_back(createData(kRed2x2PNG.data(), static_cast<uint32_t>(kRed2x2PNG.size())));
+  sources.push_back(createData(garbage.data(), static_cast<uint32_t>(garbage.size())));
+  sources.push_back(createData(kRed2x2PNG.data(), static_cast<uint32_t>(kRed2x2PNG.size())));
+  return sources;
+}
+
+} // namespace
+
+class TextureLoaderFactoryTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    std::vector<std::unique_ptr<iglu::textureloader::ITextureLoaderFactory>> factories;
+    factories.push_back(std::make_unique<iglu::textureloader::stb::jpeg::TextureLoaderFactory>());
+    factories.push_back(std::make_unique<iglu::textureloader::stb::png::TextureLoaderFactory>());
+    factory_ = std::make_unique<iglu::textureloader::TextureLoaderFactory>(std::move(factories));
+  }
+
+  std::unique_ptr<iglu::textureloader::TextureLoaderFactory> factory_;
+};
+
+TEST_F(TextureLoaderFactoryTest, TryCreateBatch) {
+  std::vector<Result> results;
+  auto loaders = factory_->tryCreateBatch(createSources(), TextureFormat::Invalid, &results);
+  ASSERT_EQ(loaders.size(), 3u);
+  ASSERT_EQ(results.size(), 3u);
+
+  ASSERT_NE(loaders[0], nullptr);
+  EXPECT_TRUE(results[0].isOk()) << results[0].message;
+  EXPECT_EQ(loaders[0]->descriptor().width, 2u);
+
+  EXPECT_EQ(loaders[1], nullptr);
+  EXPECT_FALSE(results[1].isOk());
+
+  ASSERT_NE(loaders[2], nullptr);
+  EXPECT_TRUE(results[2].isOk()) << results[2].message;
+}
+
+TEST_F(TextureLoaderFactoryTest, CreateTextures) {
+  std::shared_ptr<IDevice> device;
+  std::shared_ptr<ICommandQueue> commandQueue;
+  util::createDeviceAndQueue(device, commandQueue);
+  ASSERT_NE(device, nullptr);
+
+  auto loaders = factory_->tryCreateBatch(createSources(), TextureFormat::Invalid, nullptr);
+
+  std::vector<Result> results;
+  auto textures = iglu::textureloader::TextureLoaderFactory::createTextures(
+      *device, loaders, commandQueue.get(), &results);
+  ASSERT_EQ(textures.size(), 3u);
+  ASSERT_EQ(results.size(), 3u);
+
+  ASSERT_NE(textures[0], nullptr);
+  EXPECT_TRUE(results[0].isOk()) << results[0].message;
+  EXPECT_EQ(textures[0]->getDimensions().width, 2u);
+  EXPECT_EQ(textures[0]->getNumMipLevels(), 2u);
+
+  EXPECT_EQ(textures[1], nullptr);
+  EXPECT_FALSE(results[1].isOk());
+
+  ASSERT_NE(textures[2], nullptr);
+  EXPECT_TRUE(results[2].isOk()) << results[2].message;
+}
+
+} // namespace igl::tests
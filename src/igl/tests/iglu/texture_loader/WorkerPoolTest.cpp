@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <IGLU/texture_loader/WorkerPool.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace igl::tests {
+
+using iglu::textureloader::WorkerPool;
+
+TEST(WorkerPoolTest, ParallelForRunsEveryIndexOnce) {
+  WorkerPool pool(3);
+  EXPECT_EQ(pool.numThreads(), 3u);
+
+  std::vector<std::atomic<int>> counts(1000);
+  pool.parallelFor(counts.size(), [&counts](size_t i) { ++counts[i]; });
+  for (const auto& count : counts) {
+    EXPECT_EQ(count, 1);
+  }
+
+  pool.parallelFor(0, [](size_t) { FAIL(); });
+}
+
+TEST(WorkerPoolTest, NestedParallelForDoesNotDeadlock) {
+  // Every worker is busy with the outer loop, so the inner loops run on their calling threads
+  WorkerPool pool(1);
+  std::atomic<size_t> sum = 0;
+  pool.parallelFor(4, [&](size_t) {
+    pool.parallelFor(8, [&sum](size_t i) { sum += i; });
+  });
+  EXPECT_EQ(sum, 4u * 28u);
+}
+
+TEST(WorkerPoolTest, AsyncReturnsResults) {
+  WorkerPool pool(2);
+  std::vector<WorkerPool::TaskFuture<size_t>> futures;
+  for (size_t i = 0; i < 16; ++i) {
+    futures.push_back(pool.async([i]() { return i * i; }));
+  }
+  for (size_t i = 0; i < futures.size(); ++i) {
+    ASSERT_TRUE(futures[i].valid());
+    EXPECT_EQ(futures[i].get(), i * i);
+    EXPECT_FALSE(futures[i].valid());
+  }
+}
+
+TEST(WorkerPoolTest, GetRunsPendingTaskOnCallingThread) {
+  WorkerPool pool(1);
+  // Waiting on a task queued behind the current one from the only worker must not deadlock
+  std::atomic<bool> started = false;
+  auto outer = pool.async([&pool, &started]() {
+    started = true;
+    auto inner = pool.async([]() { return std::this_thread::get_id(); });
+    return inner.get() == std::this_thread::get_id();
+  });
+  while (!started) {
+    std::this_thread::yield();
+  }
+  EXPECT_TRUE(outer.get());
+}
+
+} // namespace igl::tests
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../data/ShaderData.h"
+#include "../data/VertexIndexData.h"
+#include "../util/Common.h"
+#include "../util/TestDevice.h"
+
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/IContext.h>
+#include <igl/opengl/SamplerState.h>
+#include <igl/opengl/Texture.h>
+#include <igl/opengl/Version.h>
+#include <string>
+
+namespace igl::tests {
+
+class BindlessTexturesOGLTest : public ::testing::Test {
+ public:
+  BindlessTexturesOGLTest() = default;
+  ~BindlessTexturesOGLTest() override = default;
+
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    context_ = &static_cast<opengl::Device&>(*iglDev_).getContext();
+
+    Result ret;
+    const TextureDesc texDesc = TextureDesc::new2D(
+        TextureFormat::RGBA_UNorm8, 4, 4, TextureDesc::TextureUsageBits::Sampled);
+    texture_ = iglDev_->createTexture(texDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    samplerState_ = iglDev_->createSamplerState(SamplerStateDesc::newLinear(), &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+
+  void TearDown() override {
+    context_->setShouldUseBindlessTextures(false);
+  }
+
+ public:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  opengl::IContext* context_ = nullptr;
+  std::shared_ptr<ITexture> texture_;
+  std::shared_ptr<ISamplerState> samplerState_;
+};
+
+//
+// BindGroupsSampleWithTheirOwnSampler
+//
+// With bindless textures enabled, texture bind groups carry a uniform buffer of resident handles.
+// Two bind groups that combine the same texture with different samplers must each sample with
+// their own sampler.
+//
+TEST_F(BindlessTexturesOGLTest, BindGroupsSampleWithTheirOwnSampler) {
+  context_->setShouldUseBindlessTextures(true);
+  if (!context_->shouldUseBindlessTextures()) {
+    GTEST_SKIP() << "GL_ARB_bindless_texture is not supported";
+  }
+
+  // A black and a white texel; u = 1.25 wraps to the black one and clamps to the white one
+  Result ret;
+  auto texture = iglDev_->createTexture(
+      TextureDesc::new2D(TextureFormat::RGBA_UNorm8, 2, 1, TextureDesc::TextureUsageBits::Sampled),
+      &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  const uint32_t texels[] = {0xff000000, 0xffffffff};
+  ASSERT_TRUE(texture->upload(TextureRangeDesc::new2D(0, 0, 2, 1), texels).isOk());
+
+  SamplerStateDesc repeatDesc;
+  repeatDesc.addressModeU = SamplerAddressMode::Repeat;
+  SamplerStateDesc clampDesc;
+  clampDesc.addressModeU = SamplerAddressMode::Clamp;
+  auto repeatSampler = iglDev_->createSamplerState(repeatDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  auto clampSampler = iglDev_->createSamplerState(clampDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  auto repeatGroup = iglDev_->createBindGroup(
+      BindGroupTextureDesc{{texture}, {repeatSampler}, "repeat"}, nullptr, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  auto clampGroup = iglDev_->createBindGroup(
+      BindGroupTextureDesc{{texture}, {clampSampler}, "clamp"}, nullptr, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  const auto* metadata = context_->bindGroupTexturesPool_.get(repeatGroup);
+  ASSERT_TRUE(metadata != nullptr);
+  ASSERT_TRUE(metadata->bindlessHandles != nullptr);
+
+  // Render target and pipeline
+  auto target = iglDev_->createTexture(
+      TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                         1,
+                         1,
+                         TextureDesc::TextureUsageBits::Sampled |
+                             TextureDesc::TextureUsageBits::Attachment),
+      &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  FramebufferDesc framebufferDesc;
+  framebufferDesc.colorAttachments[0].texture = target;
+  auto framebuffer = iglDev_->createFramebuffer(framebufferDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  const std::string prolog =
+      opengl::getStringFromShaderVersion(context_->deviceFeatures().getShaderVersion()) +
+      "\n#extension GL_ARB_bindless_texture : require\n";
+  const std::string vertexSource = prolog + R"(
+    in vec4 position_in;
+    void main() {
+      gl_Position = position_in;
+    })";
+  const std::string fragmentSource = prolog + R"(
+    layout (std140) uniform BindlessTextures {
+      sampler2D textures[16];
+    };
+    out vec4 fragColor;
+    void main() {
+      fragColor = texture(textures[0], vec2(1.25, 0.5));
+    })";
+  std::unique_ptr<IShaderStages> stages;
+  util::createShaderStages(iglDev_,
+                           vertexSource.c_str(),
+                           data::shader::shaderFunc,
+                           fragmentSource.c_str(),
+                           data::shader::shaderFunc,
+                           stages);
+  ASSERT_TRUE(stages != nullptr);
+
+  VertexInputStateDesc inputDesc;
+  inputDesc.numAttributes = inputDesc.numInputBindings = 1;
+  inputDesc.attributes[0].format = VertexAttributeFormat::Float4;
+  inputDesc.attributes[0].name = data::shader::simplePos;
+  inputDesc.inputBindings[0].stride = sizeof(float) * 4;
+
+  RenderPipelineDesc pipelineDesc;
+  pipelineDesc.vertexInputState = iglDev_->createVertexInputState(inputDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  pipelineDesc.shaderStages = std::move(stages);
+  pipelineDesc.topology = PrimitiveType::TriangleStrip;
+  pipelineDesc.targetDesc.colorAttachments.resize(1);
+  pipelineDesc.targetDesc.colorAttachments[0].textureFormat = target->getFormat();
+  pipelineDesc.uniformBlockBindingMap[opengl::kBindlessTexturesBlockBinding] = {
+      {IGL_NAMEHANDLE("BindlessTextures"), IGL_NAMEHANDLE("")}};
+  auto pipelineState = iglDev_->createRenderPipeline(pipelineDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  auto vertexBuffer = iglDev_->createBuffer(BufferDesc(BufferDesc::BufferTypeBits::Vertex,
+                                                       data::vertex_index::QUAD_VERT,
+                                                       sizeof(data::vertex_index::QUAD_VERT)),
+                                            &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  RenderPassDesc renderPass;
+  renderPass.colorAttachments.resize(1);
+  renderPass.colorAttachments[0].loadAction = LoadAction::Clear;
+  renderPass.colorAttachments[0].storeAction = StoreAction::Store;
+  renderPass.colorAttachments[0].clearColor = {0.5f, 0.5f, 0.5f, 0.5f};
+
+  auto renderWith = [&](BindGroupTextureHandle bindGroup) {
+    auto cmdBuffer = cmdQueue_->createCommandBuffer({}, &ret);
+    auto encoder = cmdBuffer->createRenderCommandEncoder(renderPass, framebuffer);
+    encoder->bindRenderPipelineState(pipelineState);
+    encoder->bindVertexBuffer(0, *vertexBuffer);
+    encoder->bindViewport({0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f});
+    encoder->bindBindGroup(bindGroup);
+    encoder->draw(4);
+    encoder->endEncoding();
+    cmdQueue_->submit(*cmdBuffer);
+    cmdBuffer->waitUntilCompleted();
+
+    uint32_t pixel = 0;
+    framebuffer->copyBytesColorAttachment(
+        *cmdQueue_, 0, &pixel, TextureRangeDesc::new2D(0, 0, 1, 1));
+    return pixel;
+  };
+
+  ASSERT_EQ(renderWith(repeatGroup), 0xff000000);
+  ASSERT_EQ(renderWith(clampGroup), 0xffffffff);
+}
+
+//
+// SamplerStateKeepsHandleParameters
+//
+// Once a texture has a bindless handle, its parameters are immutable. Binding it with another
+// sampler state to a texture unit must leave them alone instead of raising GL_INVALID_OPERATION.
+//
+TEST_F(BindlessTexturesOGLTest, SamplerStateKeepsHandleParameters) {
+  context_->setShouldUseBindlessTextures(true);
+  if (!context_->shouldUseBindlessTextures()) {
+    GTEST_SKIP() << "GL_ARB_bindless_texture is not supported";
+  }
+
+  auto& texture = static_cast<opengl::Texture&>(*texture_);
+  ASSERT_FALSE(texture.hasBindlessHandles());
+
+  Result ret;
+  auto bindGroup = iglDev_->createBindGroup(
+      BindGroupTextureDesc{{texture_}, {samplerState_}, "bindless"}, nullptr, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_TRUE(texture.hasBindlessHandles());
+
+  auto defaultSampler = iglDev_->createSamplerState(SamplerStateDesc{}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  // Clear errors raised by earlier calls
+  while (context_->getError() != GL_NO_ERROR) {
+  }
+  texture.bind();
+  static_cast<opengl::SamplerState&>(*defaultSampler).bind(texture_.get());
+  texture.unbind();
+  ASSERT_EQ(context_->getError(), GL_NO_ERROR);
+}
+
+//
+// BindGroupWithoutBindless
+//
+// Bindless bind groups are opt-in; by default bind groups bind individual texture units.
+//
+TEST_F(BindlessTexturesOGLTest, BindGroupWithoutBindless) {
+  ASSERT_FALSE(context_->shouldUseBindlessTextures());
+
+  BindGroupTextureDesc desc;
+  desc.textures[0] = texture_;
+  desc.samplers[0] = samplerState_;
+  desc.debugName = "bound";
+
+  Result ret;
+  auto bindGroup = iglDev_->createBindGroup(desc, nullptr, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  const auto* metadata = context_->bindGroupTexturesPool_.get(bindGroup);
+  ASSERT_TRUE(metadata != nullptr);
+  ASSERT_TRUE(metadata->bindlessHandles == nullptr);
+}
+
+} // namespace igl::tests
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../util/TestDevice.h"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/DeviceFeatureSet.h>
+#include <igl/opengl/GLIncludes.h>
+#include <igl/opengl/IContext.h>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+namespace igl::tests {
+
+class DeviceFeatureSetOGLTest : public ::testing::Test {
+ public:
+  DeviceFeatureSetOGLTest() = default;
+  ~DeviceFeatureSetOGLTest() override = default;
+
+  void SetUp() override {
+    igl::setDebugBreakEnabled(false);
+
+    device_ = util::createTestDevice();
+    ASSERT_TRUE(device_ != nullptr);
+    context_ = &static_cast<opengl::Device&>(*device_).getContext();
+    ASSERT_TRUE(context_ != nullptr);
+  }
+
+  void TearDown() override {}
+
+ public:
+  opengl::IContext* context_{};
+  std::shared_ptr<::igl::IDevice> device_;
+};
+
+/// Extensions reported through GL_EXTENSIONS must match by full name, not by substring.
+TEST_F(DeviceFeatureSetOGLTest, ExtensionStringIsTokenized) {
+  opengl::DeviceFeatureSet featureSet(*context_);
+  featureSet.initializeVersion(context_->deviceFeatures().getGLVersion());
+  featureSet.initializeExtensions("  GL_EXT_debug_marker_extended GL_OES_texture_3D ", {});
+
+  EXPECT_TRUE(featureSet.isSupported("GL_OES_texture_3D"));
+  EXPECT_TRUE(featureSet.isSupported("GL_EXT_debug_marker_extended"));
+  EXPECT_FALSE(featureSet.isSupported("GL_EXT_debug_marker"));
+  EXPECT_FALSE(featureSet.isSupported(""));
+}
+
+/// A set initialized from the same extension list as the context must answer every query the same
+/// way, whether the list is reported as one string or one name at a time.
+TEST_F(DeviceFeatureSetOGLTest, PrecomputedTablesMatchContext) {
+  const auto& contextFeatures = context_->deviceFeatures();
+
+  std::string extensions;
+  std::unordered_set<std::string> supportedExtensions;
+  if (!contextFeatures.hasInternalFeature(opengl::InternalFeatures::GetStringi)) {
+    const auto* extensionStr = reinterpret_cast<const char*>(context_->getString(GL_EXTENSIONS));
+    ASSERT_TRUE(extensionStr != nullptr);
+    extensions = extensionStr;
+  } else {
+    GLint n = 0;
+    context_->getIntegerv(GL_NUM_EXTENSIONS, &n);
+    for (GLuint i = 0; i < static_cast<GLuint>(n); i++) {
+      const auto* ext = reinterpret_cast<const char*>(context_->getStringi(GL_EXTENSIONS, i));
+      if (ext) {
+        supportedExtensions.insert(ext);
+      }
+    }
+  }
+
+  opengl::DeviceFeatureSet featureSet(*context_);
+  featureSet.initializeVersion(contextFeatures.getGLVersion());
+  featureSet.initializeExtensions(std::move(extensions), std::move(supportedExtensions));
+
+  for (size_t i = 0; i < opengl::kNumExtensions; ++i) {
+    const auto extension = static_cast<opengl::Extensions>(i);
+    EXPECT_EQ(featureSet.hasExtension(extension), contextFeatures.hasExtension(extension));
+  }
+  for (size_t i = 0; i < opengl::kNumInternalFeatures; ++i) {
+    const auto feature = static_cast<opengl::InternalFeatures>(i);
+    EXPECT_EQ(featureSet.hasInternalFeature(feature), contextFeatures.hasInternalFeature(feature));
+  }
+  for (size_t i = 0; i < opengl::kNumTextureFeatures; ++i) {
+    const auto feature = static_cast<opengl::TextureFeatures>(i);
+    EXPECT_EQ(featureSet.hasTextureFeature(feature), contextFeatures.hasTextureFeature(feature));
+  }
+  for (size_t i = 0; i <= static_cast<size_t>(TextureFormat::YUV_420p); ++i) {
+    const auto format = static_cast<TextureFormat>(i);
+    EXPECT_EQ(featureSet.getTextureFormatCapabilities(format),
+              contextFeatures.getTextureFormatCapabilities(format));
+  }
+}
+
+/// Micro-benchmark comparing table lookups against extension name lookups. Table lookups must give
+/// the same answers as looking the extensions up by name, which is what every query did before the
+/// tables existed.
+TEST_F(DeviceFeatureSetOGLTest, LookupBenchmark) {
+  const auto& featureSet = context_->deviceFeatures();
+  constexpr size_t kIterations = 100000;
+
+  // Extensions that map to a single name on both desktop GL and GLES
+  const std::pair<opengl::Extensions, const char*> kNamedExtensions[] = {
+      {opengl::Extensions::AppleRgb422, "GL_APPLE_rgb_422"},
+      {opengl::Extensions::BindlessTextureNv, "GL_NV_bindless_texture"},
+      {opengl::Extensions::Debug, "GL_KHR_debug"},
+      {opengl::Extensions::DebugLabel, "GL_EXT_debug_label"},
+      {opengl::Extensions::DebugMarker, "GL_EXT_debug_marker"},
+  };
+  constexpr size_t kNumNamedExtensions = sizeof(kNamedExtensions) / sizeof(kNamedExtensions[0]);
+
+  size_t expectedHits = 0;
+  for (const auto& [extension, name] : kNamedExtensions) {
+    ASSERT_EQ(featureSet.hasExtension(extension), featureSet.isSupported(name)) << name;
+    expectedHits += featureSet.isSupported(name) ? kIterations / kNumNamedExtensions : 0;
+  }
+
+  size_t tableHits = 0;
+  const auto tableStart = std::chrono::steady_clock::now();
+  for (size_t iter = 0; iter < kIterations; ++iter) {
+    tableHits += featureSet.hasExtension(kNamedExtensions[iter % kNumNamedExtensions].first) ? 1
+                                                                                             : 0;
+  }
+  const auto tableEnd = std::chrono::steady_clock::now();
+
+  size_t nameHits = 0;
+  const auto nameStart = std::chrono::steady_clock::now();
+  for (size_t iter = 0; iter < kIterations; ++iter) {
+    nameHits += featureSet.isSupported(kNamedExtensions[iter % kNumNamedExtensions].second) ? 1
+                                                                                            : 0;
+  }
+  const auto nameEnd = std::chrono::steady_clock::now();
+
+  const auto tableNs =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(tableEnd - tableStart).count();
+  const auto nameNs =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(nameEnd - nameStart).count();
+  IGL_LOG_INFO("DeviceFeatureSet table lookups: %.2f ns/query (%zu hits)\n",
+               static_cast<double>(tableNs) / static_cast<double>(kIterations),
+               tableHits);
+  IGL_LOG_INFO("DeviceFeatureSet name lookups: %.2f ns/query (%zu hits)\n",
+               static_cast<double>(nameNs) / static_cast<double>(kIterations),
+               nameHits);
+
+  static_assert(kIterations % kNumNamedExtensions == 0);
+  EXPECT_EQ(tableHits, expectedHits);
+  EXPECT_EQ(nameHits, expectedHits);
+}
+
+/// The texture format table covers every value of TextureFormat's underlying type.
+TEST_F(DeviceFeatureSetOGLTest, TextureFormatTableCoversUnderlyingType) {
+  const auto& featureSet = context_->deviceFeatures();
+  for (size_t i = static_cast<size_t>(TextureFormat::YUV_420p) + 1; i <= 0xff; ++i) {
+    EXPECT_EQ(featureSet.getTextureFormatCapabilities(static_cast<TextureFormat>(i)),
+              ICapabilities::TextureFormatCapabilityBits::Unsupported);
+  }
+}
+
+} // namespace igl::tests
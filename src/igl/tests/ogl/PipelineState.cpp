@@ -10,9 +10,12 @@
 #include "../util/Common.h"
 #include "../util/TestDevice.h"
 
+#include <chrono>
 #include <gtest/gtest.h>
 #include <igl/IGL.h>
+#include <igl/opengl/Device.h>
 #include <igl/opengl/RenderPipelineState.h>
+#include <igl/opengl/Shader.h>
 #include <utility>
 
 namespace igl::tests {
@@ -111,7 +114,24 @@ class PipelineStateOGLTest : public ::testing::Test {
     renderPipelineDesc_.targetDesc.colorAttachments[0].blendEnabled = true;
   }
 
-  void TearDown() override {}
+  // Polls isReady() for a deferred pipeline, giving up after a few seconds
+  static bool waitUntilReady(const IRenderPipelineState& pipelineState) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!pipelineState.isReady()) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void TearDown() override {
+    // Tests that defer status checks must not leak the setting into later tests
+    if (iglDev_) {
+      static_cast<igl::opengl::Device&>(*iglDev_).getContext().setShouldDeferShaderStatusChecks(
+          false);
+    }
+  }
 
   // Member variables
  public:
@@ -169,6 +189,84 @@ TEST_F(PipelineStateOGLTest, GetIndexByName) {
   ASSERT_NE(idx, -1);
 }
 
+//
+// DeferredShaderStatusChecks
+//
+// With deferred status checks, pipeline creation must not report errors up front, isReady() must
+// eventually become true, and the pipeline must behave the same as a synchronously created one.
+//
+TEST_F(PipelineStateOGLTest, DeferredShaderStatusChecks) {
+  auto& context = static_cast<igl::opengl::Device&>(*iglDev_).getContext();
+  context.setShouldDeferShaderStatusChecks(true);
+
+  Result ret;
+  std::unique_ptr<IShaderStages> stages;
+  igl::tests::util::createSimpleShaderStages(iglDev_, stages);
+  shaderStages_ = std::move(stages);
+  renderPipelineDesc_.shaderStages = shaderStages_;
+
+  auto pipelineState = iglDev_->createRenderPipeline(renderPipelineDesc_, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_TRUE(pipelineState != nullptr);
+
+  const bool hasParallelShaderCompile = context.deviceFeatures().hasInternalFeature(
+      igl::opengl::InternalFeatures::ParallelShaderCompile);
+  if (!hasParallelShaderCompile) {
+    // Status checks are never deferred without GL_KHR_parallel_shader_compile
+    ASSERT_TRUE(pipelineState->isReady());
+  }
+  ASSERT_TRUE(waitUntilReady(*pipelineState));
+
+  const int idx = pipelineState->getIndexByName(igl::genNameHandle(data::shader::simplePos),
+                                                igl::ShaderStage::Vertex);
+  ASSERT_NE(idx, -1);
+  ASSERT_TRUE(pipelineState->getStatus().isOk());
+}
+
+//
+// DeferredLinkFailure
+//
+// A deferred link that fails must fail every pipeline created from the stages afterwards, rather
+// than letting them build their state on program 0.
+//
+TEST_F(PipelineStateOGLTest, DeferredLinkFailure) {
+  auto& context = static_cast<igl::opengl::Device&>(*iglDev_).getContext();
+  context.setShouldDeferShaderStatusChecks(true);
+  if (!context.shouldDeferShaderStatusChecks()) {
+    GTEST_SKIP() << "GL_KHR_parallel_shader_compile not supported";
+  }
+
+  // The varying types don't match, so both shaders compile but the program fails to link
+  const char* fragmentShader = IGL_TO_STRING(PROLOG varying vec3 uv;
+
+                                             void main() { gl_FragColor = vec4(uv, 1.0); });
+  Result ret;
+  std::shared_ptr<IShaderStages> stages =
+      ShaderStagesCreator::fromModuleStringInput(*iglDev_,
+                                                 data::shader::OGL_SIMPLE_VERT_SHADER,
+                                                 "main",
+                                                 "",
+                                                 fragmentShader,
+                                                 "main",
+                                                 "",
+                                                 &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  renderPipelineDesc_.shaderStages = stages;
+
+  auto pipelineState = iglDev_->createRenderPipeline(renderPipelineDesc_, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_TRUE(waitUntilReady(*pipelineState));
+  EXPECT_FALSE(pipelineState->getStatus().isOk());
+  EXPECT_FALSE(static_cast<igl::opengl::RenderPipelineState&>(*pipelineState).bind().isOk());
+
+  const auto& glStages = static_cast<const igl::opengl::ShaderStages&>(*stages);
+  EXPECT_EQ(glStages.getProgramID(), 0u);
+  iglDev_->createRenderPipeline(renderPipelineDesc_, &ret);
+  EXPECT_EQ(ret.code, Result::Code::RuntimeError);
+  iglDev_->createRenderPipeline(renderPipelineDesc_, &ret);
+  EXPECT_EQ(ret.code, Result::Code::RuntimeError);
+}
+
 // Test static conversions from IGL ops to OGL ops
 TEST_F(PipelineStateOGLTest, ConvertOps) {
   //----------------
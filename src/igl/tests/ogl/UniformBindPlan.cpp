@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../data/ShaderData.h"
+#include "../util/Common.h"
+#include "../util/TestDevice.h"
+
+#include <gtest/gtest.h>
+#include <igl/IGL.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/IContext.h>
+#include <igl/opengl/Shader.h>
+#include <igl/opengl/UniformBindPlan.h>
+
+namespace igl::tests {
+
+class UniformBindPlanOGLTest : public ::testing::Test {
+ public:
+  UniformBindPlanOGLTest() = default;
+  ~UniformBindPlanOGLTest() override = default;
+
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    context_ = &static_cast<opengl::Device&>(*iglDev_).getContext();
+
+    std::unique_ptr<IShaderStages> stages;
+    util::createSimpleShaderStages(iglDev_, stages);
+    ASSERT_TRUE(stages != nullptr);
+    shaderStages_ = std::move(stages);
+
+    programID_ = static_cast<opengl::ShaderStages&>(*shaderStages_).getProgramID();
+    location_ = context_->getUniformLocation(programID_, data::shader::simpleSampler);
+    ASSERT_GE(location_, 0);
+    context_->useProgram(programID_);
+  }
+
+  void TearDown() override {
+    context_->useProgram(0);
+  }
+
+  [[nodiscard]] GLint getUniformValue() const {
+    GLint value = -1;
+    context_->getUniformiv(programID_, location_, &value);
+    return value;
+  }
+
+ public:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::shared_ptr<IShaderStages> shaderStages_;
+  opengl::IContext* context_ = nullptr;
+  GLuint programID_ = 0;
+  GLint location_ = -1;
+};
+
+//
+// SkipsUnchangedValues
+//
+// Binding the value last uploaded through the plan must not reach GL; binding a new value or
+// binding after invalidate() must.
+//
+TEST_F(UniformBindPlanOGLTest, SkipsUnchangedValues) {
+  opengl::UniformBindPlan plan;
+
+  UniformDesc desc;
+  desc.location = location_;
+  desc.type = UniformType::Int;
+  desc.numElements = 1;
+
+  GLint unit = 3;
+  plan.bind(*context_, desc, reinterpret_cast<const uint8_t*>(&unit), sizeof(unit));
+  ASSERT_EQ(getUniformValue(), 3);
+
+  // Change the value behind the plan's back; rebinding the shadowed value is skipped
+  context_->uniform1i(location_, 5);
+  plan.bind(*context_, desc, reinterpret_cast<const uint8_t*>(&unit), sizeof(unit));
+  ASSERT_EQ(getUniformValue(), 5);
+
+  plan.invalidate(location_);
+  plan.bind(*context_, desc, reinterpret_cast<const uint8_t*>(&unit), sizeof(unit));
+  ASSERT_EQ(getUniformValue(), 3);
+
+  unit = 1;
+  plan.bind(*context_, desc, reinterpret_cast<const uint8_t*>(&unit), sizeof(unit));
+  ASSERT_EQ(getUniformValue(), 1);
+}
+
+//
+// RebuildsOnLayoutChange
+//
+// A different type at the same location rebuilds the entry and always uploads.
+//
+TEST_F(UniformBindPlanOGLTest, RebuildsOnLayoutChange) {
+  opengl::UniformBindPlan plan;
+
+  UniformDesc desc;
+  desc.location = location_;
+  desc.type = UniformType::Int;
+  desc.numElements = 1;
+
+  const GLint unit = 2;
+  plan.bind(*context_, desc, reinterpret_cast<const uint8_t*>(&unit), sizeof(unit));
+  ASSERT_EQ(getUniformValue(), 2);
+
+  context_->uniform1i(location_, 0);
+
+  // Booleans are uploaded as 1-byte values expanded to GLint
+  desc.type = UniformType::Boolean;
+  const uint8_t enabled = 1;
+  plan.bind(*context_, desc, &enabled, sizeof(enabled));
+  ASSERT_EQ(getUniformValue(), 1);
+}
+
+//
+// ForgetsValuesOnRelink
+//
+// Relinking replaces the program, whose uniforms start at their defaults, so the shader stages'
+// plan must upload the next value even if it matches the last one.
+//
+TEST_F(UniformBindPlanOGLTest, ForgetsValuesOnRelink) {
+  auto& stages = static_cast<opengl::ShaderStages&>(*shaderStages_);
+  auto& plan = stages.getUniformBindPlan();
+
+  UniformDesc desc;
+  desc.location = location_;
+  desc.type = UniformType::Int;
+  desc.numElements = 1;
+
+  const GLint unit = 3;
+  plan.bind(*context_, desc, reinterpret_cast<const uint8_t*>(&unit), sizeof(unit));
+  ASSERT_EQ(getUniformValue(), 3);
+
+  const Result ret = stages.create(ShaderStagesDesc{});
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  ASSERT_TRUE(stages.resolveLinkStatus().isOk());
+  programID_ = stages.getProgramID();
+  location_ = context_->getUniformLocation(programID_, data::shader::simpleSampler);
+  ASSERT_GE(location_, 0);
+  context_->useProgram(programID_);
+  ASSERT_EQ(getUniformValue(), 0);
+
+  desc.location = location_;
+  plan.bind(*context_, desc, reinterpret_cast<const uint8_t*>(&unit), sizeof(unit));
+  ASSERT_EQ(getUniformValue(), 3);
+}
+
+} // namespace igl::tests
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <array>
+#include <gtest/gtest.h>
+#include <igl/vulkan/Common.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/Texture.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanTexture.h>
+#include <memory>
+
+#include <igl/tests/util/device/TestDevice.h>
+
+#if IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+
+namespace igl::tests {
+
+//
+// VulkanContextTest
+//
+// Unit tests for igl::vulkan::VulkanContext.
+//
+class VulkanContextTest : public ::testing::Test {
+ public:
+  // Set up common resources.
+  void SetUp() override {
+    // Turn off debug break so unit tests can run
+    igl::setDebugBreakEnabled(false);
+
+    device_ = igl::tests::util::device::createTestDevice(igl::BackendType::Vulkan);
+    ASSERT_TRUE(device_ != nullptr);
+    auto& device = static_cast<igl::vulkan::Device&>(*device_);
+    context_ = &device.getVulkanContext();
+    ASSERT_TRUE(context_ != nullptr);
+
+    Result ret;
+    cmdQueue_ = device_->createCommandQueue({CommandQueueType::Graphics}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message;
+  }
+
+  std::shared_ptr<ITexture> createTexture() {
+    Result ret;
+    const TextureDesc desc = TextureDesc::new2D(
+        TextureFormat::RGBA_UNorm8, 4, 4, TextureDesc::TextureUsageBits::Sampled);
+    auto texture = device_->createTexture(desc, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message;
+    return texture;
+  }
+
+  static uint32_t textureId(const ITexture& texture) {
+    return static_cast<const igl::vulkan::Texture&>(texture).getVulkanTexture().textureId_;
+  }
+
+  // Encoding runs VulkanContext::checkAndUpdateDescriptorSets(), which prunes released textures
+  void encode() {
+    Result ret;
+    auto cmdBuffer = cmdQueue_->createCommandBuffer({}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message;
+    auto computeEncoder = cmdBuffer->createComputeCommandEncoder();
+    ASSERT_TRUE(computeEncoder != nullptr);
+    computeEncoder->endEncoding();
+    cmdQueue_->submit(*cmdBuffer);
+    cmdBuffer->waitUntilCompleted();
+  }
+
+ protected:
+  std::shared_ptr<IDevice> device_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  vulkan::VulkanContext* context_ = nullptr;
+};
+
+TEST_F(VulkanContextTest, PruneReleasedTextures) {
+  std::array<std::shared_ptr<ITexture>, 3> textures;
+  std::array<uint32_t, 3> ids = {};
+  for (size_t i = 0; i != textures.size(); ++i) {
+    textures[i] = createTexture();
+    ASSERT_TRUE(textures[i] != nullptr);
+    ids[i] = textureId(*textures[i]);
+  }
+  const uint32_t numTextures = context_->textures_.numObjects();
+
+  // Dropped textures stay in the pool until the next descriptor set update
+  for (auto& texture : textures) {
+    texture.reset();
+  }
+  EXPECT_EQ(context_->textures_.numObjects(), numTextures);
+
+  encode();
+  EXPECT_EQ(context_->textures_.numObjects(), numTextures - textures.size());
+
+  // The next texture reuses one of the freed slots instead of growing the pool
+  auto texture = createTexture();
+  ASSERT_TRUE(texture != nullptr);
+  EXPECT_NE(std::find(ids.begin(), ids.end(), textureId(*texture)), ids.end());
+  EXPECT_EQ(context_->textures_.numObjects(), numTextures - textures.size() + 1);
+}
+
+} // namespace igl::tests
+
+#endif // IGL_PLATFORM_WIN || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
@@ -8,6 +8,7 @@
 #include <array>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <thread>
 #include <utility>
@@ -363,6 +364,14 @@ struct VulkanContextImpl final {
   SamplerHandle dummySampler_ = {};
   TextureHandle dummyTexture_ = {};
 
+  // Textures whose last external reference was dropped. Shared with the deleters of the
+  // references returned by createTexture(), which can run on any thread and outlive the context.
+  struct TextureReleaseList {
+    std::mutex mutex;
+    std::vector<TextureHandle> handles;
+  };
+  std::shared_ptr<TextureReleaseList> releasedTextures_ = std::make_shared<TextureReleaseList>();
+
   igl::vulkan::DescriptorPoolsArena& getOrCreateArena_CombinedImageSamplers(
       const VulkanContext& ctx,
       VkDescriptorSetLayout dsl,
@@ -1304,16 +1313,15 @@ std::unique_ptr<VulkanImage> VulkanContext::createImageFromFileDescriptor(
 }
 
 void VulkanContext::pruneTextures() {
-  // here we remove deleted textures - everything which has only 1 reference is owned by this
-  // context and can be released safely
-
-  // textures
+  // here we remove deleted textures - only the textures on the release list are visited, so the
+  // cost does not depend on the number of live textures
+  std::vector<TextureHandle> handles;
   {
-    for (uint32_t i = 1; i < (uint32_t)textures_.objects_.size(); i++) {
-      if (textures_.objects_[i].obj_ && textures_.objects_[i].obj_.use_count() == 1) {
-        textures_.destroy(i);
-      }
-    }
+    const std::lock_guard<std::mutex> lock(pimpl_->releasedTextures_->mutex);
+    handles.swap(pimpl_->releasedTextures_->handles);
+  }
+  for (const TextureHandle handle : handles) {
+    textures_.destroy(handle);
   }
 }
 
@@ -1461,7 +1469,13 @@ std::shared_ptr<VulkanTexture> VulkanContext::createTexture(
 
   awaitingCreation_ = true;
 
-  return texture;
+  // Callers get their own reference count. When it drops to zero the texture goes on the release
+  // list for pruneTextures(); the deleter keeps the texture alive until its control block dies.
+  return {texture.get(),
+          [owner = texture, handle, releasedTextures = pimpl_->releasedTextures_](VulkanTexture*) {
+            const std::lock_guard<std::mutex> lock(releasedTextures->mutex);
+            releasedTextures->handles.push_back(handle);
+          }};
 }
 
 std::shared_ptr<VulkanTexture> VulkanContext::createTextureFromVkImage(
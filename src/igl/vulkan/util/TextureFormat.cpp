@@ -82,6 +82,8 @@ namespace igl::vulkan::util {
 #define VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK 148
 #define VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK 149
 #define VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK 150
+#define VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK 151
+#define VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK 152
 #define VK_FORMAT_EAC_R11G11_UNORM_BLOCK 155
 #define VK_FORMAT_EAC_R11G11_SNORM_BLOCK 156
 #define VK_FORMAT_EAC_R11_UNORM_BLOCK 153
@@ -219,6 +221,10 @@ TextureFormat vkTextureFormatToTextureFormat(int32_t vkFormat) {
     return TextureFormat::RGB8_Punchthrough_A1_ETC2;
   case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
     return TextureFormat::SRGB8_Punchthrough_A1_ETC2;
+  case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+    return TextureFormat::RGBA8_EAC_ETC2;
+  case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+    return TextureFormat::SRGB8_A8_EAC_ETC2;
   case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
     return TextureFormat::RG_EAC_UNorm;
   case VK_FORMAT_EAC_R11G11_SNORM_BLOCK: